@@ -0,0 +1,57 @@
+/**
+ * @file stat.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SYS_STAT_H_
+#define SYS_STAT_H_
+
+#ifndef _TIME_T
+#define	_TIME_T
+typedef long int time_t;
+#endif	/* _TIME_T */
+
+#ifndef _OFF_T
+#define	_OFF_T
+typedef long int off_t;
+#endif	/* _OFF_T */
+
+/**
+ * Only the size and the modification time are filled in
+ */
+struct stat {
+	off_t st_size;		/* total size, in bytes */
+	time_t st_mtime;	/* time of last modification */
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int stat(const char *pathname, struct stat *statbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_STAT_H_ */
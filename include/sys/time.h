@@ -52,6 +52,7 @@ extern "C" {
 
 extern int gettimeofday(struct timeval *tv, struct timezone *tz);
 extern int settimeofday(const struct timeval *tv, const struct timezone *tz);
+extern int adjtime(const struct timeval *delta, struct timeval *olddelta);
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,7 @@
 
 #include "packets.h"
 #include "artnettrigger.h"
+#include "artnettimecode.h"
 
 #include "artnetpolltable.h"
 
@@ -99,12 +100,20 @@ public:
 		return m_pArtNetTrigger;
 	}
 
+	void SetArtNetTimeCode(ArtNetTimeCode *pArtNetTimeCode) {
+		m_pArtNetTimeCode = pArtNetTimeCode;
+	}
+	ArtNetTimeCode *GetArtNetTimeCode() {
+		return m_pArtNetTimeCode;
+	}
+
 	const uint8_t *GetSoftwareVersion();
 
 private:
 	void HandlePoll();
 	void HandlePollReply();
 	void HandleTrigger();
+	void HandleTimeCode();
 	void ActiveUniversesAdd(uint16_t nUniverse);
 	void ActiveUniversesClear();
 
@@ -118,6 +127,7 @@ private:
 	struct TArtDmx *m_pArtDmx;
 	struct TArtSync *m_pArtSync;
 	ArtNetTrigger *m_pArtNetTrigger{nullptr}; // Trigger handler
+	ArtNetTimeCode *m_pArtNetTimeCode{nullptr}; // TimeCode handler
 	uint32_t m_nLastPollMillis{0};
 	bool m_bDoTableCleanup{true};
 	bool m_bDmxHandled{false};
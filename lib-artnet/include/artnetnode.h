@@ -36,6 +36,8 @@
 #include "packets.h"
 
 #include "lightset.h"
+#include "lightsetmerge.h"
+#include "lightsetbarrier.h"
 #include "ledblink.h"
 
 #include "artnettimecode.h"
@@ -130,16 +132,9 @@ struct TGenericPort {
 };
 
 struct TOutputPort {
-	uint8_t data[ArtNet::DMX_LENGTH];	///< Data sent
-	uint16_t nLength;					///< Length of sent DMX data
-	uint8_t dataA[ArtNet::DMX_LENGTH];	///< The data received from Port A
-	uint32_t nMillisA;					///< The latest time of the data received from Port A
-	uint32_t ipA;						///< The IP address for port A
-	uint8_t dataB[ArtNet::DMX_LENGTH];	///< The data received from Port B
-	uint32_t nMillisB;					///< The latest time of the data received from Port B
-	uint32_t ipB;						///< The IP address for Port B
 	artnet::Merge mergeMode;				///< \ref artnet::Merge
 	bool IsDataPending;					///< ArtDMX received and waiting for ArtSync
+	bool bMergeCancel;					///< ArtAddress AcCancelMerge, handled with the next ArtDmx
 	bool bIsEnabled;					///< Is the port enabled ?
 	TGenericPort port;					///< \ref TGenericPort
 	artnet::PortProtocol tPortProtocol;		///< Art-Net 4
@@ -192,6 +187,22 @@ public:
 		return m_bDirectUpdate;
 	}
 
+	/**
+	 * Without ArtSync the output ports are staged and committed together,
+	 * when all the enabled output ports received an ArtDmx
+	 */
+	void SetOutputBarrier(bool bOutputBarrier) {
+		m_bOutputBarrier = bOutputBarrier;
+		UpdateBarrier();
+	}
+	bool GetOutputBarrier() const {
+		return m_bOutputBarrier;
+	}
+
+	const LightSetBarrier& GetBarrier() const {
+		return m_Barrier;
+	}
+
 	void SetShortName(const char *);
 	const char *GetShortName() const {
 		return m_Node.ShortName;
@@ -314,9 +325,8 @@ private:
 
 	uint16_t MakePortAddress(uint16_t, uint8_t nPage = 0);
 
-	bool IsMergedDmxDataChanged(uint8_t, const uint8_t *, uint16_t);
-	void CheckMergeTimeouts(uint8_t);
-	bool IsDmxDataChanged(uint8_t, const uint8_t *, uint16_t);
+	void UpdateMergeStatus(uint32_t nPortIndex);
+	void UpdateBarrier();
 
 	void SendPollRelply(bool);
 	void SendTod(uint8_t nPortId = 0);
@@ -357,7 +367,11 @@ private:
 	struct TOutputPort m_OutputPorts[ARTNET_NODE_MAX_PORTS_OUTPUT];
 	struct TInputPort m_InputPorts[ARTNET_NODE_MAX_PORTS_INPUT];
 
+	LightSetMerge m_Merge { ARTNET_NODE_MAX_PORTS_OUTPUT, artnet::MERGE_TIMEOUT_SECONDS };
+
 	bool m_bDirectUpdate { false };
+	bool m_bOutputBarrier { false };
+	LightSetBarrier m_Barrier;
 
 	uint32_t m_nCurrentPacketMillis { 0 };
 	uint32_t m_nPreviousPacketMillis { 0 };
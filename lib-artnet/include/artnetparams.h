@@ -102,6 +102,7 @@ struct ArtnetParamsMask {
 	static constexpr auto PROTOCOL_D = (1U << 26);
 	static constexpr auto ENABLE_NO_CHANGE_OUTPUT = (1U << 27);
 	static constexpr auto DIRECTION = (1U << 28);
+	static constexpr auto OUTPUT_BARRIER = (1U << 29);
 };
 
 class ArtNetParamsStore {
@@ -173,6 +174,10 @@ public:
 		return isMaskSet(ArtnetParamsMask::ENABLE_NO_CHANGE_OUTPUT);
 	}
 
+	bool IsOutputBarrier() const {
+		return isMaskSet(ArtnetParamsMask::OUTPUT_BARRIER);
+	}
+
 	artnet::PortDir GetDirection() const {
 		return static_cast<artnet::PortDir>(m_tArtNetParams.nDirection);
 	}
@@ -29,24 +29,28 @@
 #include "artnet.h"
 
 struct ArtNetParamsConst {
-	static const char FILE_NAME[];
+	static constexpr char FILE_NAME[] = "artnet.txt";
 
-	static const char NET[];
-	static const char SUBNET[];
-	static const char USE_TIMECODE[];
-	static const char USE_TIMESYNC[];
-	static const char ENABLE_RDM[];
-	static const char RDM_DISCOVERY[];
-	static const char NODE_SHORT_NAME[];
-	static const char NODE_LONG_NAME[];
-	static const char NODE_MANUFACTURER_ID[];
-	static const char NODE_OEM_VALUE[];
-	static const char NODE_NETWORK_DATA_LOSS_TIMEOUT[];
-	static const char NODE_DISABLE_MERGE_TIMEOUT[];
-	static const char PROTOCOL[];
-	static const char PROTOCOL_PORT[ArtNet::MAX_PORTS][16];
-	static const char DIRECTION[];
-	static const char DESTINATION_IP_PORT[ArtNet::MAX_PORTS][24];
+	static constexpr char NET[] = "net";
+	static constexpr char SUBNET[] = "subnet";
+	static constexpr char USE_TIMECODE[] = "use_timecode";
+	static constexpr char USE_TIMESYNC[] = "use_timesync";
+	static constexpr char ENABLE_RDM[] = "enable_rdm";
+	static constexpr char RDM_DISCOVERY[] = "rdm_discovery_at_startup";
+	static constexpr char NODE_SHORT_NAME[] = "short_name";
+	static constexpr char NODE_LONG_NAME[] = "long_name";
+	static constexpr char NODE_MANUFACTURER_ID[] = "manufacturer_id";
+	static constexpr char NODE_OEM_VALUE[] = "oem_value";
+	static constexpr char NODE_NETWORK_DATA_LOSS_TIMEOUT[] = "network_data_loss_timeout";
+	static constexpr char NODE_DISABLE_MERGE_TIMEOUT[] = "disable_merge_timeout";
+	static constexpr char PROTOCOL[] = "protocol";
+	static constexpr char PROTOCOL_PORT[ArtNet::MAX_PORTS][16] = {
+			"protocol_port_a", "protocol_port_b", "protocol_port_c",
+			"protocol_port_d" };
+	static constexpr char DIRECTION[] = "direction";
+	static constexpr char DESTINATION_IP_PORT[ArtNet::MAX_PORTS][24] = {
+			"destination_ip_port_a", "destination_ip_port_b",
+			"destination_ip_port_c", "destination_ip_port_d" };
 };
 
 #endif /* ARTNETPARAMSCONST_H_ */
@@ -255,6 +255,12 @@ void ArtNetController::HandleTrigger() {
 	DEBUG_EXIT
 }
 
+void ArtNetController::HandleTimeCode() {
+	const auto *pArtTimeCode = &m_pArtNetPacket->ArtPacket.ArtTimeCode;
+
+	m_pArtNetTimeCode->Handler(reinterpret_cast<const struct TArtNetTimeCode*>(&pArtTimeCode->Frames));
+}
+
 void ArtNetController::HandlePoll() {
 	const uint32_t nCurrentMillis = Hardware::Get()->Millis();
 
@@ -324,6 +330,11 @@ void ArtNetController::Run() {
 			HandleTrigger();
 		}
 		break;
+	case OP_TIMECODE:
+		if (m_pArtNetTimeCode != nullptr) {
+			HandleTimeCode();
+		}
+		break;
 	default:
 		break;
 	}
@@ -116,8 +116,8 @@ ArtNetNode::~ArtNetNode() {
 }
 
 void ArtNetNode::Start() {
-	m_Node.Status2 = (m_Node.Status2 & ~(ArtNetStatus2::IP_DHCP)) | (Network::Get()->IsDhcpUsed() ? ArtNetStatus2::IP_DHCP : ArtNetStatus2::IP_MANUALY);
-	m_Node.Status2 = (m_Node.Status2 & ~(ArtNetStatus2::DHCP_CAPABLE)) | (Network::Get()->IsDhcpCapable() ? ArtNetStatus2::DHCP_CAPABLE : 0);
+	m_Node.Status2 = static_cast<uint8_t>((m_Node.Status2 & ~(ArtNetStatus2::IP_DHCP)) | (Network::Get()->IsDhcpUsed() ? ArtNetStatus2::IP_DHCP : ArtNetStatus2::IP_MANUALY));
+	m_Node.Status2 = static_cast<uint8_t>((m_Node.Status2 & ~(ArtNetStatus2::DHCP_CAPABLE)) | (Network::Get()->IsDhcpCapable() ? ArtNetStatus2::DHCP_CAPABLE : 0));
 
 	FillPollReply();
 #if defined ( ENABLE_SENDDIAG )
@@ -161,7 +161,7 @@ void ArtNetNode::Stop() {
 	}
 
 	LedBlink::Get()->SetMode(ledblink::Mode::OFF_OFF);
-	m_Node.Status1 = (m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_MUTE_MODE;
+	m_Node.Status1 = static_cast<uint8_t>((m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_MUTE_MODE);
 
 	m_State.status = ARTNET_OFF;
 }
@@ -219,10 +219,8 @@ void ArtNetNode::SetNetworkDataLossCondition() {
 			m_IsLightSetRunning[i] = false;
 		}
 
-		m_OutputPorts[i].port.nStatus &= (~GO_DATA_IS_BEING_TRANSMITTED);
-		m_OutputPorts[i].nLength = 0;
-		m_OutputPorts[i].ipA = 0;
-		m_OutputPorts[i].ipB = 0;
+		m_OutputPorts[i].port.nStatus &= static_cast<uint8_t>(~(GO_DATA_IS_BEING_TRANSMITTED | GO_OUTPUT_IS_MERGING));
+		m_Merge.Reset(i);
 	}
 }
 
@@ -73,6 +73,7 @@ int ArtNetNode::SetUniverseSwitch(uint8_t nPortIndex, artnet::PortDir dir, uint8
 			}
 		}
 
+		UpdateBarrier();
 		return ARTNET_EOK;
 	}
 
@@ -129,6 +130,7 @@ int ArtNetNode::SetUniverseSwitch(uint8_t nPortIndex, artnet::PortDir dir, uint8
 		}
 	}
 
+	UpdateBarrier();
 	return ARTNET_EOK;
 }
 
@@ -212,11 +214,12 @@ void ArtNetNode::SetPortProtocol(uint8_t nPortIndex, PortProtocol tPortProtocol)
 		assert(nPortIndex < ARTNET_NODE_MAX_PORTS_OUTPUT);
 
 		m_OutputPorts[nPortIndex].tPortProtocol = tPortProtocol;
+		UpdateBarrier();
 
 		if (tPortProtocol == PortProtocol::SACN) {
 			m_OutputPorts[nPortIndex].port.nStatus |= GO_OUTPUT_IS_SACN;
 		} else {
-			m_OutputPorts[nPortIndex].port.nStatus &= (~GO_OUTPUT_IS_SACN);
+			m_OutputPorts[nPortIndex].port.nStatus &= static_cast<uint8_t>(~GO_OUTPUT_IS_SACN);
 		}
 
 		if (m_State.status == ARTNET_ON) {
@@ -242,11 +245,12 @@ void ArtNetNode::SetMergeMode(uint8_t nPortIndex, Merge tMergeMode) {
 	assert(nPortIndex < (ArtNet::MAX_PORTS * ArtNet::MAX_PAGES));
 
 	m_OutputPorts[nPortIndex].mergeMode = tMergeMode;
+	m_Merge.SetMode(nPortIndex, tMergeMode == Merge::LTP ? lightset::merge::Mode::LTP : lightset::merge::Mode::HTP);
 
 	if (tMergeMode == Merge::LTP) {
 		m_OutputPorts[nPortIndex].port.nStatus |= GO_MERGE_MODE_LTP;
 	} else {
-		m_OutputPorts[nPortIndex].port.nStatus &= (~GO_MERGE_MODE_LTP);
+		m_OutputPorts[nPortIndex].port.nStatus &= static_cast<uint8_t>(~GO_MERGE_MODE_LTP);
 	}
 
 	if (m_State.status == ARTNET_ON) {
@@ -288,13 +292,13 @@ void ArtNetNode::HandleAddress() {
 	if (pArtAddress->SubSwitch == PROGRAM_DEFAULTS) {
 		SetSubnetSwitch(defaults::SUBNET_SWITCH, nPage);
 	} else if (pArtAddress->SubSwitch & PROGRAM_CHANGE_MASK) {
-		SetSubnetSwitch(pArtAddress->SubSwitch & ~PROGRAM_CHANGE_MASK, nPage);
+		SetSubnetSwitch(static_cast<uint8_t>(pArtAddress->SubSwitch & ~PROGRAM_CHANGE_MASK), nPage);
 	}
 
 	if (pArtAddress->NetSwitch == PROGRAM_DEFAULTS) {
 		SetNetSwitch(defaults::NET_SWITCH, nPage);
 	} else if (pArtAddress->NetSwitch & PROGRAM_CHANGE_MASK) {
-		SetNetSwitch(pArtAddress->NetSwitch & ~PROGRAM_CHANGE_MASK, nPage);
+		SetNetSwitch(static_cast<uint8_t>(pArtAddress->NetSwitch & ~PROGRAM_CHANGE_MASK), nPage);
 	}
 
 	uint8_t nPortIndex = nPage * ArtNet::MAX_PORTS;
@@ -304,14 +308,14 @@ void ArtNetNode::HandleAddress() {
 		} else if (pArtAddress->SwOut[i] == PROGRAM_DEFAULTS) {
 			SetUniverseSwitch(nPortIndex, PortDir::OUTPUT, defaults::UNIVERSE);
 		} else if (pArtAddress->SwOut[i] & PROGRAM_CHANGE_MASK) {
-			SetUniverseSwitch(nPortIndex, PortDir::OUTPUT, pArtAddress->SwOut[i] & ~PROGRAM_CHANGE_MASK);
+			SetUniverseSwitch(nPortIndex, PortDir::OUTPUT, static_cast<uint8_t>(pArtAddress->SwOut[i] & ~PROGRAM_CHANGE_MASK));
 		}
 
 		if (pArtAddress->SwIn[i] == PROGRAM_NO_CHANGE) {
 		} else if (pArtAddress->SwIn[i] == PROGRAM_DEFAULTS) {
 			SetUniverseSwitch(nPortIndex, PortDir::INPUT, defaults::UNIVERSE);
 		} else if (pArtAddress->SwIn[i] & PROGRAM_CHANGE_MASK) {
-			SetUniverseSwitch(nPortIndex, PortDir::INPUT, pArtAddress->SwIn[i] & ~PROGRAM_CHANGE_MASK);
+			SetUniverseSwitch(nPortIndex, PortDir::INPUT, static_cast<uint8_t>(pArtAddress->SwIn[i] & ~PROGRAM_CHANGE_MASK));
 		}
 
 		nPortIndex++;
@@ -320,23 +324,22 @@ void ArtNetNode::HandleAddress() {
 	switch (pArtAddress->Command) {
 	case ARTNET_PC_CANCEL:
 		// If Node is currently in merge mode, cancel merge mode upon receipt of next ArtDmx packet.
-		m_State.IsMergeMode = false;
 		for (uint32_t i = 0; i < (ArtNet::MAX_PORTS * m_nPages); i++) {
-			m_OutputPorts[i].port.nStatus &= (~GO_OUTPUT_IS_MERGING);
+			m_OutputPorts[i].bMergeCancel = m_Merge.IsMerging(i);
 		}
 		break;
 
 	case ARTNET_PC_LED_NORMAL:
 		LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
-		m_Node.Status1 = (m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_NORMAL_MODE;
+		m_Node.Status1 = static_cast<uint8_t>((m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_NORMAL_MODE);
 		break;
 	case ARTNET_PC_LED_MUTE:
 		LedBlink::Get()->SetMode(ledblink::Mode::OFF_OFF);
-		m_Node.Status1 = (m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_MUTE_MODE;
+		m_Node.Status1 = static_cast<uint8_t>((m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_MUTE_MODE);
 		break;
 	case ARTNET_PC_LED_LOCATE:
 		LedBlink::Get()->SetMode(ledblink::Mode::FAST);
-		m_Node.Status1 = (m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_LOCATE_MODE;
+		m_Node.Status1 = static_cast<uint8_t>((m_Node.Status1 & ~STATUS1_INDICATOR_MASK) | STATUS1_INDICATOR_LOCATE_MODE);
 		break;
 
 	case ARTNET_PC_MERGE_LTP_O:
@@ -372,12 +375,9 @@ void ArtNetNode::HandleAddress() {
 	case ARTNET_PC_CLR_2:
 	case ARTNET_PC_CLR_3:
 		nPort = pArtAddress->Command & 0x3;
-		for (uint32_t i = 0; i < ArtNet::DMX_LENGTH; i++) {
-			m_OutputPorts[nPort].data[i] = 0;
-		}
-		m_OutputPorts[nPort].nLength = ArtNet::DMX_LENGTH;
+		m_Merge.Clear(nPort);
 		if (m_OutputPorts[nPort].tPortProtocol == PortProtocol::ARTNET) {
-			m_pLightSet->SetData(nPort, m_OutputPorts[nPort].data, m_OutputPorts[nPort].nLength);
+			m_pLightSet->SetData(nPort, m_Merge.GetData(nPort), m_Merge.GetLength(nPort));
 		}
 		break;
 
@@ -27,107 +27,47 @@
  */
 
 #include <stdint.h>
-#include <string.h>
 #include <algorithm>
 #include <cassert>
 
 #include "artnetnode.h"
 #include "artnet.h"
 
-using namespace artnet;
-
-bool ArtNetNode::IsDmxDataChanged(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
-	assert(pData != nullptr);
-
-	auto isChanged = false;
-	const auto *pSrc = pData;
-	auto *pDst = m_OutputPorts[nPortId].data;
+#include "hardware.h"
 
-	if (nLength != m_OutputPorts[nPortId].nLength) {
-		m_OutputPorts[nPortId].nLength = nLength;
-
-		for (uint32_t i = 0; i < nLength; i++) {
-			*pDst++ = *pSrc++;
-		}
+using namespace artnet;
 
-		return true;
+void ArtNetNode::UpdateMergeStatus(uint32_t nPortIndex) {
+	if (m_Merge.IsMerging(nPortIndex)) {
+		m_OutputPorts[nPortIndex].port.nStatus |= GO_OUTPUT_IS_MERGING;
+	} else {
+		m_OutputPorts[nPortIndex].port.nStatus &= static_cast<uint8_t>(~GO_OUTPUT_IS_MERGING);
 	}
 
-	for (uint32_t i = 0; i < nLength; i++) {
-		if (*pDst != *pSrc) {
-			isChanged = true;
-		}
-		*pDst++ = *pSrc++;
-	}
+	const auto bIsMerging = m_Merge.IsMerging();
 
-	return isChanged;
-}
-
-bool ArtNetNode::IsMergedDmxDataChanged(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
-	assert(pData != nullptr);
-
-	auto isChanged = false;
-
-	if (!m_State.IsMergeMode) {
-		m_State.IsMergeMode = true;
+	if (bIsMerging != m_State.IsMergeMode) {
+		m_State.IsMergeMode = bIsMerging;
 		m_State.IsChanged = true;
-	}
-
-	m_OutputPorts[nPortId].port.nStatus |= GO_OUTPUT_IS_MERGING;
-
-	if (m_OutputPorts[nPortId].mergeMode == Merge::HTP) {
-
-		if (nLength != m_OutputPorts[nPortId].nLength) {
-			m_OutputPorts[nPortId].nLength = nLength;
-			for (uint32_t i = 0; i < nLength; i++) {
-				uint8_t data = std::max(m_OutputPorts[nPortId].dataA[i], m_OutputPorts[nPortId].dataB[i]);
-				m_OutputPorts[nPortId].data[i] = data;
-			}
-			return true;
-		}
-
-		for (uint32_t i = 0; i < nLength; i++) {
-			uint8_t data = std::max(m_OutputPorts[nPortId].dataA[i], m_OutputPorts[nPortId].dataB[i]);
-			if (data != m_OutputPorts[nPortId].data[i]) {
-				m_OutputPorts[nPortId].data[i] = data;
-				isChanged = true;
-			}
-		}
-
-		return isChanged;
-	} else {
-		return IsDmxDataChanged(nPortId, pData, nLength);
+#if defined ( ENABLE_SENDDIAG )
+		SendDiag(bIsMerging ? "Entering Merging Mode" : "Leaving Merging Mode", ARTNET_DP_LOW);
+#endif
 	}
 }
 
-void ArtNetNode::CheckMergeTimeouts(uint8_t nPortId) {
-	const uint32_t nTimeOutAMillis = m_nCurrentPacketMillis - m_OutputPorts[nPortId].nMillisA;
-
-	if (nTimeOutAMillis > (artnet::MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPorts[nPortId].ipA = 0;
-		m_OutputPorts[nPortId].port.nStatus &= (~GO_OUTPUT_IS_MERGING);
-	}
-
-	const uint32_t nTimeOutBMillis = m_nCurrentPacketMillis - m_OutputPorts[nPortId].nMillisB;
-
-	if (nTimeOutBMillis > (artnet::MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPorts[nPortId].ipB = 0;
-		m_OutputPorts[nPortId].port.nStatus &= (~GO_OUTPUT_IS_MERGING);
-	}
-
-	bool bIsMerging = false;
+/*
+ * The expected ports of the output barrier, updated when the output ports or their protocol change
+ */
+void ArtNetNode::UpdateBarrier() {
+	uint32_t nPortMask = 0;
 
 	for (uint32_t i = 0; i < (ArtNet::MAX_PORTS * m_nPages); i++) {
-		bIsMerging |= ((m_OutputPorts[i].port.nStatus & GO_OUTPUT_IS_MERGING) != 0);
+		if (m_OutputPorts[i].bIsEnabled && (m_OutputPorts[i].tPortProtocol == PortProtocol::ARTNET)) {
+			nPortMask |= (1U << i);
+		}
 	}
 
-	if (!bIsMerging) {
-		m_State.IsChanged = true;
-		m_State.IsMergeMode = false;
-#if defined ( ENABLE_SENDDIAG )
-		SendDiag("Leaving Merging Mode", ARTNET_DP_LOW);
-#endif
-	}
+	m_Barrier.SetExpected(nPortMask);
 }
 
 void ArtNetNode::HandleDmx() {
@@ -136,90 +76,42 @@ void ArtNetNode::HandleDmx() {
 	auto data_length = (static_cast<uint32_t>(pArtDmx->LengthHi << 8) & 0xff00) | pArtDmx->Length;
 	data_length = std::min(data_length, ArtNet::DMX_LENGTH);
 
+	if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
+		m_Merge.Run(m_nCurrentPacketMillis);
+	}
+
 	for (uint32_t i = 0; i < (ArtNet::MAX_PORTS * m_nPages); i++) {
 
 		if (m_OutputPorts[i].bIsEnabled && (m_OutputPorts[i].tPortProtocol == PortProtocol::ARTNET) && (pArtDmx->PortAddress == m_OutputPorts[i].port.nPortAddress)) {
 
-			uint32_t ipA = m_OutputPorts[i].ipA;
-			uint32_t ipB = m_OutputPorts[i].ipB;
+			m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus | GO_DATA_IS_BEING_TRANSMITTED;
 
-			bool sendNewData = false;
+			auto nSourceIndex = m_Merge.FindSource(i, m_ArtNetPacket.IPAddressFrom);
 
-			m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus | GO_DATA_IS_BEING_TRANSMITTED;
+			if (nSourceIndex == lightset::merge::INVALID_SOURCE) {
+				nSourceIndex = m_Merge.AddSource(i, m_ArtNetPacket.IPAddressFrom);
 
-			if (m_State.IsMergeMode) {
-				if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
-					CheckMergeTimeouts(i);
+				if (nSourceIndex == lightset::merge::INVALID_SOURCE) {
+#if defined ( ENABLE_SENDDIAG )
+					SendDiag("Too many sources, discarding data", ARTNET_DP_LOW);
+#endif
+					continue;
 				}
 			}
 
-			if (ipA == 0 && ipB == 0) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("1. first packet recv on this port", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].nMillisA = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataA, pArtDmx->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, pArtDmx->Data, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == 0) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("2. continued transmission from the same ip (source A)", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].nMillisA = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataA, pArtDmx->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, pArtDmx->Data, data_length);
-			} else if (ipA == 0 && ipB == m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("3. continued transmission from the same ip (source B)", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].nMillisB = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataB, pArtDmx->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, pArtDmx->Data, data_length);
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == 0) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("4. new source, start the merge", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].ipB = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].nMillisB = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataB, pArtDmx->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
-			} else if (ipA == 0 && ipB != m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("5. new source, start the merge", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].nMillisA = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataA, pArtDmx->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("6. continue merge", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].nMillisA = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataA, pArtDmx->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("7. continue merge", ARTNET_DP_LOW);
-#endif
-				m_OutputPorts[i].nMillisB = m_nCurrentPacketMillis;
-				memcpy(&m_OutputPorts[i].dataB, pArtDmx->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("8. Source matches both buffers, this shouldn't be happening!", ARTNET_DP_LOW);
-#endif
-				return;
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("9. More than two sources, discarding data", ARTNET_DP_LOW);
-#endif
-				return;
-			} else {
-#if defined ( ENABLE_SENDDIAG )
-				SendDiag("0. No cases matched, this shouldn't happen!", ARTNET_DP_LOW);
-#endif
-				return;
+			if (m_OutputPorts[i].bMergeCancel) {
+				m_OutputPorts[i].bMergeCancel = false;
+				m_Merge.CancelMerge(i, nSourceIndex);
+			}
+
+			const auto sendNewData = m_Merge.SetData(i, nSourceIndex, lightset::merge::DEFAULT_PRIORITY, pArtDmx->Data, data_length, m_nCurrentPacketMillis);
+
+			UpdateMergeStatus(i);
+
+			// A repeated port commits the pending frame before its new data is staged
+			if (m_bOutputBarrier && !m_State.IsSynchronousMode && m_Barrier.IsRepeated(i)) {
+				m_pLightSet->Commit();
+				m_Barrier.Commit();
 			}
 
 			if (sendNewData || m_bDirectUpdate) {
@@ -227,7 +119,11 @@ void ArtNetNode::HandleDmx() {
 #if defined ( ENABLE_SENDDIAG )
 					SendDiag("Send new data", ARTNET_DP_LOW);
 #endif
-					m_pLightSet->SetData(i, m_OutputPorts[i].data, m_OutputPorts[i].nLength);
+					if (m_bOutputBarrier) {
+						m_pLightSet->Stage(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+					} else {
+						m_pLightSet->SetData(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+					}
 
 					if(!m_IsLightSetRunning[i]) {
 						m_pLightSet->Start(i);
@@ -246,6 +142,14 @@ void ArtNetNode::HandleDmx() {
 #endif
 			}
 
+			// With ArtSync the barrier only measures the skew, ArtSync commits
+			if (m_bOutputBarrier || m_State.IsSynchronousMode) {
+				if (m_Barrier.Arrive(i, Hardware::Get()->Micros()) && !m_State.IsSynchronousMode) {
+					m_pLightSet->Commit();
+					m_Barrier.Commit();
+				}
+			}
+
 			m_State.bIsReceivingDmx = true;
 		}
 	}
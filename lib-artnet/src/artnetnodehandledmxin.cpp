@@ -86,7 +86,7 @@ void ArtNetNode::HandleDmxIn() {
 			} else {
 				if ((m_InputPorts[i].port.nStatus & GO_DATA_IS_BEING_TRANSMITTED) == GO_DATA_IS_BEING_TRANSMITTED) {
 					if (nUpdatesPerSecond == 0) {
-						m_InputPorts[i].port.nStatus = m_InputPorts[i].port.nStatus & ~GI_DATA_RECIEVED;
+						m_InputPorts[i].port.nStatus = static_cast<uint8_t>(m_InputPorts[i].port.nStatus & ~GI_DATA_RECIEVED);
 						s_ReceivingMask &= ~(1U << i);
 						m_State.bIsReceivingDmx = (s_ReceivingMask != 0);
 					}
@@ -72,7 +72,7 @@ void ArtNetNode::HandleIpProg() {
 		// Update Node network details
 		m_Node.IPAddressLocal = Network::Get()->GetIp();
 		m_Node.IPAddressBroadcast = m_Node.IPAddressLocal | ~(Network::Get()->GetNetmask());
-		m_Node.Status2 = (m_Node.Status2 & (~(ArtNetStatus2::IP_DHCP))) | (Network::Get()->IsDhcpUsed() ? ArtNetStatus2::IP_DHCP : ArtNetStatus2::IP_MANUALY);
+		m_Node.Status2 = static_cast<uint8_t>((m_Node.Status2 & (~(ArtNetStatus2::IP_DHCP))) | (Network::Get()->IsDhcpUsed() ? ArtNetStatus2::IP_DHCP : ArtNetStatus2::IP_MANUALY));
 		// Update PollReply for new IPAddress
 		memcpy(m_PollReply.IPAddress, &m_pIpProgReply->ProgIpHi, ArtNet::IP_SIZE);
 		if (m_nVersion > 3) {
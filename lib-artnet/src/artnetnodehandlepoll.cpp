@@ -108,16 +108,10 @@ void ArtNetNode::SendPollRelply(bool bResponse) {
 			uint8_t nStatus = m_OutputPorts[nPortIndex].port.nStatus;
 
 			if (m_OutputPorts[nPortIndex].tPortProtocol == PortProtocol::ARTNET) {
-				nStatus &= (~GO_DATA_IS_BEING_TRANSMITTED);
+				nStatus &= static_cast<uint8_t>(~GO_DATA_IS_BEING_TRANSMITTED);
 
-				if (m_OutputPorts[nPortIndex].ipA != 0) {
-					if ((m_nCurrentPacketMillis - m_OutputPorts[nPortIndex].nMillisA) < 1000) {
-						nStatus |= GO_DATA_IS_BEING_TRANSMITTED;
-					}
-				}
-
-				if (m_OutputPorts[nPortIndex].ipB != 0) {
-					if ((m_nCurrentPacketMillis - m_OutputPorts[nPortIndex].nMillisB) < 1000) {
+				if (m_Merge.GetActiveSources(nPortIndex) != 0) {
+					if ((m_nCurrentPacketMillis - m_Merge.GetMillis(nPortIndex)) < 1000) {
 						nStatus |= GO_DATA_IS_BEING_TRANSMITTED;
 					}
 				}
@@ -125,11 +119,12 @@ void ArtNetNode::SendPollRelply(bool bResponse) {
 				if (m_pArtNet4Handler != nullptr) {
 					const uint8_t nMask = GO_OUTPUT_IS_MERGING | GO_DATA_IS_BEING_TRANSMITTED | GO_OUTPUT_IS_SACN;
 
-					nStatus &= (~nMask);
+					nStatus &= static_cast<uint8_t>(~nMask);
 					nStatus |= (m_pArtNet4Handler->GetStatus(nPortIndex) & nMask);
 
 					if ((nStatus & GO_OUTPUT_IS_SACN) == 0) {
 						m_OutputPorts[nPortIndex].tPortProtocol = PortProtocol::ARTNET;
+						UpdateBarrier();
 					}
 				}
 			}
@@ -39,13 +39,16 @@ void ArtNetNode::HandleSync() {
 	m_State.IsSynchronousMode = true;
 	m_State.nArtSyncMillis = Hardware::Get()->Millis();
 
+	auto bIsStaged = false;
+
 	for (uint32_t i = 0; i < (m_nPages * ArtNet::MAX_PORTS); i++) {
 		if ((m_OutputPorts[i].tPortProtocol == PortProtocol::ARTNET)
 				&& ((m_OutputPorts[i].IsDataPending) || (m_OutputPorts[i].bIsEnabled && m_bDirectUpdate))) {
 #if defined ( ENABLE_SENDDIAG )
 			SendDiag("Send pending data", ARTNET_DP_LOW);
 #endif
-			m_pLightSet->SetData(i, m_OutputPorts[i].data, m_OutputPorts[i].nLength);
+			m_pLightSet->Stage(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+			bIsStaged = true;
 
 			if (!m_IsLightSetRunning[i]) {
 				m_pLightSet->Start(i);
@@ -55,4 +58,10 @@ void ArtNetNode::HandleSync() {
 			m_OutputPorts[i].IsDataPending = false;
 		}
 	}
+
+	if (bIsStaged) {
+		m_pLightSet->Commit();
+	}
+
+	m_Barrier.Commit();
 }
@@ -69,6 +69,10 @@ void ArtNetNode::Print() {
 		if (m_bDirectUpdate) {
 			printf(" Direct update : Yes\n");
 		}
+
+		if (m_bOutputBarrier) {
+			printf(" Output barrier : Yes [skew %u/%u us, %u commits]\n", m_Barrier.GetSkewMicros(), m_Barrier.GetSkewMaxMicros(), m_Barrier.GetCommits());
+		}
 	}
 
 	if (m_State.nActiveInputPorts != 0) {
@@ -49,6 +49,7 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertieskey.h"
 
 #include "propertiesbuilder.h"
 
@@ -131,171 +132,204 @@ void ArtNetParams::callbackFunction(const char *pLine) {
 	uint16_t nValue16;
 	uint32_t nValue32;
 
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::USE_TIMECODE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, ArtnetParamsMask::TIMECODE);
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::USE_TIMESYNC, nValue8) == Sscan::OK) {
-		SetBool(nValue8, ArtnetParamsMask::TIMESYNC);
-		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::ENABLE_RDM, nValue8) == Sscan::OK) {
-		SetBool(nValue8, ArtnetParamsMask::RDM);
-		return;
-	}
-
-	nLength = ArtNet::SHORT_NAME_LENGTH - 1;
-	if (Sscan::Char(pLine, ArtNetParamsConst::NODE_SHORT_NAME, reinterpret_cast<char*>(m_tArtNetParams.aShortName), nLength) == Sscan::OK) {
-		m_tArtNetParams.aShortName[nLength] = '\0';
-		m_tArtNetParams.nSetList |= ArtnetParamsMask::SHORT_NAME;
+	switch (properties::key(pLine)) {
+	case properties::hash(ArtNetParamsConst::USE_TIMECODE):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::USE_TIMECODE, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::TIMECODE);
+		}
 		return;
-	}
-
-	nLength = ArtNet::LONG_NAME_LENGTH - 1;
-	if (Sscan::Char(pLine, ArtNetParamsConst::NODE_LONG_NAME, reinterpret_cast<char*>(m_tArtNetParams.aLongName), nLength) == Sscan::OK) {
-		m_tArtNetParams.aLongName[nLength] = '\0';
-		m_tArtNetParams.nSetList |= ArtnetParamsMask::LONG_NAME;
+	case properties::hash(ArtNetParamsConst::USE_TIMESYNC):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::USE_TIMESYNC, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::TIMESYNC);
+		}
 		return;
-	}
-
-	if (Sscan::HexUint16(pLine, ArtNetParamsConst::NODE_OEM_VALUE, nValue16) == Sscan::OK) {
-		m_tArtNetParams.aOemValue[0] = (nValue16 >> 8);
-		m_tArtNetParams.aOemValue[1] = (nValue16 & 0xFF);
-		m_tArtNetParams.nSetList |= ArtnetParamsMask::OEM_VALUE;
+	case properties::hash(ArtNetParamsConst::ENABLE_RDM):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::ENABLE_RDM, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::RDM);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::NODE_NETWORK_DATA_LOSS_TIMEOUT, nValue8) == Sscan::OK) {
-		m_tArtNetParams.nNetworkTimeout = nValue8;
-		m_tArtNetParams.nSetList |= ArtnetParamsMask::NETWORK_TIMEOUT;
+	case properties::hash(ArtNetParamsConst::NODE_SHORT_NAME):
+		nLength = ArtNet::SHORT_NAME_LENGTH - 1;
+		if (Sscan::Char(pLine, ArtNetParamsConst::NODE_SHORT_NAME, reinterpret_cast<char*>(m_tArtNetParams.aShortName), nLength) == Sscan::OK) {
+			m_tArtNetParams.aShortName[nLength] = '\0';
+			m_tArtNetParams.nSetList |= ArtnetParamsMask::SHORT_NAME;
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT, nValue8) == Sscan::OK) {
-		SetBool(nValue8, ArtnetParamsMask::DISABLE_MERGE_TIMEOUT);
+	case properties::hash(ArtNetParamsConst::NODE_LONG_NAME):
+		nLength = ArtNet::LONG_NAME_LENGTH - 1;
+		if (Sscan::Char(pLine, ArtNetParamsConst::NODE_LONG_NAME, reinterpret_cast<char*>(m_tArtNetParams.aLongName), nLength) == Sscan::OK) {
+			m_tArtNetParams.aLongName[nLength] = '\0';
+			m_tArtNetParams.nSetList |= ArtnetParamsMask::LONG_NAME;
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::NET, nValue8) == Sscan::OK) {
-		if (nValue8 != 0) {
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::NET;
-		} else {
-			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::NET;
+	case properties::hash(ArtNetParamsConst::NODE_OEM_VALUE):
+		if (Sscan::HexUint16(pLine, ArtNetParamsConst::NODE_OEM_VALUE, nValue16) == Sscan::OK) {
+			m_tArtNetParams.aOemValue[0] = (nValue16 >> 8);
+			m_tArtNetParams.aOemValue[1] = (nValue16 & 0xFF);
+			m_tArtNetParams.nSetList |= ArtnetParamsMask::OEM_VALUE;
 		}
-		m_tArtNetParams.nNet = nValue8;
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, ArtNetParamsConst::SUBNET, nValue8) == Sscan::OK) {
-		if (nValue8 != 0) {
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::SUBNET;
-		} else {
-			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::SUBNET;
+	case properties::hash(ArtNetParamsConst::NODE_NETWORK_DATA_LOSS_TIMEOUT):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::NODE_NETWORK_DATA_LOSS_TIMEOUT, nValue8) == Sscan::OK) {
+			m_tArtNetParams.nNetworkTimeout = nValue8;
+			m_tArtNetParams.nSetList |= ArtnetParamsMask::NETWORK_TIMEOUT;
 		}
-		m_tArtNetParams.nSubnet = nValue8;
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LightSetConst::PARAMS_UNIVERSE, nValue8) == Sscan::OK) {
-		if ((nValue8 != 1) && (nValue8 <= 0xF)) {
-			m_tArtNetParams.nUniverse = nValue8;
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::UNIVERSE;
-		} else {
-			m_tArtNetParams.nUniverse = 1;
-			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::UNIVERSE;
+	case properties::hash(ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::DISABLE_MERGE_TIMEOUT);
 		}
 		return;
-	}
-
-	nLength = 3;
-	if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE, value, nLength) == Sscan::OK) {
-		if(ArtNet::GetMergeMode(value) == Merge::LTP) {
-			m_tArtNetParams.nMergeMode = static_cast<uint8_t>(Merge::LTP);
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::MERGE_MODE;
-			return;
+	case properties::hash(ArtNetParamsConst::NET):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::NET, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::NET;
+			} else {
+				m_tArtNetParams.nSetList &= ~ArtnetParamsMask::NET;
+			}
+			m_tArtNetParams.nNet = nValue8;
 		}
-
-		m_tArtNetParams.nMergeMode = static_cast<uint8_t>(Merge::HTP);
-		m_tArtNetParams.nSetList &= ~ArtnetParamsMask::MERGE_MODE;
 		return;
-	}
-
-	nLength = 4;
-	if (Sscan::Char(pLine, ArtNetParamsConst::PROTOCOL, value, nLength) == Sscan::OK) {
-		if(memcmp(value, "sacn", 4) == 0) {
-			m_tArtNetParams.nProtocol = static_cast<uint8_t>(PortProtocol::SACN);
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::PROTOCOL;
-		} else {
-			m_tArtNetParams.nProtocol = static_cast<uint8_t>(PortProtocol::ARTNET);
-			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::PROTOCOL;
+	case properties::hash(ArtNetParamsConst::SUBNET):
+		if (Sscan::Uint8(pLine, ArtNetParamsConst::SUBNET, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::SUBNET;
+			} else {
+				m_tArtNetParams.nSetList &= ~ArtnetParamsMask::SUBNET;
+			}
+			m_tArtNetParams.nSubnet = nValue8;
 		}
 		return;
-	}
-
-	for (unsigned i = 0; i < ArtNet::MAX_PORTS; i++) {
-		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_UNIVERSE_PORT[i], nValue8) == Sscan::OK) {
-			if ((nValue8 != (i + 1)) && (nValue8 <= 0xF)) {
-				m_tArtNetParams.nUniversePort[i] = nValue8;
-				m_tArtNetParams.nSetList |= (ArtnetParamsMask::UNIVERSE_A << i);
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_UNIVERSE, nValue8) == Sscan::OK) {
+			if ((nValue8 != 1) && (nValue8 <= 0xF)) {
+				m_tArtNetParams.nUniverse = nValue8;
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::UNIVERSE;
 			} else {
-				m_tArtNetParams.nUniversePort[i] = i + 1;
-				m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::UNIVERSE_A << i);
+				m_tArtNetParams.nUniverse = 1;
+				m_tArtNetParams.nSetList &= ~ArtnetParamsMask::UNIVERSE;
 			}
-			return;
 		}
-
+		return;
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE):
 		nLength = 3;
-		if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE_PORT[i], value, nLength) == Sscan::OK) {
+		if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE, value, nLength) == Sscan::OK) {
 			if(ArtNet::GetMergeMode(value) == Merge::LTP) {
-				m_tArtNetParams.nMergeModePort[i] = static_cast<uint8_t>(Merge::LTP);
-				m_tArtNetParams.nSetList |= (ArtnetParamsMask::MERGE_MODE_A << i);
-			} else {
-				m_tArtNetParams.nMergeModePort[i] = static_cast<uint8_t>(Merge::HTP);
-				m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::MERGE_MODE_A << i);
+				m_tArtNetParams.nMergeMode = static_cast<uint8_t>(Merge::LTP);
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::MERGE_MODE;
+				return;
 			}
-			return;
-		}
 
+			m_tArtNetParams.nMergeMode = static_cast<uint8_t>(Merge::HTP);
+			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::MERGE_MODE;
+		}
+		return;
+	case properties::hash(ArtNetParamsConst::PROTOCOL):
 		nLength = 4;
-		if (Sscan::Char(pLine, ArtNetParamsConst::PROTOCOL_PORT[i], value, nLength) == Sscan::OK) {
-			if (memcmp(value, "sacn", 4) == 0) {
-				m_tArtNetParams.nProtocolPort[i] = static_cast<uint8_t>(PortProtocol::SACN);
-				m_tArtNetParams.nSetList |= (ArtnetParamsMask::PROTOCOL_A << i);
+		if (Sscan::Char(pLine, ArtNetParamsConst::PROTOCOL, value, nLength) == Sscan::OK) {
+			if(memcmp(value, "sacn", 4) == 0) {
+				m_tArtNetParams.nProtocol = static_cast<uint8_t>(PortProtocol::SACN);
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::PROTOCOL;
 			} else {
-				m_tArtNetParams.nProtocolPort[i] = static_cast<uint8_t>(PortProtocol::ARTNET);
-				m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::PROTOCOL_A << i);
+				m_tArtNetParams.nProtocol = static_cast<uint8_t>(PortProtocol::ARTNET);
+				m_tArtNetParams.nSetList &= ~ArtnetParamsMask::PROTOCOL;
 			}
-			return;
 		}
-
-		if (Sscan::IpAddress(pLine, ArtNetParamsConst::DESTINATION_IP_PORT[i], nValue32) == Sscan::OK) {
-			m_tArtNetParams.nDestinationIpPort[i] = nValue32;
-
-			if (nValue32 != 0) {
-				m_tArtNetParams.nMultiPortOptions |= (ArtnetParamsMaskMultiPortOptions::DESTINATION_IP_A << i);
-			} else {
-				m_tArtNetParams.nMultiPortOptions &= ~(ArtnetParamsMaskMultiPortOptions::DESTINATION_IP_A << i);
+		return;
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[0]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[1]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[2]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[3]):
+		for (unsigned i = 0; i < ArtNet::MAX_PORTS; i++) {
+			if (Sscan::Uint8(pLine, LightSetConst::PARAMS_UNIVERSE_PORT[i], nValue8) == Sscan::OK) {
+				if ((nValue8 != (i + 1)) && (nValue8 <= 0xF)) {
+					m_tArtNetParams.nUniversePort[i] = nValue8;
+					m_tArtNetParams.nSetList |= (ArtnetParamsMask::UNIVERSE_A << i);
+				} else {
+					m_tArtNetParams.nUniversePort[i] = i + 1;
+					m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::UNIVERSE_A << i);
+				}
+				return;
 			}
 		}
-	}
-
-	if (Sscan::Uint8(pLine, LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, ArtnetParamsMask::ENABLE_NO_CHANGE_OUTPUT);
 		return;
-	}
-
-	nLength = 5;
-	if (Sscan::Char(pLine, ArtNetParamsConst::DIRECTION, value, nLength) == Sscan::OK) {
-		if (memcmp(value, "input", 5) == 0) {
-			m_tArtNetParams.nDirection = static_cast<uint8_t>(PortDir::INPUT);
-			m_tArtNetParams.nSetList |= ArtnetParamsMask::DIRECTION;
-		} else {
-			m_tArtNetParams.nDirection = static_cast<uint8_t>(PortDir::OUTPUT);
-			m_tArtNetParams.nSetList &= ~ArtnetParamsMask::DIRECTION;
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[0]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[1]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[2]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[3]):
+		for (unsigned i = 0; i < ArtNet::MAX_PORTS; i++) {
+			nLength = 3;
+			if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE_PORT[i], value, nLength) == Sscan::OK) {
+				if(ArtNet::GetMergeMode(value) == Merge::LTP) {
+					m_tArtNetParams.nMergeModePort[i] = static_cast<uint8_t>(Merge::LTP);
+					m_tArtNetParams.nSetList |= (ArtnetParamsMask::MERGE_MODE_A << i);
+				} else {
+					m_tArtNetParams.nMergeModePort[i] = static_cast<uint8_t>(Merge::HTP);
+					m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::MERGE_MODE_A << i);
+				}
+				return;
+			}
+		}
+		return;
+	case properties::hash(ArtNetParamsConst::PROTOCOL_PORT[0]):
+	case properties::hash(ArtNetParamsConst::PROTOCOL_PORT[1]):
+	case properties::hash(ArtNetParamsConst::PROTOCOL_PORT[2]):
+	case properties::hash(ArtNetParamsConst::PROTOCOL_PORT[3]):
+		for (unsigned i = 0; i < ArtNet::MAX_PORTS; i++) {
+			nLength = 4;
+			if (Sscan::Char(pLine, ArtNetParamsConst::PROTOCOL_PORT[i], value, nLength) == Sscan::OK) {
+				if (memcmp(value, "sacn", 4) == 0) {
+					m_tArtNetParams.nProtocolPort[i] = static_cast<uint8_t>(PortProtocol::SACN);
+					m_tArtNetParams.nSetList |= (ArtnetParamsMask::PROTOCOL_A << i);
+				} else {
+					m_tArtNetParams.nProtocolPort[i] = static_cast<uint8_t>(PortProtocol::ARTNET);
+					m_tArtNetParams.nSetList &= ~(ArtnetParamsMask::PROTOCOL_A << i);
+				}
+				return;
+			}
 		}
 		return;
+	case properties::hash(ArtNetParamsConst::DESTINATION_IP_PORT[0]):
+	case properties::hash(ArtNetParamsConst::DESTINATION_IP_PORT[1]):
+	case properties::hash(ArtNetParamsConst::DESTINATION_IP_PORT[2]):
+	case properties::hash(ArtNetParamsConst::DESTINATION_IP_PORT[3]):
+		for (unsigned i = 0; i < ArtNet::MAX_PORTS; i++) {
+			if (Sscan::IpAddress(pLine, ArtNetParamsConst::DESTINATION_IP_PORT[i], nValue32) == Sscan::OK) {
+				m_tArtNetParams.nDestinationIpPort[i] = nValue32;
+
+				if (nValue32 != 0) {
+					m_tArtNetParams.nMultiPortOptions |= (ArtnetParamsMaskMultiPortOptions::DESTINATION_IP_A << i);
+				} else {
+					m_tArtNetParams.nMultiPortOptions &= ~(ArtnetParamsMaskMultiPortOptions::DESTINATION_IP_A << i);
+				}
+				return;
+			}
+		}
+		return;
+	case properties::hash(LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::ENABLE_NO_CHANGE_OUTPUT);
+		}
+		return;
+	case properties::hash(LightSetConst::PARAMS_OUTPUT_BARRIER):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_OUTPUT_BARRIER, nValue8) == Sscan::OK) {
+			SetBool(nValue8, ArtnetParamsMask::OUTPUT_BARRIER);
+		}
+		return;
+	case properties::hash(ArtNetParamsConst::DIRECTION):
+		nLength = 5;
+		if (Sscan::Char(pLine, ArtNetParamsConst::DIRECTION, value, nLength) == Sscan::OK) {
+			if (memcmp(value, "input", 5) == 0) {
+				m_tArtNetParams.nDirection = static_cast<uint8_t>(PortDir::INPUT);
+				m_tArtNetParams.nSetList |= ArtnetParamsMask::DIRECTION;
+			} else {
+				m_tArtNetParams.nDirection = static_cast<uint8_t>(PortDir::OUTPUT);
+				m_tArtNetParams.nSetList &= ~ArtnetParamsMask::DIRECTION;
+			}
+		}
+		return;
+	default:
+		return;
 	}
 }
 
@@ -27,25 +27,25 @@
 
 #include "artnet.h"
 
-const char ArtNetParamsConst::FILE_NAME[] = "artnet.txt";
+constexpr char ArtNetParamsConst::FILE_NAME[];
 
-const char ArtNetParamsConst::NET[] = "net";
-const char ArtNetParamsConst::SUBNET[] = "subnet";
+constexpr char ArtNetParamsConst::NET[];
+constexpr char ArtNetParamsConst::SUBNET[];
 
-const char ArtNetParamsConst::USE_TIMECODE[] = "use_timecode";
-const char ArtNetParamsConst::USE_TIMESYNC[] = "use_timesync";
+constexpr char ArtNetParamsConst::USE_TIMECODE[];
+constexpr char ArtNetParamsConst::USE_TIMESYNC[];
 
-const char ArtNetParamsConst::ENABLE_RDM[] = "enable_rdm";
-const char ArtNetParamsConst::RDM_DISCOVERY[] = "rdm_discovery_at_startup";
+constexpr char ArtNetParamsConst::ENABLE_RDM[];
+constexpr char ArtNetParamsConst::RDM_DISCOVERY[];
 
-const char ArtNetParamsConst::NODE_SHORT_NAME[] = "short_name";
-const char ArtNetParamsConst::NODE_LONG_NAME[] = "long_name";
-const char ArtNetParamsConst::NODE_MANUFACTURER_ID[] = "manufacturer_id";
-const char ArtNetParamsConst::NODE_OEM_VALUE[] = "oem_value";
-const char ArtNetParamsConst::NODE_NETWORK_DATA_LOSS_TIMEOUT[] = "network_data_loss_timeout";
-const char ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT[] = "disable_merge_timeout";
+constexpr char ArtNetParamsConst::NODE_SHORT_NAME[];
+constexpr char ArtNetParamsConst::NODE_LONG_NAME[];
+constexpr char ArtNetParamsConst::NODE_MANUFACTURER_ID[];
+constexpr char ArtNetParamsConst::NODE_OEM_VALUE[];
+constexpr char ArtNetParamsConst::NODE_NETWORK_DATA_LOSS_TIMEOUT[];
+constexpr char ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT[];
 
-const char ArtNetParamsConst::PROTOCOL[] = "protocol";
-const char ArtNetParamsConst::PROTOCOL_PORT[ArtNet::MAX_PORTS][16] = { "protocol_port_a", "protocol_port_b", "protocol_port_c", "protocol_port_d" };
-const char ArtNetParamsConst::DIRECTION[] = "direction";
-const char ArtNetParamsConst::DESTINATION_IP_PORT[ArtNet::MAX_PORTS][24] = { "destination_ip_port_a", "destination_ip_port_b", "destination_ip_port_c", "destination_ip_port_d" };
+constexpr char ArtNetParamsConst::PROTOCOL[];
+constexpr char ArtNetParamsConst::PROTOCOL_PORT[ArtNet::MAX_PORTS][16];
+constexpr char ArtNetParamsConst::DIRECTION[];
+constexpr char ArtNetParamsConst::DESTINATION_IP_PORT[ArtNet::MAX_PORTS][24];
@@ -120,6 +120,10 @@ void ArtNetParams::Dump() {
 		printf(" %s=1 [Yes]\n", LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE);
 	}
 
+	if(isMaskSet(ArtnetParamsMask::OUTPUT_BARRIER)) {
+		printf(" %s=1 [Yes]\n", LightSetConst::PARAMS_OUTPUT_BARRIER);
+	}
+
 	if(isMaskSet(ArtnetParamsMask::DIRECTION)) {
 		printf(" %s=%d [%s]\n", ArtNetParamsConst::DIRECTION, static_cast<int>(m_tArtNetParams.nDirection), m_tArtNetParams.nDirection == static_cast<uint8_t>(PortDir::INPUT) ? "Input" : "Output");
 	}
@@ -93,6 +93,7 @@ void ArtNetParams::Builder(const struct TArtNetParams *pArtNetParams, char *pBuf
 	builder.Add(ArtNetParamsConst::NODE_DISABLE_MERGE_TIMEOUT, isMaskSet(ArtnetParamsMask::DISABLE_MERGE_TIMEOUT));
 
 	builder.Add(LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, isMaskSet(ArtnetParamsMask::ENABLE_NO_CHANGE_OUTPUT));
+	builder.Add(LightSetConst::PARAMS_OUTPUT_BARRIER, isMaskSet(ArtnetParamsMask::OUTPUT_BARRIER));
 
 	builder.AddComment("DMX Input");
 	for (uint32_t i = 0; i < ARTNET_NODE_MAX_PORTS_INPUT; i++) {
@@ -103,4 +103,8 @@ void ArtNetParams::Set(ArtNetNode *pArtNetNode) {
 	if (isMaskSet(ArtnetParamsMask::ENABLE_NO_CHANGE_OUTPUT)) {
 		pArtNetNode->SetDirectUpdate(true);
 	}
+
+	if (isMaskSet(ArtnetParamsMask::OUTPUT_BARRIER)) {
+		pArtNetNode->SetOutputBarrier(true);
+	}
 }
@@ -0,0 +1,67 @@
+/**
+ * @file bcm2835.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * The bcm2835 SPI and GPIO functions used by the host examples, built with -DRASPPI.
+ * Each example implements the functions it needs: lib-l6470 simulates the
+ * daisy chain, lib-ws28xx and lib-ws28xxdmx keep the frames written.
+ */
+
+#ifndef BCM2835_H_
+#define BCM2835_H_
+
+#include <stdint.h>
+
+#define HIGH	0x1
+#define LOW		0x0
+
+#define BCM2835_SPI_BIT_ORDER_MSBFIRST	1
+#define BCM2835_SPI_MODE0				0
+#define BCM2835_SPI_MODE3				3
+#define BCM2835_SPI_CS0					0
+#define BCM2835_SPI_CS1					1
+#define BCM2835_SPI_CS_NONE				3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void bcm2835_spi_begin();
+extern void bcm2835_spi_chipSelect(uint8_t);
+extern void bcm2835_spi_set_speed_hz(uint32_t);
+extern void bcm2835_spi_setDataMode(uint8_t);
+extern void bcm2835_spi_transfern(char *, uint32_t);
+extern void bcm2835_spi_writenb(const char *, uint32_t);
+extern void bcm2835_spi_write(uint16_t);
+
+extern uint8_t bcm2835_gpio_lev(uint8_t);
+
+extern void bcm2835_delayMicroseconds(uint64_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCM2835_H_ */
@@ -35,8 +35,11 @@
 
 static uint32_t set_timer = 0;
 static uint64_t s_micros = 0;
+static int32_t s_adjust_micros = 0;
+static uint32_t s_slew_remainder = 0;
 
 #define MICROS_SECONDS	1000000
+#define SLEW_RATE_DIVIDER	2000	// 500 ppm, same as the Linux kernel adjtime
 
 /*
  * number of seconds and microseconds since the Epoch,
@@ -57,7 +60,36 @@ int gettimeofday(struct timeval *tv, __attribute__((unused))  struct timezone *t
 	}
 
 	set_timer = timer;
-	s_micros += (timer_elapsed * 1000);
+
+	uint32_t micros_elapsed = timer_elapsed * 1000;
+
+	/*
+	 * adjtime: slew the clock by at most 500us per elapsed second
+	 */
+	if (s_adjust_micros != 0) {
+		/*
+		 * The remainder is kept, callers polling within 2 ms are slewed as well
+		 */
+		const uint32_t slew_micros = micros_elapsed + s_slew_remainder;
+		int32_t slew = (int32_t) (slew_micros / SLEW_RATE_DIVIDER);
+		s_slew_remainder = slew_micros % SLEW_RATE_DIVIDER;
+
+		if (s_adjust_micros > 0) {
+			if (slew > s_adjust_micros) {
+				slew = s_adjust_micros;
+			}
+			micros_elapsed += (uint32_t) slew;
+			s_adjust_micros -= slew;
+		} else {
+			if (slew > -s_adjust_micros) {
+				slew = -s_adjust_micros;
+			}
+			micros_elapsed -= (uint32_t) slew;
+			s_adjust_micros += slew;
+		}
+	}
+
+	s_micros += micros_elapsed;
 
 	tv->tv_sec = s_micros / MICROS_SECONDS;
 	tv->tv_usec = (suseconds_t) (s_micros - ((uint64_t) tv->tv_sec * MICROS_SECONDS));
@@ -70,6 +102,25 @@ int settimeofday(const struct timeval *tv, __attribute__((unused)) const struct
 
 	set_timer = H3_TIMER->AVS_CNT0;
 	s_micros = ((uint64_t) tv->tv_sec * MICROS_SECONDS) + (uint64_t) tv->tv_usec;
+	s_adjust_micros = 0;
+	s_slew_remainder = 0;
+
+	return 0;
+}
+
+/*
+ * Gradually adjust the time. The remaining adjustment from a previous
+ * call is returned in olddelta and replaced by delta.
+ */
+int adjtime(const struct timeval *delta, struct timeval *olddelta) {
+	if (olddelta != 0) {
+		olddelta->tv_sec = s_adjust_micros / MICROS_SECONDS;
+		olddelta->tv_usec = s_adjust_micros % MICROS_SECONDS;
+	}
+
+	if (delta != 0) {
+		s_adjust_micros = (int32_t) ((delta->tv_sec * MICROS_SECONDS) + delta->tv_usec);
+	}
 
 	return 0;
 }
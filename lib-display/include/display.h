@@ -40,7 +40,11 @@
 namespace display {
 struct Defaults {
 	static constexpr auto SEEP_TIMEOUT = 5;
+	static constexpr uint32_t FLUSH_BYTES = 64;	///< Maximum display bytes sent per Run()
 };
+namespace latency {
+static constexpr auto BUCKETS = 16;	///< Bucket n counts [2^(n-1), 2^n) us, the last one is open
+}  // namespace latency
 }  // namespace display
 
 enum class DisplayType {
@@ -67,6 +71,15 @@ public:
 	}
 
 	void Run();
+
+	const uint32_t *GetLatencyHistogram() const {
+		return m_aLatency;
+	}
+	uint32_t GetLatencyMax() const {
+		return m_nLatencyMax;
+	}
+	void ResetLatencyHistogram();
+	void PrintLatencyHistogram();
 #endif
 
 	void Cls();
@@ -104,6 +117,8 @@ public:
 
 	void SetContrast(uint8_t nContrast);
 
+	void Flush();
+
 	uint32_t getCols() {
 		return m_nCols;
 	}
@@ -130,6 +145,9 @@ private:
 	bool m_bIsSleep { false };
 #if !defined(NO_HAL)
 	uint32_t m_nMillis{0};
+	uint32_t m_nRunMicros{0};
+	uint32_t m_nLatencyMax{0};
+	uint32_t m_aLatency[display::latency::BUCKETS] {};
 #endif
 	uint32_t m_nSleepTimeout { 1000 * 60 * display::Defaults::SEEP_TIMEOUT };
 
@@ -67,9 +67,30 @@ public:
 
 	virtual void PrintInfo() {}
 
+	/**
+	 * Send at most nBytes of the pending updates.
+	 * @return true when there are still updates pending
+	 */
+	virtual bool Flush(__attribute__((unused)) uint32_t nBytes) {
+		return false;
+	}
+
+	/**
+	 * When deferred, the updates are only sent with Flush().
+	 * Otherwise each update is sent before returning.
+	 */
+	void SetDeferred(bool bDeferred) {
+		m_bDeferred = bDeferred;
+	}
+
+	bool IsDeferred() const {
+		return m_bDeferred;
+	}
+
 protected:
 	uint8_t m_nCols;
 	uint8_t m_nRows;
+	bool m_bDeferred { false };
 };
 
 #endif /* DISPLAYSET_H_ */
@@ -66,6 +66,8 @@ public:
 
 	void PrintInfo() override;
 
+	bool Flush(uint32_t nBytes) override;
+
 	bool IsSH1106() {
 		return m_bHaveSH1106;
 	}
@@ -80,9 +82,12 @@ private:
 	void SendCommand(uint8_t);
 	void SendData(const uint8_t *, uint32_t);
 
-	void SetCursorOn();
-	void SetCursorOff();
-	void SetCursorBlinkOn();
+	void ClearPanel();
+	void SetShadow(uint32_t nIndex, char c);
+	void Put(int c);
+	void Update();
+	void MarkDirty(uint32_t nColumn, uint32_t nRow);
+	void MoveCursor();
 	void SetColumnRow(uint8_t nColumn, uint8_t nRow);
 
 	void DumpShadowRam();
@@ -95,9 +100,11 @@ private:
 	uint32_t m_tCursorMode{display::cursor::OFF};
 	char *m_pShadowRam{nullptr};
 	uint16_t m_nShadowRamIndex{0};
-	uint8_t m_nCursorOnChar;
-	uint8_t m_nCursorOnCol;
-	uint8_t m_nCursorOnRow;
+	uint32_t m_nDirtyRows{0};		///< Bit per row with pending characters
+	uint8_t m_aDirtyFirst[8];		///< First pending column of each row
+	uint8_t m_aDirtyLast[8];		///< Last pending column of each row
+	uint8_t m_nCursorOnCol{0};
+	uint8_t m_nCursorOnRow{0};
 
 	static Ssd1306 *s_pThis;
 };
@@ -355,6 +355,18 @@ void Display::SetContrast(uint8_t nContrast) {
 	m_LcdDisplay->SetContrast(nContrast);
 }
 
+/**
+ * Send all the deferred updates, i.e. before a reboot.
+ */
+void Display::Flush() {
+	if (m_LcdDisplay == nullptr) {
+		return;
+	}
+
+	while (m_LcdDisplay->Flush(UINT32_MAX))
+		;
+}
+
 void Display::PrintInfo() {
 	if (m_LcdDisplay == nullptr) {
 		puts("No display found");
@@ -379,7 +391,42 @@ void Display::SetSleep(bool bSleep) {
 	}
 }
 
+/**
+ * Called from the main loop.
+ * The time between two calls is the main loop latency, kept in a log2 histogram.
+ * From the first call on the display updates are deferred and sent here,
+ * at most display::Defaults::FLUSH_BYTES per call.
+ */
 void Display::Run() {
+	const auto nMicros = Hardware::Get()->Micros();
+
+	if (__builtin_expect((m_nRunMicros != 0), 1)) {
+		const auto nLatency = nMicros - m_nRunMicros;
+		auto nBucket = (nLatency == 0) ? 0 : static_cast<uint32_t>(32 - __builtin_clz(nLatency));
+
+		if (nBucket >= latency::BUCKETS) {
+			nBucket = latency::BUCKETS - 1;
+		}
+
+		m_aLatency[nBucket]++;
+
+		if (nLatency > m_nLatencyMax) {
+			m_nLatencyMax = nLatency;
+		}
+	}
+
+	m_nRunMicros = nMicros;
+
+	if (m_LcdDisplay == nullptr) {
+		return;
+	}
+
+	if (__builtin_expect((!m_LcdDisplay->IsDeferred()), 0)) {
+		m_LcdDisplay->SetDeferred(true);
+	}
+
+	m_LcdDisplay->Flush(Defaults::FLUSH_BYTES);
+
 	if (m_nSleepTimeout == 0) {
 		return;
 	}
@@ -390,4 +437,29 @@ void Display::Run() {
 		}
 	}
 }
+
+void Display::ResetLatencyHistogram() {
+	for (uint32_t i = 0; i < latency::BUCKETS; i++) {
+		m_aLatency[i] = 0;
+	}
+
+	m_nLatencyMax = 0;
+	m_nRunMicros = 0;
+}
+
+void Display::PrintLatencyHistogram() {
+	printf("Main loop latency (max %u us)\n", static_cast<unsigned>(m_nLatencyMax));
+
+	for (uint32_t i = 0; i < latency::BUCKETS; i++) {
+		if (m_aLatency[i] == 0) {
+			continue;
+		}
+
+		if (i == latency::BUCKETS - 1) {
+			printf(">= %6u us : %u\n", 1U << (i - 1), static_cast<unsigned>(m_aLatency[i]));
+		} else {
+			printf(" < %6u us : %u\n", 1U << i, static_cast<unsigned>(m_aLatency[i]));
+		}
+	}
+}
 #endif
@@ -233,10 +233,8 @@ Ssd1306::Ssd1306(uint8_t nSlaveAddress, TOledPanel tOledPanel) : m_I2C(nSlaveAdd
 }
 
 Ssd1306::~Ssd1306() {
-#if defined(ENABLE_CURSOR_MODE)
 	delete[] m_pShadowRam;
 	m_pShadowRam = nullptr;
-#endif
 }
 
 void Ssd1306::PrintInfo() {
@@ -303,14 +301,17 @@ bool Ssd1306::Start() {
 
 	CheckSH1106();
 
-	Ssd1306::Cls();
+	ClearPanel();
 
 	SendCommand(cmd::DISPLAY_ON);
 
 	return true;
 }
 
-void Ssd1306::Cls() {
+/**
+ * Clear the panel RAM, the shadow RAM is in sync after this.
+ */
+void Ssd1306::ClearPanel() {
 	uint32_t nColumnAdd = 0;
 
 	if (m_bHaveSH1106) {
@@ -321,57 +322,44 @@ void Ssd1306::Cls() {
 		SendCommand(cmd::SET_LOWCOLUMN | (nColumnAdd & 0XF));
 		SendCommand(cmd::SET_HIGHCOLUMN | (nColumnAdd));
 		SendCommand(cmd::SET_STARTPAGE | nPage);
-
-		switch (m_OledPanel) {
-		case OLED_PANEL_128x64_8ROWS:
-			SendData(reinterpret_cast<const uint8_t*>(&_ClearBuffer), nColumnAdd + SSD1306_LCD_WIDTH + 1);
-			break;
-		case OLED_PANEL_128x64_4ROWS:
-			/* no break */
-		case OLED_PANEL_128x32_4ROWS:
-			SendData(reinterpret_cast<const uint8_t*>(&_ClearBuffer), nColumnAdd + SSD1306_LCD_WIDTH + 1);
-			break;
-		default:
-			break;
-		}
+		SendData(reinterpret_cast<const uint8_t*>(&_ClearBuffer), nColumnAdd + SSD1306_LCD_WIDTH + 1);
 	}
 
-	SendCommand(cmd::SET_LOWCOLUMN | (nColumnAdd & 0XF));
-	SendCommand(cmd::SET_HIGHCOLUMN | (nColumnAdd));
-	SendCommand(cmd::SET_STARTPAGE);
-
-#if defined(ENABLE_CURSOR_MODE)
 	m_nShadowRamIndex = 0;
 	memset(m_pShadowRam, ' ', static_cast<size_t>(m_nCols * m_nRows));
-#endif
+	m_nDirtyRows = 0;
 }
 
-void Ssd1306::PutChar(int c) {
-	uint8_t i;
+/**
+ * All the text functions below are writing into the shadow RAM.
+ * Only the changed characters are marked dirty and sent with Flush().
+ */
 
-	if (c < 32 || c > 127) {
-#if defined(ENABLE_CURSOR_MODE)
-		c = 32;
-#endif
-		i = 0;
-	} else {
-		i = (c - 32);
+void Ssd1306::Cls() {
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_nCols * m_nRows); i++) {
+		SetShadow(i, ' ');
 	}
 
-#if defined(ENABLE_CURSOR_MODE)
-	m_pShadowRam[m_nShadowRamIndex++] = c;
-#endif
-	const uint8_t *base = _OledFont8x6 + (oled::font8x6::CHAR_W + 1) * i;
-	SendData(base, oled::font8x6::CHAR_W + 1);
+	m_nShadowRamIndex = 0;
+
+	MoveCursor();
+	Update();
+}
+
+void Ssd1306::PutChar(int c) {
+	Put(c);
+	Update();
 }
 
 void Ssd1306::PutString(const char *pString) {
 	const char *p = pString;
 
-	for (uint32_t i = 0; *p != '\0'; i++) {
-		Ssd1306::PutChar(static_cast<int>(*p));
+	while (*p != '\0') {
+		Put(static_cast<int>(*p));
 		p++;
 	}
+
+	Update();
 }
 
 /**
@@ -382,9 +370,14 @@ void Ssd1306::ClearLine(uint8_t nLine) {
 		return;
 	}
 
+	const uint32_t nIndex = static_cast<uint32_t>((nLine - 1) * m_nCols);
+
+	for (uint32_t i = 0; i < m_nCols; i++) {
+		SetShadow(nIndex + i, ' ');
+	}
+
 	Ssd1306::SetCursorPos(0, nLine - 1);
-	SendData(reinterpret_cast<const uint8_t*>(&_ClearBuffer), SSD1306_LCD_WIDTH + 1);
-	Ssd1306::SetCursorPos(0, nLine - 1);
+	Update();
 }
 
 void Ssd1306::TextLine(uint8_t nLine, const char *pData, uint8_t nLength) {
@@ -402,8 +395,10 @@ void Ssd1306::Text(const char *pData, uint8_t nLength) {
 	}
 
 	for (uint32_t i = 0; i < nLength; i++) {
-		Ssd1306::PutChar(pData[i]);
+		Put(pData[i]);
 	}
+
+	Update();
 }
 
 /**
@@ -414,27 +409,10 @@ void Ssd1306::SetCursorPos(uint8_t nCol, uint8_t nRow) {
 		return;
 	}
 
-	nCol = nCol * oled::font8x6::CHAR_W;
-
-	if (m_bHaveSH1106) {
-		nCol += 4;
-	}
-
-	SendCommand(cmd::SET_LOWCOLUMN | (nCol & 0XF));
-	SendCommand(cmd::SET_HIGHCOLUMN | (nCol >> 4));
-	SendCommand(cmd::SET_STARTPAGE | nRow);
+	m_nShadowRamIndex = static_cast<uint16_t>((nRow * oled::font8x6::COLS) + nCol);
 
-#if defined(ENABLE_CURSOR_MODE)
-	m_nShadowRamIndex = (nRow * oled::font8x6::COLS) + (nCol / oled::font8x6::CHAR_W);
-
-	if (m_tCursorMode == display::cursor::ON) {
-		SetCursorOff();
-		SetCursorOn();
-	} else if (m_tCursorMode == static_cast<uint32_t>((display::cursor::ON | display::cursor::BLINK_ON))) {
-		SetCursorOff();
-		SetCursorBlinkOn();
-	}
-#endif
+	MoveCursor();
+	Update();
 }
 
 void Ssd1306::SetSleep(bool bSleep) {
@@ -470,11 +448,11 @@ void Ssd1306::InitMembers() {
 
 	m_nPages = (m_OledPanel == OLED_PANEL_128x64_8ROWS ? 8 : 4);
 
-#if defined(ENABLE_CURSOR_MODE)
 	m_pShadowRam = new char[oled::font8x6::COLS * m_nRows];
+	assert(m_pShadowRam != nullptr);
+
 	m_nShadowRamIndex = 0;
 	memset(m_pShadowRam, ' ', static_cast<size_t>(oled::font8x6::COLS * m_nRows));
-#endif
 }
 
 void Ssd1306::SendCommand(uint8_t nCmd) {
@@ -485,116 +463,180 @@ void Ssd1306::SendData(const uint8_t *pData, uint32_t nLength) {
 	m_I2C.Write(reinterpret_cast<const char*>(pData), nLength);
 }
 
-/**
- *  Cursor mode support
- */
+void Ssd1306::SetShadow(uint32_t nIndex, char c) {
+	if (m_pShadowRam[nIndex] != c) {
+		m_pShadowRam[nIndex] = c;
+		MarkDirty(nIndex % oled::font8x6::COLS, nIndex / oled::font8x6::COLS);
+	}
+}
 
-#if defined(ENABLE_CURSOR_MODE)
-# define UNUSED
-#else
-# define UNUSED __attribute__((unused))
-#endif
+void Ssd1306::Put(int c) {
+	if (c < 32 || c > 127) {
+		c = 32;
+	}
 
-void Ssd1306::SetCursor(UNUSED uint32_t tCursorMode) {
-#if defined(ENABLE_CURSOR_MODE)
-	if (tCursorMode == m_tCursorMode) {
+	if (__builtin_expect((m_nShadowRamIndex >= (m_nCols * m_nRows)), 0)) {
 		return;
 	}
 
-	m_tCursorMode = tCursorMode;
+	SetShadow(m_nShadowRamIndex++, static_cast<char>(c));
+}
 
-	switch (static_cast<int>(tCursorMode)) {
-	case display::cursor::OFF:
-		SetCursorOff();
-		break;
-	case display::cursor::ON:
-		SetCursorOn();
-		break;
-	case display::cursor::ON | display::cursor::BLINK_ON:
-		SetCursorBlinkOn();
-		break;
-	default:
-		break;
+void Ssd1306::Update() {
+	if (!m_bDeferred) {
+		Flush(UINT32_MAX);
 	}
-#endif
 }
 
-void Ssd1306::SetCursorOn() {
-#if defined(ENABLE_CURSOR_MODE)
-	m_nCursorOnCol = m_nShadowRamIndex % oled::font8x6::COLS;
-	m_nCursorOnRow =  m_nShadowRamIndex / oled::font8x6::COLS;
-	m_nCursorOnChar = m_pShadowRam[m_nShadowRamIndex] - 32;
-
-	const uint8_t *pBase = const_cast<uint8_t *>(_OledFont8x6) + 1 + (oled::font8x6::CHAR_W + 1) * m_nCursorOnChar;
-
-	uint8_t data[oled::font8x6::CHAR_W + 1];
-	data[0] = 0x40;
+/**
+ * Updates to the same row are merged into one column range.
+ */
+void Ssd1306::MarkDirty(uint32_t nColumn, uint32_t nRow) {
+	const auto nMask = (1U << nRow);
 
-	for (uint32_t i = 1 ; i <= oled::font8x6::CHAR_W; i++) {
-		data[i] = *pBase | 0x80;
-		pBase++;
+	if ((m_nDirtyRows & nMask) == 0) {
+		m_nDirtyRows |= nMask;
+		m_aDirtyFirst[nRow] = static_cast<uint8_t>(nColumn);
+		m_aDirtyLast[nRow] = static_cast<uint8_t>(nColumn);
+		return;
 	}
 
-	SendData(data, oled::font8x6::CHAR_W + 1);
-	SetColumnRow(m_nCursorOnCol, m_nCursorOnRow);
-#endif
+	if (nColumn < m_aDirtyFirst[nRow]) {
+		m_aDirtyFirst[nRow] = static_cast<uint8_t>(nColumn);
+	} else if (nColumn > m_aDirtyLast[nRow]) {
+		m_aDirtyLast[nRow] = static_cast<uint8_t>(nColumn);
+	}
 }
 
-void Ssd1306::SetCursorBlinkOn() {
-#if defined(ENABLE_CURSOR_MODE)
-	m_nCursorOnCol = m_nShadowRamIndex % oled::font8x6::COLS;
-	m_nCursorOnRow =  m_nShadowRamIndex / oled::font8x6::COLS;
-	m_nCursorOnChar = m_pShadowRam[m_nShadowRamIndex] - 32;
+/**
+ * Each call sends one I2C transfer per row segment.
+ * The address commands are counted as 6 bytes.
+ * At least one character is sent, so the display always makes progress.
+ */
+bool Ssd1306::Flush(uint32_t nBytes) {
+	static constexpr uint32_t ADDRESS_BYTES = 6;
+	bool bSent = false;
+
+	while (m_nDirtyRows != 0) {
+		const auto nRow = static_cast<uint32_t>(__builtin_ctz(m_nDirtyRows));
+		const uint32_t nFirst = m_aDirtyFirst[nRow];
+		uint32_t nChars = (nBytes > ADDRESS_BYTES) ? (nBytes - ADDRESS_BYTES) / oled::font8x6::CHAR_W : 0;
+
+		if (nChars == 0) {
+			if (bSent) {
+				return true;
+			}
+			nChars = 1;
+		}
 
-	const uint8_t *pBase = const_cast<uint8_t *>(_OledFont8x6) + 1 + (oled::font8x6::CHAR_W + 1) * m_nCursorOnChar;
+		uint32_t nLast = m_aDirtyLast[nRow];
 
-	uint8_t data[oled::font8x6::CHAR_W + 1];
-	data[0] = 0x40;
+		if (nLast - nFirst >= nChars) {
+			nLast = nFirst + nChars - 1;
+		}
 
-	for (uint32_t i = 1 ; i <= oled::font8x6::CHAR_W; i++) {
-		data[i] = ~*pBase;
-		pBase++;
-	}
+		uint8_t aData[1 + oled::font8x6::COLS * oled::font8x6::CHAR_W];
+		aData[0] = mode::DATA;
+		auto *pData = &aData[1];
 
-	SendData(data, (oled::font8x6::CHAR_W + 1));
-	SetColumnRow(m_nCursorOnCol, m_nCursorOnRow);
-#endif
-}
+		for (uint32_t nColumn = nFirst; nColumn <= nLast; nColumn++) {
+			const auto nIndex = nRow * oled::font8x6::COLS + nColumn;
+			const auto *pBase = _OledFont8x6 + 1 + (oled::font8x6::CHAR_W + 1) * static_cast<uint32_t>(m_pShadowRam[nIndex] - 32);
 
-void Ssd1306::SetCursorOff() {
 #if defined(ENABLE_CURSOR_MODE)
-	const uint8_t nCol = m_nShadowRamIndex % oled::font8x6::COLS;
-	const uint8_t nRow =  m_nShadowRamIndex / oled::font8x6::COLS;
+			if (((m_tCursorMode & display::cursor::ON) != 0) && (nColumn == m_nCursorOnCol) && (nRow == m_nCursorOnRow)) {
+				const bool bBlink = ((m_tCursorMode & display::cursor::BLINK_ON) != 0);
 
-	SetColumnRow(m_nCursorOnCol, m_nCursorOnRow);
+				for (uint32_t i = 0; i < oled::font8x6::CHAR_W; i++) {
+					*pData++ = static_cast<uint8_t>(bBlink ? ~pBase[i] : (pBase[i] | 0x80));
+				}
 
-	const uint8_t *pBase = _OledFont8x6 + (oled::font8x6::CHAR_W + 1) * m_nCursorOnChar;
-
-	SendData(pBase, (oled::font8x6::CHAR_W + 1));
-	SetColumnRow(nCol, nRow);
+				continue;
+			}
 #endif
+			memcpy(pData, pBase, oled::font8x6::CHAR_W);
+			pData += oled::font8x6::CHAR_W;
+		}
+
+		const auto nLength = static_cast<uint32_t>(pData - aData);
+
+		SetColumnRow(static_cast<uint8_t>(nFirst), static_cast<uint8_t>(nRow));
+		SendData(aData, nLength);
+
+		if (nLast == m_aDirtyLast[nRow]) {
+			m_nDirtyRows &= ~(1U << nRow);
+		} else {
+			m_aDirtyFirst[nRow] = static_cast<uint8_t>(nLast + 1);
+		}
+
+		const auto nCost = ADDRESS_BYTES + nLength - 1;
+		nBytes = (nBytes > nCost) ? nBytes - nCost : 0;
+		bSent = true;
+	}
+
+	return false;
 }
 
-void Ssd1306::SetColumnRow(UNUSED uint8_t nColumn, UNUSED uint8_t nRow) {
-#if defined(ENABLE_CURSOR_MODE)
-	uint8_t nColumnAdd = nColumn * oled::font8x6::CHAR_W;
+void Ssd1306::SetColumnRow(uint8_t nColumn, uint8_t nRow) {
+	uint8_t nColumnAdd = static_cast<uint8_t>(nColumn * oled::font8x6::CHAR_W);
 
 	if (m_bHaveSH1106) {
-		nColumnAdd += 4;
+		nColumnAdd = static_cast<uint8_t>(nColumnAdd + 4);
 	}
 
 	SendCommand(cmd::SET_LOWCOLUMN | (nColumnAdd & 0xF));
 	SendCommand(cmd::SET_HIGHCOLUMN | (nColumnAdd >> 4));
 	SendCommand(cmd::SET_STARTPAGE | nRow);
+}
+
+/**
+ *  Cursor mode support
+ */
+
+#if defined(ENABLE_CURSOR_MODE)
+# define UNUSED
+#else
+# define UNUSED __attribute__((unused))
+#endif
+
+void Ssd1306::SetCursor(UNUSED uint32_t tCursorMode) {
+#if defined(ENABLE_CURSOR_MODE)
+	if (tCursorMode == m_tCursorMode) {
+		return;
+	}
+
+	m_tCursorMode = tCursorMode;
+
+	MarkDirty(m_nCursorOnCol, m_nCursorOnRow);
+	MoveCursor();
+	Update();
 #endif
 }
 
-void Ssd1306::DumpShadowRam() {
+/**
+ * The cursor is drawn by Flush(), both the old and the new position are redrawn.
+ */
+void Ssd1306::MoveCursor() {
 #if defined(ENABLE_CURSOR_MODE)
+	if ((m_tCursorMode & display::cursor::ON) == 0) {
+		return;
+	}
+
+	const auto nIndex = (m_nShadowRamIndex < (m_nCols * m_nRows)) ? m_nShadowRamIndex : 0;
+
+	MarkDirty(m_nCursorOnCol, m_nCursorOnRow);
+
+	m_nCursorOnCol = static_cast<uint8_t>(nIndex % oled::font8x6::COLS);
+	m_nCursorOnRow = static_cast<uint8_t>(nIndex / oled::font8x6::COLS);
+
+	MarkDirty(m_nCursorOnCol, m_nCursorOnRow);
+#endif
+}
+
+void Ssd1306::DumpShadowRam() {
 #ifndef NDEBUG
 	for (uint32_t i = 0; i < m_nRows; i++) {
 		printf("%d: [%.*s]\n", i, oled::font8x6::COLS, &m_pShadowRam[i * oled::font8x6::COLS]);
 	}
 #endif
-#endif
 }
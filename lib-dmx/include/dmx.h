@@ -33,6 +33,9 @@
 #define DMX_MAX_IN		4U
 
 #define DMX_DATA_BUFFER_SIZE					516									///< including SC, aligned 4
+#define DMX_CHANGED_BLOCK_SLOTS					8									///< Slots per changed block, including SC
+#define DMX_CHANGED_BLOCKS						((DMX_DATA_BUFFER_SIZE + DMX_CHANGED_BLOCK_SLOTS - 1) / DMX_CHANGED_BLOCK_SLOTS)
+#define DMX_CHANGED_BLOCKS_WORDS				((DMX_CHANGED_BLOCKS + 31) / 32)	///< Bitmap size, see \ref dmx_get_changed_blocks
 #define DMX_DATA_BUFFER_INDEX_ENTRIES			(1 << 1)							///<
 #define DMX_DATA_BUFFER_INDEX_MASK 				(DMX_DATA_BUFFER_INDEX_ENTRIES - 1)	///<
 
@@ -90,6 +93,7 @@ extern void dmx_data_send(const uint8_t *, uint16_t);
 extern /*@shared@*/const /*@null@*/uint8_t *dmx_get_available(void) __attribute__((assume_aligned(4)));
 extern /*@shared@*/const uint8_t *dmx_get_current_data(void) __attribute__((assume_aligned(4)));
 extern /*@shared@*/const uint8_t *dmx_is_data_changed(void) __attribute__((assume_aligned(4)));
+extern /*@shared@*/const uint32_t *dmx_get_changed_blocks(void);
 extern uint32_t dmx_get_output_break_time(void);
 extern void dmx_set_output_break_time(uint32_t);
 extern uint32_t dmx_get_output_mab_time(void);
@@ -0,0 +1,59 @@
+/**
+ * @file dmx_changed.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMX_CHANGED_H_
+#define DMX_CHANGED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmx.h"
+
+/**
+ * Copies the received packet into the previous packet and marks each
+ * DMX_CHANGED_BLOCK_SLOTS block that differs in \ref dmx_get_changed_blocks bitmap.
+ * Returns true when at least one slot was changed.
+ */
+static inline bool dmx_changed_update(const uint32_t *src, uint32_t *previous, uint32_t *changed_blocks) {
+	uint32_t i;
+	bool is_changed = false;
+
+	for (i = 0; i < DMX_CHANGED_BLOCKS_WORDS; i++) {
+		changed_blocks[i] = 0;
+	}
+
+	for (i = 0; i < DMX_DATA_BUFFER_SIZE / 4; i++) {
+		if (previous[i] != src[i]) {
+			const uint32_t block = (i * 4) / DMX_CHANGED_BLOCK_SLOTS;
+			changed_blocks[block / 32] |= (1U << (block & 31));
+			previous[i] = src[i];
+			is_changed = true;
+		}
+	}
+
+	return is_changed;
+}
+
+#endif /* DMX_CHANGED_H_ */
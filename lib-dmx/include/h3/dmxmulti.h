@@ -42,6 +42,11 @@ public:
 	const uint8_t *RdmReceiveTimeOut(uint8_t nPort, uint32_t nTimeOut) override;
 
 	void SetPortSendDataWithoutSC(uint8_t nPort, const uint8_t *pData, uint16_t nLength);
+	/**
+	 * The staged data is sent after CommitSendData(), all the committed ports start with the same break.
+	 */
+	void StagePortSendDataWithoutSC(uint8_t nPort, const uint8_t *pData, uint16_t nLength);
+	void CommitSendData();
 
 	void SetDmxBreakTime(uint32_t nBreakTime);
 	uint32_t GetDmxBreakTime() const {
@@ -75,6 +80,7 @@ private:
 	uint8_t m_nDmxDataDirectionGpioPin[DMX_MAX_OUT];
 	TDmxRdmPortDirection m_tDmxPortDirection[DMX_MAX_OUT];
 	uint32_t m_nDmxTransmissionLength[DMX_MAX_OUT];
+	uint32_t m_nDmxDataStaged { 0 };	///< Bit per UART
 };
 
 #endif /* H3_DMXMULTI_H_ */
@@ -45,6 +45,7 @@
 
 #include "gpio.h"
 #include "dmx.h"
+#include "dmx_changed.h"
 #include "rdm.h"
 #include "rdm_e120.h"
 
@@ -91,6 +92,7 @@ static volatile uint32_t dmx_data_buffer_index_head = 0;
 static volatile uint32_t dmx_data_buffer_index_tail = 0;
 static struct _dmx_data dmx_data[DMX_DATA_BUFFER_INDEX_ENTRIES] ALIGNED;
 static uint8_t dmx_data_previous[DMX_DATA_BUFFER_SIZE] ALIGNED;
+static uint32_t dmx_changed_blocks[DMX_CHANGED_BLOCKS_WORDS];
 static volatile _dmx_state dmx_receive_state = IDLE;
 static volatile uint32_t dmx_data_index = 0;
 
@@ -187,6 +189,16 @@ void dmx_clear_data(void) {
 	while (i-- != (uint32_t) 0) {
 		*p++ = (uint32_t) 0;
 	}
+
+	// Change of state reception starts from all zeros
+	i = sizeof(dmx_data_previous) / sizeof(uint32_t);
+	p = (uint32_t *)dmx_data_previous;
+
+	while (i-- != (uint32_t) 0) {
+		*p++ = (uint32_t) 0;
+	}
+
+	dmx_slots_in_packet_previous = 0;
 }
 
 uint32_t dmx_get_output_period(void) {
@@ -233,40 +245,33 @@ uint8_t dmx_get_receive_state(void) {
 }
 
 const uint8_t *dmx_is_data_changed(void) {
-	uint32_t i;
 	uint8_t const *p = (uint8_t *)dmx_get_available();
-	uint32_t *src = (uint32_t *)p;
-	uint32_t *dst = (uint32_t *)dmx_data_previous;
-	bool is_changed = false;
+	bool is_changed;
 
-	if (src == NULL) {
+	if (p == NULL) {
 		return NULL;
 	}
 
+	is_changed = dmx_changed_update((const uint32_t *)p, (uint32_t *)dmx_data_previous, dmx_changed_blocks);
+
 	const struct _dmx_data *dmx_statistics = (struct _dmx_data *)p;
 
 	if (dmx_statistics->statistics.slots_in_packet != dmx_slots_in_packet_previous) {
 		dmx_slots_in_packet_previous = dmx_statistics->statistics.slots_in_packet;
-		for (i = 0; i < DMX_DATA_BUFFER_SIZE / 4; i++) {
-			*dst= *src;
-			dst++;
-			src++;
-		}
 		return p;
 	}
 
-	for (i = 0; i < DMX_DATA_BUFFER_SIZE / 4; i++) {
-		if (*dst != *src) {
-			*dst = *src;
-			is_changed = true;
-		}
-		dst++;
-		src++;
-	}
-
 	return (is_changed ? p : NULL);
 }
 
+/**
+ * Bit n is set when slots [n * DMX_CHANGED_BLOCK_SLOTS, (n + 1) * DMX_CHANGED_BLOCK_SLOTS)
+ * were changed in the packet returned by the last call of \ref dmx_is_data_changed.
+ */
+const uint32_t *dmx_get_changed_blocks(void) {
+	return dmx_changed_blocks;
+}
+
 _dmx_port_direction dmx_get_port_direction(void) {
 	return dmx_port_direction;
 }
@@ -681,6 +681,11 @@ void DmxMulti::SetDmxPeriodTime(uint32_t nPeriod) {
 }
 
 void DmxMulti::SetPortSendDataWithoutSC(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+	StagePortSendDataWithoutSC(nPort, pData, nLength);
+	CommitSendData();
+}
+
+void DmxMulti::StagePortSendDataWithoutSC(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
 	assert(pData != 0);
 	assert(nLength != 0);
 
@@ -703,7 +708,28 @@ void DmxMulti::SetPortSendDataWithoutSC(uint8_t nPort, const uint8_t *pData, uin
 		SetDmxPeriodTime(m_nDmxTransmitPeriodRequested);
 	}
 
-	s_nDmxDataWriteIndex[nUart] = nNext;
+	m_nDmxDataStaged |= (1U << nUart);
+}
+
+void DmxMulti::CommitSendData() {
+	if (m_nDmxDataStaged == 0) {
+		return;
+	}
+
+	dmb();
+
+	// The break interrupt must see all the new write indexes, or none of them
+	__disable_irq();
+
+	for (uint32_t nUart = 0; nUart < DMX_MAX_OUT; nUart++) {
+		if ((m_nDmxDataStaged & (1U << nUart)) != 0) {
+			s_nDmxDataWriteIndex[nUart] = (s_nDmxDataWriteIndex[nUart] + 1) & (DMX_DATA_OUT_INDEX - 1);
+		}
+	}
+
+	__enable_irq();
+
+	m_nDmxDataStaged = 0;
 }
 
 void DmxMulti::SetPortDirection(uint8_t nPort, TDmxRdmPortDirection tPortDirection, bool bEnableData) {
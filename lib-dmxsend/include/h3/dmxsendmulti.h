@@ -40,6 +40,11 @@ public:
 	void Stop(uint8_t nPort) override;
 
 	void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override;
+	void Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override;
+
+	void Commit() override {
+		CommitSendData();
+	}
 
 	void Print() override;
 
@@ -96,3 +96,14 @@ void DMXSendMulti::SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength
 
 //	DEBUG_EXIT
 }
+
+void DMXSendMulti::Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+	assert(nPort < MAX_PORTS);
+	assert(pData != nullptr);
+
+	if (__builtin_expect((nLength == 0), 0)) {
+		return;
+	}
+
+	StagePortSendDataWithoutSC(nPort, pData, nLength);
+}
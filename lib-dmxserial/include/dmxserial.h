@@ -44,10 +44,12 @@ namespace DmxSerialDefaults {
 	static constexpr auto SPI_MODE = 0;
 	static constexpr auto I2C_ADDRESS = 0x30;
 	static constexpr auto I2C_SPEED_MODE = serial::i2c::speed::FAST;
+	static constexpr auto TX_OVERFLOW = serial::tx::overflow::DROP_OLDEST;
 }
 
 #define DMXSERIAL_FILE_PREFIX	"chl"
 #define DMXSERIAL_FILE_SUFFIX	".txt"
+#define DMXSERIAL_CACHE_FILE	"chlcache.bin"
 
 namespace DmxSerialFile {
 	static constexpr auto NAME_LENGTH = sizeof(DMXSERIAL_FILE_PREFIX "NNN" DMXSERIAL_FILE_SUFFIX) - 1;
@@ -79,6 +81,10 @@ public:
 		return m_nFilesCount;
 	}
 
+	bool IsCacheLoaded() {
+		return m_bCacheLoaded;
+	}
+
 	void EnableTFTP(bool bEnableTFTP);
 
 	bool DeleteFile(int16_t nFileNumber);
@@ -86,6 +92,7 @@ public:
 
 	static bool FileNameCopyTo(char *pFileName, uint32_t nLength, int16_t nFileNumber);
 	static bool CheckFileName(const char *pFileName, int16_t &nFileNumber);
+	static void DeleteCache();
 
 	static DmxSerial *Get() {
 		return s_pThis;
@@ -95,12 +102,26 @@ private:
 	void ScanDirectory();
 	void HandleUdp();
 
+	uint32_t GetSignature();
+	void Compile();
+	bool LoadCache(uint32_t nSignature);
+	bool SaveCache(uint32_t nSignature);
+	void FreeCompiled();
+
 private:
 	Serial m_Serial;
 	uint32_t m_nFilesCount { 0 };
 	int16_t m_aFileIndex[DmxSerialFile::MAX_NUMBER];
 	int32_t m_nHandle { -1 };
-	DmxSerialChannelData *m_pDmxSerialChannelData[DmxSerialFile::MAX_NUMBER];
+	/*
+	 * The payloads of all the channel files are packed in a single arena.
+	 * The payload for file index i and channel value v are the arena bytes
+	 * m_pOffsets[(i << 8) + v] up to m_pOffsets[(i << 8) + v + 1]
+	 */
+	uint32_t *m_pOffsets { nullptr };
+	uint8_t *m_pArena { nullptr };
+	uint32_t m_nArenaSize { 0 };
+	bool m_bCacheLoaded { false };
 	uint16_t m_nDmxLastSlot { lightset::Dmx::UNIVERSE_SIZE };
 	uint8_t m_DmxData[lightset::Dmx::UNIVERSE_SIZE];
 	bool m_bEnableTFTP { false };
@@ -41,6 +41,7 @@ struct TDmxSerialParams {
 	uint8_t nSpiMode;
 	uint8_t nI2cAddress;
 	uint8_t nI2cSpeedMode;
+	uint8_t nTxOverflow;
 } __attribute__((packed));
 
 static_assert(sizeof(struct TDmxSerialParams) <= 32, "struct TDmxSerialParams is too large");
@@ -55,6 +56,7 @@ struct DmxSerialParamsMask {
 	static constexpr auto SPI_MODE = (1U << 6);
 	static constexpr auto I2C_ADDRESS = (1U << 7);
 	static constexpr auto I2C_SPEED_MODE = (1U << 8);
+	static constexpr auto TX_OVERFLOW = (1U << 9);
 };
 
 class DmxSerialParamsStore {
@@ -30,6 +30,7 @@ struct DmxSerialParamsConst {
 	static const char FILE_NAME[];
 
 	static const char TYPE[];
+	static const char TX_OVERFLOW[];
 
 	static const char UART_BAUD[];
 	static const char UART_BITS[];
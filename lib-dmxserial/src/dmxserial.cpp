@@ -48,18 +48,13 @@ DmxSerial::DmxSerial() {
 
 	for (uint32_t i = 0; i < DmxSerialFile::MAX_NUMBER; i++) {
 		m_aFileIndex[i] = -1;
-		m_pDmxSerialChannelData[i] = nullptr;
 	}
 
 	memset(m_DmxData, 0, sizeof(m_DmxData));
 }
 
 DmxSerial::~DmxSerial() {
-	for (uint32_t i = 0; i < m_nFilesCount; i++) {
-		if (m_pDmxSerialChannelData[i] != nullptr) {
-			delete m_pDmxSerialChannelData[i];
-		}
-	}
+	FreeCompiled();
 
 	Network::Get()->End(UDP::PORT);
 
@@ -93,16 +88,14 @@ void DmxSerial::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t *pD
 
 //			DEBUG_PRINTF("nPort=%d, nIndex=%d, m_aFileIndex[nIndex]=%d, nOffset=%d, m_DmxData[nOffset]=%d", nPort, nIndex, m_aFileIndex[nIndex], nOffset, m_DmxData[nOffset]);
 
-			if (m_pDmxSerialChannelData[nIndex] != nullptr) {
-				uint32_t nLength;
-				const uint8_t *pSerialData = m_pDmxSerialChannelData[nIndex]->GetData(m_DmxData[nOffset], nLength);
-
-				if (nLength == 0) {
-					continue;
-				}
+			const uint32_t *pEntry = &m_pOffsets[(nIndex << 8) + m_DmxData[nOffset]];
+			const uint32_t nSerialLength = pEntry[1] - pEntry[0];
 
-				m_Serial.Send(pSerialData, nLength);
+			if (nSerialLength == 0) {
+				continue;
 			}
+
+			m_Serial.Send(&m_pArena[pEntry[0]], nSerialLength, static_cast<uint16_t>(m_aFileIndex[nIndex]));
 		}
 	}
 }
@@ -114,11 +107,12 @@ void DmxSerial::Print() {
 	printf("DMX\n");
 	printf(" First channel : %d\n", m_aFileIndex[0]);
 	printf(" Last channel  : %d\n", m_nDmxLastSlot);
+	printf("Cache : %s, %u bytes\n", m_bCacheLoaded ? "Loaded" : "Compiled", static_cast<unsigned>(m_nArenaSize));
 }
 
 void DmxSerial::ScanDirectory() {
 	// We can only run this once, for now
-	assert(m_pDmxSerialChannelData[0] == nullptr);
+	assert(m_pOffsets == nullptr);
 
     DIR *dirp;
     struct dirent *dp;
@@ -178,28 +172,24 @@ void DmxSerial::ScanDirectory() {
 
 #ifndef NDEBUG
 	printf("%d\n", m_nFilesCount);
-#endif
 
 	for (uint32_t nIndex = 0; nIndex < m_nFilesCount; nIndex++) {
-#ifndef NDEBUG
 		printf("\tnIndex=%d -> %d\n", nIndex, m_aFileIndex[nIndex]);
+	}
 #endif
 
-		m_pDmxSerialChannelData[nIndex] = new DmxSerialChannelData;
-		assert(m_pDmxSerialChannelData[nIndex] != nullptr);
+	const auto nSignature = GetSignature();
 
-		char pBuffer[16];
-		snprintf(pBuffer, sizeof(pBuffer) - 1, DMXSERIAL_FILE_PREFIX "%.3d" DMXSERIAL_FILE_SUFFIX, m_aFileIndex[nIndex]);
-		DEBUG_PUTS(pBuffer);
-		m_pDmxSerialChannelData[nIndex]->Parse(pBuffer);
+	if (LoadCache(nSignature)) {
+		m_bCacheLoaded = true;
+		return;
 	}
 
-#ifndef NDEBUG
-	for (uint32_t nIndex = 0; nIndex < m_nFilesCount; nIndex++) {
-		printf("\tnIndex=%d -> %d\n", nIndex, m_aFileIndex[nIndex]);
-		m_pDmxSerialChannelData[nIndex]->Dump();
+	Compile();
+
+	if (!SaveCache(nSignature)) {
+		perror(DMXSERIAL_CACHE_FILE);
 	}
-#endif
 }
 
 void DmxSerial::EnableTFTP(bool bEnableTFTP) {
@@ -228,6 +218,8 @@ void DmxSerial::EnableTFTP(bool bEnableTFTP) {
 }
 
 void DmxSerial::Run() {
+	m_Serial.Run();
+
 	HandleUdp();
 
 	if (m_pDmxSerialTFTP == nullptr) {
@@ -243,6 +235,7 @@ bool DmxSerial::DeleteFile(int16_t nFileNumber) {
 	char aFileName[DmxSerialFile::NAME_LENGTH + 1];
 
 	if (FileNameCopyTo(aFileName, sizeof(aFileName), nFileNumber)) {
+		DeleteCache();
 		const int nResult = unlink(aFileName);
 		DEBUG_PRINTF("nResult=%d", nResult);
 		DEBUG_EXIT
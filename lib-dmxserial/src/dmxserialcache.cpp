@@ -0,0 +1,278 @@
+/**
+ * @file dmxserialcache.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cassert>
+
+#include "dmxserial.h"
+#include "dmxserialchanneldata.h"
+
+#include "propertieskey.h"
+
+#include "debug.h"
+
+/*
+ * chlcache.bin : Header, offset table, arena
+ * The signature is built from the numbers, the sizes and the modification times of the chl*.txt files.
+ * A TFTP upload or a delete of a channel file removes the cache file.
+ */
+
+namespace cache {
+static constexpr uint32_t MAGIC = 0x314C4843;	// "CHL1"
+static constexpr uint32_t VALUES = 256;
+
+struct Header {
+	uint32_t nMagic;
+	uint32_t nSignature;
+	uint32_t nFilesCount;
+	uint32_t nArenaSize;
+};
+}  // namespace cache
+
+static uint32_t fnv(uint32_t nHash, uint32_t nValue) {
+	for (uint32_t i = 0; i < 4; i++) {
+		nHash = (nHash ^ (nValue & 0xFF)) * properties::fnv::PRIME;
+		nValue >>= 8;
+	}
+
+	return nHash;
+}
+
+uint32_t DmxSerial::GetSignature() {
+	uint32_t nSignature = fnv(properties::fnv::OFFSET_BASIS, m_nFilesCount);
+
+	for (uint32_t nIndex = 0; nIndex < m_nFilesCount; nIndex++) {
+		char aFileName[DmxSerialFile::NAME_LENGTH + 1];
+
+		if (!FileNameCopyTo(aFileName, sizeof(aFileName), m_aFileIndex[nIndex])) {
+			continue;
+		}
+
+		nSignature = fnv(nSignature, static_cast<uint32_t>(m_aFileIndex[nIndex]));
+
+		/*
+		 * The size and the modification time, the files are not read.
+		 * An edit on another computer changes the modification time.
+		 */
+		struct stat statbuf;
+
+		if (stat(aFileName, &statbuf) != 0) {
+			continue;
+		}
+
+		nSignature = fnv(nSignature, static_cast<uint32_t>(statbuf.st_size));
+		nSignature = fnv(nSignature, static_cast<uint32_t>(statbuf.st_mtime));
+	}
+
+	DEBUG_PRINTF("nSignature=%.8x", nSignature);
+	return nSignature;
+}
+
+void DmxSerial::Compile() {
+	DEBUG_ENTRY
+
+	const auto nEntries = (m_nFilesCount * cache::VALUES) + 1;
+
+	m_pOffsets = new uint32_t[nEntries];
+	assert(m_pOffsets != nullptr);
+
+	auto **pChannelData = new DmxSerialChannelData*[m_nFilesCount];
+	assert((m_nFilesCount == 0) || (pChannelData != nullptr));
+
+	m_nArenaSize = 0;
+
+	for (uint32_t nIndex = 0; nIndex < m_nFilesCount; nIndex++) {
+		pChannelData[nIndex] = new DmxSerialChannelData;
+		assert(pChannelData[nIndex] != nullptr);
+
+		char aFileName[DmxSerialFile::NAME_LENGTH + 1];
+		FileNameCopyTo(aFileName, sizeof(aFileName), m_aFileIndex[nIndex]);
+		DEBUG_PUTS(aFileName);
+		pChannelData[nIndex]->Parse(aFileName);
+
+#ifndef NDEBUG
+		printf("\tnIndex=%d -> %d\n", nIndex, m_aFileIndex[nIndex]);
+		pChannelData[nIndex]->Dump();
+#endif
+
+		for (uint32_t nValue = 0; nValue < cache::VALUES; nValue++) {
+			uint32_t nLength;
+			pChannelData[nIndex]->GetData(static_cast<uint8_t>(nValue), nLength);
+			m_nArenaSize += nLength;
+		}
+	}
+
+	m_pArena = new uint8_t[m_nArenaSize + 1];
+	assert(m_pArena != nullptr);
+
+	uint32_t nOffset = 0;
+
+	for (uint32_t nIndex = 0; nIndex < m_nFilesCount; nIndex++) {
+		for (uint32_t nValue = 0; nValue < cache::VALUES; nValue++) {
+			m_pOffsets[(nIndex * cache::VALUES) + nValue] = nOffset;
+
+			uint32_t nLength;
+			const auto *pData = pChannelData[nIndex]->GetData(static_cast<uint8_t>(nValue), nLength);
+
+			if (nLength != 0) {
+				memcpy(&m_pArena[nOffset], pData, nLength);
+				nOffset += nLength;
+			}
+		}
+
+		delete pChannelData[nIndex];
+	}
+
+	m_pOffsets[nEntries - 1] = nOffset;
+
+	assert(nOffset == m_nArenaSize);
+
+	delete[] pChannelData;
+
+	DEBUG_PRINTF("m_nArenaSize=%u", m_nArenaSize);
+	DEBUG_EXIT
+}
+
+bool DmxSerial::LoadCache(uint32_t nSignature) {
+	DEBUG_ENTRY
+
+	FILE *pFile = fopen(DMXSERIAL_CACHE_FILE, "r");
+
+	if (pFile == nullptr) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	cache::Header header;
+
+	if ((fread(&header, 1, sizeof(header), pFile) != sizeof(header))
+			|| (header.nMagic != cache::MAGIC)
+			|| (header.nSignature != nSignature)
+			|| (header.nFilesCount != m_nFilesCount)) {
+		fclose(pFile);
+		DEBUG_EXIT
+		return false;
+	}
+
+	const auto nOffsetsSize = ((m_nFilesCount * cache::VALUES) + 1) * sizeof(uint32_t);
+
+	// The arena size must match the file, before it is allocated
+	if ((fseek(pFile, 0, SEEK_END) != 0)
+			|| (static_cast<uint32_t>(ftell(pFile)) != (sizeof(header) + nOffsetsSize + header.nArenaSize))
+			|| (fseek(pFile, sizeof(header), SEEK_SET) != 0)) {
+		fclose(pFile);
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_pOffsets = new uint32_t[(m_nFilesCount * cache::VALUES) + 1];
+	assert(m_pOffsets != nullptr);
+
+	m_nArenaSize = header.nArenaSize;
+	m_pArena = new uint8_t[m_nArenaSize + 1];
+	assert(m_pArena != nullptr);
+
+	auto isValid = (fread(m_pOffsets, 1, nOffsetsSize, pFile) == nOffsetsSize)
+			&& (fread(m_pArena, 1, m_nArenaSize, pFile) == m_nArenaSize)
+			&& (m_pOffsets[0] == 0)
+			&& (m_pOffsets[m_nFilesCount * cache::VALUES] == m_nArenaSize);
+
+	fclose(pFile);
+
+	/*
+	 * SetData uses m_pArena[m_pOffsets[n]] with length m_pOffsets[n + 1] - m_pOffsets[n]
+	 */
+	for (uint32_t i = 0; isValid && (i < m_nFilesCount * cache::VALUES); i++) {
+		isValid = (m_pOffsets[i] <= m_pOffsets[i + 1]);
+	}
+
+	if (!isValid) {
+		FreeCompiled();
+		DEBUG_EXIT
+		return false;
+	}
+
+	DEBUG_PRINTF("m_nArenaSize=%u", m_nArenaSize);
+	DEBUG_EXIT
+	return true;
+}
+
+bool DmxSerial::SaveCache(uint32_t nSignature) {
+	DEBUG_ENTRY
+
+	FILE *pFile = fopen(DMXSERIAL_CACHE_FILE, "w+");
+
+	if (pFile == nullptr) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	cache::Header header;
+	header.nMagic = cache::MAGIC;
+	header.nSignature = nSignature;
+	header.nFilesCount = m_nFilesCount;
+	header.nArenaSize = m_nArenaSize;
+
+	const auto nOffsetsSize = ((m_nFilesCount * cache::VALUES) + 1) * sizeof(uint32_t);
+
+	const auto isWritten = (fwrite(&header, 1, sizeof(header), pFile) == sizeof(header))
+			&& (fwrite(m_pOffsets, 1, nOffsetsSize, pFile) == nOffsetsSize)
+			&& (fwrite(m_pArena, 1, m_nArenaSize, pFile) == m_nArenaSize);
+
+	fclose(pFile);
+
+	if (!isWritten) {
+		DeleteCache();
+	}
+
+	DEBUG_EXIT
+	return isWritten;
+}
+
+void DmxSerial::FreeCompiled() {
+	if (m_pOffsets != nullptr) {
+		delete[] m_pOffsets;
+		m_pOffsets = nullptr;
+	}
+
+	if (m_pArena != nullptr) {
+		delete[] m_pArena;
+		m_pArena = nullptr;
+	}
+
+	m_nArenaSize = 0;
+}
+
+void DmxSerial::DeleteCache() {
+	DEBUG_ENTRY
+
+	static_cast<void>(unlink(DMXSERIAL_CACHE_FILE));
+
+	DEBUG_EXIT
+}
@@ -60,6 +60,7 @@ DmxSerialParams::DmxSerialParams(DmxSerialParamsStore *pDmxSerialParamsStore):
 	m_tDmxSerialParams.nSpiMode = DmxSerialDefaults::SPI_MODE;
 	m_tDmxSerialParams.nI2cAddress = DmxSerialDefaults::I2C_ADDRESS;
 	m_tDmxSerialParams.nI2cSpeedMode = static_cast<uint8_t>(DmxSerialDefaults::I2C_SPEED_MODE);
+	m_tDmxSerialParams.nTxOverflow = static_cast<uint8_t>(DmxSerialDefaults::TX_OVERFLOW);
 
 	DEBUG_EXIT
 }
@@ -122,6 +123,20 @@ void DmxSerialParams::callbackFunction(const char *pLine) {
 		return;
 	}
 
+	nLength = sizeof(aChar) - 1;
+
+	if (Sscan::Char(pLine, DmxSerialParamsConst::TX_OVERFLOW, aChar, nLength) == Sscan::OK) {
+		aChar[nLength] = '\0';
+		m_tDmxSerialParams.nTxOverflow = static_cast<uint8_t>(Serial::GetTxOverflow(aChar));
+
+		if (m_tDmxSerialParams.nTxOverflow != static_cast<uint8_t>(DmxSerialDefaults::TX_OVERFLOW)) {
+			m_tDmxSerialParams.nSetList |= DmxSerialParamsMask::TX_OVERFLOW;
+		} else {
+			m_tDmxSerialParams.nSetList &= ~DmxSerialParamsMask::TX_OVERFLOW;
+		}
+		return;
+	}
+
 	/*
 	 * UART
 	 */
@@ -241,6 +256,7 @@ void DmxSerialParams::Builder(const struct TDmxSerialParams *pDmxSerialParams, c
 	PropertiesBuilder builder(DmxSerialParamsConst::FILE_NAME, pBuffer, nLength);
 
 	builder.Add(DmxSerialParamsConst::TYPE, Serial::GetType(static_cast<type>(m_tDmxSerialParams.nType)), isMaskSet(DmxSerialParamsMask::TYPE));
+	builder.Add(DmxSerialParamsConst::TX_OVERFLOW, Serial::GetTxOverflow(static_cast<tx::overflow>(m_tDmxSerialParams.nTxOverflow)), isMaskSet(DmxSerialParamsMask::TX_OVERFLOW));
 
 	builder.AddComment("UART");
 	builder.Add(DmxSerialParamsConst::UART_BAUD, m_tDmxSerialParams.nBaud, isMaskSet(DmxSerialParamsMask::BAUD));
@@ -278,6 +294,10 @@ void DmxSerialParams::Set() {
 		Serial::Get()->SetType(static_cast<type>(m_tDmxSerialParams.nType));
 	}
 
+	if (isMaskSet(DmxSerialParamsMask::TX_OVERFLOW)) {
+		Serial::Get()->SetTxOverflow(static_cast<tx::overflow>(m_tDmxSerialParams.nTxOverflow));
+	}
+
 	if (isMaskSet(DmxSerialParamsMask::BAUD)) {
 		Serial::Get()->SetUartBaud(m_tDmxSerialParams.nBaud);
 	}
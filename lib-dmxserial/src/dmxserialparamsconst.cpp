@@ -28,6 +28,7 @@
 const char DmxSerialParamsConst::FILE_NAME[] = "serial.txt";
 
 const char DmxSerialParamsConst::TYPE[] = "type";
+const char DmxSerialParamsConst::TX_OVERFLOW[] = "tx_overflow";
 
 const char DmxSerialParamsConst::UART_BAUD[] = "uart_baud";
 const char DmxSerialParamsConst::UART_BITS[] = "uart_bits";
@@ -38,6 +38,10 @@ void DmxSerialParams::Dump() {
 		printf(" %s=%d [%s]\n", DmxSerialParamsConst::TYPE, m_tDmxSerialParams.nType, Serial::GetType(static_cast<type>(m_tDmxSerialParams.nType)));
 	}
 
+	if (isMaskSet(DmxSerialParamsMask::TX_OVERFLOW)) {
+		printf(" %s=%s [%d]\n", DmxSerialParamsConst::TX_OVERFLOW, Serial::GetTxOverflow(static_cast<tx::overflow>(m_tDmxSerialParams.nTxOverflow)), m_tDmxSerialParams.nTxOverflow);
+	}
+
 	if (isMaskSet(DmxSerialParamsMask::BAUD)) {
 		printf(" %s=%d\n", DmxSerialParamsConst::UART_BAUD, m_tDmxSerialParams.nBaud);
 	}
@@ -74,6 +74,8 @@ bool DmxSerialTFTP::FileCreate(const char *pFileName, __attribute__((unused)) TF
 		return false;
 	}
 
+	DmxSerial::DeleteCache();
+
 	m_pFile = fopen(pFileName, "w+");
 	return (m_pFile != nullptr);
 }
@@ -34,12 +34,26 @@
 #include "h3_ccu.h"
 #include "uart.h"
 
+#include "arm/arm.h"
 #include "arm/synchronize.h"
+#include "arm/gic.h"
 
 #include "debug.h"
 
 using namespace serial;
 
+static void __attribute__((interrupt("FIQ"))) fiq_serial_uart() {
+	dmb();
+
+	if ((H3_UART1->O08.IIR & 0xF) == UART_IIR_IID_THRE) {
+		if (!Serial::Get()->TxUart()) {
+			H3_UART1->O04.IER = 0;
+		}
+	}
+
+	dmb();
+}
+
 void Serial::SetUartBaud(uint32_t nBaud) {
 	DEBUG_PRINTF("nBaud=%d", nBaud);
 
@@ -156,27 +170,56 @@ bool Serial::InitUart() {
 	H3_UART1->O04.IER = 0;
 	isb();
 
+	/*
+	 * The TX FIFO is topped up from the THR empty interrupt,
+	 * enabled by TxUartStart() when a message is queued.
+	 */
+	__disable_fiq();
+
+	arm_install_handler(reinterpret_cast<unsigned>(fiq_serial_uart), ARM_VECTOR(ARM_VECTOR_FIQ));
+	gic_fiq_config(H3_UART1_IRQn, GIC_CORE0);
+
+	m_bTxUartIrq = true;
+
+	isb();
+	__enable_fiq();
+
 	DEBUG_EXIT
 	return true;
 }
 
+void Serial::TxLock() {
+	if (m_bTxUartIrq) {
+		__disable_fiq();
+		dmb();
+	}
+}
 
+void Serial::TxUnlock() {
+	if (m_bTxUartIrq) {
+		dmb();
+		__enable_fiq();
+	}
+}
 
-void Serial::SendUart(const uint8_t *pData, uint32_t nLength) {
-	DEBUG_ENTRY
+/*
+ * An empty FIFO raises the interrupt as soon as it is enabled
+ */
+void Serial::TxUartStart() {
+	dmb();
+	H3_UART1->O04.IER = UART_IER_ETBEI;
+	isb();
+}
 
-	const uint8_t *p = pData;
 
-	while (nLength > 0) {
-		uint32_t nAvailable = 64 - H3_UART1->TFL;
 
-		while ((nLength > 0) && (nAvailable > 0)) {
-			H3_UART1->O00.THR = static_cast<uint32_t>(*p);
-			nLength--;
-			nAvailable--;
-			p++;
-		}
+uint32_t Serial::SendUart(const uint8_t *pData, uint32_t nLength) {
+	const uint32_t nAvailable = 64 - H3_UART1->TFL;
+	const uint32_t nCount = (nLength < nAvailable) ? nLength : nAvailable;
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		H3_UART1->O00.THR = static_cast<uint32_t>(pData[i]);
 	}
 
-	DEBUG_EXIT
+	return nCount;
 }
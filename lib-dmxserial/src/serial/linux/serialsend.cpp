@@ -30,11 +30,12 @@
 
 #include "debug.h"
 
-void Serial::SendUart(__attribute__((unused)) const uint8_t *pData, __attribute__((unused)) uint32_t nLength) {
+uint32_t Serial::SendUart(__attribute__((unused)) const uint8_t *pData, uint32_t nLength) {
 	assert(pData != 0);
 	assert(nLength != 0);
 
 	DEBUG_PUTS("SendUart");
+	return nLength;
 }
 
 void Serial::SendSpi(__attribute__((unused)) const uint8_t *pData, __attribute__((unused)) uint32_t nLength) {
@@ -50,3 +51,15 @@ void Serial::SendI2c(__attribute__((unused)) const uint8_t *pData, __attribute__
 
 	DEBUG_PUTS("SendI2c");
 }
+
+/*
+ * There is no UART TX interrupt, the queue is sent from Run()
+ */
+void Serial::TxLock() {
+}
+
+void Serial::TxUnlock() {
+}
+
+void Serial::TxUartStart() {
+}
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <cassert>
 
 #include "serial.h"
@@ -52,6 +53,8 @@ Serial::Serial()  {
 	m_I2cConfiguration.nAddress = 0x30;
 	m_I2cConfiguration.tMode = i2c::speed::FAST;
 
+	memset(&m_TxStatistics, 0, sizeof(m_TxStatistics));
+
 	DEBUG_EXIT
 }
 
@@ -63,27 +66,189 @@ Serial::~Serial() {
 	DEBUG_EXIT
 }
 
-void Serial::Send(const uint8_t *pData, uint32_t nLength) {
+void Serial::Send(const uint8_t *pData, uint32_t nLength, uint16_t nChannel) {
 	DEBUG_ENTRY
 	debug_dump(const_cast<uint8_t *>(pData), nLength);
 
-	if (m_tType == type::UART) {
-		SendUart(pData, nLength);
+	assert(pData != nullptr);
+
+	if (nLength == 0) {
+		DEBUG_EXIT
+		return;
 	}
 
-	if (m_tType == type::SPI) {
-		SendSpi(pData, nLength);
+	if (nLength > tx::BUFFER_SIZE) {
+		m_TxStatistics.nMessagesDropped++;
+		DEBUG_EXIT
+		return;
 	}
 
-	if (m_tType == type::I2C) {
-		SendI2c(pData, nLength);
+	TxLock();
+
+	/*
+	 * The message being sent (m_nTxSent != 0) is never touched
+	 */
+	if ((m_tTxOverflow == tx::overflow::COALESCE) && (nChannel != tx::NO_CHANNEL)) {
+		for (auto i = m_nTxTail + (m_nTxSent != 0 ? 1 : 0); i != m_nTxHead; i++) {
+			auto &message = m_TxMessages[i & (tx::MAX_MESSAGES - 1)];
+
+			if ((!message.bCancelled) && (message.nChannel == nChannel)) {
+				message.bCancelled = true;
+				m_TxStatistics.nMessagesCoalesced++;
+			}
+		}
+	}
+
+	uint32_t nOffset;
+
+	while (!TxReserve(nLength, nOffset)) {
+		if ((m_nTxSent != 0) || (m_nTxHead == m_nTxTail)) {
+			m_TxStatistics.nMessagesDropped++;
+			TxUnlock();
+			DEBUG_EXIT
+			return;
+		}
+
+		// Drop the oldest message
+		if (!m_TxMessages[m_nTxTail & (tx::MAX_MESSAGES - 1)].bCancelled) {
+			m_TxStatistics.nMessagesDropped++;
+		}
+
+		m_nTxTail++;
+	}
+
+	memcpy(&m_TxBuffer[nOffset], pData, nLength);
+
+	auto &message = m_TxMessages[m_nTxHead & (tx::MAX_MESSAGES - 1)];
+	message.nOffset = static_cast<uint16_t>(nOffset);
+	message.nLength = static_cast<uint16_t>(nLength);
+	message.nChannel = nChannel;
+	message.bCancelled = false;
+
+	m_nTxHead++;
+	m_nTxWrite = nOffset + nLength;
+
+	m_TxStatistics.nBytesQueued += nLength;
+
+	if ((m_nTxHead - m_nTxTail) > m_TxStatistics.nDepthMax) {
+		m_TxStatistics.nDepthMax = m_nTxHead - m_nTxTail;
+	}
+
+	TxUnlock();
+
+	if ((m_tType == type::UART) && m_bTxUartIrq) {
+		TxUartStart();
 	}
 
 	DEBUG_EXIT
 }
 
+/*
+ * A message is always stored contiguous, so it can be sent with a single SPI/I2C transfer.
+ * When it does not fit at the end of the buffer, it is stored at the start.
+ */
+bool Serial::TxReserve(uint32_t nLength, uint32_t &nOffset) {
+	if ((m_nTxHead - m_nTxTail) == tx::MAX_MESSAGES) {
+		return false;
+	}
+
+	if (m_nTxHead == m_nTxTail) {
+		nOffset = 0;
+		return true;
+	}
+
+	const uint32_t nRead = m_TxMessages[m_nTxTail & (tx::MAX_MESSAGES - 1)].nOffset;
+
+	if (m_nTxWrite > nRead) {
+		if ((m_nTxWrite + nLength) <= tx::BUFFER_SIZE) {
+			nOffset = m_nTxWrite;
+			return true;
+		}
+
+		if (nLength <= nRead) {
+			nOffset = 0;
+			return true;
+		}
+
+		return false;
+	}
+
+	if ((m_nTxWrite + nLength) <= nRead) {
+		nOffset = m_nTxWrite;
+		return true;
+	}
+
+	return false;
+}
+
+bool Serial::TxUart() {
+	while (m_nTxHead != m_nTxTail) {
+		const auto &message = m_TxMessages[m_nTxTail & (tx::MAX_MESSAGES - 1)];
+
+		if (message.bCancelled) {
+			m_nTxTail++;
+			continue;
+		}
+
+		const auto nSent = SendUart(&m_TxBuffer[message.nOffset + m_nTxSent], message.nLength - m_nTxSent);
+
+		m_nTxSent += nSent;
+		m_TxStatistics.nBytesSent += nSent;
+
+		if (m_nTxSent < message.nLength) {
+			return true;
+		}
+
+		m_TxStatistics.nMessagesSent++;
+		m_nTxSent = 0;
+		m_nTxTail++;
+	}
+
+	return false;
+}
+
+/*
+ * Called from the main loop. SPI and I2C send at most one message per call.
+ * The UART TX FIFO is topped up without waiting, unless the UART TX interrupt does this.
+ */
+void Serial::Run() {
+	if (m_tType == type::UART) {
+		if (!m_bTxUartIrq) {
+			TxUart();
+		}
+		return;
+	}
+
+	while (m_nTxHead != m_nTxTail) {
+		const auto &message = m_TxMessages[m_nTxTail & (tx::MAX_MESSAGES - 1)];
+
+		if (message.bCancelled) {
+			m_nTxTail++;
+			continue;
+		}
+
+		const auto *pData = &m_TxBuffer[message.nOffset];
+
+		if (m_tType == type::SPI) {
+			SendSpi(pData, message.nLength);
+		} else if (m_tType == type::I2C) {
+			SendI2c(pData, message.nLength);
+		}
+
+		m_TxStatistics.nBytesSent += message.nLength;
+		m_TxStatistics.nMessagesSent++;
+		m_nTxTail++;
+
+		return;
+	}
+}
+
 void Serial::Print() {
 	printf("Serial [%s]\n", GetType(m_tType));
+	printf(" TX overflow : %s\n", GetTxOverflow(m_tTxOverflow));
+	printf(" TX bytes    : %u queued, %u sent\n", static_cast<unsigned>(m_TxStatistics.nBytesQueued), static_cast<unsigned>(m_TxStatistics.nBytesSent));
+	printf(" TX messages : %u sent, %u dropped, %u coalesced\n", static_cast<unsigned>(m_TxStatistics.nMessagesSent), static_cast<unsigned>(m_TxStatistics.nMessagesDropped), static_cast<unsigned>(m_TxStatistics.nMessagesCoalesced));
+	printf(" TX depth    : %u [%u]\n", static_cast<unsigned>(GetTxDepth()), static_cast<unsigned>(m_TxStatistics.nDepthMax));
 
 	if (m_tType == type::UART) {
 		printf(" Baud     : %d\n", m_UartConfiguration.nBaud);
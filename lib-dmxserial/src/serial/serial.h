@@ -47,6 +47,22 @@ enum speed : uint8_t {
 	NORMAL, FAST, UNDEFINED
 };
 }  // namespace i2c
+namespace tx {
+enum overflow : uint8_t {
+	DROP_OLDEST, COALESCE, UNDEFINED
+};
+static constexpr uint32_t BUFFER_SIZE = 2048;
+static constexpr uint32_t MAX_MESSAGES = 64;	///< Must be a power of 2
+static constexpr uint16_t NO_CHANNEL = 0xFFFF;	///< Channel files are chl000 - chl999
+struct Statistics {
+	uint32_t nBytesQueued;
+	uint32_t nBytesSent;
+	uint32_t nMessagesSent;
+	uint32_t nMessagesDropped;
+	uint32_t nMessagesCoalesced;
+	uint32_t nDepthMax;
+};
+}  // namespace tx
 }  // namespace serial
 
 class Serial {
@@ -89,9 +105,42 @@ public:
 	void Print();
 
 	/*
-	 * Send the data
+	 * TX queue
+	 */
+	void SetTxOverflow(serial::tx::overflow tOverflow) {
+		if (tOverflow < serial::tx::overflow::UNDEFINED) {
+			m_tTxOverflow = tOverflow;
+		}
+	}
+
+	serial::tx::overflow GetTxOverflow() {
+		return m_tTxOverflow;
+	}
+
+	uint32_t GetTxDepth() {
+		return m_nTxHead - m_nTxTail;
+	}
+
+	const serial::tx::Statistics& GetTxStatistics() {
+		return m_TxStatistics;
+	}
+
+	/*
+	 * Queue the data, the queue is sent from Run().
+	 * With COALESCE, a queued message for the same channel is replaced.
+	 */
+	void Send(const uint8_t *pData, uint32_t nLength, uint16_t nChannel = serial::tx::NO_CHANNEL);
+
+	/*
+	 * Sends the queue, the UART only when it is not interrupt driven.
 	 */
-	void Send(const uint8_t *pData, uint32_t nLength);
+	void Run();
+
+	/*
+	 * Tops up the UART TX FIFO from the queue, returns false when the queue is empty.
+	 * Called from Run() or from the UART TX interrupt.
+	 */
+	bool TxUart();
 
 	static const char *GetType(serial::type tType);
 	static serial::type GetType(const char *pType);
@@ -102,13 +151,16 @@ public:
 	static const char *GetI2cSpeed(serial::i2c::speed tSpeed);
 	static serial::i2c::speed GetI2cSpeed(const char *pSpeed);
 
+	static const char *GetTxOverflow(serial::tx::overflow tOverflow);
+	static serial::tx::overflow GetTxOverflow(const char *pOverflow);
+
 	static Serial *Get() {
 		return s_pThis;
 	}
 
 private:
 	bool InitUart();
-	void SendUart(const uint8_t *pData, uint32_t nLength);
+	uint32_t SendUart(const uint8_t *pData, uint32_t nLength);
 
 	bool InitSpi();
 	void SendSpi(const uint8_t *pData, uint32_t nLength);
@@ -116,6 +168,11 @@ private:
 	bool InitI2c();
 	void SendI2c(const uint8_t *pData, uint32_t nLength);
 
+	bool TxReserve(uint32_t nLength, uint32_t &nOffset);
+	void TxLock();
+	void TxUnlock();
+	void TxUartStart();
+
 private:
 	serial::type m_tType{serial::type::UART};
 	struct {
@@ -133,6 +190,23 @@ private:
 		serial::i2c::speed tMode;
 	} m_I2cConfiguration;
 
+	struct TxMessage {
+		uint16_t nOffset;
+		uint16_t nLength;
+		uint16_t nChannel;
+		bool bCancelled;
+	};
+
+	uint8_t m_TxBuffer[serial::tx::BUFFER_SIZE];
+	TxMessage m_TxMessages[serial::tx::MAX_MESSAGES];
+	uint32_t m_nTxHead { 0 };
+	uint32_t m_nTxTail { 0 };
+	uint32_t m_nTxWrite { 0 };
+	uint32_t m_nTxSent { 0 };
+	bool m_bTxUartIrq { false };	///< The UART TX FIFO is topped up from the interrupt
+	serial::tx::overflow m_tTxOverflow { serial::tx::overflow::DROP_OLDEST };
+	serial::tx::Statistics m_TxStatistics;
+
 	static Serial *s_pThis;
 };
 
@@ -33,6 +33,7 @@ using namespace serial;
 constexpr char aType[type::UNDEFINED][5] = { "uart", "spi", "i2c" };
 constexpr char aUartParity[uart::parity::UNDEFINED][5] = { "none", "odd", "even" };
 constexpr char aI2cSpeed[i2c::speed::UNDEFINED][9] = { "standard", "fast" };
+constexpr char aTxOverflow[tx::overflow::UNDEFINED][9] = { "drop", "coalesce" };
 
 const char* Serial::GetType(type tType) {
 	if (tType < type::UNDEFINED) {
@@ -87,3 +88,21 @@ i2c::speed Serial::GetI2cSpeed(const char *pSpeed) {
 
 	return i2c::speed::FAST;
 }
+
+const char* Serial::GetTxOverflow(tx::overflow tOverflow) {
+	if (tOverflow < tx::overflow::UNDEFINED) {
+		return aTxOverflow[tOverflow];
+	}
+
+	return "Undefined";
+}
+
+tx::overflow Serial::GetTxOverflow(const char *pOverflow) {
+	for (uint32_t i = 0; i < tx::overflow::UNDEFINED; i++) {
+		if (strcasecmp(aTxOverflow[i], pOverflow) == 0) {
+			return static_cast<tx::overflow>(i);
+		}
+	}
+
+	return tx::overflow::DROP_OLDEST;
+}
@@ -48,6 +48,10 @@ struct OptionsMask {
 	static constexpr auto FORCE_SYNCHRONIZATION = (1 << 5);	///< Force Synchronization: Bit 5
 };
 
+namespace startcode {
+static constexpr auto DMX = 0x00;
+static constexpr auto PRIORITY = 0xDD;				///< Per address priority, one priority for each slot
+}  // namespace startcode
 namespace universe {
 static constexpr auto DEFAULT = 1;
 static constexpr auto MAX = 63999;
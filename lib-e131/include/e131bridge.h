@@ -33,6 +33,8 @@
 #include "e131packets.h"
 
 #include "lightset.h"
+#include "lightsetmerge.h"
+#include "lightsetbarrier.h"
 
 // Handlers
 #include "e131dmx.h"
@@ -51,32 +53,17 @@ struct TE131BridgeState {
 	uint32_t SynchronizationTime;
 	uint32_t DiscoveryTime;
 	uint16_t DiscoveryPacketLength;
-	uint16_t nSynchronizationAddressSourceA;
-	uint16_t nSynchronizationAddressSourceB;
+	uint16_t nSynchronizationAddressSource[lightset::merge::MAX_SOURCES];
 	uint8_t nActiveInputPorts;
 	uint8_t nActiveOutputPorts;
-	uint8_t nPriority;
-};
-
-struct TSource {
-	uint32_t time;
-	uint32_t ip;
-	uint8_t data[E131::DMX_LENGTH];
-	uint8_t cid[E131::CID_LENGTH];
-	uint8_t sequenceNumberData;
 };
 
 struct TE131OutputPort {
-	uint8_t data[E131::DMX_LENGTH];
-	uint16_t length;
 	uint16_t nUniverse;
 	e131::Merge mergeMode;
 	bool IsDataPending;
 	bool bIsEnabled;
 	bool IsTransmitting;
-	bool IsMerging;
-	struct TSource sourceA;
-	struct TSource sourceB;
 };
 
 struct TE131InputPort {
@@ -118,6 +105,22 @@ public:
 		return m_bDirectUpdate;
 	}
 
+	/**
+	 * When not synchronized the output ports are staged and committed together,
+	 * when all the enabled output ports received a data packet
+	 */
+	void SetOutputBarrier(bool bOutputBarrier) {
+		m_bOutputBarrier = bOutputBarrier;
+		UpdateBarrier();
+	}
+	bool GetOutputBarrier() const {
+		return m_bOutputBarrier;
+	}
+
+	const LightSetBarrier& GetBarrier() const {
+		return m_Barrier;
+	}
+
 	bool IsTransmitting(uint8_t nPortIndex) const;
 	bool IsMerging(uint8_t nPortIndex) const;
 	bool IsStatusChanged();
@@ -196,21 +199,19 @@ private:
 	bool IsValidRoot();
 	bool IsValidDataPacket();
 
-	void SetNetworkDataLossCondition(bool bSourceA = true, bool bSourceB = true);
+	void SetNetworkDataLossCondition();
+	void SetStreamTerminated(uint32_t nPortIndex, uint32_t nSourceIndex);
 
-	void SetSynchronizationAddress(bool bSourceA, bool bSourceB, uint16_t nSynchronizationAddress);
+	void SetSynchronizationAddress(uint32_t nSourceIndex, uint16_t nSynchronizationAddress);
 
-	void CheckMergeTimeouts(uint8_t nPortIndex);
-	bool IsPriorityTimeOut(uint8_t nPortIndex);
-	bool isIpCidMatch(const struct TSource *);
-	bool IsDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, uint16_t nLength);
-	bool IsMergedDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, uint16_t nLength);
+	void UpdateMergeStatus();
 
 	void HandleDmx();
 	void HandleSynchronization();
 
 	uint32_t UniverseToMulticastIp(uint16_t nUniverse) const;
 	void LeaveUniverse(uint8_t nPortIndex, uint16_t nUniverse);
+	void UpdateBarrier();
 
 	// Input
 	void HandleDmxIn();
@@ -224,6 +225,8 @@ private:
 	LightSet *m_pLightSet { nullptr };
 
 	bool m_bDirectUpdate { false };
+	bool m_bOutputBarrier { false };
+	LightSetBarrier m_Barrier;
 	bool m_bEnableDataIndicator { true };
 
 	uint32_t m_nCurrentPacketMillis { 0 };
@@ -232,6 +235,8 @@ private:
 	struct TE131BridgeState m_State;
 	struct TE131OutputPort m_OutputPort[E131::MAX_PORTS];
 	struct TE131InputPort m_InputPort[E131::MAX_UARTS];
+
+	LightSetMerge m_Merge { E131::MAX_PORTS, e131::MERGE_TIMEOUT_SECONDS };
 	struct TE131 m_E131;
 
 	// Input
@@ -71,6 +71,7 @@ struct E131ParamsMask {
 	static constexpr auto ENABLE_NO_CHANGE_OUTPUT = (1U << 14);
 	static constexpr auto DIRECTION = (1U << 15);
 	static constexpr auto PRIORITY = (1U << 16);
+	static constexpr auto OUTPUT_BARRIER = (1U << 17);
 };
 
 class E131ParamsStore {
@@ -114,6 +115,10 @@ public:
 		return isMaskSet(E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT);
 	}
 
+	bool IsOutputBarrier() const {
+		return isMaskSet(E131ParamsMask::OUTPUT_BARRIER);
+	}
+
 	e131::PortDir GetDirection() const {
 		return static_cast<e131::PortDir>(m_tE131Params.nDirection);
 	}
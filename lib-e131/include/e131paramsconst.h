@@ -27,12 +27,12 @@
 #define E131PARAMSCONST_H_
 
 struct E131ParamsConst {
-	static const char FILE_NAME[];
+	static constexpr char FILE_NAME[] = "e131.txt";
 
-	static const char NETWORK_DATA_LOSS_TIMEOUT[];
-	static const char DISABLE_MERGE_TIMEOUT[];
-	static const char DIRECTION[];
-	static const char PRIORITY[];
+	static constexpr char NETWORK_DATA_LOSS_TIMEOUT[] = "network_data_loss_timeout";
+	static constexpr char DISABLE_MERGE_TIMEOUT[] = "disable_merge_timeout";
+	static constexpr char DIRECTION[] = "direction";
+	static constexpr char PRIORITY[] = "priority";
 };
 
 #endif /* E131PARAMSCONST_H_ */
@@ -23,7 +23,6 @@
  * THE SOFTWARE.
  */
 
-#include <algorithm>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -68,7 +67,6 @@ E131Bridge::E131Bridge() {
 	}
 
 	memset(&m_State, 0, sizeof(struct TE131BridgeState));
-	m_State.nPriority = priority::LOWEST;
 
 	char aSourceName[E131::SOURCE_NAME_LENGTH];
 	uint8_t nLength;
@@ -116,7 +114,7 @@ void E131Bridge::Stop() {
 	if (m_pLightSet != nullptr) {
 		for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
 			m_pLightSet->Stop(i);
-			m_OutputPort[i].length = 0;
+			m_Merge.Reset(i);
 			m_OutputPort[i].IsDataPending = false;
 		}
 	}
@@ -157,22 +155,14 @@ uint32_t E131Bridge::UniverseToMulticastIp(uint16_t nUniverse) const {
 	return nMulticastIp;
 }
 
-void E131Bridge::SetSynchronizationAddress(bool bSourceA, bool bSourceB, uint16_t nSynchronizationAddress) {
+void E131Bridge::SetSynchronizationAddress(uint32_t nSourceIndex, uint16_t nSynchronizationAddress) {
 	DEBUG_ENTRY
-	DEBUG_PRINTF("bSourceA=%d, bSourceB=%d, nSynchronizationAddress=%d", bSourceA, bSourceB, nSynchronizationAddress);
+	DEBUG_PRINTF("nSourceIndex=%u, nSynchronizationAddress=%d", nSourceIndex, nSynchronizationAddress);
 
+	assert(nSourceIndex < lightset::merge::MAX_SOURCES);
 	assert(nSynchronizationAddress != 0);
 
-	uint16_t *pSynchronizationAddressSource;
-
-	if (bSourceA) {
-		pSynchronizationAddressSource = &m_State.nSynchronizationAddressSourceA;
-	} else if (bSourceB) {
-		pSynchronizationAddressSource = &m_State.nSynchronizationAddressSourceB;
-	} else {
-		DEBUG_EXIT
-		return; // Just make the compiler happy
-	}
+	auto *pSynchronizationAddressSource = &m_State.nSynchronizationAddressSource[nSourceIndex];
 
 	if (*pSynchronizationAddressSource == 0) {
 		*pSynchronizationAddressSource = nSynchronizationAddress;
@@ -214,6 +204,21 @@ void E131Bridge::LeaveUniverse(uint8_t nPortIndex, uint16_t nUniverse) {
 	DEBUG_EXIT
 }
 
+/*
+ * The expected ports of the output barrier, updated when an output port is enabled or disabled
+ */
+void E131Bridge::UpdateBarrier() {
+	uint32_t nPortMask = 0;
+
+	for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
+		if (m_OutputPort[i].bIsEnabled) {
+			nPortMask |= (1U << i);
+		}
+	}
+
+	m_Barrier.SetExpected(nPortMask);
+}
+
 void E131Bridge::SetUniverse(uint8_t nPortIndex, e131::PortDir dir, uint16_t nUniverse) {
 	assert(nPortIndex < E131::MAX_PORTS);
 	assert(dir <= PortDir::DISABLE);
@@ -252,6 +257,7 @@ void E131Bridge::SetUniverse(uint8_t nPortIndex, e131::PortDir dir, uint16_t nUn
 			}
 		}
 
+		UpdateBarrier();
 		return;
 	}
 
@@ -267,6 +273,7 @@ void E131Bridge::SetUniverse(uint8_t nPortIndex, e131::PortDir dir, uint16_t nUn
 		m_State.nActiveOutputPorts = m_State.nActiveOutputPorts + 1;
 		assert(m_State.nActiveOutputPorts <= E131::MAX_PORTS);
 		m_OutputPort[nPortIndex].bIsEnabled = true;
+		UpdateBarrier();
 	}
 
 	Network::Get()->JoinGroup(m_nHandle, UniverseToMulticastIp(nUniverse));
@@ -296,6 +303,7 @@ void E131Bridge::SetMergeMode(uint8_t nPortIndex, Merge tE131Merge) {
 	assert(nPortIndex < E131::MAX_PORTS);
 
 	m_OutputPort[nPortIndex].mergeMode = tE131Merge;
+	m_Merge.SetMode(nPortIndex, tE131Merge == Merge::LTP ? lightset::merge::Mode::LTP : lightset::merge::Mode::HTP);
 }
 
 Merge E131Bridge::GetMergeMode(uint8_t nPortIndex) const {
@@ -304,145 +312,29 @@ Merge E131Bridge::GetMergeMode(uint8_t nPortIndex) const {
 	return m_OutputPort[nPortIndex].mergeMode;
 }
 
-bool E131Bridge::IsDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, uint16_t nLength) {
-	assert(nPortIndex < E131::MAX_PORTS);
-	assert(pData != nullptr);
-
-	bool isChanged = false;
-	const uint8_t *pSrc = pData;
-	auto *pDst = m_OutputPort[nPortIndex].data;
-
-	if (nLength != m_OutputPort[nPortIndex].length) {
-		m_OutputPort[nPortIndex].length = nLength;
-		for (unsigned i = 0 ; i < E131::DMX_LENGTH; i++) {
-			*pDst++ = *pSrc++;
-		}
-		return true;
-	}
+void E131Bridge::UpdateMergeStatus() {
+	const auto bIsMerging = m_Merge.IsMerging();
 
-	for (unsigned i = 0; i < E131::DMX_LENGTH; i++) {
-		if (*pDst != *pSrc) {
-			*pDst = *pSrc;
-			isChanged = true;
-		}
-		pDst++;
-		pSrc++;
-	}
-
-	return isChanged;
-}
-
-bool E131Bridge::IsMergedDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, uint16_t nLength) {
-	assert(nPortIndex < E131::MAX_PORTS);
-	assert(pData != nullptr);
-
-	auto isChanged = false;
-
-	if (!m_State.IsMergeMode) {
-		m_State.IsMergeMode = true;
+	if (bIsMerging != m_State.IsMergeMode) {
+		m_State.IsMergeMode = bIsMerging;
 		m_State.IsChanged = true;
 	}
-
-	m_OutputPort[nPortIndex].IsMerging = true;
-
-	if (m_OutputPort[nPortIndex].mergeMode == Merge::HTP) {
-
-		if (nLength != m_OutputPort[nPortIndex].length) {
-			m_OutputPort[nPortIndex].length = nLength;
-			for (unsigned i = 0; i < nLength; i++) {
-				uint8_t data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-				m_OutputPort[nPortIndex].data[i] = data;
-			}
-			return true;
-		}
-
-		for (unsigned i = 0; i < nLength; i++) {
-			uint8_t data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-			if (data != m_OutputPort[nPortIndex].data[i]) {
-				m_OutputPort[nPortIndex].data[i] = data;
-				isChanged = true;
-			}
-		}
-
-		return isChanged;
-	} else {
-		return IsDmxDataChanged(nPortIndex, pData, nLength);
-	}
-}
-
-void E131Bridge::CheckMergeTimeouts(uint8_t nPortIndex) {
-	assert(nPortIndex < E131::MAX_PORTS);
-
-	const uint32_t timeOutA = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceA.time;
-
-	if (timeOutA > (MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPort[nPortIndex].sourceA.ip = 0;
-		memset(m_OutputPort[nPortIndex].sourceA.cid, 0, E131::CID_LENGTH);
-		m_OutputPort[nPortIndex].IsMerging = false;
-	}
-
-	const uint32_t timeOutB = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceB.time;
-
-	if (timeOutB > (MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPort[nPortIndex].sourceB.ip = 0;
-		memset(m_OutputPort[nPortIndex].sourceB.cid, 0, E131::CID_LENGTH);
-		m_OutputPort[nPortIndex].IsMerging = false;
-	}
-
-	bool bIsMerging = false;
-
-	for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
-		bIsMerging |= m_OutputPort[i].IsMerging;
-	}
-
-	if (!bIsMerging) {
-		m_State.IsChanged = true;
-		m_State.IsMergeMode = false;
-	}
-
 }
 
-bool E131Bridge::IsPriorityTimeOut(uint8_t nPortIndex) {
-	assert(nPortIndex < E131::MAX_PORTS);
-
-	const uint32_t timeOutA = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceA.time;
-	const uint32_t timeOutB = m_nCurrentPacketMillis - m_OutputPort[nPortIndex].sourceB.time;
-
-	if ( (m_OutputPort[nPortIndex].sourceA.ip != 0) && (m_OutputPort[nPortIndex].sourceB.ip != 0) ) {
-		if ( (timeOutA < (PRIORITY_TIMEOUT_SECONDS * 1000)) || (timeOutB < (PRIORITY_TIMEOUT_SECONDS * 1000)) ) {
-			return false;
-		} else {
-			return true;
-		}
-	} else if ( (m_OutputPort[nPortIndex].sourceA.ip != 0) && (m_OutputPort[nPortIndex].sourceB.ip == 0) ) {
-		if (timeOutA > (PRIORITY_TIMEOUT_SECONDS * 1000)) {
-			return true;
-		}
-	} else if ( (m_OutputPort[nPortIndex].sourceA.ip == 0) && (m_OutputPort[nPortIndex].sourceB.ip != 0) ) {
-		if (timeOutB > (PRIORITY_TIMEOUT_SECONDS * 1000)) {
-			return true;
-		}
-	}
-
-	return false;
-}
+void E131Bridge::HandleDmx() {
+	const uint8_t *p = &m_E131.E131Packet.Data.DMPLayer.PropertyValues[1];
+	const uint16_t slots = __builtin_bswap16(m_E131.E131Packet.Data.DMPLayer.PropertyValueCount) - 1;
+	const auto nStartCode = m_E131.E131Packet.Data.DMPLayer.PropertyValues[0];
+	const auto *pCid = m_E131.E131Packet.Data.RootLayer.Cid;
 
-bool E131Bridge::isIpCidMatch(const struct TSource *source) {
-	if (source->ip != m_E131.IPAddressFrom) {
-		return false;
+	if (__builtin_expect((slots > E131::DMX_LENGTH), 0)) {
+		return;
 	}
 
-	if (memcmp(source->cid, m_E131.E131Packet.Raw.RootLayer.Cid, E131::CID_LENGTH) != 0) {
-		return false;
+	if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
+		m_Merge.Run(m_nCurrentPacketMillis);
 	}
 
-	return true;
-}
-
-void E131Bridge::HandleDmx() {
-	const uint8_t *p = &m_E131.E131Packet.Data.DMPLayer.PropertyValues[1];
-	const uint16_t slots = __builtin_bswap16(m_E131.E131Packet.Data.DMPLayer.PropertyValueCount) - 1;
-
 	for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
 		if (!m_OutputPort[i].bIsEnabled) {
 			continue;
@@ -456,30 +348,16 @@ void E131Bridge::HandleDmx() {
 			continue;
 		}
 
-		struct TSource *pSourceA = &m_OutputPort[i].sourceA;
-		struct TSource *pSourceB = &m_OutputPort[i].sourceB;
-
-		const uint32_t ipA = pSourceA->ip;
-		const uint32_t ipB = pSourceB->ip;
-
-		const bool isSourceA = isIpCidMatch(pSourceA);
-		const bool isSourceB = isIpCidMatch(pSourceB);
-
-		bool sendNewData = false;
+		auto nSourceIndex = m_Merge.FindSource(i, m_E131.IPAddressFrom, pCid);
 
 		// 6.9.2 Sequence Numbering
 		// Having first received a packet with sequence number A, a second packet with sequence number B
 		// arrives. If, using signed 8-bit binary arithmetic, B – A is less than or equal to 0, but greater than -20 then
 		// the packet containing sequence number B shall be deemed out of sequence and discarded
-		if (isSourceA) {
-			const auto diff = static_cast<int8_t>(m_E131.E131Packet.Data.FrameLayer.SequenceNumber - pSourceA->sequenceNumberData);
-			pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			if ((diff <= 0) && (diff > -20)) {
-				continue;
-			}
-		} else if (isSourceB) {
-			const auto diff = static_cast<int8_t>(m_E131.E131Packet.Data.FrameLayer.SequenceNumber - pSourceB->sequenceNumberData);
-			pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
+		if (nSourceIndex != lightset::merge::INVALID_SOURCE) {
+			auto *pSource = m_Merge.GetSource(i, nSourceIndex);
+			const auto diff = static_cast<int8_t>(m_E131.E131Packet.Data.FrameLayer.SequenceNumber - pSource->nSequenceNumber);
+			pSource->nSequenceNumber = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
 			if ((diff <= 0) && (diff > -20)) {
 				continue;
 			}
@@ -494,101 +372,38 @@ void E131Bridge::HandleDmx() {
 		// Upon receipt of a packet containing this bit set to a value of 1, receiver shall enter network data loss condition.
 		// Any property values in these packets shall be ignored.
 		if ((m_E131.E131Packet.Data.FrameLayer.Options & OptionsMask::STREAM_TERMINATED) != 0) {
-			if (isSourceA || isSourceB) {
-				SetNetworkDataLossCondition(isSourceA, isSourceB);
+			if (nSourceIndex != lightset::merge::INVALID_SOURCE) {
+				SetStreamTerminated(i, nSourceIndex);
 			}
 			continue;
 		}
 
-		if (m_State.IsMergeMode) {
-			if (__builtin_expect((!m_State.bDisableMergeTimeout), 1)) {
-				CheckMergeTimeouts(i);
-			}
+		if ((nStartCode != startcode::DMX) && (nStartCode != startcode::PRIORITY)) {
+			continue;
 		}
 
-		if (m_E131.E131Packet.Data.FrameLayer.Priority < m_State.nPriority ){
-			if (!IsPriorityTimeOut(i)) {
+		if (nSourceIndex == lightset::merge::INVALID_SOURCE) {
+			nSourceIndex = m_Merge.AddSource(i, m_E131.IPAddressFrom, pCid);
+
+			if (nSourceIndex == lightset::merge::INVALID_SOURCE) {
+				DEBUG_PUTS("Too many sources, discarding data");
 				continue;
 			}
-			m_State.nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
-		} else if (m_E131.E131Packet.Data.FrameLayer.Priority > m_State.nPriority) {
-			m_OutputPort[i].sourceA.ip = 0;
-			m_OutputPort[i].sourceB.ip = 0;
-			m_State.IsMergeMode = false;
-			m_State.nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
-		}
-
-		if ((ipA == 0) && (ipB == 0)) {
-			//printf("1. First package from Source\n");
-			pSourceA->ip = m_E131.IPAddressFrom;
-			pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			memcpy(pSourceA->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
-			pSourceA->time = m_nCurrentPacketMillis;
-			memcpy(pSourceA->data, p, slots);
-			sendNewData = IsDmxDataChanged(i, p, slots);
-
-		} else if (isSourceA && (ipB == 0)) {
-			//printf("2. Continue package from SourceA\n");
-			pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			pSourceA->time = m_nCurrentPacketMillis;
-			memcpy(pSourceA->data, p, slots);
-			sendNewData = IsDmxDataChanged(i, p, slots);
-
-		} else if ((ipA == 0) && isSourceB) {
-			//printf("3. Continue package from SourceB\n");
-			pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			pSourceB->time = m_nCurrentPacketMillis;
-			memcpy(pSourceB->data, p, slots);
-			sendNewData = IsDmxDataChanged(i, p, slots);
-
-		} else if (!isSourceA && (ipB == 0)) {
-			//printf("4. New ip, start merging\n");
-			pSourceB->ip = m_E131.IPAddressFrom;
-			pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			memcpy(pSourceB->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
-			pSourceB->time = m_nCurrentPacketMillis;
-			memcpy(pSourceB->data, p, slots);
-			sendNewData = IsMergedDmxDataChanged(i, pSourceB->data, slots);
-
-		} else if ((ipA == 0) && !isSourceB) {
-			//printf("5. New ip, start merging\n");
-			pSourceA->ip = m_E131.IPAddressFrom;
-			pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			memcpy(pSourceA->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
-			pSourceA->time = m_nCurrentPacketMillis;
-			memcpy(pSourceA->data, p, slots);
-			sendNewData = IsMergedDmxDataChanged(i, pSourceA->data, slots);
-
-		} else if (isSourceA && !isSourceB) {
-			//printf("6. Continue merging\n");
-			pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			pSourceA->time = m_nCurrentPacketMillis;
-			memcpy(pSourceA->data, p, slots);
-			sendNewData = IsMergedDmxDataChanged(i, pSourceA->data, slots);
-
-		} else if (!isSourceA && isSourceB) {
-			//printf("7. Continue merging\n");
-			pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-			pSourceB->time = m_nCurrentPacketMillis;
-			memcpy(pSourceB->data, p, slots);
-			sendNewData = IsMergedDmxDataChanged(i, pSourceB->data, slots);
-
-		} else if (isSourceA && isSourceB) {
-			printf("8. Source matches both buffers, this shouldn't be happening!\n");
-			assert(0);
-			return;
 
-		} else if (!isSourceA && !isSourceB) {
-			printf("9. More than two sources, discarding data\n");
-			assert(0);
-			return;
+			m_Merge.GetSource(i, nSourceIndex)->nSequenceNumber = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
+		}
 
+		// Only the sources with the highest priority are merged, see LightSetMerge
+		bool sendNewData;
+
+		if (__builtin_expect((nStartCode == startcode::DMX), 1)) {
+			sendNewData = m_Merge.SetData(i, nSourceIndex, m_E131.E131Packet.Data.FrameLayer.Priority, p, slots, m_nCurrentPacketMillis);
 		} else {
-			printf("0. No cases matched, this shouldn't happen!\n");
-			assert(0);
-			return;
+			sendNewData = m_Merge.SetSlotPriority(i, nSourceIndex, p, slots, m_nCurrentPacketMillis);
 		}
 
+		UpdateMergeStatus();
+
 		// This bit indicates whether to lock or revert to an unsynchronized state when synchronization is lost
 		// (See Section 11 on Universe Synchronization and 11.1 for discussion on synchronization states).
 		// When set to 0, components that had been operating in a synchronized state shall not update with any
@@ -602,11 +417,7 @@ void E131Bridge::HandleDmx() {
 			// Receivers shall ignore E1.31 Synchronization Packets containing a Synchronization Address of 0.
 			if (m_E131.E131Packet.Data.FrameLayer.SynchronizationAddress != 0) {
 				if (!m_State.IsForcedSynchronized) {
-					if (!(isSourceA || isSourceB)) {
-						SetSynchronizationAddress((pSourceA->ip != 0), (pSourceB->ip != 0), __builtin_bswap16(m_E131.E131Packet.Data.FrameLayer.SynchronizationAddress));
-					} else {
-						SetSynchronizationAddress(isSourceA, isSourceB, __builtin_bswap16(m_E131.E131Packet.Data.FrameLayer.SynchronizationAddress));
-					}
+					SetSynchronizationAddress(nSourceIndex, __builtin_bswap16(m_E131.E131Packet.Data.FrameLayer.SynchronizationAddress));
 					m_State.IsForcedSynchronized = true;
 					m_State.IsSynchronized = true;
 				}
@@ -615,10 +426,21 @@ void E131Bridge::HandleDmx() {
 			m_State.IsForcedSynchronized = false;
 		}
 
-		if (sendNewData || m_bDirectUpdate) {
-			if ((!m_State.IsSynchronized) || (m_State.bDisableSynchronize)) {
+		const auto bIsSynchronized = (m_State.IsSynchronized && !m_State.bDisableSynchronize);
 
-				m_pLightSet->SetData(i, m_OutputPort[i].data, m_OutputPort[i].length);
+		// A repeated port commits the pending frame before its new data is staged
+		if (m_bOutputBarrier && !bIsSynchronized && m_Barrier.IsRepeated(i)) {
+			m_pLightSet->Commit();
+			m_Barrier.Commit();
+		}
+
+		if (sendNewData || m_bDirectUpdate) {
+			if (!bIsSynchronized) {
+				if (m_bOutputBarrier) {
+					m_pLightSet->Stage(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+				} else {
+					m_pLightSet->SetData(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+				}
 
 				if (!m_OutputPort[i].IsTransmitting) {
 					m_pLightSet->Start(i);
@@ -631,6 +453,14 @@ void E131Bridge::HandleDmx() {
 
 		}
 
+		// When synchronized the barrier only measures the skew, the Synchronization Packet commits
+		if (m_bOutputBarrier || bIsSynchronized) {
+			if (m_Barrier.Arrive(i, Hardware::Get()->Micros()) && !bIsSynchronized) {
+				m_pLightSet->Commit();
+				m_Barrier.Commit();
+			}
+		}
+
 		m_State.bIsReceivingDmx = true;
 	}
 }
@@ -645,7 +475,15 @@ void E131Bridge::HandleSynchronization() {
 
 	const uint16_t nSynchronizationAddress = __builtin_bswap16(m_E131.E131Packet.Synchronization.FrameLayer.UniverseNumber);
 
-	if ((nSynchronizationAddress != m_State.nSynchronizationAddressSourceA) && (nSynchronizationAddress != m_State.nSynchronizationAddressSourceB)) {
+	uint32_t nSourceIndex;
+
+	for (nSourceIndex = 0; nSourceIndex < lightset::merge::MAX_SOURCES; nSourceIndex++) {
+		if (nSynchronizationAddress == m_State.nSynchronizationAddressSource[nSourceIndex]) {
+			break;
+		}
+	}
+
+	if (nSourceIndex == lightset::merge::MAX_SOURCES) {
 		LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
 		DEBUG_PUTS("");
 		return;
@@ -653,10 +491,13 @@ void E131Bridge::HandleSynchronization() {
 
 	m_State.SynchronizationTime = m_nCurrentPacketMillis;
 
+	auto bIsStaged = false;
+
 	for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
 		if ((m_OutputPort[i].IsDataPending) || (m_OutputPort[i].bIsEnabled && m_bDirectUpdate)){
 
-			m_pLightSet->SetData(i, m_OutputPort[i].data, m_OutputPort[i].length);
+			m_pLightSet->Stage(i, m_Merge.GetData(i), m_Merge.GetLength(i));
+			bIsStaged = true;
 
 			if (!m_OutputPort[i].IsTransmitting) {
 				m_pLightSet->Start(i);
@@ -667,66 +508,57 @@ void E131Bridge::HandleSynchronization() {
 		}
 	}
 
+	if (bIsStaged) {
+		m_pLightSet->Commit();
+	}
+
+	m_Barrier.Commit();
+
 	if (m_pE131Sync != nullptr) {
 		m_pE131Sync->Handler();
 	}
 }
 
-void E131Bridge::SetNetworkDataLossCondition(bool bSourceA, bool bSourceB) {
+void E131Bridge::SetNetworkDataLossCondition() {
 	DEBUG_ENTRY
-	DEBUG_PRINTF("%d %d", bSourceA, bSourceB);
 
 	m_State.IsChanged = true;
+	m_State.IsNetworkDataLoss = true;
+	m_State.IsMergeMode = false;
+	m_State.IsSynchronized = false;
+	m_State.IsForcedSynchronized = false;
 
-	if (bSourceA && bSourceB) {
-		m_State.IsNetworkDataLoss = true;
-		m_State.IsMergeMode = false;
-		m_State.IsSynchronized = false;
-		m_State.IsForcedSynchronized = false;
-		m_State.nPriority = priority::LOWEST;
-
-		for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
-			if (m_OutputPort[i].IsTransmitting) {
-				m_pLightSet->Stop(i);
-				m_OutputPort[i].sourceA.ip = 0;
-				memset(m_OutputPort[i].sourceA.cid, 0, E131::CID_LENGTH);
-				m_OutputPort[i].sourceB.ip = 0;
-				memset(m_OutputPort[i].sourceB.cid, 0, E131::CID_LENGTH);
-				m_OutputPort[i].length = 0;
-				m_OutputPort[i].IsDataPending = false;
-				m_OutputPort[i].IsTransmitting = false;
-				m_OutputPort[i].IsMerging = false;
-			}
+	for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
+		if (m_OutputPort[i].IsTransmitting) {
+			m_pLightSet->Stop(i);
+			m_OutputPort[i].IsDataPending = false;
+			m_OutputPort[i].IsTransmitting = false;
 		}
 
-	} else {
-		for (uint32_t i = 0; i < E131::MAX_PORTS; i++) {
-			if (m_OutputPort[i].IsTransmitting) {
+		m_Merge.Reset(i);
+	}
 
-				if ((bSourceA) && (m_OutputPort[i].sourceA.ip != 0)) {
-					m_OutputPort[i].sourceA.ip = 0;
-					memset(m_OutputPort[i].sourceA.cid, 0, E131::CID_LENGTH);
-					m_OutputPort[i].IsMerging = false;
-				}
+	LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
+	m_State.bIsReceivingDmx = false;
 
-				if ((bSourceB) && (m_OutputPort[i].sourceB.ip != 0)) {
-					m_OutputPort[i].sourceB.ip = 0;
-					memset(m_OutputPort[i].sourceB.cid, 0, E131::CID_LENGTH);
-					m_OutputPort[i].IsMerging = false;
-				}
+	DEBUG_EXIT
+}
 
-				if (!m_State.IsMergeMode) {
-					m_pLightSet->Stop(i);
-					m_OutputPort[i].length = 0;
-					m_OutputPort[i].IsDataPending = false;
-					m_OutputPort[i].IsTransmitting = false;
-				}
-			}
-		}
+void E131Bridge::SetStreamTerminated(uint32_t nPortIndex, uint32_t nSourceIndex) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nPortIndex=%u, nSourceIndex=%u", nPortIndex, nSourceIndex);
+
+	m_Merge.RemoveSource(nPortIndex, nSourceIndex);
+
+	if ((m_Merge.GetActiveSources(nPortIndex) == 0) && m_OutputPort[nPortIndex].IsTransmitting) {
+		m_pLightSet->Stop(nPortIndex);
+		m_Merge.Reset(nPortIndex);
+		m_OutputPort[nPortIndex].IsDataPending = false;
+		m_OutputPort[nPortIndex].IsTransmitting = false;
 	}
 
-	LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
-	m_State.bIsReceivingDmx = false;
+	m_State.IsChanged = true;
+	UpdateMergeStatus();
 
 	DEBUG_EXIT
 }
@@ -738,7 +570,7 @@ bool E131Bridge::IsTransmitting(uint8_t nPortIndex) const {
 
 bool E131Bridge::IsMerging(uint8_t nPortIndex) const {
 	assert(nPortIndex < E131::MAX_PORTS);
-	return m_OutputPort[nPortIndex].IsMerging;
+	return m_Merge.IsMerging(nPortIndex);
 }
 
 bool E131Bridge::IsStatusChanged() {
@@ -753,15 +585,9 @@ bool E131Bridge::IsStatusChanged() {
 void E131Bridge::Clear(uint8_t nPortIndex) {
 	assert(nPortIndex < E131::MAX_PORTS);
 
-	uint8_t *pDst = m_OutputPort[nPortIndex].data;
-
-	for (uint32_t i = 0; i < E131::DMX_LENGTH; i++) {
-		*pDst++ = 0;
-	}
-
-	m_OutputPort[nPortIndex].length = E131::DMX_LENGTH;
+	m_Merge.Clear(nPortIndex);
 
-	m_pLightSet->SetData(nPortIndex, m_OutputPort[nPortIndex].data, m_OutputPort[nPortIndex].length);
+	m_pLightSet->SetData(nPortIndex, m_Merge.GetData(nPortIndex), m_Merge.GetLength(nPortIndex));
 
 	if (m_OutputPort[nPortIndex].bIsEnabled && !m_OutputPort[nPortIndex].IsTransmitting) {
 		m_pLightSet->Start(nPortIndex);
@@ -75,6 +75,10 @@ void E131Bridge::Print() {
 		printf(" Direct update : Yes\n");
 	}
 
+	if (m_bOutputBarrier) {
+		printf(" Output barrier : Yes [skew %u/%u us, %u commits]\n", m_Barrier.GetSkewMicros(), m_Barrier.GetSkewMaxMicros(), m_Barrier.GetCommits());
+	}
+
 	if (m_State.bDisableSynchronize) {
 		printf(" Synchronize is disabled\n");
 	}
@@ -38,6 +38,7 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertieskey.h"
 
 #include "lightsetconst.h"
 
@@ -106,105 +107,128 @@ void E131Params::callbackFunction(const char *pLine) {
 	uint16_t value16;
 	float fValue;
 
-	if (Sscan::Uint16(pLine, LightSetConst::PARAMS_UNIVERSE, value16) == Sscan::OK) {
-		if ((value16 == 0) || (value16 > universe::MAX) || (value16 == universe::DEFAULT)) {
-			m_tE131Params.nUniverse = universe::DEFAULT;
-			m_tE131Params.nSetList &= ~E131ParamsMask::UNIVERSE;
-		} else {
-			m_tE131Params.nUniverse = value16;
-			m_tE131Params.nSetList |= E131ParamsMask::UNIVERSE;
+	switch (properties::key(pLine)) {
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE):
+		if (Sscan::Uint16(pLine, LightSetConst::PARAMS_UNIVERSE, value16) == Sscan::OK) {
+			if ((value16 == 0) || (value16 > universe::MAX) || (value16 == universe::DEFAULT)) {
+				m_tE131Params.nUniverse = universe::DEFAULT;
+				m_tE131Params.nSetList &= ~E131ParamsMask::UNIVERSE;
+			} else {
+				m_tE131Params.nUniverse = value16;
+				m_tE131Params.nSetList |= E131ParamsMask::UNIVERSE;
+			}
 		}
 		return;
-	}
-
-	nLength = 3;
-	if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE, value, nLength) == Sscan::OK) {
-		if (E131::GetMergeMode(value) == Merge::LTP) {
-			m_tE131Params.nMergeMode = static_cast<uint8_t>(Merge::LTP);
-			m_tE131Params.nSetList |= E131ParamsMask::MERGE_MODE;
-		} else {
-			m_tE131Params.nMergeMode = static_cast<uint8_t>(Merge::HTP);
-			m_tE131Params.nSetList &= ~E131ParamsMask::MERGE_MODE;
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE):
+		nLength = 3;
+		if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE, value, nLength) == Sscan::OK) {
+			if (E131::GetMergeMode(value) == Merge::LTP) {
+				m_tE131Params.nMergeMode = static_cast<uint8_t>(Merge::LTP);
+				m_tE131Params.nSetList |= E131ParamsMask::MERGE_MODE;
+			} else {
+				m_tE131Params.nMergeMode = static_cast<uint8_t>(Merge::HTP);
+				m_tE131Params.nSetList &= ~E131ParamsMask::MERGE_MODE;
+			}
 		}
 		return;
-	}
-
-	for (uint32_t i = 0; i < E131_PARAMS::MAX_PORTS; i++) {
-		if (Sscan::Uint16(pLine, LightSetConst::PARAMS_UNIVERSE_PORT[i], value16) == Sscan::OK) {
-			if ((value16 == 0) || (value16 == (i + 1)) || (value16 > universe::MAX)) {
-				m_tE131Params.nUniversePort[i] = i + 1;
-				m_tE131Params.nSetList &= ~(E131ParamsMask::UNIVERSE_A << i);
-			} else {
-				m_tE131Params.nUniversePort[i] = value16;
-				m_tE131Params.nSetList |= (E131ParamsMask::UNIVERSE_A << i);
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[0]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[1]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[2]):
+	case properties::hash(LightSetConst::PARAMS_UNIVERSE_PORT[3]):
+		for (uint32_t i = 0; i < E131_PARAMS::MAX_PORTS; i++) {
+			if (Sscan::Uint16(pLine, LightSetConst::PARAMS_UNIVERSE_PORT[i], value16) == Sscan::OK) {
+				if ((value16 == 0) || (value16 == (i + 1)) || (value16 > universe::MAX)) {
+					m_tE131Params.nUniversePort[i] = i + 1;
+					m_tE131Params.nSetList &= ~(E131ParamsMask::UNIVERSE_A << i);
+				} else {
+					m_tE131Params.nUniversePort[i] = value16;
+					m_tE131Params.nSetList |= (E131ParamsMask::UNIVERSE_A << i);
+				}
+				return;
 			}
-			return;
 		}
-
-		nLength = 3;
-		if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE_PORT[i], value, nLength) == Sscan::OK) {
-			if (E131::GetMergeMode(value) == Merge::LTP) {
-				m_tE131Params.nMergeModePort[i] = static_cast<uint8_t>(Merge::LTP);
-				m_tE131Params.nSetList |= (E131ParamsMask::MERGE_MODE_A << i);
+		return;
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[0]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[1]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[2]):
+	case properties::hash(LightSetConst::PARAMS_MERGE_MODE_PORT[3]):
+		for (uint32_t i = 0; i < E131_PARAMS::MAX_PORTS; i++) {
+			nLength = 3;
+			if (Sscan::Char(pLine, LightSetConst::PARAMS_MERGE_MODE_PORT[i], value, nLength) == Sscan::OK) {
+				if (E131::GetMergeMode(value) == Merge::LTP) {
+					m_tE131Params.nMergeModePort[i] = static_cast<uint8_t>(Merge::LTP);
+					m_tE131Params.nSetList |= (E131ParamsMask::MERGE_MODE_A << i);
+				} else {
+					m_tE131Params.nMergeModePort[i] = static_cast<uint8_t>(Merge::HTP);
+					m_tE131Params.nSetList &= ~(E131ParamsMask::MERGE_MODE_A << i);
+				}
+				return;
+			}
+		}
+		return;
+	case properties::hash(E131ParamsConst::NETWORK_DATA_LOSS_TIMEOUT):
+		if (Sscan::Float(pLine, E131ParamsConst::NETWORK_DATA_LOSS_TIMEOUT, fValue) == Sscan::OK) {
+			if (fValue != NETWORK_DATA_LOSS_TIMEOUT_SECONDS) {
+				m_tE131Params.nSetList |= E131ParamsMask::NETWORK_TIMEOUT;
 			} else {
-				m_tE131Params.nMergeModePort[i] = static_cast<uint8_t>(Merge::HTP);
-				m_tE131Params.nSetList &= ~(E131ParamsMask::MERGE_MODE_A << i);
+				m_tE131Params.nSetList &= ~E131ParamsMask::NETWORK_TIMEOUT;
 			}
-			return;
+			m_tE131Params.nNetworkTimeout = fValue;
 		}
-	}
-
-	if (Sscan::Float(pLine, E131ParamsConst::NETWORK_DATA_LOSS_TIMEOUT, fValue) == Sscan::OK) {
-		if (fValue != NETWORK_DATA_LOSS_TIMEOUT_SECONDS) {
-			m_tE131Params.nSetList |= E131ParamsMask::NETWORK_TIMEOUT;
-		} else {
-			m_tE131Params.nSetList &= ~E131ParamsMask::NETWORK_TIMEOUT;
+		return;
+	case properties::hash(E131ParamsConst::DISABLE_MERGE_TIMEOUT):
+		if (Sscan::Uint8(pLine, E131ParamsConst::DISABLE_MERGE_TIMEOUT, value8) == Sscan::OK) {
+			if (value8 != 0) {
+				m_tE131Params.nSetList |= E131ParamsMask::DISABLE_MERGE_TIMEOUT;
+			} else {
+				m_tE131Params.nSetList &= ~E131ParamsMask::DISABLE_MERGE_TIMEOUT;
+			}
 		}
-		m_tE131Params.nNetworkTimeout = fValue;
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, E131ParamsConst::DISABLE_MERGE_TIMEOUT, value8) == Sscan::OK) {
-		if (value8 != 0) {
-			m_tE131Params.nSetList |= E131ParamsMask::DISABLE_MERGE_TIMEOUT;
-		} else {
-			m_tE131Params.nSetList &= ~E131ParamsMask::DISABLE_MERGE_TIMEOUT;
+	case properties::hash(LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, value8) == Sscan::OK) {
+			if (value8 != 0) {
+				m_tE131Params.nSetList |= E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT;
+			} else {
+				m_tE131Params.nSetList &= ~E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT;
+			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, value8) == Sscan::OK) {
-		if (value8 != 0) {
-			m_tE131Params.nSetList |= E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT;
-		} else {
-			m_tE131Params.nSetList &= ~E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT;
+	case properties::hash(LightSetConst::PARAMS_OUTPUT_BARRIER):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_OUTPUT_BARRIER, value8) == Sscan::OK) {
+			if (value8 != 0) {
+				m_tE131Params.nSetList |= E131ParamsMask::OUTPUT_BARRIER;
+			} else {
+				m_tE131Params.nSetList &= ~E131ParamsMask::OUTPUT_BARRIER;
+			}
 		}
 		return;
-	}
-
-	nLength = 5;
-	if (Sscan::Char(pLine, E131ParamsConst::DIRECTION, value, nLength) == Sscan::OK) {
-		if (memcmp(value, "input", 5) == 0) {
-			m_tE131Params.nDirection = static_cast<uint8_t>(PortDir::INPUT);
-			m_tE131Params.nSetList |= E131ParamsMask::DIRECTION;
-		} else {
-			m_tE131Params.nDirection = static_cast<uint8_t>(PortDir::OUTPUT);
-			m_tE131Params.nSetList &= ~E131ParamsMask::DIRECTION;
+	case properties::hash(E131ParamsConst::DIRECTION):
+		nLength = 5;
+		if (Sscan::Char(pLine, E131ParamsConst::DIRECTION, value, nLength) == Sscan::OK) {
+			if (memcmp(value, "input", 5) == 0) {
+				m_tE131Params.nDirection = static_cast<uint8_t>(PortDir::INPUT);
+				m_tE131Params.nSetList |= E131ParamsMask::DIRECTION;
+			} else {
+				m_tE131Params.nDirection = static_cast<uint8_t>(PortDir::OUTPUT);
+				m_tE131Params.nSetList &= ~E131ParamsMask::DIRECTION;
+			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, E131ParamsConst::PRIORITY, value8) == Sscan::OK) {
-		if ((value8 >= priority::LOWEST) && (value8 <= priority::HIGHEST) && (value8 != priority::DEFAULT)) {
-			m_tE131Params.nPriority = value8;
-			m_tE131Params.nSetList |= E131ParamsMask::PRIORITY;
-		} else {
-			m_tE131Params.nPriority = priority::DEFAULT;
-			m_tE131Params.nSetList &= ~E131ParamsMask::PRIORITY;
+	case properties::hash(E131ParamsConst::PRIORITY):
+		if (Sscan::Uint8(pLine, E131ParamsConst::PRIORITY, value8) == Sscan::OK) {
+			if ((value8 >= priority::LOWEST) && (value8 <= priority::HIGHEST) && (value8 != priority::DEFAULT)) {
+				m_tE131Params.nPriority = value8;
+				m_tE131Params.nSetList |= E131ParamsMask::PRIORITY;
+			} else {
+				m_tE131Params.nPriority = priority::DEFAULT;
+				m_tE131Params.nSetList &= ~E131ParamsMask::PRIORITY;
+			}
 		}
 		return;
+	default:
+		return;
 	}
-
 }
 
 uint16_t E131Params::GetUniverse(uint8_t nPort, bool &IsSet) {
@@ -25,9 +25,9 @@
 
 #include "e131paramsconst.h"
 
-const char E131ParamsConst::FILE_NAME[] = "e131.txt";
+constexpr char E131ParamsConst::FILE_NAME[];
 
-const char E131ParamsConst::NETWORK_DATA_LOSS_TIMEOUT[] = "network_data_loss_timeout";
-const char E131ParamsConst::DISABLE_MERGE_TIMEOUT[] = "disable_merge_timeout";
-const char E131ParamsConst::DIRECTION[] = "direction";
-const char E131ParamsConst::PRIORITY[] = "priority";
+constexpr char E131ParamsConst::NETWORK_DATA_LOSS_TIMEOUT[];
+constexpr char E131ParamsConst::DISABLE_MERGE_TIMEOUT[];
+constexpr char E131ParamsConst::DIRECTION[];
+constexpr char E131ParamsConst::PRIORITY[];
@@ -74,6 +74,7 @@ void E131Params::Builder(const struct TE131Params *ptE131Params, char *pBuffer,
 	builder.Add(E131ParamsConst::DISABLE_MERGE_TIMEOUT, isMaskSet(E131ParamsMask::DISABLE_MERGE_TIMEOUT));
 
 	builder.Add(LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE, isMaskSet(E131ParamsMask::ENABLE_NO_CHANGE_OUTPUT));
+	builder.Add(LightSetConst::PARAMS_OUTPUT_BARRIER, isMaskSet(E131ParamsMask::OUTPUT_BARRIER));
 
 	builder.AddComment("DMX Input");
 	builder.Add(E131ParamsConst::PRIORITY, m_tE131Params.nPriority, isMaskSet(E131ParamsMask::PRIORITY));
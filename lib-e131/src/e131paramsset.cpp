@@ -63,6 +63,10 @@ void E131Params::Set(E131Bridge *pE131Bridge) {
 		pE131Bridge->SetDirectUpdate(true);
 	}
 
+	if (isMaskSet(E131ParamsMask::OUTPUT_BARRIER)) {
+		pE131Bridge->SetOutputBarrier(true);
+	}
+
 	if (isMaskSet(E131ParamsMask::PRIORITY)) {
 		pE131Bridge->SetPriority(m_tE131Params.nPriority);
 	}
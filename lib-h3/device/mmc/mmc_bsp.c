@@ -59,6 +59,8 @@
 #include "h3.h"
 #include "h3_timer.h"
 
+#include "arm/synchronize.h"
+
 #include "debug.h"
 
 // CCU register
@@ -73,6 +75,7 @@
 #define GCTL_FIFO_RST			(1U << 1)	///< Reset FIFO
 #define GCTL_DMA_RST			(1U << 2)	///< DMA Reset
 	#define GCTL_RESET	(GCTL_SOFT_RST | GCTL_FIFO_RST | GCTL_DMA_RST)
+#define GCTL_DMA_ENB			(1U << 5)	///< DMA Global Enable
 #define GCTL_FIFO_AC_MODE_AHB	(1U << 31)	///< FIFO Access Mode AHB bus
 
 	#define CKC_CCLK_DIV_MASK		(0xFF << 0)
@@ -124,6 +127,57 @@
 //0xbbc2 0b1011101111000010
 #define RIS_RAW_ISTA	(RIS_DATA_ENDBIT_ERROR |RIS_DATA_START_ERROR | RIS_CMD_BUSY | RIS_FIFO_UNDERRUN | RIS_DATA_TIMEOUT | RIS_RESP_TIMEOUT | RIS_DATA_CRC_ERROR | RIS_RESP_CRC_ERROR | RIS_RESPONSE_ERROR)
 
+#define DMAC_IDMAC_SOFT_RST		(1U << 0)	///< Internal DMA Controller Soft Reset
+#define DMAC_IDMAC_FIX_BURST	(1U << 1)	///< Fixed Burst
+#define DMAC_IDMAC_ENABLE		(1U << 7)	///< Internal DMA Controller Enable
+
+#define IDST_TX_INT				(1U << 0)	///< Transmit Interrupt
+#define IDST_RX_INT				(1U << 1)	///< Receive Interrupt
+#define IDST_FATAL_BUS_ERR		(1U << 2)	///< Fatal Bus Error Interrupt
+#define IDST_DES_UNAVL			(1U << 4)	///< Descriptor Unavailable Interrupt
+#define IDST_ERR_FLAG_SUM		(1U << 5)	///< Card Error Summary
+#define IDST_ABN_INT_SUM		(1U << 9)	///< Abnormal Interrupt Summary
+	#define IDST_ERROR	(IDST_FATAL_BUS_ERR | IDST_DES_UNAVL | IDST_ERR_FLAG_SUM | IDST_ABN_INT_SUM)
+
+#define IDIE_TX_INT				(1U << 0)	///< Transmit Interrupt Enable
+#define IDIE_RX_INT				(1U << 1)	///< Receive Interrupt Enable
+
+#define FWL_BURST_8_RX_7_TX_8	0x20070008	///< DMA burst size 8, RX trigger level 7, TX trigger level 8
+
+/*
+ * IDMA descriptor, chain mode
+ */
+#define DES0_DIC				(1U << 1)	///< Disable Interrupt on Completion
+#define DES0_LAST				(1U << 2)	///< Last descriptor
+#define DES0_FIRST				(1U << 3)	///< First descriptor
+#define DES0_CHAIN				(1U << 4)	///< Chain mode
+#define DES0_END_OF_RING		(1U << 5)	///< End of ring
+#define DES0_CARD_ERR_SUM		(1U << 30)	///< Card error summary
+#define DES0_OWN				(1U << 31)	///< Owned by the IDMA
+
+struct sunxi_idma_desc {
+	uint32_t config;
+	uint32_t buf_size;
+	uint32_t buf_addr;
+	uint32_t next_desc;
+};
+
+/*
+ * The DMA buffer is in the non-cached coherent region, the data is copied from/to the caller's buffer.
+ * A transfer larger than the DMA buffer falls back to the CPU (PIO) transfer.
+ */
+#define MMC_DMA_COHERENT_REGION		(H3_MEM_COHERENT_REGION + MEGABYTE/2 + MEGABYTE/4 + MEGABYTE/8)
+#define MMC_DMA_DESC_BUFFER_SIZE	(8 * 1024)
+#define MMC_DMA_BUFFER_SIZE			(64 * 1024)
+#define MMC_DMA_DESC_COUNT			(MMC_DMA_BUFFER_SIZE / MMC_DMA_DESC_BUFFER_SIZE)
+
+struct coherent_region {
+	struct sunxi_idma_desc desc[MMC_DMA_DESC_COUNT];
+	uint8_t buffer[MMC_DMA_BUFFER_SIZE] __attribute__((aligned(64)));
+};
+
+static struct coherent_region *p_coherent_region = (struct coherent_region *)(MMC_DMA_COHERENT_REGION);
+
 static void dumphex32(__attribute__((unused)) const char *reg_name, __attribute__((unused)) char *base, __attribute__((unused)) uint32_t len) {
 #ifndef NDEBUG
 	uint32_t i;
@@ -284,7 +338,7 @@ static int mmc_core_init(void) {
 	return 0;
 }
 
-static int mmc_trans_data_by_cpu(__attribute__((unused)) struct mmc *mmc, struct mmc_data *data) {
+static int mmc_trans_data_by_cpu(struct mmc_data *data) {
 	uint32_t i;
 	uint32_t byte_cnt = data->blocksize * data->blocks;
 	uint32_t *buff;
@@ -325,26 +379,81 @@ static int mmc_trans_data_by_cpu(__attribute__((unused)) struct mmc *mmc, struct
 	return 0;
 }
 
-// Called by mmc.c
-static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *data) {
-	uint32_t cmdval = CMD_CMD_LOAD;
-	uint32_t timeout = 0;
-	uint32_t status = 0;
-	int32_t error = 0;
+static int mmc_use_dma(const struct mmc_data *data) {
+	return (data->blocksize * data->blocks) <= MMC_DMA_BUFFER_SIZE;
+}
 
-	if (_aw_mmc_host.fatal_err){
-		DEBUG_PUTS("Found fatal err,so no send cmd");
-		return -1;
+static void mmc_dma_prepare(struct mmc_data *data) {
+	struct sunxi_idma_desc *desc = p_coherent_region->desc;
+	uint32_t byte_cnt = data->blocksize * data->blocks;
+	uint32_t i;
+
+	if (data->flags & MMC_DATA_WRITE) {
+		memcpy(p_coherent_region->buffer, data->b.src, byte_cnt);
 	}
 
-	if (cmd->resp_type & MMC_RSP_BUSY) {
-		DEBUG_PRINTF("cmd %d check rsp busy", cmd->cmdidx);
+	for (i = 0; byte_cnt != 0; i++) {
+		const uint32_t size = byte_cnt > MMC_DMA_DESC_BUFFER_SIZE ? MMC_DMA_DESC_BUFFER_SIZE : byte_cnt;
+
+		desc[i].config = DES0_OWN | DES0_CHAIN | DES0_DIC;
+		desc[i].buf_size = size;
+		desc[i].buf_addr = (uint32_t) &p_coherent_region->buffer[i * MMC_DMA_DESC_BUFFER_SIZE];
+		desc[i].next_desc = (uint32_t) &desc[i + 1];
+
+		byte_cnt -= size;
 	}
 
-	if (cmd->cmdidx == 12) { // TODO What is this 12? MMC_CMD_STOP_TRANSMISSION ?
+	desc[0].config |= DES0_FIRST;
+	desc[i - 1].config |= DES0_LAST | DES0_END_OF_RING;
+	desc[i - 1].config &= ~DES0_DIC;
+	desc[i - 1].next_desc = 0;
+
+	dmb();
+
+	uint32_t value = H3_SD_MMC0->GCTL;
+	value &= ~GCTL_FIFO_AC_MODE_AHB;
+	value |= GCTL_DMA_ENB | GCTL_DMA_RST;
+	H3_SD_MMC0->GCTL = value;
+
+	H3_SD_MMC0->DMAC = DMAC_IDMAC_SOFT_RST;
+	H3_SD_MMC0->DMAC = DMAC_IDMAC_FIX_BURST | DMAC_IDMAC_ENABLE;
+
+	H3_SD_MMC0->IDST = 0xffffffff;
+	H3_SD_MMC0->IDIE = (data->flags & MMC_DATA_WRITE) ? IDIE_TX_INT : IDIE_RX_INT;
+	H3_SD_MMC0->DLBA = (uint32_t) desc;
+	H3_SD_MMC0->FWL = FWL_BURST_8_RX_7_TX_8;
+}
+
+static void mmc_dma_disable(void) {
+	H3_SD_MMC0->DMAC = 0;
+	H3_SD_MMC0->IDIE = 0;
+	H3_SD_MMC0->GCTL &= ~GCTL_DMA_ENB;
+}
+
+/*
+ * Returns 0 when the data is in memory, 1 when the IDMA is still busy, < 0 on error
+ */
+static int mmc_dma_status(void) {
+	const uint32_t status = H3_SD_MMC0->IDST;
+
+	if (status & IDST_ERROR) {
+		return -1;
+	}
+
+	if (status & (IDST_RX_INT | IDST_TX_INT)) {
 		return 0;
 	}
 
+	return 1;
+}
+
+static int mmc_send_cmd_start(struct mmc_cmd *cmd, struct mmc_data *data) {
+	uint32_t cmdval = CMD_CMD_LOAD;
+
+	if (cmd->resp_type & MMC_RSP_BUSY) {
+		DEBUG_PRINTF("cmd %d check rsp busy", cmd->cmdidx);
+	}
+
 	if (!cmd->cmdidx) {
 		cmdval |= CMD_SEND_INIT_SEQ;
 	}
@@ -364,8 +473,7 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 	if (data) {
 		if ((uint32_t) data->b.dest & 0x3) {
 			DEBUG_PUTS("dest is not 4 byte align");
-			error = -1;
-			goto out;
+			return -1;
 		}
 
 		cmdval |= CMD_DATA_TRANS | CMD_WAIT_PRE_OVER;
@@ -380,7 +488,6 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 
 		H3_SD_MMC0->BKS = data->blocksize;
 		H3_SD_MMC0->BYC = data->blocks * data->blocksize;
-
 	}
 
 	DEBUG_PRINTF("cmd %d(0x%x), arg 0x%x", cmd->cmdidx, cmdval|cmd->cmdidx, cmd->cmdarg);
@@ -388,31 +495,41 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 
 	if (!data) {
 		H3_SD_MMC0->CMD = cmdval | (cmd->cmdidx & CMD_CMD_IDX_MASK);
+		return 0;
 	}
 
-	if (data) {
-		int ret = 0;
-		DEBUG_PRINTF("trans data %d bytes", data->blocksize * data->blocks);
+	DEBUG_PRINTF("trans data %d bytes", data->blocksize * data->blocks);
 
-		H3_SD_MMC0->GCTL |= GCTL_FIFO_AC_MODE_AHB;
+	if (mmc_use_dma(data)) {
+		mmc_dma_prepare(data);
 		H3_SD_MMC0->CMD = cmdval | (cmd->cmdidx & CMD_CMD_IDX_MASK);
+		return 0;
+	}
 
-		ret = mmc_trans_data_by_cpu(mmc, data);
+	mmc_dma_disable();
 
-		if (ret) {
-			DEBUG_PUTS("Transfer failed");
+	H3_SD_MMC0->GCTL |= GCTL_FIFO_AC_MODE_AHB;
+	H3_SD_MMC0->CMD = cmdval | (cmd->cmdidx & CMD_CMD_IDX_MASK);
 
-			error = H3_SD_MMC0->RIS & RIS_RAW_ISTA;
+	if (mmc_trans_data_by_cpu(data)) {
+		DEBUG_PUTS("Transfer failed");
 
-			if (!error) {
-				error = 0xffffffff;
-			}
+		const int32_t error = H3_SD_MMC0->RIS & RIS_RAW_ISTA;
 
-			goto out;
+		if (!error) {
+			return 0xffffffff;
 		}
+
+		return error;
 	}
 
-	timeout = 0xffffff;
+	return 0;
+}
+
+static int mmc_send_cmd_finish(struct mmc_cmd *cmd, struct mmc_data *data) {
+	uint32_t timeout = 0xffffff;
+	uint32_t status = 0;
+	int32_t error = 0;
 
 	do {
 		status = H3_SD_MMC0->RIS;
@@ -426,7 +543,7 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 
 			DEBUG_PRINTF("cmd %d timeout, err %x", cmd->cmdidx, error);
 
-			goto out;
+			return error;
 		}
 	} while (!(status & RIS_CMD_COMPLETE));
 
@@ -446,7 +563,7 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 
 				DEBUG_PRINTF("data timeout, err %x", error);
 
-				goto out;
+				return error;
 			}
 
 			if (data->blocks > 1) {
@@ -456,6 +573,26 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 			}
 
 		} while (!done);
+
+		if (mmc_use_dma(data)) {
+			int dma_status;
+			timeout = 0xffff;
+
+			while ((dma_status = mmc_dma_status()) == 1) {
+				if (!timeout--) {
+					break;
+				}
+			}
+
+			if (dma_status != 0) {
+				DEBUG_PRINTF("dma error, idst %x", H3_SD_MMC0->IDST);
+				return 0xffffffff;
+			}
+
+			if (data->flags & MMC_DATA_READ) {
+				memcpy(data->b.dest, p_coherent_region->buffer, data->blocksize * data->blocks);
+			}
+		}
 	}
 
 	if (cmd->resp_type & MMC_RSP_BUSY) {
@@ -464,9 +601,8 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 			status = H3_SD_MMC0->STA;
 
 			if (!timeout--) {
-				error = -1;
 				DEBUG_PUTS("busy timeout");
-				goto out;
+				return -1;
 			}
 		} while (status & RIS_DATA_TIMEOUT);
 	}
@@ -482,8 +618,10 @@ static int mmc_send_cmd(struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *d
 		DEBUG_PRINTF("resp 0x%x", cmd->response[0]);
 	}
 
-out:
+	return 0;
+}
 
+static int mmc_send_cmd_end(__attribute__((unused)) struct mmc_cmd *cmd, int32_t error) {
 	if (error) {
 		dumphex32("MMC0_BASE", (char *) H3_SD_MMC0_BASE, 0x100);
 
@@ -496,6 +634,7 @@ out:
 	}
 
 	H3_SD_MMC0->RIS = 0xffffffff;
+	H3_SD_MMC0->IDST = 0xffffffff;
 
 	if (error) {
 		return -1;
@@ -504,6 +643,26 @@ out:
 	return 0;
 }
 
+// Called by mmc.c
+static int mmc_send_cmd(__attribute__((unused)) struct mmc *mmc, struct mmc_cmd *cmd, struct mmc_data *data) {
+	if (_aw_mmc_host.fatal_err){
+		DEBUG_PUTS("Found fatal err,so no send cmd");
+		return -1;
+	}
+
+	if (cmd->cmdidx == 12) { // TODO What is this 12? MMC_CMD_STOP_TRANSMISSION ?
+		return 0;
+	}
+
+	int32_t error = mmc_send_cmd_start(cmd, data);
+
+	if (!error) {
+		error = mmc_send_cmd_finish(cmd, data);
+	}
+
+	return mmc_send_cmd_end(cmd, error);
+}
+
 int __attribute__((cold)) sunxi_mmc_init(void) {
 	DEBUG_ENTRY
 	DEBUG_PRINTF("mmc driver ver %s",__DATE__ " " __TIME__);
@@ -525,6 +684,7 @@ int __attribute__((cold)) sunxi_mmc_init(void) {
 	mmc_dev.f_min = 400000;
 	mmc_dev.f_max = 25000000;
 	mmc_dev.control_num = 0;
+	mmc_dev.b_max = MMC_DMA_BUFFER_SIZE / 512;
 
 	mmc_ccu_init();
 
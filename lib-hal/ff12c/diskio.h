@@ -34,6 +34,7 @@ DSTATUS disk_status (BYTE pdrv);
 DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
+DWORD disk_benchmark (BYTE pdrv, UINT count, DWORD sectors);
 
 
 /* Disk Status Bits (DSTATUS) */
@@ -0,0 +1,107 @@
+/**
+ * @file multicore.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MULTICORE_H_
+#define MULTICORE_H_
+
+#include <stdint.h>
+
+namespace multicore {
+static constexpr uint32_t MAX_CORES = 4;
+/**
+ * A task is called in a loop on its own core.
+ * It returns true when it has done work, which is counted as busy time.
+ */
+typedef bool (*Task)(void *pArg);
+}  // namespace multicore
+
+/**
+ * Core 0 runs the superloop (network, protocol, display, remote configuration).
+ * The secondary cores each run a single task, typically the consumer of an SpscRing.
+ * On Linux the secondary cores are pthreads, so the same code can be run on a host.
+ */
+class MultiCore {
+public:
+	MultiCore();
+	~MultiCore();
+
+	bool Start(uint32_t nCore, multicore::Task pTask, void *pArg = nullptr);
+	void Stop();
+
+	bool IsStarted(uint32_t nCore) const {
+		return (nCore < multicore::MAX_CORES) && (m_Cores[nCore].pTask != nullptr);
+	}
+
+	/**
+	 * Called once per iteration of the core 0 superloop.
+	 * The fastest iteration is the cost of an idle loop, the time above it is counted as busy.
+	 * An iteration within one microsecond of the idle loop is counted as idle.
+	 */
+	void Run();
+
+	/**
+	 * Busy time in percent since the previous call
+	 */
+	uint32_t GetLoad(uint32_t nCore);
+
+	uint32_t GetBusyMicros(uint32_t nCore) const {
+		return (nCore < multicore::MAX_CORES) ? m_Cores[nCore].nBusyMicros : 0;
+	}
+
+	uint32_t GetTotalMicros(uint32_t nCore) const {
+		return (nCore < multicore::MAX_CORES) ? m_Cores[nCore].nTotalMicros : 0;
+	}
+
+	void Print();
+
+	static MultiCore *Get() {
+		return s_pThis;
+	}
+
+	static void Worker(uint32_t nCore);
+
+private:
+	bool PlatformStart(uint32_t nCore);
+	void PlatformStop();
+
+private:
+	struct Core {
+		multicore::Task pTask;
+		void *pArg;
+		volatile uint32_t nBusyMicros;
+		volatile uint32_t nTotalMicros;
+		uint32_t nBusyMicrosPrevious;
+		uint32_t nTotalMicrosPrevious;
+	} __attribute__((aligned(64)));
+
+	Core m_Cores[multicore::MAX_CORES];
+	uint32_t m_nLoopMicros;
+	uint32_t m_nIdleLoopMicros { UINT32_MAX };
+	volatile bool m_bRunning { false };
+
+	static MultiCore *s_pThis;
+};
+
+#endif /* MULTICORE_H_ */
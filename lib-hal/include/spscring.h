@@ -0,0 +1,128 @@
+/**
+ * @file spscring.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <stdint.h>
+
+/**
+ * Lock-free single producer, single consumer ring.
+ * Push() is called from one core only, Pop() from one other core only.
+ * The head is written by the producer and the tail by the consumer, each on its own cache line.
+ * N must be a power of 2.
+ */
+template<typename T, uint32_t N>
+class SpscRing {
+	static_assert((N != 0) && ((N & (N - 1)) == 0), "N must be a power of 2");
+public:
+	bool Push(const T& item) {
+		const auto nHead = m_nHead;
+
+		if (__builtin_expect(((nHead - __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE)) == N), 0)) {
+			return false;
+		}
+
+		m_Items[nHead & (N - 1)] = item;
+		__atomic_store_n(&m_nHead, nHead + 1, __ATOMIC_RELEASE);
+
+		return true;
+	}
+
+	/**
+	 * Zero copy variant of Push(): Claim() returns the free entry or nullptr when the ring is full,
+	 * Publish() makes the claimed entry visible to the consumer.
+	 */
+	T *Claim() {
+		const auto nHead = m_nHead;
+
+		if (__builtin_expect(((nHead - __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE)) == N), 0)) {
+			return nullptr;
+		}
+
+		return &m_Items[nHead & (N - 1)];
+	}
+
+	void Publish() {
+		__atomic_store_n(&m_nHead, m_nHead + 1, __ATOMIC_RELEASE);
+	}
+
+	bool Pop(T& item) {
+		T *pItem = Front();
+
+		if (pItem == nullptr) {
+			return false;
+		}
+
+		item = *pItem;
+		Release();
+
+		return true;
+	}
+
+	/**
+	 * Zero copy variant of Pop(): Front() returns the oldest entry or nullptr when the ring is empty,
+	 * Release() hands the entry back to the producer.
+	 */
+	T *Front() {
+		const auto nTail = m_nTail;
+
+		if (nTail == __atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE)) {
+			return nullptr;
+		}
+
+		return &m_Items[nTail & (N - 1)];
+	}
+
+	void Release() {
+		__atomic_store_n(&m_nTail, m_nTail + 1, __ATOMIC_RELEASE);
+	}
+
+	uint32_t Size() const {
+		return __atomic_load_n(&m_nHead, __ATOMIC_ACQUIRE) - __atomic_load_n(&m_nTail, __ATOMIC_ACQUIRE);
+	}
+
+	bool IsEmpty() const {
+		return Size() == 0;
+	}
+
+	static constexpr uint32_t Capacity() {
+		return N;
+	}
+
+private:
+	static constexpr uint32_t CACHE_LINE_SIZE = 64;
+	/*
+	 * Padding instead of aligned(64) on the members: an over-aligned class cannot be
+	 * allocated with new in C++11 (-Waligned-new)
+	 */
+	uint32_t m_nHead { 0 };
+	uint8_t m_Padding0[CACHE_LINE_SIZE - sizeof(uint32_t)];
+	uint32_t m_nTail { 0 };
+	uint8_t m_Padding1[CACHE_LINE_SIZE - sizeof(uint32_t)];
+	T m_Items[N];
+};
+
+#endif /* SPSCRING_H_ */
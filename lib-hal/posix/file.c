@@ -24,9 +24,12 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
+#include <time.h>
+#include <sys/stat.h>
 #include <assert.h>
 
 #include "../ff12c/ff.h"
@@ -37,9 +40,25 @@
 int console_error(const char *);
 static int fatfs_to_errno(FRESULT fresult);
 
-static FIL file_object;
+/*
+ * Several files can be open at the same time: the show file zones (4),
+ * the single show file and one more for a config file or TFTP.
+ */
+#define FILE_MAX	6
+
+static FIL file_object[FILE_MAX];
+static uint8_t file_in_use[FILE_MAX];
 static FRESULT s_fresult = 0;
 
+/*
+ * Fast seek cluster link map, for the files opened read only.
+ * [0] is the size of the table, each fragment needs 2 entries, +1 for the terminator.
+ */
+#define CLMT_SIZE	64
+static DWORD s_clmt[FILE_MAX][CLMT_SIZE];
+
+#define TO_FIL(stream)	((FIL *)(stream))
+
 // http://elm-chan.org/fsw/ff/doc/open.html
 FILE *fopen(const char *path, const char *mode) {
 	errno = 0;
@@ -58,11 +77,37 @@ FILE *fopen(const char *path, const char *mode) {
 		return NULL;
 	}
 
-	s_fresult = f_open(&file_object, (TCHAR *)path, fa);
+	uint32_t i;
+
+	for (i = 0; i < FILE_MAX; i++) {
+		if (!file_in_use[i]) {
+			break;
+		}
+	}
+
+	if (i == FILE_MAX) {
+		errno = EMFILE;
+		return NULL;
+	}
+
+	FIL *fil = &file_object[i];
+
+	s_fresult = f_open(fil, (TCHAR *)path, fa);
 	errno = fatfs_to_errno(s_fresult);
 
 	if (s_fresult == FR_OK) {
-		return (FILE *)&file_object;
+		if (fa == (BYTE) FA_READ) {
+			s_clmt[i][0] = CLMT_SIZE;
+			fil->cltbl = s_clmt[i];
+
+			if (f_lseek(fil, CREATE_LINKMAP) != FR_OK) {
+				/* Too many fragments (FR_NOT_ENOUGH_CORE), walk the FAT chain */
+				fil->cltbl = NULL;
+			}
+		}
+
+		file_in_use[i] = 1;
+		return (FILE *)fil;
 	} else {
 		return NULL;
 	}
@@ -75,9 +120,11 @@ int fclose(FILE *stream) {
 		return 0;
 	}
 
-	s_fresult = f_close(&file_object);
+	s_fresult = f_close(TO_FIL(stream));
 	errno = fatfs_to_errno(s_fresult);
 
+	file_in_use[TO_FIL(stream) - file_object] = 0;
+
 	if (s_fresult == FR_OK) {
 		return 0;
 	}
@@ -94,7 +141,7 @@ int fgetc(FILE *stream) {
 		return EOF;
 	}
 
-	if ((s_fresult = f_read(&file_object, &c, (UINT) 1, &bytes_read)) == FR_OK) {
+	if ((s_fresult = f_read(TO_FIL(stream), &c, (UINT) 1, &bytes_read)) == FR_OK) {
 		if (bytes_read > 0) {
 			return c;
 		}
@@ -109,10 +156,10 @@ int fgetc(FILE *stream) {
 	return (EOF);
 }
 
-size_t fread(void *ptr, size_t size, size_t nmemb, __attribute__((unused)) FILE *stream) {
+size_t fread(void *ptr, size_t size, size_t nmemb, FILE *stream) {
 	UINT bytes_read;
 
-	s_fresult = f_read(&file_object, ptr, (UINT) (size * nmemb), &bytes_read);
+	s_fresult = f_read(TO_FIL(stream), ptr, (UINT) (size * nmemb), &bytes_read);
 	errno = fatfs_to_errno(s_fresult);
 
 	if (s_fresult == FR_OK) {
@@ -122,11 +169,11 @@ size_t fread(void *ptr, size_t size, size_t nmemb, __attribute__((unused)) FILE
 	return 0;
 }
 
-int fseek(__attribute__((unused)) FILE *stream, long offset, int whence) {
+int fseek(FILE *stream, long offset, int whence) {
 	if (whence == SEEK_SET) {
-		s_fresult = f_lseek(&file_object, (FSIZE_t) offset);
+		s_fresult = f_lseek(TO_FIL(stream), (FSIZE_t) offset);
 	} else if (whence == SEEK_END) {
-		s_fresult = f_lseek(&file_object, (FSIZE_t) f_size(&file_object));
+		s_fresult = f_lseek(TO_FIL(stream), (FSIZE_t) f_size(TO_FIL(stream)));
 	}
 
 	errno = fatfs_to_errno(s_fresult);
@@ -138,8 +185,8 @@ int fseek(__attribute__((unused)) FILE *stream, long offset, int whence) {
 	return -1;
 }
 
-long ftell(__attribute__((unused)) FILE *stream) {
-	return (long) f_tell(&file_object);
+long ftell(FILE *stream) {
+	return (long) f_tell(TO_FIL(stream));
 }
 
 char *fgets(char *s, int size, FILE *stream) {
@@ -151,9 +198,9 @@ char *fgets(char *s, int size, FILE *stream) {
 		return NULL;
 	}
 
-	if (f_gets((TCHAR *) s, size, &file_object) != (TCHAR *)s) {
+	if (f_gets((TCHAR *) s, size, TO_FIL(stream)) != (TCHAR *)s) {
 		*s = '\0';
-		errno = fatfs_to_errno(f_error(&file_object));
+		errno = fatfs_to_errno(f_error(TO_FIL(stream)));
 		return NULL;
 	}
 
@@ -231,7 +278,7 @@ int fputs(__attribute__((unused)) const char *s, __attribute__((unused)) FILE *s
 		return 0;
 	}
 
-	return f_puts((const TCHAR *) s, &file_object);
+	return f_puts((const TCHAR *) s, TO_FIL(stream));
 #endif
 }
 
@@ -242,7 +289,7 @@ size_t fwrite(__attribute__((unused)) const void *ptr, __attribute__((unused)) s
 #else
 	UINT bytes_write;
 
-	s_fresult = f_write(&file_object, ptr, (UINT) (size * nmemb), &bytes_write);
+	s_fresult = f_write(TO_FIL(stream), ptr, (UINT) (size * nmemb), &bytes_write);
 	errno = fatfs_to_errno(s_fresult);
 
 	if (s_fresult == FR_OK) {
@@ -269,6 +316,39 @@ int unlink(__attribute__((unused)) const char *pathname) {
 #endif
 }
 
+/**
+ * Only st_size and st_mtime are filled in, the FAT time has a 2 seconds resolution.
+ */
+int stat(__attribute__((unused)) const char *pathname, __attribute__((unused)) struct stat *statbuf) {
+#if !defined (SD_WRITE_SUPPORT)
+	errno = ENOSYS;
+	return -1;
+#else
+	FILINFO fno;
+
+	s_fresult = f_stat(pathname, &fno);
+	errno = fatfs_to_errno(s_fresult);
+
+	if (s_fresult != FR_OK) {
+		return -1;
+	}
+
+	struct tm tm;
+
+	tm.tm_year = 80 + (fno.fdate >> 9);
+	tm.tm_mon = ((fno.fdate >> 5) & 0xF) - 1;
+	tm.tm_mday = fno.fdate & 0x1F;
+	tm.tm_hour = fno.ftime >> 11;
+	tm.tm_min = (fno.ftime >> 5) & 0x3F;
+	tm.tm_sec = (fno.ftime & 0x1F) * 2;
+
+	statbuf->st_size = (off_t) fno.fsize;
+	statbuf->st_mtime = mktime(&tm);
+
+	return 0;
+#endif
+}
+
 #if !defined (SD_WRITE_SUPPORT)
 #else
 static DIR s_dir;
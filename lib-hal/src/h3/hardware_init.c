@@ -43,6 +43,7 @@
 
 #include "console.h"
 #include "../ff12c/ff.h"
+#include "../ff12c/diskio.h"
 
 #define WIFI_EN_PIO		7	// PL7
 #define POWER_LED_PIO	10	// PL10
@@ -58,6 +59,20 @@
  static bool s_is_pwr_button_pressed = false;
 #endif
 
+/*
+ * Present when the file sdcard.bench is on the card.
+ * Reads the first 10MB with 1, 8 and 128 sectors per disk_read().
+ */
+static void sdcard_benchmark(void) {
+	static const UINT counts[] = { 1, 8, 128 };
+	unsigned i;
+
+	for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+		const DWORD kbps = disk_benchmark(0, counts[i], 20480);
+		printf("SD card read %3u sectors : %u.%02u MB/s\n", counts[i], (unsigned) (kbps / 1024U), (unsigned) (((kbps % 1024U) * 100U) / 1024U));
+	}
+}
+
 static uint32_t s_hardware_init_startup_seconds = 0;
 
 extern void sys_time_init(void);
@@ -159,6 +174,11 @@ void __attribute__((cold)) hardware_init(void) {
 		snprintf(buffer, sizeof(buffer) - 1, "f_mount failed! %d\n", (int) result);
 		console_error(buffer);
 		assert(0);
+	} else {
+		FILINFO fno;
+		if (f_stat("sdcard.bench", &fno) == FR_OK) {
+			sdcard_benchmark();
+		}
 	}
 
 #define PRCM_APB0_GATE_PIO (0x1 << 0)
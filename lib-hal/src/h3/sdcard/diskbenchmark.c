@@ -0,0 +1,63 @@
+/**
+ * @file diskbenchmark.c
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "../ff12c/diskio.h"
+
+#include "h3_hs_timer.h"
+
+#define SECTOR_SIZE			512
+#define MAX_SECTORS_READ	128		///< A single IDMA transfer
+
+static uint8_t buffer[SECTOR_SIZE * MAX_SECTORS_READ] __attribute__((aligned(SECTOR_SIZE)));
+
+/*
+ * Raw read throughput of the card in KB/s, 0 on error.
+ * Reads sectors from the start of the card with count sectors per disk_read(),
+ * so it measures the driver and the card, not FatFs.
+ */
+DWORD disk_benchmark(BYTE drv, UINT count, DWORD sectors) {
+	if (drv || !count || (count > MAX_SECTORS_READ)) {
+		return 0;
+	}
+
+	const uint32_t micros_start = h3_hs_timer_lo_us();
+	DWORD sector;
+
+	for (sector = 0; sector < sectors; sector += count) {
+		if (disk_read(drv, buffer, sector, count) != RES_OK) {
+			return 0;
+		}
+	}
+
+	const uint32_t micros = h3_hs_timer_lo_us() - micros_start;
+
+	if (micros == 0) {
+		return 0;
+	}
+
+	return (DWORD) (((uint64_t) sector * SECTOR_SIZE * 1000000U) / ((uint64_t) micros * 1024U));
+}
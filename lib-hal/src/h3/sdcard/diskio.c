@@ -94,8 +94,17 @@ static inline int sdcard_read(uint8_t* buf, int sector, int count) {
 
 	} else {
 #endif
-		if (mmc_read_blocks(mmc, (void *)buf, (unsigned long)sector, (unsigned)count) != count) {
-			return RES_ERROR;
+		// Multi-block reads, at most b_max blocks per DMA transfer
+		while (count > 0) {
+			const int blocks = (count > (int) mmc->b_max) ? (int) mmc->b_max : count;
+
+			if (mmc_read_blocks(mmc, (void *)buf, (unsigned long)sector, (unsigned)blocks) != blocks) {
+				return RES_ERROR;
+			}
+
+			buf += blocks * SECTOR_SIZE;
+			sector += blocks;
+			count -= blocks;
 		}
 #ifdef CACHE_ENABLED
 	}
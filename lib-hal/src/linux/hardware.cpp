@@ -429,19 +429,17 @@ bool Hardware::ExecCmd(const char *pCmd, char *Result, int nResultSize) {
 	return true;
 }
 
+/*
+ * The monotonic clock is not affected by NTP or by setting the date/time.
+ */
 uint32_t Hardware::Micros() {
-	struct timeval tv;
-	gettimeofday(&tv, NULL);
-	return static_cast<uint32_t>((tv.tv_sec * 1000000) + tv.tv_usec);
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint32_t>((static_cast<uint64_t>(ts.tv_sec) * 1000000U) + (static_cast<uint64_t>(ts.tv_nsec) / 1000U));
 }
 
 uint32_t Hardware::Millis() {
-	struct timeval tv;
-	gettimeofday(&tv, NULL);
-
-#if defined (__APPLE__)
-	return (tv.tv_sec * static_cast<__darwin_time_t>(1000) + (tv.tv_usec / static_cast<__darwin_time_t>(1000)));
-#else
-	return static_cast<uint32_t>(tv.tv_sec * static_cast<__time_t >(1000) + (tv.tv_usec / static_cast<__suseconds_t >(1000)));
-#endif
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint32_t>((static_cast<uint64_t>(ts.tv_sec) * 1000U) + (static_cast<uint64_t>(ts.tv_nsec) / 1000000U));
 }
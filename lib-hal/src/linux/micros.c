@@ -28,7 +28,7 @@
 #include <sys/time.h>
 
 uint32_t micros(void) {
-	struct timeval tv;
-	gettimeofday(&tv, NULL);
-	return (uint32_t)((tv.tv_sec * 1000000) + tv.tv_usec);
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U));
 }
@@ -0,0 +1,64 @@
+/**
+ * @file multicore.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "multicore.h"
+
+#include "debug.h"
+
+namespace multicore {
+static pthread_t s_Threads[MAX_CORES];
+static bool s_bIsCreated[MAX_CORES];
+}  // namespace multicore
+
+static void *core_start(void *pArg) {
+	MultiCore::Worker(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pArg)));
+	return nullptr;
+}
+
+bool MultiCore::PlatformStart(uint32_t nCore) {
+	const auto nResult = pthread_create(&multicore::s_Threads[nCore], nullptr, core_start, reinterpret_cast<void *>(static_cast<uintptr_t>(nCore)));
+
+	if (nResult != 0) {
+		fprintf(stderr, "pthread_create failed: %d\n", nResult);
+		return false;
+	}
+
+	multicore::s_bIsCreated[nCore] = true;
+	return true;
+}
+
+void MultiCore::PlatformStop() {
+	for (uint32_t nCore = 1; nCore < multicore::MAX_CORES; nCore++) {
+		if (multicore::s_bIsCreated[nCore]) {
+			pthread_join(multicore::s_Threads[nCore], nullptr);
+			multicore::s_bIsCreated[nCore] = false;
+			m_Cores[nCore].pTask = nullptr;
+		}
+	}
+}
@@ -0,0 +1,176 @@
+/**
+ * @file multicore.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <cassert>
+
+#include "multicore.h"
+#include "hardware.h"
+
+#include "debug.h"
+
+MultiCore *MultiCore::s_pThis = nullptr;
+
+MultiCore::MultiCore() {
+	DEBUG_ENTRY
+
+	assert(s_pThis == nullptr);
+	s_pThis = this;
+
+	for (uint32_t nCore = 0; nCore < multicore::MAX_CORES; nCore++) {
+		auto& core = m_Cores[nCore];
+		core.pTask = nullptr;
+		core.pArg = nullptr;
+		core.nBusyMicros = 0;
+		core.nTotalMicros = 0;
+		core.nBusyMicrosPrevious = 0;
+		core.nTotalMicrosPrevious = 0;
+	}
+
+	m_nLoopMicros = Hardware::Get()->Micros();
+
+	DEBUG_EXIT
+}
+
+MultiCore::~MultiCore() {
+	DEBUG_ENTRY
+
+	Stop();
+	s_pThis = nullptr;
+
+	DEBUG_EXIT
+}
+
+bool MultiCore::Start(uint32_t nCore, multicore::Task pTask, void *pArg) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nCore=%u", nCore);
+
+	assert(pTask != nullptr);
+
+	if ((nCore == 0) || (nCore >= multicore::MAX_CORES) || (m_Cores[nCore].pTask != nullptr)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_Cores[nCore].pTask = pTask;
+	m_Cores[nCore].pArg = pArg;
+
+	__atomic_store_n(&m_bRunning, true, __ATOMIC_RELEASE);
+
+	if (!PlatformStart(nCore)) {
+		m_Cores[nCore].pTask = nullptr;
+		DEBUG_EXIT
+		return false;
+	}
+
+	DEBUG_EXIT
+	return true;
+}
+
+void MultiCore::Stop() {
+	DEBUG_ENTRY
+
+	__atomic_store_n(&m_bRunning, false, __ATOMIC_RELEASE);
+	PlatformStop();
+
+	DEBUG_EXIT
+}
+
+void MultiCore::Worker(uint32_t nCore) {
+	assert(s_pThis != nullptr);
+	assert(nCore < multicore::MAX_CORES);
+
+	auto& core = s_pThis->m_Cores[nCore];
+	auto *pHardware = Hardware::Get();
+	auto nMicrosPrevious = pHardware->Micros();
+
+	while (__atomic_load_n(&s_pThis->m_bRunning, __ATOMIC_ACQUIRE)) {
+		const auto bIsBusy = core.pTask(core.pArg);
+		const auto nMicros = pHardware->Micros();
+		const auto nElapsed = nMicros - nMicrosPrevious;
+
+		nMicrosPrevious = nMicros;
+
+		// Only this core writes its counters
+		if (bIsBusy) {
+			core.nBusyMicros = core.nBusyMicros + nElapsed;
+		}
+
+		core.nTotalMicros = core.nTotalMicros + nElapsed;
+	}
+}
+
+void MultiCore::Run() {
+	auto& core = m_Cores[0];
+	const auto nMicros = Hardware::Get()->Micros();
+	const auto nElapsed = nMicros - m_nLoopMicros;
+
+	m_nLoopMicros = nMicros;
+
+	if (nElapsed < m_nIdleLoopMicros) {
+		m_nIdleLoopMicros = nElapsed;
+	}
+
+	// Within one tick of the idle loop is the resolution of Micros()
+	if (nElapsed > (m_nIdleLoopMicros + 1)) {
+		core.nBusyMicros = core.nBusyMicros + (nElapsed - m_nIdleLoopMicros);
+	}
+
+	core.nTotalMicros = core.nTotalMicros + nElapsed;
+}
+
+uint32_t MultiCore::GetLoad(uint32_t nCore) {
+	if (nCore >= multicore::MAX_CORES) {
+		return 0;
+	}
+
+	auto& core = m_Cores[nCore];
+
+	const auto nBusyMicros = core.nBusyMicros;
+	const auto nTotalMicros = core.nTotalMicros;
+
+	const auto nBusy = nBusyMicros - core.nBusyMicrosPrevious;
+	const auto nTotal = nTotalMicros - core.nTotalMicrosPrevious;
+
+	core.nBusyMicrosPrevious = nBusyMicros;
+	core.nTotalMicrosPrevious = nTotalMicros;
+
+	if (nTotal == 0) {
+		return 0;
+	}
+
+	return static_cast<uint32_t>((static_cast<uint64_t>(nBusy) * 100U) / nTotal);
+}
+
+void MultiCore::Print() {
+	printf("MultiCore\n");
+
+	for (uint32_t nCore = 0; nCore < multicore::MAX_CORES; nCore++) {
+		if ((nCore == 0) || IsStarted(nCore)) {
+			printf(" Core %u : %u%%\n", nCore, GetLoad(nCore));
+		}
+	}
+}
@@ -0,0 +1,516 @@
+/**
+ * @file chainsimulation.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Runs AutoDriver against a simulated L6470 daisy chain.
+ * Each simulated L6470 decodes the byte stream it receives, as in the datasheet.
+ * The commands seen by each board must be the same with and without the command
+ * queue. The SPI transfers and the bus time per DMX update are reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "bcm2835.h"
+
+#include "autodriver.h"
+#include "l6470constants.h"
+
+namespace bus {
+static constexpr uint32_t SPEED_HZ = 4000000;
+static constexpr uint32_t CS_OVERHEAD_NANOS = 1000;	///< Chip select setup and hold per transfer
+}  // namespace bus
+
+namespace model {
+static constexpr uint64_t MOVE_NANOS = 2000000;		///< BUSY low after a motion command
+static constexpr uint64_t STOP_NANOS = 500000;		///< BUSY low after a soft stop
+}  // namespace model
+
+static uint64_t s_nNanos;
+
+struct Command {
+	uint8_t nOpcode;
+	uint32_t nValue;
+
+	bool operator==(const Command& other) const {
+		return (nOpcode == other.nOpcode) && (nValue == other.nValue);
+	}
+};
+
+/**
+ * The register length in bytes, 0 for an unknown register
+ */
+static uint32_t register_bytes(uint32_t nParam) {
+	switch (nParam) {
+	case L6470_PARAM_ABS_POS:
+	case L6470_PARAM_MARK:
+	case L6470_PARAM_SPEED:
+		return 3;
+	case L6470_PARAM_EL_POS:
+	case L6470_PARAM_ACC:
+	case L6470_PARAM_DECEL:
+	case L6470_PARAM_MAX_SPEED:
+	case L6470_PARAM_MIN_SPEED:
+	case L6470_PARAM_FS_SPD:
+	case L6470_PARAM_INT_SPD:
+	case L6470_PARAM_CONFIG:
+	case L6470_PARAM_STATUS:
+		return 2;
+	case L6470_PARAM_KVAL_HOLD:
+	case L6470_PARAM_KVAL_RUN:
+	case L6470_PARAM_KVAL_ACC:
+	case L6470_PARAM_KVAL_DEC:
+	case L6470_PARAM_ST_SLP:
+	case L6470_PARAM_FN_SLP_ACC:
+	case L6470_PARAM_FN_SLP_DEC:
+	case L6470_PARAM_K_THERM:
+	case L6470_PARAM_ADC_OUT:
+	case L6470_PARAM_OCD_TH:
+	case L6470_PARAM_STALL_TH:
+	case L6470_PARAM_STEP_MODE:
+	case L6470_PARAM_ALARM_EN:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * The number of argument bytes of a command, -1 when the command is not valid
+ */
+static int argument_bytes(uint8_t nOpcode) {
+	if (nOpcode == L6470_CMD_NOP) {
+		return 0;
+	}
+
+	if (nOpcode < L6470_CMD_GET_PARAM) {
+		const auto nBytes = register_bytes(nOpcode);
+		return ((nBytes == 0) || (nOpcode == L6470_PARAM_STATUS)) ? -1 : static_cast<int>(nBytes);
+	}
+
+	if (nOpcode < L6470_CMD_MOVE) {
+		return 0;	// GET_PARAM, the register is sent back
+	}
+
+	switch (nOpcode & 0xFE) {
+	case L6470_CMD_MOVE:
+	case L6470_CMD_RUN:
+	case L6470_CMD_GOTO_DIR:
+		return 3;
+	case L6470_CMD_STEP_CLOCK:
+		return 0;
+	default:
+		break;
+	}
+
+	switch (nOpcode & 0xF6) {
+	case L6470_CMD_GO_UNTIL:
+		return 3;
+	case L6470_CMD_RELEASE_SW:
+		return 0;
+	default:
+		break;
+	}
+
+	switch (nOpcode) {
+	case L6470_CMD_GOTO:
+		return 3;
+	case L6470_CMD_GO_HOME:
+	case L6470_CMD_GO_MARK:
+	case L6470_CMD_RESET_POS:
+	case L6470_CMD_RESET_DEVICE:
+	case L6470_CMD_SOFT_STOP:
+	case L6470_CMD_HARD_STOP:
+	case L6470_CMD_SOFT_HIZ:
+	case L6470_CMD_HARD_HIZ:
+	case L6470_CMD_GET_STATUS:
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+class SimulatedL6470 {
+public:
+	SimulatedL6470() {
+		Reset();
+	}
+
+	void Reset() {
+		memset(m_aRegister, 0, sizeof(m_aRegister));
+		m_aRegister[L6470_PARAM_CONFIG] = 0x2E88;
+		m_nArguments = 0;
+		m_nOutput = 0;
+		m_nBusyUntilNanos = 0;
+		m_Log.clear();
+		m_nErrors = 0;
+	}
+
+	uint8_t Transfer(uint8_t nByte) {
+		if (m_nOutput != 0) {
+			// A response is shifted out, the input must be NOP
+			if (nByte != L6470_CMD_NOP) {
+				m_nErrors++;
+			}
+			m_nOutput--;
+			return static_cast<uint8_t>(m_nOutputValue >> (8 * m_nOutput));
+		}
+
+		if (m_nArguments != 0) {
+			m_nValue = (m_nValue << 8) | nByte;
+
+			if (--m_nArguments == 0) {
+				Execute();
+			}
+
+			return 0;
+		}
+
+		if (nByte == L6470_CMD_NOP) {
+			return 0;
+		}
+
+		const auto nArguments = argument_bytes(nByte);
+
+		if (nArguments < 0) {
+			m_nErrors++;
+			return 0;
+		}
+
+		m_nOpcode = nByte;
+		m_nValue = 0;
+		m_nArguments = static_cast<uint32_t>(nArguments);
+
+		if (m_nArguments == 0) {
+			Execute();
+		}
+
+		return 0;
+	}
+
+	bool IsBusy() const {
+		return s_nNanos < m_nBusyUntilNanos;
+	}
+
+	const std::vector<Command>& GetLog() const {
+		return m_Log;
+	}
+
+	uint32_t GetRegister(uint32_t nParam) const {
+		return m_aRegister[nParam];
+	}
+
+	uint32_t GetErrors() const {
+		return m_nErrors;
+	}
+
+private:
+	uint32_t Status() const {
+		return IsBusy() ? 0 : L6470_STATUS_BUSY;
+	}
+
+	void Execute() {
+		if ((m_nOpcode >= L6470_CMD_GET_PARAM) && (m_nOpcode < L6470_CMD_MOVE)) {
+			const auto nParam = m_nOpcode & 0x1F;
+			m_nOutput = register_bytes(nParam);
+
+			if (m_nOutput == 0) {
+				m_nErrors++;
+				return;
+			}
+
+			m_nOutputValue = (nParam == L6470_PARAM_STATUS) ? Status() : m_aRegister[nParam];
+			return;
+		}
+
+		if (m_nOpcode == L6470_CMD_GET_STATUS) {
+			m_nOutput = 2;
+			m_nOutputValue = Status();
+			return;
+		}
+
+		m_Log.push_back(Command { m_nOpcode, m_nValue });
+
+		if (m_nOpcode < L6470_CMD_GET_PARAM) {
+			m_aRegister[m_nOpcode] = m_nValue;
+			return;
+		}
+
+		switch (m_nOpcode) {
+		case L6470_CMD_GOTO:
+			m_aRegister[L6470_PARAM_ABS_POS] = m_nValue;
+			m_nBusyUntilNanos = s_nNanos + model::MOVE_NANOS;
+			break;
+		case L6470_CMD_SOFT_STOP:
+			if (IsBusy()) {
+				m_nBusyUntilNanos = s_nNanos + model::STOP_NANOS;
+			}
+			break;
+		case L6470_CMD_HARD_STOP:
+		case L6470_CMD_SOFT_HIZ:
+		case L6470_CMD_HARD_HIZ:
+			m_nBusyUntilNanos = 0;
+			break;
+		default:
+			if ((m_nOpcode & 0xF0) == L6470_CMD_MOVE || (m_nOpcode & 0xF8) == L6470_CMD_RUN || (m_nOpcode & 0xF8) == L6470_CMD_GOTO_DIR) {
+				m_nBusyUntilNanos = s_nNanos + model::MOVE_NANOS;
+			}
+			break;
+		}
+	}
+
+private:
+	uint32_t m_aRegister[32];
+	uint8_t m_nOpcode { 0 };
+	uint32_t m_nValue { 0 };
+	uint32_t m_nArguments { 0 };
+	uint32_t m_nOutput { 0 };
+	uint32_t m_nOutputValue { 0 };
+	uint64_t m_nBusyUntilNanos { 0 };
+	std::vector<Command> m_Log;
+	uint32_t m_nErrors { 0 };
+};
+
+/*
+ * The simulated SPI bus, chip select 0 and 1 each have a chain
+ */
+
+static SimulatedL6470 s_Chain[autodriver::MAX_CHIP_SELECTS][autodriver::MAX_BOARDS];
+static uint8_t s_nChipSelect;
+static uint32_t s_nTransfers;
+
+void bcm2835_spi_chipSelect(uint8_t nChipSelect) {
+	s_nChipSelect = nChipSelect;
+}
+
+void bcm2835_spi_set_speed_hz(__attribute__((unused)) uint32_t nSpeedHz) {
+}
+
+void bcm2835_spi_setDataMode(__attribute__((unused)) uint8_t nMode) {
+}
+
+/**
+ * Byte i of the packet is clocked into board i of the chain, its response replaces the byte.
+ */
+void bcm2835_spi_transfern(char *pBuffer, uint32_t nLength) {
+	if (nLength > autodriver::MAX_BOARDS) {
+		fprintf(stderr, "Transfer of %u bytes for a chain of at most %u boards\n", nLength, autodriver::MAX_BOARDS);
+		exit(EXIT_FAILURE);
+	}
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		pBuffer[i] = static_cast<char>(s_Chain[s_nChipSelect][i].Transfer(static_cast<uint8_t>(pBuffer[i])));
+	}
+
+	s_nTransfers++;
+	s_nNanos += bus::CS_OVERHEAD_NANOS + (nLength * 8ULL * 1000000000ULL) / bus::SPEED_HZ;
+}
+
+void bcm2835_spi_writenb(__attribute__((unused)) const char *pBuffer, __attribute__((unused)) uint32_t nLength) {
+}
+
+void bcm2835_spi_write(__attribute__((unused)) uint16_t nData) {
+}
+
+uint8_t bcm2835_gpio_lev(__attribute__((unused)) uint8_t nPin) {
+	return HIGH;
+}
+
+void bcm2835_delayMicroseconds(uint64_t nMicros) {
+	s_nNanos += nMicros * 1000;
+}
+
+/*
+ * Test
+ */
+
+static void reset_chains() {
+	for (auto& chain : s_Chain) {
+		for (auto& board : chain) {
+			board.Reset();
+		}
+	}
+
+	s_nTransfers = 0;
+	s_nNanos = 0;
+}
+
+static uint32_t chain_errors(uint32_t nBoards) {
+	uint32_t nErrors = 0;
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		nErrors += s_Chain[0][i].GetErrors();
+	}
+
+	return nErrors;
+}
+
+struct Run {
+	uint32_t nTransfers;
+	uint64_t nBusNanos;
+	std::vector<Command> Log[autodriver::MAX_BOARDS];
+	uint32_t nErrors;
+};
+
+/**
+ * The motor update of a DMX frame as done by SparkFunDmx::SetData:
+ * a soft stop when busy, the new maximum speed and position. Then the busy poll of Run().
+ */
+static void dmx_frames(AutoDriver **pBoards, uint32_t nBoards, bool bQueued, uint32_t nFrames, Run& run) {
+	reset_chains();
+
+	for (uint32_t nFrame = 0; nFrame < nFrames; nFrame++) {
+		for (uint32_t i = 0; i < nBoards; i++) {
+			pBoards[i]->SetQueued(bQueued);
+
+			if ((nFrame % 4) == 0) {
+				pBoards[i]->softStop();
+			}
+
+			pBoards[i]->setMaxSpeed(static_cast<float>(100 + ((nFrame * 7 + i * 13) % 400)));
+			pBoards[i]->goTo(static_cast<long>((nFrame * 1000 + i * 10) & 0x3FFFFF));
+		}
+
+		if (bQueued) {
+			AutoDriver::FlushQueue();
+		}
+
+		for (uint32_t i = 0; i < nBoards; i++) {
+			pBoards[i]->busyCheck();
+		}
+
+		s_nNanos += 1000000000ULL / 44;	// DMX frame rate
+	}
+
+	run.nTransfers = s_nTransfers;
+	run.nBusNanos = s_nNanos - nFrames * (1000000000ULL / 44);
+	run.nErrors = chain_errors(nBoards);
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		run.Log[i] = s_Chain[0][i].GetLog();
+		pBoards[i]->SetQueued(false);
+	}
+}
+
+/**
+ * A queue overflow splits a command, the next immediate transfer on the chain must not cut into it.
+ */
+static bool overflow_and_read(AutoDriver **pBoards, uint32_t nBoards) {
+	reset_chains();
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		pBoards[i]->SetQueued(true);
+	}
+
+	// 17 command bytes for board 0, the queue has 16
+	pBoards[0]->setCurrent(10, 20, 30, 40);
+	pBoards[0]->setParam(L6470_PARAM_ACC, 0x123);
+	pBoards[0]->setParam(L6470_PARAM_DECEL, 0x234);
+	pBoards[0]->goTo(0x12345);
+
+	// Immediate reads of the other boards with an empty queue, board 0 is mid-command
+	for (uint32_t i = 1; i < nBoards; i++) {
+		pBoards[i]->busyCheck();
+	}
+
+	// Read after a queued write
+	for (uint32_t i = 1; i < nBoards; i++) {
+		pBoards[i]->setParam(L6470_PARAM_MAX_SPEED, 0x20 + i);
+		if (pBoards[i]->getParam(L6470_PARAM_MAX_SPEED) != static_cast<long>(0x20 + i)) {
+			printf("  board %u: read after queued write failed\n", i);
+			return false;
+		}
+	}
+
+	AutoDriver::FlushQueue();
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		pBoards[i]->SetQueued(false);
+	}
+
+	const auto& board = s_Chain[0][0];
+
+	const auto bPass = (chain_errors(nBoards) == 0)
+			&& (board.GetRegister(L6470_PARAM_KVAL_HOLD) == 10)
+			&& (board.GetRegister(L6470_PARAM_KVAL_DEC) == 40)
+			&& (board.GetRegister(L6470_PARAM_ACC) == 0x123)
+			&& (board.GetRegister(L6470_PARAM_DECEL) == 0x234)
+			&& (board.GetRegister(L6470_PARAM_ABS_POS) == 0x12345);
+
+	printf("Queue overflow with reads on the chain: %u commands on board 0, %u errors -> %s\n",
+			static_cast<uint32_t>(board.GetLog().size()), chain_errors(nBoards), bPass ? "PASS" : "FAIL");
+
+	return bPass;
+}
+
+int main() {
+	constexpr uint32_t nFrames = 100;
+	auto bPass = true;
+
+	puts("Boards  Transfers/frame        Bus time/frame (us)    Commands");
+	puts("        direct  queued         direct  queued");
+
+	for (uint32_t nBoards = 1; nBoards <= autodriver::MAX_BOARDS; nBoards *= 2) {
+		AutoDriver *pBoards[autodriver::MAX_BOARDS];
+
+		for (uint32_t i = 0; i < nBoards; i++) {
+			pBoards[i] = new AutoDriver(static_cast<uint8_t>(i), 0, 0xFF);
+		}
+
+		Run direct;
+		Run queued;
+
+		dmx_frames(pBoards, nBoards, false, nFrames, direct);
+		dmx_frames(pBoards, nBoards, true, nFrames, queued);
+
+		auto bSame = (direct.nErrors == 0) && (queued.nErrors == 0);
+
+		for (uint32_t i = 0; i < nBoards; i++) {
+			bSame &= (direct.Log[i] == queued.Log[i]) && !direct.Log[i].empty();
+		}
+
+		printf("%6u  %6.1f  %6.1f         %6.1f  %6.1f         %s\n", nBoards,
+				static_cast<double>(direct.nTransfers) / nFrames, static_cast<double>(queued.nTransfers) / nFrames,
+				static_cast<double>(direct.nBusNanos) / nFrames / 1000, static_cast<double>(queued.nBusNanos) / nFrames / 1000,
+				bSame ? "same -> PASS" : "differ -> FAIL");
+
+		bPass &= bSame;
+
+		if (nBoards == autodriver::MAX_BOARDS) {
+			bPass &= overflow_and_read(pBoards, nBoards);
+		}
+
+		for (uint32_t i = 0; i < nBoards; i++) {
+			delete pBoards[i];
+		}
+	}
+
+	puts(bPass ? "PASS" : "FAIL");
+
+	return bPass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -33,6 +33,12 @@
 
 #include "l6470.h"
 
+namespace autodriver {
+static constexpr uint32_t MAX_CHIP_SELECTS = 2;
+static constexpr uint32_t MAX_BOARDS = 8;		///< Per chip select
+static constexpr uint32_t QUEUE_SIZE = 16;		///< Command bytes per board
+}  // namespace autodriver
+
 class AutoDriver: public L6470 {
 public:
 	AutoDriver(uint8_t, uint8_t, uint8_t, uint8_t);
@@ -64,14 +70,28 @@ public:
 	static uint16_t getNumBoards();
 	static uint8_t getNumBoards(uint8_t cs);
 
+	/*
+	 * Command queue
+	 */
+	static void FlushQueue();
+	static void FlushQueue(uint8_t nSpiChipSelect);
+
+	static uint32_t GetChainTransfers() {
+		return s_nChainTransfers;
+	}
+
 private:
 	uint8_t m_nSpiChipSelect;
 	uint8_t m_nResetPin;
 	uint8_t m_nBusyPin;
 	uint8_t m_nPosition;
 	bool m_bIsBusy;
+	uint8_t m_aQueue[autodriver::QUEUE_SIZE];
+	uint32_t m_nQueueLength { 0 };
 
-	static uint8_t m_nNumBoards[2];
+	static uint8_t m_nNumBoards[autodriver::MAX_CHIP_SELECTS];
+	static AutoDriver *s_pChain[autodriver::MAX_CHIP_SELECTS][autodriver::MAX_BOARDS];
+	static uint32_t s_nChainTransfers;
 };
 
 #endif /* AUTODRIVER_H_ */
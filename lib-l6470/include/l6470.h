@@ -194,6 +194,18 @@ public:
 
 	void Dump();
 
+	/**
+	 * While queued, a driver may collect the command bytes and send them later.
+	 * Reads (getParam, getStatus) are always done immediately.
+	 */
+	void SetQueued(bool bQueued) {
+		m_bQueued = bQueued;
+	}
+
+	bool IsQueued() const {
+		return m_bQueued;
+	}
+
 private:
 	virtual uint8_t SPIXfer(uint8_t)=0;
 
@@ -219,6 +231,7 @@ private:
 
 protected:
 	unsigned m_nMotorNumber;	///< Just for administration purposes
+	bool m_bQueued { false };
 };
 
 #endif /* L6470_H_ */
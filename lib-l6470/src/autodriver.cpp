@@ -40,7 +40,9 @@
 
 #define BUSY_PIN_NOT_USED	0xFF
 
-uint8_t AutoDriver::m_nNumBoards[2];
+uint8_t AutoDriver::m_nNumBoards[autodriver::MAX_CHIP_SELECTS];
+AutoDriver *AutoDriver::s_pChain[autodriver::MAX_CHIP_SELECTS][autodriver::MAX_BOARDS];
+uint32_t AutoDriver::s_nChainTransfers;
 
 AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin, uint8_t nBusyPin) :
 	m_nSpiChipSelect(nSpiChipSelect),
@@ -53,7 +55,11 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 
 	DEBUG_PRINTF("nPosition=%d, nSpiChipSelect=%d\n", static_cast<int>(nPosition), static_cast<int>(nSpiChipSelect));
 
+	assert(nSpiChipSelect < autodriver::MAX_CHIP_SELECTS);
+	assert(nPosition < autodriver::MAX_BOARDS);
+
 	m_nNumBoards[nSpiChipSelect]++;
+	s_pChain[nSpiChipSelect][nPosition] = this;
 
 	DEBUG_PRINTF("m_nNumBoards[%d]=%d", static_cast<int>(nSpiChipSelect), static_cast<int>(m_nNumBoards[nSpiChipSelect]));
 	DEBUG_EXIT
@@ -70,16 +76,22 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 
 	DEBUG_PRINTF("nPosition=%d, nSpiChipSelect=%d\n", static_cast<int>(nPosition), static_cast<int>(nSpiChipSelect));
 
+	assert(nSpiChipSelect < autodriver::MAX_CHIP_SELECTS);
+	assert(nPosition < autodriver::MAX_BOARDS);
+
 	m_nNumBoards[nSpiChipSelect]++;
+	s_pChain[nSpiChipSelect][nPosition] = this;
 
 	DEBUG_PRINTF("m_nNumBoards[%d]=%d", static_cast<int>(nSpiChipSelect), static_cast<int>(m_nNumBoards[nSpiChipSelect]));
 	DEBUG_EXIT
 }
 
 AutoDriver::~AutoDriver() {
+	m_bQueued = false;
 	hardHiZ();
 	m_bIsBusy = false;
 	m_nNumBoards[m_nSpiChipSelect]--;
+	s_pChain[m_nSpiChipSelect][m_nPosition] = nullptr;
 }
 
 int AutoDriver::busyCheck() {
@@ -108,9 +120,30 @@ int AutoDriver::busyCheck() {
 	}
 }
 
+/**
+ * When queued, the byte is added to the command queue of this board.
+ * Otherwise the queues of the chain are flushed first, so the order of the bytes is kept.
+ */
 uint8_t AutoDriver::SPIXfer(uint8_t data) {
 	DEBUG_ENTRY
 
+	if (m_bQueued) {
+		if (m_nQueueLength == autodriver::QUEUE_SIZE) {
+			FlushQueue(m_nSpiChipSelect);
+		}
+
+		m_aQueue[m_nQueueLength++] = data;
+
+		DEBUG_EXIT
+		return 0;
+	}
+
+	/*
+	 * Any board of the chain may have queued bytes, possibly a command split by a full queue.
+	 * These are sent first, otherwise the NOP of this transfer ends up in the middle of that command.
+	 */
+	FlushQueue(m_nSpiChipSelect);
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wvla"
 
@@ -134,6 +167,66 @@ uint8_t AutoDriver::SPIXfer(uint8_t data) {
 	return dataPacket[m_nPosition];
 }
 
+/**
+ * Each SPI transfer clocks one byte into every board of the daisy chain.
+ * So the queued commands of all the boards are sent in parallel, one transfer per byte slot.
+ * A board with a shorter queue gets NOP (0x00) for the remaining slots.
+ */
+void AutoDriver::FlushQueue(uint8_t nSpiChipSelect) {
+	assert(nSpiChipSelect < autodriver::MAX_CHIP_SELECTS);
+
+	const auto nBoards = m_nNumBoards[nSpiChipSelect];
+	uint32_t nSlots = 0;
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		const auto *pAutoDriver = s_pChain[nSpiChipSelect][i];
+
+		if ((pAutoDriver != nullptr) && (pAutoDriver->m_nQueueLength > nSlots)) {
+			nSlots = pAutoDriver->m_nQueueLength;
+		}
+	}
+
+	if (nSlots == 0) {
+		return;
+	}
+
+	FUNC_PREFIX(spi_chipSelect(nSpiChipSelect));
+	FUNC_PREFIX(spi_set_speed_hz(4000000));
+	FUNC_PREFIX(spi_setDataMode(SPI_MODE3));
+
+	char dataPacket[autodriver::MAX_BOARDS];
+
+	for (uint32_t nSlot = 0; nSlot < nSlots; nSlot++) {
+		for (uint32_t i = 0; i < nBoards; i++) {
+			const auto *pAutoDriver = s_pChain[nSpiChipSelect][i];
+
+			if ((pAutoDriver != nullptr) && (nSlot < pAutoDriver->m_nQueueLength)) {
+				dataPacket[i] = static_cast<char>(pAutoDriver->m_aQueue[nSlot]);
+			} else {
+				dataPacket[i] = 0;
+			}
+		}
+
+		FUNC_PREFIX(spi_transfern(dataPacket, nBoards));
+	}
+
+	s_nChainTransfers += nSlots;
+
+	for (uint32_t i = 0; i < nBoards; i++) {
+		auto *pAutoDriver = s_pChain[nSpiChipSelect][i];
+
+		if (pAutoDriver != nullptr) {
+			pAutoDriver->m_nQueueLength = 0;
+		}
+	}
+}
+
+void AutoDriver::FlushQueue() {
+	for (uint32_t nSpiChipSelect = 0; nSpiChipSelect < autodriver::MAX_CHIP_SELECTS; nSpiChipSelect++) {
+		FlushQueue(static_cast<uint8_t>(nSpiChipSelect));
+	}
+}
+
 uint16_t AutoDriver::getNumBoards() {
 	uint16_t n = 0;
 
@@ -34,9 +34,14 @@ void L6470::setParam(TL6470ParamRegisters param, unsigned long value) {
 }
 
 long L6470::getParam(TL6470ParamRegisters param) {
+	const auto bQueued = m_bQueued;
+	m_bQueued = false;
+
 	SPIXfer(param | L6470_CMD_GET_PARAM);
+	const auto nValue = paramHandler(param, 0);
 
-	return paramHandler(param, 0);
+	m_bQueued = bQueued;
+	return nValue;
 }
 
 long L6470::getPos() {
@@ -180,10 +185,14 @@ void L6470::hardHiZ() {
 int L6470::getStatus() {
 	int temp = 0;
 
+	const auto bQueued = m_bQueued;
+	m_bQueued = false;
+
 	auto *bytePointer = reinterpret_cast<uint8_t*>(&temp);
 	SPIXfer(L6470_CMD_GET_STATUS);
 	bytePointer[1] = SPIXfer(0);
 	bytePointer[0] = SPIXfer(0);
 
+	m_bQueued = bQueued;
 	return temp;
 }
@@ -48,6 +48,7 @@ public:
 
 	bool IsDmxDataChanged(const uint8_t *, uint16_t);
 	void DmxData(const uint8_t *, uint16_t);
+	void DmxData();
 
 	void Start();
 	void Stop();
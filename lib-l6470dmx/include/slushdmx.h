@@ -93,6 +93,8 @@ public:	// MCP23017 Port A , Port B
 public:
 	void ReadConfigFiles();
 
+	void Run();
+
 public:
     static void staticCallbackFunction(void *p, const char *s);
 
@@ -129,6 +131,7 @@ private:
 	ModeParams *m_pModeParams[SLUSH_DMX_MAX_MOTORS];
 	L6470DmxModes *m_pL6470DmxModes[SLUSH_DMX_MAX_MOTORS];
 	lightset::SlotInfo *m_pSlotInfo[SLUSH_DMX_MAX_MOTORS];
+	bool m_bDataPending[SLUSH_DMX_MAX_MOTORS];
 
 	uint8_t m_nDmxMode;
 	uint16_t m_nDmxStartAddressMode;
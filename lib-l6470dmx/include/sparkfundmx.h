@@ -58,6 +58,8 @@ public:
 
 	void SetData(uint8_t nPort, const uint8_t *, uint16_t) override;
 
+	void Run();
+
 	void Print() override;
 
 	uint32_t GetMotorsConnected() {
@@ -119,12 +121,16 @@ public:
 public:
 	void ReadConfigFiles(struct TSparkFunStores *ptSparkFunStores=nullptr);
 
+private:
+	void SetQueued(bool bQueued);
+
 private:
 	AutoDriver *m_pAutoDriver[SPARKFUN_DMX_MAX_MOTORS];
 	MotorParams *m_pMotorParams[SPARKFUN_DMX_MAX_MOTORS];
 	ModeParams *m_pModeParams[SPARKFUN_DMX_MAX_MOTORS];
 	L6470DmxModes *m_pL6470DmxModes[SPARKFUN_DMX_MAX_MOTORS];
 	lightset::SlotInfo *m_pSlotInfo[SPARKFUN_DMX_MAX_MOTORS];
+	bool m_bDataPending[SPARKFUN_DMX_MAX_MOTORS];
 
 	uint8_t m_nGlobalSpiCs;
 	uint8_t m_nGlobalResetPin;
@@ -280,3 +280,18 @@ void L6470DmxModes::DmxData(const uint8_t *pDmxData, uint16_t nLength) {
 	DEBUG1_EXIT;
 }
 
+
+/**
+ * Apply the slots saved by IsDmxDataChanged, i.e. when the motor was busy at the time the data changed.
+ */
+void L6470DmxModes::DmxData() {
+	DEBUG1_ENTRY;
+
+	assert(m_pDmxMode != nullptr);
+
+	m_pDmxMode->Data(m_pDmxData);
+
+	m_bIsStarted = true;
+
+	DEBUG1_EXIT;
+}
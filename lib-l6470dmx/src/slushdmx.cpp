@@ -180,6 +180,7 @@ SlushDmx::SlushDmx(bool bUseSPI):
 		m_pModeParams[i] = 0;
 		m_pL6470DmxModes[i] = 0;
 		m_pSlotInfo[i] = 0;
+		m_bDataPending[i] = false;
 	}
 
 	m_pSlotInfoRaw = new char[DMX_SLOT_INFO_RAW_LENGTH];
@@ -274,6 +275,8 @@ void SlushDmx::Stop(__attribute__((unused)) uint8_t nPort) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->Stop();
 		}
+
+		m_bDataPending[i] = false;
 	}
 
 	DEBUG_EXIT;
@@ -490,47 +493,48 @@ void SlushDmx::ReadConfigFiles(void) {
 	DEBUG_EXIT;
 }
 
+/**
+ * A motor which is still busy gets a soft stop, its new data is kept
+ * and applied from Run() as soon as the motor is no longer busy.
+ */
 void SlushDmx::SetData(__attribute__((unused)) uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
 	DEBUG_ENTRY;
 
 	assert(pData != 0);
 	assert(nLength <= Dmx::UNIVERSE_SIZE);
 
-	bool bIsDmxDataChanged[SLUSH_DMX_MAX_MOTORS];
-
 	for (uint32_t i = 0; i < SLUSH_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
-			bIsDmxDataChanged[i] = m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength);
-
-			if(bIsDmxDataChanged[i]) {
+			if (m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength)) {
 				m_pL6470DmxModes[i]->HandleBusy();
+				m_bDataPending[i] = true;
 			}
-		} else {
-			bIsDmxDataChanged[i] = false;
 		}
 #ifndef NDEBUG
-		printf("bIsDmxDataChanged[%d]=%d\n", i, bIsDmxDataChanged[i]);
+		printf("m_bDataPending[%d]=%d\n", i, m_bDataPending[i]);
 #endif
 	}
 
-	for (uint32_t i = 0; i < SLUSH_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			while (m_pL6470DmxModes[i]->BusyCheck())
-				;
-		}
-	}
-
-	for (uint32_t i = 0; i < SLUSH_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			m_pL6470DmxModes[i]->DmxData(pData, nLength);
-		}
-	}
+	Run();
 
 	UpdateIOPorts(pData, nLength);
 
 	DEBUG_EXIT;
 }
 
+/**
+ * Called from the main loop and after SetData.
+ * The BUSY state is polled once per call, there is no waiting.
+ */
+void SlushDmx::Run() {
+	for (uint32_t i = 0; i < SLUSH_DMX_MAX_MOTORS; i++) {
+		if (m_bDataPending[i] && !m_pL6470DmxModes[i]->BusyCheck()) {
+			m_pL6470DmxModes[i]->DmxData();
+			m_bDataPending[i] = false;
+		}
+	}
+}
+
 void SlushDmx::UpdateIOPorts(const uint8_t *pData, uint16_t nLength) {
 	DEBUG_ENTRY;
 
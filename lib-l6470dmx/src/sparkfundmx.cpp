@@ -87,6 +87,7 @@ SparkFunDmx::SparkFunDmx():
 		m_pModeParams[i] = 0;
 		m_pL6470DmxModes[i] = 0;
 		m_pSlotInfo[i] = 0;
+		m_bDataPending[i] = false;
 	}
 
 	DEBUG_EXIT;
@@ -128,27 +129,53 @@ SparkFunDmx::~SparkFunDmx() {
 void SparkFunDmx::Start(__attribute__((unused)) uint8_t nPort) {
 	DEBUG_ENTRY;
 
+	SetQueued(true);
+
 	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->Start();
 		}
 	}
 
+	SetQueued(false);
+
 	DEBUG_EXIT;
 }
 
 void SparkFunDmx::Stop(__attribute__((unused)) uint8_t nPort) {
 	DEBUG_ENTRY;
 
+	SetQueued(true);
+
 	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->Stop();
 		}
+
+		m_bDataPending[i] = false;
 	}
 
+	SetQueued(false);
+
 	DEBUG_EXIT;
 }
 
+/**
+ * The commands of all the motors are collected and then sent
+ * in parallel over the daisy chain(s) when leaving the queued state.
+ */
+void SparkFunDmx::SetQueued(bool bQueued) {
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if (m_pAutoDriver[i] != nullptr) {
+			m_pAutoDriver[i]->SetQueued(bQueued);
+		}
+	}
+
+	if (!bQueued) {
+		AutoDriver::FlushQueue();
+	}
+}
+
 void SparkFunDmx::ReadConfigFiles(struct TSparkFunStores *ptSparkFunStores) {
 	DEBUG_ENTRY;
 #if !defined (H3)
@@ -346,43 +373,65 @@ void SparkFunDmx::ReadConfigFiles(struct TSparkFunStores *ptSparkFunStores) {
 	DEBUG_EXIT;
 }
 
+/**
+ * A motor which is still busy gets a soft stop, its new data is kept
+ * and applied from Run() as soon as the motor is no longer busy.
+ */
 void SparkFunDmx::SetData(__attribute__((unused)) uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
 	DEBUG_ENTRY;
 
 	assert(pData != 0);
 	assert(nLength <= DMX_UNIVERSE_SIZE);
 
-	bool bIsDmxDataChanged[SPARKFUN_DMX_MAX_MOTORS];
+	SetQueued(true);
 
 	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
-			bIsDmxDataChanged[i] = m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength);
-
-			if(bIsDmxDataChanged[i]) {
+			if (m_pL6470DmxModes[i]->IsDmxDataChanged(pData, nLength)) {
 				m_pL6470DmxModes[i]->HandleBusy();
+				m_bDataPending[i] = true;
 			}
-		} else {
-			bIsDmxDataChanged[i] = false;
 		}
 #ifndef NDEBUG
-		printf("bIsDmxDataChanged[%d]=%d\n", i, bIsDmxDataChanged[i]);
+		printf("m_bDataPending[%d]=%d\n", i, m_bDataPending[i]);
 #endif
 	}
 
+	SetQueued(false);
+
+	Run();
+
+	DEBUG_EXIT;
+}
+
+/**
+ * Called from the main loop and after SetData.
+ * The BUSY state is polled once per call, there is no waiting.
+ */
+void SparkFunDmx::Run() {
+	bool bIsPending = false;
+
 	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			while (m_pL6470DmxModes[i]->BusyCheck())
-				;
+		if (m_bDataPending[i]) {
+			bIsPending = true;
+			break;
 		}
 	}
 
-	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
-		if (bIsDmxDataChanged[i]) {
-			m_pL6470DmxModes[i]->DmxData(pData, nLength);
+	if (!bIsPending) {
+		return;
+	}
+
+	SetQueued(true);
+
+	for (uint32_t i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
+		if (m_bDataPending[i] && !m_pL6470DmxModes[i]->BusyCheck()) {
+			m_pL6470DmxModes[i]->DmxData();
+			m_bDataPending[i] = false;
 		}
 	}
 
-	DEBUG_EXIT;
+	SetQueued(false);
 }
 
 bool SparkFunDmx::SetDmxStartAddress(uint16_t nDmxStartAddress) {
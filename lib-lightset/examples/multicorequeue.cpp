@@ -0,0 +1,242 @@
+/**
+ * @file multicorequeue.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Runs LightSetQueue through MultiCore on the host, the secondary core is a pthread.
+ * The superloop on core 0 receives frames of 4 universes, each one is staged and
+ * the frame is committed. The simulated pixel output spends a fixed time per
+ * universe and per commit, and checks that every port sees each frame exactly once
+ * and in order, with the data intact.
+ * The same workload is run with the output on core 0, then through the queue on core 1.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lightset.h"
+#include "lightsetqueue.h"
+#include "multicore.h"
+#include "hardware.h"
+
+using namespace lightset;
+
+static constexpr uint32_t PORTS = 4;
+static constexpr uint32_t FRAMES = 2000;
+static constexpr uint32_t FRAME_MICROS = 1000;
+static constexpr uint32_t STAGE_MICROS = 120;	///< Per universe, the pixel encoding
+static constexpr uint32_t COMMIT_MICROS = 60;	///< Per frame, starting the update
+static constexpr uint32_t RECEIVE_MICROS = 10;	///< Per universe, the network and the protocol
+
+/*
+ * Hardware
+ */
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Micros() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint32_t>((static_cast<uint64_t>(ts.tv_sec) * 1000000U) + (static_cast<uint64_t>(ts.tv_nsec) / 1000U));
+}
+
+static void spin(uint32_t nMicros) {
+	const auto nStart = Hardware::Get()->Micros();
+
+	while ((Hardware::Get()->Micros() - nStart) < nMicros) {
+	}
+}
+
+/*
+ * Pixel output simulation
+ */
+
+class PixelSimulation final: public LightSet {
+public:
+	void Start(__attribute__((unused)) uint8_t nPort) override {
+		m_nStarts++;
+	}
+
+	void Stop(__attribute__((unused)) uint8_t nPort) override {
+	}
+
+	void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override {
+		Stage(nPort, pData, nLength);
+		Commit();
+	}
+
+	void Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override {
+		uint32_t nFrame;
+		memcpy(&nFrame, pData, sizeof(uint32_t));
+
+		if ((nPort >= PORTS) || (nFrame != m_nFrame[nPort]) || (nLength != Dmx::UNIVERSE_SIZE)) {
+			m_nErrors++;
+		}
+
+		for (uint32_t i = sizeof(uint32_t); i < nLength; i++) {
+			if (pData[i] != static_cast<uint8_t>(nFrame + nPort + i)) {
+				m_nErrors++;
+				break;
+			}
+		}
+
+		m_nFrame[nPort % PORTS] = nFrame + 1;
+		spin(STAGE_MICROS);
+	}
+
+	void Commit() override {
+		m_nCommits++;
+		spin(COMMIT_MICROS);
+	}
+
+	uint32_t GetErrors() const {
+		return m_nErrors;
+	}
+
+	uint32_t GetCommits() const {
+		return m_nCommits;
+	}
+
+	bool IsComplete() const {
+		for (uint32_t nPort = 0; nPort < PORTS; nPort++) {
+			if (m_nFrame[nPort] != FRAMES) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	uint32_t m_nFrame[PORTS] {};
+	uint32_t m_nErrors { 0 };
+	uint32_t m_nCommits { 0 };
+	uint32_t m_nStarts { 0 };
+};
+
+/*
+ * The core 0 superloop: a frame arrives every FRAME_MICROS
+ */
+static void superloop(LightSet *pLightSet, MultiCore& multiCore) {
+	uint8_t data[Dmx::UNIVERSE_SIZE];
+	auto nNextMicros = Hardware::Get()->Micros();
+
+	for (uint32_t nPort = 0; nPort < PORTS; nPort++) {
+		pLightSet->Start(static_cast<uint8_t>(nPort));
+	}
+
+	multiCore.GetLoad(0);
+	multiCore.GetLoad(1);
+
+	uint32_t nFrame = 0;
+
+	while (nFrame < FRAMES) {
+		if (static_cast<int32_t>(Hardware::Get()->Micros() - nNextMicros) >= 0) {
+			nNextMicros += FRAME_MICROS;
+
+			for (uint32_t nPort = 0; nPort < PORTS; nPort++) {
+				spin(RECEIVE_MICROS);
+
+				memcpy(data, &nFrame, sizeof(uint32_t));
+				for (uint32_t i = sizeof(uint32_t); i < Dmx::UNIVERSE_SIZE; i++) {
+					data[i] = static_cast<uint8_t>(nFrame + nPort + i);
+				}
+
+				pLightSet->Stage(static_cast<uint8_t>(nPort), data, Dmx::UNIVERSE_SIZE);
+			}
+
+			pLightSet->Commit();
+			nFrame++;
+		}
+
+		multiCore.Run();
+	}
+}
+
+static uint32_t s_nFailed;
+
+static void result(const char *pName, const PixelSimulation& pixels, uint32_t nMicros, uint32_t nLoad0, uint32_t nLoad1, uint32_t nStalls, uint32_t nDepthMax) {
+	const auto bPass = (pixels.GetErrors() == 0) && pixels.IsComplete() && (pixels.GetCommits() == FRAMES);
+
+	printf("%-12s %8u %8u %7u%% %7u%% %7u %7u %7u  %s\n", pName, pixels.GetCommits(), nMicros / 1000, nLoad0, nLoad1, nStalls, nDepthMax, pixels.GetErrors(), bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+int main() {
+	Hardware hw;
+
+	printf("%u ports, a frame every %u us, %u us per universe, %u us per commit\n\n", PORTS, FRAME_MICROS, STAGE_MICROS, COMMIT_MICROS);
+	if (sysconf(_SC_NPROCESSORS_ONLN) < 2) {
+		puts("Only 1 CPU online: the cores share it, the timing and the load are not representative\n");
+	}
+
+	printf("%-12s %8s %8s %8s %8s %7s %7s %7s\n", "Output", "Frames", "ms", "Core 0", "Core 1", "Stalls", "Depth", "Errors");
+
+	{
+		PixelSimulation pixels;
+		MultiCore multiCore;
+
+		const auto nStart = hw.Micros();
+		superloop(&pixels, multiCore);
+		const auto nElapsed = hw.Micros() - nStart;
+		const auto nLoad0 = multiCore.GetLoad(0);
+
+		result("Core 0", pixels, nElapsed, nLoad0, 0, 0, 0);
+	}
+
+	{
+		PixelSimulation pixels;
+		LightSetQueue lightSetQueue(&pixels);
+		MultiCore multiCore;
+
+		multiCore.Start(1, LightSetQueue::Task, &lightSetQueue);
+
+		const auto nStart = hw.Micros();
+		superloop(&lightSetQueue, multiCore);
+
+		while (!pixels.IsComplete() || (pixels.GetCommits() != FRAMES)) {
+			multiCore.Run();
+		}
+
+		const auto nElapsed = hw.Micros() - nStart;
+		const auto nLoad0 = multiCore.GetLoad(0);
+		const auto nLoad1 = multiCore.GetLoad(1);
+
+		multiCore.Stop();
+
+		result("Core 1", pixels, nElapsed, nLoad0, nLoad1, lightSetQueue.GetStalls(), lightSetQueue.GetDepthMax());
+	}
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
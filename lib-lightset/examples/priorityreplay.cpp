@@ -0,0 +1,535 @@
+/**
+ * @file priorityreplay.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Replays sACN sources into LightSetMerge and checks the merged output
+ * after each packet against a slot by slot reference model:
+ * packet priorities, per slot priorities (START Code 0xDD) with 0 as
+ * "not controlled", HTP on equal priorities, the fallback to the packet
+ * priority when a source stops sending 0xDD and the source timeout.
+ * In LTP mode the output is the most recent source with the top priority.
+ * The scripted scenarios are followed by a random replay, then the cost
+ * of a merge is measured.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "lightsetmerge.h"
+
+using namespace lightset;
+using namespace lightset::merge;
+
+static constexpr uint32_t TIMEOUT_SECONDS = 10;
+static constexpr uint32_t FRAME_MILLIS = 25;
+
+namespace ref {
+struct Source {
+	uint8_t data[Dmx::UNIVERSE_SIZE];
+	uint8_t slotPriority[Dmx::UNIVERSE_SIZE];
+	uint32_t nIp;
+	uint32_t nMillis;
+	uint32_t nSlotPriorityMillis;
+	uint32_t nLength;
+	uint32_t nUpdate;
+	uint8_t nPriority;
+	bool bHasSlotPriority;
+};
+}  // namespace ref
+
+class Replay {
+public:
+	Replay(Mode tMode = Mode::HTP): m_tMode(tMode) {
+		memset(m_Source, 0, sizeof(m_Source));
+		m_Merge.SetMode(0, tMode);
+	}
+
+	void Data(uint32_t nIp, uint8_t nPriority, const uint8_t *pData, uint32_t nLength) {
+		const auto nSourceIndex = Source(nIp);
+		auto &source = m_Source[nSourceIndex];
+
+		memcpy(source.data, pData, nLength);
+		memset(&source.data[nLength], 0, Dmx::UNIVERSE_SIZE - nLength);
+		source.nLength = nLength;
+		source.nPriority = nPriority;
+		source.nMillis = m_nMillis;
+		source.nUpdate = ++m_nUpdates;
+
+		if (source.bHasSlotPriority && ((m_nMillis - source.nSlotPriorityMillis) > SLOT_PRIORITY_TIMEOUT_MILLIS)) {
+			source.bHasSlotPriority = false;
+		}
+
+		m_Merge.SetData(0, nSourceIndex, nPriority, pData, nLength, m_nMillis);
+		Check();
+	}
+
+	void SlotPriority(uint32_t nIp, const uint8_t *pPriority, uint32_t nLength) {
+		const auto nSourceIndex = Source(nIp);
+		auto &source = m_Source[nSourceIndex];
+
+		memcpy(source.slotPriority, pPriority, nLength);
+		memset(&source.slotPriority[nLength], 0, Dmx::UNIVERSE_SIZE - nLength);
+		source.nSlotPriorityMillis = m_nMillis;
+		source.nMillis = m_nMillis;
+		source.bHasSlotPriority = true;
+
+		m_Merge.SetSlotPriority(0, nSourceIndex, pPriority, nLength, m_nMillis);
+		Check();
+	}
+
+	/*
+	 * A source must not be removed before the timeout, and not later than the next second
+	 */
+	void Advance(uint32_t nMillis) {
+		m_nMillis += nMillis;
+		m_Merge.Run(m_nMillis);
+
+		for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+			auto &source = m_Source[i];
+
+			if (source.nIp == 0) {
+				continue;
+			}
+
+			const auto nIdle = m_nMillis - source.nMillis;
+
+			if (m_Merge.GetSource(0, i)->nIp == 0) {
+				if (nIdle <= TIMEOUT_SECONDS * 1000) {
+					m_nErrors++;
+				}
+				source.nIp = 0;
+				m_nTimeouts++;
+			} else if (nIdle > (TIMEOUT_SECONDS * 1000) + 1000 + nMillis) {
+				m_nErrors++;
+			}
+		}
+	}
+
+	uint32_t Packets() const {
+		return m_nPackets;
+	}
+
+	uint32_t Errors() const {
+		return m_nErrors;
+	}
+
+	uint32_t Timeouts() const {
+		return m_nTimeouts;
+	}
+
+	const uint8_t *GetData() const {
+		return m_Merge.GetData(0);
+	}
+
+private:
+	uint32_t Source(uint32_t nIp) {
+		auto nSourceIndex = m_Merge.FindSource(0, nIp);
+
+		if (nSourceIndex == INVALID_SOURCE) {
+			nSourceIndex = m_Merge.AddSource(0, nIp);
+
+			if (nSourceIndex == INVALID_SOURCE) {
+				fprintf(stderr, "No free source for %08x\n", nIp);
+				exit(EXIT_FAILURE);
+			}
+
+			memset(&m_Source[nSourceIndex], 0, sizeof(ref::Source));
+			m_Source[nSourceIndex].nIp = nIp;
+			m_Source[nSourceIndex].nPriority = DEFAULT_PRIORITY;
+		}
+
+		return nSourceIndex;
+	}
+
+	void Check() {
+		m_nPackets++;
+
+		bool bSlotPriority = false;
+		uint32_t nActive = 0;
+		uint32_t nTop = 0;
+		uint32_t nTopSources = 0;
+
+		for (const auto &source : m_Source) {
+			if (source.nIp == 0) {
+				continue;
+			}
+
+			nActive++;
+			bSlotPriority |= source.bHasSlotPriority;
+
+			if (source.nPriority > nTop) {
+				nTop = source.nPriority;
+				nTopSources = 1;
+			} else if (source.nPriority == nTop) {
+				nTopSources++;
+			}
+		}
+
+		uint8_t expected[Dmx::UNIVERSE_SIZE];
+		uint32_t nLength = 0;
+
+		for (uint32_t nSlot = 0; nSlot < Dmx::UNIVERSE_SIZE; nSlot++) {
+			uint32_t nSlotTop = 0;
+			uint8_t nValue = 0;
+
+			for (const auto &source : m_Source) {
+				if (source.nIp == 0) {
+					continue;
+				}
+
+				const uint32_t nPriority = source.bHasSlotPriority ? source.slotPriority[nSlot] : source.nPriority;
+
+				if ((nPriority == 0) || (!bSlotPriority && (nPriority != nTop))) {
+					continue;
+				}
+
+				if (nSlot == 0 && source.nLength > nLength) {
+					nLength = source.nLength;
+				}
+
+				if (nPriority > nSlotTop) {
+					nSlotTop = nPriority;
+					nValue = source.data[nSlot];
+				} else if ((nPriority == nSlotTop) && (source.data[nSlot] > nValue)) {
+					nValue = source.data[nSlot];
+				}
+			}
+
+			expected[nSlot] = nValue;
+		}
+
+		if (!bSlotPriority && (m_tMode == Mode::LTP)) {
+			const ref::Source *pLatest = nullptr;
+
+			for (const auto &source : m_Source) {
+				if ((source.nIp != 0) && (source.nPriority == nTop) && ((pLatest == nullptr) || (source.nUpdate > pLatest->nUpdate))) {
+					pLatest = &source;
+				}
+			}
+
+			memcpy(expected, pLatest->data, Dmx::UNIVERSE_SIZE);
+			nLength = pLatest->nLength;
+		}
+
+		if (bSlotPriority) {
+			nLength = 0;
+			for (const auto &source : m_Source) {
+				if ((source.nIp != 0) && (source.nLength > nLength)) {
+					nLength = source.nLength;
+				}
+			}
+		}
+
+		const auto bIsMerging = bSlotPriority ? (nActive > 1) : (nTopSources > 1);
+
+		if ((m_Merge.GetLength(0) != nLength) || (memcmp(m_Merge.GetData(0), expected, nLength) != 0) || (m_Merge.IsMerging(0) != bIsMerging)) {
+			if (m_nErrors < 8) {
+				printf("  Mismatch at packet %u, %u ms: length %u/%u, merging %d/%d\n", m_nPackets, m_nMillis, m_Merge.GetLength(0), nLength, m_Merge.IsMerging(0), bIsMerging);
+			}
+			m_nErrors++;
+		}
+	}
+
+private:
+	LightSetMerge m_Merge { 1, TIMEOUT_SECONDS };
+	ref::Source m_Source[MAX_SOURCES];
+	Mode m_tMode;
+	uint32_t m_nUpdates { 0 };
+	uint32_t m_nMillis { 1000 };
+	uint32_t m_nPackets { 0 };
+	uint32_t m_nErrors { 0 };
+	uint32_t m_nTimeouts { 0 };
+};
+
+static constexpr uint32_t IP_A = 0x0a000001;
+static constexpr uint32_t IP_B = 0x0a000002;
+static constexpr uint32_t IP_C = 0x0a000003;
+static constexpr uint32_t IP_D = 0x0a000004;
+
+static void fill(uint8_t *p, uint8_t nValue, uint32_t nFrom = 0, uint32_t nTo = Dmx::UNIVERSE_SIZE) {
+	memset(&p[nFrom], nValue, nTo - nFrom);
+}
+
+static uint32_t s_nFailed;
+
+static void result(const char *pName, const Replay& replay, bool bExtra = true) {
+	const auto bPass = (replay.Errors() == 0) && bExtra;
+	printf("%-40s %6u %6u %8u  %s\n", pName, replay.Packets(), replay.Timeouts(), replay.Errors(), bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+/*
+ * Two sources at the default priority, a third at a higher priority takes over and times out
+ */
+static void scenario_packet_priority() {
+	Replay replay;
+	uint8_t a[Dmx::UNIVERSE_SIZE], b[Dmx::UNIVERSE_SIZE], c[Dmx::UNIVERSE_SIZE];
+
+	for (uint32_t nFrame = 0; nFrame < 800; nFrame++) {
+		fill(a, static_cast<uint8_t>(nFrame));
+		fill(b, 0x80, 0, 256);
+		fill(b, 0x10, 256);
+		fill(c, 0x40);
+
+		replay.Data(IP_A, 100, a, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_B, 100, b, 300);
+
+		if (nFrame < 200) {
+			replay.Data(IP_C, 150, c, Dmx::UNIVERSE_SIZE);
+		}
+
+		replay.Advance(FRAME_MILLIS);
+	}
+
+	result("Packet priority, HTP, timeout", replay, replay.Timeouts() == 1);
+}
+
+/*
+ * A drops its packet priority below B while both are sending
+ */
+static void scenario_priority_drop() {
+	Replay replay;
+	uint8_t a[Dmx::UNIVERSE_SIZE], b[Dmx::UNIVERSE_SIZE];
+
+	fill(a, 0xAA);
+	fill(b, 0x11);
+
+	for (uint32_t nFrame = 0; nFrame < 100; nFrame++) {
+		replay.Data(IP_A, (nFrame < 50) ? 150 : 90, a, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_B, 100, b, Dmx::UNIVERSE_SIZE);
+		replay.Advance(FRAME_MILLIS);
+	}
+
+	result("Packet priority change", replay, replay.GetData()[0] == 0x11);
+}
+
+/*
+ * LTP: A and B share the top priority, C is lower and sends first in each frame.
+ * When D times out, the first packet after it is from C. The output must be
+ * the most recent top priority source, not a merge of A and B.
+ */
+static void scenario_ltp_state_change() {
+	Replay replay(Mode::LTP);
+	uint8_t a[Dmx::UNIVERSE_SIZE], b[Dmx::UNIVERSE_SIZE], c[Dmx::UNIVERSE_SIZE], d[Dmx::UNIVERSE_SIZE];
+
+	fill(a, 0x20);
+	fill(b, 0xA0);
+	fill(c, 0xFF);
+	fill(d, 0x60);
+
+	for (uint32_t nFrame = 0; nFrame < 600; nFrame++) {
+		replay.Data(IP_C, 100, c, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_B, 150, b, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_A, 150, a, 256);
+
+		if (nFrame < 100) {
+			replay.Data(IP_D, 150, d, Dmx::UNIVERSE_SIZE);
+		}
+
+		replay.Advance(FRAME_MILLIS);
+	}
+
+	result("LTP, lower priority after a timeout", replay, replay.Timeouts() == 1);
+}
+
+/*
+ * A controls the first half with 0xDD, B and C the rest; the ties are merged HTP.
+ * Then A stops sending 0xDD and falls back to its packet priority.
+ */
+static void scenario_slot_priority() {
+	Replay replay;
+	uint8_t a[Dmx::UNIVERSE_SIZE], b[Dmx::UNIVERSE_SIZE], c[Dmx::UNIVERSE_SIZE];
+	uint8_t pa[Dmx::UNIVERSE_SIZE], pb[Dmx::UNIVERSE_SIZE];
+
+	fill(pa, 200, 0, 256);
+	fill(pa, 0, 256);
+	fill(pb, 0, 0, 128);
+	fill(pb, 200, 128, 384);
+	fill(pb, 120, 384);
+
+	for (uint32_t nFrame = 0; nFrame < 600; nFrame++) {
+		fill(a, static_cast<uint8_t>(nFrame * 3));
+		fill(b, static_cast<uint8_t>(0xFF - nFrame));
+		fill(c, 0x55);
+
+		replay.Data(IP_A, 80, a, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_B, 100, b, Dmx::UNIVERSE_SIZE);
+		replay.Data(IP_C, 120, c, 400);
+
+		if ((nFrame % 40) == 0) {
+			if (nFrame < 300) {
+				replay.SlotPriority(IP_A, pa, Dmx::UNIVERSE_SIZE);
+			}
+			replay.SlotPriority(IP_B, pb, 450);
+		}
+
+		replay.Advance(FRAME_MILLIS);
+	}
+
+	result("Per slot priority, fallback", replay);
+}
+
+/*
+ * Up to 4 sources with random priorities, data, 0xDD and silences
+ */
+static void scenario_random(const char *pName, Mode tMode) {
+	Replay replay(tMode);
+
+	struct {
+		uint8_t data[Dmx::UNIVERSE_SIZE];
+		uint8_t priority[Dmx::UNIVERSE_SIZE];
+		uint32_t nSilentFrames;
+		uint32_t nLength;
+		uint32_t nPriorityLength;
+		uint8_t nPriority;
+		bool bSlotPriority;
+	} sources[MAX_SOURCES];
+
+	static constexpr uint8_t PRIORITIES[] = { 0, 50, 100, 100, 150, 200 };
+	const uint32_t ip[MAX_SOURCES] = { IP_A, IP_B, IP_C, IP_D };
+
+	memset(sources, 0, sizeof(sources));
+
+	for (auto &source : sources) {
+		source.nLength = Dmx::UNIVERSE_SIZE;
+		source.nPriority = DEFAULT_PRIORITY;
+	}
+
+	srand(0x0DD);
+
+	for (uint32_t nFrame = 0; nFrame < 20000; nFrame++) {
+		for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+			auto &source = sources[i];
+
+			if (source.nSilentFrames != 0) {
+				source.nSilentFrames--;
+				continue;
+			}
+
+			switch (rand() % 400) {
+			case 0:
+				source.nSilentFrames = 40 + static_cast<uint32_t>(rand() % 600);
+				continue;
+			case 1:
+				source.bSlotPriority = !source.bSlotPriority;
+				break;
+			case 2:
+				source.nPriority = static_cast<uint8_t>(1 + (rand() % 200));
+				break;
+			case 3:
+				source.nLength = 1 + static_cast<uint32_t>(rand() % Dmx::UNIVERSE_SIZE);
+				break;
+			case 4:
+				for (uint32_t nSlot = 0; nSlot < Dmx::UNIVERSE_SIZE; nSlot += 32) {
+					fill(source.priority, PRIORITIES[rand() % sizeof(PRIORITIES)], nSlot, nSlot + 32);
+				}
+				source.nPriorityLength = 1 + static_cast<uint32_t>(rand() % Dmx::UNIVERSE_SIZE);
+				break;
+			default:
+				break;
+			}
+
+			for (uint32_t n = 0; n < 8; n++) {
+				source.data[rand() % Dmx::UNIVERSE_SIZE] = static_cast<uint8_t>(rand());
+			}
+
+			if ((rand() % 10) != 0) {
+				replay.Data(ip[i], source.nPriority, source.data, source.nLength);
+			}
+
+			if (source.bSlotPriority && ((rand() % 40) == 0)) {
+				replay.SlotPriority(ip[i], source.priority, source.nPriorityLength);
+			}
+		}
+
+		replay.Advance(FRAME_MILLIS);
+	}
+
+	result(pName, replay, replay.Timeouts() != 0);
+}
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/*
+ * The merge cost of a full universe per received packet
+ */
+static void benchmark(const char *pName, uint32_t nSources, bool bSlotPriority) {
+	static constexpr uint32_t PACKETS = 200000;
+	LightSetMerge merge(1, TIMEOUT_SECONDS);
+	uint8_t data[Dmx::UNIVERSE_SIZE];
+	uint8_t priority[Dmx::UNIVERSE_SIZE];
+
+	fill(priority, 100, 0, 256);
+	fill(priority, 0, 256);
+
+	for (uint32_t i = 0; i < nSources; i++) {
+		merge.AddSource(0, IP_A + i);
+		if (bSlotPriority) {
+			merge.SetSlotPriority(0, i, priority, Dmx::UNIVERSE_SIZE, 1000);
+		}
+	}
+
+	uint32_t nChanged = 0;
+	const auto nStart = nanos();
+
+	for (uint32_t nPacket = 0; nPacket < PACKETS; nPacket++) {
+		fill(data, static_cast<uint8_t>(nPacket));
+		nChanged += merge.SetData(0, nPacket % nSources, DEFAULT_PRIORITY, data, Dmx::UNIVERSE_SIZE, 1000 + (nPacket / 1000));
+	}
+
+	const auto nElapsed = nanos() - nStart;
+
+	printf("%-40s %8.1f ns/packet (%u changed)\n", pName, static_cast<double>(nElapsed) / PACKETS, nChanged);
+}
+
+int main() {
+	printf("%-40s %6s %6s %8s\n", "Scenario", "Pkts", "T/O", "Errors");
+
+	scenario_packet_priority();
+	scenario_priority_drop();
+	scenario_ltp_state_change();
+	scenario_slot_priority();
+	scenario_random("Random replay", Mode::HTP);
+	scenario_random("Random replay LTP", Mode::LTP);
+
+	puts("");
+	benchmark("1 source", 1, false);
+	benchmark("2 sources HTP", 2, false);
+	benchmark("4 sources HTP", 4, false);
+	benchmark("2 sources per slot priority", 2, true);
+	benchmark("4 sources per slot priority", 4, true);
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
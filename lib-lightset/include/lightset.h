@@ -75,6 +75,15 @@ public:
 
 	virtual void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength)= 0;
 
+	/**
+	 * Two-phase output: Stage() keeps the data of a port, Commit() outputs all the staged ports at once.
+	 * Outputs which cannot defer their output keep the default, which is SetData() and no Commit().
+	 */
+	virtual void Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+		SetData(nPort, pData, nLength);
+	}
+	virtual void Commit() {}
+
 	virtual void Blackout(__attribute__((unused)) bool bBlackout) {}
 
 	virtual void Print() {}
@@ -0,0 +1,112 @@
+/**
+ * @file lightsetbarrier.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETBARRIER_H_
+#define LIGHTSETBARRIER_H_
+
+#include <stdint.h>
+#include <cassert>
+
+/**
+ * Decides when the staged ports of a frame are committed, see LightSet::Stage and LightSet::Commit.
+ * A frame is complete when all the expected ports have arrived. A port arriving for the
+ * second time means an expected port is missing: the caller checks IsRepeated before
+ * staging, commits the pending frame and then stages the new data, which arrives in the next frame.
+ * The skew is the time between the first and the last arrival of a committed frame.
+ */
+class LightSetBarrier {
+public:
+	void SetExpected(uint32_t nPortMask) {
+		m_nExpected = nPortMask;
+	}
+
+	/**
+	 * Returns true when the port has already arrived in the pending frame
+	 */
+	bool IsRepeated(uint32_t nPortIndex) const {
+		assert(nPortIndex < 32);
+		return (m_nArrived & (1U << nPortIndex)) != 0;
+	}
+
+	/**
+	 * Returns true when the frame is complete
+	 */
+	bool Arrive(uint32_t nPortIndex, uint32_t nMicros) {
+		assert(nPortIndex < 32);
+
+		if (m_nArrived == 0) {
+			m_nFirstMicros = nMicros;
+		}
+
+		m_nArrived |= (1U << nPortIndex);
+		m_nLastMicros = nMicros;
+
+		return (m_nArrived & m_nExpected) == m_nExpected;
+	}
+
+	void Commit() {
+		if (m_nArrived == 0) {
+			return;
+		}
+
+		m_nSkewMicros = m_nLastMicros - m_nFirstMicros;
+
+		if (m_nSkewMicros > m_nSkewMaxMicros) {
+			m_nSkewMaxMicros = m_nSkewMicros;
+		}
+
+		m_nArrived = 0;
+		m_nCommits++;
+	}
+
+	uint32_t GetSkewMicros() const {
+		return m_nSkewMicros;
+	}
+
+	uint32_t GetSkewMaxMicros() const {
+		return m_nSkewMaxMicros;
+	}
+
+	uint32_t GetCommits() const {
+		return m_nCommits;
+	}
+
+	void ResetStatistics() {
+		m_nSkewMicros = 0;
+		m_nSkewMaxMicros = 0;
+		m_nCommits = 0;
+	}
+
+private:
+	uint32_t m_nExpected { 0 };
+	uint32_t m_nArrived { 0 };
+	uint32_t m_nFirstMicros { 0 };
+	uint32_t m_nLastMicros { 0 };
+	uint32_t m_nSkewMicros { 0 };
+	uint32_t m_nSkewMaxMicros { 0 };
+	uint32_t m_nCommits { 0 };
+};
+
+#endif /* LIGHTSETBARRIER_H_ */
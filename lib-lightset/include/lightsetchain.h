@@ -46,6 +46,8 @@ public:
 	void Stop(uint8_t nPort) override;
 
 	void SetData(uint8_t nPort, const uint8_t *, uint16_t) override;
+	void Stage(uint8_t nPort, const uint8_t *, uint16_t) override;
+	void Commit() override;
 
 	void Print() override;
 
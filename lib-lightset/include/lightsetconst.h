@@ -27,22 +27,30 @@
 #define LIGHTSETCONST_H_
 
 struct LightSetConst {
-	static const char PARAMS_OUTPUT[];
+	static constexpr char PARAMS_OUTPUT[] = "output";
 
-	static const char PARAMS_UNIVERSE[];
-	static const char PARAMS_UNIVERSE_PORT[4][16];
+	static constexpr char PARAMS_UNIVERSE[] = "universe";
+	static constexpr char PARAMS_UNIVERSE_PORT[4][16] = {
+			"universe_port_a", "universe_port_b", "universe_port_c",
+			"universe_port_d" };
 
-	static const char PARAMS_MERGE_MODE[];
-	static const char PARAMS_MERGE_MODE_PORT[4][18];
+	static constexpr char PARAMS_MERGE_MODE[] = "merge_mode";
+	static constexpr char PARAMS_MERGE_MODE_PORT[4][18] = {
+			"merge_mode_port_a", "merge_mode_port_b",
+			"merge_mode_port_c", "merge_mode_port_d" };
 
-	static const char PARAMS_START_UNI_PORT[8][18];
+	static constexpr char PARAMS_START_UNI_PORT[8][18] = {
+			"start_uni_port_1", "start_uni_port_2", "start_uni_port_3",
+			"start_uni_port_4", "start_uni_port_5", "start_uni_port_6",
+			"start_uni_port_7", "start_uni_port_8" };
 
-	static const char PARAMS_ENABLE_NO_CHANGE_UPDATE[];
+	static constexpr char PARAMS_ENABLE_NO_CHANGE_UPDATE[] = "enable_no_change_update";
+	static constexpr char PARAMS_OUTPUT_BARRIER[] = "output_barrier";
 
-	static const char PARAMS_DMX_START_ADDRESS[];
-	static const char PARAMS_DMX_SLOT_INFO[];
+	static constexpr char PARAMS_DMX_START_ADDRESS[] = "dmx_start_address";
+	static constexpr char PARAMS_DMX_SLOT_INFO[] = "dmx_slot_info";
 
-	static const char PARAMS_TEST_PATTERN[];
+	static constexpr char PARAMS_TEST_PATTERN[] = "test_pattern";
 };
 
 #endif /* LIGHTSETCONST_H_ */
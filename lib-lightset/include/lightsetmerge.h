@@ -0,0 +1,198 @@
+/**
+ * @file lightsetmerge.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETMERGE_H_
+#define LIGHTSETMERGE_H_
+
+#include <stdint.h>
+#include <cassert>
+
+#include "lightset.h"
+
+namespace lightset {
+namespace merge {
+static constexpr uint32_t MAX_SOURCES = 4;
+static constexpr uint32_t INVALID_SOURCE = MAX_SOURCES;
+static constexpr uint32_t CID_LENGTH = 16;
+static constexpr uint8_t DEFAULT_PRIORITY = 100;
+static constexpr uint32_t SLOT_PRIORITY_TIMEOUT_MILLIS = 2500;	///< Without per slot priority updates the source falls back to its packet priority
+static constexpr uint32_t WHEEL_SLOTS = 16;	///< Must be a power of 2 and larger than the timeout in seconds
+static constexpr uint16_t WHEEL_NIL = 0xFFFF;
+static constexpr uint8_t WHEEL_NONE = 0xFF;
+
+enum class Mode : uint8_t {
+	HTP, LTP
+};
+
+struct Source {
+	uint8_t data[Dmx::UNIVERSE_SIZE] __attribute__((aligned(4)));
+	uint8_t slotPriority[Dmx::UNIVERSE_SIZE] __attribute__((aligned(4)));	///< Valid when bHasSlotPriority, 0 is "do not use this slot"
+	uint8_t cid[CID_LENGTH];
+	uint32_t nIp;					///< 0 is a free entry
+	uint32_t nMillis;				///< The latest time data was received
+	uint32_t nSlotPriorityMillis;	///< The latest time per slot priorities were received
+	uint32_t nUpdate;				///< The port update count at the latest data, LTP uses the most recent source
+	uint16_t nLength;
+	uint16_t nPrevious;				///< Timer wheel
+	uint16_t nNext;					///< Timer wheel
+	uint8_t nWheelSlot;				///< Timer wheel, WHEEL_NONE when not linked
+	uint8_t nPriority;
+	uint8_t nSequenceNumber;		///< Not used by the merge, for the protocol
+	bool bHasSlotPriority;
+};
+
+struct Port {
+	uint8_t data[Dmx::UNIVERSE_SIZE] __attribute__((aligned(4)));	///< Merged output
+	Source source[MAX_SOURCES];
+	uint32_t nMillis;				///< The latest time data was received from any source
+	uint32_t nUpdates;				///< Data received from any source
+	uint16_t nLength;
+	Mode tMode;
+	uint8_t nActiveSources;
+	uint8_t nSlotPrioritySources;	///< When not 0 the port is merged slot by slot
+	bool bIsMerging;
+	bool bStateChanged;				///< The sources or their priorities have changed, the next merge is done for any source
+};
+}  // namespace merge
+}  // namespace lightset
+
+/**
+ * Merges the DMX data of up to merge::MAX_SOURCES sources per port.
+ * Only the sources with the highest priority of a port take part in the merge.
+ * With per slot priorities this is decided slot by slot, equal priorities are then merged HTP.
+ * A source which did not send data within the timeout is removed by the timer wheel.
+ */
+class LightSetMerge {
+public:
+	LightSetMerge(uint32_t nPorts, uint32_t nTimeoutSeconds);
+	~LightSetMerge();
+
+	void SetMode(uint32_t nPortIndex, lightset::merge::Mode tMode) {
+		assert(nPortIndex < m_nPorts);
+		m_pPorts[nPortIndex].tMode = tMode;
+	}
+
+	lightset::merge::Mode GetMode(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].tMode;
+	}
+
+	/**
+	 * Returns merge::INVALID_SOURCE when the source is not known
+	 */
+	uint32_t FindSource(uint32_t nPortIndex, uint32_t nIp, const uint8_t *pCid = nullptr) const;
+	/**
+	 * Returns merge::INVALID_SOURCE when all the entries of the port are in use
+	 */
+	uint32_t AddSource(uint32_t nPortIndex, uint32_t nIp, const uint8_t *pCid = nullptr);
+	void RemoveSource(uint32_t nPortIndex, uint32_t nSourceIndex);
+	/**
+	 * Removes all the sources except nSourceIndex
+	 */
+	void CancelMerge(uint32_t nPortIndex, uint32_t nSourceIndex);
+
+	lightset::merge::Source *GetSource(uint32_t nPortIndex, uint32_t nSourceIndex) {
+		assert(nPortIndex < m_nPorts);
+		assert(nSourceIndex < lightset::merge::MAX_SOURCES);
+		return &m_pPorts[nPortIndex].source[nSourceIndex];
+	}
+
+	/**
+	 * Returns true when the merged output has changed
+	 */
+	bool SetData(uint32_t nPortIndex, uint32_t nSourceIndex, uint8_t nPriority, const uint8_t *pData, uint32_t nLength, uint32_t nMillis);
+	/**
+	 * Per slot priorities (sACN START Code 0xDD). These replace the packet priority of the source.
+	 * A port with such a source is merged slot by slot: highest priority first, then HTP.
+	 * Returns true when the merged output has changed
+	 */
+	bool SetSlotPriority(uint32_t nPortIndex, uint32_t nSourceIndex, const uint8_t *pPriority, uint32_t nLength, uint32_t nMillis);
+
+	/**
+	 * Removes the sources which timed out. Amortized O(1), it can be called for each packet.
+	 */
+	void Run(uint32_t nMillis);
+
+	/**
+	 * Removes all the sources, the output length is set to 0
+	 */
+	void Reset(uint32_t nPortIndex);
+	/**
+	 * All slots are set to 0, the output length is set to a full universe
+	 */
+	void Clear(uint32_t nPortIndex);
+
+	const uint8_t *GetData(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].data;
+	}
+
+	uint32_t GetLength(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].nLength;
+	}
+
+	uint32_t GetMillis(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].nMillis;
+	}
+
+	uint32_t GetActiveSources(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].nActiveSources;
+	}
+
+	bool IsMerging(uint32_t nPortIndex) const {
+		assert(nPortIndex < m_nPorts);
+		return m_pPorts[nPortIndex].bIsMerging;
+	}
+
+	bool IsMerging() const {
+		return m_nMergingPorts != 0;
+	}
+
+private:
+	void UpdateState(uint32_t nPortIndex);
+	void Update(uint32_t nPortIndex, uint32_t nSourceIndex, uint32_t nMillis);
+	void ClearSlotPriority(uint32_t nPortIndex, uint32_t nSourceIndex);
+	bool Merge(uint32_t nPortIndex, uint32_t nSourceIndex);
+	bool MergeSlotPriority(uint32_t nPortIndex);
+	void WheelInsert(uint32_t nEntry, uint32_t nSlot);
+	void WheelRemove(uint32_t nEntry);
+
+	lightset::merge::Source& Entry(uint32_t nEntry) {
+		return m_pPorts[nEntry / lightset::merge::MAX_SOURCES].source[nEntry % lightset::merge::MAX_SOURCES];
+	}
+
+private:
+	lightset::merge::Port *m_pPorts;
+	uint32_t m_nPorts;
+	uint32_t m_nTimeoutMillis;
+	uint32_t m_nMergingPorts { 0 };
+	uint32_t m_nWheelSecond { 0 };
+	uint16_t m_aWheel[lightset::merge::WHEEL_SLOTS];
+};
+
+#endif /* LIGHTSETMERGE_H_ */
@@ -0,0 +1,132 @@
+/**
+ * @file lightsetqueue.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETQUEUE_H_
+#define LIGHTSETQUEUE_H_
+
+#include <stdint.h>
+
+#include "lightset.h"
+#include "spscring.h"
+
+namespace lightset {
+namespace queue {
+static constexpr uint32_t SIZE = 8;
+enum class Type : uint8_t {
+	START, STOP, SET_DATA, STAGE, COMMIT, BLACKOUT
+};
+struct Message {
+	Type type;
+	uint8_t nPort;
+	uint16_t nLength;
+	uint8_t data[Dmx::UNIVERSE_SIZE];
+};
+}  // namespace queue
+}  // namespace lightset
+
+/**
+ * Hands the output over to a secondary core, see MultiCore.
+ * The protocol stack on core 0 is the producer, Run() on the secondary core is the consumer
+ * and calls the wrapped LightSet. When the ring is full the producer waits (back pressure).
+ * The RDM getters and Print() are called directly, they do not touch the output.
+ */
+class LightSetQueue final: public LightSet {
+public:
+	LightSetQueue(LightSet *pLightSet);
+
+	void Start(uint8_t nPort) override {
+		Push(lightset::queue::Type::START, nPort);
+	}
+
+	void Stop(uint8_t nPort) override {
+		Push(lightset::queue::Type::STOP, nPort);
+	}
+
+	void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override {
+		Push(lightset::queue::Type::SET_DATA, nPort, pData, nLength);
+	}
+
+	void Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override {
+		Push(lightset::queue::Type::STAGE, nPort, pData, nLength);
+	}
+
+	void Commit() override {
+		Push(lightset::queue::Type::COMMIT, 0);
+	}
+
+	void Blackout(bool bBlackout) override {
+		Push(lightset::queue::Type::BLACKOUT, bBlackout ? 1 : 0);
+	}
+
+	void Print() override;
+
+	// RDM
+	bool SetDmxStartAddress(uint16_t nDmxStartAddress) override {
+		return m_pLightSet->SetDmxStartAddress(nDmxStartAddress);
+	}
+
+	uint16_t GetDmxStartAddress() override {
+		return m_pLightSet->GetDmxStartAddress();
+	}
+
+	uint16_t GetDmxFootprint() override {
+		return m_pLightSet->GetDmxFootprint();
+	}
+
+	bool GetSlotInfo(uint16_t nSlotOffset, lightset::SlotInfo &tSlotInfo) override {
+		return m_pLightSet->GetSlotInfo(nSlotOffset, tSlotInfo);
+	}
+
+	/**
+	 * Consumer, returns true when a message has been handled
+	 */
+	bool Run();
+
+	/**
+	 * multicore::Task
+	 */
+	static bool Task(void *pArg) {
+		return static_cast<LightSetQueue *>(pArg)->Run();
+	}
+
+	uint32_t GetStalls() const {
+		return m_nStalls;
+	}
+
+	uint32_t GetDepthMax() const {
+		return m_nDepthMax;
+	}
+
+private:
+	void Push(lightset::queue::Type type, uint8_t nPort, const uint8_t *pData = nullptr, uint16_t nLength = 0);
+
+private:
+	LightSet *m_pLightSet;
+	SpscRing<lightset::queue::Message, lightset::queue::SIZE> m_Ring;
+	uint32_t m_nStalls { 0 };
+	uint32_t m_nDepthMax { 0 };
+};
+
+#endif /* LIGHTSETQUEUE_H_ */
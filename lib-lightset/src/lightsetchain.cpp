@@ -72,6 +72,20 @@ void LightSetChain::SetData(uint8_t nPort, const uint8_t *pData, uint16_t nSize)
 	}
 }
 
+void LightSetChain::Stage(uint8_t nPort, const uint8_t *pData, uint16_t nSize) {
+	assert(pData != nullptr);
+
+	for (unsigned i = 0; i < m_nSize; i++) {
+		m_pTable[i].pLightSet->Stage(nPort, pData, nSize);
+	}
+}
+
+void LightSetChain::Commit() {
+	for (unsigned i = 0; i < m_nSize; i++) {
+		m_pTable[i].pLightSet->Commit();
+	}
+}
+
 void LightSetChain::Print() {
 	for (unsigned i = 0; i < m_nSize; i++) {
 		m_pTable[i].pLightSet->Print();
@@ -25,24 +25,20 @@
 
 #include "lightsetconst.h"
 
-const char LightSetConst::PARAMS_OUTPUT[] = "output";
+constexpr char LightSetConst::PARAMS_OUTPUT[];
 
-const char LightSetConst::PARAMS_UNIVERSE[] = "universe";
-const char LightSetConst::PARAMS_UNIVERSE_PORT[4][16] = { "universe_port_a",
-		"universe_port_b", "universe_port_c", "universe_port_d" };
+constexpr char LightSetConst::PARAMS_UNIVERSE[];
+constexpr char LightSetConst::PARAMS_UNIVERSE_PORT[4][16];
 
-const char LightSetConst::PARAMS_MERGE_MODE[] = "merge_mode";
-const char LightSetConst::PARAMS_MERGE_MODE_PORT[4][18] = { "merge_mode_port_a",
-		"merge_mode_port_b", "merge_mode_port_c", "merge_mode_port_d" };
+constexpr char LightSetConst::PARAMS_MERGE_MODE[];
+constexpr char LightSetConst::PARAMS_MERGE_MODE_PORT[4][18];
 
-const char LightSetConst::PARAMS_START_UNI_PORT[8][18] = { "start_uni_port_1",
-		"start_uni_port_2", "start_uni_port_3", "start_uni_port_4",
-		"start_uni_port_5", "start_uni_port_6", "start_uni_port_7",
-		"start_uni_port_8" };
+constexpr char LightSetConst::PARAMS_START_UNI_PORT[8][18];
 
-const char LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE[] = "enable_no_change_update";
+constexpr char LightSetConst::PARAMS_ENABLE_NO_CHANGE_UPDATE[];
+constexpr char LightSetConst::PARAMS_OUTPUT_BARRIER[];
 
-const char LightSetConst::PARAMS_DMX_START_ADDRESS[] = "dmx_start_address";
-const char LightSetConst::PARAMS_DMX_SLOT_INFO[] = "dmx_slot_info";
+constexpr char LightSetConst::PARAMS_DMX_START_ADDRESS[];
+constexpr char LightSetConst::PARAMS_DMX_SLOT_INFO[];
 
-const char LightSetConst::PARAMS_TEST_PATTERN[] = "test_pattern";
+constexpr char LightSetConst::PARAMS_TEST_PATTERN[];
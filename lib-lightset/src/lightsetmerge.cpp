@@ -0,0 +1,561 @@
+/**
+ * @file lightsetmerge.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <cassert>
+
+#include "lightsetmerge.h"
+
+#include "debug.h"
+
+using namespace lightset;
+using namespace lightset::merge;
+
+/*
+ * Byte wise a >= b, 0xFF for true and 0x00 for false, 4 slots at once
+ */
+static inline uint32_t ge8(uint32_t a, uint32_t b) {
+#if defined (__ARM_FEATURE_SIMD32)
+	uint32_t r;
+	asm volatile ("usub8 %0, %1, %2\n\tsel %0, %3, %4" : "=&r" (r) : "r" (a), "r" (b), "r" (0xFFFFFFFF), "r" (0) : "cc");
+	return r;
+#else
+	constexpr uint32_t H = 0x80808080;
+	const auto t = (a | H) - (b & ~H);
+	const auto ge = ((a & ~b) | (~(a ^ b) & t)) & H;
+	return (ge >> 7) * 0xFF;
+#endif
+}
+
+/*
+ * Byte wise maximum of 4 slots at once
+ */
+static inline uint32_t max8(uint32_t a, uint32_t b) {
+#if defined (__ARM_FEATURE_SIMD32)
+	uint32_t r;
+	asm volatile ("usub8 %0, %1, %2\n\tsel %0, %1, %2" : "=&r" (r) : "r" (a), "r" (b) : "cc");
+	return r;
+#else
+	const auto mask = ge8(a, b);
+	return (a & mask) | (b & ~mask);
+#endif
+}
+
+LightSetMerge::LightSetMerge(uint32_t nPorts, uint32_t nTimeoutSeconds): m_nPorts(nPorts), m_nTimeoutMillis(nTimeoutSeconds * 1000) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nPorts=%u, nTimeoutSeconds=%u", nPorts, nTimeoutSeconds);
+
+	assert(nPorts * MAX_SOURCES < WHEEL_NIL);
+	assert(nTimeoutSeconds + 1 < WHEEL_SLOTS);
+
+	m_pPorts = new Port[nPorts];
+	assert(m_pPorts != nullptr);
+
+	for (uint32_t nPortIndex = 0; nPortIndex < nPorts; nPortIndex++) {
+		memset(&m_pPorts[nPortIndex], 0, sizeof(struct Port));
+		m_pPorts[nPortIndex].tMode = Mode::HTP;
+
+		for (uint32_t nSourceIndex = 0; nSourceIndex < MAX_SOURCES; nSourceIndex++) {
+			m_pPorts[nPortIndex].source[nSourceIndex].nWheelSlot = WHEEL_NONE;
+		}
+	}
+
+	for (uint32_t i = 0; i < WHEEL_SLOTS; i++) {
+		m_aWheel[i] = WHEEL_NIL;
+	}
+
+	DEBUG_EXIT
+}
+
+LightSetMerge::~LightSetMerge() {
+	delete[] m_pPorts;
+}
+
+uint32_t LightSetMerge::FindSource(uint32_t nPortIndex, uint32_t nIp, const uint8_t *pCid) const {
+	assert(nPortIndex < m_nPorts);
+
+	if (nIp == 0) {
+		return INVALID_SOURCE;
+	}
+
+	const auto &port = m_pPorts[nPortIndex];
+
+	for (uint32_t nSourceIndex = 0; nSourceIndex < MAX_SOURCES; nSourceIndex++) {
+		const auto &source = port.source[nSourceIndex];
+
+		if ((source.nIp == nIp) && ((pCid == nullptr) || (memcmp(source.cid, pCid, CID_LENGTH) == 0))) {
+			return nSourceIndex;
+		}
+	}
+
+	return INVALID_SOURCE;
+}
+
+uint32_t LightSetMerge::AddSource(uint32_t nPortIndex, uint32_t nIp, const uint8_t *pCid) {
+	assert(nPortIndex < m_nPorts);
+	assert(nIp != 0);
+
+	auto &port = m_pPorts[nPortIndex];
+
+	for (uint32_t nSourceIndex = 0; nSourceIndex < MAX_SOURCES; nSourceIndex++) {
+		auto &source = port.source[nSourceIndex];
+
+		if (source.nIp == 0) {
+			source.nIp = nIp;
+
+			if (pCid != nullptr) {
+				memcpy(source.cid, pCid, CID_LENGTH);
+			}
+
+			source.nPriority = DEFAULT_PRIORITY;
+			source.nSequenceNumber = 0;
+
+			UpdateState(nPortIndex);
+			return nSourceIndex;
+		}
+	}
+
+	return INVALID_SOURCE;
+}
+
+void LightSetMerge::RemoveSource(uint32_t nPortIndex, uint32_t nSourceIndex) {
+	assert(nPortIndex < m_nPorts);
+	assert(nSourceIndex < MAX_SOURCES);
+
+	auto &source = m_pPorts[nPortIndex].source[nSourceIndex];
+
+	if (source.nIp == 0) {
+		return;
+	}
+
+	if (source.nWheelSlot != WHEEL_NONE) {
+		WheelRemove((nPortIndex * MAX_SOURCES) + nSourceIndex);
+	}
+
+	if (source.bHasSlotPriority) {
+		ClearSlotPriority(nPortIndex, nSourceIndex);
+	}
+
+	memset(source.data, 0, source.nLength);
+	memset(source.cid, 0, CID_LENGTH);
+	source.nLength = 0;
+	source.nIp = 0;
+
+	UpdateState(nPortIndex);
+}
+
+void LightSetMerge::CancelMerge(uint32_t nPortIndex, uint32_t nSourceIndex) {
+	for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+		if (i != nSourceIndex) {
+			RemoveSource(nPortIndex, i);
+		}
+	}
+}
+
+void LightSetMerge::Reset(uint32_t nPortIndex) {
+	for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+		RemoveSource(nPortIndex, i);
+	}
+
+	m_pPorts[nPortIndex].nLength = 0;
+}
+
+void LightSetMerge::Clear(uint32_t nPortIndex) {
+	assert(nPortIndex < m_nPorts);
+
+	memset(m_pPorts[nPortIndex].data, 0, Dmx::UNIVERSE_SIZE);
+	m_pPorts[nPortIndex].nLength = Dmx::UNIVERSE_SIZE;
+}
+
+void LightSetMerge::Update(uint32_t nPortIndex, uint32_t nSourceIndex, uint32_t nMillis) {
+	auto &port = m_pPorts[nPortIndex];
+	auto &source = port.source[nSourceIndex];
+
+	source.nMillis = nMillis;
+	port.nMillis = nMillis;
+
+	const auto nSlot = (nMillis / 1000) & (WHEEL_SLOTS - 1);
+
+	if (source.nWheelSlot != nSlot) {
+		const auto nEntry = (nPortIndex * MAX_SOURCES) + nSourceIndex;
+
+		if (source.nWheelSlot != WHEEL_NONE) {
+			WheelRemove(nEntry);
+		}
+
+		WheelInsert(nEntry, nSlot);
+	}
+}
+
+bool LightSetMerge::SetData(uint32_t nPortIndex, uint32_t nSourceIndex, uint8_t nPriority, const uint8_t *pData, uint32_t nLength, uint32_t nMillis) {
+	assert(nPortIndex < m_nPorts);
+	assert(nSourceIndex < MAX_SOURCES);
+	assert(pData != nullptr);
+	assert(nLength <= Dmx::UNIVERSE_SIZE);
+
+	auto &port = m_pPorts[nPortIndex];
+	auto &source = port.source[nSourceIndex];
+
+	assert(source.nIp != 0);
+
+	memcpy(source.data, pData, nLength);
+
+	if (nLength < source.nLength) {
+		memset(&source.data[nLength], 0, source.nLength - nLength);
+	}
+
+	source.nLength = static_cast<uint16_t>(nLength);
+	source.nUpdate = ++port.nUpdates;
+
+	Update(nPortIndex, nSourceIndex, nMillis);
+
+	if (__builtin_expect((source.bHasSlotPriority), 0)) {
+		if ((nMillis - source.nSlotPriorityMillis) > SLOT_PRIORITY_TIMEOUT_MILLIS) {
+			ClearSlotPriority(nPortIndex, nSourceIndex);
+		}
+	}
+
+	if (source.nPriority != nPriority) {
+		source.nPriority = nPriority;
+		UpdateState(nPortIndex);
+	}
+
+	return Merge(nPortIndex, nSourceIndex);
+}
+
+bool LightSetMerge::SetSlotPriority(uint32_t nPortIndex, uint32_t nSourceIndex, const uint8_t *pPriority, uint32_t nLength, uint32_t nMillis) {
+	assert(nPortIndex < m_nPorts);
+	assert(nSourceIndex < MAX_SOURCES);
+	assert(pPriority != nullptr);
+	assert(nLength <= Dmx::UNIVERSE_SIZE);
+
+	auto &port = m_pPorts[nPortIndex];
+	auto &source = port.source[nSourceIndex];
+
+	assert(source.nIp != 0);
+
+	memcpy(source.slotPriority, pPriority, nLength);
+	memset(&source.slotPriority[nLength], 0, Dmx::UNIVERSE_SIZE - nLength);
+
+	source.nSlotPriorityMillis = nMillis;
+
+	Update(nPortIndex, nSourceIndex, nMillis);
+
+	if (!source.bHasSlotPriority) {
+		source.bHasSlotPriority = true;
+		port.nSlotPrioritySources++;
+		UpdateState(nPortIndex);
+	}
+
+	return MergeSlotPriority(nPortIndex);
+}
+
+void LightSetMerge::ClearSlotPriority(uint32_t nPortIndex, uint32_t nSourceIndex) {
+	auto &port = m_pPorts[nPortIndex];
+	auto &source = port.source[nSourceIndex];
+
+	assert(source.bHasSlotPriority);
+	assert(port.nSlotPrioritySources != 0);
+
+	source.bHasSlotPriority = false;
+	port.nSlotPrioritySources--;
+
+	UpdateState(nPortIndex);
+}
+
+bool LightSetMerge::Merge(uint32_t nPortIndex, uint32_t nSourceIndex) {
+	auto &port = m_pPorts[nPortIndex];
+
+	if (__builtin_expect((port.nSlotPrioritySources != 0), 0)) {
+		return MergeSlotPriority(nPortIndex);
+	}
+
+	uint8_t nTopPriority = 0;
+
+	for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+		if ((port.source[i].nIp != 0) && (port.source[i].nPriority > nTopPriority)) {
+			nTopPriority = port.source[i].nPriority;
+		}
+	}
+
+	if ((port.source[nSourceIndex].nPriority < nTopPriority) && !port.bStateChanged) {
+		return false;
+	}
+
+	port.bStateChanged = false;
+
+	const uint32_t *pSources[MAX_SOURCES];
+	uint32_t nSources = 0;
+	uint32_t nLength = 0;
+
+	if (port.tMode == Mode::LTP) {
+		auto nLatest = nSourceIndex;
+
+		// After a state change a lower priority source can trigger the merge, the output is the most recent top priority source
+		if (port.source[nSourceIndex].nPriority != nTopPriority) {
+			nLatest = INVALID_SOURCE;
+
+			for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+				const auto &source = port.source[i];
+
+				if ((source.nIp != 0) && (source.nPriority == nTopPriority)) {
+					if ((nLatest == INVALID_SOURCE) || (static_cast<int32_t>(source.nUpdate - port.source[nLatest].nUpdate) > 0)) {
+						nLatest = i;
+					}
+				}
+			}
+
+			assert(nLatest != INVALID_SOURCE);
+		}
+
+		pSources[nSources++] = reinterpret_cast<const uint32_t *>(port.source[nLatest].data);
+		nLength = port.source[nLatest].nLength;
+	} else {
+		for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+			if ((port.source[i].nIp != 0) && (port.source[i].nPriority == nTopPriority)) {
+				pSources[nSources++] = reinterpret_cast<const uint32_t *>(port.source[i].data);
+
+				if (port.source[i].nLength > nLength) {
+					nLength = port.source[i].nLength;
+				}
+			}
+		}
+	}
+
+	auto *pOut = reinterpret_cast<uint32_t *>(port.data);
+	const auto nWords = (nLength + 3) / 4;
+	uint32_t nDiff = 0;
+
+	if (nSources == 1) {
+		const auto *pSource = pSources[0];
+
+		for (uint32_t i = 0; i < nWords; i++) {
+			nDiff |= (pOut[i] ^ pSource[i]);
+			pOut[i] = pSource[i];
+		}
+	} else {
+		for (uint32_t i = 0; i < nWords; i++) {
+			auto nValue = max8(pSources[0][i], pSources[1][i]);
+
+			for (uint32_t j = 2; j < nSources; j++) {
+				nValue = max8(nValue, pSources[j][i]);
+			}
+
+			nDiff |= (pOut[i] ^ nValue);
+			pOut[i] = nValue;
+		}
+	}
+
+	if (port.nLength != nLength) {
+		port.nLength = static_cast<uint16_t>(nLength);
+		return true;
+	}
+
+	return (nDiff != 0);
+}
+
+/*
+ * For each slot only the sources with the highest priority for that slot are used.
+ * A slot priority of 0 means the source does not control that slot.
+ */
+bool LightSetMerge::MergeSlotPriority(uint32_t nPortIndex) {
+	auto &port = m_pPorts[nPortIndex];
+	port.bStateChanged = false;
+
+	const uint32_t *pSources[MAX_SOURCES];
+	const uint32_t *pPriorities[MAX_SOURCES];
+	uint32_t nPriorities[MAX_SOURCES];
+	uint32_t nSources = 0;
+	uint32_t nLength = 0;
+
+	for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+		const auto &source = port.source[i];
+
+		if (source.nIp == 0) {
+			continue;
+		}
+
+		pSources[nSources] = reinterpret_cast<const uint32_t *>(source.data);
+
+		if (source.bHasSlotPriority) {
+			pPriorities[nSources] = reinterpret_cast<const uint32_t *>(source.slotPriority);
+			nPriorities[nSources] = 0;
+		} else {
+			pPriorities[nSources] = nullptr;
+			nPriorities[nSources] = source.nPriority * 0x01010101U;
+		}
+
+		if (source.nLength > nLength) {
+			nLength = source.nLength;
+		}
+
+		nSources++;
+	}
+
+	auto *pOut = reinterpret_cast<uint32_t *>(port.data);
+	const auto nWords = (nLength + 3) / 4;
+	uint32_t nDiff = 0;
+
+	for (uint32_t i = 0; i < nWords; i++) {
+		uint32_t nTopPriority = 0;
+		uint32_t nValue = 0;
+
+		for (uint32_t j = 0; j < nSources; j++) {
+			const auto nPriority = (pPriorities[j] != nullptr) ? pPriorities[j][i] : nPriorities[j];
+			const auto nData = pSources[j][i] & ~ge8(0, nPriority);
+			const auto ge = ge8(nPriority, nTopPriority);	// This source is at least the top priority
+			const auto le = ge8(nTopPriority, nPriority);	// The top priority is at least this source
+			const auto nMerged = (max8(nValue, nData) & le) | (nData & ~le);
+
+			nValue = (nMerged & ge) | (nValue & ~ge);
+			nTopPriority = max8(nTopPriority, nPriority);
+		}
+
+		nDiff |= (pOut[i] ^ nValue);
+		pOut[i] = nValue;
+	}
+
+	if (port.nLength != nLength) {
+		port.nLength = static_cast<uint16_t>(nLength);
+		return true;
+	}
+
+	return (nDiff != 0);
+}
+
+void LightSetMerge::UpdateState(uint32_t nPortIndex) {
+	auto &port = m_pPorts[nPortIndex];
+
+	uint32_t nActiveSources = 0;
+	uint32_t nTopSources = 0;
+	uint8_t nTopPriority = 0;
+
+	for (uint32_t i = 0; i < MAX_SOURCES; i++) {
+		const auto &source = port.source[i];
+
+		if (source.nIp == 0) {
+			continue;
+		}
+
+		nActiveSources++;
+
+		if (source.nPriority > nTopPriority) {
+			nTopPriority = source.nPriority;
+			nTopSources = 1;
+		} else if (source.nPriority == nTopPriority) {
+			nTopSources++;
+		}
+	}
+
+	port.nActiveSources = static_cast<uint8_t>(nActiveSources);
+	port.bStateChanged = true;
+
+	if (port.nSlotPrioritySources != 0) {
+		nTopSources = nActiveSources;
+	}
+
+	const auto bIsMerging = (nTopSources > 1);
+
+	if (bIsMerging != port.bIsMerging) {
+		port.bIsMerging = bIsMerging;
+
+		if (bIsMerging) {
+			m_nMergingPorts++;
+		} else {
+			m_nMergingPorts--;
+		}
+	}
+}
+
+/*
+ * A source is linked in the slot of the second it last received data.
+ * When the wheel moves to second s, the slot of second (s - timeout - 1)
+ * only holds sources which did not receive data for more than the timeout.
+ */
+void LightSetMerge::Run(uint32_t nMillis) {
+	const auto nSecond = nMillis / 1000;
+
+	if (__builtin_expect((nSecond == m_nWheelSecond), 1)) {
+		return;
+	}
+
+	auto nSteps = nSecond - m_nWheelSecond;
+
+	if (nSteps > WHEEL_SLOTS) {
+		nSteps = WHEEL_SLOTS;
+	}
+
+	m_nWheelSecond = nSecond;
+
+	const auto nTimeoutSeconds = m_nTimeoutMillis / 1000;
+
+	for (uint32_t nStep = 0; nStep < nSteps; nStep++) {
+		const auto nSlot = (nSecond - nStep - nTimeoutSeconds - 1) & (WHEEL_SLOTS - 1);
+		auto nEntry = m_aWheel[nSlot];
+
+		while (nEntry != WHEEL_NIL) {
+			const auto &source = Entry(nEntry);
+			const auto nNext = source.nNext;
+
+			if ((nMillis - source.nMillis) > m_nTimeoutMillis) {
+				DEBUG_PRINTF("Timeout %u:%u", nEntry / MAX_SOURCES, nEntry % MAX_SOURCES);
+				RemoveSource(nEntry / MAX_SOURCES, nEntry % MAX_SOURCES);
+			}
+
+			nEntry = nNext;
+		}
+	}
+}
+
+void LightSetMerge::WheelInsert(uint32_t nEntry, uint32_t nSlot) {
+	auto &source = Entry(nEntry);
+
+	source.nWheelSlot = static_cast<uint8_t>(nSlot);
+	source.nPrevious = WHEEL_NIL;
+	source.nNext = m_aWheel[nSlot];
+
+	if (source.nNext != WHEEL_NIL) {
+		Entry(source.nNext).nPrevious = static_cast<uint16_t>(nEntry);
+	}
+
+	m_aWheel[nSlot] = static_cast<uint16_t>(nEntry);
+}
+
+void LightSetMerge::WheelRemove(uint32_t nEntry) {
+	auto &source = Entry(nEntry);
+
+	if (source.nPrevious != WHEEL_NIL) {
+		Entry(source.nPrevious).nNext = source.nNext;
+	} else {
+		m_aWheel[source.nWheelSlot] = source.nNext;
+	}
+
+	if (source.nNext != WHEEL_NIL) {
+		Entry(source.nNext).nPrevious = source.nPrevious;
+	}
+
+	source.nWheelSlot = WHEEL_NONE;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file lightsetqueue.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <cassert>
+
+#include "lightsetqueue.h"
+
+#include "debug.h"
+
+using namespace lightset;
+
+LightSetQueue::LightSetQueue(LightSet *pLightSet) : m_pLightSet(pLightSet) {
+	DEBUG_ENTRY
+
+	assert(m_pLightSet != nullptr);
+
+	DEBUG_EXIT
+}
+
+void LightSetQueue::Push(queue::Type type, uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+	assert(nLength <= Dmx::UNIVERSE_SIZE);
+
+	auto *pMessage = m_Ring.Claim();
+
+	if (__builtin_expect((pMessage == nullptr), 0)) {
+		m_nStalls++;
+
+		do {
+			pMessage = m_Ring.Claim();
+		} while (pMessage == nullptr);
+	}
+
+	pMessage->type = type;
+	pMessage->nPort = nPort;
+	pMessage->nLength = nLength;
+
+	if (pData != nullptr) {
+		memcpy(pMessage->data, pData, nLength);
+	}
+
+	m_Ring.Publish();
+
+	const auto nDepth = m_Ring.Size();
+
+	if (nDepth > m_nDepthMax) {
+		m_nDepthMax = nDepth;
+	}
+}
+
+bool LightSetQueue::Run() {
+	const auto *pMessage = m_Ring.Front();
+
+	if (pMessage == nullptr) {
+		return false;
+	}
+
+	switch (pMessage->type) {
+	case queue::Type::START:
+		m_pLightSet->Start(pMessage->nPort);
+		break;
+	case queue::Type::STOP:
+		m_pLightSet->Stop(pMessage->nPort);
+		break;
+	case queue::Type::SET_DATA:
+		m_pLightSet->SetData(pMessage->nPort, pMessage->data, pMessage->nLength);
+		break;
+	case queue::Type::STAGE:
+		m_pLightSet->Stage(pMessage->nPort, pMessage->data, pMessage->nLength);
+		break;
+	case queue::Type::COMMIT:
+		m_pLightSet->Commit();
+		break;
+	case queue::Type::BLACKOUT:
+		m_pLightSet->Blackout(pMessage->nPort != 0);
+		break;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
+	}
+
+	m_Ring.Release();
+	return true;
+}
+
+void LightSetQueue::Print() {
+	m_pLightSet->Print();
+
+	printf("Output queue\n");
+	printf(" Size    : %u\n", queue::SIZE);
+	printf(" Depth   : %u\n", m_nDepthMax);
+	printf(" Stalls  : %u\n", m_nStalls);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file ltcdecode.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Feeds simulated bi-phase mark LTC into LtcDecoder, as the FIQ does: the time
+ * in microseconds between two edges, with jitter. Film, EBU, DF and SMPTE,
+ * counting over a minute boundary. The signal starts in the middle of a frame,
+ * and has a drop out in the middle of the run. Every frame passed to the
+ * callback must be the frame that has just been sent, the frame at the start
+ * and the frame with the drop out must not be passed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ltcdecoder.h"
+#include "ltc.h"
+
+static constexpr uint32_t FRAMES = 300;
+static constexpr uint32_t DROP_OUT_FRAME = 150;
+static constexpr uint32_t DROP_OUT_BIT = 20;
+static constexpr uint32_t DROP_OUT_MICROS = 2000;
+static constexpr uint32_t JITTER_PERCENT = 5;
+
+static uint32_t s_nFailed;
+
+static void result(const char *pName, bool bPassed) {
+	printf("%-48s %s\n", pName, bPassed ? "PASS" : "FAIL");
+	if (!bPassed) {
+		s_nFailed++;
+	}
+}
+
+static TLtcTimeCode s_Sent[FRAMES];
+static uint32_t s_nSending;
+static uint32_t s_nCallbacks;
+static uint32_t s_nWrong;
+static bool s_bDropFrame;
+static bool s_bPassed[FRAMES];
+
+static void frame_handler(const uint8_t *pBits) {
+	TLtcTimeCode tLtcTimeCode;
+	LtcDecoder::GetTimeCode(pBits, tLtcTimeCode);
+
+	const auto& sent = s_Sent[s_nSending];
+
+	if ((tLtcTimeCode.nFrames != sent.nFrames) || (tLtcTimeCode.nSeconds != sent.nSeconds) || (tLtcTimeCode.nMinutes != sent.nMinutes) || (tLtcTimeCode.nHours != sent.nHours) || (LtcDecoder::IsDropFrame(pBits) != s_bDropFrame)) {
+		s_nWrong++;
+	}
+
+	s_bPassed[s_nSending] = true;
+	s_nCallbacks++;
+}
+
+static LtcDecoder s_LtcDecoder(frame_handler);
+
+static void next(TLtcTimeCode& tc, uint32_t nFps, bool bDropFrame) {
+	if (++tc.nFrames < nFps) {
+		return;
+	}
+	tc.nFrames = 0;
+	if (++tc.nSeconds == 60) {
+		tc.nSeconds = 0;
+		if (++tc.nMinutes == 60) {
+			tc.nMinutes = 0;
+			tc.nHours = static_cast<uint8_t>((tc.nHours + 1) % 24);
+		}
+		// Drop frame: frames 0 and 1 are skipped at the start of each minute, not every tenth minute
+		if (bDropFrame && ((tc.nMinutes % 10) != 0)) {
+			tc.nFrames = 2;
+		}
+	}
+}
+
+static void encode(const TLtcTimeCode& tc, bool bDropFrame, uint8_t *pBits) {
+	memset(pBits, 0, 80);
+
+	auto bcd = [&](uint32_t nValue, uint32_t nUnitsBit, uint32_t nTensBit, uint32_t nTensBits) {
+		for (uint32_t i = 0; i < 4; i++) {
+			pBits[nUnitsBit + i] = static_cast<uint8_t>(((nValue % 10) >> i) & 1);
+		}
+		for (uint32_t i = 0; i < nTensBits; i++) {
+			pBits[nTensBit + i] = static_cast<uint8_t>(((nValue / 10) >> i) & 1);
+		}
+	};
+
+	bcd(tc.nFrames, 0, 8, 2);
+	bcd(tc.nSeconds, 16, 24, 3);
+	bcd(tc.nMinutes, 32, 40, 3);
+	bcd(tc.nHours, 48, 56, 2);
+	pBits[10] = bDropFrame ? 1 : 0;
+
+	static constexpr uint8_t SYNC[16] = { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1 };
+	memcpy(&pBits[64], SYNC, sizeof(SYNC));
+}
+
+static uint32_t jitter(uint32_t nMicros) {
+	const auto nRange = (nMicros * JITTER_PERCENT) / 100;
+	return nMicros - nRange + static_cast<uint32_t>(rand()) % (2 * nRange + 1);
+}
+
+/*
+ * nStartHalfBit: the signal starts at this half bit of the first frame
+ */
+static void run(const char *pName, uint32_t nFps, bool bDropFrame, uint32_t nStartHalfBit, bool bExact) {
+	const auto nBitMicros = 1000000 / (nFps * 80);
+
+	s_nCallbacks = 0;
+	s_nWrong = 0;
+	s_bDropFrame = bDropFrame;
+	memset(s_bPassed, 0, sizeof(s_bPassed));
+
+	TLtcTimeCode tc = { 0, 59, 10, 1, 0 };	// 01:10:59:00, the run counts into minute 11
+
+	for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+		s_Sent[nFrame] = tc;
+		next(tc, nFps, bDropFrame);
+	}
+
+	s_LtcDecoder.Edge(0);	// The first edge after power on, no previous edge
+
+	for (s_nSending = 0; s_nSending < FRAMES; s_nSending++) {
+		uint8_t aBits[80];
+		encode(s_Sent[s_nSending], bDropFrame, aBits);
+
+		for (uint32_t nBit = 0; nBit < 80; nBit++) {
+			if ((s_nSending == DROP_OUT_FRAME) && (nBit == DROP_OUT_BIT)) {
+				s_LtcDecoder.Edge(DROP_OUT_MICROS);
+			}
+
+			const auto nHalfBit = nBit * 2;
+
+			if (aBits[nBit] == 0) {
+				if ((s_nSending != 0) || (nHalfBit >= nStartHalfBit)) {
+					s_LtcDecoder.Edge(jitter(nBitMicros));
+				}
+			} else {
+				if ((s_nSending != 0) || (nHalfBit >= nStartHalfBit)) {
+					s_LtcDecoder.Edge(jitter(nBitMicros / 2));
+				}
+				if ((s_nSending != 0) || (nHalfBit + 1 >= nStartHalfBit)) {
+					s_LtcDecoder.Edge(jitter(nBitMicros / 2));
+				}
+			}
+		}
+	}
+
+	auto bPassed = (s_nWrong == 0) && !s_bPassed[0] && !s_bPassed[DROP_OUT_FRAME];
+
+	if (bExact) {
+		// Frame 0 is not complete, the frame with the drop out is corrupt, all others are passed
+		bPassed = bPassed && (s_nCallbacks == FRAMES - 2);
+	} else {
+		// Starting within a bit, the first complete frame can be needed to lock
+		bPassed = bPassed && (s_nCallbacks >= FRAMES - 3) && s_bPassed[DROP_OUT_FRAME + 1];
+	}
+
+	result(pName, bPassed);
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+
+	run("Film, start at bit 37", 24, false, 2 * 37, true);
+	run("EBU, start at bit 37", 25, false, 2 * 37, true);
+	run("DF, start at bit 37", 30, true, 2 * 37, true);
+	run("SMPTE, start at bit 37", 30, false, 2 * 37, true);
+
+	char aName[32];
+
+	for (uint32_t nHalfBit = 1; nHalfBit < 160; nHalfBit += 7) {
+		snprintf(aName, sizeof(aName), "EBU, start at half bit %u", nHalfBit);
+		run(aName, 25, false, nHalfBit, false);
+		snprintf(aName, sizeof(aName), "DF, start at half bit %u", nHalfBit);
+		run(aName, 30, true, nHalfBit, false);
+	}
+
+	printf("%s\n", s_nFailed == 0 ? "All passed" : "Failed");
+	return s_nFailed == 0 ? 0 : 1;
+}
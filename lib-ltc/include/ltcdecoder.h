@@ -0,0 +1,143 @@
+/**
+ * @file ltcdecoder.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LTCDECODER_H_
+#define LTCDECODER_H_
+
+#include <stdint.h>
+
+#include "ltc.h"
+
+namespace ltc {
+namespace decoder {
+static constexpr uint32_t ONE_TIME_MIN = 150;	///< 417us/2 = 208us
+static constexpr uint32_t ZERO_TIME_MIN = 380;	///< 30 FPS * 80 bits = 2400Hz, 1E6/2400Hz = 417us
+static constexpr uint32_t ZERO_TIME_MAX = 600;	///< 24 FPS * 80 bits = 1920Hz, 1E6/1920Hz = 521us
+static constexpr uint32_t END_DATA_POSITION = 63;
+static constexpr uint32_t END_SYNC_POSITION = 77;
+static constexpr uint32_t END_SMPTE_POSITION = 80;
+static constexpr uint32_t BITS_BYTES = 8;
+}  // namespace decoder
+}  // namespace ltc
+
+/**
+ * SMPTE LTC bi-phase mark decoder, shared by the LTC inputs.
+ * Edge() is called from the FIQ with the time between two edges of the input signal.
+ * After the sync word of each frame the callback gets the 64 data bits as 8 bytes, bit 0 first.
+ * The first frame after the start or after an invalid edge is not passed, its data bits are not aligned.
+ * The callback runs in the FIQ as well.
+ */
+class LtcDecoder {
+public:
+	typedef void (*FrameCallback)(const uint8_t *pBits);
+
+	constexpr LtcDecoder(FrameCallback frameCallback): m_FrameCallback(frameCallback) {
+	}
+
+	void Edge(uint32_t nBitTime) {
+		if ((nBitTime < ltc::decoder::ONE_TIME_MIN) || (nBitTime > ltc::decoder::ZERO_TIME_MAX)) {
+			m_nTotalBits = 0;
+			m_bLocked = false;
+			return;
+		}
+
+		if (m_bOnesBitCount) {
+			m_bOnesBitCount = false;
+			return;
+		}
+
+		uint32_t nCurrentBit;
+
+		if (nBitTime > ltc::decoder::ZERO_TIME_MIN) {
+			nCurrentBit = 0;
+			m_nSyncCount = 0;
+		} else {
+			nCurrentBit = 1;
+			m_bOnesBitCount = true;
+			m_nSyncCount++;
+
+			if (m_nSyncCount == 12) {
+				m_nSyncCount = 0;
+				m_bTimeCodeSync = true;
+				m_nTotalBits = ltc::decoder::END_SYNC_POSITION;
+			}
+		}
+
+		if (m_nTotalBits <= ltc::decoder::END_DATA_POSITION) {
+			m_aBits[0] = static_cast<uint8_t>(m_aBits[0] >> 1);
+
+			for (uint32_t n = 1; n < ltc::decoder::BITS_BYTES; n++) {
+				if (m_aBits[n] & 1) {
+					m_aBits[n - 1] = static_cast<uint8_t>(m_aBits[n - 1] | 0x80);
+				}
+				m_aBits[n] = static_cast<uint8_t>(m_aBits[n] >> 1);
+			}
+
+			if (nCurrentBit == 1) {
+				m_aBits[7] = static_cast<uint8_t>(m_aBits[7] | 0x80);
+			}
+		}
+
+		m_nTotalBits++;
+
+		if (m_nTotalBits == ltc::decoder::END_SMPTE_POSITION) {
+			m_nTotalBits = 0;
+
+			if (m_bTimeCodeSync) {
+				m_bTimeCodeSync = false;
+
+				if (m_bLocked) {
+					m_FrameCallback(m_aBits);
+				}
+
+				m_bLocked = true;
+			} else {
+				m_bLocked = false;
+			}
+		}
+	}
+
+	static void GetTimeCode(const uint8_t *pBits, struct TLtcTimeCode& tLtcTimeCode) {
+		tLtcTimeCode.nFrames = static_cast<uint8_t>((10 * (pBits[1] & 0x03)) + (pBits[0] & 0x0F));
+		tLtcTimeCode.nSeconds = static_cast<uint8_t>((10 * (pBits[3] & 0x07)) + (pBits[2] & 0x0F));
+		tLtcTimeCode.nMinutes = static_cast<uint8_t>((10 * (pBits[5] & 0x07)) + (pBits[4] & 0x0F));
+		tLtcTimeCode.nHours = static_cast<uint8_t>((10 * (pBits[7] & 0x03)) + (pBits[6] & 0x0F));
+	}
+
+	static bool IsDropFrame(const uint8_t *pBits) {
+		return (pBits[1] & (1U << 2)) != 0;
+	}
+
+private:
+	FrameCallback m_FrameCallback;
+	uint32_t m_nTotalBits { 0 };
+	uint32_t m_nSyncCount { 0 };
+	uint8_t m_aBits[ltc::decoder::BITS_BYTES] __attribute__((aligned(4))) { 0, 0, 0, 0, 0, 0, 0, 0 };
+	bool m_bOnesBitCount { false };
+	bool m_bTimeCodeSync { false };
+	bool m_bLocked { false };
+};
+
+#endif /* LTCDECODER_H_ */
@@ -26,49 +26,49 @@
 #define LTCPARAMSCONST_H_
 
 struct LtcParamsConst {
-	static const char FILE_NAME[];
+	static constexpr char FILE_NAME[] = "ltc.txt";
 
-	static const char SOURCE[];
+	static constexpr char SOURCE[] = "source";
 	// System time
-	static const char AUTO_START[];
+	static constexpr char AUTO_START[] = "auto_start";
 	// Output options
-	static const char DISABLE_DISPLAY[];
-	static const char DISABLE_MAX7219[];
-	static const char DISABLE_MIDI[];
-	static const char DISABLE_ARTNET[];
-	static const char DISABLE_LTC[];
-	static const char DISABLE_RTPMIDI[];
-	static const char SHOW_SYSTIME[];
-	static const char DISABLE_TIMESYNC[];
+	static constexpr char DISABLE_DISPLAY[] = "disable_display";
+	static constexpr char DISABLE_MAX7219[] = "disable_max7219";
+	static constexpr char DISABLE_MIDI[] = "disable_midi";
+	static constexpr char DISABLE_ARTNET[] = "disable_artnet";
+	static constexpr char DISABLE_LTC[] = "disable_ltc";
+	static constexpr char DISABLE_RTPMIDI[] = "disable_rtp-midi";
+	static constexpr char SHOW_SYSTIME[] = "show_systime";
+	static constexpr char DISABLE_TIMESYNC[] = "disable_timesync";
 	// NTP
-	static const char YEAR[];
-	static const char MONTH[];
-	static const char DAY[];
-	static const char NTP_ENABLE[];
+	static constexpr char YEAR[] = "year";
+	static constexpr char MONTH[] = "month";
+	static constexpr char DAY[] = "day";
+	static constexpr char NTP_ENABLE[] = "ntp_enable";
 	// LTC
-	static const char VOLUME[];
+	static constexpr char VOLUME[] = "volume";
 	// Art-Net
-	static const char TIMECODE_IP[];
+	static constexpr char TIMECODE_IP[] = "timecode_ip";
 	// Generator
-	static const char FPS[];
-	static const char START_FRAME[];
-	static const char START_SECOND[];
-	static const char START_MINUTE[];
-	static const char START_HOUR[];
-	static const char STOP_FRAME[];
-	static const char STOP_SECOND[];
-	static const char STOP_MINUTE[];
-	static const char STOP_HOUR[];
-	static const char ALT_FUNCTION[];
-	static const char SKIP_SECONDS[];
-	static const char SKIP_FREE[];
+	static constexpr char FPS[] = "fps";
+	static constexpr char START_FRAME[] = "start_frame";
+	static constexpr char START_SECOND[] = "start_second";
+	static constexpr char START_MINUTE[] = "start_minute";
+	static constexpr char START_HOUR[] = "start_hour";
+	static constexpr char STOP_FRAME[] = "stop_frame";
+	static constexpr char STOP_SECOND[] = "stop_second";
+	static constexpr char STOP_MINUTE[] = "stop_minute";
+	static constexpr char STOP_HOUR[] = "stop_hour";
+	static constexpr char ALT_FUNCTION[] = "alt_function";
+	static constexpr char SKIP_SECONDS[] = "skip_seconds";
+	static constexpr char SKIP_FREE[] = "skip_free";
 	// OSC
-	static const char OSC_ENABLE[];
-	static const char OSC_PORT[];
+	static constexpr char OSC_ENABLE[] = "osc_enable";
+	static constexpr char OSC_PORT[] = "osc_port";
 	// WS28xx Display
-	static const char WS28XX_ENABLE[];
+	static constexpr char WS28XX_ENABLE[] = "ws28xx_enable";
 	// RGB led panel
-	static const char RGBPANEL_ENABLE[];
+	static constexpr char RGBPANEL_ENABLE[] = "rgbpanel_enable";
 };
 
 #endif /* LTCPARAMSCONST_H_ */
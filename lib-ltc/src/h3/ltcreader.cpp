@@ -32,6 +32,7 @@
 
 #include "h3/ltcreader.h"
 #include "ltc.h"
+#include "ltcdecoder.h"
 #include "timecodeconst.h"
 
 #include "h3.h"
@@ -61,32 +62,13 @@
  #define ALIGNED __attribute__ ((aligned (4)))
 #endif
 
-#define ONE_TIME_MIN        150	///< 417us/2 = 208us
-#define ONE_TIME_MAX       	300	///< 521us/2 = 260us
-#define ZERO_TIME_MIN      	380	///< 30 FPS * 80 bits = 2400Hz, 1E6/2400Hz = 417us
-#define ZERO_TIME_MAX      	600	///< 24 FPS * 80 bits = 1920Hz, 1E6/1920Hz = 521us
-
-#define END_DATA_POSITION	63
-#define END_SYNC_POSITION	77
-#define END_SMPTE_POSITION	80
-
 static volatile char aTimeCode[TC_CODE_MAX_LENGTH] ALIGNED;
 
 static volatile bool IsMidiQuarterFrameMessage = false;
 static uint32_t nMidiQuarterFramePiece = 0;
 
 static volatile uint32_t nFiqUsPrevious = 0;
-static volatile uint32_t nFiqUsCurrent = 0;
-
-static volatile uint32_t nBitTime = 0;
-static volatile uint32_t nTotalBits = 0;
-static volatile bool bOnesBitCount = false;
-static volatile uint32_t nCurrentBit = 0;
-static volatile uint32_t nSyncCount = 0;
-static volatile bool bTimeCodeSync = false;
-static volatile bool bTimeCodeValid = false;
 
-static volatile uint8_t aTimeCodeBits[8] ALIGNED;
 static volatile bool bIsDropFrameFlagSet = false;
 
 static volatile bool bTimeCodeAvailable = false;
@@ -97,87 +79,41 @@ static volatile uint32_t nUpdatesPerSecond = 0;
 static volatile uint32_t nUpdatesPrevious = 0;
 static volatile uint32_t nUpdates = 0;
 
-static void __attribute__((interrupt("FIQ"))) fiq_handler() {
-	dmb();
-
-	nFiqUsCurrent = h3_hs_timer_lo_us();
-
-	H3_PIO_PA_INT->STA = static_cast<uint32_t>(~0x0);
-
-	nBitTime = nFiqUsCurrent - nFiqUsPrevious;
-
-	if ((nBitTime < ONE_TIME_MIN) || (nBitTime > ZERO_TIME_MAX)) {
-		nTotalBits = 0;
-	} else {
-		if (bOnesBitCount) {
-			bOnesBitCount = false;
-		} else {
-			if (nBitTime > ZERO_TIME_MIN) {
-				nCurrentBit = 0;
-				nSyncCount = 0;
-			} else {
-				nCurrentBit = 1;
-				bOnesBitCount = true;
-				nSyncCount++;
-
-				if (nSyncCount == 12) {
-					nSyncCount = 0;
-					bTimeCodeSync = true;
-					nTotalBits = END_SYNC_POSITION;
-				}
-			}
-
-			if (nTotalBits <= END_DATA_POSITION) {
-				aTimeCodeBits[0] = aTimeCodeBits[0] >> 1;
-				for (uint32_t n = 1; n < 8; n++) {
-					if (aTimeCodeBits[n] & 1) {
-						aTimeCodeBits[n - 1] |= 0x80;
-					}
-					aTimeCodeBits[n] = aTimeCodeBits[n] >> 1;
-				}
-
-				if (nCurrentBit == 1) {
-					aTimeCodeBits[7] |= 0x80;
-				}
-			}
+static void frame_handler(const uint8_t *pBits) {
+	nUpdates++;
 
-			nTotalBits++;
-		}
+	struct TLtcTimeCode tLtcTimeCode;
+	LtcDecoder::GetTimeCode(pBits, tLtcTimeCode);
 
-		if (nTotalBits == END_SMPTE_POSITION) {
+	s_tMidiTimeCode.nFrames  = tLtcTimeCode.nFrames;
+	s_tMidiTimeCode.nSeconds = tLtcTimeCode.nSeconds;
+	s_tMidiTimeCode.nMinutes = tLtcTimeCode.nMinutes;
+	s_tMidiTimeCode.nHours   = tLtcTimeCode.nHours;
 
-			nTotalBits = 0;
+	aTimeCode[10] = (pBits[0] & 0x0F) + '0';	// frames
+	aTimeCode[9]  = (pBits[1] & 0x03) + '0';	// 10's of frames
+	aTimeCode[7]  = (pBits[2] & 0x0F) + '0';	// seconds
+	aTimeCode[6]  = (pBits[3] & 0x07) + '0';	// 10's of seconds
+	aTimeCode[4]  = (pBits[4] & 0x0F) + '0';	// minutes
+	aTimeCode[3]  = (pBits[5] & 0x07) + '0';	// 10's of minutes
+	aTimeCode[1]  = (pBits[6] & 0x0F) + '0';	// hours
+	aTimeCode[0]  = (pBits[7] & 0x03) + '0';	// 10's of hours
 
-			if (bTimeCodeSync) {
-				bTimeCodeSync = false;
-				bTimeCodeValid = true;
-			}
-		}
+	bIsDropFrameFlagSet = LtcDecoder::IsDropFrame(pBits);
 
-		if (bTimeCodeValid) {
-			nUpdates++;
+	bTimeCodeAvailable = true;
+}
 
-			bTimeCodeValid = false;
+static LtcDecoder s_LtcDecoder(frame_handler);
 
-			s_tMidiTimeCode.nFrames  = (10 * (aTimeCodeBits[1] & 0x03)) + (aTimeCodeBits[0] & 0x0F);
-			s_tMidiTimeCode.nSeconds = (10 * (aTimeCodeBits[3] & 0x07)) + (aTimeCodeBits[2] & 0x0F);
-			s_tMidiTimeCode.nMinutes = (10 * (aTimeCodeBits[5] & 0x07)) + (aTimeCodeBits[4] & 0x0F);
-			s_tMidiTimeCode.nHours   = (10 * (aTimeCodeBits[7] & 0x03)) + (aTimeCodeBits[6] & 0x0F);
+static void __attribute__((interrupt("FIQ"))) fiq_handler() {
+	dmb();
 
-			aTimeCode[10] = (aTimeCodeBits[0] & 0x0F) + '0';	// frames
-			aTimeCode[9]  = (aTimeCodeBits[1] & 0x03) + '0';	// 10's of frames
-			aTimeCode[7]  = (aTimeCodeBits[2] & 0x0F) + '0';	// seconds
-			aTimeCode[6]  = (aTimeCodeBits[3] & 0x07) + '0';	// 10's of seconds
-			aTimeCode[4]  = (aTimeCodeBits[4] & 0x0F) + '0';	// minutes
-			aTimeCode[3]  = (aTimeCodeBits[5] & 0x07) + '0';	// 10's of minutes
-			aTimeCode[1]  = (aTimeCodeBits[6] & 0x0F) + '0';	// hours
-			aTimeCode[0]  = (aTimeCodeBits[7] & 0x03) + '0';	// 10's of hours
+	const uint32_t nFiqUsCurrent = h3_hs_timer_lo_us();
 
-			bIsDropFrameFlagSet = (aTimeCodeBits[1] & (1 << 2));
+	H3_PIO_PA_INT->STA = static_cast<uint32_t>(~0x0);
 
-			bTimeCodeAvailable = true;
-		}
-	}
+	s_LtcDecoder.Edge(nFiqUsCurrent - nFiqUsPrevious);
 
 	nFiqUsPrevious = nFiqUsCurrent;
 
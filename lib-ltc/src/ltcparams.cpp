@@ -40,6 +40,7 @@
 #include "readconfigfile.h"
 #include "sscan.h"
 #include "propertiesbuilder.h"
+#include "propertieskey.h"
 
 #include "debug.h"
 
@@ -143,187 +144,197 @@ void LtcParams::callbackFunction(const char* pLine) {
 
 	uint8_t nValue8;
 	uint16_t nValue16;
+	uint32_t nValue32;
 	char source[16];
-	uint32_t nLength = sizeof(source) - 1;
-
-	if (Sscan::Char(pLine, LtcParamsConst::SOURCE, source, nLength) == Sscan::OK) {
-		source[nLength] = '\0';
-		m_tLtcParams.tSource = GetSourceType(source);
-		m_tLtcParams.nSetList |= LtcParamsMask::SOURCE;
+	uint32_t nLength;
+
+	switch (properties::key(pLine)) {
+	case properties::hash(LtcParamsConst::SOURCE):
+		nLength = sizeof(source) - 1;
+		if (Sscan::Char(pLine, LtcParamsConst::SOURCE, source, nLength) == Sscan::OK) {
+			source[nLength] = '\0';
+			m_tLtcParams.tSource = GetSourceType(source);
+			m_tLtcParams.nSetList |= LtcParamsMask::SOURCE;
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::VOLUME, nValue8) == Sscan::OK) {
-		if ((nValue8 > 1) && (nValue8 < 32)) {
-			m_tLtcParams.nVolume = nValue8;
-			m_tLtcParams.nSetList |= LtcParamsMask::VOLUME;
-		} else {
-			m_tLtcParams.nVolume = VOLUME_0DBV;
-			m_tLtcParams.nSetList &= ~LtcParamsMask::VOLUME;
+	case properties::hash(LtcParamsConst::VOLUME):
+		if (Sscan::Uint8(pLine, LtcParamsConst::VOLUME, nValue8) == Sscan::OK) {
+			if ((nValue8 > 1) && (nValue8 < 32)) {
+				m_tLtcParams.nVolume = nValue8;
+				m_tLtcParams.nSetList |= LtcParamsMask::VOLUME;
+			} else {
+				m_tLtcParams.nVolume = VOLUME_0DBV;
+				m_tLtcParams.nSetList &= ~LtcParamsMask::VOLUME;
+			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::AUTO_START, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nAutoStart, LtcParamsMask::AUTO_START);
+	case properties::hash(LtcParamsConst::AUTO_START):
+		if (Sscan::Uint8(pLine, LtcParamsConst::AUTO_START, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nAutoStart, LtcParamsMask::AUTO_START);
+		}
 		return;
-	}
-
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_DISPLAY, LtcParamsMaskDisabledOutputs::DISPLAY);
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_MAX7219, LtcParamsMaskDisabledOutputs::MAX7219);
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_LTC, LtcParamsMaskDisabledOutputs::LTC);
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_MIDI, LtcParamsMaskDisabledOutputs::MIDI);
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_ARTNET, LtcParamsMaskDisabledOutputs::ARTNET);
-	HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_RTPMIDI, LtcParamsMaskDisabledOutputs::RTPMIDI);
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::SHOW_SYSTIME, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nShowSysTime, LtcParamsMask::SHOW_SYSTIME);
+	case properties::hash(LtcParamsConst::DISABLE_DISPLAY):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_DISPLAY, LtcParamsMaskDisabledOutputs::DISPLAY);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::DISABLE_TIMESYNC, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nDisableTimeSync, LtcParamsMask::DISABLE_TIMESYNC);
+	case properties::hash(LtcParamsConst::DISABLE_MAX7219):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_MAX7219, LtcParamsMaskDisabledOutputs::MAX7219);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::YEAR, nValue8) == Sscan::OK) {
-		SetValue((nValue8 >= 19), nValue8, m_tLtcParams.nYear, LtcParamsMask::YEAR);
+	case properties::hash(LtcParamsConst::DISABLE_LTC):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_LTC, LtcParamsMaskDisabledOutputs::LTC);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::MONTH, nValue8) == Sscan::OK) {
-		SetValue((nValue8 >= 1) && (nValue8 <= 12), nValue8, m_tLtcParams.nMonth, LtcParamsMask::MONTH);
+	case properties::hash(LtcParamsConst::DISABLE_MIDI):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_MIDI, LtcParamsMaskDisabledOutputs::MIDI);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::DAY, nValue8) == Sscan::OK) {
-		SetValue((nValue8 >= 1) && (nValue8 <= 31), nValue8, m_tLtcParams.nDay, LtcParamsMask::DAY);
+	case properties::hash(LtcParamsConst::DISABLE_ARTNET):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_ARTNET, LtcParamsMaskDisabledOutputs::ARTNET);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::NTP_ENABLE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nEnableNtp, LtcParamsMask::ENABLE_NTP);
+	case properties::hash(LtcParamsConst::DISABLE_RTPMIDI):
+		HandleDisabledOutput(pLine, LtcParamsConst::DISABLE_RTPMIDI, LtcParamsMaskDisabledOutputs::RTPMIDI);
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::FPS, nValue8) == Sscan::OK) {
-		SetValue((nValue8 >= 24) && (nValue8 <= 30), nValue8, m_tLtcParams.nFps, LtcParamsMask::FPS);
+	case properties::hash(LtcParamsConst::SHOW_SYSTIME):
+		if (Sscan::Uint8(pLine, LtcParamsConst::SHOW_SYSTIME, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nShowSysTime, LtcParamsMask::SHOW_SYSTIME);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::START_FRAME, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 30), nValue8, m_tLtcParams.nStartFrame, LtcParamsMask::START_FRAME);
+	case properties::hash(LtcParamsConst::DISABLE_TIMESYNC):
+		if (Sscan::Uint8(pLine, LtcParamsConst::DISABLE_TIMESYNC, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nDisableTimeSync, LtcParamsMask::DISABLE_TIMESYNC);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::START_SECOND, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStartSecond, LtcParamsMask::START_SECOND);
+	case properties::hash(LtcParamsConst::YEAR):
+		if (Sscan::Uint8(pLine, LtcParamsConst::YEAR, nValue8) == Sscan::OK) {
+			SetValue((nValue8 >= 19), nValue8, m_tLtcParams.nYear, LtcParamsMask::YEAR);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::START_MINUTE, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStartMinute, LtcParamsMask::START_MINUTE);
+	case properties::hash(LtcParamsConst::MONTH):
+		if (Sscan::Uint8(pLine, LtcParamsConst::MONTH, nValue8) == Sscan::OK) {
+			SetValue((nValue8 >= 1) && (nValue8 <= 12), nValue8, m_tLtcParams.nMonth, LtcParamsMask::MONTH);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::START_HOUR, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 23), nValue8, m_tLtcParams.nStartHour, LtcParamsMask::START_HOUR);
+	case properties::hash(LtcParamsConst::DAY):
+		if (Sscan::Uint8(pLine, LtcParamsConst::DAY, nValue8) == Sscan::OK) {
+			SetValue((nValue8 >= 1) && (nValue8 <= 31), nValue8, m_tLtcParams.nDay, LtcParamsMask::DAY);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::STOP_FRAME, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 30), nValue8, m_tLtcParams.nStopFrame, LtcParamsMask::STOP_FRAME);
+	case properties::hash(LtcParamsConst::NTP_ENABLE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::NTP_ENABLE, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nEnableNtp, LtcParamsMask::ENABLE_NTP);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::STOP_SECOND, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStopSecond, LtcParamsMask::STOP_SECOND);
+	case properties::hash(LtcParamsConst::FPS):
+		if (Sscan::Uint8(pLine, LtcParamsConst::FPS, nValue8) == Sscan::OK) {
+			SetValue((nValue8 >= 24) && (nValue8 <= 30), nValue8, m_tLtcParams.nFps, LtcParamsMask::FPS);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::STOP_MINUTE, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStopMinute, LtcParamsMask::STOP_MINUTE);
+	case properties::hash(LtcParamsConst::START_FRAME):
+		if (Sscan::Uint8(pLine, LtcParamsConst::START_FRAME, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 30), nValue8, m_tLtcParams.nStartFrame, LtcParamsMask::START_FRAME);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::STOP_HOUR, nValue8) == Sscan::OK) {
-		SetValue((nValue8 <= 23), nValue8, m_tLtcParams.nStopHour, LtcParamsMask::STOP_HOUR);
+	case properties::hash(LtcParamsConst::START_SECOND):
+		if (Sscan::Uint8(pLine, LtcParamsConst::START_SECOND, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStartSecond, LtcParamsMask::START_SECOND);
+		}
 		return;
-	}
-
-#if 0
-	if (Sscan::Uint8(pLine, LtcParamsConst::SET_DATE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nSetDate, LtcParamsMask::SET_DATE);
-	}
-#endif
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::ALT_FUNCTION, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nAltFunction, LtcParamsMask::ALT_FUNCTION);
+	case properties::hash(LtcParamsConst::START_MINUTE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::START_MINUTE, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStartMinute, LtcParamsMask::START_MINUTE);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::SKIP_SECONDS, nValue8) == Sscan::OK) {
-		SetValue((nValue8 > 0) && (nValue8 <= 99), nValue8, m_tLtcParams.nSkipSeconds, LtcParamsMask::SKIP_SECONDS);
+	case properties::hash(LtcParamsConst::START_HOUR):
+		if (Sscan::Uint8(pLine, LtcParamsConst::START_HOUR, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 23), nValue8, m_tLtcParams.nStartHour, LtcParamsMask::START_HOUR);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::SKIP_FREE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nSkipFree, LtcParamsMask::SKIP_FREE);
+	case properties::hash(LtcParamsConst::STOP_FRAME):
+		if (Sscan::Uint8(pLine, LtcParamsConst::STOP_FRAME, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 30), nValue8, m_tLtcParams.nStopFrame, LtcParamsMask::STOP_FRAME);
+		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::OSC_ENABLE, nValue8) == Sscan::OK) {
-		SetBool(nValue8, m_tLtcParams.nEnableOsc, LtcParamsMask::ENABLE_OSC);
+	case properties::hash(LtcParamsConst::STOP_SECOND):
+		if (Sscan::Uint8(pLine, LtcParamsConst::STOP_SECOND, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStopSecond, LtcParamsMask::STOP_SECOND);
+		}
 		return;
-	}
-
-	if (Sscan::Uint16(pLine, LtcParamsConst::OSC_PORT, nValue16) == Sscan::OK) {
-		if (nValue16 > 1023) {
-			m_tLtcParams.nOscPort = nValue16;
-			m_tLtcParams.nSetList |= LtcParamsMask::OSC_PORT;
+	case properties::hash(LtcParamsConst::STOP_MINUTE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::STOP_MINUTE, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 59), nValue8, m_tLtcParams.nStopMinute, LtcParamsMask::STOP_MINUTE);
 		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::WS28XX_ENABLE, nValue8) == Sscan::OK) {
-		if (nValue8 != 0) {
-			m_tLtcParams.nRgbLedType = static_cast<uint8_t>(TLtcParamsRgbLedType::WS28XX);
-			m_tLtcParams.nSetList |= LtcParamsMask::RGBLEDTYPE;
-		} else {
-			m_tLtcParams.nRgbLedType &= ~static_cast<uint8_t>(TLtcParamsRgbLedType::WS28XX);
-
-			if (m_tLtcParams.nRgbLedType == 0) {
-				m_tLtcParams.nSetList &= ~LtcParamsMask::RGBLEDTYPE;
+	case properties::hash(LtcParamsConst::STOP_HOUR):
+		if (Sscan::Uint8(pLine, LtcParamsConst::STOP_HOUR, nValue8) == Sscan::OK) {
+			SetValue((nValue8 <= 23), nValue8, m_tLtcParams.nStopHour, LtcParamsMask::STOP_HOUR);
+		}
+		return;
+	case properties::hash(LtcParamsConst::ALT_FUNCTION):
+		if (Sscan::Uint8(pLine, LtcParamsConst::ALT_FUNCTION, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nAltFunction, LtcParamsMask::ALT_FUNCTION);
+		}
+		return;
+	case properties::hash(LtcParamsConst::SKIP_SECONDS):
+		if (Sscan::Uint8(pLine, LtcParamsConst::SKIP_SECONDS, nValue8) == Sscan::OK) {
+			SetValue((nValue8 > 0) && (nValue8 <= 99), nValue8, m_tLtcParams.nSkipSeconds, LtcParamsMask::SKIP_SECONDS);
+		}
+		return;
+	case properties::hash(LtcParamsConst::SKIP_FREE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::SKIP_FREE, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nSkipFree, LtcParamsMask::SKIP_FREE);
+		}
+		return;
+	case properties::hash(LtcParamsConst::OSC_ENABLE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::OSC_ENABLE, nValue8) == Sscan::OK) {
+			SetBool(nValue8, m_tLtcParams.nEnableOsc, LtcParamsMask::ENABLE_OSC);
+		}
+		return;
+	case properties::hash(LtcParamsConst::OSC_PORT):
+		if (Sscan::Uint16(pLine, LtcParamsConst::OSC_PORT, nValue16) == Sscan::OK) {
+			if (nValue16 > 1023) {
+				m_tLtcParams.nOscPort = nValue16;
+				m_tLtcParams.nSetList |= LtcParamsMask::OSC_PORT;
 			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, LtcParamsConst::RGBPANEL_ENABLE, nValue8) == Sscan::OK) {
-		if (nValue8 != 0) {
-			m_tLtcParams.nRgbLedType = static_cast<uint8_t>(TLtcParamsRgbLedType::RGBPANEL);
-			m_tLtcParams.nSetList |= LtcParamsMask::RGBLEDTYPE;
-		} else {
-			m_tLtcParams.nRgbLedType &= ~static_cast<uint8_t>(TLtcParamsRgbLedType::RGBPANEL);
-
-			if (m_tLtcParams.nRgbLedType == 0) {
-				m_tLtcParams.nSetList &= ~LtcParamsMask::RGBLEDTYPE;
+	case properties::hash(LtcParamsConst::WS28XX_ENABLE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::WS28XX_ENABLE, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tLtcParams.nRgbLedType = static_cast<uint8_t>(TLtcParamsRgbLedType::WS28XX);
+				m_tLtcParams.nSetList |= LtcParamsMask::RGBLEDTYPE;
+			} else {
+				m_tLtcParams.nRgbLedType &= static_cast<uint8_t>(~static_cast<uint8_t>(TLtcParamsRgbLedType::WS28XX));
+
+				if (m_tLtcParams.nRgbLedType == 0) {
+					m_tLtcParams.nSetList &= ~LtcParamsMask::RGBLEDTYPE;
+				}
 			}
 		}
 		return;
-	}
-
-	uint32_t nValue32;
-
-	if (Sscan::IpAddress(pLine, LtcParamsConst::TIMECODE_IP, nValue32) == Sscan::OK) {
-		if (Network::Get()->IsValidIp(nValue32)) {
-			m_tLtcParams.nSetList |= LtcParamsMask::TIMECODE_IP;
-			m_tLtcParams.nTimeCodeIp = nValue32;
-		} else {
-			m_tLtcParams.nSetList &= ~LtcParamsMask::TIMECODE_IP;
-			m_tLtcParams.nTimeCodeIp = Network::Get()->GetBroadcastIp();
+	case properties::hash(LtcParamsConst::RGBPANEL_ENABLE):
+		if (Sscan::Uint8(pLine, LtcParamsConst::RGBPANEL_ENABLE, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tLtcParams.nRgbLedType = static_cast<uint8_t>(TLtcParamsRgbLedType::RGBPANEL);
+				m_tLtcParams.nSetList |= LtcParamsMask::RGBLEDTYPE;
+			} else {
+				m_tLtcParams.nRgbLedType &= static_cast<uint8_t>(~static_cast<uint8_t>(TLtcParamsRgbLedType::RGBPANEL));
+
+				if (m_tLtcParams.nRgbLedType == 0) {
+					m_tLtcParams.nSetList &= ~LtcParamsMask::RGBLEDTYPE;
+				}
+			}
+		}
+		return;
+	case properties::hash(LtcParamsConst::TIMECODE_IP):
+		if (Sscan::IpAddress(pLine, LtcParamsConst::TIMECODE_IP, nValue32) == Sscan::OK) {
+			if (Network::Get()->IsValidIp(nValue32)) {
+				m_tLtcParams.nSetList |= LtcParamsMask::TIMECODE_IP;
+				m_tLtcParams.nTimeCodeIp = nValue32;
+			} else {
+				m_tLtcParams.nSetList &= ~LtcParamsMask::TIMECODE_IP;
+				m_tLtcParams.nTimeCodeIp = Network::Get()->GetBroadcastIp();
+			}
 		}
 		return;
+	default:
+		return;
 	}
 }
 
@@ -24,46 +24,46 @@
 
 #include "ltcparamsconst.h"
 
-const char LtcParamsConst::FILE_NAME[] = "ltc.txt";
+constexpr char LtcParamsConst::FILE_NAME[];
 
-const char LtcParamsConst::SOURCE[] = "source";
+constexpr char LtcParamsConst::SOURCE[];
 // System time
-const char LtcParamsConst::AUTO_START[] = "auto_start";
+constexpr char LtcParamsConst::AUTO_START[];
 // Output options
-const char LtcParamsConst::DISABLE_DISPLAY[] = "disable_display";
-const char LtcParamsConst::DISABLE_MAX7219[] = "disable_max7219";
-const char LtcParamsConst::DISABLE_MIDI[] = "disable_midi";
-const char LtcParamsConst::DISABLE_ARTNET[] = "disable_artnet";
-const char LtcParamsConst::DISABLE_LTC[] = "disable_ltc";
-const char LtcParamsConst::DISABLE_RTPMIDI[] = "disable_rtp-midi";
-const char LtcParamsConst::SHOW_SYSTIME[] = "show_systime";
-const char LtcParamsConst::DISABLE_TIMESYNC[] = "disable_timesync";
+constexpr char LtcParamsConst::DISABLE_DISPLAY[];
+constexpr char LtcParamsConst::DISABLE_MAX7219[];
+constexpr char LtcParamsConst::DISABLE_MIDI[];
+constexpr char LtcParamsConst::DISABLE_ARTNET[];
+constexpr char LtcParamsConst::DISABLE_LTC[];
+constexpr char LtcParamsConst::DISABLE_RTPMIDI[];
+constexpr char LtcParamsConst::SHOW_SYSTIME[];
+constexpr char LtcParamsConst::DISABLE_TIMESYNC[];
 // NTP
-const char LtcParamsConst::YEAR[] = "year";
-const char LtcParamsConst::MONTH[] = "month";
-const char LtcParamsConst::DAY[] = "day";
-const char LtcParamsConst::NTP_ENABLE[] = "ntp_enable";
+constexpr char LtcParamsConst::YEAR[];
+constexpr char LtcParamsConst::MONTH[];
+constexpr char LtcParamsConst::DAY[];
+constexpr char LtcParamsConst::NTP_ENABLE[];
 // LTC
-const char LtcParamsConst::VOLUME[] = "volume";
+constexpr char LtcParamsConst::VOLUME[];
 // Art-Net
-const char LtcParamsConst::TIMECODE_IP[] = "timecode_ip";
+constexpr char LtcParamsConst::TIMECODE_IP[];
 // Generator
-const char LtcParamsConst::FPS[] = "fps";
-const char LtcParamsConst::START_FRAME[] = "start_frame";
-const char LtcParamsConst::START_SECOND[] = "start_second";
-const char LtcParamsConst::START_MINUTE[] = "start_minute";
-const char LtcParamsConst::START_HOUR[] = "start_hour";
-const char LtcParamsConst::STOP_FRAME[] = "stop_frame";
-const char LtcParamsConst::STOP_SECOND[] = "stop_second";
-const char LtcParamsConst::STOP_MINUTE[] = "stop_minute";
-const char LtcParamsConst::STOP_HOUR[] = "stop_hour";
-const char LtcParamsConst::ALT_FUNCTION[] = "alt_function";
-const char LtcParamsConst::SKIP_SECONDS[] = "skip_seconds";
-const char LtcParamsConst::SKIP_FREE[] = "skip_free";
+constexpr char LtcParamsConst::FPS[];
+constexpr char LtcParamsConst::START_FRAME[];
+constexpr char LtcParamsConst::START_SECOND[];
+constexpr char LtcParamsConst::START_MINUTE[];
+constexpr char LtcParamsConst::START_HOUR[];
+constexpr char LtcParamsConst::STOP_FRAME[];
+constexpr char LtcParamsConst::STOP_SECOND[];
+constexpr char LtcParamsConst::STOP_MINUTE[];
+constexpr char LtcParamsConst::STOP_HOUR[];
+constexpr char LtcParamsConst::ALT_FUNCTION[];
+constexpr char LtcParamsConst::SKIP_SECONDS[];
+constexpr char LtcParamsConst::SKIP_FREE[];
 // OSC
-const char LtcParamsConst::OSC_ENABLE[] = "osc_enable";
-const char LtcParamsConst::OSC_PORT[] = "osc_port";
+constexpr char LtcParamsConst::OSC_ENABLE[];
+constexpr char LtcParamsConst::OSC_PORT[];
 // WS28xx Display
-const char LtcParamsConst::WS28XX_ENABLE[] = "ws28xx_enable";
+constexpr char LtcParamsConst::WS28XX_ENABLE[];
 // RGB led panel
-const char LtcParamsConst::RGBPANEL_ENABLE[] = "rgbpanel_enable";
+constexpr char LtcParamsConst::RGBPANEL_ENABLE[];
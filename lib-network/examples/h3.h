@@ -0,0 +1,52 @@
+/**
+ * @file h3.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * The H3 millisecond timer used by lib-c/src/h3/time.c, for ntpsimulation.cpp.
+ * The simulation sets AVS_CNT0 from its oscillator.
+ */
+
+#ifndef H3_H_
+#define H3_H_
+
+#include <stdint.h>
+
+typedef struct {
+	volatile uint32_t AVS_CNT0;
+} H3_TIMER_TypeDef;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern H3_TIMER_TypeDef h3_timer;
+
+#ifdef __cplusplus
+}
+#endif
+
+#define H3_TIMER	(&h3_timer)
+
+#endif /* H3_H_ */
@@ -0,0 +1,418 @@
+/**
+ * @file mdnsreplay.cpp
+ *
+ * Replays mDNS query bursts through the MDNS responder and reports the
+ * time per packet and the answers sent. The queries come from a pcap
+ * capture (Ethernet or Linux cooked, UDP port 5353), or from a built-in
+ * burst as seen in a room with Bonjour heavy consoles.
+ *
+ * Usage: mdnsreplay [capture.pcap] [repeat]
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "mdns.h"
+#include "mdnsservices.h"
+#include "network.h"
+
+namespace replay {
+static constexpr uint16_t MDNS_PORT = 5353;
+
+struct Packet {
+	std::vector<uint8_t> data;
+};
+
+static std::vector<Packet> s_Packets;
+static uint32_t s_nIndex;
+static uint32_t s_nAnswers;
+static uint32_t s_nAnswerBytes;
+}  // namespace replay
+
+class ReplayNetwork: public Network {
+public:
+	ReplayNetwork() {
+		strcpy(m_aHostName, "opi-node");
+		m_nLocalIp = 0x6401a8c0;	// 192.168.1.100
+		m_nNetmask = 0x00FFFFFF;
+	}
+
+	int32_t Begin(__attribute__((unused)) uint16_t nPort) override {
+		return 0;
+	}
+
+	int32_t End(__attribute__((unused)) uint16_t nPort) override {
+		return -1;
+	}
+
+	void MacAddressCopyTo(uint8_t *pMacAddress) override {
+		memset(pMacAddress, 0, NETWORK_MAC_SIZE);
+	}
+
+	void JoinGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void LeaveGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	uint16_t RecvFrom(__attribute__((unused)) int32_t nHandle, void *pBuffer, uint16_t nLength, uint32_t *pFromIp, uint16_t *pFromPort) override {
+		const auto& packet = replay::s_Packets[replay::s_nIndex];
+		const auto nBytes = packet.data.size() < nLength ? static_cast<uint16_t>(packet.data.size()) : nLength;
+
+		memcpy(pBuffer, packet.data.data(), nBytes);
+		*pFromIp = 0x0a01a8c0;
+		*pFromPort = replay::MDNS_PORT;
+
+		return nBytes;
+	}
+
+	void SendTo(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) const void *pBuffer, uint16_t nLength, __attribute__((unused)) uint32_t nToIp, __attribute__((unused)) uint16_t nRemotePort) override {
+		replay::s_nAnswers++;
+		replay::s_nAnswerBytes += nLength;
+	}
+
+	void SetIp(__attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void SetNetmask(__attribute__((unused)) uint32_t nNetmask) override {
+	}
+
+	bool SetZeroconf() override {
+		return false;
+	}
+
+	bool EnableDhcp() override {
+		return false;
+	}
+};
+
+/*
+ * Minimal DNS message writer for the built-in burst
+ */
+class Query {
+public:
+	Query(uint16_t nFlags = 0) {
+		Put16(0);		// xid
+		Put16(nFlags);
+		Put16(0);		// questions
+		Put16(0);		// answers
+		Put16(0);		// authority
+		Put16(0);		// additional
+	}
+
+	/*
+	 * Returns the offset of the name, for compression pointers
+	 */
+	uint16_t Name(const char *pName, uint16_t nPointer = 0) {
+		const auto nOffset = static_cast<uint16_t>(m_Data.size());
+
+		while (*pName != 0) {
+			const char *pDot = strchr(pName, '.');
+			const auto nLength = pDot == nullptr ? strlen(pName) : static_cast<size_t>(pDot - pName);
+			m_Data.push_back(static_cast<uint8_t>(nLength));
+			m_Data.insert(m_Data.end(), pName, pName + nLength);
+			pName += nLength;
+			if (*pName == '.') {
+				pName++;
+			}
+		}
+
+		if (nPointer != 0) {
+			Put16(static_cast<uint16_t>(0xC000 | nPointer));
+		} else {
+			m_Data.push_back(0);
+		}
+
+		return nOffset;
+	}
+
+	void Question(const char *pName, uint16_t nType, uint16_t nPointer = 0) {
+		Name(pName, nPointer);
+		Put16(nType);
+		Put16(0x0001);	// IN, QM
+		Count(4);
+	}
+
+	void KnownPtr(const char *pName, const char *pTarget, uint32_t nTTL) {
+		Name(pName);
+		Put16(12);		// PTR
+		Put16(0x0001);
+		Put16(static_cast<uint16_t>(nTTL >> 16));
+		Put16(static_cast<uint16_t>(nTTL));
+		const auto nLengthOffset = m_Data.size();
+		Put16(0);
+		const auto nStart = m_Data.size();
+		Name(pTarget);
+		const auto nLength = m_Data.size() - nStart;
+		m_Data[nLengthOffset] = static_cast<uint8_t>(nLength >> 8);
+		m_Data[nLengthOffset + 1] = static_cast<uint8_t>(nLength);
+		Count(6);
+	}
+
+	void Add(uint32_t nCopies = 1) {
+		for (uint32_t i = 0; i < nCopies; i++) {
+			replay::Packet packet;
+			packet.data = m_Data;
+			replay::s_Packets.push_back(packet);
+		}
+	}
+
+	uint16_t Offset() const {
+		return static_cast<uint16_t>(m_Data.size());
+	}
+
+private:
+	void Put16(uint16_t nValue) {
+		m_Data.push_back(static_cast<uint8_t>(nValue >> 8));
+		m_Data.push_back(static_cast<uint8_t>(nValue));
+	}
+
+	void Count(uint32_t nIndex) {
+		const auto nCount = static_cast<uint16_t>(((m_Data[nIndex] << 8) | m_Data[nIndex + 1]) + 1);
+		m_Data[nIndex] = static_cast<uint8_t>(nCount >> 8);
+		m_Data[nIndex + 1] = static_cast<uint8_t>(nCount);
+	}
+
+	std::vector<uint8_t> m_Data;
+};
+
+static void BuiltinBurst() {
+	static constexpr uint16_t TYPE_A = 1, TYPE_PTR = 12, TYPE_TXT = 16, TYPE_AAAA = 28, TYPE_SRV = 33, TYPE_ANY = 255;
+
+	// Queries for other devices, the most common traffic
+	const char *pForeign[] = { "_airplay._tcp.local", "_raop._tcp.local", "_googlecast._tcp.local", "_companion-link._tcp.local",
+			"_sleep-proxy._udp.local", "_homekit._tcp.local", "_spotify-connect._tcp.local", "_ipp._tcp.local" };
+
+	for (auto *pName : pForeign) {
+		Query query;
+		query.Question(pName, TYPE_PTR);
+		query.Add(4);
+	}
+
+	{
+		Query query;
+		query.Question("console-1.local", TYPE_A);
+		query.Question("console-1.local", TYPE_AAAA);
+		query.Add(4);
+	}
+
+	// A response from another node, not a query
+	{
+		Query query(0x8400);
+		query.Question("other-node.local", TYPE_A);
+		query.Add(4);
+	}
+
+	// Queries answered by this node
+	{
+		Query query;
+		query.Question("_services._dns-sd._udp.local", TYPE_PTR);
+		query.Add(2);
+	}
+	{
+		Query query;
+		query.Question("_config._udp.local", TYPE_PTR);
+		query.Add(2);
+	}
+	{
+		Query query;
+		query.Question("OPI-NODE.local", TYPE_A);	// Case insensitive
+		query.Add(1);
+	}
+	{
+		Query query;
+		query.Question("opi-node._config._udp.local", TYPE_SRV);
+		query.Question("opi-node._config._udp.local", TYPE_TXT);
+		query.Add(1);
+	}
+	{
+		Query query;
+		query.Question("opi-node.local", TYPE_ANY);
+		query.Add(1);
+	}
+
+	// Multi-question with compression, as sent by a browser for several services
+	{
+		Query query;
+		const auto nUdp = static_cast<uint16_t>(query.Offset() + 8);	// "_config" label is 8 bytes
+		query.Question("_config._udp.local", TYPE_PTR);
+		query.Question("_osc", TYPE_PTR, nUdp);
+		query.Question("_airplay._tcp.local", TYPE_PTR);
+		query.Add(2);
+	}
+
+	// Known-answer suppression: the browser already has the PTR
+	{
+		Query query;
+		query.Question("_config._udp.local", TYPE_PTR);
+		query.KnownPtr("_config._udp.local", "opi-node._config._udp.local", 4500);
+		query.Add(4);
+	}
+}
+
+static bool ReadPcap(const char *pFileName) {
+	auto *pFile = fopen(pFileName, "rb");
+
+	if (pFile == nullptr) {
+		perror(pFileName);
+		return false;
+	}
+
+	uint8_t aHeader[24];
+
+	if (fread(aHeader, 1, sizeof(aHeader), pFile) != sizeof(aHeader)) {
+		fclose(pFile);
+		return false;
+	}
+
+	const uint32_t nMagic = *reinterpret_cast<uint32_t *>(aHeader);
+	const bool bSwap = (nMagic == 0xd4c3b2a1) || (nMagic == 0x4d3cb2a1);
+
+	if (!bSwap && (nMagic != 0xa1b2c3d4) && (nMagic != 0xa1b23c4d)) {
+		fprintf(stderr, "%s: not a pcap file\n", pFileName);
+		fclose(pFile);
+		return false;
+	}
+
+	auto Get32 = [bSwap](const uint8_t *p) {
+		const auto nValue = *reinterpret_cast<const uint32_t *>(p);
+		return bSwap ? __builtin_bswap32(nValue) : nValue;
+	};
+
+	const auto nLinkType = Get32(&aHeader[20]);
+	const uint32_t nLinkHeader = (nLinkType == 113) ? 16 : 14;
+
+	if ((nLinkType != 1) && (nLinkType != 113)) {
+		fprintf(stderr, "%s: link type %u is not supported\n", pFileName, nLinkType);
+		fclose(pFile);
+		return false;
+	}
+
+	uint8_t aRecord[16];
+	std::vector<uint8_t> frame;
+
+	while (fread(aRecord, 1, sizeof(aRecord), pFile) == sizeof(aRecord)) {
+		const auto nLength = Get32(&aRecord[8]);
+		frame.resize(nLength);
+
+		if (fread(frame.data(), 1, nLength, pFile) != nLength) {
+			break;
+		}
+
+		if (nLength < nLinkHeader + 20 + 8) {
+			continue;
+		}
+
+		const auto *pIp = &frame[nLinkHeader];
+
+		if (((pIp[0] >> 4) != 4) || (pIp[9] != 17)) {
+			continue;	// IPv4 UDP only
+		}
+
+		const auto *pUdp = pIp + ((pIp[0] & 0x0F) * 4);
+
+		if ((pUdp + 8) > (frame.data() + nLength)) {
+			continue;
+		}
+
+		if (((pUdp[2] << 8) | pUdp[3]) != replay::MDNS_PORT) {
+			continue;
+		}
+
+		replay::Packet packet;
+		packet.data.assign(pUdp + 8, static_cast<const uint8_t *>(frame.data()) + nLength);
+		replay::s_Packets.push_back(packet);
+	}
+
+	fclose(pFile);
+	return true;
+}
+
+int main(int argc, char **argv) {
+	const char *pCapture = nullptr;
+	uint32_t nRepeat = 10000;
+
+	for (int i = 1; i < argc; i++) {
+		if (atoi(argv[i]) > 0) {
+			nRepeat = static_cast<uint32_t>(atoi(argv[i]));
+		} else {
+			pCapture = argv[i];
+		}
+	}
+
+	if (pCapture != nullptr) {
+		if (!ReadPcap(pCapture)) {
+			return -1;
+		}
+	} else {
+		BuiltinBurst();
+	}
+
+	if (replay::s_Packets.empty()) {
+		fprintf(stderr, "No mDNS packets\n");
+		return -1;
+	}
+
+	ReplayNetwork network;
+	MDNS mDns;
+
+	mDns.Start();
+	mDns.AddServiceRecord(nullptr, MDNS_SERVICE_CONFIG, 0x2905);
+	mDns.AddServiceRecord(nullptr, MDNS_SERVICE_OSC, 8000, "type=server");
+
+	// One pass to count the answers of the burst
+	replay::s_nAnswers = 0;
+	replay::s_nAnswerBytes = 0;
+
+	for (replay::s_nIndex = 0; replay::s_nIndex < replay::s_Packets.size(); replay::s_nIndex++) {
+		mDns.Run();
+	}
+
+	const auto nBurstAnswers = replay::s_nAnswers;
+	const auto nBurstBytes = replay::s_nAnswerBytes;
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (uint32_t n = 0; n < nRepeat; n++) {
+		for (replay::s_nIndex = 0; replay::s_nIndex < replay::s_Packets.size(); replay::s_nIndex++) {
+			mDns.Run();
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	const auto nNanos = static_cast<uint64_t>(end.tv_sec - start.tv_sec) * 1000000000 + static_cast<uint64_t>(end.tv_nsec - start.tv_nsec);
+	const auto nPackets = static_cast<uint64_t>(nRepeat) * replay::s_Packets.size();
+
+	printf("Burst      : %u packets [%s]\n", static_cast<unsigned>(replay::s_Packets.size()), pCapture == nullptr ? "built-in" : pCapture);
+	printf("Answers    : %u messages, %u bytes per burst\n", nBurstAnswers, nBurstBytes);
+	printf("Replayed   : %llu packets\n", static_cast<unsigned long long>(nPackets));
+	printf("Time       : %.1f ns per packet, %.0f packets/s\n", static_cast<double>(nNanos) / static_cast<double>(nPackets), static_cast<double>(nPackets) * 1e9 / static_cast<double>(nNanos));
+
+	return 0;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file ntpsimulation.cpp
+ *
+ * NtpClient against a fake server, on a simulated clock.
+ * The system clock is lib-c/src/h3/time.c, driven by a simulated millisecond
+ * timer. The local oscillator has a frequency error, the network adds jitter
+ * and an occasional delay spike. Nothing touches the real system clock.
+ *
+ * The second case adds a fast caller, time() every 100us as SystimeReader::Run,
+ * the slew of adjtime must not get lost.
+ *
+ * Usage: ntpsimulation [hours] [drift ppm] [jitter us] [initial offset ms]
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "ntpclient.h"
+#include "ntp.h"
+#include "network.h"
+#include "hardware.h"
+
+#include "h3.h"
+
+/*
+ * lib-c/src/h3/time.c, see h3time.c
+ */
+extern "C" {
+int h3_gettimeofday(struct timeval *tv, struct timezone *tz);
+int h3_settimeofday(const struct timeval *tv, const struct timezone *tz);
+int h3_adjtime(const struct timeval *delta, struct timeval *olddelta);
+time_t h3_time(time_t *__timer);
+
+H3_TIMER_TypeDef h3_timer;
+}
+
+namespace sim {
+static constexpr int64_t NANOS_PER_MICRO = 1000;
+static constexpr int64_t MICROS_PER_SECOND = 1000000;
+static constexpr int64_t NANOS_PER_SECOND = MICROS_PER_SECOND * NANOS_PER_MICRO;
+static constexpr uint32_t JAN_1970 = 0x83aa7e80;
+static constexpr uint32_t SERVER_IP = 0x0100000a;	// 10.0.0.1
+
+static int64_t s_nTrueNanos;			///< Reference time, since the Epoch
+static int64_t s_nStartNanos;
+static int64_t s_nDriftPpm;
+static int64_t s_nJitterMicros;
+static int64_t s_nOscillatorNanos;		///< Hardware::Micros() and the H3 timer, runs with the frequency error
+
+void Advance(int64_t nNanos) {
+	s_nTrueNanos += nNanos;
+
+	const auto nElapsed = s_nTrueNanos - s_nStartNanos;
+	s_nOscillatorNanos = nElapsed + (nElapsed * s_nDriftPpm) / 1000000;
+
+	h3_timer.AVS_CNT0 = static_cast<uint32_t>(s_nOscillatorNanos / (NANOS_PER_MICRO * 1000));
+}
+
+/*
+ * Local clock minus reference
+ */
+int64_t ErrorMicros() {
+	struct timeval tv;
+	h3_gettimeofday(&tv, nullptr);
+	return (static_cast<int64_t>(tv.tv_sec) * MICROS_PER_SECOND + tv.tv_usec) - (s_nTrueNanos / NANOS_PER_MICRO);
+}
+
+/*
+ * One way network delay: 300us base, uniform jitter and 1 in 16 packets delayed by 20ms
+ */
+int64_t Delay() {
+	auto nMicros = 300 + (s_nJitterMicros == 0 ? 0 : (random() % s_nJitterMicros));
+
+	if ((random() & 0xF) == 0) {
+		nMicros += 20000;
+	}
+
+	return nMicros * NANOS_PER_MICRO;
+}
+
+void ToNtp(int64_t nNanos, uint32_t& nSeconds, uint32_t& nFraction) {
+	const auto nMicros = nNanos / NANOS_PER_MICRO;
+	nSeconds = static_cast<uint32_t>(nMicros / MICROS_PER_SECOND) + JAN_1970;
+	nFraction = static_cast<uint32_t>(((nMicros % MICROS_PER_SECOND) << 32) / MICROS_PER_SECOND);
+}
+}  // namespace sim
+
+/*
+ * The system clock, interposed for the whole program
+ */
+extern "C" {
+int gettimeofday(struct timeval *tv, __attribute__((unused)) void *tz) {
+	return h3_gettimeofday(tv, nullptr);
+}
+
+int settimeofday(const struct timeval *tv, __attribute__((unused)) const struct timezone *tz) {
+	return h3_settimeofday(tv, nullptr);
+}
+
+int adjtime(const struct timeval *delta, struct timeval *olddelta) {
+	return h3_adjtime(delta, olddelta);
+}
+
+time_t time(time_t *__timer) {
+	return h3_time(__timer);
+}
+}
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Micros() {
+	return static_cast<uint32_t>(sim::s_nOscillatorNanos / sim::NANOS_PER_MICRO);
+}
+
+uint32_t Hardware::Millis() {
+	return static_cast<uint32_t>(sim::s_nOscillatorNanos / (sim::NANOS_PER_MICRO * 1000));
+}
+
+/*
+ * A stratum 1 server with a perfect clock
+ */
+class FakeNtpServer: public Network {
+public:
+	FakeNtpServer() {
+		m_nNtpServerIp = sim::SERVER_IP;
+		m_nLocalIp = 0x0200000a;
+		m_nNetmask = 0x00FFFFFF;
+	}
+
+	int32_t Begin(__attribute__((unused)) uint16_t nPort) override {
+		return 0;
+	}
+
+	int32_t End(__attribute__((unused)) uint16_t nPort) override {
+		return -1;
+	}
+
+	void MacAddressCopyTo(uint8_t *pMacAddress) override {
+		memset(pMacAddress, 0, NETWORK_MAC_SIZE);
+	}
+
+	void JoinGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void LeaveGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void SendTo(__attribute__((unused)) int32_t nHandle, const void *pBuffer, uint16_t nLength, __attribute__((unused)) uint32_t nToIp, __attribute__((unused)) uint16_t nRemotePort) override {
+		if (nLength != sizeof(struct TNtpPacket)) {
+			return;
+		}
+
+		const auto *pRequest = reinterpret_cast<const struct TNtpPacket *>(pBuffer);
+
+		memset(&m_Reply, 0, sizeof(struct TNtpPacket));
+		m_Reply.LiVnMode = NTP_VERSION | NTP_MODE_SERVER;
+		m_Reply.Stratum = 1;
+		m_Reply.OriginTimestamp_s = pRequest->TransmitTimestamp_s;
+		m_Reply.OriginTimestamp_f = pRequest->TransmitTimestamp_f;
+
+		uint32_t nSeconds, nFraction;
+
+		const auto nReceive = sim::s_nTrueNanos + sim::Delay();
+		sim::ToNtp(nReceive, nSeconds, nFraction);
+		m_Reply.ReceiveTimestamp_s = __builtin_bswap32(nSeconds);
+		m_Reply.ReceiveTimestamp_f = __builtin_bswap32(nFraction);
+
+		const auto nTransmit = nReceive + 20 * sim::NANOS_PER_MICRO;
+		sim::ToNtp(nTransmit, nSeconds, nFraction);
+		m_Reply.TransmitTimestamp_s = __builtin_bswap32(nSeconds);
+		m_Reply.TransmitTimestamp_f = __builtin_bswap32(nFraction);
+
+		m_nArrivalNanos = nTransmit + sim::Delay();
+		m_bPending = true;
+		m_nRequests++;
+	}
+
+	/*
+	 * Each poll for a reply costs 100us
+	 */
+	uint16_t RecvFrom(__attribute__((unused)) int32_t nHandle, void *pBuffer, uint16_t nLength, uint32_t *pFromIp, uint16_t *pFromPort) override {
+		if (!m_bPending || (sim::s_nTrueNanos < m_nArrivalNanos)) {
+			sim::Advance(100 * sim::NANOS_PER_MICRO);
+			return 0;
+		}
+
+		m_bPending = false;
+
+		const auto nBytes = nLength < sizeof(struct TNtpPacket) ? nLength : static_cast<uint16_t>(sizeof(struct TNtpPacket));
+		memcpy(pBuffer, &m_Reply, nBytes);
+		*pFromIp = sim::SERVER_IP;
+		*pFromPort = NTP_UDP_PORT;
+
+		return nBytes;
+	}
+
+	void SetIp(__attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void SetNetmask(__attribute__((unused)) uint32_t nNetmask) override {
+	}
+
+	bool SetZeroconf() override {
+		return false;
+	}
+
+	bool EnableDhcp() override {
+		return false;
+	}
+
+	uint32_t GetRequests() const {
+		return m_nRequests;
+	}
+
+private:
+	struct TNtpPacket m_Reply;
+	int64_t m_nArrivalNanos { 0 };
+	bool m_bPending { false };
+	uint32_t m_nRequests { 0 };
+};
+
+/*
+ * Locked: no step, within the 1 ms resolution of the H3 timer plus the network jitter
+ */
+static constexpr int64_t MAX_ERROR_MICROS = 5000;
+
+struct Result {
+	const char *pCase;
+	int64_t nErrorMaxMicros;
+	uint32_t nSteps;
+};
+
+static Result s_Results[2];
+static uint32_t s_nResults;
+
+static uint32_t s_nFailed;
+
+static void result(const char *pCase, int64_t nErrorMaxMicros, uint32_t nSteps) {
+	const auto bPass = (nSteps == 0) && (nErrorMaxMicros < MAX_ERROR_MICROS);
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+
+	printf("%-24s %10d us %6u   %s\n", pCase, static_cast<int>(nErrorMaxMicros), nSteps, bPass ? "PASS" : "FAIL");
+}
+
+/*
+ * The main loop runs every nLoopNanos. The error is sampled once per second,
+ * the sample itself is not a fast caller.
+ */
+static void run(const char *pCase, int nHours, int nOffsetMillis, int64_t nLoopNanos, bool bFastCaller) {
+	srandom(1);
+
+	sim::s_nTrueNanos = static_cast<int64_t>(1609459200) * sim::NANOS_PER_SECOND; // 2021-01-01
+	sim::s_nStartNanos = sim::s_nTrueNanos;
+	sim::Advance(0);
+
+	struct timeval tv;
+	const auto nLocalMicros = (sim::s_nTrueNanos / sim::NANOS_PER_MICRO) + static_cast<int64_t>(nOffsetMillis) * 1000;
+	tv.tv_sec = static_cast<time_t>(nLocalMicros / sim::MICROS_PER_SECOND);
+	tv.tv_usec = static_cast<suseconds_t>(nLocalMicros % sim::MICROS_PER_SECOND);
+	h3_settimeofday(&tv, nullptr);
+
+	printf("%s\n\n", pCase);
+
+	FakeNtpServer server;
+	NtpClient client;
+
+	client.Start();
+
+	printf("%6s %12s %10s %8s %8s %10s %6s %6s %6s\n", "min", "error [us]", "offset", "delay", "jitter", "drift ppb", "poll", "steps", "slews");
+
+	const auto nEndNanos = sim::s_nStartNanos + static_cast<int64_t>(nHours) * 3600 * sim::NANOS_PER_SECOND;
+	int64_t nNextSample = sim::s_nTrueNanos;
+	int64_t nNextReport = sim::s_nTrueNanos;
+	int64_t nErrorMaxMicros = 0;		///< Second half of the run, when locked
+
+	while (sim::s_nTrueNanos < nEndNanos) {
+		client.Run();
+
+		if (bFastCaller) {
+			time(nullptr);
+		}
+
+		sim::Advance(nLoopNanos);
+
+		if (sim::s_nTrueNanos < nNextSample) {
+			continue;
+		}
+
+		nNextSample += sim::NANOS_PER_SECOND;
+
+		const auto nError = sim::ErrorMicros();
+
+		if ((sim::s_nTrueNanos - sim::s_nStartNanos) > ((nEndNanos - sim::s_nStartNanos) / 2)) {
+			const auto nAbs = nError < 0 ? -nError : nError;
+			if (nAbs > nErrorMaxMicros) {
+				nErrorMaxMicros = nAbs;
+			}
+		}
+
+		if (sim::s_nTrueNanos >= nNextReport) {
+			const auto& stats = client.GetStats();
+			printf("%6d %12d %10d %8u %8u %10d %6u %6u %6u\n",
+					static_cast<int>((sim::s_nTrueNanos - sim::s_nStartNanos) / (60 * sim::NANOS_PER_SECOND)),
+					static_cast<int>(nError),
+					stats.nOffsetMicros, stats.nDelayMicros, stats.nJitterMicros, stats.nDriftPpb,
+					stats.nPollSeconds, stats.nSteps, stats.nSlews);
+			nNextReport += 30 * 60 * sim::NANOS_PER_SECOND;
+		}
+	}
+
+	const auto& stats = client.GetStats();
+
+	printf("\nRequests            : %u\n", server.GetRequests());
+	printf("Steps               : %u\n", stats.nSteps);
+	printf("Max error (locked)  : %d us\n", static_cast<int>(nErrorMaxMicros));
+	printf("Drift estimate      : %d ppb [actual %d ppb]\n\n", stats.nDriftPpb, static_cast<int>(-sim::s_nDriftPpm * 1000));
+
+	s_Results[s_nResults].pCase = pCase;
+	s_Results[s_nResults].nErrorMaxMicros = nErrorMaxMicros;
+	s_Results[s_nResults].nSteps = stats.nSteps;
+	s_nResults++;
+}
+
+int main(int argc, char **argv) {
+	const auto nHours = argc > 1 ? atoi(argv[1]) : 12;
+	sim::s_nDriftPpm = argc > 2 ? atoi(argv[2]) : 25;
+	sim::s_nJitterMicros = argc > 3 ? atoi(argv[3]) : 2000;
+	const auto nOffsetMillis = argc > 4 ? atoi(argv[4]) : 50;
+
+	printf("Drift %d ppm, jitter %d us, initial offset %d ms, %d hours\n\n", static_cast<int>(sim::s_nDriftPpm), static_cast<int>(sim::s_nJitterMicros), nOffsetMillis, nHours);
+
+	Hardware hw;
+
+	run("1 ms main loop", nHours, nOffsetMillis, 1000 * sim::NANOS_PER_MICRO, false);
+	run("time() every 100 us", nHours, nOffsetMillis, 100 * sim::NANOS_PER_MICRO, true);
+
+	printf("%-24s %13s %6s\n", "Case", "Max error", "Steps");
+
+	for (uint32_t i = 0; i < s_nResults; i++) {
+		result(s_Results[i].pCase, s_Results[i].nErrorMaxMicros, s_Results[i].nSteps);
+	}
+
+	return s_nFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
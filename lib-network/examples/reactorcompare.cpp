@@ -0,0 +1,235 @@
+/**
+ * @file reactorcompare.cpp
+ *
+ * Compares the polling superloop with NetworkReactor on a Linux host.
+ * A sender thread sends time stamped UDP packets over the loopback at a
+ * fixed rate. The receiver either polls the socket, as the superloop does,
+ * or waits in NetworkReactor::Wait() with the 100 ms tick. For each mode
+ * the receiver CPU time and the latency (mean, 99th percentile, maximum)
+ * are reported.
+ *
+ * Usage: reactorcompare [packets] [interval_us]
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <vector>
+#include <algorithm>
+
+#include "networkreactor.h"
+
+struct Packet {
+	uint64_t nSentNanos;
+	uint32_t nSequence;
+	uint8_t data[512];
+};
+
+static uint32_t s_nPackets = 2000;
+static uint32_t s_nIntervalMicros = 1000;
+
+static uint64_t nanos(clockid_t clock = CLOCK_MONOTONIC) {
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return (static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct Sender {
+	int nSocket;
+	struct sockaddr_in to;
+};
+
+static void *sender(void *pArg) {
+	const auto *pSender = static_cast<const Sender *>(pArg);
+	Packet packet;
+
+	memset(&packet, 0, sizeof(packet));
+
+	auto nNext = nanos();
+
+	for (uint32_t i = 0; i < s_nPackets; i++) {
+		nNext += static_cast<uint64_t>(s_nIntervalMicros) * 1000U;
+
+		struct timespec ts;
+		ts.tv_sec = static_cast<time_t>(nNext / 1000000000ULL);
+		ts.tv_nsec = static_cast<long>(nNext % 1000000000ULL);
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+
+		packet.nSequence = i;
+		packet.nSentNanos = nanos();
+
+		if (sendto(pSender->nSocket, &packet, sizeof(packet), 0, reinterpret_cast<const struct sockaddr *>(&pSender->to), sizeof(pSender->to)) == -1) {
+			perror("sendto");
+		}
+	}
+
+	return nullptr;
+}
+
+struct Result {
+	uint32_t nReceived;
+	uint32_t nWakeUps;
+	double fCpuPercent;
+	double fMeanMicros;
+	double f99Micros;
+	double fMaxMicros;
+};
+
+/*
+ * Reads all the pending packets, as the Run() functions do after a wake-up
+ */
+static void drain(int nSocket, std::vector<uint64_t>& latencies, uint32_t& nReceived) {
+	Packet packet;
+
+	while (recv(nSocket, &packet, sizeof(packet), 0) == static_cast<ssize_t>(sizeof(packet))) {
+		latencies.push_back(nanos() - packet.nSentNanos);
+		nReceived++;
+	}
+}
+
+static Result run(bool bReactor) {
+	const auto nReceive = socket(AF_INET, SOCK_DGRAM, 0);
+	const auto nSend = socket(AF_INET, SOCK_DGRAM, 0);
+
+	if ((nReceive == -1) || (nSend == -1)) {
+		perror("socket");
+		exit(EXIT_FAILURE);
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+
+	socklen_t nLength = sizeof(addr);
+
+	if ((bind(nReceive, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == -1) || (getsockname(nReceive, reinterpret_cast<struct sockaddr *>(&addr), &nLength) == -1)) {
+		perror("bind");
+		exit(EXIT_FAILURE);
+	}
+
+	NetworkReactor *pReactor = nullptr;
+
+	if (bReactor) {
+		pReactor = new NetworkReactor;
+		pReactor->Add(nReceive);
+		pReactor->AddTimer(networkreactor::TICK_MILLIS);
+	} else {
+		fcntl(nReceive, F_SETFL, fcntl(nReceive, F_GETFL, 0) | O_NONBLOCK);
+	}
+
+	std::vector<uint64_t> latencies;
+	latencies.reserve(s_nPackets);
+
+	Sender s { nSend, addr };
+	pthread_t thread;
+
+	const auto nCpuStart = nanos(CLOCK_THREAD_CPUTIME_ID);
+	const auto nStart = nanos();
+
+	pthread_create(&thread, nullptr, sender, &s);
+
+	// Up to a second after the last packet, for the packets still in flight
+	const auto nEnd = nStart + (static_cast<uint64_t>(s_nPackets) * s_nIntervalMicros * 1000U) + 1000000000ULL;
+	uint32_t nReceived = 0;
+
+	while ((nReceived < s_nPackets) && (nanos() < nEnd)) {
+		if (pReactor != nullptr) {
+			pReactor->Wait();
+		}
+		drain(nReceive, latencies, nReceived);
+	}
+
+	const auto nCpu = nanos(CLOCK_THREAD_CPUTIME_ID) - nCpuStart;
+	const auto nElapsed = nanos() - nStart;
+
+	pthread_join(thread, nullptr);
+
+	Result result;
+	result.nReceived = nReceived;
+	result.nWakeUps = (pReactor != nullptr) ? pReactor->GetWakeUps() : 0;
+	result.fCpuPercent = (100.0 * static_cast<double>(nCpu)) / static_cast<double>(nElapsed);
+
+	std::sort(latencies.begin(), latencies.end());
+
+	uint64_t nSum = 0;
+	for (const auto nLatency : latencies) {
+		nSum += nLatency;
+	}
+
+	const auto nCount = latencies.size();
+	result.fMeanMicros = (nCount != 0) ? static_cast<double>(nSum) / static_cast<double>(nCount) / 1000.0 : 0;
+	result.f99Micros = (nCount != 0) ? static_cast<double>(latencies[(nCount * 99) / 100]) / 1000.0 : 0;
+	result.fMaxMicros = (nCount != 0) ? static_cast<double>(latencies[nCount - 1]) / 1000.0 : 0;
+
+	delete pReactor;
+	close(nReceive);
+	close(nSend);
+
+	return result;
+}
+
+int main(int argc, char **argv) {
+	if (argc > 1) {
+		s_nPackets = static_cast<uint32_t>(atoi(argv[1]));
+	}
+
+	if (argc > 2) {
+		s_nIntervalMicros = static_cast<uint32_t>(atoi(argv[2]));
+	}
+
+	if ((s_nPackets == 0) || (s_nIntervalMicros == 0)) {
+		fprintf(stderr, "Usage: %s [packets] [interval_us]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	printf("%u packets, one every %u us\n", s_nPackets, s_nIntervalMicros);
+
+	if (sysconf(_SC_NPROCESSORS_ONLN) < 2) {
+		puts("Only 1 CPU online: the polling receiver delays the sender, its latency is not representative");
+	}
+
+	printf("\n%-10s %8s %8s %8s %10s %10s %10s\n", "Mode", "Packets", "Wake-ups", "CPU %", "Mean us", "99% us", "Max us");
+
+	bool bPass = true;
+
+	for (const auto bReactor : { false, true }) {
+		const auto result = run(bReactor);
+
+		printf("%-10s %8u %8u %8.1f %10.1f %10.1f %10.1f  %s\n", bReactor ? "Reactor" : "Polling", result.nReceived, result.nWakeUps, result.fCpuPercent, result.fMeanMicros, result.f99Micros, result.fMaxMicros, (result.nReceived == s_nPackets) ? "PASS" : "FAIL");
+
+		bPass &= (result.nReceived == s_nPackets);
+	}
+
+	return bPass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
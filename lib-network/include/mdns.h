@@ -48,13 +48,23 @@ struct TMDNSServiceRecord {
 	char *pTextContent;
 };
 
+/**
+ * Location of a precomputed resource record in TMDNSRecordData::aBuffer
+ */
+struct TMDNSAnswer {
+	uint16_t nOffset;
+	uint16_t nSize;
+};
+
+#define SERVICE_RECORDS_MAX		4
+#define SERVICE_ANSWERS			4	///< SRV, TXT, DNS-SD PTR, PTR
+
 struct TMDNSRecordData {
 	uint32_t nSize;
 	uint8_t aBuffer[512];
+	TMDNSAnswer aAnswers[SERVICE_ANSWERS];
 };
 
-#define SERVICE_RECORDS_MAX		4
-
 class MDNS {
 public:
 	MDNS();
@@ -73,13 +83,19 @@ public:
 
 private:
 	void Parse();
-	void HandleRequest(uint16_t nQuestions);
+	void HandleRequest(uint16_t nQuestions, uint16_t nKnownAnswers);
+
+	uint32_t SkipName(uint32_t nOffset) const;
+	bool IsNameEqual(uint32_t nOffset, const uint8_t *pName) const;
+	bool IsKnownAnswer(uint32_t nOffset, const uint8_t *pRecord) const;
 
-	uint32_t DecodeDNSNameNotation(const char *pDNSNameNotation, char *pString);
+	const uint8_t *GetAnswer(uint32_t nAnswer, uint32_t& nSize) const;
+	void SendAnswers(uint32_t nAnswers, uint32_t nAdditionals);
 
 	uint32_t WriteDnsName(const char *pSource, char *pDestination, bool bNullTerminated = true);
 	const char *FindFirstDotFromRight(const char *pString);
 
+	void CreateAnswers();
 	void CreateAnswerLocalIpAddress();
 
 	uint32_t CreateAnswerServiceSrv(uint32_t nIndex, uint8_t *pDestination);
@@ -95,6 +111,7 @@ private:
 
 private:
 	uint32_t m_nMulticastIp;
+	uint32_t m_nIp{0};
 	int32_t m_nHandle{-1};
 	uint8_t *m_pBuffer{nullptr};
 	uint8_t *m_pOutBuffer{nullptr};
@@ -0,0 +1,101 @@
+/**
+ * @file networkreactor.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef NETWORKREACTOR_H_
+#define NETWORKREACTOR_H_
+
+#include <stdint.h>
+
+namespace networkreactor {
+static constexpr uint32_t MAX_EVENTS = 16;
+static constexpr uint32_t MAX_TIMERS = 8;
+/**
+ * Wake-up for the time based work in the Run() functions (time-outs, identify, flash store)
+ */
+static constexpr uint32_t TICK_MILLIS = 100;
+}  // namespace networkreactor
+
+/**
+ * Linux only. Replaces the busy superloop by a wait on epoll.
+ * Every handle returned by Network::Begin is registered, Wait() returns when a packet
+ * has arrived or a timer has expired. The reactor only wakes up the superloop,
+ * the Run() functions are then called as before and do all the work:
+ *
+ *	for (;;) {
+ *		reactor.Wait();
+ *		node.Run();
+ *		remoteConfig.Run();
+ *	}
+ *
+ * The handles are level triggered, a packet not yet read wakes up the next Wait() immediately.
+ * Without epoll Wait() returns at once, the superloop is then polling as without a reactor.
+ */
+class NetworkReactor {
+public:
+	NetworkReactor();
+	~NetworkReactor();
+
+	bool Add(int32_t nHandle);
+	void Remove(int32_t nHandle);
+
+	/**
+	 * Periodic wake-up based on timerfd, returns the timer handle or -1
+	 */
+	int32_t AddTimer(uint32_t nIntervalMillis);
+
+	bool IsActive() const {
+		return m_nEpollFd != -1;
+	}
+
+	/**
+	 * Returns the number of events handled, 0 on time-out
+	 */
+	uint32_t Wait(int32_t nTimeoutMillis = -1);
+
+	uint32_t GetWakeUps() const {
+		return m_nWakeUps;
+	}
+
+	static NetworkReactor *Get() {
+		return s_pThis;
+	}
+
+private:
+	struct Entry {
+		int32_t nHandle;
+		bool isTimer;
+	};
+
+	Entry *Find(int32_t nHandle);
+
+private:
+	int m_nEpollFd { -1 };
+	Entry m_Entries[networkreactor::MAX_EVENTS + networkreactor::MAX_TIMERS];
+	uint32_t m_nWakeUps { 0 };
+
+	static NetworkReactor *s_pThis;
+};
+
+#endif /* NETWORKREACTOR_H_ */
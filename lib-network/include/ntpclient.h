@@ -2,7 +2,7 @@
  * @file ntpclient.h
  *
  */
-/* Copyright (C) 2019-2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2019-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -38,6 +38,21 @@ enum class NtpClientStatus {
 	WAITING
 };
 
+namespace ntpclient {
+static constexpr auto FILTER_SAMPLES = 8;
+
+struct Stats {
+	int32_t nOffsetMicros;		///< Offset of the selected sample
+	uint32_t nDelayMicros;		///< Round-trip delay of the selected sample
+	uint32_t nJitterMicros;		///< RMS of the offset differences in the clock filter
+	int32_t nDriftPpb;			///< Frequency correction applied to the system clock
+	uint32_t nPollSeconds;
+	uint32_t nSamples;
+	uint32_t nSteps;
+	uint32_t nSlews;
+}__attribute__((packed));
+}  // namespace ntpclient
+
 struct NtpClientDisplay {
 	virtual ~NtpClientDisplay() {
 	}
@@ -59,6 +74,10 @@ public:
 		return m_tStatus;
 	}
 
+	const ntpclient::Stats& GetStats() const {
+		return m_Stats;
+	}
+
 	void SetNtpClientDisplay(NtpClientDisplay *pNtpClientDisplay) {
 		m_pNtpClientDisplay = pNtpClientDisplay;
 	}
@@ -78,8 +97,18 @@ private:
 		uint32_t nFraction;
 	};
 
-	void Difference(const struct TimeStamp *Start, const struct TimeStamp *Stop, int32_t &nDiffSeconds, uint32_t &nDiffFraction);
-	int SetTimeOfDay();
+	struct Sample {
+		int64_t nOffsetMicros;
+		int64_t nDelayMicros;
+		uint32_t nMillis;
+	};
+
+	static int64_t ToMicros(const struct TimeStamp *pTimeStamp);
+	void Process();
+	bool ClockFilter(struct Sample& selected);
+	void Discipline(const struct Sample& sample);
+	void Slew();
+	int SetTimeOfDay(int64_t nOffsetMicros);
 
 	void PrintNtpTime(const char *pText, const struct TimeStamp *pNtpTime);
 
@@ -98,8 +127,17 @@ private:
 	struct TimeStamp T3{0,0};	// time reply sent by server
 	struct TimeStamp T4{0,0};	// time reply received by client
 
-	int32_t m_nOffsetSeconds{0};
-	uint32_t m_nOffsetMicros{0};
+	struct Sample m_Filter[ntpclient::FILTER_SAMPLES];
+	uint32_t m_nFilterIndex{0};
+	uint32_t m_nFilterCount{0};
+	uint32_t m_nMillisLastUpdate{0};	// Sample time of the last offset used by the discipline
+
+	uint32_t m_nPollSeconds;
+	uint32_t m_MillisLastSlew{0};
+	int64_t m_nSlewRemainingMicros{0};
+	int32_t m_nDriftAccumulatorNanos{0};
+
+	ntpclient::Stats m_Stats;
 
 	NtpClientDisplay *m_pNtpClientDisplay = nullptr;
 
@@ -36,6 +36,7 @@
 #include <cassert>
 
 #include "networklinux.h"
+#include "networkreactor.h"
 
 #include "debug.h"
 
@@ -224,6 +225,12 @@ int32_t NetworkLinux::Begin(uint16_t nPort) {
 
 	snHandles[i] = nSocket;
 
+#if defined (__linux__)
+	if (NetworkReactor::Get() != nullptr) {
+		NetworkReactor::Get()->Add(nSocket);
+	}
+#endif
+
 	return nSocket;
 }
 
@@ -250,6 +257,11 @@ int32_t NetworkLinux::End(uint16_t nPort) {
 		if (s_ports_allowed[i] == nPort) {
 			s_ports_allowed[i] = 0;
 			printf("close");
+#if defined (__linux__)
+			if (NetworkReactor::Get() != nullptr) {
+				NetworkReactor::Get()->Remove(snHandles[i]);
+			}
+#endif
 			if (close(snHandles[i]) == -1) {
 				perror("unbind");
 				exit(EXIT_FAILURE);
@@ -0,0 +1,248 @@
+/**
+ * @file networkreactor.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined (__linux__)
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <cassert>
+
+#include "networkreactor.h"
+
+#include "debug.h"
+
+using namespace networkreactor;
+
+NetworkReactor *NetworkReactor::s_pThis = nullptr;
+
+NetworkReactor::NetworkReactor() {
+	DEBUG_ENTRY
+
+	assert(s_pThis == nullptr);
+	s_pThis = this;
+
+	for (auto& entry : m_Entries) {
+		entry.nHandle = -1;
+		entry.isTimer = false;
+	}
+
+	if ((m_nEpollFd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+		perror("epoll_create1");
+		fprintf(stderr, "NetworkReactor: polling\n");
+	}
+
+	DEBUG_EXIT
+}
+
+NetworkReactor::~NetworkReactor() {
+	DEBUG_ENTRY
+
+	for (auto& entry : m_Entries) {
+		if (entry.isTimer) {
+			close(entry.nHandle);
+		}
+	}
+
+	if (m_nEpollFd != -1) {
+		close(m_nEpollFd);
+	}
+
+	s_pThis = nullptr;
+
+	DEBUG_EXIT
+}
+
+NetworkReactor::Entry *NetworkReactor::Find(int32_t nHandle) {
+	for (auto& entry : m_Entries) {
+		if (entry.nHandle == nHandle) {
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+bool NetworkReactor::Add(int32_t nHandle) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nHandle=%d", nHandle);
+
+	if (m_nEpollFd == -1) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	auto *pEntry = Find(nHandle);
+
+	if (pEntry != nullptr) {
+		DEBUG_EXIT
+		return true;
+	}
+
+	if ((pEntry = Find(-1)) == nullptr) {
+		fprintf(stderr, "NetworkReactor: too many handles\n");
+		DEBUG_EXIT
+		return false;
+	}
+
+	// RecvFrom is called after every wake-up, also for the handles without data
+	const auto nFlags = fcntl(nHandle, F_GETFL, 0);
+
+	if ((nFlags == -1) || (fcntl(nHandle, F_SETFL, nFlags | O_NONBLOCK) == -1)) {
+		perror("fcntl(O_NONBLOCK)");
+	}
+
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.ptr = pEntry;
+
+	if (epoll_ctl(m_nEpollFd, EPOLL_CTL_ADD, nHandle, &event) == -1) {
+		perror("epoll_ctl(EPOLL_CTL_ADD)");
+		DEBUG_EXIT
+		return false;
+	}
+
+	pEntry->nHandle = nHandle;
+	pEntry->isTimer = false;
+
+	DEBUG_EXIT
+	return true;
+}
+
+void NetworkReactor::Remove(int32_t nHandle) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nHandle=%d", nHandle);
+
+	auto *pEntry = Find(nHandle);
+
+	if (pEntry == nullptr) {
+		DEBUG_EXIT
+		return;
+	}
+
+	if ((m_nEpollFd != -1) && (epoll_ctl(m_nEpollFd, EPOLL_CTL_DEL, nHandle, nullptr) == -1)) {
+		perror("epoll_ctl(EPOLL_CTL_DEL)");
+	}
+
+	if (pEntry->isTimer) {
+		close(nHandle);
+	}
+
+	pEntry->nHandle = -1;
+	pEntry->isTimer = false;
+
+	DEBUG_EXIT
+}
+
+int32_t NetworkReactor::AddTimer(uint32_t nIntervalMillis) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nIntervalMillis=%u", nIntervalMillis);
+
+	assert(nIntervalMillis != 0);
+
+	if (m_nEpollFd == -1) {
+		DEBUG_EXIT
+		return -1;
+	}
+
+	const auto nTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (nTimerFd == -1) {
+		perror("timerfd_create");
+		DEBUG_EXIT
+		return -1;
+	}
+
+	struct itimerspec spec;
+	spec.it_interval.tv_sec = static_cast<time_t>(nIntervalMillis / 1000U);
+	spec.it_interval.tv_nsec = static_cast<long>((nIntervalMillis % 1000U) * 1000000U);
+	spec.it_value = spec.it_interval;
+
+	if (timerfd_settime(nTimerFd, 0, &spec, nullptr) == -1) {
+		perror("timerfd_settime");
+		close(nTimerFd);
+		DEBUG_EXIT
+		return -1;
+	}
+
+	if (!Add(nTimerFd)) {
+		close(nTimerFd);
+		DEBUG_EXIT
+		return -1;
+	}
+
+	Find(nTimerFd)->isTimer = true;
+
+	DEBUG_EXIT
+	return nTimerFd;
+}
+
+/*
+ * An error other than EINTR will not go away, the reactor then falls back to polling
+ */
+uint32_t NetworkReactor::Wait(int32_t nTimeoutMillis) {
+	if (__builtin_expect((m_nEpollFd == -1), 0)) {
+		return 0;
+	}
+
+	struct epoll_event events[MAX_EVENTS];
+
+	const auto nEvents = epoll_wait(m_nEpollFd, events, MAX_EVENTS, nTimeoutMillis);
+
+	if (nEvents == -1) {
+		if (errno != EINTR) {
+			perror("epoll_wait");
+			fprintf(stderr, "NetworkReactor: polling\n");
+			close(m_nEpollFd);
+			m_nEpollFd = -1;
+		}
+		return 0;
+	}
+
+	if (nEvents != 0) {
+		m_nWakeUps++;
+	}
+
+	for (int i = 0; i < nEvents; i++) {
+		const auto *pEntry = static_cast<Entry *>(events[i].data.ptr);
+
+		if (pEntry->isTimer) {
+			uint64_t nExpirations;
+			if (read(pEntry->nHandle, &nExpirations, sizeof(nExpirations)) == -1) {
+				if (errno != EAGAIN) {
+					perror("read(timerfd)");
+				}
+			}
+		}
+	}
+
+	return static_cast<uint32_t>(nEvents);
+}
+
+#endif
@@ -46,16 +46,43 @@
 #define BUFFER_SIZE				1024
 
 enum TDNSClasses {
-	DNSClassInternet = 1
+	DNSClassInternet = 1,
+	DNSClassAny = 255
 };
 
 enum TDNSRecordTypes {
 	DNSRecordTypeA = 1,		///< 0x01
 	DNSRecordTypePTR = 12,	///< 0x0c
 	DNSRecordTypeTXT = 16,	///< 0x10
-	DNSRecordTypeSRV = 33	///< 0x21
+	DNSRecordTypeSRV = 33,	///< 0x21
+	DNSRecordTypeANY = 255	///< 0xff
 };
 
+/*
+ * Order of the records in the precomputed service message
+ */
+enum TServiceAnswer {
+	ServiceAnswerSrv,
+	ServiceAnswerTxt,
+	ServiceAnswerDnsSd,
+	ServiceAnswerPtr
+};
+
+/*
+ * Answer bit 0 is the A record, followed by SERVICE_ANSWERS bits per service record
+ */
+#define ANSWER_A				0
+#define ANSWER_SERVICE(i, a)	(1U + ((i) * SERVICE_ANSWERS) + (a))
+
+static_assert((1 + (SERVICE_RECORDS_MAX * SERVICE_ANSWERS)) <= 32, "Answers do not fit in uint32_t");
+
+static uint8_t to_lower(uint8_t c) {
+	if ((c >= 'A') && (c <= 'Z')) {
+		return static_cast<uint8_t>(c + ('a' - 'A'));
+	}
+	return c;
+}
+
 enum TDNSCacheFlush {
 	DNSCacheFlushTrue = 0x8000
 };
@@ -109,7 +136,7 @@ void MDNS::Start() {
 		SetName(Network::Get()->GetHostName());
 	}
 
-	CreateAnswerLocalIpAddress();
+	CreateAnswers();
 
 	Network::Get()->SetDomainName(&MDNS_TLD[1]);
 }
@@ -134,6 +161,28 @@ void MDNS::SetName(const char *pName) {
 	strcpy(m_pName + strlen(pName), MDNS_TLD);
 
 	DEBUG_PUTS(m_pName);
+
+	if (m_nHandle != -1) {
+		CreateAnswers();
+	}
+}
+
+/*
+ * The answers are precomputed in wire format. They are rebuild only
+ * when the IP address, the name or the services are changed.
+ */
+void MDNS::CreateAnswers() {
+	DEBUG_ENTRY
+
+	CreateAnswerLocalIpAddress();
+
+	for (uint32_t i = 0; i < SERVICE_RECORDS_MAX; i++) {
+		if (m_aServiceRecords[i].pName != nullptr) {
+			CreateMDNSMessage(i);
+		}
+	}
+
+	DEBUG_EXIT
 }
 
 void MDNS::CreateMDNSMessage(uint32_t nIndex) {
@@ -148,11 +197,23 @@ void MDNS::CreateMDNSMessage(uint32_t nIndex) {
 	pHeader->additionalCount = __builtin_bswap16(0);
 
 	auto *pData = reinterpret_cast<uint8_t*>(&m_aServiceRecordsData[nIndex].aBuffer) + sizeof(struct TmDNSHeader);
+	auto *pAnswers = m_aServiceRecordsData[nIndex].aAnswers;
+
+	pAnswers[ServiceAnswerSrv].nOffset = static_cast<uint16_t>(pData - reinterpret_cast<uint8_t*>(pHeader));
+	pAnswers[ServiceAnswerSrv].nSize = static_cast<uint16_t>(CreateAnswerServiceSrv(nIndex, pData));
+	pData += pAnswers[ServiceAnswerSrv].nSize;
 
-	pData += CreateAnswerServiceSrv(nIndex, pData);
-	pData += CreateAnswerServiceTxt(nIndex, pData);
-	pData += CreateAnswerServiceDnsSd(nIndex, pData);
-	pData += CreateAnswerServicePtr(nIndex, pData);
+	pAnswers[ServiceAnswerTxt].nOffset = static_cast<uint16_t>(pData - reinterpret_cast<uint8_t*>(pHeader));
+	pAnswers[ServiceAnswerTxt].nSize = static_cast<uint16_t>(CreateAnswerServiceTxt(nIndex, pData));
+	pData += pAnswers[ServiceAnswerTxt].nSize;
+
+	pAnswers[ServiceAnswerDnsSd].nOffset = static_cast<uint16_t>(pData - reinterpret_cast<uint8_t*>(pHeader));
+	pAnswers[ServiceAnswerDnsSd].nSize = static_cast<uint16_t>(CreateAnswerServiceDnsSd(nIndex, pData));
+	pData += pAnswers[ServiceAnswerDnsSd].nSize;
+
+	pAnswers[ServiceAnswerPtr].nOffset = static_cast<uint16_t>(pData - reinterpret_cast<uint8_t*>(pHeader));
+	pAnswers[ServiceAnswerPtr].nSize = static_cast<uint16_t>(CreateAnswerServicePtr(nIndex, pData));
+	pData += pAnswers[ServiceAnswerPtr].nSize;
 
 	memcpy(pData, &m_tAnswerLocalIp.aBuffer[sizeof (struct TmDNSHeader)], m_tAnswerLocalIp.nSize - sizeof (struct TmDNSHeader));
 	pData += (m_tAnswerLocalIp.nSize - sizeof (struct TmDNSHeader));
@@ -164,63 +225,6 @@ void MDNS::CreateMDNSMessage(uint32_t nIndex) {
 	DEBUG1_EXIT
 }
 
-uint32_t MDNS::DecodeDNSNameNotation(const char *pDNSNameNotation, char *pString) {
-	DEBUG_ENTRY
-
-	const char *pSrc = pDNSNameNotation;
-	char *pDst = pString;
-
-	uint32_t nLenght = 0;
-	uint32_t nSize = 0;
-	bool isCompressed = false;
-
-	while (*pSrc != 0) {
-		nLenght = static_cast<uint8_t>(*pSrc++);
-//		DEBUG_PRINTF("nLenght=%.2x", (int) nLenght);
-
-		if (nLenght > 63) {
-			if (!isCompressed) {
-				nSize += 1;
-			}
-
-			isCompressed = true;
-			const uint32_t nCompressedOffset = ((nLenght & static_cast<uint32_t>(~(0xC0))) << 8) | ((*pSrc & 0xFF));
-			nLenght =  m_pBuffer[nCompressedOffset];
-
-//			DEBUG_PRINTF("--> nCompressedOffset=%.4x", (int) nCompressedOffset);
-
-			pSrc = reinterpret_cast<char*>(&m_pBuffer[nCompressedOffset + 1]);
-
-			for (uint32_t i = 0; i < nLenght; i++) {
-				*pDst = *pSrc;
-				pDst++;
-				pSrc++;
-			}
-
-		} else if (nLenght > 0) {
-
-			for (uint32_t i = 0; i < nLenght; i++) {
-				*pDst = *pSrc;
-				pDst++;
-				pSrc++;
-			}
-
-			if (!isCompressed) {
-				nSize += (nLenght + 1);
-			}
-		}
-
-		if (*pSrc != 0) {
-			*pDst++ = '.';
-		}
-	}
-
-	*pDst = '\0';
-
-	DEBUG_EXIT
-	return 1 + nSize;
-}
-
 bool MDNS::AddServiceRecord(const char *pName, const char *pServName, uint16_t nPort, const char *pTextContent) {
 	DEBUG1_ENTRY
 
@@ -234,7 +238,7 @@ bool MDNS::AddServiceRecord(const char *pName, const char *pServName, uint16_t n
 			m_aServiceRecords[i].nPort = nPort;
 
 			if (pName == nullptr) {
-				m_aServiceRecords[i].pName = new char[1 + strlen(Network::Get()->GetHostName() + strlen(pServName))];
+				m_aServiceRecords[i].pName = new char[1 + strlen(Network::Get()->GetHostName()) + strlen(pServName)];
 				assert(m_aServiceRecords[i].pName != nullptr);
 
 				strcpy(m_aServiceRecords[i].pName, Network::Get()->GetHostName());
@@ -344,10 +348,13 @@ void MDNS::CreateAnswerLocalIpAddress() {
 	pData += 4;
 	*reinterpret_cast<uint16_t*>(pData) = __builtin_bswap16(4);	// Data length
 	pData += 2;
-	*reinterpret_cast<uint32_t*>(pData) = Network::Get()->GetIp();
+	m_nIp = Network::Get()->GetIp();
+	*reinterpret_cast<uint32_t*>(pData) = m_nIp;
 	pData += 4;
 
 	m_tAnswerLocalIp.nSize = static_cast<uint32_t>(pData - reinterpret_cast<uint8_t*>(pHeader));
+	m_tAnswerLocalIp.aAnswers[0].nOffset = sizeof(struct TmDNSHeader);
+	m_tAnswerLocalIp.aAnswers[0].nSize = static_cast<uint16_t>(m_tAnswerLocalIp.nSize - sizeof(struct TmDNSHeader));
 
 	DEBUG1_EXIT
 }
@@ -455,40 +462,287 @@ uint32_t MDNS::CreateAnswerServiceDnsSd(uint32_t nIndex, uint8_t *pDestination)
 	return static_cast<uint32_t>(pDst - pDestination);
 }
 
-void MDNS::HandleRequest(uint16_t nQuestions) {
+/*
+ * Returns the offset just after the (compressed) name, 0 when invalid
+ */
+uint32_t MDNS::SkipName(uint32_t nOffset) const {
+	while (nOffset < m_nBytesReceived) {
+		const auto nLength = m_pBuffer[nOffset];
+
+		if (nLength == 0) {
+			return nOffset + 1;
+		}
+
+		if ((nLength & 0xC0) == 0xC0) {
+			return nOffset + 2;
+		}
+
+		nOffset += 1U + nLength;
+	}
+
+	return 0;
+}
+
+/*
+ * Compares the (compressed) name in the received packet with
+ * the uncompressed wire format name. DNS names are case insensitive.
+ */
+bool MDNS::IsNameEqual(uint32_t nOffset, const uint8_t *pName) const {
+	uint32_t nPointers = 0;
+
+	for (;;) {
+		if (nOffset >= m_nBytesReceived) {
+			return false;
+		}
+
+		const auto nLength = m_pBuffer[nOffset];
+
+		if ((nLength & 0xC0) == 0xC0) {
+			if ((nOffset + 1 >= m_nBytesReceived) || (++nPointers > 16)) {
+				return false;
+			}
+
+			nOffset = (static_cast<uint32_t>(nLength & 0x3F) << 8) | m_pBuffer[nOffset + 1];
+			continue;
+		}
+
+		if (nLength != *pName) {
+			return false;
+		}
+
+		if (nLength == 0) {
+			return true;
+		}
+
+		nOffset++;
+		pName++;
+
+		if (nOffset + nLength > m_nBytesReceived) {
+			return false;
+		}
+
+		for (uint32_t i = 0; i < nLength; i++) {
+			if (to_lower(m_pBuffer[nOffset + i]) != to_lower(pName[i])) {
+				return false;
+			}
+		}
+
+		nOffset += nLength;
+		pName += nLength;
+	}
+}
+
+/*
+ * RFC 6762, 7.1. Known-Answer Suppression
+ */
+bool MDNS::IsKnownAnswer(uint32_t nOffset, const uint8_t *pRecord) const {
+	const auto nEnd = SkipName(nOffset);
+
+	if ((nEnd == 0) || ((nEnd + 10) > m_nBytesReceived)) {
+		return false;
+	}
+
+	if (!IsNameEqual(nOffset, pRecord)) {
+		return false;
+	}
+
+	const auto *pFixed = pRecord;
+
+	while (*pFixed != 0) {
+		pFixed += 1 + *pFixed;
+	}
+	pFixed++;
+
+	const auto *pKnown = &m_pBuffer[nEnd];
+
+	if ((pKnown[0] != pFixed[0]) || (pKnown[1] != pFixed[1])) {
+		return false;	// Type
+	}
+
+	if (((pKnown[2] & 0x7F) != (pFixed[2] & 0x7F)) || (pKnown[3] != pFixed[3])) {
+		return false;	// Class, without the cache flush bit
+	}
+
+	const auto nTTL = (static_cast<uint32_t>(pKnown[4]) << 24) | (static_cast<uint32_t>(pKnown[5]) << 16) | (static_cast<uint32_t>(pKnown[6]) << 8) | pKnown[7];
+
+	if (nTTL < (MDNS_RESPONSE_TTL / 2)) {
+		return false;
+	}
+
+	const auto nKnownLength = (static_cast<uint32_t>(pKnown[8]) << 8) | pKnown[9];
+
+	if ((nEnd + 10 + nKnownLength) > m_nBytesReceived) {
+		return false;
+	}
+
+	if (pFixed[1] == DNSRecordTypePTR) {
+		return IsNameEqual(nEnd + 10, &pFixed[10]);
+	}
+
+	const auto nLength = (static_cast<uint32_t>(pFixed[8]) << 8) | pFixed[9];
+
+	return (nKnownLength == nLength) && (memcmp(&pKnown[10], &pFixed[10], nLength) == 0);
+}
+
+const uint8_t *MDNS::GetAnswer(uint32_t nAnswer, uint32_t& nSize) const {
+	if (nAnswer == ANSWER_A) {
+		nSize = m_tAnswerLocalIp.aAnswers[0].nSize;
+		return &m_tAnswerLocalIp.aBuffer[m_tAnswerLocalIp.aAnswers[0].nOffset];
+	}
+
+	const auto nIndex = (nAnswer - 1) / SERVICE_ANSWERS;
+	const auto& answer = m_aServiceRecordsData[nIndex].aAnswers[(nAnswer - 1) % SERVICE_ANSWERS];
+
+	nSize = answer.nSize;
+	return &m_aServiceRecordsData[nIndex].aBuffer[answer.nOffset];
+}
+
+/*
+ * All the answers for a query are combined in one message
+ */
+void MDNS::SendAnswers(uint32_t nAnswers, uint32_t nAdditionals) {
 	DEBUG_ENTRY
+	DEBUG_PRINTF("nAnswers=%x, nAdditionals=%x", nAnswers, nAdditionals);
+
+	auto *pHeader = reinterpret_cast<struct TmDNSHeader*>(m_pOutBuffer);
+
+	pHeader->xid = 0;
+	pHeader->nFlags = __builtin_bswap16(0x8400);
+	pHeader->queryCount = 0;
+	pHeader->authorityCount = 0;
+
+	uint32_t nSize = sizeof(struct TmDNSHeader);
+	uint16_t aCount[2] = { 0, 0 };
+	const uint32_t aRecords[2] = { nAnswers, nAdditionals };
+
+	for (uint32_t nSection = 0; nSection < 2; nSection++) {
+		auto nRecords = aRecords[nSection];
 
-	char DnsName[255];
+		while (nRecords != 0) {
+			const auto nAnswer = static_cast<uint32_t>(__builtin_ctz(nRecords));
+			nRecords &= (nRecords - 1);
 
+			uint32_t nLength;
+			const auto *pAnswer = GetAnswer(nAnswer, nLength);
+
+			if ((nSize + nLength) > BUFFER_SIZE) {
+				pHeader->answerCount = __builtin_bswap16(aCount[0]);
+				pHeader->additionalCount = __builtin_bswap16(aCount[1]);
+				Network::Get()->SendTo(m_nHandle, m_pOutBuffer, static_cast<uint16_t>(nSize), m_nMulticastIp, MDNS_PORT);
+
+				nSize = sizeof(struct TmDNSHeader);
+				aCount[0] = 0;
+				aCount[1] = 0;
+			}
+
+			memcpy(&m_pOutBuffer[nSize], pAnswer, nLength);
+			nSize += nLength;
+			aCount[nSection]++;
+		}
+	}
+
+	if ((aCount[0] + aCount[1]) != 0) {
+		pHeader->answerCount = __builtin_bswap16(aCount[0]);
+		pHeader->additionalCount = __builtin_bswap16(aCount[1]);
+		Network::Get()->SendTo(m_nHandle, m_pOutBuffer, static_cast<uint16_t>(nSize), m_nMulticastIp, MDNS_PORT);
+	}
+
+	DEBUG_EXIT
+}
+
+void MDNS::HandleRequest(uint16_t nQuestions, uint16_t nKnownAnswers) {
+	DEBUG_ENTRY
+
+	uint32_t nAnswers = 0;
+	uint32_t nAdditionals = 0;
 	uint32_t nOffset = sizeof(struct TmDNSHeader);
 
-	for (uint32_t i = 0; i < nQuestions; i++) {
-		nOffset += DecodeDNSNameNotation(reinterpret_cast<const char*>(&m_pBuffer[nOffset]), DnsName);
+	for (uint32_t nQuestion = 0; nQuestion < nQuestions; nQuestion++) {
+		const auto nNameOffset = nOffset;
+
+		nOffset = SkipName(nOffset);
+
+		if ((nOffset == 0) || ((nOffset + 4) > m_nBytesReceived)) {
+			DEBUG_EXIT
+			return;
+		}
+
+		const uint16_t nType = static_cast<uint16_t>((m_pBuffer[nOffset] << 8) | m_pBuffer[nOffset + 1]);
+		const uint16_t nClass = static_cast<uint16_t>(((m_pBuffer[nOffset + 2] << 8) | m_pBuffer[nOffset + 3]) & 0x7FFF);
+		nOffset += 4;
 
-		const uint16_t nType = __builtin_bswap16(*reinterpret_cast<uint16_t*>(&m_pBuffer[nOffset]));
-		nOffset += 2;
+		DEBUG_PRINTF("Type : %d, Class: %d", nType, nClass);
 
-		const uint16_t nClass = __builtin_bswap16(*reinterpret_cast<uint16_t*>(&m_pBuffer[nOffset])) & 0x7F;
-		nOffset += 2;
+		if ((nClass != DNSClassInternet) && (nClass != DNSClassAny)) {
+			continue;
+		}
 
-		DEBUG_PRINTF("%s ==> Type : %d, Class: %d", DnsName, nType, nClass);
+		const bool isAny = (nType == DNSRecordTypeANY);
+
+		if ((isAny || (nType == DNSRecordTypeA)) && IsNameEqual(nNameOffset, &m_tAnswerLocalIp.aBuffer[m_tAnswerLocalIp.aAnswers[0].nOffset])) {
+			nAnswers |= (1U << ANSWER_A);
+		}
 
-		if (nClass == DNSClassInternet) {
-			if ((strcmp(m_pName, DnsName) == 0) && (nType == DNSRecordTypeA)) {
-				Network::Get()->SendTo(m_nHandle, m_tAnswerLocalIp.aBuffer, m_tAnswerLocalIp.nSize, m_nMulticastIp, MDNS_PORT);
+		for (uint32_t i = 0; i < SERVICE_RECORDS_MAX; i++) {
+			if (m_aServiceRecords[i].pName == nullptr) {
+				continue;
 			}
 
-			const bool isDnsDs = (strcmp(DNS_SD_SERVICE, DnsName) == 0);
+			const auto *pData = m_aServiceRecordsData[i].aBuffer;
+			const auto *pAnswers = m_aServiceRecordsData[i].aAnswers;
 
-			for (uint32_t i = 0; i < SERVICE_RECORDS_MAX; i++) {
-				if (m_aServiceRecords[i].pName != nullptr) {
-					if ((isDnsDs || (strcmp(m_aServiceRecords[i].pServName, DnsName) == 0)) && (nType == DNSRecordTypePTR) ) {
-						Network::Get()->SendTo(m_nHandle, &m_aServiceRecordsData[i].aBuffer, m_aServiceRecordsData[i].nSize, m_nMulticastIp, MDNS_PORT);
-					}
+			if (isAny || (nType == DNSRecordTypePTR)) {
+				if (IsNameEqual(nNameOffset, &pData[pAnswers[ServiceAnswerPtr].nOffset])) {
+					nAnswers |= (1U << ANSWER_SERVICE(i, ServiceAnswerPtr));
+					nAdditionals |= (1U << ANSWER_SERVICE(i, ServiceAnswerSrv)) | (1U << ANSWER_SERVICE(i, ServiceAnswerTxt)) | (1U << ANSWER_A);
+				} else if (IsNameEqual(nNameOffset, &pData[pAnswers[ServiceAnswerDnsSd].nOffset])) {
+					nAnswers |= (1U << ANSWER_SERVICE(i, ServiceAnswerDnsSd));
 				}
 			}
+
+			if ((isAny || (nType == DNSRecordTypeSRV) || (nType == DNSRecordTypeTXT)) && IsNameEqual(nNameOffset, &pData[pAnswers[ServiceAnswerSrv].nOffset])) {
+				if (nType != DNSRecordTypeTXT) {
+					nAnswers |= (1U << ANSWER_SERVICE(i, ServiceAnswerSrv));
+					nAdditionals |= (1U << ANSWER_A);
+				}
+				if (nType != DNSRecordTypeSRV) {
+					nAnswers |= (1U << ANSWER_SERVICE(i, ServiceAnswerTxt));
+				}
+			}
+		}
+	}
+
+	/*
+	 * The known answers follow the questions
+	 */
+	for (uint32_t nKnownAnswer = 0; (nKnownAnswer < nKnownAnswers) && (nAnswers != 0); nKnownAnswer++) {
+		const auto nEnd = SkipName(nOffset);
+
+		if ((nEnd == 0) || ((nEnd + 10) > m_nBytesReceived)) {
+			break;
+		}
+
+		auto nRecords = nAnswers;
+
+		while (nRecords != 0) {
+			const auto nAnswer = static_cast<uint32_t>(__builtin_ctz(nRecords));
+			nRecords &= (nRecords - 1);
+
+			uint32_t nLength;
+
+			if (IsKnownAnswer(nOffset, GetAnswer(nAnswer, nLength))) {
+				DEBUG_PRINTF("Known answer %u", nAnswer);
+				nAnswers &= ~(1U << nAnswer);
+			}
 		}
 
+		nOffset = nEnd + 10 + ((static_cast<uint32_t>(m_pBuffer[nEnd + 8]) << 8) | m_pBuffer[nEnd + 9]);
+	}
+
+	nAdditionals &= ~nAnswers;
+
+	if (nAnswers != 0) {
+		SendAnswers(nAnswers, nAdditionals);
 	}
 
 	DEBUG_EXIT
@@ -504,9 +758,13 @@ void MDNS::Parse() {
 	Dump(pmDNSHeader, nFlags);
 #endif
 
+	if (__builtin_expect((m_nIp != Network::Get()->GetIp()), 0)) {
+		CreateAnswers();
+	}
+
 	if ((((nFlags >> 15) & 1) == 0) && (((nFlags >> 14) & 0xf) == DNSOpQuery)) {
 		if (pmDNSHeader->queryCount != 0) {
-			HandleRequest(__builtin_bswap16(pmDNSHeader->queryCount));
+			HandleRequest(__builtin_bswap16(pmDNSHeader->queryCount), __builtin_bswap16(pmDNSHeader->answerCount));
 		}
 	}
 
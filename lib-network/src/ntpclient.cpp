@@ -2,7 +2,7 @@
  * @file ntpclient.cpp
  *
  */
-/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2020-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -47,9 +47,19 @@ extern "C" {
 
 static constexpr auto RETRIES = 3;
 static constexpr auto TIMEOUT_MILLIS = 3000; 	// 3 seconds
-static constexpr auto POLL_SECONDS = 1024;		// 2ˆ10
+static constexpr auto MINPOLL_SECONDS = 64;		// 2ˆ6
+static constexpr auto MAXPOLL_SECONDS = 1024;	// 2ˆ10
 static constexpr auto JAN_1970 = 0x83aa7e80; 	// 2208988800 1970 - 1900 in seconds
 
+static constexpr int64_t MICROS_PER_SECOND = 1000000;
+static constexpr int64_t STEP_THRESHOLD_MICROS = 128000;	// RFC 5905, larger offsets are stepped
+static constexpr int64_t POLL_UP_THRESHOLD_MICROS = 2000;	// Below this offset the poll interval is increased
+static constexpr int32_t MAX_SLEW_MICROS = 500;				// Per second, 500 ppm
+static constexpr int32_t MAX_DRIFT_PPB = 500000;			// 500 ppm
+static constexpr auto DRIFT_GAIN_SHIFT = 2;					// Frequency loop gain 1/4
+static constexpr int64_t PHI_PPM = 15;						// RFC 5905, dispersion rate
+static constexpr int64_t DELAY_MARGIN_MICROS = 1000;
+
 /* How to multiply by 4294.967296 quickly (and not quite exactly)
  * without using floating point or greater than 32-bit integers.
  * If you want to fix the last 12 microseconds of error, add in
@@ -88,6 +98,10 @@ NtpClient::NtpClient(uint32_t nServerIp): m_nServerIp(nServerIp) {
 	memset(&m_Request, 0, sizeof m_Request);
 	memset(&m_Reply, 0, sizeof m_Reply);
 
+	memset(&m_Stats, 0, sizeof m_Stats);
+	m_nPollSeconds = MINPOLL_SECONDS;
+	m_Stats.nPollSeconds = m_nPollSeconds;
+
 	m_Request.LiVnMode = NTP_VERSION | NTP_MODE_CLIENT;
 	m_Request.Poll = 10; // Poll: 1024 seconds
 	m_Request.ReferenceID = ('A' << 0) | ('V' << 8) | ('S' << 16);
@@ -150,54 +164,229 @@ bool NtpClient::Receive() {
 	return true;
 }
 
-void NtpClient::Difference(const struct TimeStamp *Start, const struct TimeStamp *Stop, int32_t &nDiffSeconds, uint32_t &nDiffMicros) {
-	nDiffSeconds = static_cast<int32_t>(Stop->nSeconds - Start->nSeconds);
-	uint32_t nDiffFraction;
+int64_t NtpClient::ToMicros(const struct TimeStamp *pTimeStamp) {
+	return (static_cast<int64_t>(pTimeStamp->nSeconds) * 1000000) + static_cast<int64_t>(USEC(pTimeStamp->nFraction));
+}
 
-	if (Stop->nFraction >= Start->nFraction) {
-		nDiffFraction = Stop->nFraction - Start->nFraction;
-	} else {
-		nDiffFraction = Start->nFraction - Stop->nFraction;
-		nDiffFraction = ~nDiffFraction;
-		nDiffSeconds -= 1;
+/*
+ * offset = ((T2 - T1) + (T3 - T4)) / 2
+ * delay  = (T4 - T1) - (T3 - T2)
+ */
+void NtpClient::Process() {
+	const auto nT1 = ToMicros(&T1);
+	const auto nT2 = ToMicros(&T2);
+	const auto nT3 = ToMicros(&T3);
+	const auto nT4 = ToMicros(&T4);
+
+	auto& sample = m_Filter[m_nFilterIndex];
+
+	sample.nOffsetMicros = ((nT2 - nT1) + (nT3 - nT4)) / 2;
+	sample.nDelayMicros = (nT4 - nT1) - (nT3 - nT2);
+	sample.nMillis = Hardware::Get()->Millis();
+
+	if (sample.nDelayMicros < 0) {
+		sample.nDelayMicros = 0;
+	}
+
+	DEBUG_PRINTF("offset=%d, delay=%d", static_cast<int>(sample.nOffsetMicros), static_cast<int>(sample.nDelayMicros));
+
+	m_nFilterIndex = (m_nFilterIndex + 1) & (ntpclient::FILTER_SAMPLES - 1);
+
+	if (m_nFilterCount < ntpclient::FILTER_SAMPLES) {
+		m_nFilterCount++;
 	}
 
-	nDiffMicros = USEC(nDiffFraction);
+	m_Stats.nSamples++;
+
+	struct Sample selected;
 
-	DEBUG_PRINTF("Seconds  %u - %u = %d", Stop->nSeconds, Start->nSeconds, nDiffSeconds);
-	DEBUG_PRINTF("Micros   %u - %u = %u", USEC(Stop->nFraction), USEC(Start->nFraction), nDiffMicros);
+	if (ClockFilter(selected)) {
+		Discipline(selected);
+	}
 }
 
-int NtpClient::SetTimeOfDay() {
-	int32_t nDiffSeconds1, nDiffSeconds2 ;
-	uint32_t nDiffFraction1, nDiffFraction2;
+/*
+ * RFC 5905 clock filter: the sample with the lowest round-trip delay
+ * is the most accurate one. The dispersion grows with the age of a sample,
+ * so an old low delay sample cannot block the newer ones. A sample is used only once.
+ */
+bool NtpClient::ClockFilter(struct Sample& selected) {
+	assert(m_nFilterCount != 0);
+
+	const auto nMillisLatest = m_Filter[(m_nFilterIndex - 1) & (ntpclient::FILTER_SAMPLES - 1)].nMillis;
+	auto nDelayMin = m_Filter[0].nDelayMicros;
+
+	for (uint32_t i = 1; i < m_nFilterCount; i++) {
+		if (m_Filter[i].nDelayMicros < nDelayMin) {
+			nDelayMin = m_Filter[i].nDelayMicros;
+		}
+	}
+
+	// Delay spikes are not selected, whatever their age
+	const auto nDelayMax = (2 * nDelayMin) + DELAY_MARGIN_MICROS;
+	uint32_t nSelected = 0;
+	int64_t nDistanceMin = 0x7FFFFFFFFFFFFFFF;
 
-	Difference(&T1, &T2, nDiffSeconds1, nDiffFraction1);
-	Difference(&T4, &T3, nDiffSeconds2, nDiffFraction2);
+	for (uint32_t i = 0; i < m_nFilterCount; i++) {
+		if (m_Filter[i].nDelayMicros > nDelayMax) {
+			continue;
+		}
 
-	m_nOffsetSeconds = nDiffSeconds1 + nDiffSeconds2;
-	m_nOffsetMicros = nDiffFraction1 + nDiffFraction2;
+		const auto nDistance = (m_Filter[i].nDelayMicros / 2) + ((static_cast<int64_t>(nMillisLatest - m_Filter[i].nMillis) * PHI_PPM) / 1000);
 
-	if (m_nOffsetMicros >= 1E6) {
-		m_nOffsetMicros -= 1E6	;
-		m_nOffsetSeconds += 1;
+		if (nDistance < nDistanceMin) {
+			nDistanceMin = nDistance;
+			nSelected = i;
+		}
 	}
 
-	m_nOffsetSeconds /= 2;
-	m_nOffsetMicros /= 2;
+	selected = m_Filter[nSelected];
 
-	struct timeval tv;
+	uint64_t nSum = 0;
+
+	for (uint32_t i = 0; i < m_nFilterCount; i++) {
+		const auto nDifference = m_Filter[i].nOffsetMicros - selected.nOffsetMicros;
+		nSum += static_cast<uint64_t>(nDifference * nDifference);
+	}
+
+	auto nMean = nSum / m_nFilterCount;
+	uint64_t nJitter = 0;
+
+	for (uint64_t nBit = 1ULL << 62; nBit != 0; nBit >>= 2) {
+		if (nMean >= nJitter + nBit) {
+			nMean -= nJitter + nBit;
+			nJitter = (nJitter >> 1) + nBit;
+		} else {
+			nJitter >>= 1;
+		}
+	}
+
+	m_Stats.nJitterMicros = static_cast<uint32_t>(nJitter);
 
-	tv.tv_sec =	static_cast<time_t>(T4.nSeconds - JAN_1970)  + m_nOffsetSeconds + m_nUtcOffset;
-	tv.tv_usec = static_cast<suseconds_t>(static_cast<int32_t>(USEC(T4.nFraction)) + static_cast<int32_t>(m_nOffsetMicros));
+	if ((m_nMillisLastUpdate != 0) && (static_cast<int32_t>(selected.nMillis - m_nMillisLastUpdate) <= 0)) {
+		DEBUG_PUTS("Sample already used");
+		return false;
+	}
+
+	return true;
+}
+
+void NtpClient::Discipline(const struct Sample& sample) {
+	m_Stats.nOffsetMicros = static_cast<int32_t>(sample.nOffsetMicros);
+	m_Stats.nDelayMicros = static_cast<uint32_t>(sample.nDelayMicros);
 
-	if (tv.tv_usec >= 1E6) {
-		tv.tv_sec++;
-		tv.tv_usec = 1E6 - tv.tv_usec;
+	const auto nOffsetAbs = sample.nOffsetMicros < 0 ? -sample.nOffsetMicros : sample.nOffsetMicros;
+
+	if (nOffsetAbs > STEP_THRESHOLD_MICROS) {
+		if (SetTimeOfDay(sample.nOffsetMicros) == 0) {
+			m_Stats.nSteps++;
+		}
+
+		// The samples in the filter are no longer valid after a step
+		m_nFilterCount = 0;
+		m_nFilterIndex = 0;
+		m_nMillisLastUpdate = 0;
+		m_nSlewRemainingMicros = 0;
+		m_nPollSeconds = MINPOLL_SECONDS;
+		m_Stats.nPollSeconds = m_nPollSeconds;
+		return;
 	}
 
-	DEBUG_PRINTF("(%ld, %d) %s ", tv.tv_sec, static_cast<int>(tv.tv_usec) , tv.tv_usec  >= 1E6 ? "!" : "");
-	DEBUG_PRINTF("%d %u",m_nOffsetSeconds, m_nOffsetMicros);
+	/*
+	 * What is left of the offset, after the pending slew has completed,
+	 * is caused by the frequency error of the local oscillator.
+	 */
+	if (m_nMillisLastUpdate != 0) {
+		const auto nIntervalMillis = static_cast<int64_t>(sample.nMillis - m_nMillisLastUpdate);
+
+		if (nIntervalMillis >= (MINPOLL_SECONDS * 1000 / 2)) {
+			const auto nResidualMicros = sample.nOffsetMicros - m_nSlewRemainingMicros;
+			auto nDrift = static_cast<int64_t>(m_Stats.nDriftPpb) + (((nResidualMicros * 1000000) / nIntervalMillis) >> DRIFT_GAIN_SHIFT);
+
+			if (nDrift > MAX_DRIFT_PPB) {
+				nDrift = MAX_DRIFT_PPB;
+			} else if (nDrift < -MAX_DRIFT_PPB) {
+				nDrift = -MAX_DRIFT_PPB;
+			}
+
+			m_Stats.nDriftPpb = static_cast<int32_t>(nDrift);
+		}
+	}
+
+	m_nMillisLastUpdate = sample.nMillis;
+	m_nSlewRemainingMicros = sample.nOffsetMicros;
+	m_Stats.nSlews++;
+
+	if (nOffsetAbs < POLL_UP_THRESHOLD_MICROS) {
+		if (m_nPollSeconds < MAXPOLL_SECONDS) {
+			m_nPollSeconds <<= 1;
+		}
+	} else if (m_nPollSeconds > MINPOLL_SECONDS) {
+		m_nPollSeconds >>= 1;
+	}
+
+	m_Stats.nPollSeconds = m_nPollSeconds;
+
+	DEBUG_PRINTF("slew=%d, drift=%d ppb, poll=%u", static_cast<int>(m_nSlewRemainingMicros), m_Stats.nDriftPpb, m_nPollSeconds);
+}
+
+/*
+ * Called every second: the phase correction is spread at max 500 ppm,
+ * the frequency correction is applied continuously.
+ */
+void NtpClient::Slew() {
+	const auto nMillis = Hardware::Get()->Millis();
+
+	if (__builtin_expect(((nMillis - m_MillisLastSlew) < 1000), 1)) {
+		return;
+	}
+
+	m_MillisLastSlew = nMillis;
+
+	int32_t nSlewMicros;
+
+	if (m_nSlewRemainingMicros > MAX_SLEW_MICROS) {
+		nSlewMicros = MAX_SLEW_MICROS;
+	} else if (m_nSlewRemainingMicros < -MAX_SLEW_MICROS) {
+		nSlewMicros = -MAX_SLEW_MICROS;
+	} else {
+		nSlewMicros = static_cast<int32_t>(m_nSlewRemainingMicros);
+	}
+
+	m_nSlewRemainingMicros -= nSlewMicros;
+
+	m_nDriftAccumulatorNanos += m_Stats.nDriftPpb; // 1 ppb during 1 second is 1 ns
+	const auto nDriftMicros = m_nDriftAccumulatorNanos / 1000;
+	m_nDriftAccumulatorNanos -= nDriftMicros * 1000;
+
+	nSlewMicros += nDriftMicros;
+
+	if (nSlewMicros == 0) {
+		return;
+	}
+
+	struct timeval delta;
+	struct timeval olddelta;
+
+	delta.tv_sec = 0;
+	delta.tv_usec = nSlewMicros;
+
+	if (adjtime(&delta, &olddelta) == 0) {
+		// Not completed from the previous second, do it later
+		m_nSlewRemainingMicros += (olddelta.tv_sec * MICROS_PER_SECOND) + olddelta.tv_usec;
+	}
+}
+
+int NtpClient::SetTimeOfDay(int64_t nOffsetMicros) {
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+
+	const int64_t nMicros = (tv.tv_sec * MICROS_PER_SECOND) + tv.tv_usec + nOffsetMicros;
+
+	tv.tv_sec = nMicros / MICROS_PER_SECOND;
+	tv.tv_usec = nMicros % MICROS_PER_SECOND;
+
+	DEBUG_PRINTF("(%d, %d)", static_cast<int>(tv.tv_sec), static_cast<int>(tv.tv_usec));
 
 	return settimeofday(&tv, nullptr);
 }
@@ -239,11 +428,8 @@ void NtpClient::Start() {
 		}
 
 		if ((m_Reply.LiVnMode & NTP_MODE_SERVER) == NTP_MODE_SERVER) {
-			if (SetTimeOfDay() == 0) {
-				m_tStatus = NtpClientStatus::IDLE;
-			} else {
-				// Error
-			}
+			Process();
+			m_tStatus = NtpClientStatus::IDLE;
 		} else {
 			DEBUG_PUTS("!>> Invalid reply <<!");
 		}
@@ -252,6 +438,7 @@ void NtpClient::Start() {
 	}
 
 	m_MillisLastPoll = Hardware::Get()->Millis();
+	m_MillisLastSlew = m_MillisLastPoll;
 
 	if (nRetries == RETRIES) {
 		m_tStatus = NtpClientStatus::FAILED;
@@ -288,8 +475,14 @@ void NtpClient::Run() {
 		return;
 	}
 
+	if (__builtin_expect((m_tStatus == NtpClientStatus::STOPPED), 0)) {
+		return;
+	}
+
+	Slew();
+
 	if ((m_tStatus == NtpClientStatus::IDLE) || (m_tStatus == NtpClientStatus::FAILED)) {
-		if (__builtin_expect(((Hardware::Get()->Millis() - m_MillisLastPoll) > (1000 * POLL_SECONDS)), 0)) {
+		if (__builtin_expect(((Hardware::Get()->Millis() - m_MillisLastPoll) > (1000 * m_nPollSeconds)), 0)) {
 			Send();
 			m_MillisRequest = Hardware::Get()->Millis();
 			m_tStatus = NtpClientStatus::WAITING;
@@ -316,15 +509,12 @@ void NtpClient::Run() {
 		if (__builtin_expect(((m_Reply.LiVnMode & NTP_MODE_SERVER) == NTP_MODE_SERVER), 1)) {
 			m_MillisLastPoll = Hardware::Get()->Millis();
 
-			if (SetTimeOfDay() == 0) {
+			Process();
 #ifndef NDEBUG
-				const time_t nTime = time(nullptr);
-				const struct tm *pLocalTime = localtime(&nTime);
-				DEBUG_PRINTF("%.4d/%.2d/%.2d %.2d:%.2d:%.2d", pLocalTime->tm_year, pLocalTime->tm_mon, pLocalTime->tm_mday, pLocalTime->tm_hour, pLocalTime->tm_min, pLocalTime->tm_sec);
+			const time_t nTime = time(nullptr);
+			const struct tm *pLocalTime = localtime(&nTime);
+			DEBUG_PRINTF("%.4d/%.2d/%.2d %.2d:%.2d:%.2d", pLocalTime->tm_year, pLocalTime->tm_mon, pLocalTime->tm_mday, pLocalTime->tm_hour, pLocalTime->tm_min, pLocalTime->tm_sec);
 #endif
-			} else {
-				// Error
-			}
 		} else {
 			DEBUG_PUTS("!>> Invalid reply <<!");
 		}
@@ -351,6 +541,9 @@ void NtpClient::Print() {
 	printf(" Server : " IPSTR ":%d\n", IP2STR(m_nServerIp), NTP_UDP_PORT);
 	printf(" Status : %d\n", static_cast<int>(m_tStatus));
 	printf(" UTC offset : %d (seconds)\n", m_nUtcOffset);
+	printf(" Offset : %d us, Delay : %u us, Jitter : %u us\n", m_Stats.nOffsetMicros, m_Stats.nDelayMicros, m_Stats.nJitterMicros);
+	printf(" Drift : %d ppb, Poll : %u s\n", m_Stats.nDriftPpb, m_Stats.nPollSeconds);
+	printf(" Samples : %u, Steps : %u, Slews : %u\n", m_Stats.nSamples, m_Stats.nSteps, m_Stats.nSlews);
 	// Debug ONLY
 	PrintNtpTime("Originate", &T1);
 	PrintNtpTime("Receive", &T2);
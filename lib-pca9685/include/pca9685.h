@@ -82,6 +82,20 @@ public:
 	void SetFullOn(uint8_t, bool);
 	void SetFullOff(uint8_t, bool);
 
+	/**
+	 * Frame level output: Stage only updates the shadow registers,
+	 * Update writes the changed channel range in one auto-increment burst.
+	 */
+	void Stage(uint8_t nChannel, uint16_t nOn, uint16_t nOff);
+	void Update();
+
+	/**
+	 * Number of I2C register accesses, a burst counts as one
+	 */
+	uint32_t GetTransactions() const {
+		return m_nTransactions;
+	}
+
 	void Dump();
 
 private:
@@ -91,6 +105,7 @@ private:
 private:
 	void Sleep(bool);
 	void AutoIncrement(bool);
+	void SetShadow(uint16_t *pShadow, uint8_t nChannel, bool bFull);
 
 private:
 	void I2cSetup();
@@ -105,6 +120,11 @@ private:
 
 private:
 	uint8_t m_nAddress;
+	uint8_t m_nDirtyFirst { PCA9685_PWM_CHANNELS };
+	uint8_t m_nDirtyLast { 0 };
+	uint32_t m_nTransactions { 0 };
+	uint16_t m_aOn[PCA9685_PWM_CHANNELS];
+	uint16_t m_aOff[PCA9685_PWM_CHANNELS];
 };
 
 #endif /* PCA9685_H_ */
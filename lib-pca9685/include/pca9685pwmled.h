@@ -40,6 +40,11 @@ public:
 	void Set(uint8_t nChannel, uint16_t nData);
 	void Set(uint8_t nChannel, uint8_t nData);
 
+	/**
+	 * Buffered variant of Set, the output is written with Update()
+	 */
+	void Stage(uint8_t nChannel, uint8_t nData);
+
 private:
 };
 
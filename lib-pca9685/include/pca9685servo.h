@@ -55,10 +55,18 @@ public:
 
 	void SetAngle(uint8_t nChannel, uint8_t nAngle);
 
+	/**
+	 * Buffered variant of Set, the output is written with Update()
+	 */
+	void Stage(uint8_t nChannel, uint8_t nData) {
+		PCA9685::Stage(nChannel, 0, m_aCount[nData]);
+	}
+
 private:
 	void CalcLeftCount();
 	void CalcRightCount();
 	void CalcCenterCount();
+	void CalcCounts();
 
 private:
 	uint16_t m_nLeftUs{SERVO_LEFT_DEFAULT_US};
@@ -67,6 +75,7 @@ private:
 	uint16_t m_nLeftCount;
 	uint16_t m_nRightCount;
 	uint16_t m_nCenterCount;
+	uint16_t m_aCount[256];	///< DMX value to off count
 };
 
 #endif /* PCA9685SERVO_H_ */
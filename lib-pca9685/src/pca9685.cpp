@@ -190,13 +190,63 @@ void PCA9685::Write(uint8_t nChannel, uint16_t nOn, uint16_t nOff) {
 
 	if (nChannel <= 15) {
 		reg = PCA9685_REG_LED0_ON_L + (nChannel << 2);
+		m_aOn[nChannel] = nOn;
+		m_aOff[nChannel] = nOff;
 	} else {
 		reg = PCA9685_REG_ALL_LED_ON_L;
+		for (uint32_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+			m_aOn[i] = nOn;
+			m_aOff[i] = nOff;
+		}
 	}
 
 	I2cWriteReg(reg, nOn, nOff);
 }
 
+void PCA9685::Stage(uint8_t nChannel, uint16_t nOn, uint16_t nOff) {
+	assert(nChannel < PCA9685_PWM_CHANNELS);
+
+	if ((m_aOn[nChannel] == nOn) && (m_aOff[nChannel] == nOff)) {
+		return;
+	}
+
+	m_aOn[nChannel] = nOn;
+	m_aOff[nChannel] = nOff;
+
+	if (nChannel < m_nDirtyFirst) {
+		m_nDirtyFirst = nChannel;
+	}
+
+	if (nChannel > m_nDirtyLast) {
+		m_nDirtyLast = nChannel;
+	}
+}
+
+void PCA9685::Update() {
+	if (m_nDirtyFirst > m_nDirtyLast) {
+		return;
+	}
+
+	char buffer[1 + PCA9685_PWM_CHANNELS * 4];
+	auto *p = &buffer[1];
+
+	buffer[0] = PCA9685_REG_LED0_ON_L + (m_nDirtyFirst << 2);
+
+	for (uint32_t i = m_nDirtyFirst; i <= m_nDirtyLast; i++) {
+		*p++ = (m_aOn[i] & 0xFF);
+		*p++ = (m_aOn[i] >> 8);
+		*p++ = (m_aOff[i] & 0xFF);
+		*p++ = (m_aOff[i] >> 8);
+	}
+
+	I2cSetup();
+
+	FUNC_PREFIX(i2c_write(buffer, static_cast<uint32_t>(p - buffer)));
+
+	m_nDirtyFirst = PCA9685_PWM_CHANNELS;
+	m_nDirtyLast = 0;
+}
+
 void PCA9685::Write(uint8_t nChannel, uint16_t nValue) {
 	Write(nChannel, static_cast<uint16_t>(0), nValue);
 }
@@ -248,6 +298,7 @@ void PCA9685::SetFullOn(uint8_t nChannel, bool bMode) {
 	Data = bMode ? (Data | 0x10) : (Data & 0xEF);
 
 	I2cWriteReg(reg, Data);
+	SetShadow(m_aOn, nChannel, bMode);
 
 	if (bMode) {
 		SetFullOff(nChannel, false);
@@ -269,6 +320,16 @@ void PCA9685::SetFullOff(uint8_t nChannel, bool bMode) {
 	Data = bMode ? (Data | 0x10) : (Data & 0xEF);
 
 	I2cWriteReg(reg, Data);
+	SetShadow(m_aOff, nChannel, bMode);
+}
+
+void PCA9685::SetShadow(uint16_t *pShadow, uint8_t nChannel, bool bFull) {
+	const auto nFirst = nChannel <= 15 ? nChannel : 0U;
+	const auto nLast = nChannel <= 15 ? nChannel : 15U;
+
+	for (auto i = nFirst; i <= nLast; i++) {
+		pShadow[i] = bFull ? (pShadow[i] | 0x1000) : (pShadow[i] & 0xEFFF);
+	}
 }
 
 uint8_t PCA9685::CalcPresScale(uint16_t nFreq) {
@@ -361,6 +422,8 @@ void PCA9685::AutoIncrement(bool bMode) {
 }
 
 void PCA9685::I2cSetup() {
+	m_nTransactions++;
+
 	FUNC_PREFIX(i2c_set_address(m_nAddress));
 	FUNC_PREFIX(i2c_set_baudrate(hal::i2c::FULL_SPEED));
 }
@@ -29,6 +29,7 @@
 
 #define MAX_12BIT	(0xFFF)
 #define MAX_8BIT	(0xFF)
+#define FULL		(0x1000)	///< LEDn_ON_H / LEDn_OFF_H bit 4
 
 PCA9685PWMLed::PCA9685PWMLed(uint8_t nAddress): PCA9685(nAddress) {
 	SetFrequency(PWMLED_DEFAULT_FREQUENCY);
@@ -59,3 +60,14 @@ void PCA9685PWMLed::Set(uint8_t nChannel, uint8_t nData) {
 		Write(nChannel, nValue);
 	}
 }
+
+void PCA9685PWMLed::Stage(uint8_t nChannel, uint8_t nData) {
+	if (nData == MAX_8BIT) {
+		PCA9685::Stage(nChannel, FULL, 0);
+	} else if (nData == 0) {
+		PCA9685::Stage(nChannel, 0, FULL);
+	} else {
+		const uint16_t nValue = (nData << 4) | (nData >> 4);
+		PCA9685::Stage(nChannel, 0, nValue);
+	}
+}
@@ -42,6 +42,7 @@ PCA9685Servo::PCA9685Servo(uint8_t nAddress): PCA9685(nAddress) {
 	CalcLeftCount();
 	CalcRightCount();
 	CalcCenterCount();
+	CalcCounts();
 }
 
 PCA9685Servo::~PCA9685Servo() {
@@ -53,6 +54,7 @@ void PCA9685Servo::SetLeftUs(uint16_t nLeftUs) {
 
 	m_nLeftUs = nLeftUs;
 	CalcLeftCount();
+	CalcCounts();
 }
 
 uint16_t PCA9685Servo::GetLeftUs() const {
@@ -65,6 +67,7 @@ void PCA9685Servo::SetRightUs(uint16_t nRightUs) {
 
 	m_nRightUs = nRightUs;
 	CalcRightCount();
+	CalcCounts();
 }
 
 uint16_t PCA9685Servo::GetRightUs() const {
@@ -77,6 +80,7 @@ void PCA9685Servo::SetCenterUs(uint16_t nCenterUs) {
 
 	m_nCenterUs = nCenterUs;
 	CalcCenterCount();
+	CalcCounts();
 }
 
 uint16_t PCA9685Servo::GetCenterUs() const {
@@ -106,20 +110,24 @@ void PCA9685Servo::Set(uint8_t nChannel, uint16_t nData) {
 	Write(nChannel, nData);
 }
 
-void PCA9685Servo::Set(uint8_t nChannel, uint8_t nData) {
-
-	if (nData == 0) {
-		Write(nChannel, m_nLeftCount);
-	} else if (nData == (MAX_8BIT + 1) / 2) {
-		Write(nChannel, m_nCenterCount);
-	}  else if (nData == MAX_8BIT) {
-		Write(nChannel, m_nRightCount);
-	} else {
-		const uint16_t nCount = m_nLeftCount + (.5 + (static_cast<float>((m_nRightCount - m_nLeftCount)) / MAX_8BIT) * nData);
-		Write(nChannel, nCount);
+void PCA9685Servo::CalcCounts() {
+	for (uint32_t nData = 0; nData <= MAX_8BIT; nData++) {
+		if (nData == 0) {
+			m_aCount[nData] = m_nLeftCount;
+		} else if (nData == (MAX_8BIT + 1) / 2) {
+			m_aCount[nData] = m_nCenterCount;
+		}  else if (nData == MAX_8BIT) {
+			m_aCount[nData] = m_nRightCount;
+		} else {
+			m_aCount[nData] = m_nLeftCount + (.5 + (static_cast<float>((m_nRightCount - m_nLeftCount)) / MAX_8BIT) * nData);
+		}
 	}
 }
 
+void PCA9685Servo::Set(uint8_t nChannel, uint8_t nData) {
+	Write(nChannel, m_aCount[nData]);
+}
+
 void PCA9685Servo::SetAngle(uint8_t nChannel, uint8_t nAngle) {
 
 	if (nAngle == 0) {
@@ -41,6 +41,10 @@ public:
 	void Stop(uint8_t nPort = 0) override;
 
 	void SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Stage(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Commit() override;
+
+	void Print() override;
 
 public: // RDM
 	bool SetDmxStartAddress(uint16_t nDmxStartAddress) override;
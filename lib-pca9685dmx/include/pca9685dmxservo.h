@@ -51,6 +51,10 @@ public:
 	void Stop(uint8_t nPort = 0) override;
 
 	void SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Stage(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Commit() override;
+
+	void Print() override;
 
 public:
 	void SetI2cAddress(uint8_t nI2cAddress);
@@ -24,9 +24,7 @@
  */
 
 #include <stdint.h>
-#ifndef NDEBUG
-# include <stdio.h>
-#endif
+#include <stdio.h>
 #include <cassert>
 
 #include "pca9685dmxled.h"
@@ -86,7 +84,12 @@ void PCA9685DmxLed::Stop(__attribute__((unused)) uint8_t nPort) {
 	m_bIsStarted = false;
 }
 
-void PCA9685DmxLed::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) {
+void PCA9685DmxLed::SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) {
+	Stage(nPort, pDmxData, nLength);
+	Commit();
+}
+
+void PCA9685DmxLed::Stage(__attribute__((unused)) uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) {
 	assert(pDmxData != nullptr);
 	assert(nLength <= DMX_MAX_CHANNELS);
 
@@ -108,9 +111,9 @@ void PCA9685DmxLed::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t
 			if (*p != *q) {
 				uint8_t value = *p;
 #ifndef NDEBUG
-				printf("m_pPWMLed[%d]->SetDmx(CHANNEL(%d), %d)\n", static_cast<int>(j), static_cast<int>(i), static_cast<int>(value));
+				printf("m_pPWMLed[%d]->Stage(CHANNEL(%d), %d)\n", static_cast<int>(j), static_cast<int>(i), static_cast<int>(value));
 #endif
-				m_pPWMLed[j]->Set(CHANNEL(i), value);
+				m_pPWMLed[j]->Stage(CHANNEL(i), value);
 			}
 			*q = *p;
 			p++;
@@ -120,6 +123,36 @@ void PCA9685DmxLed::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t
 	}
 }
 
+void PCA9685DmxLed::Commit() {
+	if (__builtin_expect((m_pPWMLed == nullptr), 0)) {
+		return;
+	}
+
+	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		m_pPWMLed[j]->Update();
+	}
+}
+
+void PCA9685DmxLed::Print() {
+	printf("PCA9685 LED\n");
+	printf(" Address   : 0x%.2x, Boards=%d\n", m_nI2cAddress, m_nBoardInstances);
+	printf(" Frequency : %d Hz\n", m_nPwmFrequency);
+	printf(" Output    : %s, %s\n", m_bOutputInvert ? "Inverted" : "Normal", m_bOutputDriver ? "Totem pole" : "Open drain");
+	printf(" DMX       : StartAddress=%d, FootPrint=%d\n", m_nDmxStartAddress, m_nDmxFootprint);
+
+	if (m_pPWMLed == nullptr) {
+		return;
+	}
+
+	uint32_t nTransactions = 0;
+
+	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		nTransactions += m_pPWMLed[j]->GetTransactions();
+	}
+
+	printf(" I2C       : %d transactions\n", static_cast<int>(nTransactions));
+}
+
 bool PCA9685DmxLed::SetDmxStartAddress(uint16_t nDmxStartAddress) {
 	assert((nDmxStartAddress != 0) && (nDmxStartAddress <= DMX_MAX_CHANNELS));
 
@@ -24,9 +24,7 @@
  */
 
 #include <stdint.h>
-#ifndef NDEBUG
-# include <stdio.h>
-#endif
+#include <stdio.h>
 #include <cassert>
 
 #include "pca9685dmxservo.h"
@@ -83,7 +81,12 @@ void PCA9685DmxServo::Stop(__attribute__((unused)) uint8_t nPort) {
 	m_bIsStarted = false;
 }
 
-void PCA9685DmxServo::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t* pDmxData, uint16_t nLength) {
+void PCA9685DmxServo::SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) {
+	Stage(nPort, pDmxData, nLength);
+	Commit();
+}
+
+void PCA9685DmxServo::Stage(__attribute__((unused)) uint8_t nPort, const uint8_t* pDmxData, uint16_t nLength) {
 	assert(pDmxData != nullptr);
 	assert(nLength <= DMX_MAX_CHANNELS);
 
@@ -105,9 +108,9 @@ void PCA9685DmxServo::SetData(__attribute__((unused)) uint8_t nPort, const uint8
 			if (*p != *q) {
 				uint8_t value = *p;
 #ifndef NDEBUG
-				printf("m_pServo[%d]->SetDmx(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
+				printf("m_pServo[%d]->Stage(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
 #endif
-				m_pServo[j]->Set(CHANNEL(i), value);
+				m_pServo[j]->Stage(CHANNEL(i), value);
 			}
 			*q = *p;
 			p++;
@@ -117,6 +120,35 @@ void PCA9685DmxServo::SetData(__attribute__((unused)) uint8_t nPort, const uint8
 	}
 }
 
+void PCA9685DmxServo::Commit() {
+	if (__builtin_expect((m_pServo == nullptr), 0)) {
+		return;
+	}
+
+	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		m_pServo[j]->Update();
+	}
+}
+
+void PCA9685DmxServo::Print() {
+	printf("PCA9685 Servo\n");
+	printf(" Address   : 0x%.2x, Boards=%d\n", m_nI2cAddress, m_nBoardInstances);
+	printf(" Pulse     : Left=%d us, Right=%d us\n", m_nLeftUs, m_nRightUs);
+	printf(" DMX       : StartAddress=%d, FootPrint=%d\n", m_nDmxStartAddress, m_nDmxFootprint);
+
+	if (m_pServo == nullptr) {
+		return;
+	}
+
+	uint32_t nTransactions = 0;
+
+	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		nTransactions += m_pServo[j]->GetTransactions();
+	}
+
+	printf(" I2C       : %d transactions\n", static_cast<int>(nTransactions));
+}
+
 void PCA9685DmxServo::SetI2cAddress(uint8_t nI2cAddress) {
 	m_nI2cAddress = nI2cAddress;
 }
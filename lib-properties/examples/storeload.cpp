@@ -0,0 +1,379 @@
+/**
+ * @file storeload.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Loads every store that dispatches on the key hash: artnet.txt, e131.txt,
+ * ltc.txt and devices.txt, as at boot or through the remote configuration.
+ * The configuration text is the output of the Builder with every key
+ * uncommented, so all the keys are present.
+ *
+ * Checked: each line loaded on its own into new params changes the stored
+ * params, so no key falls through the switch.
+ * Timed: the boot load of all the stores, and the dispatch itself, the
+ * key hash against testing the line against every name in turn as before.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "artnetparams.h"
+#include "artnetnode.h"
+#include "e131params.h"
+#include "ltcparams.h"
+#include "ws28xxdmxparams.h"
+
+#include "propertieskey.h"
+
+#include "network.h"
+
+static constexpr uint32_t BUFFER_SIZE = 8192;
+static constexpr uint32_t LOOPS = 2000;
+
+static uint32_t s_nFailed;
+
+static void result(const char *pTest, bool bPass) {
+	if (!bPass) {
+		s_nFailed++;
+	}
+
+	printf("%-40s %s\n", pTest, bPass ? "PASS" : "FAIL");
+}
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/*
+ * The LtcParams defaults and checks use the network, the ArtNetParams Builder the node
+ */
+class NetworkStub final: public Network {
+public:
+	NetworkStub() {
+		m_nLocalIp = 0x0200000a;
+		m_nNetmask = 0x00FFFFFF;
+	}
+
+	int32_t Begin(__attribute__((unused)) uint16_t nPort) override {
+		return 0;
+	}
+
+	int32_t End(__attribute__((unused)) uint16_t nPort) override {
+		return 0;
+	}
+
+	void MacAddressCopyTo(uint8_t *pMacAddress) override {
+		memset(pMacAddress, 0, NETWORK_MAC_SIZE);
+	}
+
+	void JoinGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void LeaveGroup(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) uint32_t nIp) override {
+	}
+
+	uint16_t RecvFrom(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) void *pBuffer, __attribute__((unused)) uint16_t nLength, __attribute__((unused)) uint32_t *pFromIp, __attribute__((unused)) uint16_t *pFromPort) override {
+		return 0;
+	}
+
+	void SendTo(__attribute__((unused)) int32_t nHandle, __attribute__((unused)) const void *pBuffer, __attribute__((unused)) uint16_t nLength, __attribute__((unused)) uint32_t nToIp, __attribute__((unused)) uint16_t nRemotePort) override {
+	}
+
+	void SetIp(__attribute__((unused)) uint32_t nIp) override {
+	}
+
+	void SetNetmask(__attribute__((unused)) uint32_t nNetmask) override {
+	}
+
+	bool SetZeroconf() override {
+		return false;
+	}
+
+	bool EnableDhcp() override {
+		return false;
+	}
+};
+
+ArtNetNode *ArtNetNode::s_pThis = nullptr;
+
+/*
+ * The destination IP addresses are set, the Builder does not ask the node for them
+ */
+static void prepare(struct TArtNetParams& params) {
+	for (uint32_t i = 0; i < ARTNET_NODE_MAX_PORTS_INPUT; i++) {
+		params.nMultiPortOptions = static_cast<uint16_t>(params.nMultiPortOptions | (ArtnetParamsMaskMultiPortOptions::DESTINATION_IP_A << i));
+	}
+}
+
+template<typename T>
+static void prepare(__attribute__((unused)) T& params) {
+}
+
+/*
+ * The stores keep the params in memory
+ */
+template<class Base, typename T>
+class StoreStub: public Base {
+public:
+	void Update(const T *pParams) override {
+		memcpy(&m_Params, pParams, sizeof(T));
+	}
+
+	void Copy(T *pParams) override {
+		memcpy(pParams, &m_Params, sizeof(T));
+	}
+
+	const T& Get() const {
+		return m_Params;
+	}
+
+private:
+	T m_Params;
+};
+
+class StoreLtc final: public StoreStub<LtcParamsStore, struct TLtcParams> {
+public:
+	void SaveSource(__attribute__((unused)) uint8_t nSource) override {
+	}
+};
+
+struct Config {
+	char aText[BUFFER_SIZE];
+	uint32_t nLength;
+	uint32_t nLines;
+	const char *pLine[256];		///< Into aLines, each line '\0' terminated
+	char aLines[BUFFER_SIZE];
+};
+
+/*
+ * The Builder comments out the keys that are not set, uncomment them
+ */
+static void uncomment(const char *pBuilder, uint32_t nSize, Config& config) {
+	config.nLength = 0;
+	config.nLines = 0;
+
+	uint32_t i = 0;
+
+	while (i < nSize) {
+		const auto *pLine = &pBuilder[i];
+		const auto *pEnd = static_cast<const char *>(memchr(pLine, '\n', nSize - i));
+		const auto nLine = static_cast<uint32_t>((pEnd == nullptr ? &pBuilder[nSize] : pEnd) - pLine);
+
+		i += nLine + 1;
+
+		if ((pLine[0] == '#') && (nLine > 1) && (pLine[1] >= 'a')) {
+			pLine++;
+		}
+
+		const auto nCopy = static_cast<uint32_t>(&pBuilder[i - 1] - pLine);
+
+		if ((pLine[0] < 'a') || (memchr(pLine, '=', nCopy) == nullptr)) {
+			continue;	// Comment or file name
+		}
+
+		auto *pDst = &config.aLines[config.nLength];
+		memcpy(pDst, pLine, nCopy);
+		pDst[nCopy] = '\0';
+		config.pLine[config.nLines++] = pDst;
+
+		memcpy(&config.aText[config.nLength], pLine, nCopy);
+		config.aText[config.nLength + nCopy] = '\n';
+		config.nLength += nCopy + 1;
+	}
+}
+
+/*
+ * A line with the default value changes nothing, the check loads another value:
+ * the other enum value, another address or the last digit up or down, as one may be out of range
+ */
+static void alternative(const char *pLine, char *pOut, uint32_t nOut, bool bDown) {
+	static constexpr const char *ALTERNATIVES[][2] = {
+			{ "output", "input" }, { "htp", "ltp" }, { "artnet", "sacn" }, { "0.0.0.0", "10.0.0.9" }
+	};
+	// A range the last digit does not reach
+	static constexpr const char *LINES[][2] = {
+			{ "max_current=100", "max_current=50" }, { "layout_rotate=0", "layout_rotate=90" }
+	};
+
+	for (const auto& alt : LINES) {
+		if (strcmp(pLine, alt[0]) == 0) {
+			snprintf(pOut, nOut, "%s", alt[1]);
+			return;
+		}
+	}
+
+	const auto *pValue = strchr(pLine, '=') + 1;
+	const auto nName = static_cast<int>(pValue - pLine);
+
+	for (const auto& alt : ALTERNATIVES) {
+		if (strcmp(pValue, alt[0]) == 0) {
+			snprintf(pOut, nOut, "%.*s%s", nName, pLine, alt[1]);
+			return;
+		}
+	}
+
+	snprintf(pOut, nOut, "%s", pLine);
+
+	const auto nLength = strlen(pOut);
+
+	if (pOut[nName] == '\0') {
+		snprintf(&pOut[nName], nOut - static_cast<uint32_t>(nName), "x");
+	} else if ((pOut[nLength - 1] > '0') && (bDown || (pOut[nLength - 1] == '9'))) {
+		pOut[nLength - 1]--;
+	} else if ((pOut[nLength - 1] >= '0') && (pOut[nLength - 1] < '9')) {
+		pOut[nLength - 1]++;
+	}
+}
+
+/*
+ * As the callbacks before the key hash: Sscan compares the name and the '=', for every name until found
+ */
+static uint32_t sequential(const Config& config, const char *pLine) {
+	for (uint32_t i = 0; i < config.nLines; i++) {
+		const auto *pName = config.pLine[i];
+		const auto nName = static_cast<size_t>(strchr(pName, '=') - pName);
+
+		if ((strncmp(pLine, pName, nName) == 0) && (pLine[nName] == '=')) {
+			return i;
+		}
+	}
+
+	return config.nLines;
+}
+
+template<class Params, class Store, typename T>
+static void run(const char *pFileName, uint64_t& nLoadNanos, uint64_t& nHashNanos, uint64_t& nSequentialNanos, uint32_t& nLines) {
+	static Config config;
+	static char aBuilder[BUFFER_SIZE];
+
+	Store store;
+	Params params(&store);
+
+	// The defaults, nothing set
+	params.Load("#", 1);
+	const auto defaults = store.Get();
+
+	auto all = defaults;
+	prepare(all);
+
+	uint32_t nSize;
+	params.Builder(&all, aBuilder, sizeof(aBuilder), nSize);
+	uncomment(aBuilder, nSize, config);
+
+	uint32_t nMissed = 0;
+
+	for (uint32_t i = 0; i < config.nLines; i++) {
+		auto bDispatched = false;
+		char aLine[128];
+
+		for (uint32_t nDown = 0; (nDown < 2) && !bDispatched; nDown++) {
+			alternative(config.pLine[i], aLine, sizeof(aLine), nDown != 0);
+
+			Params fresh(&store);
+			fresh.Load(aLine, static_cast<uint32_t>(strlen(aLine)));
+
+			bDispatched = (memcmp(&store.Get(), &defaults, sizeof(T)) != 0);
+		}
+
+		if (!bDispatched) {
+			printf("  %s: not dispatched [%s]\n", pFileName, aLine);
+			nMissed++;
+		}
+	}
+
+	char aTest[64];
+	snprintf(aTest, sizeof(aTest), "%s %u keys dispatched", pFileName, config.nLines);
+	result(aTest, nMissed == 0);
+
+	auto nStart = nanos();
+
+	for (uint32_t n = 0; n < LOOPS; n++) {
+		params.Load(config.aText, config.nLength);
+	}
+
+	nLoadNanos = (nanos() - nStart) / LOOPS;
+
+	volatile uint32_t nSink = 0;
+
+	nStart = nanos();
+
+	for (uint32_t n = 0; n < LOOPS; n++) {
+		for (uint32_t i = 0; i < config.nLines; i++) {
+			nSink = nSink + properties::key(config.pLine[i]);
+		}
+	}
+
+	nHashNanos = (nanos() - nStart) / LOOPS;
+
+	nStart = nanos();
+
+	for (uint32_t n = 0; n < LOOPS; n++) {
+		for (uint32_t i = 0; i < config.nLines; i++) {
+			nSink = nSink + sequential(config, config.pLine[i]);
+		}
+	}
+
+	nSequentialNanos = (nanos() - nStart) / LOOPS;
+	nLines = config.nLines;
+}
+
+int main() {
+	NetworkStub network;
+
+	struct Timing {
+		const char *pFileName;
+		uint64_t nLoadNanos;
+		uint64_t nHashNanos;
+		uint64_t nSequentialNanos;
+		uint32_t nLines;
+	} timing[4] = {
+		{ "artnet.txt", 0, 0, 0, 0 },
+		{ "e131.txt", 0, 0, 0, 0 },
+		{ "ltc.txt", 0, 0, 0, 0 },
+		{ "devices.txt", 0, 0, 0, 0 }
+	};
+
+	run<ArtNetParams, StoreStub<ArtNetParamsStore, struct TArtNetParams>, struct TArtNetParams>(timing[0].pFileName, timing[0].nLoadNanos, timing[0].nHashNanos, timing[0].nSequentialNanos, timing[0].nLines);
+	run<E131Params, StoreStub<E131ParamsStore, struct TE131Params>, struct TE131Params>(timing[1].pFileName, timing[1].nLoadNanos, timing[1].nHashNanos, timing[1].nSequentialNanos, timing[1].nLines);
+	run<LtcParams, StoreLtc, struct TLtcParams>(timing[2].pFileName, timing[2].nLoadNanos, timing[2].nHashNanos, timing[2].nSequentialNanos, timing[2].nLines);
+	run<WS28xxDmxParams, StoreStub<WS28xxDmxParamsStore, struct TWS28xxDmxParams>, struct TWS28xxDmxParams>(timing[3].pFileName, timing[3].nLoadNanos, timing[3].nHashNanos, timing[3].nSequentialNanos, timing[3].nLines);
+
+	printf("\n%-12s %6s %12s %14s %16s\n", "Store", "Lines", "Load [ns]", "Key hash [ns]", "Sequential [ns]");
+
+	uint64_t nLoadNanos = 0;
+
+	for (const auto& t : timing) {
+		printf("%-12s %6u %12u %14u %16u\n", t.pFileName, t.nLines, static_cast<uint32_t>(t.nLoadNanos), static_cast<uint32_t>(t.nHashNanos), static_cast<uint32_t>(t.nSequentialNanos));
+		nLoadNanos += t.nLoadNanos;
+	}
+
+	printf("\nBoot load of all the stores: %u ns\n", static_cast<uint32_t>(nLoadNanos));
+
+	return s_nFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
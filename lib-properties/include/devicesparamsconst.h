@@ -27,24 +27,43 @@
 #define DEVICESPARAMSCONST_H_
 
 struct DevicesParamsConst {
-	static const char FILE_NAME[];
+	static constexpr char FILE_NAME[] = "devices.txt";
 
-	static const char TYPE[];
-	static const char MAP[];
+	static constexpr char TYPE[] = "led_type";
+	static constexpr char MAP[] = "led_rgb_mapping";
 
-	static const char LED_T0H[];
-	static const char LED_T1H[];
+	static constexpr char LED_T0H[] = "led_t0h";
+	static constexpr char LED_T1H[] = "led_t1h";
 
-	static const char COUNT[];
+	static constexpr char COUNT[] = "led_count";
 
-	static const char GROUPING_ENABLED[];
-	static const char GROUPING_COUNT[];
+	static constexpr char GROUPING_ENABLED[] = "led_grouping";
+	static constexpr char GROUPING_COUNT[] = "led_group_count";
 
-	static const char SPI_SPEED_HZ[];
+	static constexpr char SPI_SPEED_HZ[] = "clock_speed_hz";
 
-	static const char GLOBAL_BRIGHTNESS[];
+	static constexpr char GLOBAL_BRIGHTNESS[] = "global_brightness";
 
-	static const char ACTIVE_OUT[];
+	static constexpr char ACTIVE_OUT[] = "active_out";
+
+	static constexpr char GAMMA[] = "gamma";
+	static constexpr char WHITE_POINT_RED[] = "white_point_red";
+	static constexpr char WHITE_POINT_GREEN[] = "white_point_green";
+	static constexpr char WHITE_POINT_BLUE[] = "white_point_blue";
+	static constexpr char MAX_CURRENT[] = "max_current";
+
+	static constexpr char PIXEL_16BIT[] = "pixel_16bit";
+	static constexpr char PIXEL_EFFECTS[] = "pixel_effects";
+
+	static constexpr char LAYOUT_WIDTH[] = "layout_width";
+	static constexpr char LAYOUT_HEIGHT[] = "layout_height";
+	static constexpr char LAYOUT_SERPENTINE[] = "layout_serpentine";
+	static constexpr char LAYOUT_ROTATE[] = "layout_rotate";
+	static constexpr char LAYOUT_MIRROR_X[] = "layout_mirror_x";
+	static constexpr char LAYOUT_MIRROR_Y[] = "layout_mirror_y";
+	static constexpr char LAYOUT_TILES_X[] = "layout_tiles_x";
+	static constexpr char LAYOUT_TILES_Y[] = "layout_tiles_y";
+	static constexpr char LAYOUT_TILES_SERPENTINE[] = "layout_tiles_serpentine";
 };
 
 #endif /* DEVICESPARAMSCONST_H_ */
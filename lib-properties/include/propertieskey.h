@@ -0,0 +1,59 @@
+/**
+ * @file propertieskey.h
+ *
+ */
+/* Copyright (C) 2020 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PROPERTIESKEY_H_
+#define PROPERTIESKEY_H_
+
+#include <stdint.h>
+
+/**
+ * FNV-1a hash of a property key. The constexpr hash() is used for the case
+ * labels, key() hashes the "name=" part of a configuration line at runtime.
+ * A callback can then switch on the key instead of testing every name in turn.
+ * Two keys with the same hash are rejected by the compiler as duplicate case values.
+ */
+
+namespace properties {
+namespace fnv {
+static constexpr uint32_t OFFSET_BASIS = 2166136261U;
+static constexpr uint32_t PRIME = 16777619U;
+}  // namespace fnv
+
+constexpr uint32_t hash(const char *pName, uint32_t nHash = fnv::OFFSET_BASIS) {
+	return (*pName == 0) ? nHash : hash(pName + 1, (nHash ^ static_cast<uint8_t>(*pName)) * fnv::PRIME);
+}
+
+inline uint32_t key(const char *pLine) {
+	uint32_t nHash = fnv::OFFSET_BASIS;
+
+	while ((*pLine != 0) && (*pLine != '=')) {
+		nHash = (nHash ^ static_cast<uint8_t>(*pLine++)) * fnv::PRIME;
+	}
+
+	return nHash;
+}
+}  // namespace properties
+
+#endif /* PROPERTIESKEY_H_ */
@@ -25,22 +25,41 @@
 
 #include "devicesparamsconst.h"
 
-const char DevicesParamsConst::FILE_NAME[] = "devices.txt";
+constexpr char DevicesParamsConst::FILE_NAME[];
 
-const char DevicesParamsConst::TYPE[] = "led_type";
+constexpr char DevicesParamsConst::TYPE[];
 
-const char DevicesParamsConst::MAP[] = "led_rgb_mapping";
+constexpr char DevicesParamsConst::MAP[];
 
-const char DevicesParamsConst::LED_T0H[] = "led_t0h";
-const char DevicesParamsConst::LED_T1H[] = "led_t1h";
+constexpr char DevicesParamsConst::LED_T0H[];
+constexpr char DevicesParamsConst::LED_T1H[];
 
-const char DevicesParamsConst::COUNT[] = "led_count";
+constexpr char DevicesParamsConst::COUNT[];
 
-const char DevicesParamsConst::GROUPING_ENABLED[] = "led_grouping";
-const char DevicesParamsConst::GROUPING_COUNT[] = "led_group_count";
+constexpr char DevicesParamsConst::GROUPING_ENABLED[];
+constexpr char DevicesParamsConst::GROUPING_COUNT[];
 
-const char DevicesParamsConst::SPI_SPEED_HZ[] = "clock_speed_hz";
+constexpr char DevicesParamsConst::SPI_SPEED_HZ[];
 
-const char DevicesParamsConst::GLOBAL_BRIGHTNESS[] = "global_brightness";
+constexpr char DevicesParamsConst::GLOBAL_BRIGHTNESS[];
 
-const char DevicesParamsConst::ACTIVE_OUT[] = "active_out";
+constexpr char DevicesParamsConst::ACTIVE_OUT[];
+
+constexpr char DevicesParamsConst::GAMMA[];
+constexpr char DevicesParamsConst::WHITE_POINT_RED[];
+constexpr char DevicesParamsConst::WHITE_POINT_GREEN[];
+constexpr char DevicesParamsConst::WHITE_POINT_BLUE[];
+constexpr char DevicesParamsConst::MAX_CURRENT[];
+
+constexpr char DevicesParamsConst::PIXEL_16BIT[];
+constexpr char DevicesParamsConst::PIXEL_EFFECTS[];
+
+constexpr char DevicesParamsConst::LAYOUT_WIDTH[];
+constexpr char DevicesParamsConst::LAYOUT_HEIGHT[];
+constexpr char DevicesParamsConst::LAYOUT_SERPENTINE[];
+constexpr char DevicesParamsConst::LAYOUT_ROTATE[];
+constexpr char DevicesParamsConst::LAYOUT_MIRROR_X[];
+constexpr char DevicesParamsConst::LAYOUT_MIRROR_Y[];
+constexpr char DevicesParamsConst::LAYOUT_TILES_X[];
+constexpr char DevicesParamsConst::LAYOUT_TILES_Y[];
+constexpr char DevicesParamsConst::LAYOUT_TILES_SERPENTINE[];
@@ -118,6 +118,64 @@ struct ListBin {
 	char aDisplayName[remoteconfig::DISPLAY_NAME_LENGTH];
 }__attribute__((packed));
 
+/**
+ * Binary protocol, all fields are little endian.
+ * A request is a Header followed by Header::nCount records.
+ */
+namespace bin {
+static constexpr uint8_t ID[2] = { 'R', 'c' };
+static constexpr uint8_t VERSION = 1;
+
+enum class Command : uint8_t {
+	GET_VERSIONS,	///< Response: Header, Versions
+	GET,			///< Request: GetRecord[], Response: (Record + store data)[]
+	SET				///< Request: (Record + store data)[], Response: Record[]
+};
+
+enum class Status : uint8_t {
+	OK,
+	NOT_MODIFIED,	///< The store version is the same as requested, no data
+	ERROR,
+	TOO_LARGE		///< The store does not fit in a datagram, use ?store#
+};
+
+enum Flags {
+	DELTA = (1U << 0)	///< Return data only for the stores with a different version
+};
+
+struct Header {
+	uint8_t aId[2];
+	uint8_t nVersion;
+	uint8_t nCommand;
+	uint16_t nSequence;	///< Echoed in the response
+	uint8_t nCount;		///< Number of records, in the response the number of records handled
+	uint8_t nFlags;
+}__attribute__((packed));
+
+/**
+ * The versions start at 0 after a reboot, nUptime going backwards invalidates them.
+ */
+struct Versions {
+	uint32_t nUptime;
+	uint8_t nStores;
+	uint8_t nReserved;
+	uint16_t aVersion[static_cast<uint32_t>(spiflashstore::Store::LAST)];
+}__attribute__((packed));
+
+struct GetRecord {
+	uint8_t nTxtFile;
+	uint8_t nReserved;
+	uint16_t nVersion;	///< Version known by the client
+}__attribute__((packed));
+
+struct Record {
+	uint8_t nTxtFile;
+	uint8_t nStatus;
+	uint16_t nVersion;
+	uint16_t nLength;	///< Length of the store data following the record
+}__attribute__((packed));
+}  // namespace bin
+
 }  // namespace remoteconfig
 
 class RemoteConfig {
@@ -251,63 +309,63 @@ private:
 #if defined (RDM_RESPONDER)
 #endif
 
-	void HandleTxtFileRconfig();
-	void HandleTxtFileNetwork();
+	bool HandleTxtFileRconfig();
+	bool HandleTxtFileNetwork();
 
 #if defined (NODE_ARTNET)
-	void HandleTxtFileArtnet();
+	bool HandleTxtFileArtnet();
 #endif
 
 #if defined (NODE_E131)
-	void HandleTxtFileE131();
+	bool HandleTxtFileE131();
 #endif
 
 #if defined (NODE_OSC_SERVER)
-	void HandleTxtFileOsc();
+	bool HandleTxtFileOsc();
 #endif
 
 #if defined (OUTPUT_DMXSEND)
-	void HandleTxtFileParams();
+	bool HandleTxtFileParams();
 #endif
 
 #if defined (OUTPUT_PIXEL)
-	void HandleTxtFileDevices();
+	bool HandleTxtFileDevices();
 #endif
 
 #if defined (NODE_LTC_SMPTE)
-	void HandleTxtFileLtc();
-	void HandleTxtFileLtcDisplay();
-	void HandleTxtFileTCNet();
-	void HandleTxtFileGps();
+	bool HandleTxtFileLtc();
+	bool HandleTxtFileLtcDisplay();
+	bool HandleTxtFileTCNet();
+	bool HandleTxtFileGps();
 #endif
 
 #if defined (OUTPUT_DMX_MONITOR)
-	void HandleTxtFileMon();
+	bool HandleTxtFileMon();
 #endif
 
 #if defined (NODE_OSC_CLIENT)
-	void HandleTxtFileOscClient();
+	bool HandleTxtFileOscClient();
 #endif
 
 #if defined (DISPLAY_UDF)
-	void HandleTxtFileDisplay();
+	bool HandleTxtFileDisplay();
 #endif
 
 #if defined (OUTPUT_STEPPER)
-	void HandleTxtFileSparkFun();
-	void HandleTxtFileMotor(uint32_t nMotorIndex);
+	bool HandleTxtFileSparkFun();
+	bool HandleTxtFileMotor(uint32_t nMotorIndex);
 #endif
 
 #if defined(NODE_SHOWFILE)
-	void HandleTxtFileShow();
+	bool HandleTxtFileShow();
 #endif
 
 #if defined (OUTPUT_DMXSERIAL)
-	void HandleTxtFileSerial();
+	bool HandleTxtFileSerial();
 #endif
 
 #if defined (OUTPUT_RGB_PANEL)
-	void HandleTxtFileRgbPanel();
+	bool HandleTxtFileRgbPanel();
 #endif
 
 #if defined (RDM_RESPONDER)
@@ -322,6 +380,16 @@ private:
 	void HandleTftpSet();
 	void HandleTftpGet();
 
+	void HandleNtpGet();
+
+	bool IsBinary() const;
+	void HandleBinary();
+	void HandleBinaryVersions(uint32_t nSize);
+	void HandleBinaryGet(uint32_t nSize);
+	void HandleBinarySet(uint32_t nSize);
+
+	bool HandleTxtFileIndex(remoteconfig::TxtFile tTxtFile);
+
 private:
 	remoteconfig::Node m_tNode;
 	remoteconfig::Output m_tOutput;
@@ -343,6 +411,7 @@ private:
 	uint16_t m_nBytesReceived { 0 };
 	remoteconfig::HandleMode m_tHandleMode { remoteconfig::HandleMode::TXT };
 	uint8_t *m_pStoreBuffer { nullptr };
+	uint8_t *m_pBinaryBuffer { nullptr };
 	bool m_bIsReboot { false };
 
 	static RemoteConfig *s_pThis;
@@ -116,4 +116,10 @@ void Display::SetSleep(__attribute__((unused)) bool bSleep) {
 
 void Display::Run() {
 }
+
+void Display::ResetLatencyHistogram() {
+}
+
+void Display::PrintLatencyHistogram() {
+}
 #endif
@@ -35,6 +35,7 @@
 
 #include "hardware.h"
 #include "network.h"
+#include "ntpclient.h"
 #include "display.h"
 
 #include "spiflashstore.h"
@@ -183,6 +184,7 @@ static constexpr char STORE[] = "?store#";
 static constexpr char DISPLAY[] = "?display#";
 static constexpr char TFTP[] = "?tftp#";
 static constexpr char FACTORY[] = "?factory##";
+static constexpr char NTP[] = "?ntp#";
 namespace length {
 static constexpr auto REBOOT = sizeof(cmd::get::REBOOT) - 1;
 static constexpr auto LIST = sizeof(cmd::get::LIST) - 1;
@@ -193,6 +195,7 @@ static constexpr auto STORE = sizeof(cmd::get::STORE) - 1;
 static constexpr auto DISPLAY = sizeof(cmd::get::DISPLAY) - 1;
 static constexpr auto TFTP = sizeof(cmd::get::TFTP) - 1;
 static constexpr auto FACTORY = sizeof(cmd::get::FACTORY) - 1;
+static constexpr auto NTP = sizeof(cmd::get::NTP) - 1;
 }  // namespace length
 }  // namespace get
 
@@ -246,12 +249,18 @@ RemoteConfig::RemoteConfig(Node tNode, Output tMode, uint32_t nOutputs): m_tNode
 	m_pStoreBuffer = new uint8_t[udp::BUFFER_SIZE];
 	assert(m_pStoreBuffer != nullptr);
 
+	m_pBinaryBuffer = new uint8_t[udp::BUFFER_SIZE];
+	assert(m_pBinaryBuffer != nullptr);
+
 	DEBUG_EXIT
 }
 
 RemoteConfig::~RemoteConfig() {
 	DEBUG_ENTRY
 
+	delete [] m_pBinaryBuffer;
+	m_pBinaryBuffer = nullptr;
+
 	delete [] m_pStoreBuffer;
 	m_pStoreBuffer = nullptr;
 
@@ -311,6 +320,11 @@ void RemoteConfig::Run() {
 	debug_dump(m_pUdpBuffer, m_nBytesReceived);
 #endif
 
+	if (IsBinary()) {
+		HandleBinary();
+		return;
+	}
+
 	if (m_pUdpBuffer[m_nBytesReceived - 1] == '\n') {
 		m_nBytesReceived--;
 	}
@@ -364,6 +378,11 @@ void RemoteConfig::Run() {
 			return;
 		}
 
+		if ((m_nBytesReceived >= udp::cmd::get::length::NTP) && (memcmp(m_pUdpBuffer, udp::cmd::get::NTP, udp::cmd::get::length::NTP) == 0)) {
+			HandleNtpGet();
+			return;
+		}
+
 		Network::Get()->SendTo(m_nHandle, "?#ERROR#\n", 9, m_nIPAddressFrom, udp::PORT);
 
 		return;
@@ -909,101 +928,113 @@ void RemoteConfig::HandleTxtFile(void *pBuffer, uint32_t nBufferLength) {
 		return;
 	}
 
+	HandleTxtFileIndex(i);
+
+	DEBUG_EXIT
+}
+
+bool RemoteConfig::HandleTxtFileIndex(TxtFile i) {
+	DEBUG_ENTRY
+
+	bool bResult;
+
 	switch (i) {
 	case TxtFile::RCONFIG:
-		HandleTxtFileRconfig();
+		bResult = HandleTxtFileRconfig();
 		break;
 	case TxtFile::NETWORK:
-		HandleTxtFileNetwork();
+		bResult = HandleTxtFileNetwork();
 		break;
 #if defined (NODE_ARTNET)
 	case TxtFile::ARTNET:
-		HandleTxtFileArtnet();
+		bResult = HandleTxtFileArtnet();
 		break;
 #endif
 #if defined (NODE_E131)
 	case TxtFile::E131:
-		HandleTxtFileE131();
+		bResult = HandleTxtFileE131();
 		break;
 #endif
 #if defined (NODE_OSC_SERVER)
 	case TxtFile::OSC_SERVER:
-		HandleTxtFileOsc();
+		bResult = HandleTxtFileOsc();
 		break;
 #endif
 #if defined (OUTPUT_DMXSEND)
 	case TxtFile::PARAMS:
-		HandleTxtFileParams();
+		bResult = HandleTxtFileParams();
 		break;
 #endif
 #if defined (OUTPUT_PIXEL)
 	case TxtFile::DEVICES:
-		HandleTxtFileDevices();
+		bResult = HandleTxtFileDevices();
 		break;
 #endif
 #if defined (NODE_LTC_SMPTE)
 	case TxtFile::LTC:
-		HandleTxtFileLtc();
+		bResult = HandleTxtFileLtc();
 		break;
 	case TxtFile::LTCDISPLAY:
-		HandleTxtFileLtcDisplay();
+		bResult = HandleTxtFileLtcDisplay();
 		break;
 	case TxtFile::TCNET:
-		HandleTxtFileTCNet();
+		bResult = HandleTxtFileTCNet();
 		break;
 	case TxtFile::GPS:
-		HandleTxtFileGps();
+		bResult = HandleTxtFileGps();
 		break;
 #endif
 #if defined (NODE_OSC_CLIENT)
 	case TxtFile::OSC_CLIENT:
-		HandleTxtFileOscClient();
+		bResult = HandleTxtFileOscClient();
 		break;
 #endif
 #if defined(OUTPUT_DMX_MONITOR)
 	case TxtFile::MONITOR:
-		HandleTxtFileMon();
+		bResult = HandleTxtFileMon();
 		break;
 #endif
 #if defined(DISPLAY_UDF)
 	case TxtFile::DISPLAY:
-		HandleTxtFileDisplay();
+		bResult = HandleTxtFileDisplay();
 		break;
 #endif
 #if defined(OUTPUT_STEPPER)
 	case TxtFile::SPARKFUN:
-		HandleTxtFileSparkFun();
+		bResult = HandleTxtFileSparkFun();
 		break;
 	case TxtFile::MOTOR0:
 	case TxtFile::MOTOR1:
 	case TxtFile::MOTOR2:
 	case TxtFile::MOTOR3:
-		HandleTxtFileMotor(static_cast<uint32_t>(i) - static_cast<uint32_t>(TxtFile::MOTOR0));
+		bResult = HandleTxtFileMotor(static_cast<uint32_t>(i) - static_cast<uint32_t>(TxtFile::MOTOR0));
 		break;
 #endif
 #if defined (NODE_SHOWFILE)
 	case TxtFile::SHOW:
-		HandleTxtFileShow();
+		bResult = HandleTxtFileShow();
 		break;
 #endif
 #if defined (OUTPUT_DMXSERIAL)
 	case TxtFile::SERIAL:
-		HandleTxtFileSerial();
+		bResult = HandleTxtFileSerial();
 		break;
 #endif
 #if defined (OUTPUT_RGB_PANEL)
 	case TxtFile::RGBPANEL:
-		HandleTxtFileRgbPanel();
+		bResult = HandleTxtFileRgbPanel();
 		break;
 #endif
 	default:
+		bResult = false;
 		break;
 	}
 
 	DEBUG_EXIT
+	return bResult;
 }
 
-void RemoteConfig::HandleTxtFileRconfig() {
+bool RemoteConfig::HandleTxtFileRconfig() {
 	DEBUG_ENTRY
 
 	RemoteConfigParams remoteConfigParams(StoreRemoteConfig::Get());
@@ -1015,7 +1046,7 @@ void RemoteConfig::HandleTxtFileRconfig() {
 		        m_nBytesReceived = nSize;
 		} else {
 		        DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1025,9 +1056,10 @@ void RemoteConfig::HandleTxtFileRconfig() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
-void RemoteConfig::HandleTxtFileNetwork() {
+bool RemoteConfig::HandleTxtFileNetwork() {
 	DEBUG_ENTRY
 
 	NetworkParams params(StoreNetwork::Get());
@@ -1040,7 +1072,7 @@ void RemoteConfig::HandleTxtFileNetwork() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1050,10 +1082,11 @@ void RemoteConfig::HandleTxtFileNetwork() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
 #if defined (NODE_ARTNET)
-void RemoteConfig::HandleTxtFileArtnet() {
+bool RemoteConfig::HandleTxtFileArtnet() {
 	DEBUG_ENTRY
 	static_assert(sizeof(struct TArtNet4Params) != sizeof(struct TArtNetParams), "");
 
@@ -1072,7 +1105,7 @@ void RemoteConfig::HandleTxtFileArtnet() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1082,11 +1115,12 @@ void RemoteConfig::HandleTxtFileArtnet() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (NODE_E131)
-void RemoteConfig::HandleTxtFileE131() {
+bool RemoteConfig::HandleTxtFileE131() {
 	DEBUG_ENTRY
 
 	E131Params e131params(StoreE131::Get());
@@ -1098,7 +1132,7 @@ void RemoteConfig::HandleTxtFileE131() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 		
 	}
@@ -1108,11 +1142,12 @@ void RemoteConfig::HandleTxtFileE131() {
 	e131params.Dump();
 #endif
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (NODE_OSC_SERVER)
-void RemoteConfig::HandleTxtFileOsc() {
+bool RemoteConfig::HandleTxtFileOsc() {
 	DEBUG_ENTRY
 
 	OSCServerParams oscServerParams(StoreOscServer::Get());
@@ -1124,7 +1159,7 @@ void RemoteConfig::HandleTxtFileOsc() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 		
 	}
@@ -1135,11 +1170,12 @@ void RemoteConfig::HandleTxtFileOsc() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (NODE_OSC_CLIENT)
-void RemoteConfig::HandleTxtFileOscClient() {
+bool RemoteConfig::HandleTxtFileOscClient() {
 	DEBUG_ENTRY
 
 	OscClientParams oscClientParams(StoreOscClient::Get());
@@ -1151,7 +1187,7 @@ void RemoteConfig::HandleTxtFileOscClient() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1161,11 +1197,12 @@ void RemoteConfig::HandleTxtFileOscClient() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (OUTPUT_DMXSEND)
-void RemoteConfig::HandleTxtFileParams() {
+bool RemoteConfig::HandleTxtFileParams() {
 	DEBUG_ENTRY
 
 	DMXParams dmxparams(StoreDmxSend::Get());
@@ -1177,7 +1214,7 @@ void RemoteConfig::HandleTxtFileParams() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1187,11 +1224,12 @@ void RemoteConfig::HandleTxtFileParams() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (OUTPUT_PIXEL)
-void RemoteConfig::HandleTxtFileDevices() {
+bool RemoteConfig::HandleTxtFileDevices() {
 	DEBUG_ENTRY
 
 #if !defined (OUTPUT_PIXEL_MULTI)
@@ -1206,7 +1244,7 @@ void RemoteConfig::HandleTxtFileDevices() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1227,7 +1265,7 @@ void RemoteConfig::HandleTxtFileDevices() {
 				m_nBytesReceived = nSize;
 			} else {
 				DEBUG_EXIT
-				return;
+				return false;
 			}
 		}
 
@@ -1240,11 +1278,12 @@ void RemoteConfig::HandleTxtFileDevices() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (NODE_LTC_SMPTE)
-void RemoteConfig::HandleTxtFileLtc() {
+bool RemoteConfig::HandleTxtFileLtc() {
 	DEBUG_ENTRY
 
 	LtcParams ltcParams(StoreLtc::Get());
@@ -1256,7 +1295,7 @@ void RemoteConfig::HandleTxtFileLtc() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1266,9 +1305,10 @@ void RemoteConfig::HandleTxtFileLtc() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
-void RemoteConfig::HandleTxtFileLtcDisplay() {
+bool RemoteConfig::HandleTxtFileLtcDisplay() {
 	DEBUG_ENTRY
 
 	LtcDisplayParams ltcDisplayParams(StoreLtcDisplay::Get());
@@ -1280,7 +1320,7 @@ void RemoteConfig::HandleTxtFileLtcDisplay() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1290,9 +1330,10 @@ void RemoteConfig::HandleTxtFileLtcDisplay() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
-void RemoteConfig::HandleTxtFileTCNet() {
+bool RemoteConfig::HandleTxtFileTCNet() {
 	DEBUG_ENTRY
 
 	TCNetParams tcnetParams(StoreTCNet::Get());
@@ -1304,7 +1345,7 @@ void RemoteConfig::HandleTxtFileTCNet() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1314,9 +1355,10 @@ void RemoteConfig::HandleTxtFileTCNet() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
-void RemoteConfig::HandleTxtFileGps() {
+bool RemoteConfig::HandleTxtFileGps() {
 	DEBUG_ENTRY
 
 	GPSParams gpsParams(StoreGPS::Get());
@@ -1328,7 +1370,7 @@ void RemoteConfig::HandleTxtFileGps() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1338,11 +1380,12 @@ void RemoteConfig::HandleTxtFileGps() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined(OUTPUT_DMX_MONITOR)
-void RemoteConfig::HandleTxtFileMon() {
+bool RemoteConfig::HandleTxtFileMon() {
 	DEBUG_ENTRY
 
 	DMXMonitorParams monitorParams(StoreMonitor::Get());
@@ -1354,7 +1397,7 @@ void RemoteConfig::HandleTxtFileMon() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1364,11 +1407,12 @@ void RemoteConfig::HandleTxtFileMon() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined(DISPLAY_UDF)
-void RemoteConfig::HandleTxtFileDisplay() {
+bool RemoteConfig::HandleTxtFileDisplay() {
 	DEBUG_ENTRY
 
 	DisplayUdfParams displayParams(StoreDisplayUdf::Get());
@@ -1380,7 +1424,7 @@ void RemoteConfig::HandleTxtFileDisplay() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1390,11 +1434,12 @@ void RemoteConfig::HandleTxtFileDisplay() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined(OUTPUT_STEPPER)
-void RemoteConfig::HandleTxtFileSparkFun() {
+bool RemoteConfig::HandleTxtFileSparkFun() {
 	DEBUG_ENTRY
 
 	SparkFunDmxParams sparkFunDmxParams(StoreSparkFunDmx::Get());
@@ -1406,7 +1451,7 @@ void RemoteConfig::HandleTxtFileSparkFun() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1416,15 +1461,17 @@ void RemoteConfig::HandleTxtFileSparkFun() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 
-void RemoteConfig::HandleTxtFileMotor(uint32_t nMotorIndex) {
+bool RemoteConfig::HandleTxtFileMotor(uint32_t nMotorIndex) {
 	DEBUG_ENTRY
 	DEBUG_PRINTF("nMotorIndex=%d", nMotorIndex);
 
 	if (m_tHandleMode == HandleMode::BIN) {
 		// TODO HandleTxtFileMotor HandleMode::BIN
-		return;
+		DEBUG_EXIT
+		return false;
 	}
 
 	SparkFunDmxParams sparkFunDmxParams(StoreSparkFunDmx::Get());
@@ -1452,11 +1499,12 @@ void RemoteConfig::HandleTxtFileMotor(uint32_t nMotorIndex) {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (NODE_SHOWFILE)
-void RemoteConfig::HandleTxtFileShow() {
+bool RemoteConfig::HandleTxtFileShow() {
 	DEBUG_ENTRY
 
 	ShowFileParams showFileParams(StoreShowFile::Get());
@@ -1468,7 +1516,7 @@ void RemoteConfig::HandleTxtFileShow() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1478,11 +1526,12 @@ void RemoteConfig::HandleTxtFileShow() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (OUTPUT_DMXSERIAL)
-void RemoteConfig::HandleTxtFileSerial() {
+bool RemoteConfig::HandleTxtFileSerial() {
 	DEBUG_ENTRY
 
 	DmxSerialParams dmxSerialParams(StoreDmxSerial::Get());
@@ -1494,7 +1543,7 @@ void RemoteConfig::HandleTxtFileSerial() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1504,11 +1553,12 @@ void RemoteConfig::HandleTxtFileSerial() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
 #if defined (OUTPUT_RGB_PANEL)
-void RemoteConfig::HandleTxtFileRgbPanel() {
+bool RemoteConfig::HandleTxtFileRgbPanel() {
 	DEBUG_ENTRY
 
 	RgbPanelParams rgbPanelParams(StoreRgbPanel::Get());
@@ -1520,7 +1570,7 @@ void RemoteConfig::HandleTxtFileRgbPanel() {
 			m_nBytesReceived = nSize;
 		} else {
 			DEBUG_EXIT
-			return;
+			return false;
 		}
 	}
 
@@ -1530,6 +1580,7 @@ void RemoteConfig::HandleTxtFileRgbPanel() {
 #endif
 
 	DEBUG_EXIT
+	return true;
 }
 #endif
 
@@ -1610,3 +1661,225 @@ void RemoteConfig::HandleTftpGet() {
 
 	DEBUG_EXIT
 }
+
+void RemoteConfig::HandleNtpGet() {
+	DEBUG_ENTRY
+
+	auto *pNtpClient = NtpClient::Get();
+
+	if (pNtpClient == nullptr) {
+		Network::Get()->SendTo(m_nHandle, "?ntp#ERROR#\n", 12, m_nIPAddressFrom, udp::PORT);
+		DEBUG_EXIT
+		return;
+	}
+
+	const auto& stats = pNtpClient->GetStats();
+
+	if (m_nBytesReceived == udp::cmd::get::length::NTP) {
+		const auto nLength = snprintf(m_pUdpBuffer, udp::BUFFER_SIZE - 1, "ntp:%d,offset=%d,delay=%u,jitter=%u,drift=%d,poll=%u,steps=%u\n",
+				static_cast<int>(pNtpClient->GetStatus()), stats.nOffsetMicros, stats.nDelayMicros, stats.nJitterMicros, stats.nDriftPpb, stats.nPollSeconds, stats.nSteps);
+		Network::Get()->SendTo(m_nHandle, m_pUdpBuffer, nLength, m_nIPAddressFrom, udp::PORT);
+	} else if (m_nBytesReceived == udp::cmd::get::length::NTP + 3) {
+		if (memcmp(&m_pUdpBuffer[udp::cmd::get::length::NTP], "bin", 3) == 0) {
+			Network::Get()->SendTo(m_nHandle, &stats, sizeof(struct ntpclient::Stats), m_nIPAddressFrom, udp::PORT);
+		}
+	}
+
+	DEBUG_EXIT
+}
+
+/**
+ * Binary protocol
+ */
+
+namespace udp {
+namespace bin {
+static constexpr auto MAX_SET_RECORDS = 32;
+}  // namespace bin
+}  // namespace udp
+
+bool RemoteConfig::IsBinary() const {
+	if (m_nBytesReceived < sizeof(struct bin::Header)) {
+		return false;
+	}
+
+	const auto *pHeader = reinterpret_cast<const struct bin::Header*>(m_pUdpBuffer);
+
+	return (pHeader->aId[0] == bin::ID[0]) && (pHeader->aId[1] == bin::ID[1]) && (pHeader->nVersion == bin::VERSION);
+}
+
+void RemoteConfig::HandleBinary() {
+	DEBUG_ENTRY
+
+	// The request is kept, m_pUdpBuffer is used for the response and by the Params Builder
+	const auto nSize = m_nBytesReceived;
+	memcpy(m_pBinaryBuffer, m_pUdpBuffer, nSize);
+
+	const auto *pHeader = reinterpret_cast<const struct bin::Header*>(m_pBinaryBuffer);
+
+	const auto tCommand = static_cast<bin::Command>(pHeader->nCommand);
+
+	if (tCommand == bin::Command::GET_VERSIONS) {
+		HandleBinaryVersions(nSize);
+	} else if (tCommand == bin::Command::GET) {
+		HandleBinaryGet(nSize);
+	} else if ((tCommand == bin::Command::SET) && !m_bDisableWrite) {
+		HandleBinarySet(nSize);
+	} else {
+		auto *pResponse = reinterpret_cast<struct bin::Header*>(m_pUdpBuffer);
+		memcpy(pResponse, pHeader, sizeof(struct bin::Header));
+		pResponse->nCount = 0;
+		Network::Get()->SendTo(m_nHandle, m_pUdpBuffer, sizeof(struct bin::Header), m_nIPAddressFrom, udp::PORT);
+	}
+
+	DEBUG_EXIT
+}
+
+void RemoteConfig::HandleBinaryVersions(__attribute__((unused)) uint32_t nSize) {
+	DEBUG_ENTRY
+
+	const auto *pHeader = reinterpret_cast<const struct bin::Header*>(m_pBinaryBuffer);
+	auto *pResponse = reinterpret_cast<struct bin::Header*>(m_pUdpBuffer);
+	auto *pVersions = reinterpret_cast<struct bin::Versions*>(m_pUdpBuffer + sizeof(struct bin::Header));
+
+	memcpy(pResponse, pHeader, sizeof(struct bin::Header));
+	pResponse->nCount = 1;
+
+	pVersions->nUptime = Hardware::Get()->GetUpTime();
+	pVersions->nStores = static_cast<uint8_t>(spiflashstore::Store::LAST);
+	pVersions->nReserved = 0;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(spiflashstore::Store::LAST); i++) {
+		pVersions->aVersion[i] = SpiFlashStore::Get()->GetVersion(static_cast<spiflashstore::Store>(i));
+	}
+
+	Network::Get()->SendTo(m_nHandle, m_pUdpBuffer, sizeof(struct bin::Header) + sizeof(struct bin::Versions), m_nIPAddressFrom, udp::PORT);
+
+	DEBUG_EXIT
+}
+
+void RemoteConfig::HandleBinaryGet(uint32_t nSize) {
+	DEBUG_ENTRY
+
+	const auto *pHeader = reinterpret_cast<const struct bin::Header*>(m_pBinaryBuffer);
+	const auto *pRequest = reinterpret_cast<const struct bin::GetRecord*>(m_pBinaryBuffer + sizeof(struct bin::Header));
+	const auto nRecords = std::min(static_cast<uint32_t>(pHeader->nCount), static_cast<uint32_t>((nSize - sizeof(struct bin::Header)) / sizeof(struct bin::GetRecord)));
+	const bool isDelta = (pHeader->nFlags & bin::Flags::DELTA) == bin::Flags::DELTA;
+
+	auto *pResponse = reinterpret_cast<struct bin::Header*>(m_pUdpBuffer);
+	memcpy(pResponse, pHeader, sizeof(struct bin::Header));
+
+	uint32_t nLength = sizeof(struct bin::Header);
+	uint32_t nHandled;
+
+	for (nHandled = 0; nHandled < nRecords; nHandled++) {
+		if ((nLength + sizeof(struct bin::Record)) > udp::BUFFER_SIZE) {
+			break;
+		}
+
+		auto *pRecord = reinterpret_cast<struct bin::Record*>(m_pUdpBuffer + nLength);
+		const auto tStore = GetStore(static_cast<TxtFile>(std::min(static_cast<uint32_t>(pRequest[nHandled].nTxtFile), static_cast<uint32_t>(TxtFile::LAST))));
+
+		pRecord->nTxtFile = pRequest[nHandled].nTxtFile;
+		pRecord->nLength = 0;
+
+		if (tStore == spiflashstore::Store::LAST) {
+			pRecord->nStatus = static_cast<uint8_t>(bin::Status::ERROR);
+			pRecord->nVersion = 0;
+			nLength += sizeof(struct bin::Record);
+			continue;
+		}
+
+		pRecord->nVersion = SpiFlashStore::Get()->GetVersion(tStore);
+
+		if (isDelta && (pRecord->nVersion == pRequest[nHandled].nVersion)) {
+			pRecord->nStatus = static_cast<uint8_t>(bin::Status::NOT_MODIFIED);
+			nLength += sizeof(struct bin::Record);
+			continue;
+		}
+
+		const auto nStoreSize = SpiFlashStore::Get()->GetStoreSize(tStore);
+
+		if ((sizeof(struct bin::Header) + sizeof(struct bin::Record) + nStoreSize) > udp::BUFFER_SIZE) {
+			pRecord->nStatus = static_cast<uint8_t>(bin::Status::TOO_LARGE);
+			nLength += sizeof(struct bin::Record);
+			continue;
+		}
+
+		if ((nLength + sizeof(struct bin::Record) + nStoreSize) > udp::BUFFER_SIZE) {
+			break;	// The client requests the remaining records again
+		}
+
+		uint32_t nDataLength;
+		SpiFlashStore::Get()->CopyTo(tStore, m_pUdpBuffer + nLength + sizeof(struct bin::Record), nDataLength);
+
+		pRecord->nStatus = static_cast<uint8_t>(bin::Status::OK);
+		pRecord->nLength = static_cast<uint16_t>(nDataLength);
+		nLength += sizeof(struct bin::Record) + nDataLength;
+	}
+
+	pResponse->nCount = static_cast<uint8_t>(nHandled);
+
+	Network::Get()->SendTo(m_nHandle, m_pUdpBuffer, static_cast<uint16_t>(nLength), m_nIPAddressFrom, udp::PORT);
+
+	DEBUG_EXIT
+}
+
+void RemoteConfig::HandleBinarySet(uint32_t nSize) {
+	DEBUG_ENTRY
+
+	const auto *pHeader = reinterpret_cast<const struct bin::Header*>(m_pBinaryBuffer);
+	const auto nRecords = std::min(static_cast<uint32_t>(pHeader->nCount), static_cast<uint32_t>(udp::bin::MAX_SET_RECORDS));
+
+	struct bin::Record aResult[udp::bin::MAX_SET_RECORDS];
+	uint32_t nOffset = sizeof(struct bin::Header);
+	uint32_t nHandled;
+
+	for (nHandled = 0; nHandled < nRecords; nHandled++) {
+		if ((nOffset + sizeof(struct bin::Record)) > nSize) {
+			break;
+		}
+
+		const auto *pRecord = reinterpret_cast<const struct bin::Record*>(m_pBinaryBuffer + nOffset);
+		nOffset += sizeof(struct bin::Record);
+
+		if ((nOffset + pRecord->nLength) > nSize) {
+			break;
+		}
+
+		const auto tTxtFile = static_cast<TxtFile>(std::min(static_cast<uint32_t>(pRecord->nTxtFile), static_cast<uint32_t>(TxtFile::LAST)));
+		const auto tStore = GetStore(tTxtFile);
+
+		aResult[nHandled].nTxtFile = pRecord->nTxtFile;
+		aResult[nHandled].nLength = 0;
+
+		if ((tStore == spiflashstore::Store::LAST) || (pRecord->nLength == 0) || (pRecord->nLength > SpiFlashStore::Get()->GetStoreSize(tStore))) {
+			aResult[nHandled].nStatus = static_cast<uint8_t>(bin::Status::ERROR);
+			aResult[nHandled].nVersion = 0;
+		} else {
+			// Same path as !store#, the Params validate the data
+			memcpy(m_pStoreBuffer, m_pBinaryBuffer + nOffset, pRecord->nLength);
+			m_nBytesReceived = pRecord->nLength;
+			m_tHandleMode = HandleMode::BIN;
+
+			// False when the size does not match the Params struct or the store is not compiled in
+			const auto isHandled = HandleTxtFileIndex(tTxtFile);
+
+			aResult[nHandled].nStatus = static_cast<uint8_t>(isHandled ? bin::Status::OK : bin::Status::ERROR);
+			aResult[nHandled].nVersion = SpiFlashStore::Get()->GetVersion(tStore);
+		}
+
+		nOffset += pRecord->nLength;
+	}
+
+	auto *pResponse = reinterpret_cast<struct bin::Header*>(m_pUdpBuffer);
+	memcpy(pResponse, pHeader, sizeof(struct bin::Header));
+	pResponse->nCount = static_cast<uint8_t>(nHandled);
+
+	const auto nLength = nHandled * sizeof(struct bin::Record);
+	memcpy(m_pUdpBuffer + sizeof(struct bin::Header), aResult, nLength);
+
+	Network::Get()->SendTo(m_nHandle, m_pUdpBuffer, static_cast<uint16_t>(sizeof(struct bin::Header) + nLength), m_nIPAddressFrom, udp::PORT);
+
+	DEBUG_EXIT
+}
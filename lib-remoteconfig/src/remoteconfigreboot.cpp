@@ -49,9 +49,11 @@ void RemoteConfig::HandleReboot() {
 	Network::Get()->Shutdown();
 
 	printf("Rebooting ...\n");
+	Display::Get()->PrintLatencyHistogram();
 
 	Display::Get()->Cls();
 	Display::Get()->TextStatus("Rebooting ...", Display7SegmentMessage::INFO_REBOOTING);
+	Display::Get()->Flush();
 
 	Hardware::Get()->Reboot();
 
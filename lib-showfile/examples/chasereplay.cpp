@@ -0,0 +1,393 @@
+/**
+ * @file chasereplay.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Replays a simulated timecode (EBU, 25 fps) into OlaShowFile in chase mode,
+ * on a simulated millisecond clock. The show file has a frame every 40 ms,
+ * each frame carries its own number. After every tick the frame sent must be
+ * the one at the timecode position, minus the chase offset, within one frame.
+ * The timecode locates, runs off speed, starts before the offset, and chase
+ * mode is switched on and off while the show file is running.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "olashowfile.h"
+#include "showfile.h"
+#include "showfilechase.h"
+#include "showfileprotocolhandler.h"
+#include "tftpdaemon.h"
+#include "ledblink.h"
+#include "hardware.h"
+
+static constexpr uint32_t FRAME_MILLIS = 40;
+static constexpr uint32_t FRAMES = 3000;			///< 2 minutes, more frames than index entries
+static constexpr uint32_t SETTLE_MILLIS = 120;		///< After a lock or a locate
+static constexpr uint32_t EBU = 1;
+
+/*
+ * Hardware, the clock is simulated
+ */
+
+static uint32_t s_nNowMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nNowMillis;
+}
+
+LedBlink *LedBlink::s_pThis = nullptr;
+
+LedBlink::LedBlink() {
+	s_pThis = this;
+}
+
+void LedBlink::SetMode(ledblink::Mode tMode) {
+	m_tMode = tMode;
+}
+
+/*
+ * No network, TFTP is not enabled
+ */
+
+TFTPDaemon *TFTPDaemon::s_pThis = nullptr;
+
+TFTPDaemon::TFTPDaemon() {
+	s_pThis = this;
+}
+
+TFTPDaemon::~TFTPDaemon() {
+	s_pThis = nullptr;
+}
+
+bool TFTPDaemon::Run() {
+	return false;
+}
+
+/*
+ * Protocol handler, keeps the number of the last frame sent
+ */
+
+class Capture final: public ShowFileProtocolHandler {
+public:
+	void DmxOut(__attribute__((unused)) uint16_t nUniverse, const uint8_t *pDmxData, uint16_t nLength) override {
+		if (nLength >= 2) {
+			m_nFrame = static_cast<uint32_t>((pDmxData[0] << 8) | pDmxData[1]);
+			m_bSent = true;
+		}
+	}
+
+	void DmxSync() override {}
+	void DmxBlackout() override {}
+	void DmxMaster(__attribute__((unused)) uint32_t nMaster) override {}
+	void DoRunCleanupProcess(__attribute__((unused)) bool bDoRun) override {}
+	void Start() override {}
+	void Stop() override {}
+	void Run() override {}
+	bool IsSyncDisabled() override {
+		return false;
+	}
+	void Print() override {}
+
+	void Reset() {
+		m_bSent = false;
+	}
+
+	bool IsSent() const {
+		return m_bSent;
+	}
+
+	uint32_t GetFrame() const {
+		return m_nFrame;
+	}
+
+private:
+	uint32_t m_nFrame{0};
+	bool m_bSent{false};
+};
+
+static bool write_show() {
+	auto *pFile = fopen("show01.txt", "w");
+
+	if (pFile == nullptr) {
+		perror("show01.txt");
+		return false;
+	}
+
+	for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+		fprintf(pFile, "1 %u,%u,0,255\n%u\n", nFrame >> 8, nFrame & 0xFF, FRAME_MILLIS);
+	}
+
+	fclose(pFile);
+	return true;
+}
+
+/*
+ * Timecode source, sends a frame each time its time line passes a frame boundary
+ */
+
+class TimeCodeSource {
+public:
+	void Locate(uint32_t nTimeCodeMillis) {
+		m_nBaseMillis = nTimeCodeMillis;
+		m_nBaseLocalMillis = s_nNowMillis;
+		m_nFrameLast = UINT32_MAX;
+	}
+
+	void SetRate(uint32_t nRatePerMille) {
+		m_nBaseMillis = Position();
+		m_nBaseLocalMillis = s_nNowMillis;
+		m_nRatePerMille = nRatePerMille;
+	}
+
+	uint32_t Position() const {
+		return m_nBaseMillis + ((s_nNowMillis - m_nBaseLocalMillis) * m_nRatePerMille) / 1000U;
+	}
+
+	void Run() {
+		const auto nFrame = Position() / FRAME_MILLIS;
+
+		if (nFrame != m_nFrameLast) {
+			m_nFrameLast = nFrame;
+
+			const auto nSeconds = nFrame / 25U;
+			ShowFile::Get()->TimeCode(nSeconds / 3600U, (nSeconds / 60U) % 60U, nSeconds % 60U, nFrame % 25U, EBU);
+		}
+	}
+
+private:
+	uint32_t m_nBaseMillis{0};
+	uint32_t m_nBaseLocalMillis{0};
+	uint32_t m_nRatePerMille{1000};
+	uint32_t m_nFrameLast{UINT32_MAX};
+};
+
+/*
+ * Scenarios
+ */
+
+static uint32_t s_nFailed;
+
+struct Event {
+	uint32_t nAtMillis;
+	enum class Type { LOCATE, RATE, CHASE_ON, CHASE_OFF } tType;
+	uint32_t nValue;
+};
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (static_cast<uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/*
+ * The chase is checked while it is on and settled, a chase off must restart the free run at frame 0
+ */
+static void scenario(const char *pName, OlaShowFile& showFile, Capture& capture, bool bChase, uint32_t nOffsetMillis, uint32_t nStartMillis, const Event *pEvents, uint32_t nEvents, uint32_t nRunMillis) {
+	TimeCodeSource source;
+	uint32_t nChecks = 0;
+	uint32_t nErrorMax = 0;
+	uint32_t nRestarts = 0;
+	uint32_t nEvent = 0;
+	uint32_t nSettledMillis = SETTLE_MILLIS;
+	uint64_t nTimeCodeNanos = 0;
+	auto bFreeRunCheck = false;
+	auto bPass = true;
+
+	showFile.Stop();
+	showFile.SetChase(bChase);
+	showFile.SetChaseOffset(nOffsetMillis);
+
+	s_nNowMillis = 0;
+	source.Locate(nStartMillis);
+	showFile.Start();
+	capture.Reset();
+
+	for (s_nNowMillis = 0; s_nNowMillis <= nRunMillis; s_nNowMillis++) {
+		while ((nEvent < nEvents) && (pEvents[nEvent].nAtMillis == s_nNowMillis)) {
+			const auto& event = pEvents[nEvent++];
+
+			switch (event.tType) {
+			case Event::Type::LOCATE:
+				source.Locate(event.nValue);
+				break;
+			case Event::Type::RATE:
+				source.SetRate(event.nValue);
+				break;
+			case Event::Type::CHASE_ON:
+				showFile.SetChase(true);
+				break;
+			case Event::Type::CHASE_OFF:
+				showFile.SetChase(false);
+				capture.Reset();
+				bFreeRunCheck = true;
+				break;
+			}
+
+			nSettledMillis = s_nNowMillis + SETTLE_MILLIS;
+		}
+
+		if (showFile.IsChase()) {
+			const auto nStart = nanos();
+			source.Run();
+			nTimeCodeNanos += nanos() - nStart;
+		}
+
+		showFile.Run();
+
+		if (bFreeRunCheck && capture.IsSent()) {
+			bFreeRunCheck = false;
+			nRestarts++;
+			bPass = bPass && (capture.GetFrame() == 0);
+		}
+
+		if (showFile.IsChase() && (s_nNowMillis >= nSettledMillis)) {
+			const auto nPosition = source.Position();
+
+			nChecks++;
+
+			// Nothing is sent before the offset, the last frame is held at the end of the show file
+			if (nPosition < nOffsetMillis) {
+				if (capture.IsSent()) {
+					nErrorMax = UINT32_MAX;
+				}
+				continue;
+			}
+
+			if (!capture.IsSent()) {
+				nErrorMax = UINT32_MAX;
+				continue;
+			}
+
+			auto nExpected = (nPosition - nOffsetMillis) / FRAME_MILLIS;
+
+			if (nExpected >= FRAMES) {
+				nExpected = FRAMES - 1;
+			}
+
+			const auto nFrame = capture.GetFrame();
+			const auto nError = nFrame > nExpected ? nFrame - nExpected : nExpected - nFrame;
+
+			if (nError > nErrorMax) {
+				nErrorMax = nError;
+			}
+		}
+	}
+
+	bPass = bPass && (nErrorMax <= 1) && (nChecks != 0) && !bFreeRunCheck;
+
+	printf("%-36s %6u %6u %6u %8u  %s\n", pName, nChecks, nErrorMax, nRestarts, static_cast<uint32_t>(nTimeCodeNanos / 1000U), bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+static void check_to_millis(const char *pName, uint32_t nHours, uint32_t nMinutes, uint32_t nSeconds, uint32_t nFrames, uint32_t nType, uint32_t nExpected) {
+	const auto nMillis = ShowFileChase::ToMillis(nHours, nMinutes, nSeconds, nFrames, nType);
+	const auto bPass = (nMillis == nExpected);
+
+	printf("%-36s %9u %9u  %s\n", pName, nMillis, nExpected, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+int main() {
+	Hardware hw;
+	LedBlink lb;
+
+	char aDirectory[] = "/tmp/chasereplayXXXXXX";
+
+	if ((mkdtemp(aDirectory) == nullptr) || (chdir(aDirectory) != 0) || !write_show()) {
+		perror(aDirectory);
+		return EXIT_FAILURE;
+	}
+
+	Capture capture;
+	OlaShowFile showFile;
+
+	showFile.SetProtocolHandler(&capture);
+	showFile.SetShowFile(1);
+
+	printf("%u frames of %u ms, EBU timecode, simulated clock\n", FRAMES, FRAME_MILLIS);
+	puts("Error is in frames, the us is the host time of ShowFile::TimeCode() including the seeks\n");
+
+	printf("%-36s %6s %6s %6s %8s\n", "Scenario", "Checks", "Error", "Starts", "us");
+
+	scenario("Chase from 00:00:00:00", showFile, capture, true, 0, 0, nullptr, 0, 10000);
+
+	scenario("Offset 01:00:00:00, from 01:00:05:00", showFile, capture, true, 3600000, 3605000, nullptr, 0, 10000);
+
+	const Event locate[] = {
+		{ 3000, Event::Type::LOCATE, 90000 },
+		{ 6000, Event::Type::LOCATE, 20000 },
+		{ 8000, Event::Type::LOCATE, 119000 },
+	};
+	scenario("Locate 1:30, back to 0:20, to the end", showFile, capture, true, 0, 5000, locate, 3, 10000);
+
+	const Event varispeed[] = {
+		{ 2000, Event::Type::RATE, 1020 },
+		{ 6000, Event::Type::RATE, 970 },
+	};
+	scenario("Varispeed +2%, then -3%", showFile, capture, true, 0, 0, varispeed, 2, 10000);
+
+	const Event before[] = {
+		{ 3000, Event::Type::LOCATE, 9900 },
+	};
+	scenario("Before the offset, then passing it", showFile, capture, true, 10000, 5000, before, 1, 6000);
+
+	const Event toggle[] = {
+		{ 2000, Event::Type::LOCATE, 30000 },
+		{ 2000, Event::Type::CHASE_ON, 0 },
+		{ 6000, Event::Type::CHASE_OFF, 0 },
+	};
+	scenario("Chase on/off while running", showFile, capture, false, 0, 0, toggle, 3, 8000);
+
+	puts("");
+	printf("%-36s %9s %9s\n", "ShowFileChase::ToMillis", "ms", "Expected");
+
+	check_to_millis("EBU 01:00:00:12", 1, 0, 0, 12, 1, 3600480);
+	check_to_millis("FILM 00:00:01:12", 0, 0, 1, 12, 0, 1500);
+	check_to_millis("DF 00:01:00;02", 0, 1, 0, 2, 2, 60060);
+	check_to_millis("DF 00:10:00;00", 0, 10, 0, 0, 2, 599999);
+
+	unlink("show01.txt");
+	chdir("/");
+	rmdir(aDirectory);
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
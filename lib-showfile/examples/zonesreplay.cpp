@@ -0,0 +1,466 @@
+/**
+ * @file zonesreplay.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Replays generated OLA show files through ShowFileZones on the host, on a simulated
+ * millisecond clock. Every universe sent is checked against a reference model of the
+ * zones (frame per time line, offset, loop, master, HTP merge), one DmxSync per tick.
+ * The frame statistics are read back from ShowFile.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "showfilezones.h"
+#include "showfile.h"
+#include "showfileprotocolhandler.h"
+#include "hardware.h"
+
+static constexpr uint32_t UNIVERSES = 3;	///< Universe 1, 2 and 3
+static constexpr uint32_t SLOTS = 512;
+
+/*
+ * Hardware, the clock is simulated
+ */
+
+static uint32_t s_nNowMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nNowMillis;
+}
+
+/*
+ * ShowFile, only the statistics are used by ShowFileZones
+ */
+
+ShowFile *ShowFile::s_pThis = nullptr;
+
+ShowFile::ShowFile() {
+	s_pThis = this;
+	m_aShowFileName[0] = '\0';
+}
+
+class StatisticsShowFile final: public ShowFile {
+protected:
+	void ShowFileStart() override {}
+	void ShowFileStop() override {}
+	void ShowFileResume() override {}
+	void ShowFileRun() override {}
+	void ShowFilePrint() override {}
+	void ShowFileSeek(__attribute__((unused)) uint32_t nMillis) override {}
+};
+
+/*
+ * The show files
+ */
+
+struct Show {
+	uint8_t nNumber;
+	uint16_t nUniverse[2];
+	uint32_t nUniverses;
+	uint32_t nFrames;
+	uint32_t nDelayMillis;
+};
+
+static const Show s_Show[] = {
+	{ 1, { 1, 2 }, 2, 40, 25 },
+	{ 2, { 1, 0 }, 1, 30, 40 },
+	{ 3, { 3, 0 }, 1, 20, 33 },
+	{ 4, { 1, 3 }, 2, 10, 50 },
+};
+
+static uint8_t value(const Show& show, uint32_t nFrame, uint32_t nUniverse, uint32_t nSlot) {
+	return static_cast<uint8_t>((show.nNumber * 37U) + (nFrame * 7U) + (nUniverse * 13U) + nSlot);
+}
+
+static bool write_show(const Show& show) {
+	char aFileName[16];
+	snprintf(aFileName, sizeof(aFileName), "show%.2u.txt", show.nNumber);
+
+	auto *pFile = fopen(aFileName, "w");
+
+	if (pFile == nullptr) {
+		perror(aFileName);
+		return false;
+	}
+
+	for (uint32_t nFrame = 0; nFrame < show.nFrames; nFrame++) {
+		for (uint32_t i = 0; i < show.nUniverses; i++) {
+			fprintf(pFile, "%u ", show.nUniverse[i]);
+
+			for (uint32_t nSlot = 0; nSlot < SLOTS; nSlot++) {
+				fprintf(pFile, nSlot == 0 ? "%u" : ",%u", value(show, nFrame, show.nUniverse[i], nSlot));
+			}
+
+			fputc('\n', pFile);
+		}
+
+		fprintf(pFile, "%u\n", show.nDelayMillis);
+	}
+
+	fclose(pFile);
+	return true;
+}
+
+/*
+ * Reference model
+ */
+
+struct ZoneConfig {
+	uint32_t nShow;		///< Index in s_Show
+	bool bDoLoop;
+	uint8_t nMaster;
+	uint32_t nOffsetMillis;
+};
+
+class Reference {
+public:
+	Reference(const ZoneConfig *pConfig, uint32_t nZones): m_pConfig(pConfig), m_nZones(nZones) {
+		for (uint32_t i = 0; i < nZones; i++) {
+			m_nMaster[i] = pConfig[i].nMaster;
+		}
+	}
+
+	void SetMaster(uint32_t nZone, uint8_t nMaster) {
+		m_nMaster[nZone] = nMaster;
+	}
+
+	uint8_t Slot(uint32_t nNowMillis, uint16_t nUniverse, uint32_t nSlot) const {
+		uint32_t nValue = 0;
+
+		for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+			const auto& config = m_pConfig[nZone];
+			const auto& show = s_Show[config.nShow];
+
+			if ((nNowMillis < config.nOffsetMillis) || !HasUniverse(show, nUniverse)) {
+				continue;
+			}
+
+			auto nFrame = (nNowMillis - config.nOffsetMillis) / show.nDelayMillis;
+
+			if (config.bDoLoop) {
+				nFrame %= show.nFrames;
+			} else if (nFrame >= show.nFrames) {
+				nFrame = show.nFrames - 1;
+			}
+
+			const auto nZoneValue = (static_cast<uint32_t>(value(show, nFrame, nUniverse, nSlot)) * m_nMaster[nZone]) / 255U;
+
+			if (nZoneValue > nValue) {
+				nValue = nZoneValue;
+			}
+		}
+
+		return static_cast<uint8_t>(nValue);
+	}
+
+	/*
+	 * The time lines that are due, these are the frames counted by the statistics
+	 */
+	uint32_t Frames(uint32_t nNowMillis) const {
+		uint32_t nFrames = 0;
+
+		for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+			const auto& config = m_pConfig[nZone];
+			const auto& show = s_Show[config.nShow];
+
+			if (nNowMillis < config.nOffsetMillis) {
+				continue;
+			}
+
+			auto nTimeLines = ((nNowMillis - config.nOffsetMillis) / show.nDelayMillis) + 1;
+
+			if (!config.bDoLoop && (nTimeLines > show.nFrames)) {
+				nTimeLines = show.nFrames;
+			}
+
+			nFrames += nTimeLines;
+		}
+
+		return nFrames;
+	}
+
+	bool Ended(uint32_t nNowMillis) const {
+		for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+			const auto& config = m_pConfig[nZone];
+			const auto& show = s_Show[config.nShow];
+
+			if (config.bDoLoop || (nNowMillis < (config.nOffsetMillis + show.nFrames * show.nDelayMillis))) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool HasUniverse(const Show& show, uint16_t nUniverse) {
+		for (uint32_t i = 0; i < show.nUniverses; i++) {
+			if (show.nUniverse[i] == nUniverse) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	const ZoneConfig *m_pConfig;
+	uint32_t m_nZones;
+	uint8_t m_nMaster[showfilezones::MAX_ZONES];
+};
+
+/*
+ * Protocol handler, checks each universe sent against the reference
+ */
+
+class Capture final: public ShowFileProtocolHandler {
+public:
+	Capture(const Reference& reference): m_Reference(reference) {
+	}
+
+	void DmxOut(uint16_t nUniverse, const uint8_t *pDmxData, uint16_t nLength) override {
+		m_nOuts++;
+
+		if ((nUniverse == 0) || (nUniverse > UNIVERSES) || (nLength != SLOTS) || m_bSent[nUniverse - 1]) {
+			m_nErrors++;
+			return;
+		}
+
+		m_bSent[nUniverse - 1] = true;
+
+		for (uint32_t nSlot = 0; nSlot < SLOTS; nSlot++) {
+			if (pDmxData[nSlot] != m_Reference.Slot(s_nNowMillis, nUniverse, nSlot)) {
+				m_nErrors++;
+				break;
+			}
+		}
+	}
+
+	void DmxSync() override {
+		m_nSyncs++;
+
+		for (uint32_t i = 0; i < UNIVERSES; i++) {
+			m_bSent[i] = false;
+		}
+	}
+
+	void DmxBlackout() override {}
+	void DmxMaster(__attribute__((unused)) uint32_t nMaster) override {}
+	void DoRunCleanupProcess(__attribute__((unused)) bool bDoRun) override {}
+	void Start() override {}
+	void Stop() override {}
+	void Run() override {}
+	bool IsSyncDisabled() override {
+		return false;
+	}
+	void Print() override {}
+
+	/*
+	 * After each tick: a universe sent without a DmxSync is an error
+	 */
+	void Tick() {
+		for (uint32_t i = 0; i < UNIVERSES; i++) {
+			if (m_bSent[i]) {
+				m_nErrors++;
+				m_bSent[i] = false;
+			}
+		}
+	}
+
+	uint32_t Outs() const {
+		return m_nOuts;
+	}
+	uint32_t Syncs() const {
+		return m_nSyncs;
+	}
+	uint32_t Errors() const {
+		return m_nErrors;
+	}
+
+private:
+	const Reference& m_Reference;
+	bool m_bSent[UNIVERSES] {};
+	uint32_t m_nOuts{0};
+	uint32_t m_nSyncs{0};
+	uint32_t m_nErrors{0};
+};
+
+/*
+ * Scenarios
+ */
+
+static uint32_t s_nFailed;
+
+static const ZoneConfig s_Zones[] = {
+	{ 0, false, 255, 0 },
+	{ 1, true, 200, 0 },
+	{ 2, false, 128, 100 },
+	{ 3, false, 255, 500 },
+};
+
+static constexpr uint32_t ZONES = sizeof(s_Zones) / sizeof(s_Zones[0]);
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (static_cast<uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/*
+ * nTickMillis is the period of the superloop, nMasterMillis is when zone 2 is faded out (0 = never)
+ */
+static void scenario(const char *pName, const ZoneConfig *pConfig, uint32_t nZones, bool bLoad, uint32_t nTickMillis, uint32_t nRunMillis, uint32_t nMasterMillis) {
+	Reference reference(pConfig, nZones);
+	Capture capture(reference);
+	ShowFileZones zones(&capture);
+	auto bPass = true;
+
+	if (bLoad) {
+		auto *pFile = fopen(showfilezones::FILE_NAME, "w");
+
+		for (uint32_t i = 0; i < nZones; i++) {
+			fprintf(pFile, "zone%u_show=%u\nzone%u_loop=%u\nzone%u_master=%u\nzone%u_offset=%u\n",
+					i + 1, s_Show[pConfig[i].nShow].nNumber, i + 1, pConfig[i].bDoLoop ? 1 : 0, i + 1, pConfig[i].nMaster, i + 1, pConfig[i].nOffsetMillis);
+		}
+
+		fclose(pFile);
+		bPass = zones.Load();
+	} else {
+		for (uint32_t i = 0; i < nZones; i++) {
+			bPass = bPass && zones.AddZone(s_Show[pConfig[i].nShow].nNumber, pConfig[i].bDoLoop, pConfig[i].nMaster, pConfig[i].nOffsetMillis);
+		}
+	}
+
+	bPass = bPass && (zones.GetZones() == nZones);
+
+	s_nNowMillis = 0;
+	zones.Start();
+
+	uint32_t nTicks = 0;
+	uint32_t nEndedMillis = 0;
+	const auto nStart = nanos();
+
+	for (s_nNowMillis = 0; s_nNowMillis <= nRunMillis; s_nNowMillis += nTickMillis) {
+		if ((nMasterMillis != 0) && (s_nNowMillis == nMasterMillis)) {
+			zones.SetMaster(1, 0);
+			reference.SetMaster(1, 0);
+		}
+
+		zones.Run();
+		capture.Tick();
+		nTicks++;
+
+		if (!zones.IsRunning()) {
+			nEndedMillis = s_nNowMillis;
+			break;
+		}
+	}
+
+	const auto nElapsed = nanos() - nStart;
+
+	if (s_nNowMillis > nRunMillis) {
+		s_nNowMillis = nRunMillis;
+	}
+
+	const auto *pShowFile = ShowFile::Get();
+	const auto nFrames = pShowFile->GetFrames();
+	const auto nLateFrames = pShowFile->GetLateFrames();
+	const auto nLateMax = pShowFile->GetLateMaxMillis();
+
+	bPass = bPass && (capture.Errors() == 0);
+	bPass = bPass && (nFrames == reference.Frames(s_nNowMillis));
+
+	if (nTickMillis == 1) {
+		bPass = bPass && (nLateFrames == 0);
+	} else {
+		bPass = bPass && (nLateFrames != 0) && (nLateMax < nTickMillis);
+	}
+
+	if (nEndedMillis != 0) {
+		bPass = bPass && reference.Ended(nEndedMillis) && !reference.Ended(nEndedMillis - nTickMillis);
+	} else {
+		bPass = bPass && !reference.Ended(nRunMillis);
+	}
+
+	printf("%-34s %6u %6u %6u %6u %4u %7u %7u  %s\n", pName, nFrames, nLateFrames, nLateMax, capture.Outs(), capture.Errors(),
+			static_cast<uint32_t>(nElapsed / (nTicks * 1000U)), nEndedMillis, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+int main() {
+	Hardware hw;
+	StatisticsShowFile showFile;
+
+	char aDirectory[] = "/tmp/zonesreplayXXXXXX";
+
+	if ((mkdtemp(aDirectory) == nullptr) || (chdir(aDirectory) != 0)) {
+		perror(aDirectory);
+		return EXIT_FAILURE;
+	}
+
+	for (const auto& show : s_Show) {
+		if (!write_show(show)) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("%u zones, %u universes of %u slots, simulated clock\n", ZONES, UNIVERSES, SLOTS);
+	puts("The us per tick is the host time of ShowFileZones::Run(), including the file reads\n");
+
+	printf("%-34s %6s %6s %6s %6s %4s %7s %7s\n", "Scenario", "Frames", "Late", "Max ms", "Outs", "Err", "us/tick", "Ended");
+
+	scenario("zones.txt, 1 ms tick", s_Zones, ZONES, true, 1, 3000, 0);
+	scenario("AddZone, 10 ms tick", s_Zones, ZONES, false, 10, 3000, 0);
+	scenario("Master zone 2 to 0 at 700 ms", s_Zones, ZONES, false, 1, 2000, 700);
+
+	const ZoneConfig once[] = { s_Zones[0], s_Zones[2], s_Zones[3] };
+	scenario("No loop, ends with the last zone", once, 3, false, 1, 3000, 0);
+	scenario("No loop, 7 ms tick", once, 3, false, 7, 3000, 0);
+
+	for (const auto& show : s_Show) {
+		char aFileName[16];
+		snprintf(aFileName, sizeof(aFileName), "show%.2u.txt", show.nNumber);
+		unlink(aFileName);
+	}
+
+	unlink(showfilezones::FILE_NAME);
+	chdir("/");
+	rmdir(aDirectory);
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,17 +27,17 @@
 #define OLASHOWFILE_H_
 
 #include <stdio.h>
+#include <stdint.h>
 
 #include "showfile.h"
+#include "olashowfilereader.h"
+#include "olashowfileindex.h"
 
-enum class OlaParseCode {
-	FAILED,
-	TIME,
-	DMX,
-	NONE,
-	EOFILE
-};
-
+/**
+ * The show file is read ahead into a ring of parsed frames.
+ * The file is read and parsed while waiting for the next time line,
+ * the timed part only dispatches the frames from the ring.
+ */
 class OlaShowFile final: public ShowFile {
 public:
 	OlaShowFile();
@@ -46,8 +46,17 @@ public:
 	void ShowFileStop() override;
 	void ShowFileResume() override;
 	void ShowFileRun() override;
-	void ShowFilePrint() override {
-		puts("OlaShowFile");
+	void ShowFilePrint() override;
+	void ShowFileSeek(uint32_t nMillis) override;
+
+private:
+	void ShowFileRunChase();
+
+	uint32_t ChaseTarget(uint32_t nMillis) const {
+		if (m_bDoLoop && (m_Index.GetDurationMillis() != 0)) {
+			return nMillis % m_Index.GetDurationMillis();
+		}
+		return nMillis;
 	}
 
 private:
@@ -57,19 +66,18 @@ private:
 		TIME_WAITING
 	};
 
-	OlaParseCode GetNextLine();
-	OlaParseCode ParseLine(const char *pLine);
-	OlaParseCode ParseDmxData(const char *pLine);
-
 private:
-	OlaParseCode m_tParseCode{OlaParseCode::FAILED};
 	OlaState m_tState{OlaState::IDLE};
-	char s_buffer[2048];
 	uint32_t m_nDelayMillis{0};
 	uint32_t m_nLastMillis{0};
-	uint32_t m_nUniverse{0};
-	uint8_t m_DmxData[512];
 	uint32_t m_nDmxDataLength{0};
+	uint32_t m_nUnderruns{0};
+	OlaShowFileReader m_Reader;
+	// Chase
+	uint32_t m_nShowMillis{0};	///< Time line of the next frame
+	uint32_t m_nFrameMillis{0};	///< Time line of the last frame sent
+	uint32_t m_nSeeks{0};
+	OlaShowFileIndex m_Index;
 };
 
 #endif /* OLASHOWFILE_H_ */
@@ -0,0 +1,74 @@
+/**
+ * @file olashowfileindex.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OLASHOWFILEINDEX_H_
+#define OLASHOWFILEINDEX_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+namespace olashowfile {
+static constexpr uint32_t INDEX_ENTRIES = 2048;
+}  // namespace olashowfile
+
+/**
+ * Sparse index of the frame start times in an OLA show file.
+ * When the index is full, every other entry is dropped and the stride doubles.
+ * Seek() is a binary search followed by a scan of at most (stride - 1) frames.
+ */
+class OlaShowFileIndex {
+public:
+	void Build(FILE *pFile);
+	bool Seek(FILE *pFile, uint32_t nMillis, uint32_t& nFrameMillis);
+
+	uint32_t GetDurationMillis() const {
+		return m_nDurationMillis;
+	}
+
+	uint32_t GetEntries() const {
+		return m_nEntries;
+	}
+
+	uint32_t GetStride() const {
+		return m_nStride;
+	}
+
+private:
+	bool GetDelay(FILE *pFile, bool& bIsTime, uint32_t& nDelayMillis);
+
+private:
+	struct Entry {
+		uint32_t nMillis;
+		uint32_t nOffset;
+	};
+
+	Entry m_aEntry[olashowfile::INDEX_ENTRIES];
+	uint32_t m_nEntries{0};
+	uint32_t m_nStride{1};
+	uint32_t m_nDurationMillis{0};
+	char m_aBuffer[2048];
+};
+
+#endif /* OLASHOWFILEINDEX_H_ */
@@ -0,0 +1,88 @@
+/**
+ * @file olashowfilereader.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OLASHOWFILEREADER_H_
+#define OLASHOWFILEREADER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "spscring.h"
+
+enum class OlaParseCode {
+	FAILED,
+	TIME,
+	DMX,
+	NONE,
+	EOFILE
+};
+
+namespace olashowfile {
+static constexpr uint32_t READ_AHEAD_FRAMES = 16;
+static constexpr uint32_t READ_AHEAD_LINES = 4;	///< Lines parsed per idle iteration
+struct Frame {
+	OlaParseCode tCode;
+	uint16_t nUniverse;
+	uint16_t nLength;
+	uint32_t nDelayMillis;
+	uint8_t data[512];
+};
+}  // namespace olashowfile
+
+/**
+ * Reads an OLA show file ahead into a ring of parsed frames (DMX universe, time line or end of file).
+ * ReadAhead() is the producer, Front()/Release() is the consumer.
+ */
+class OlaShowFileReader {
+public:
+	void SetFile(FILE *pFile) {
+		m_pFile = pFile;
+	}
+
+	void Rewind();
+	void Reset();
+	void ReadAhead(uint32_t nLines, bool bDoLoop);
+
+	olashowfile::Frame *Front() {
+		return m_ReadAhead.Front();
+	}
+
+	void Release() {
+		m_ReadAhead.Release();
+	}
+
+private:
+	OlaParseCode GetNextLine(olashowfile::Frame& frame);
+	OlaParseCode ParseLine(const char *pLine, olashowfile::Frame& frame);
+	OlaParseCode ParseDmxData(const char *pLine, olashowfile::Frame& frame);
+
+private:
+	FILE *m_pFile{nullptr};
+	bool m_bEndOfFile{false};
+	char m_aBuffer[2048];
+	SpscRing<olashowfile::Frame, olashowfile::READ_AHEAD_FRAMES> m_ReadAhead;
+};
+
+#endif /* OLASHOWFILEREADER_H_ */
@@ -29,6 +29,7 @@
 #include <stdio.h>
 
 #include "showfileprotocolhandler.h"
+#include "showfilechase.h"
 #include "showfiledisplay.h"
 #include "showfiletftp.h"
 
@@ -44,6 +45,10 @@ enum class ShowFileProtocols : unsigned {
 	SACN, ARTNET, UNDEFINED
 };
 
+enum class ShowFileChaseSources : unsigned {
+	NONE, ARTNET, MTC, LTC, UNDEFINED
+};
+
 #define SHOWFILE_PREFIX	"show"
 #define SHOWFILE_SUFFIX	".txt"
 
@@ -93,6 +98,27 @@ public:
 
 	void BlackOut();
 
+	/**
+	 * Chase mode: the playback position follows the timecode.
+	 * When running, the show file is restarted in the new mode.
+	 */
+	void SetChase(bool bChase);
+	bool IsChase() const {
+		return m_bChase;
+	}
+
+	/**
+	 * The timecode of the start of the show file, before it the output is held
+	 */
+	void SetChaseOffset(uint32_t nOffsetMillis) {
+		m_nChaseOffsetMillis = nOffsetMillis;
+	}
+	uint32_t GetChaseOffset() const {
+		return m_nChaseOffsetMillis;
+	}
+
+	void TimeCode(uint32_t nHours, uint32_t nMinutes, uint32_t nSeconds, uint32_t nFrames, uint32_t nType);
+
 	void SetMaster(uint32_t nMaster) {
 		if (m_pShowFileProtocolHandler != nullptr) {
 			m_pShowFileProtocolHandler->DmxMaster(nMaster);
@@ -123,6 +149,39 @@ public:
 	static bool CheckShowFileName(const char *pShowFileName, uint8_t& nShowFileNumber);
 	static bool ShowFileNameCopyTo(char *pShowFileName, uint32_t nLength, uint8_t nShowFileNumber);
 
+	/**
+	 * Lateness of a frame versus the time line of the show file, also used by ShowFileZones
+	 */
+	void UpdateStatistics(uint32_t nLateMillis) {
+		m_nFrames++;
+
+		if (nLateMillis != 0) {
+			m_nLateFrames++;
+			m_nLateTotalMillis += nLateMillis;
+
+			if (nLateMillis > m_nLateMaxMillis) {
+				m_nLateMaxMillis = nLateMillis;
+			}
+		}
+	}
+
+	void ResetStatistics() {
+		m_nFrames = 0;
+		m_nLateFrames = 0;
+		m_nLateMaxMillis = 0;
+		m_nLateTotalMillis = 0;
+	}
+
+	uint32_t GetFrames() const {
+		return m_nFrames;
+	}
+	uint32_t GetLateFrames() const {
+		return m_nLateFrames;
+	}
+	uint32_t GetLateMaxMillis() const {
+		return m_nLateMaxMillis;
+	}
+
 	static ShowFile* Get() {
 		return s_pThis;
 	}
@@ -133,10 +192,14 @@ protected:
 	virtual void ShowFileResume()=0;
 	virtual void ShowFileRun()=0;
 	virtual void ShowFilePrint()=0;
+	virtual void ShowFileSeek(uint32_t nMillis)=0;
 
 protected:
 	uint8_t m_nShowFileNumber{ShowFileFile::MAX_NUMBER + 1};
 	bool m_bDoLoop{false};
+	bool m_bChase{false};
+	uint32_t m_nChaseOffsetMillis{0};
+	ShowFileChase m_Chase;
 	FILE *m_pShowFile{nullptr};
 	ShowFileProtocolHandler *m_pShowFileProtocolHandler{nullptr};
 	ShowFileDisplay *m_pShowFileDisplay{nullptr};
@@ -146,6 +209,10 @@ private:
 	char m_aShowFileName[ShowFileFile::NAME_LENGTH + 1]; // Including '\0'
 	bool m_bEnableTFTP{false};
 	ShowFileTFTP *m_pShowFileTFTP{nullptr};
+	uint32_t m_nFrames{0};
+	uint32_t m_nLateFrames{0};
+	uint32_t m_nLateMaxMillis{0};
+	uint32_t m_nLateTotalMillis{0};
 
 	static ShowFile *s_pThis;
 };
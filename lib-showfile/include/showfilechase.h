@@ -0,0 +1,84 @@
+/**
+ * @file showfilechase.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILECHASE_H_
+#define SHOWFILECHASE_H_
+
+#include <stdint.h>
+
+namespace showfilechase {
+static constexpr uint32_t RATE_ONE = 1U << 16;			///< Q16.16, nominal speed
+static constexpr uint32_t RATE_MAX = 2 * RATE_ONE;
+static constexpr uint32_t RATE_WINDOW_MILLIS = 200;		///< Tempo is measured over at least this interval
+static constexpr uint32_t JUMP_MILLIS = 250;			///< A larger error is a locate, not a tempo change
+static constexpr uint32_t FREEWHEEL_MILLIS = 500;		///< Without timecode the position is held after this time
+}  // namespace showfilechase
+
+/**
+ * Local playback clock locked to an external timecode (LTC, MTC, Art-Net).
+ * In between the timecode updates the position is extrapolated with the measured rate.
+ * Small errors are slewed (varispeed), large errors re-base the clock (jump).
+ */
+class ShowFileChase {
+public:
+	void Reset() {
+		m_bLocked = false;
+		m_nRate = showfilechase::RATE_ONE;
+	}
+
+	/**
+	 * @return true when the timecode jumped, the player must seek
+	 */
+	bool Update(uint32_t nTimeCodeMillis, uint32_t nNowMillis);
+	uint32_t Position(uint32_t nNowMillis) const;
+
+	bool IsLocked() const {
+		return m_bLocked;
+	}
+
+	uint32_t GetRate() const {
+		return m_nRate;
+	}
+
+	uint32_t GetJumps() const {
+		return m_nJumps;
+	}
+
+	static uint32_t ToMillis(uint32_t nHours, uint32_t nMinutes, uint32_t nSeconds, uint32_t nFrames, uint32_t nType);
+
+private:
+	void Rebase(uint32_t nTimeCodeMillis, uint32_t nNowMillis);
+
+private:
+	uint32_t m_nBaseMillis{0};
+	uint32_t m_nBaseLocalMillis{0};
+	uint32_t m_nLastTimeCodeMillis{0};
+	uint32_t m_nLastLocalMillis{0};
+	uint32_t m_nRate{showfilechase::RATE_ONE};
+	uint32_t m_nJumps{0};
+	bool m_bLocked{false};
+};
+
+#endif /* SHOWFILECHASE_H_ */
@@ -41,6 +41,8 @@ struct TShowFileParams {
 	uint16_t nUniverse;
 	uint8_t nDisableUnicast;
 	uint8_t nDmxMaster;
+	uint8_t nChaseSource;
+	uint32_t nChaseOffsetMillis;
 } __attribute__((packed));
 
 struct ShowFileOptions {
@@ -59,6 +61,8 @@ struct ShowFileParamsMask {
 	static constexpr auto SACN_UNIVERSE = (1U << 6);
 	static constexpr auto ARTNET_UNICAST_DISABLED = (1U << 7);
 	static constexpr auto DMX_MASTER = (1U << 8);
+	static constexpr auto CHASE_SOURCE = (1U << 9);
+	static constexpr auto CHASE_OFFSET = (1U << 10);
 };
 
 class ShowFileParamsStore {
@@ -104,6 +108,10 @@ public:
 		return isMaskSet(ShowFileParamsMask::ARTNET_UNICAST_DISABLED);
 	}
 
+	ShowFileChaseSources GetChaseSource() const {
+		return static_cast<ShowFileChaseSources>(m_tShowFileParams.nChaseSource);
+	}
+
     static void staticCallbackFunction(void *p, const char *s);
 
 private:
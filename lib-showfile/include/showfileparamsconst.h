@@ -41,6 +41,9 @@ struct ShowFileParamsConst {
 	static  const char PROTOCOL[];
 	static  const char SACN_SYNC_UNIVERSE[];
 	static  const char ARTNET_DISABLE_UNICAST[];
+
+	static  const char CHASE[];
+	static  const char CHASE_OFFSET[];
 };
 
 #endif /* SHOWFILEPARAMSCONST_H_ */
@@ -34,13 +34,15 @@
 
 #include "artnetcontroller.h"
 #include "artnettrigger.h"
+#include "artnettimecode.h"
 
 #include "showfileprotocolhandler.h"
 
-class ShowFileProtocolArtNet: public ShowFileProtocolHandler, public ArtNetTrigger {
+class ShowFileProtocolArtNet: public ShowFileProtocolHandler, public ArtNetTrigger, public ArtNetTimeCode {
 public:
 	ShowFileProtocolArtNet() {
 		m_ArtNetController.SetArtNetTrigger(this);
+		m_ArtNetController.SetArtNetTimeCode(this);
 	}
 
 	~ShowFileProtocolArtNet() override {
@@ -91,6 +93,9 @@ public:
 	// ArtNetTrigger
 	void Handler(const struct TArtNetTrigger *ptArtNetTrigger) override;
 
+	// ArtNetTimeCode, Start() and Stop() are shared with ShowFileProtocolHandler
+	void Handler(const struct TArtNetTimeCode *ptArtNetTimeCode) override;
+
 private:
 	ArtNetController m_ArtNetController;
 };
@@ -0,0 +1,117 @@
+/**
+ * @file showfilezones.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILEZONES_H_
+#define SHOWFILEZONES_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "olashowfilereader.h"
+#include "showfileprotocolhandler.h"
+
+namespace showfilezones {
+static constexpr uint32_t MAX_ZONES = 4;
+static constexpr uint32_t MAX_UNIVERSES = 8;
+static constexpr char FILE_NAME[] = "zones.txt";
+}  // namespace showfilezones
+
+/**
+ * Plays up to MAX_ZONES show files in parallel on a single master clock.
+ * Each zone has its own loop flag, master level and start offset.
+ * The zones are merged (HTP) into one frame per tick, each changed universe
+ * is sent once with DmxOut, followed by a single DmxSync.
+ * The frame statistics are kept by ShowFile.
+ */
+class ShowFileZones {
+public:
+	ShowFileZones(ShowFileProtocolHandler *pShowFileProtocolHandler);
+	~ShowFileZones();
+
+	bool AddZone(uint8_t nShowFileNumber, bool bDoLoop = false, uint8_t nMaster = 255, uint32_t nOffsetMillis = 0);
+	void SetMaster(uint32_t nZone, uint8_t nMaster);
+
+	bool Load();
+
+	void Start();
+	void Stop();
+	void Run();
+	void Print();
+
+	uint32_t GetZones() const {
+		return m_nZones;
+	}
+
+	bool IsRunning() const {
+		return m_bIsRunning;
+	}
+
+private:
+	struct Zone {
+		OlaShowFileReader Reader;
+		FILE *pFile;
+		uint32_t nOffsetMillis;
+		uint32_t nDueMillis;
+		uint32_t nUnderruns;
+		uint8_t nShowFileNumber;
+		uint8_t nMaster;
+		bool bDoLoop;
+		bool bEnded;
+	};
+
+	struct Config {
+		uint8_t nShowFileNumber;
+		uint8_t nMaster;
+		bool bDoLoop;
+		uint32_t nOffsetMillis;
+	};
+
+	struct Universe {
+		uint16_t nUniverse;
+		uint16_t nLength;
+		bool bChanged;
+		uint8_t aZoneData[showfilezones::MAX_ZONES][512];
+		uint8_t aData[512];
+	};
+
+	void Dispatch(uint32_t nZone, const olashowfile::Frame *pFrame);
+	Universe *GetUniverse(uint16_t nUniverse);
+	void Merge(Universe& universe);
+
+	void callbackFunction(const char *pLine);
+	static void staticCallbackFunction(void *p, const char *s);
+
+private:
+	ShowFileProtocolHandler *m_pShowFileProtocolHandler;
+	Zone m_aZone[showfilezones::MAX_ZONES];
+	Universe m_aUniverse[showfilezones::MAX_UNIVERSES];
+	Config m_aConfig[showfilezones::MAX_ZONES];
+	uint32_t m_nZones{0};
+	uint32_t m_nUniverses{0};
+	uint32_t m_nStartMillis{0};
+	bool m_bIsRunning{false};
+};
+
+#endif /* SHOWFILEZONES_H_ */
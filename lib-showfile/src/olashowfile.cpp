@@ -24,17 +24,19 @@
  */
 
 #include <stdio.h>
-#include <ctype.h>
 #include <stdint.h>
 #include <cassert>
 
 #include "olashowfile.h"
 #include "showfile.h"
+#include "showfilechase.h"
 
 #include "hardware.h"
 
 #include "debug.h"
 
+using namespace olashowfile;
+
 OlaShowFile::OlaShowFile() {
 	DEBUG1_ENTRY
 
@@ -46,8 +48,22 @@ void OlaShowFile::ShowFileStart() {
 
 	m_nDelayMillis = 0;
 	m_nLastMillis = 0;
+	m_nDmxDataLength = 0;
+
+	m_Reader.SetFile(m_pShowFile);
+
+	if (m_bChase) {
+		m_Index.Build(m_pShowFile);
+		m_Chase.Reset();
+		m_nShowMillis = 0;
+		m_nFrameMillis = 0;
+		m_nSeeks = 0;
+	}
+
+	m_Reader.Rewind();
+	m_Reader.ReadAhead(READ_AHEAD_FRAMES, m_bDoLoop);
 
-	fseek(m_pShowFile, 0L, SEEK_SET);
+	ResetStatistics();
 
 	m_tState = OlaState::IDLE;
 
@@ -64,112 +80,158 @@ void OlaShowFile::ShowFileResume() {
 	DEBUG1_ENTRY
 
 	m_nDelayMillis = 0;
-	m_nLastMillis = 0;
+	m_nLastMillis = Hardware::Get()->Millis();
 
 	DEBUG1_EXIT
 }
 
 void OlaShowFile::ShowFileRun() {
-	if (m_tState != OlaState::TIME_WAITING) {
-		m_tParseCode = GetNextLine();
+	if (m_bChase) {
+		ShowFileRunChase();
+		return;
+	}
 
-		if (m_tParseCode == OlaParseCode::DMX) {
-			if (m_nDmxDataLength != 0) {
-				m_pShowFileProtocolHandler->DmxOut(m_nUniverse, m_DmxData, m_nDmxDataLength);
-			}
-		} else if (m_tParseCode == OlaParseCode::TIME) {
-			if (m_nDelayMillis != 0) {
-				if (m_nDmxDataLength != 0) {
-					m_pShowFileProtocolHandler->DmxSync();
-				}
-			}
-			m_tState = OlaState::TIME_WAITING;
-		} else if (m_tParseCode == OlaParseCode::EOFILE) {
-			if (m_bDoLoop) {
-				fseek(m_pShowFile, 0L, SEEK_SET);
-			} else {
-				SetShowFileStatus(ShowFileStatus::ENDED);
-			}
+	if (m_tState == OlaState::TIME_WAITING) {
+		const auto nMillis = Hardware::Get()->Millis();
+		const auto nElapsed = nMillis - m_nLastMillis;
+
+		if (nElapsed < m_nDelayMillis) {
+			m_Reader.ReadAhead(READ_AHEAD_LINES, m_bDoLoop);
+			return;
 		}
-	}
 
-	const uint32_t nMillis = Hardware::Get()->Millis();
+		UpdateStatistics(nElapsed - m_nDelayMillis);
 
-	if ((nMillis - m_nLastMillis) >= m_nDelayMillis) {
 		m_nLastMillis = nMillis;
 		m_tState = OlaState::PARSING_DMX;
 	}
-}
 
-OlaParseCode OlaShowFile::ParseDmxData(const char *pLine) {
-	char *p = const_cast<char *>(pLine);
-	int64_t k = 0;
-	uint32_t nLength = 0;
+	auto *pFrame = m_Reader.Front();
 
-	while (isdigit(*p) == 1) {
-		k = k * 10 + *p - '0';
+	if (pFrame == nullptr) {
+		// The read-ahead did not keep up
+		m_nUnderruns++;
+		m_Reader.ReadAhead(1, m_bDoLoop);
+		return;
+	}
 
-		if (k > 255) {
-			DEBUG1_EXIT
-			return OlaParseCode::FAILED;
+	switch (pFrame->tCode) {
+	case OlaParseCode::DMX:
+		m_nDmxDataLength = pFrame->nLength;
+		if (m_nDmxDataLength != 0) {
+			m_pShowFileProtocolHandler->DmxOut(pFrame->nUniverse, pFrame->data, pFrame->nLength);
 		}
+		break;
+	case OlaParseCode::TIME:
+		m_nDelayMillis = pFrame->nDelayMillis;
+		if (m_nDelayMillis != 0) {
+			if (m_nDmxDataLength != 0) {
+				m_pShowFileProtocolHandler->DmxSync();
+			}
+		}
+		if (m_tState == OlaState::IDLE) {
+			m_nLastMillis = Hardware::Get()->Millis();
+		}
+		m_tState = OlaState::TIME_WAITING;
+		break;
+	case OlaParseCode::EOFILE:
+		SetShowFileStatus(ShowFileStatus::ENDED);
+		break;
+	default:
+		break;
+	}
 
-		p++;
-
-		if (*p == ',' || (isdigit(*p) == 0)) {
+	m_Reader.Release();
+}
 
-			if (nLength > 512) {
-				DEBUG1_EXIT
-				return OlaParseCode::FAILED;
-			}
+/*
+ * Chase mode: the frames are sent when the chased time line passes them.
+ * The file is not looped by the reader, a loop is a seek back to the start.
+ */
+void OlaShowFile::ShowFileRunChase() {
+	if (!m_Chase.IsLocked()) {
+		m_Reader.ReadAhead(READ_AHEAD_LINES, false);
+		return;
+	}
 
-			m_DmxData[nLength] = k;
+	const auto nTarget = ChaseTarget(m_Chase.Position(Hardware::Get()->Millis()));
 
-			k = 0;
-			nLength++;
-			p++;
-		}
+	if ((nTarget + showfilechase::JUMP_MILLIS) < m_nFrameMillis) {
+		ShowFileSeek(nTarget);
 	}
 
-	m_nDmxDataLength  = nLength;
+	auto bDmxOut = false;
 
-	return OlaParseCode::DMX;
-}
+	while (m_nShowMillis <= nTarget) {
+		auto *pFrame = m_Reader.Front();
 
-OlaParseCode OlaShowFile::ParseLine(const char *pLine) {
-	char *p = const_cast<char*>(pLine);
-	int32_t k = 0;
+		if (pFrame == nullptr) {
+			m_nUnderruns++;
+			m_Reader.ReadAhead(1, false);
+			break;
+		}
 
-	while (isdigit(*p) == 1) {
-		k = k * 10 + *p - '0';
-		p++;
-	}
+		switch (pFrame->tCode) {
+		case OlaParseCode::DMX:
+			if (pFrame->nLength != 0) {
+				m_pShowFileProtocolHandler->DmxOut(pFrame->nUniverse, pFrame->data, pFrame->nLength);
+				bDmxOut = true;
+			}
+			break;
+		case OlaParseCode::TIME:
+			if (pFrame->nDelayMillis != 0) {
+				UpdateStatistics(nTarget - m_nShowMillis);
+				m_nFrameMillis = m_nShowMillis;
+				m_nShowMillis += pFrame->nDelayMillis;
+				if (bDmxOut) {
+					m_pShowFileProtocolHandler->DmxSync();
+					bDmxOut = false;
+				}
+			}
+			break;
+		case OlaParseCode::EOFILE:
+			// Hold the last frame until the time code goes back
+			m_nShowMillis = UINT32_MAX;
+			break;
+		default:
+			break;
+		}
 
-	if (k > static_cast<int32_t>((static_cast<uint16_t>(~0)))) {
-		return OlaParseCode::FAILED;
+		m_Reader.Release();
 	}
 
-	if (*p++ == ' ') {
-		m_nDelayMillis = 0;
-		m_nUniverse = static_cast<uint32_t>(k);
-		return ParseDmxData(p);
+	if (bDmxOut) {
+		m_pShowFileProtocolHandler->DmxSync();
 	}
 
-	m_nDelayMillis = static_cast<uint32_t>(k);
-
-	return OlaParseCode::TIME;
+	m_Reader.ReadAhead(READ_AHEAD_LINES, false);
 }
 
-OlaParseCode OlaShowFile::GetNextLine() {
-	if (m_pShowFile != nullptr) {
-		if (fgets(s_buffer, (sizeof(s_buffer) - 1), m_pShowFile) != s_buffer) {
-			return OlaParseCode::EOFILE;
-		}
+/*
+ * Called on a time code jump, O(log n) with the index
+ */
+void OlaShowFile::ShowFileSeek(uint32_t nMillis) {
+	if (!m_bChase || (m_pShowFile == nullptr)) {
+		return;
+	}
 
-		if (isdigit(s_buffer[0])) {
-			return ParseLine(s_buffer);
-		}
+	uint32_t nFrameMillis;
+
+	if (m_Index.Seek(m_pShowFile, ChaseTarget(nMillis), nFrameMillis)) {
+		m_Reader.Reset();
+		m_Reader.ReadAhead(READ_AHEAD_FRAMES, false);
+		m_nShowMillis = nFrameMillis;
+		m_nFrameMillis = nFrameMillis;
+		m_nSeeks++;
 	}
+}
 
-	return  OlaParseCode::FAILED;
+void OlaShowFile::ShowFilePrint() {
+	puts("OlaShowFile");
+	printf(" Read-ahead : %u frames\n", READ_AHEAD_FRAMES);
+	printf(" Underruns  : %u\n", m_nUnderruns);
+	if (m_bChase) {
+		printf(" Index      : %u entries, stride %u, %u ms\n", m_Index.GetEntries(), m_Index.GetStride(), m_Index.GetDurationMillis());
+		printf(" Seeks      : %u\n", m_nSeeks);
+	}
 }
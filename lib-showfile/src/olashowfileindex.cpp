@@ -0,0 +1,179 @@
+/**
+ * @file olashowfileindex.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <cassert>
+
+#include "olashowfileindex.h"
+
+#include "debug.h"
+
+using namespace olashowfile;
+
+/*
+ * Reads one line, a time line has only digits
+ * @return false at end of file
+ */
+bool OlaShowFileIndex::GetDelay(FILE *pFile, bool& bIsTime, uint32_t& nDelayMillis) {
+	if (fgets(m_aBuffer, (sizeof(m_aBuffer) - 1), pFile) != m_aBuffer) {
+		return false;
+	}
+
+	const char *p = m_aBuffer;
+	uint32_t k = 0;
+
+	bIsTime = false;
+
+	if (!isdigit(*p)) {
+		return true;
+	}
+
+	while (isdigit(*p)) {
+		k = k * 10 + static_cast<uint32_t>(*p - '0');
+		p++;
+	}
+
+	if (*p == ' ') {
+		return true;
+	}
+
+	bIsTime = true;
+	nDelayMillis = k;
+
+	return true;
+}
+
+void OlaShowFileIndex::Build(FILE *pFile) {
+	DEBUG_ENTRY
+	assert(pFile != nullptr);
+
+	m_nEntries = 0;
+	m_nStride = 1;
+	m_nDurationMillis = 0;
+
+	fseek(pFile, 0L, SEEK_SET);
+
+	uint32_t nFrame = 0;
+	uint32_t nFrameOffset = 0;
+	bool bIsTime;
+	uint32_t nDelayMillis;
+
+	for (;;) {
+		if ((nFrame % m_nStride) == 0) {
+			if (m_nEntries == INDEX_ENTRIES) {
+				for (uint32_t i = 0; i < (INDEX_ENTRIES / 2); i++) {
+					m_aEntry[i] = m_aEntry[2 * i];
+				}
+				m_nEntries = INDEX_ENTRIES / 2;
+				m_nStride *= 2;
+			}
+
+			if ((nFrame % m_nStride) == 0) {
+				m_aEntry[m_nEntries].nMillis = m_nDurationMillis;
+				m_aEntry[m_nEntries].nOffset = nFrameOffset;
+				m_nEntries++;
+			}
+		}
+
+		// Read the frame up to and including its time line
+		bool bEndOfFile = false;
+
+		do {
+			if (!GetDelay(pFile, bIsTime, nDelayMillis)) {
+				bEndOfFile = true;
+				break;
+			}
+		} while (!bIsTime || (nDelayMillis == 0));
+
+		if (bEndOfFile) {
+			break;
+		}
+
+		m_nDurationMillis += nDelayMillis;
+		nFrameOffset = static_cast<uint32_t>(ftell(pFile));
+		nFrame++;
+	}
+
+	fseek(pFile, 0L, SEEK_SET);
+
+	DEBUG_PRINTF("Frames=%u, m_nEntries=%u, m_nStride=%u, m_nDurationMillis=%u", nFrame, m_nEntries, m_nStride, m_nDurationMillis);
+	DEBUG_EXIT
+}
+
+/*
+ * Positions the file at the start of the frame which is shown at nMillis
+ */
+bool OlaShowFileIndex::Seek(FILE *pFile, uint32_t nMillis, uint32_t& nFrameMillis) {
+	assert(pFile != nullptr);
+
+	if (m_nEntries == 0) {
+		return false;
+	}
+
+	// Last entry with nMillis <= the requested time
+	uint32_t nLow = 0;
+	uint32_t nHigh = m_nEntries;
+
+	while ((nHigh - nLow) > 1) {
+		const auto nMiddle = (nLow + nHigh) / 2;
+
+		if (m_aEntry[nMiddle].nMillis <= nMillis) {
+			nLow = nMiddle;
+		} else {
+			nHigh = nMiddle;
+		}
+	}
+
+	auto nFrameOffset = m_aEntry[nLow].nOffset;
+	nFrameMillis = m_aEntry[nLow].nMillis;
+
+	fseek(pFile, static_cast<long>(nFrameOffset), SEEK_SET);
+
+	// Scan the remaining frames in between the index entries
+	for (uint32_t nFrame = 1; nFrame < m_nStride; nFrame++) {
+		bool bIsTime;
+		uint32_t nDelayMillis;
+
+		do {
+			if (!GetDelay(pFile, bIsTime, nDelayMillis)) {
+				fseek(pFile, static_cast<long>(nFrameOffset), SEEK_SET);
+				return true;
+			}
+		} while (!bIsTime || (nDelayMillis == 0));
+
+		if ((nFrameMillis + nDelayMillis) > nMillis) {
+			break;
+		}
+
+		nFrameMillis += nDelayMillis;
+		nFrameOffset = static_cast<uint32_t>(ftell(pFile));
+	}
+
+	fseek(pFile, static_cast<long>(nFrameOffset), SEEK_SET);
+
+	return true;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file olashowfilereader.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <cassert>
+
+#include "olashowfilereader.h"
+
+#include "debug.h"
+
+using namespace olashowfile;
+
+void OlaShowFileReader::Rewind() {
+	if (m_pFile != nullptr) {
+		fseek(m_pFile, 0L, SEEK_SET);
+	}
+
+	Reset();
+}
+
+/*
+ * Discards the frames read ahead, the file position is kept
+ */
+void OlaShowFileReader::Reset() {
+	while (m_ReadAhead.Front() != nullptr) {
+		m_ReadAhead.Release();
+	}
+
+	m_bEndOfFile = false;
+}
+
+/*
+ * Producer: reads and parses at most nLines into free frames of the ring.
+ */
+void OlaShowFileReader::ReadAhead(uint32_t nLines, bool bDoLoop) {
+	while ((nLines-- != 0) && !m_bEndOfFile) {
+		auto *pFrame = m_ReadAhead.Claim();
+
+		if (pFrame == nullptr) {
+			return;
+		}
+
+		const auto tCode = GetNextLine(*pFrame);
+
+		if ((tCode == OlaParseCode::DMX) || (tCode == OlaParseCode::TIME)) {
+			pFrame->tCode = tCode;
+			m_ReadAhead.Publish();
+		} else if (tCode == OlaParseCode::EOFILE) {
+			if (bDoLoop) {
+				fseek(m_pFile, 0L, SEEK_SET);
+			} else {
+				pFrame->tCode = OlaParseCode::EOFILE;
+				m_ReadAhead.Publish();
+				m_bEndOfFile = true;
+			}
+		}
+	}
+}
+
+OlaParseCode OlaShowFileReader::ParseDmxData(const char *pLine, Frame& frame) {
+	char *p = const_cast<char *>(pLine);
+	int64_t k = 0;
+	uint32_t nLength = 0;
+
+	while (isdigit(*p) == 1) {
+		k = k * 10 + *p - '0';
+
+		if (k > 255) {
+			DEBUG1_EXIT
+			return OlaParseCode::FAILED;
+		}
+
+		p++;
+
+		if (*p == ',' || (isdigit(*p) == 0)) {
+
+			if (nLength >= sizeof(frame.data)) {
+				DEBUG1_EXIT
+				return OlaParseCode::FAILED;
+			}
+
+			frame.data[nLength] = k;
+
+			k = 0;
+			nLength++;
+			p++;
+		}
+	}
+
+	frame.nLength = nLength;
+
+	return OlaParseCode::DMX;
+}
+
+OlaParseCode OlaShowFileReader::ParseLine(const char *pLine, Frame& frame) {
+	char *p = const_cast<char*>(pLine);
+	int32_t k = 0;
+
+	while (isdigit(*p) == 1) {
+		k = k * 10 + *p - '0';
+		p++;
+	}
+
+	if (k > static_cast<int32_t>((static_cast<uint16_t>(~0)))) {
+		return OlaParseCode::FAILED;
+	}
+
+	if (*p++ == ' ') {
+		frame.nDelayMillis = 0;
+		frame.nUniverse = static_cast<uint16_t>(k);
+		return ParseDmxData(p, frame);
+	}
+
+	frame.nDelayMillis = static_cast<uint32_t>(k);
+
+	return OlaParseCode::TIME;
+}
+
+OlaParseCode OlaShowFileReader::GetNextLine(Frame& frame) {
+	if (m_pFile != nullptr) {
+		if (fgets(m_aBuffer, (sizeof(m_aBuffer) - 1), m_pFile) != m_aBuffer) {
+			return OlaParseCode::EOFILE;
+		}
+
+		if (isdigit(m_aBuffer[0])) {
+			return ParseLine(m_aBuffer, frame);
+		}
+	}
+
+	return  OlaParseCode::FAILED;
+}
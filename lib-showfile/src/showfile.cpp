@@ -30,6 +30,7 @@
 #include "showfile.h"
 #include "showfiletftp.h"
 
+#include "hardware.h"
 #include "ledblink.h"
 
 #include "debug.h"
@@ -231,8 +232,52 @@ void ShowFile::Run() {
 	}
 }
 
+void ShowFile::SetChase(bool bChase) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("bChase=%d", bChase);
+
+	if (bChase == m_bChase) {
+		DEBUG_EXIT
+		return;
+	}
+
+	m_bChase = bChase;
+	m_Chase.Reset();
+
+	// The index is built and the time line is reset by the start
+	if ((m_tShowFileStatus == ShowFileStatus::RUNNING) && (m_pShowFile != nullptr)) {
+		ShowFileStart();
+	}
+
+	DEBUG_EXIT
+}
+
+void ShowFile::TimeCode(uint32_t nHours, uint32_t nMinutes, uint32_t nSeconds, uint32_t nFrames, uint32_t nType) {
+	if (!m_bChase || (m_tShowFileStatus != ShowFileStatus::RUNNING)) {
+		return;
+	}
+
+	auto nTimeCodeMillis = ShowFileChase::ToMillis(nHours, nMinutes, nSeconds, nFrames, nType);
+
+	if (nTimeCodeMillis < m_nChaseOffsetMillis) {
+		// Before the start of the show file, the output is held
+		m_Chase.Reset();
+		return;
+	}
+
+	nTimeCodeMillis -= m_nChaseOffsetMillis;
+
+	if (m_Chase.Update(nTimeCodeMillis, Hardware::Get()->Millis())) {
+		ShowFileSeek(nTimeCodeMillis);
+	}
+}
+
 void ShowFile::Print() {
 	printf("[%s]\n", m_aShowFileName);
 	printf("%s\n", m_bDoLoop ? "Looping" : "Not looping");
+	if (m_bChase) {
+		printf("Chase: offset %u ms, rate %u.%.3u, jumps %u\n", m_nChaseOffsetMillis, m_Chase.GetRate() >> 16, ((m_Chase.GetRate() & 0xFFFF) * 1000) >> 16, m_Chase.GetJumps());
+	}
+	printf("Frames %u, late %u (max %u ms, avg %u ms)\n", m_nFrames, m_nLateFrames, m_nLateMaxMillis, m_nLateFrames == 0 ? 0 : m_nLateTotalMillis / m_nLateFrames);
 	ShowFilePrint();
 }
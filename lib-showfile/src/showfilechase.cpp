@@ -0,0 +1,109 @@
+/**
+ * @file showfilechase.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "showfilechase.h"
+
+using namespace showfilechase;
+
+namespace timecode {
+static constexpr uint32_t FPS[4] = { 24, 25, 30, 30 };
+static constexpr uint32_t TYPE_DF = 2;
+}  // namespace timecode
+
+void ShowFileChase::Rebase(uint32_t nTimeCodeMillis, uint32_t nNowMillis) {
+	m_nBaseMillis = nTimeCodeMillis;
+	m_nBaseLocalMillis = nNowMillis;
+	m_nLastTimeCodeMillis = nTimeCodeMillis;
+	m_nLastLocalMillis = nNowMillis;
+	m_nRate = RATE_ONE;
+	m_nJumps++;
+	m_bLocked = true;
+}
+
+bool ShowFileChase::Update(uint32_t nTimeCodeMillis, uint32_t nNowMillis) {
+	if (!m_bLocked) {
+		Rebase(nTimeCodeMillis, nNowMillis);
+		return true;
+	}
+
+	const auto nPredicted = Position(nNowMillis);
+	const auto nError = static_cast<int32_t>(nTimeCodeMillis - nPredicted);
+
+	if ((nError > static_cast<int32_t>(JUMP_MILLIS)) || (nError < -static_cast<int32_t>(JUMP_MILLIS))) {
+		Rebase(nTimeCodeMillis, nNowMillis);
+		return true;
+	}
+
+	// Tempo following
+	const auto nDeltaLocal = nNowMillis - m_nLastLocalMillis;
+
+	if (nDeltaLocal >= RATE_WINDOW_MILLIS) {
+		const auto nDelta = static_cast<int32_t>(nTimeCodeMillis - m_nLastTimeCodeMillis);
+		auto nMeasured = nDelta <= 0 ? 0 : static_cast<uint32_t>((static_cast<uint64_t>(nDelta) << 16) / nDeltaLocal);
+
+		if (nMeasured > RATE_MAX) {
+			nMeasured = RATE_MAX;
+		}
+
+		m_nRate = static_cast<uint32_t>(static_cast<int32_t>(m_nRate) + (static_cast<int32_t>(nMeasured) - static_cast<int32_t>(m_nRate)) / 4);
+		m_nLastTimeCodeMillis = nTimeCodeMillis;
+		m_nLastLocalMillis = nNowMillis;
+	}
+
+	// Phase, slew a quarter of the error
+	m_nBaseMillis = nPredicted + static_cast<uint32_t>(nError / 4);
+	m_nBaseLocalMillis = nNowMillis;
+
+	return false;
+}
+
+uint32_t ShowFileChase::Position(uint32_t nNowMillis) const {
+	if (!m_bLocked) {
+		return m_nBaseMillis;
+	}
+
+	auto nElapsed = nNowMillis - m_nBaseLocalMillis;
+
+	if (nElapsed > FREEWHEEL_MILLIS) {
+		nElapsed = FREEWHEEL_MILLIS;
+	}
+
+	return m_nBaseMillis + static_cast<uint32_t>((static_cast<uint64_t>(nElapsed) * m_nRate) >> 16);
+}
+
+uint32_t ShowFileChase::ToMillis(uint32_t nHours, uint32_t nMinutes, uint32_t nSeconds, uint32_t nFrames, uint32_t nType) {
+	const auto nTotalSeconds = (nHours * 60 + nMinutes) * 60 + nSeconds;
+
+	if (nType == timecode::TYPE_DF) {
+		// 29.97 fps, frames 0 and 1 are dropped every minute except every tenth minute
+		const auto nTotalMinutes = nHours * 60 + nMinutes;
+		const auto nFrameNumber = nTotalSeconds * 30 + nFrames - 2 * (nTotalMinutes - nTotalMinutes / 10);
+		return static_cast<uint32_t>((static_cast<uint64_t>(nFrameNumber) * 1001) / 30);
+	}
+
+	return nTotalSeconds * 1000 + (nFrames * 1000) / timecode::FPS[nType & 0x3];
+}
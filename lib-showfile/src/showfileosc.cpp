@@ -55,6 +55,7 @@ namespace cmd {
 	static constexpr char MASTER[] = "master";
 	static constexpr char TFTP[] = "tftp";
 	static constexpr char DELETE[] = "delete";
+	static constexpr char CHASE[] = "chase";
 	// TouchOSC specific
 	static constexpr char RELOAD[] = "reload";
 	static constexpr char INDEX[] = "index";
@@ -71,6 +72,7 @@ namespace length {
 	static constexpr auto MASTER = sizeof(cmd::MASTER) - 1;
 	static constexpr auto TFTP = sizeof(cmd::TFTP) - 1;
 	static constexpr auto DELETE = sizeof(cmd::DELETE) - 1;
+	static constexpr auto CHASE = sizeof(cmd::CHASE) - 1;
 	// TouchOSC specific
 	static constexpr auto RELOAD = sizeof(cmd::RELOAD) - 1;
 	static constexpr auto INDEX = sizeof(cmd::INDEX) - 1;
@@ -230,6 +232,26 @@ void ShowFileOSC::Run() {
 			return;
 		}
 
+		if (memcmp(&m_pBuffer[length::PATH], cmd::CHASE, length::CHASE) == 0) {
+			OscSimpleMessage Msg(m_pBuffer, nBytesReceived);
+
+			int nValue;
+
+			if (Msg.GetType(0) == osc::type::INT32) {
+				nValue = Msg.GetInt(0);
+			} else if (Msg.GetType(0) == osc::type::FLOAT) { // TouchOSC
+				nValue = Msg.GetFloat(0);
+			} else {
+				return;
+			}
+
+			ShowFile::Get()->SetChase(nValue != 0);
+			SendStatus();
+
+			DEBUG_PRINTF("Chase %d", nValue != 0);
+			return;
+		}
+
 
 		if (memcmp(&m_pBuffer[length::PATH], cmd::DELETE, length::DELETE) == 0) {
 			OscSimpleMessage Msg(m_pBuffer, nBytesReceived);
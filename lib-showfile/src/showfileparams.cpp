@@ -59,6 +59,8 @@ struct PROTOCOL2STRING {
 	}
 };
 
+static constexpr char CHASE_SOURCE[static_cast<unsigned>(ShowFileChaseSources::UNDEFINED)][7] = { "none", "artnet", "mtc", "ltc" };
+
 ShowFileParams::ShowFileParams(ShowFileParamsStore *pShowFileParamsStore): m_pShowFileParamsStore(pShowFileParamsStore) {
 	DEBUG_ENTRY
 
@@ -72,6 +74,8 @@ ShowFileParams::ShowFileParams(ShowFileParamsStore *pShowFileParamsStore): m_pSh
 	m_tShowFileParams.nUniverse = DEFAULT_SYNCHRONIZATION_ADDRESS;
 	m_tShowFileParams.nDisableUnicast = 0;
 	m_tShowFileParams.nDmxMaster = DMX_MAX_VALUE;
+	m_tShowFileParams.nChaseSource = static_cast<uint8_t>(ShowFileChaseSources::NONE);
+	m_tShowFileParams.nChaseOffsetMillis = 0;
 
 	DEBUG_EXIT
 }
@@ -137,6 +141,7 @@ void ShowFileParams::callbackFunction(const char *pLine) {
 	uint32_t nLength;
 	uint8_t nValue8;
 	uint16_t nValue16;
+	uint32_t nValue32;
 
 	nLength = ShowFileConst::SHOWFILECONST_FORMAT_NAME_LENGTH - 1;
 	if (Sscan::Char(pLine, ShowFileParamsConst::FORMAT, aValue, nLength) == Sscan::OK) {
@@ -235,6 +240,34 @@ void ShowFileParams::callbackFunction(const char *pLine) {
 		return;
 	}
 
+	nLength = 6;
+	if (Sscan::Char(pLine, ShowFileParamsConst::CHASE, aValue, nLength) == Sscan::OK) {
+		aValue[nLength] = '\0';
+
+		m_tShowFileParams.nChaseSource = static_cast<uint8_t>(ShowFileChaseSources::NONE);
+		m_tShowFileParams.nSetList &= ~ShowFileParamsMask::CHASE_SOURCE;
+
+		for (uint32_t i = static_cast<uint32_t>(ShowFileChaseSources::ARTNET); i < static_cast<uint32_t>(ShowFileChaseSources::UNDEFINED); i++) {
+			if (strcasecmp(aValue, CHASE_SOURCE[i]) == 0) {
+				m_tShowFileParams.nChaseSource = static_cast<uint8_t>(i);
+				m_tShowFileParams.nSetList |= ShowFileParamsMask::CHASE_SOURCE;
+				break;
+			}
+		}
+		return;
+	}
+
+	if (Sscan::Uint32(pLine, ShowFileParamsConst::CHASE_OFFSET, nValue32) == Sscan::OK) {
+		m_tShowFileParams.nChaseOffsetMillis = nValue32;
+
+		if (nValue32 != 0) {
+			m_tShowFileParams.nSetList |= ShowFileParamsMask::CHASE_OFFSET;
+		} else {
+			m_tShowFileParams.nSetList &= ~ShowFileParamsMask::CHASE_OFFSET;
+		}
+		return;
+	}
+
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_AUTO_START, ShowFileOptions::AUTO_START);
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_LOOP, ShowFileOptions::LOOP);
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_DISABLE_SYNC, ShowFileOptions::DISABLE_SYNC);
@@ -265,6 +298,10 @@ void ShowFileParams::Builder(const struct TShowFileParams *ptShowFileParamss, ch
 	builder.AddComment("Art-Net");
 	builder.Add(ShowFileParamsConst::ARTNET_DISABLE_UNICAST, static_cast<uint32_t>(m_tShowFileParams.nDisableUnicast), isMaskSet(ShowFileParamsMask::ARTNET_UNICAST_DISABLED));
 
+	builder.AddComment("Chase timecode: artnet, mtc or ltc, the offset in milliseconds");
+	builder.Add(ShowFileParamsConst::CHASE, CHASE_SOURCE[m_tShowFileParams.nChaseSource < static_cast<uint8_t>(ShowFileChaseSources::UNDEFINED) ? m_tShowFileParams.nChaseSource : 0], isMaskSet(ShowFileParamsMask::CHASE_SOURCE));
+	builder.Add(ShowFileParamsConst::CHASE_OFFSET, m_tShowFileParams.nChaseOffsetMillis, isMaskSet(ShowFileParamsMask::CHASE_OFFSET));
+
 	builder.AddComment("Options");
 	builder.Add(ShowFileParamsConst::OPTION_AUTO_START, isOptionSet(ShowFileOptions::AUTO_START), isOptionSet(ShowFileOptions::AUTO_START));
 	builder.Add(ShowFileParamsConst::OPTION_LOOP, isOptionSet(ShowFileOptions::LOOP), isOptionSet(ShowFileOptions::LOOP));
@@ -327,6 +364,16 @@ void ShowFileParams::Set() {
 		ShowFile::Get()->DoLoop(true);
 	}
 
+	// Chase
+
+	if (isMaskSet(ShowFileParamsMask::CHASE_SOURCE)) {
+		ShowFile::Get()->SetChase(true);
+	}
+
+	if (isMaskSet(ShowFileParamsMask::CHASE_OFFSET)) {
+		ShowFile::Get()->SetChaseOffset(m_tShowFileParams.nChaseOffsetMillis);
+	}
+
 	if (isOptionSet(ShowFileOptions::DISABLE_SYNC)) {
 		if (E131Controller::Get() != nullptr) {
 			E131Controller::Get()->SetSynchronizationAddress(0);
@@ -368,6 +415,14 @@ void ShowFileParams::Dump() {
 		printf(" %s=%u [%s]\n", ShowFileParamsConst::ARTNET_DISABLE_UNICAST, m_tShowFileParams.nDisableUnicast, m_tShowFileParams.nDisableUnicast == 0 ? "No" : "Yes");
 	}
 
+	if (isMaskSet(ShowFileParamsMask::CHASE_SOURCE)) {
+		printf(" %s=%s\n", ShowFileParamsConst::CHASE, CHASE_SOURCE[m_tShowFileParams.nChaseSource]);
+	}
+
+	if (isMaskSet(ShowFileParamsMask::CHASE_OFFSET)) {
+		printf(" %s=%u\n", ShowFileParamsConst::CHASE_OFFSET, m_tShowFileParams.nChaseOffsetMillis);
+	}
+
 	// Options
 
 	if (isMaskSet(ShowFileParamsMask::OPTIONS)) {
@@ -39,3 +39,6 @@ const char ShowFileParamsConst::OPTION_DISABLE_SYNC[] = "disable_sync";
 const char ShowFileParamsConst::PROTOCOL[] = "protocol";
 const char ShowFileParamsConst::SACN_SYNC_UNIVERSE[] = "sync_universe";
 const char ShowFileParamsConst::ARTNET_DISABLE_UNICAST[] = "disable_unicast";
+
+const char ShowFileParamsConst::CHASE[] = "chase";
+const char ShowFileParamsConst::CHASE_OFFSET[] = "chase_offset";
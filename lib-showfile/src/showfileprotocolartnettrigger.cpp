@@ -33,6 +33,7 @@
 #include "showfile.h"
 
 #include "artnettrigger.h"
+#include "artnettimecode.h"
 
 #include "debug.h"
 
@@ -66,3 +67,11 @@ void ShowFileProtocolArtNet::Handler(const struct TArtNetTrigger *ptArtNetTrigge
 
 	DEBUG_EXIT
 }
+
+void ShowFileProtocolArtNet::Handler(const struct TArtNetTimeCode *ptArtNetTimeCode) {
+	if (__builtin_expect((ptArtNetTimeCode->Frames > 29 || ptArtNetTimeCode->Minutes > 59 || ptArtNetTimeCode->Seconds > 59 || ptArtNetTimeCode->Type > 3), 0)) {
+		return;
+	}
+
+	ShowFile::Get()->TimeCode(ptArtNetTimeCode->Hours, ptArtNetTimeCode->Minutes, ptArtNetTimeCode->Seconds, ptArtNetTimeCode->Frames, ptArtNetTimeCode->Type);
+}
@@ -0,0 +1,387 @@
+/**
+ * @file showfilezones.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cassert>
+
+#include "showfilezones.h"
+#include "showfile.h"
+#include "olashowfilereader.h"
+
+#include "readconfigfile.h"
+#include "sscan.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+using namespace showfilezones;
+using namespace olashowfile;
+
+ShowFileZones::ShowFileZones(ShowFileProtocolHandler *pShowFileProtocolHandler): m_pShowFileProtocolHandler(pShowFileProtocolHandler) {
+	DEBUG_ENTRY
+	assert(m_pShowFileProtocolHandler != nullptr);
+
+	for (uint32_t i = 0; i < MAX_ZONES; i++) {
+		m_aZone[i].pFile = nullptr;
+		m_aConfig[i].nShowFileNumber = ShowFileFile::MAX_NUMBER + 1;
+	}
+
+	DEBUG_EXIT
+}
+
+ShowFileZones::~ShowFileZones() {
+	DEBUG_ENTRY
+
+	for (uint32_t i = 0; i < m_nZones; i++) {
+		if (m_aZone[i].pFile != nullptr) {
+			fclose(m_aZone[i].pFile);
+			m_aZone[i].pFile = nullptr;
+		}
+	}
+
+	DEBUG_EXIT
+}
+
+bool ShowFileZones::AddZone(uint8_t nShowFileNumber, bool bDoLoop, uint8_t nMaster, uint32_t nOffsetMillis) {
+	DEBUG_PRINTF("nShowFileNumber=%u, bDoLoop=%d, nMaster=%u, nOffsetMillis=%u", nShowFileNumber, bDoLoop, nMaster, nOffsetMillis);
+
+	if ((m_nZones == MAX_ZONES) || m_bIsRunning) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	char aFileName[ShowFileFile::NAME_LENGTH + 1];
+
+	if (!ShowFile::ShowFileNameCopyTo(aFileName, sizeof(aFileName), nShowFileNumber)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	auto *pFile = fopen(aFileName, "r");
+
+	if (pFile == nullptr) {
+		perror(aFileName);
+		DEBUG_EXIT
+		return false;
+	}
+
+	auto& zone = m_aZone[m_nZones++];
+
+	zone.pFile = pFile;
+	zone.nOffsetMillis = nOffsetMillis;
+	zone.nDueMillis = nOffsetMillis;
+	zone.nUnderruns = 0;
+	zone.nShowFileNumber = nShowFileNumber;
+	zone.nMaster = nMaster;
+	zone.bDoLoop = bDoLoop;
+	zone.bEnded = false;
+	zone.Reader.SetFile(pFile);
+
+	DEBUG_EXIT
+	return true;
+}
+
+void ShowFileZones::SetMaster(uint32_t nZone, uint8_t nMaster) {
+	if (nZone >= m_nZones) {
+		return;
+	}
+
+	m_aZone[nZone].nMaster = nMaster;
+
+	for (uint32_t i = 0; i < m_nUniverses; i++) {
+		m_aUniverse[i].bChanged = true;
+	}
+}
+
+void ShowFileZones::Start() {
+	DEBUG_ENTRY
+
+	m_nUniverses = 0;
+
+	if (ShowFile::Get() != nullptr) {
+		ShowFile::Get()->ResetStatistics();
+	}
+
+	for (uint32_t i = 0; i < m_nZones; i++) {
+		auto& zone = m_aZone[i];
+
+		zone.Reader.Rewind();
+		zone.Reader.ReadAhead(READ_AHEAD_FRAMES, zone.bDoLoop);
+		zone.nDueMillis = zone.nOffsetMillis;
+		zone.nUnderruns = 0;
+		zone.bEnded = false;
+	}
+
+	m_nStartMillis = Hardware::Get()->Millis();
+	m_bIsRunning = true;
+
+	DEBUG_EXIT
+}
+
+void ShowFileZones::Stop() {
+	DEBUG_ENTRY
+
+	m_bIsRunning = false;
+
+	DEBUG_EXIT
+}
+
+/*
+ * One tick of the master clock: every zone dispatches the frames that are due,
+ * then each changed universe is merged and sent, followed by a single sync.
+ * The remaining time is used to read ahead.
+ */
+void ShowFileZones::Run() {
+	if (!m_bIsRunning) {
+		return;
+	}
+
+	const auto nNowMillis = Hardware::Get()->Millis() - m_nStartMillis;
+	auto bAllEnded = true;
+
+	for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+		auto& zone = m_aZone[nZone];
+
+		if (zone.bEnded) {
+			continue;
+		}
+
+		while (static_cast<int32_t>(nNowMillis - zone.nDueMillis) >= 0) {
+			const auto *pFrame = zone.Reader.Front();
+
+			if (pFrame == nullptr) {
+				zone.nUnderruns++;
+				zone.Reader.ReadAhead(1, zone.bDoLoop);
+				break;
+			}
+
+			if ((pFrame->tCode == OlaParseCode::TIME) && (pFrame->nDelayMillis != 0) && (ShowFile::Get() != nullptr)) {
+				ShowFile::Get()->UpdateStatistics(nNowMillis - zone.nDueMillis);
+			}
+
+			Dispatch(nZone, pFrame);
+			zone.Reader.Release();
+
+			if (zone.bEnded) {
+				break;
+			}
+		}
+
+		if (!zone.bEnded) {
+			bAllEnded = false;
+		}
+	}
+
+	auto bSync = false;
+
+	for (uint32_t i = 0; i < m_nUniverses; i++) {
+		auto& universe = m_aUniverse[i];
+
+		if (universe.bChanged) {
+			Merge(universe);
+			m_pShowFileProtocolHandler->DmxOut(universe.nUniverse, universe.aData, universe.nLength);
+			universe.bChanged = false;
+			bSync = true;
+		}
+	}
+
+	if (bSync) {
+		m_pShowFileProtocolHandler->DmxSync();
+	}
+
+	if (bAllEnded) {
+		m_bIsRunning = false;
+		return;
+	}
+
+	for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+		auto& zone = m_aZone[nZone];
+
+		if (!zone.bEnded) {
+			zone.Reader.ReadAhead(READ_AHEAD_LINES, zone.bDoLoop);
+		}
+	}
+}
+
+void ShowFileZones::Dispatch(uint32_t nZone, const Frame *pFrame) {
+	auto& zone = m_aZone[nZone];
+
+	switch (pFrame->tCode) {
+	case OlaParseCode::DMX: {
+		auto *pUniverse = GetUniverse(pFrame->nUniverse);
+
+		if ((pUniverse == nullptr) || (pFrame->nLength == 0)) {
+			break;
+		}
+
+		memcpy(pUniverse->aZoneData[nZone], pFrame->data, pFrame->nLength);
+
+		if (pFrame->nLength > pUniverse->nLength) {
+			pUniverse->nLength = pFrame->nLength;
+		}
+
+		pUniverse->bChanged = true;
+	}
+		break;
+	case OlaParseCode::TIME:
+		zone.nDueMillis += pFrame->nDelayMillis;
+		break;
+	case OlaParseCode::EOFILE:
+		zone.bEnded = true;
+		break;
+	default:
+		break;
+	}
+}
+
+ShowFileZones::Universe *ShowFileZones::GetUniverse(uint16_t nUniverse) {
+	for (uint32_t i = 0; i < m_nUniverses; i++) {
+		if (m_aUniverse[i].nUniverse == nUniverse) {
+			return &m_aUniverse[i];
+		}
+	}
+
+	if (m_nUniverses == MAX_UNIVERSES) {
+		return nullptr;
+	}
+
+	auto& universe = m_aUniverse[m_nUniverses++];
+
+	universe.nUniverse = nUniverse;
+	universe.nLength = 0;
+	universe.bChanged = false;
+	memset(universe.aZoneData, 0, sizeof(universe.aZoneData));
+
+	return &universe;
+}
+
+/*
+ * Highest takes precedence, each zone scaled by its master
+ */
+void ShowFileZones::Merge(Universe& universe) {
+	for (uint32_t nSlot = 0; nSlot < universe.nLength; nSlot++) {
+		uint32_t nValue = 0;
+
+		for (uint32_t nZone = 0; nZone < m_nZones; nZone++) {
+			const auto nZoneValue = (static_cast<uint32_t>(universe.aZoneData[nZone][nSlot]) * m_aZone[nZone].nMaster) / 255U;
+
+			if (nZoneValue > nValue) {
+				nValue = nZoneValue;
+			}
+		}
+
+		universe.aData[nSlot] = static_cast<uint8_t>(nValue);
+	}
+}
+
+bool ShowFileZones::Load() {
+	DEBUG_ENTRY
+
+	for (uint32_t i = 0; i < MAX_ZONES; i++) {
+		m_aConfig[i].nShowFileNumber = ShowFileFile::MAX_NUMBER + 1;
+		m_aConfig[i].nMaster = 255;
+		m_aConfig[i].bDoLoop = false;
+		m_aConfig[i].nOffsetMillis = 0;
+	}
+
+	ReadConfigFile configfile(ShowFileZones::staticCallbackFunction, this);
+
+	if (!configfile.Read(FILE_NAME)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	for (uint32_t i = 0; i < MAX_ZONES; i++) {
+		const auto& config = m_aConfig[i];
+
+		if (config.nShowFileNumber <= ShowFileFile::MAX_NUMBER) {
+			AddZone(config.nShowFileNumber, config.bDoLoop, config.nMaster, config.nOffsetMillis);
+		}
+	}
+
+	DEBUG_EXIT
+	return (m_nZones != 0);
+}
+
+/*
+ * zone<N>_show=<NN>, zone<N>_loop=<0|1>, zone<N>_master=<0..255>, zone<N>_offset=<milliseconds>
+ */
+void ShowFileZones::callbackFunction(const char *pLine) {
+	assert(pLine != nullptr);
+
+	if ((memcmp(pLine, "zone", 4) != 0) || (pLine[4] < '1') || (pLine[4] > static_cast<char>('0' + MAX_ZONES)) || (pLine[5] != '_')) {
+		return;
+	}
+
+	auto& config = m_aConfig[pLine[4] - '1'];
+	const auto *pName = &pLine[6];
+	uint8_t nValue8;
+	uint32_t nValue32;
+
+	if (Sscan::Uint8(pName, "show", nValue8) == Sscan::OK) {
+		config.nShowFileNumber = nValue8;
+		return;
+	}
+
+	if (Sscan::Uint8(pName, "loop", nValue8) == Sscan::OK) {
+		config.bDoLoop = (nValue8 != 0);
+		return;
+	}
+
+	if (Sscan::Uint8(pName, "master", nValue8) == Sscan::OK) {
+		config.nMaster = nValue8;
+		return;
+	}
+
+	if (Sscan::Uint32(pName, "offset", nValue32) == Sscan::OK) {
+		config.nOffsetMillis = nValue32;
+	}
+}
+
+void ShowFileZones::staticCallbackFunction(void *p, const char *s) {
+	assert(p != nullptr);
+	assert(s != nullptr);
+
+	(static_cast<ShowFileZones *>(p))->callbackFunction(s);
+}
+
+void ShowFileZones::Print() {
+	puts("ShowFileZones");
+	printf(" Zones     : %u\n", m_nZones);
+
+	for (uint32_t i = 0; i < m_nZones; i++) {
+		const auto& zone = m_aZone[i];
+		printf("  %u: show%.2u.txt, master %u, offset %u ms%s, underruns %u\n", i + 1, zone.nShowFileNumber, zone.nMaster, zone.nOffsetMillis, zone.bDoLoop ? ", loop" : "", zone.nUnderruns);
+	}
+
+	printf(" Universes : %u\n", m_nUniverses);
+
+	if (ShowFile::Get() != nullptr) {
+		printf(" Frames %u, late %u (max %u ms)\n", ShowFile::Get()->GetFrames(), ShowFile::Get()->GetLateFrames(), ShowFile::Get()->GetLateMaxMillis());
+	}
+}
@@ -44,6 +44,11 @@ extern int spi_flash_cmd_write_multi(uint32_t offset, size_t len, const void *bu
 extern int spi_flash_cmd_erase(uint32_t offset, size_t len);
 extern int spi_flash_cmd_write_status(uint8_t sr);
 
+#if !defined (BARE_METAL) && !defined (RASPPI)
+/* Flash simulator, the erase count of a sector for wear statistics */
+extern uint32_t spi_flash_get_erase_count(uint32_t sector);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,12 @@ static FILE *file = NULL;
 #define FLASH_SECTOR_SIZE	4096
 #define FLASH_SIZE			(512 * FLASH_SECTOR_SIZE)
 
+/*
+ * Like a NOR flash, programming can only clear bits.
+ * The erase count per sector is kept for wear statistics.
+ */
+static uint32_t erase_count[FLASH_SIZE / FLASH_SECTOR_SIZE];
+
 #define FLASH_FILE_NAME		"spiflash.bin"
 
 int spi_flash_probe(__attribute__((unused)) unsigned int cs, __attribute__((unused)) unsigned int max_hz, __attribute__((unused)) unsigned int spi_mode) {
@@ -145,10 +151,26 @@ int spi_flash_cmd_erase(uint32_t offset, size_t len) {
 
 	sync();
 
+	for (i = 0; i < len; i += FLASH_SECTOR_SIZE) {
+		const uint32_t sector = (offset + i) / FLASH_SECTOR_SIZE;
+		if (sector < sizeof(erase_count) / sizeof(erase_count[0])) {
+			erase_count[sector]++;
+			DEBUG_PRINTF("sector=%u, erase_count=%u", sector, erase_count[sector]);
+		}
+	}
+
 	DEBUG_EXIT
 	return 0;
 }
 
+uint32_t spi_flash_get_erase_count(uint32_t sector) {
+	if (sector < sizeof(erase_count) / sizeof(erase_count[0])) {
+		return erase_count[sector];
+	}
+
+	return 0;
+}
+
 int spi_flash_cmd_write_multi(uint32_t offset, size_t len, const void *buf) {
 	DEBUG_ENTRY
 
@@ -156,13 +178,38 @@ int spi_flash_cmd_write_multi(uint32_t offset, size_t len, const void *buf) {
 
 	DEBUG_PRINTF("offset=%d, len=%d", (int) offset, (int) len);
 
+	uint8_t *data = malloc(len);
+
+	if (data == NULL) {
+		perror("malloc");
+		DEBUG_EXIT
+		return -1;
+	}
+
+	if ((fseek(file, offset, SEEK_SET) != 0) || (fread(data, 1, len, file) != len)) {
+		perror("fread");
+		free(data);
+		DEBUG_EXIT
+		return -1;
+	}
+
+	size_t i;
+	for (i = 0; i < len; i++) {
+		data[i] &= ((const uint8_t *) buf)[i];
+	}
+
 	if (fseek(file, offset, SEEK_SET) != 0) {
 		perror("fseek");
+		free(data);
 		DEBUG_EXIT
 		return -1;
 	}
 
-	if (fwrite(buf, 1, len, file) != len) {
+	const size_t written = fwrite(data, 1, len, file);
+
+	free(data);
+
+	if (written != len) {
 		perror("fwrite");
 		DEBUG_EXIT
 		return -1;
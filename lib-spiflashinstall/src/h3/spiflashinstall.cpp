@@ -33,17 +33,19 @@
 #include "display.h"
 
 #include "spi_flash.h"
+#include "spiflashstore.h"
 
 #include "hardware.h"
 
 #include "debug.h"
 
 #define OFFSET_UBOOT_SPI	0x000000
-#define OFFSET_UIMAGE		0x180000
+#define OFFSET_UIMAGE		spiflashstore::uimage::OFFSET
 
 #define COMPARE_BYTES		1024
 
 #define FLASH_SIZE_MINIMUM	0x200000
+#define FLASH_SIZE_STORE	spiflashstore::journal::SIZE
 
 constexpr char aFileUbootSpi[] = "uboot.spi";
 constexpr char aFileuImage[] = "uImage";
@@ -122,6 +124,17 @@ SpiFlashInstall::~SpiFlashInstall() {
 
 void SpiFlashInstall::Process(const char *pFileName, uint32_t nOffset) {
 	if (Open(pFileName)) {
+		if (nOffset == OFFSET_UIMAGE) {
+			static_cast<void>(fseek(m_pFile, 0L, SEEK_END));
+			const auto nSize = static_cast<uint32_t>(ftell(m_pFile));
+
+			if ((OFFSET_UIMAGE + nSize) > (m_nFlashSize - FLASH_SIZE_STORE)) {
+				printf("error: flash size %d > %d\n", (OFFSET_UIMAGE + nSize), (m_nFlashSize - FLASH_SIZE_STORE));
+				Close();
+				return;
+			}
+		}
+
 		Display::Get()->TextStatus(aCheckDifference, Display7SegmentMessage::INFO_SPI_CHECK);
 		puts(aCheckDifference);
 
@@ -305,8 +318,8 @@ bool SpiFlashInstall::WriteFirmware(const uint8_t* pBuffer, uint32_t nSize) {
 	assert(pBuffer != nullptr);
 	DEBUG_PRINTF("(%d + %d)=%d, m_nFlashSize=%d", OFFSET_UIMAGE, nSize, (OFFSET_UIMAGE + nSize), m_nFlashSize);
 
-	if ((OFFSET_UIMAGE + nSize) > m_nFlashSize) {
-		printf("error: flash size %d > %d\n", (OFFSET_UIMAGE + nSize), m_nFlashSize);
+	if ((OFFSET_UIMAGE + nSize) > (m_nFlashSize - FLASH_SIZE_STORE)) {
+		printf("error: flash size %d > %d\n", (OFFSET_UIMAGE + nSize), (m_nFlashSize - FLASH_SIZE_STORE));
 		DEBUG_EXIT
 		return false;
 	}
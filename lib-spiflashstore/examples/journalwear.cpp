@@ -0,0 +1,214 @@
+/**
+ * @file journalwear.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Runs the store journal on the flash simulator.
+ * Reports the erase count per journal sector, the flash time per Flash() step,
+ * and checks that a uImage reaching into the journal is never erased.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#include "spiflashstore.h"
+#include "spi_flash.h"
+
+using namespace spiflashstore;
+
+namespace model {
+// Winbond W25Q16JV, typical
+static constexpr uint32_t SECTOR_ERASE_MICROS = 45000;
+static constexpr uint32_t PAGE_PROGRAM_MICROS = 400;
+}  // namespace model
+
+static uint32_t journal_erases(uint32_t *pSectors = nullptr) {
+	const auto nFirst = (spi_flash_get_size() - journal::SIZE) / journal::SECTOR_SIZE;
+	uint32_t nTotal = 0;
+
+	for (uint32_t i = 0; i < journal::SECTORS; i++) {
+		const auto nCount = spi_flash_get_erase_count(nFirst + i);
+		if (pSectors != nullptr) {
+			pSectors[i] = nCount;
+		}
+		nTotal += nCount;
+	}
+
+	return nTotal;
+}
+
+static uint32_t other_erases() {
+	const auto nLast = (spi_flash_get_size() - journal::SIZE) / journal::SECTOR_SIZE;
+	uint32_t nTotal = 0;
+
+	for (uint32_t i = 0; i < nLast; i++) {
+		nTotal += spi_flash_get_erase_count(i);
+	}
+
+	return nTotal;
+}
+
+struct Steps {
+	uint32_t nSteps;
+	uint32_t nEraseSteps;
+	uint32_t nMaxModelMicros;
+	double fMaxWallMicros;
+};
+
+static void drain(SpiFlashStore& store, Steps& steps) {
+	for (;;) {
+		const auto nErasesBefore = journal_erases();
+		const auto start = std::chrono::steady_clock::now();
+		const auto bPending = store.Flash();
+		const std::chrono::duration<double, std::micro> wall = std::chrono::steady_clock::now() - start;
+
+		if (!bPending) {
+			return;
+		}
+
+		const auto bErased = (journal_erases() != nErasesBefore);
+		const auto nModel = bErased ? model::SECTOR_ERASE_MICROS : 2 * model::PAGE_PROGRAM_MICROS;
+
+		steps.nSteps++;
+		steps.nEraseSteps += bErased ? 1 : 0;
+		if (nModel > steps.nMaxModelMicros) {
+			steps.nMaxModelMicros = nModel;
+		}
+		if (wall.count() > steps.fMaxWallMicros) {
+			steps.fMaxWallMicros = wall.count();
+		}
+	}
+}
+
+static bool wear(uint32_t nUpdates) {
+	puts("Wear");
+
+	SpiFlashStore store;
+
+	if (!store.HaveFlashChip() || store.IsReadOnly()) {
+		puts("error: no writable store");
+		return false;
+	}
+
+	Steps steps {0, 0, 0, 0};
+	drain(store, steps);
+
+	const auto nOtherBefore = other_erases();
+	uint8_t aData[32];
+
+	for (uint32_t i = 0; i < nUpdates; i++) {
+		// A remote configuration change, a few bytes of one store
+		memset(aData, static_cast<int>(i), sizeof(aData));
+		store.Update(Store::DMXSEND, 4, aData, 4 + (i % 8));
+
+		if ((i % 16) == 0) {
+			memset(aData, static_cast<int>(i >> 4), sizeof(aData));
+			store.Update(Store::SHOW, 4, aData, sizeof(aData));
+		}
+
+		drain(store, steps);
+	}
+
+	uint32_t aSectors[journal::SECTORS];
+	const auto nTotal = journal_erases(aSectors);
+	uint32_t nMin = UINT32_MAX, nMax = 0;
+
+	for (uint32_t i = 0; i < journal::SECTORS; i++) {
+		printf(" sector %u: %u erases\n", i, aSectors[i]);
+		nMin = aSectors[i] < nMin ? aSectors[i] : nMin;
+		nMax = aSectors[i] > nMax ? aSectors[i] : nMax;
+	}
+
+	printf(" %u updates, %u erases, %.1f updates per erase, spread %u..%u\n", nUpdates, nTotal, static_cast<double>(nUpdates) / nTotal, nMin, nMax);
+	printf(" %u Flash() steps, %u erase steps, max %u us flash time per step (model), max %.0f us wall (simulator)\n", steps.nSteps, steps.nEraseSteps, steps.nMaxModelMicros, steps.fMaxWallMicros);
+
+	// The data must survive a reboot
+	uint8_t aExpected[1024];	// Largest store
+	uint32_t nLength;
+	store.CopyTo(Store::DMXSEND, aExpected, nLength);
+
+	SpiFlashStore reboot;
+	uint8_t aReplayed[1024];	// Largest store
+	reboot.CopyTo(Store::DMXSEND, aReplayed, nLength);
+
+	const auto bReplay = (memcmp(aExpected, aReplayed, nLength) == 0);
+	const auto bOther = (other_erases() == nOtherBefore);
+	const auto bSpread = (nMax - nMin) <= 1;
+
+	printf(" replay %s, erases outside the journal %s, wear leveling %s\n", bReplay ? "OK" : "FAILED", bOther ? "none" : "FAILED", bSpread ? "OK" : "FAILED");
+
+	return bReplay && bOther && bSpread;
+}
+
+static bool overlap() {
+	puts("uImage reaching into the journal");
+
+	remove("spiflash.bin");
+	spi_flash_probe(0, 0, 0);
+
+	// A 500K uImage as installed by the previous firmware, before the journal
+	uint8_t aHeader[uimage::HEADER_SIZE];
+	memset(aHeader, 0, sizeof(aHeader));
+	const uint32_t nMagic = __builtin_bswap32(0x27051956);
+	const uint32_t nSize = __builtin_bswap32(500 * 1024);
+	memcpy(&aHeader[0], &nMagic, sizeof(nMagic));
+	memcpy(&aHeader[12], &nSize, sizeof(nSize));
+	spi_flash_cmd_write_multi(uimage::OFFSET, sizeof(aHeader), aHeader);
+
+	const auto nErasesBefore = journal_erases();
+
+	SpiFlashStore store;
+
+	uint8_t aData[8];
+	memset(aData, 0x5A, sizeof(aData));
+	store.Update(Store::DMXSEND, 4, aData, sizeof(aData));
+
+	Steps steps {0, 0, 0, 0};
+	drain(store, steps);
+
+	const auto bReadOnly = store.IsReadOnly();
+	const auto bUntouched = (journal_erases() == nErasesBefore);
+
+	printf(" read-only %s, journal sectors erased %s\n", bReadOnly ? "yes" : "FAILED", bUntouched ? "none" : "FAILED");
+
+	return bReadOnly && bUntouched;
+}
+
+int main(int argc, char **argv) {
+	const uint32_t nUpdates = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : 2000;
+
+	remove("spiflash.bin");
+
+	auto bResult = wear(nUpdates);
+	bResult &= overlap();
+
+	remove("spiflash.bin");
+
+	puts(bResult ? "PASS" : "FAIL");
+
+	return bResult ? EXIT_SUCCESS : EXIT_FAILURE;
+}
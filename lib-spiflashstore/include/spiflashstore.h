@@ -63,6 +63,18 @@ enum class Store {
 	RGBPANEL,
 	LAST
 };
+
+namespace journal {
+static constexpr uint32_t SECTOR_SIZE = 4096;
+static constexpr uint32_t SECTORS = 8;
+static constexpr uint32_t COMPACT_SECTORS = SECTORS / 2;
+static constexpr uint32_t SIZE = SECTORS * SECTOR_SIZE;
+}  // namespace journal
+
+namespace uimage {
+static constexpr uint32_t OFFSET = 0x180000;	///< The firmware must end before the journal
+static constexpr uint32_t HEADER_SIZE = 64;
+}  // namespace uimage
 }  // namespace spiflashstore
 
 class SpiFlashStore {
@@ -74,15 +86,35 @@ public:
 		return m_bHaveFlashChip;
 	}
 
+	/**
+	 * True when the installed uImage extends into the journal.
+	 * The stores are then loaded from the single sector image, but not written.
+	 */
+	bool IsReadOnly() const {
+		return m_bReadOnly;
+	}
+
 	void Update(spiflashstore::Store tStore, uint32_t nOffset, const void *pData, uint32_t nDataLength, uint32_t nSetList = 0, uint32_t nOffsetSetList = 0);
 	void Update(spiflashstore::Store tStore, const void *pData, uint32_t nDataLength) {
 		Update(tStore, 0, pData, nDataLength);
 	}
 	void Copy(spiflashstore::Store tStore, void *pData, uint32_t nDataLength, uint32_t nOffset = 0);
 	void CopyTo(spiflashstore::Store tStore, void *pData, uint32_t &nDataLength);
+	uint32_t GetStoreSize(spiflashstore::Store tStore) const;
 
 	void ResetSetList(spiflashstore::Store tStore);
 
+	/**
+	 * Incremented on each change of the store, starts at 0 after boot
+	 */
+	uint16_t GetVersion(spiflashstore::Store tStore) const {
+		return m_aVersion[static_cast<uint32_t>(tStore)];
+	}
+
+	/**
+	 * Performs at most one flash erase or program step, to be called from the main loop.
+	 * Returns true as long as there is pending work.
+	 */
 	bool Flash();
 
 	void Dump();
@@ -93,13 +125,24 @@ public:
 
 private:
 	bool Init();
+	uint32_t GetUImageEnd();
+	void LoadSingleSectorImage();
 	uint32_t GetStoreOffset(spiflashstore::Store tStore);
+	void ResetImage();
+	void MarkDirty(spiflashstore::Store tStore, uint32_t nFrom, uint32_t nTo);
+	bool IsErased(uint32_t nAddress, uint32_t nLength);
+	bool Replay(uint32_t nSequence);
+	bool OpenSector(bool bSnapshot);
+	bool WriteRecord(uint8_t nType, uint32_t nStore, uint32_t nOffset, uint32_t nLength);
+	void StartCompaction();
+	bool Compact();
 
 private:
 	bool m_bHaveFlashChip { false };
 	bool m_bIsNew { false };
+	bool m_bReadOnly { false };
 	enum class State {
-		IDLE, CHANGED, ERASED
+		IDLE, CHANGED, COMPACTING
 	};
 	State m_tState { State::IDLE };
 	uint32_t m_nStartAddress { 0 };
@@ -108,6 +151,28 @@ private:
 	};
 	uint32_t m_nSpiFlashStoreSize { FlashStore::SIZE };
 	uint8_t m_aSpiFlashData[FlashStore::SIZE];
+	uint16_t m_aVersion[static_cast<uint32_t>(spiflashstore::Store::LAST)];
+	struct Dirty {
+		uint16_t nFrom;
+		uint16_t nTo;
+	};
+	Dirty m_aDirty[static_cast<uint32_t>(spiflashstore::Store::LAST)];
+	/*
+	 * Journal
+	 */
+	struct Sector {
+		uint32_t nSequence;	///< 0 when the sector has no valid header
+		bool bSnapshot;
+		bool bErased;
+	};
+	Sector m_aSector[spiflashstore::journal::SECTORS];
+	uint32_t m_nSequence { 0 };			///< Sequence of the sector being written
+	uint32_t m_nLiveSequence { 1 };		///< First sector of the committed generation
+	uint32_t m_nWriteSector { spiflashstore::journal::SECTORS - 1 };
+	uint32_t m_nWriteOffset { spiflashstore::journal::SECTOR_SIZE };
+	uint32_t m_nCompactSequence { 0 };
+	uint32_t m_nCompactStore { 0 };
+	uint32_t m_nCompactOffset { 0 };
 
 #if !defined( NO_EMAC )
 	StoreNetwork m_StoreNetwork;
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <cassert>
 
 #include "spiflashstore.h"
@@ -46,6 +47,72 @@ static constexpr uint32_t s_aStorSize[static_cast<uint32_t>(Store::LAST)]  = {96
 static constexpr char s_aStoreName[static_cast<uint32_t>(Store::LAST)][16] = {"Network", "Art-Net3", "DMX", "WS28xx", "E1.31", "LTC", "MIDI", "Art-Net4", "OSC Server", "TLC59711", "USB Pro", "RDM Device", "RConfig", "TCNet", "OSC Client", "Display", "LTC Display", "Monitor", "SparkFun", "Slush", "Motors", "Show", "Serial", "RDM Sensors", "RDM SubDevices", "GPS", "RGB Panel"};
 #endif
 
+/*
+ * The stores are kept in a log across the last journal::SECTORS sectors of the flash.
+ * An Update only appends the changed bytes as a record. When the log has grown to
+ * journal::COMPACT_SECTORS sectors, a snapshot of all stores is appended, followed
+ * by a commit record. After the commit the sectors before the snapshot are free.
+ * On boot the newest committed snapshot and all records after it are replayed.
+ *
+ * A record is programmed data first and header last, the header carries a CRC.
+ * A record interrupted by a power failure is therefore ignored on replay.
+ */
+
+namespace spiflashstore {
+namespace journal {
+static constexpr uint8_t MAGIC[] = {'A', 'v', 'J', 0x10};
+
+struct SectorHeader {
+	uint8_t aMagic[4];
+	uint32_t nSequence;
+	uint8_t nFlags;
+	uint8_t aReserved[7];
+} __attribute__((packed));
+
+namespace sector {
+static constexpr uint8_t SNAPSHOT = (1U << 0);
+}  // namespace sector
+
+struct Record {
+	uint8_t nType;
+	uint8_t nStore;
+	uint16_t nOffset;
+	uint16_t nLength;
+	uint16_t nCrc;
+} __attribute__((packed));
+
+namespace record {
+static constexpr uint8_t FREE = 0xFF;
+static constexpr uint8_t DATA = 0xDA;
+static constexpr uint8_t COMMIT = 0xC0;
+static constexpr uint32_t ALIGN = 8;	///< A header never crosses a page
+static constexpr uint32_t DATA_MAX = 256 - sizeof(struct Record);
+}  // namespace record
+}  // namespace journal
+}  // namespace spiflashstore
+
+static_assert(sizeof(struct journal::SectorHeader) % journal::record::ALIGN == 0, "");
+static_assert(sizeof(struct journal::Record) == journal::record::ALIGN, "");
+
+static uint16_t crc16(const uint8_t *pData, uint32_t nLength, uint16_t nCrc = 0xFFFF) {
+	while (nLength-- != 0) {
+		nCrc = static_cast<uint16_t>(nCrc ^ (*pData++ << 8));
+		for (uint32_t i = 0; i < 8; i++) {
+			nCrc = static_cast<uint16_t>((nCrc & 0x8000) ? ((nCrc << 1) ^ 0x1021) : (nCrc << 1));
+		}
+	}
+	return nCrc;
+}
+
+static uint16_t crc16(const struct journal::Record& record, const uint8_t *pData) {
+	const auto nCrc = crc16(reinterpret_cast<const uint8_t *>(&record), sizeof(record) - sizeof(record.nCrc));
+	return crc16(pData, record.nLength, nCrc);
+}
+
+static uint32_t record_size(uint32_t nLength) {
+	return sizeof(struct journal::Record) + ((nLength + journal::record::ALIGN - 1) & ~(journal::record::ALIGN - 1));
+}
+
 SpiFlashStore *SpiFlashStore::s_pThis = nullptr;
 
 SpiFlashStore::SpiFlashStore() {
@@ -54,6 +121,28 @@ SpiFlashStore::SpiFlashStore() {
 	assert(s_pThis == nullptr);
 	s_pThis = this;
 
+	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
+		m_aVersion[j] = 0;
+		m_aDirty[j].nFrom = 0;
+		m_aDirty[j].nTo = 0;
+	}
+
+	for (uint32_t i = 0; i < journal::SECTORS; i++) {
+		m_aSector[i].nSequence = 0;
+		m_aSector[i].bSnapshot = false;
+		m_aSector[i].bErased = false;
+	}
+
+	m_nSpiFlashStoreSize = OFFSET_STORES;
+
+	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
+		m_nSpiFlashStoreSize += s_aStorSize[j];
+	}
+
+	DEBUG_PRINTF("OFFSET_STORES=%d, m_nSpiFlashStoreSize=%d", static_cast<int>(OFFSET_STORES), m_nSpiFlashStoreSize);
+
+	assert(m_nSpiFlashStoreSize <= FlashStore::SIZE);
+
 	if (spi_flash_probe(0, 0, 0) < 0) {
 		DEBUG_PUTS("No SPI flash chip");
 	} else {
@@ -62,16 +151,6 @@ SpiFlashStore::SpiFlashStore() {
 	}
 
 	if (m_bHaveFlashChip) {
-		m_nSpiFlashStoreSize = OFFSET_STORES;
-
-		for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
-			m_nSpiFlashStoreSize += s_aStorSize[j];
-		}
-
-		DEBUG_PRINTF("OFFSET_STORES=%d, m_nSpiFlashStoreSize=%d", static_cast<int>(OFFSET_STORES), m_nSpiFlashStoreSize);
-
-		assert(m_nSpiFlashStoreSize <= FlashStore::SIZE);
-
 		Dump();
 	}
 
@@ -87,71 +166,386 @@ SpiFlashStore::~SpiFlashStore() {
 	DEBUG_EXIT
 }
 
+void SpiFlashStore::ResetImage() {
+	memcpy(m_aSpiFlashData, s_aSignature, sizeof(s_aSignature));
+
+	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
+		const auto nOffset = GetStoreOffset(static_cast<Store>(j));
+		// Clear nSetList
+		memset(&m_aSpiFlashData[nOffset], 0x00, sizeof(uint32_t));
+		// Clear rest of data
+		memset(&m_aSpiFlashData[nOffset + sizeof(uint32_t)], 0xFF, s_aStorSize[j] - sizeof(uint32_t));
+	}
+}
+
+bool SpiFlashStore::IsErased(uint32_t nAddress, uint32_t nLength) {
+	uint8_t aBuffer[64];
+
+	while (nLength != 0) {
+		const auto nRead = nLength < sizeof(aBuffer) ? nLength : sizeof(aBuffer);
+		spi_flash_cmd_read_fast(nAddress, nRead, aBuffer);
+
+		for (uint32_t i = 0; i < nRead; i++) {
+			if (aBuffer[i] != 0xFF) {
+				return false;
+			}
+		}
+
+		nAddress += nRead;
+		nLength -= nRead;
+	}
+
+	return true;
+}
+
 bool SpiFlashStore::Init() {
 	const auto nEraseSize = spi_flash_get_sector_size();
-	assert(FlashStore::SIZE == nEraseSize);
+	assert(journal::SECTOR_SIZE == nEraseSize);
 
-	if (FlashStore::SIZE != nEraseSize) {
+	if (journal::SECTOR_SIZE != nEraseSize) {
 		return false;
 	}
 
-	m_nStartAddress = spi_flash_get_size() - nEraseSize;
-	assert(!(m_nStartAddress % nEraseSize));
+	m_nStartAddress = spi_flash_get_size() - journal::SIZE;
 
-	if (m_nStartAddress % nEraseSize) {
-		return false;
+	/*
+	 * The previous firmware only kept the last sector, a uImage could be larger than
+	 * the space before the journal. Erasing a journal sector would then corrupt it.
+	 */
+
+	const auto nUImageEnd = GetUImageEnd();
+
+	if (__builtin_expect((nUImageEnd > m_nStartAddress), 0)) {
+		printf("uImage ends at 0x%x, journal starts at 0x%x: stores are read-only\n", nUImageEnd, m_nStartAddress);
+		m_bReadOnly = true;
+		LoadSingleSectorImage();
+		return true;
 	}
 
-	spi_flash_cmd_read_fast(m_nStartAddress, FlashStore::SIZE, &m_aSpiFlashData);
+	uint32_t nMaxSequence = 0;
 
-	bool bSignatureOK = true;
+	for (uint32_t i = 0; i < journal::SECTORS; i++) {
+		const auto nAddress = m_nStartAddress + i * journal::SECTOR_SIZE;
+		journal::SectorHeader header;
 
-	for (uint32_t i = 0; i < sizeof(s_aSignature); i++) {
-		if (s_aSignature[i] != m_aSpiFlashData[i]) {
-			m_aSpiFlashData[i] = s_aSignature[i];
-			bSignatureOK = false;
+		spi_flash_cmd_read_fast(nAddress, sizeof(header), &header);
+
+		if ((memcmp(header.aMagic, journal::MAGIC, sizeof(journal::MAGIC)) == 0) && (header.nSequence != 0) && (header.nSequence != UINT32_MAX)) {
+			m_aSector[i].nSequence = header.nSequence;
+			m_aSector[i].bSnapshot = (header.nFlags & journal::sector::SNAPSHOT) == journal::sector::SNAPSHOT;
+
+			if (header.nSequence > nMaxSequence) {
+				nMaxSequence = header.nSequence;
+				m_nWriteSector = i;
+			}
+		} else {
+			m_aSector[i].bErased = IsErased(nAddress, journal::SECTOR_SIZE);
 		}
+
+		DEBUG_PRINTF("Sector %u: nSequence=%u, bSnapshot=%d, bErased=%d", i, m_aSector[i].nSequence, m_aSector[i].bSnapshot, m_aSector[i].bErased);
 	}
 
-	if (__builtin_expect(!bSignatureOK, 0)) {
+	m_nSequence = nMaxSequence;
+
+	// Newest committed snapshot first, an interrupted compaction falls back to the previous one
+	auto nBelow = nMaxSequence + 1;
+
+	for (;;) {
+		uint32_t nSnapshot = 0;
+
+		for (uint32_t i = 0; i < journal::SECTORS; i++) {
+			if (m_aSector[i].bSnapshot && (m_aSector[i].nSequence < nBelow) && (m_aSector[i].nSequence > nSnapshot)) {
+				nSnapshot = m_aSector[i].nSequence;
+			}
+		}
+
+		if (nSnapshot == 0) {
+			break;
+		}
+
+		ResetImage();
+
+		if (Replay(nSnapshot)) {
+			m_nLiveSequence = nSnapshot;
+			DEBUG_PRINTF("m_nLiveSequence=%u, m_nSequence=%u, m_nWriteOffset=%u", m_nLiveSequence, m_nSequence, m_nWriteOffset);
+
+			if ((m_nSequence - m_nLiveSequence) >= journal::COMPACT_SECTORS) {
+				StartCompaction();
+			}
+
+			return true;
+		}
+
+		// Interrupted compaction, its records are not committed
+		for (uint32_t i = 0; i < journal::SECTORS; i++) {
+			if (m_aSector[i].nSequence >= nSnapshot) {
+				spi_flash_cmd_erase(m_nStartAddress + i * journal::SECTOR_SIZE, journal::SECTOR_SIZE);
+				m_aSector[i].nSequence = 0;
+				m_aSector[i].bSnapshot = false;
+				m_aSector[i].bErased = true;
+			}
+		}
+
+		nMaxSequence = nSnapshot - 1;
+		nBelow = nSnapshot;
+	}
+
+	m_nLiveSequence = nMaxSequence + 1;
+	m_nSequence = nMaxSequence;
+	m_nWriteOffset = journal::SECTOR_SIZE;
+
+	/*
+	 * No journal yet. The previous firmware kept a single image in the last sector.
+	 */
+
+	LoadSingleSectorImage();
+	StartCompaction();
+
+	return true;
+}
+
+/**
+ * Returns the first address after the uImage, or 0 when there is no valid uImage header.
+ */
+uint32_t SpiFlashStore::GetUImageEnd() {
+	struct {
+		uint32_t ih_magic;
+		uint32_t ih_hcrc;
+		uint32_t ih_time;
+		uint32_t ih_size;
+	} header;
+
+	spi_flash_cmd_read_fast(uimage::OFFSET, sizeof(header), &header);
+
+	if (header.ih_magic != __builtin_bswap32(0x27051956)) {
+		return 0;
+	}
+
+	return uimage::OFFSET + uimage::HEADER_SIZE + __builtin_bswap32(header.ih_size);
+}
+
+void SpiFlashStore::LoadSingleSectorImage() {
+	const auto nLegacyAddress = spi_flash_get_size() - journal::SECTOR_SIZE;
+
+	spi_flash_cmd_read_fast(nLegacyAddress, FlashStore::SIZE, &m_aSpiFlashData);
+
+	if (__builtin_expect((memcmp(m_aSpiFlashData, s_aSignature, sizeof(s_aSignature)) != 0), 0)) {
 		DEBUG_PUTS("No signature");
 
 		m_bIsNew = true;
+		ResetImage();
+	} else {
+		DEBUG_PUTS("Single sector image");
 
-		// Clear nSetList
 		for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
-			const auto nOffset = GetStoreOffset(static_cast<Store>(j));
-			auto k = nOffset;
-			m_aSpiFlashData[k++] = 0x00;
-			m_aSpiFlashData[k++] = 0x00;
-			m_aSpiFlashData[k++] = 0x00;
-			m_aSpiFlashData[k++] = 0x00;
-
-			// Clear rest of data
-			for (; k < nOffset + s_aStorSize[j]; k++) {
-				m_aSpiFlashData[k] = 0xFF;
+			auto *pbSetList = &m_aSpiFlashData[GetStoreOffset(static_cast<Store>(j))];
+			if ((pbSetList[0] == 0xFF) && (pbSetList[1] == 0xFF) && (pbSetList[2] == 0xFF) && (pbSetList[3] == 0xFF)) {
+				DEBUG_PRINTF("[%s]: nSetList \'FF...FF\'", s_aStoreName[j]);
+				// Clear bSetList
+				memset(pbSetList, 0x00, sizeof(uint32_t));
 			}
 		}
+	}
+}
 
-		m_tState = State::CHANGED;
+/**
+ * Applies the records of the sectors starting with nSequence.
+ * Returns true when a commit record has been found.
+ */
+bool SpiFlashStore::Replay(uint32_t nSequence) {
+	uint8_t aData[journal::record::DATA_MAX];
+	auto bCommitted = false;
 
-		return true;
+	for (;; nSequence++) {
+		uint32_t nSector;
+
+		for (nSector = 0; nSector < journal::SECTORS; nSector++) {
+			if (m_aSector[nSector].nSequence == nSequence) {
+				break;
+			}
+		}
+
+		if (nSector == journal::SECTORS) {
+			return bCommitted;
+		}
+
+		const auto nAddress = m_nStartAddress + nSector * journal::SECTOR_SIZE;
+		uint32_t nOffset = sizeof(struct journal::SectorHeader);
+
+		while (nOffset + sizeof(struct journal::Record) <= journal::SECTOR_SIZE) {
+			journal::Record record;
+
+			spi_flash_cmd_read_fast(nAddress + nOffset, sizeof(record), &record);
+
+			if (record.nType == journal::record::FREE) {
+				// Data of a record without header cannot be overwritten
+				if (!IsErased(nAddress + nOffset, journal::SECTOR_SIZE - nOffset)) {
+					nOffset = journal::SECTOR_SIZE;
+				}
+				break;
+			}
+
+			const auto nSize = record_size(record.nLength);
+
+			if ((record.nLength > journal::record::DATA_MAX) || (nOffset + nSize > journal::SECTOR_SIZE)) {
+				nOffset = journal::SECTOR_SIZE;
+				break;
+			}
+
+			if (record.nLength != 0) {
+				spi_flash_cmd_read_fast(nAddress + nOffset + sizeof(record), record.nLength, aData);
+			}
+
+			if (crc16(record, aData) != record.nCrc) {
+				DEBUG_PRINTF("CRC error at sector %u offset %u", nSector, nOffset);
+				nOffset = journal::SECTOR_SIZE;
+				break;
+			}
+
+			if (record.nType == journal::record::COMMIT) {
+				bCommitted = true;
+			} else if ((record.nType == journal::record::DATA)
+					&& (record.nStore < static_cast<uint32_t>(Store::LAST))
+					&& ((record.nOffset + record.nLength) <= s_aStorSize[record.nStore])) {
+				memcpy(&m_aSpiFlashData[GetStoreOffset(static_cast<Store>(record.nStore)) + record.nOffset], aData, record.nLength);
+			}
+
+			nOffset += nSize;
+		}
+
+		m_nSequence = nSequence;
+		m_nWriteSector = nSector;
+		m_nWriteOffset = nOffset;
 	}
+}
 
-	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
-		auto *pbSetList = &m_aSpiFlashData[GetStoreOffset(static_cast<Store>(j))];
-		if ((pbSetList[0] == 0xFF) && (pbSetList[1] == 0xFF) && (pbSetList[2] == 0xFF) && (pbSetList[3] == 0xFF)) {
-			DEBUG_PRINTF("[%s]: nSetList \'FF...FF\'", s_aStoreName[j]);
-			// Clear bSetList
-			*pbSetList++ = 0x00;
-			*pbSetList++ = 0x00;
-			*pbSetList++ = 0x00;
-			*pbSetList = 0x00;
+bool SpiFlashStore::OpenSector(bool bSnapshot) {
+	const auto nSector = (m_nWriteSector + 1) % journal::SECTORS;
+	auto& sector = m_aSector[nSector];
+	const auto nAddress = m_nStartAddress + nSector * journal::SECTOR_SIZE;
 
-			m_tState = State::CHANGED;
+	if (__builtin_expect((sector.nSequence >= m_nLiveSequence), 0)) {
+		printf("SpiFlashStore: journal full\n");
+		m_nCompactSequence = 0;
+		m_tState = State::IDLE;
+		return false;
+	}
+
+	if (!sector.bErased) {
+		spi_flash_cmd_erase(nAddress, journal::SECTOR_SIZE);
+		sector.nSequence = 0;
+		sector.bErased = true;
+		return false;
+	}
+
+	journal::SectorHeader header;
+
+	memcpy(header.aMagic, journal::MAGIC, sizeof(journal::MAGIC));
+	header.nSequence = ++m_nSequence;
+	header.nFlags = bSnapshot ? journal::sector::SNAPSHOT : 0;
+	memset(header.aReserved, 0xFF, sizeof(header.aReserved));
+
+	spi_flash_cmd_write_multi(nAddress, sizeof(header), &header);
+
+	sector.nSequence = m_nSequence;
+	sector.bSnapshot = bSnapshot;
+	sector.bErased = false;
+
+	m_nWriteSector = nSector;
+	m_nWriteOffset = sizeof(header);
+
+	DEBUG_PRINTF("Sector %u: nSequence=%u, bSnapshot=%d", nSector, m_nSequence, bSnapshot);
+
+	if ((m_tState != State::COMPACTING) && ((m_nSequence - m_nLiveSequence) >= journal::COMPACT_SECTORS)) {
+		StartCompaction();
+	}
+
+	return true;
+}
+
+/**
+ * Returns false when the step has been used for erasing the next sector.
+ */
+bool SpiFlashStore::WriteRecord(uint8_t nType, uint32_t nStore, uint32_t nOffset, uint32_t nLength) {
+	assert(nLength <= journal::record::DATA_MAX);
+
+	const auto nSize = record_size(nLength);
+
+	if (m_nWriteOffset + nSize > journal::SECTOR_SIZE) {
+		if (!OpenSector(false)) {
+			return false;
 		}
 	}
 
+	const auto nAddress = m_nStartAddress + m_nWriteSector * journal::SECTOR_SIZE + m_nWriteOffset;
+	const uint8_t *pData = nullptr;
+
+	journal::Record record;
+
+	record.nType = nType;
+	record.nStore = static_cast<uint8_t>(nStore);
+	record.nOffset = static_cast<uint16_t>(nOffset);
+	record.nLength = static_cast<uint16_t>(nLength);
+
+	if (nLength != 0) {
+		pData = &m_aSpiFlashData[GetStoreOffset(static_cast<Store>(nStore)) + nOffset];
+		spi_flash_cmd_write_multi(nAddress + sizeof(record), nLength, pData);
+	}
+
+	record.nCrc = crc16(record, pData);
+
+	spi_flash_cmd_write_multi(nAddress, sizeof(record), &record);
+
+	m_nWriteOffset += nSize;
+
+	return true;
+}
+
+void SpiFlashStore::StartCompaction() {
+	DEBUG_PRINTF("m_nLiveSequence=%u, m_nSequence=%u", m_nLiveSequence, m_nSequence);
+
+	m_nCompactSequence = 0;
+	m_nCompactStore = 0;
+	m_nCompactOffset = 0;
+	m_tState = State::COMPACTING;
+}
+
+/**
+ * Writes the next part of the snapshot, returns true when the snapshot has been committed.
+ */
+bool SpiFlashStore::Compact() {
+	if (m_nCompactSequence == 0) {
+		if (OpenSector(true)) {
+			m_nCompactSequence = m_nSequence;
+		}
+		return false;
+	}
+
+	if (m_nCompactStore < static_cast<uint32_t>(Store::LAST)) {
+		const auto nRemaining = s_aStorSize[m_nCompactStore] - m_nCompactOffset;
+		const auto nLength = nRemaining < journal::record::DATA_MAX ? nRemaining : journal::record::DATA_MAX;
+
+		if (WriteRecord(journal::record::DATA, m_nCompactStore, m_nCompactOffset, nLength)) {
+			m_nCompactOffset += nLength;
+
+			if (m_nCompactOffset == s_aStorSize[m_nCompactStore]) {
+				m_nCompactOffset = 0;
+				m_nCompactStore++;
+			}
+		}
+
+		return false;
+	}
+
+	if (!WriteRecord(journal::record::COMMIT, 0, 0, 0)) {
+		return false;
+	}
+
+	m_nLiveSequence = m_nCompactSequence;
+	m_nCompactSequence = 0;
+
+	DEBUG_PRINTF("m_nLiveSequence=%u", m_nLiveSequence);
+
 	return true;
 }
 
@@ -164,11 +558,29 @@ uint32_t SpiFlashStore::GetStoreOffset(Store tStore) {
 		nOffset += s_aStorSize[i];
 	}
 
-	DEBUG_PRINTF("nOffset=%d", nOffset);
-
 	return nOffset;
 }
 
+void SpiFlashStore::MarkDirty(Store tStore, uint32_t nFrom, uint32_t nTo) {
+	auto& dirty = m_aDirty[static_cast<uint32_t>(tStore)];
+
+	if (dirty.nTo == 0) {
+		dirty.nFrom = static_cast<uint16_t>(nFrom);
+		dirty.nTo = static_cast<uint16_t>(nTo);
+	} else {
+		if (nFrom < dirty.nFrom) {
+			dirty.nFrom = static_cast<uint16_t>(nFrom);
+		}
+		if (nTo > dirty.nTo) {
+			dirty.nTo = static_cast<uint16_t>(nTo);
+		}
+	}
+
+	if (m_tState != State::COMPACTING) {
+		m_tState = State::CHANGED;
+	}
+}
+
 void SpiFlashStore::ResetSetList(Store tStore) {
 	assert(tStore < Store::LAST);
 
@@ -180,7 +592,8 @@ void SpiFlashStore::ResetSetList(Store tStore) {
 	*pbSetList++ = 0x00;
 	*pbSetList = 0x00;
 
-	m_tState = State::CHANGED;
+	m_aVersion[static_cast<uint32_t>(tStore)]++;
+	MarkDirty(tStore, 0, sizeof(uint32_t));
 }
 
 void SpiFlashStore::Update(Store tStore, uint32_t nOffset, const void *pData, uint32_t nDataLength, uint32_t nSetList, uint32_t nOffsetSetList) {
@@ -199,6 +612,8 @@ void SpiFlashStore::Update(Store tStore, uint32_t nOffset, const void *pData, ui
 	debug_dump(const_cast<void*>(pData), nDataLength);
 
 	auto bIsChanged = false;
+	uint32_t nFirst = 0;
+	uint32_t nLast = 0;
 
 	const auto nBase = nOffset + GetStoreOffset(tStore);
 
@@ -207,21 +622,27 @@ void SpiFlashStore::Update(Store tStore, uint32_t nOffset, const void *pData, ui
 
 	for (uint32_t i = 0; i < nDataLength; i++) {
 		if (*pSrc != *pDst) {
-			bIsChanged = true;
+			if (!bIsChanged) {
+				bIsChanged = true;
+				nFirst = i;
+			}
+			nLast = i;
 			*pDst = *pSrc;
 		}
 		pDst++;
 		pSrc++;
 	}
 
-	if (bIsChanged && (m_tState != State::ERASED)) {
-		m_tState = State::CHANGED;
+	if (bIsChanged) {
+		m_aVersion[static_cast<uint32_t>(tStore)]++;
+		MarkDirty(tStore, nOffset + nFirst, nOffset + nLast + 1);
 	}
 
 	if ((0 != nOffset) && (bIsChanged) && (nSetList != 0)) {
 		auto *pSet = reinterpret_cast<uint32_t*>((&m_aSpiFlashData[GetStoreOffset(tStore)] + nOffsetSetList));
 
 		*pSet |= nSetList;
+		MarkDirty(tStore, nOffsetSetList, nOffsetSetList + sizeof(uint32_t));
 	}
 
 	DEBUG_PRINTF("m_tState=%u", static_cast<uint32_t>(m_tState));
@@ -281,6 +702,14 @@ void SpiFlashStore::CopyTo(Store tStore, void* pData, uint32_t& nDataLength) {
 	DEBUG1_EXIT
 }
 
+uint32_t SpiFlashStore::GetStoreSize(Store tStore) const {
+	if (__builtin_expect((tStore >= Store::LAST), 0)) {
+		return 0;
+	}
+
+	return s_aStorSize[static_cast<uint32_t>(tStore)];
+}
+
 bool SpiFlashStore::Flash() {
 	if (__builtin_expect((m_tState == State::IDLE), 1)) {
 		return false;
@@ -288,6 +717,11 @@ bool SpiFlashStore::Flash() {
 
 	DEBUG_PRINTF("m_tState=%d", static_cast<uint32_t>(m_tState));
 
+	if (__builtin_expect((m_bReadOnly), 0)) {
+		m_tState = State::IDLE;
+		return false;
+	}
+
 	assert(m_nStartAddress != 0);
 
 	if (m_nStartAddress == 0) {
@@ -295,20 +729,37 @@ bool SpiFlashStore::Flash() {
 		return false;
 	}
 
-	switch (m_tState) {
-		case State::CHANGED:
-			spi_flash_cmd_erase(m_nStartAddress, FlashStore::SIZE);
-			m_tState = State::ERASED;
-			return true;
-			break;
-		case State::ERASED:
-			spi_flash_cmd_write_multi(m_nStartAddress, m_nSpiFlashStoreSize, &m_aSpiFlashData);
-			m_tState = State::IDLE;
-			break;
-		default:
-			break;
+	if (m_tState == State::COMPACTING) {
+		if (Compact()) {
+			m_tState = State::CHANGED;
+		}
+		return true;
 	}
 
+	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
+		auto& dirty = m_aDirty[j];
+
+		if (dirty.nTo == 0) {
+			continue;
+		}
+
+		const auto nRemaining = static_cast<uint32_t>(dirty.nTo - dirty.nFrom);
+		const auto nLength = nRemaining < journal::record::DATA_MAX ? nRemaining : journal::record::DATA_MAX;
+
+		if (WriteRecord(journal::record::DATA, j, dirty.nFrom, nLength)) {
+			if (nLength == nRemaining) {
+				dirty.nFrom = 0;
+				dirty.nTo = 0;
+			} else {
+				dirty.nFrom = static_cast<uint16_t>(dirty.nFrom + nLength);
+			}
+		}
+
+		return true;
+	}
+
+	m_tState = State::IDLE;
+
 	Dump();
 
 	return false;
@@ -343,5 +794,6 @@ void SpiFlashStore::Dump() {
 	}
 
 	printf("m_tState=%d\n", static_cast<uint32_t>(m_tState));
+	printf("Journal: sequence %u, live %u, sector %u, offset %u%s\n", m_nSequence, m_nLiveSequence, m_nWriteSector, m_nWriteOffset, m_bReadOnly ? ", read-only" : "");
 #endif
 }
@@ -39,6 +39,8 @@ enum TTLC59711Type {
 	TTLC59711_TYPE_UNDEFINED
 };
 
+class PixelLut;
+
 class TLC59711Dmx final: public LightSet {
 public:
 	TLC59711Dmx();
@@ -48,6 +50,8 @@ public:
 	void Stop(uint8_t nPort = 0) override;
 
 	void SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Stage(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength) override;
+	void Commit() override;
 
 	void Blackout(bool bBlackout) override;
 
@@ -63,6 +67,32 @@ public:
 		return m_nLEDCount;
 	}
 
+	/**
+	 * 16-bit per output (coarse, fine), the DMX footprint is doubled
+	 */
+	void Set16Bit(bool b16Bit);
+	bool Is16Bit() const {
+		return m_b16Bit;
+	}
+
+	/**
+	 * Colour curve, the same gamma, white point and max current as the pixel outputs.
+	 * The table is built when the output is started.
+	 */
+	void SetGamma(uint8_t nGamma) {
+		m_nGamma = nGamma;
+	}
+
+	void SetWhitePoint(uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
+		m_aWhitePoint[0] = nRed;
+		m_aWhitePoint[1] = nGreen;
+		m_aWhitePoint[2] = nBlue;
+	}
+
+	void SetMaxCurrent(uint8_t nMaxCurrent) {
+		m_nMaxCurrent = nMaxCurrent;
+	}
+
 	void SetSpiSpeedHz(uint32_t nSpiSpeedHz);
 	uint32_t GetSpiSpeedHz() const {
 		return m_nSpiSpeedHz;
@@ -97,13 +127,20 @@ private:
 private:
 	uint16_t m_nDmxStartAddress { 1 };
 	uint16_t m_nDmxFootprint;
+	uint16_t m_nOutputs;
 	uint8_t m_nBoardInstances { 1 };
 	bool m_bIsStarted { false };
 	bool m_bBlackout { false };
+	bool m_bStaged { false };
 	TLC59711 *m_pTLC59711 { nullptr };
 	uint32_t m_nSpiSpeedHz { 0 };
 	TTLC59711Type m_LEDType { TTLC59711_TYPE_RGB };
 	uint8_t m_nLEDCount;
+	bool m_b16Bit { false };
+	uint8_t m_nGamma;
+	uint8_t m_aWhitePoint[3];
+	uint8_t m_nMaxCurrent;
+	PixelLut *m_pLut { nullptr };
 
 	TLC59711DmxStore *m_pTLC59711DmxStore { nullptr };
 };
@@ -36,14 +36,23 @@ struct TTLC59711DmxParams {
 	uint8_t nLedCount;
 	uint16_t nDmxStartAddress;
     uint32_t nSpiSpeedHz;
+	uint8_t nGamma;
+	uint8_t nWhitePoint[3];
+	uint8_t nMaxCurrent;
 };
 //} __attribute__((packed));
 
+static_assert(sizeof(struct TTLC59711DmxParams) <= 32, "struct TTLC59711DmxParams is too large");
+
 struct TLC59711DmxParamsMask {
 	static constexpr auto TYPE = (1U << 0);
 	static constexpr auto COUNT = (1U << 1);
 	static constexpr auto START_ADDRESS = (1U << 2);
 	static constexpr auto SPI_SPEED = (1U << 3);
+	static constexpr auto PIXEL_16BIT = (1U << 4);
+	static constexpr auto GAMMA = (1U << 5);
+	static constexpr auto WHITE_POINT = (1U << 6);
+	static constexpr auto MAX_CURRENT = (1U << 7);
 };
 
 class TLC59711DmxParamsStore {
@@ -28,10 +28,12 @@
 
 #include "tlc59711dmx.h"
 #include "tlc59711.h"
+#include "pixellut.h"
 
 #include "lightset.h"
 
 using namespace lightset;
+using pixellut::Colour;
 
 static unsigned long ceil(float f) {
 	int i = static_cast<int>(f);
@@ -43,11 +45,20 @@ static unsigned long ceil(float f) {
 	return static_cast<unsigned long>(i + 1);
 }
 
-TLC59711Dmx::TLC59711Dmx() : m_nDmxFootprint(TLC59711Channels::OUT), m_nLEDCount(TLC59711Channels::RGB) {
+TLC59711Dmx::TLC59711Dmx() : m_nDmxFootprint(TLC59711Channels::OUT), m_nOutputs(TLC59711Channels::OUT), m_nLEDCount(TLC59711Channels::RGB) {
+	m_nGamma = pixellut::defaults::GAMMA;
+	for (uint32_t i = 0; i < 3; i++) {
+		m_aWhitePoint[i] = pixellut::defaults::WHITE_POINT;
+	}
+	m_nMaxCurrent = pixellut::defaults::MAX_CURRENT;
+
 	UpdateMembers();
 }
 
 TLC59711Dmx::~TLC59711Dmx() {
+	delete m_pLut;
+	m_pLut = nullptr;
+
 	delete m_pTLC59711;
 	m_pTLC59711 = nullptr;
 }
@@ -72,7 +83,12 @@ void TLC59711Dmx::Stop(__attribute__((unused)) uint8_t nPort) {
 	m_bIsStarted = false;
 }
 
-void TLC59711Dmx::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t* pDmxData, uint16_t nLength) {
+void TLC59711Dmx::SetData(uint8_t nPort, const uint8_t* pDmxData, uint16_t nLength) {
+	Stage(nPort, pDmxData, nLength);
+	Commit();
+}
+
+void TLC59711Dmx::Stage(__attribute__((unused)) uint8_t nPort, const uint8_t* pDmxData, uint16_t nLength) {
 	assert(pDmxData != nullptr);
 	assert(nLength <= Dmx::UNIVERSE_SIZE);
 
@@ -83,24 +99,64 @@ void TLC59711Dmx::SetData(__attribute__((unused)) uint8_t nPort, const uint8_t*
 	uint8_t *p = const_cast<uint8_t*>(pDmxData) + m_nDmxStartAddress - 1;
 
 	unsigned nDmxAddress = m_nDmxStartAddress;
+	// The outputs are R, G, B(, W) per LED
+	const uint32_t nColours = (m_LEDType == TTLC59711_TYPE_RGB) ? 3 : 4;
+	uint32_t nColour = 0;
 
-	for (unsigned i = 0; i < m_nDmxFootprint; i++) {
-		if (nDmxAddress > nLength) {
-			break;
+	if (m_b16Bit) {
+		for (unsigned i = 0; i < m_nOutputs; i++) {
+			if ((nDmxAddress + 1) > nLength) {
+				break;
+			}
+
+			auto nValue = static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | static_cast<uint16_t>(p[1]));
+
+			if (m_pLut != nullptr) {
+				nValue = m_pLut->Interpolate16(static_cast<Colour>(nColour), nValue);
+				nColour = (nColour + 1 == nColours) ? 0 : nColour + 1;
+			}
+
+			m_pTLC59711->Set(i, nValue);
+
+			p += 2;
+			nDmxAddress += 2;
 		}
+	} else {
+		for (unsigned i = 0; i < m_nOutputs; i++) {
+			if (nDmxAddress > nLength) {
+				break;
+			}
+
+			uint16_t nValue;
 
-		const uint16_t nValue = (static_cast<uint16_t>(*p) << 8) | static_cast<uint16_t>(*p);
+			if (m_pLut != nullptr) {
+				nValue = m_pLut->Get16(static_cast<Colour>(nColour), *p);
+				nColour = (nColour + 1 == nColours) ? 0 : nColour + 1;
+			} else {
+				nValue = static_cast<uint16_t>((static_cast<uint16_t>(*p) << 8) | static_cast<uint16_t>(*p));
+			}
 
-		m_pTLC59711->Set(i, nValue);
+			m_pTLC59711->Set(i, nValue);
 
-		p++;
-		nDmxAddress++;
+			p++;
+			nDmxAddress++;
+		}
 	}
 
 	if (__builtin_expect((nDmxAddress == m_nDmxStartAddress), 0)) {
 		return;
 	}
 
+	m_bStaged = true;
+}
+
+void TLC59711Dmx::Commit() {
+	if (!m_bStaged) {
+		return;
+	}
+
+	m_bStaged = false;
+
 	if (!m_bBlackout) {
 		m_pTLC59711->Update();
 	}
@@ -116,6 +172,11 @@ void TLC59711Dmx::SetLEDCount(uint8_t nLEDCount) {
 	UpdateMembers();
 }
 
+void TLC59711Dmx::Set16Bit(bool b16Bit) {
+	m_b16Bit = b16Bit;
+	UpdateMembers();
+}
+
 void TLC59711Dmx::SetSpiSpeedHz(uint32_t nSpiSpeedHz) {
 	m_nSpiSpeedHz = nSpiSpeedHz;
 }
@@ -125,16 +186,25 @@ void TLC59711Dmx::Initialize() {
 	m_pTLC59711 = new TLC59711(m_nBoardInstances, m_nSpiSpeedHz);
 	assert(m_pTLC59711 != nullptr);
 	m_pTLC59711->Dump();
+
+	if (!PixelLut::IsIdentity(m_nGamma, m_aWhitePoint, m_nMaxCurrent)) {
+		assert(m_pLut == nullptr);
+		m_pLut = new PixelLut;
+		assert(m_pLut != nullptr);
+		m_pLut->Build(m_nGamma, m_aWhitePoint, m_nMaxCurrent);
+	}
 }
 
 void TLC59711Dmx::UpdateMembers() {
 	if (m_LEDType == TTLC59711_TYPE_RGB) {
-		m_nDmxFootprint = m_nLEDCount * 3;
+		m_nOutputs = m_nLEDCount * 3;
 	} else {
-		m_nDmxFootprint = m_nLEDCount * 4;
+		m_nOutputs = m_nLEDCount * 4;
 	}
 
-	m_nBoardInstances = ceil(static_cast<float>(m_nDmxFootprint) / TLC59711Channels::OUT);
+	m_nDmxFootprint = m_b16Bit ? static_cast<uint16_t>(m_nOutputs * 2) : m_nOutputs;
+
+	m_nBoardInstances = ceil(static_cast<float>(m_nOutputs) / TLC59711Channels::OUT);
 }
 
 void TLC59711Dmx::Blackout(bool bBlackout) {
@@ -182,6 +252,16 @@ bool TLC59711Dmx::GetSlotInfo(uint16_t nSlotOffset, SlotInfo& tSlotInfo) {
 		return false;
 	}
 
+	if (m_b16Bit) {
+		if ((nSlotOffset & 0x1) != 0) {
+			tSlotInfo.nType = 0x01;	// ST_SEC_FINE
+			tSlotInfo.nCategory = static_cast<uint16_t>(nSlotOffset - 1);
+			return true;
+		}
+
+		nSlotOffset = static_cast<uint16_t>(nSlotOffset / 2);
+	}
+
 	if (m_LEDType == TTLC59711_TYPE_RGB) {
 		nIndex = MOD(nSlotOffset, 3);
 	} else {
@@ -37,6 +37,7 @@
 
 #include "tlc59711dmxparams.h"
 #include "tlc59711dmx.h"
+#include "pixellut.h"
 
 #include "readconfigfile.h"
 #include "sscan.h"
@@ -55,6 +56,11 @@ TLC59711DmxParams::TLC59711DmxParams(TLC59711DmxParamsStore *pTLC59711ParamsStor
 	m_tTLC59711Params.nLedCount = 4;
 	m_tTLC59711Params.nDmxStartAddress = 1;
 	m_tTLC59711Params.nSpiSpeedHz = 0;
+	m_tTLC59711Params.nGamma = pixellut::defaults::GAMMA;
+	for (uint32_t i = 0; i < 3; i++) {
+		m_tTLC59711Params.nWhitePoint[i] = pixellut::defaults::WHITE_POINT;
+	}
+	m_tTLC59711Params.nMaxCurrent = pixellut::defaults::MAX_CURRENT;
 }
 
 bool TLC59711DmxParams::Load() {
@@ -100,6 +106,7 @@ void TLC59711DmxParams::callbackFunction(const char* pLine) {
 	uint8_t value8;
 	uint16_t value16;
 	uint32_t value32;
+	float fValue;
 	char buffer[12];
 
 	uint32_t nLength = 9;
@@ -134,6 +141,56 @@ void TLC59711DmxParams::callbackFunction(const char* pLine) {
 	if (Sscan::Uint32(pLine, DevicesParamsConst::SPI_SPEED_HZ, value32) == Sscan::OK) {
 		m_tTLC59711Params.nSpiSpeedHz = value32;
 		m_tTLC59711Params.nSetList |= TLC59711DmxParamsMask::SPI_SPEED;
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, DevicesParamsConst::PIXEL_16BIT, value8) == Sscan::OK) {
+		if (value8 != 0) {
+			m_tTLC59711Params.nSetList |= TLC59711DmxParamsMask::PIXEL_16BIT;
+		} else {
+			m_tTLC59711Params.nSetList &= ~TLC59711DmxParamsMask::PIXEL_16BIT;
+		}
+		return;
+	}
+
+	if (Sscan::Float(pLine, DevicesParamsConst::GAMMA, fValue) == Sscan::OK) {
+		if ((fValue >= 1.0f) && (fValue <= 3.0f)) {
+			m_tTLC59711Params.nGamma = static_cast<uint8_t>(fValue * 10 + 0.5f);
+		} else {
+			m_tTLC59711Params.nGamma = pixellut::defaults::GAMMA;
+		}
+
+		if (m_tTLC59711Params.nGamma != pixellut::defaults::GAMMA) {
+			m_tTLC59711Params.nSetList |= TLC59711DmxParamsMask::GAMMA;
+		} else {
+			m_tTLC59711Params.nSetList &= ~TLC59711DmxParamsMask::GAMMA;
+		}
+		return;
+	}
+
+	const char *pWhitePoint[3] = { DevicesParamsConst::WHITE_POINT_RED, DevicesParamsConst::WHITE_POINT_GREEN, DevicesParamsConst::WHITE_POINT_BLUE };
+
+	for (uint32_t i = 0; i < 3; i++) {
+		if (Sscan::Uint8(pLine, pWhitePoint[i], value8) == Sscan::OK) {
+			m_tTLC59711Params.nWhitePoint[i] = value8;
+
+			if ((m_tTLC59711Params.nWhitePoint[0] & m_tTLC59711Params.nWhitePoint[1] & m_tTLC59711Params.nWhitePoint[2]) != pixellut::defaults::WHITE_POINT) {
+				m_tTLC59711Params.nSetList |= TLC59711DmxParamsMask::WHITE_POINT;
+			} else {
+				m_tTLC59711Params.nSetList &= ~TLC59711DmxParamsMask::WHITE_POINT;
+			}
+			return;
+		}
+	}
+
+	if (Sscan::Uint8(pLine, DevicesParamsConst::MAX_CURRENT, value8) == Sscan::OK) {
+		if ((value8 != 0) && (value8 < pixellut::defaults::MAX_CURRENT)) {
+			m_tTLC59711Params.nMaxCurrent = value8;
+			m_tTLC59711Params.nSetList |= TLC59711DmxParamsMask::MAX_CURRENT;
+		} else {
+			m_tTLC59711Params.nMaxCurrent = pixellut::defaults::MAX_CURRENT;
+			m_tTLC59711Params.nSetList &= ~TLC59711DmxParamsMask::MAX_CURRENT;
+		}
 	}
 }
 
@@ -158,6 +215,24 @@ void TLC59711DmxParams::Dump() {
 	if(isMaskSet(TLC59711DmxParamsMask::SPI_SPEED)) {
 		printf(" %s=%d Hz\n", DevicesParamsConst::SPI_SPEED_HZ, m_tTLC59711Params.nSpiSpeedHz);
 	}
+
+	if(isMaskSet(TLC59711DmxParamsMask::PIXEL_16BIT)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::PIXEL_16BIT);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::GAMMA)) {
+		printf(" %s=%d.%d\n", DevicesParamsConst::GAMMA, m_tTLC59711Params.nGamma / 10, m_tTLC59711Params.nGamma % 10);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::WHITE_POINT)) {
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_RED, m_tTLC59711Params.nWhitePoint[0]);
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_GREEN, m_tTLC59711Params.nWhitePoint[1]);
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_BLUE, m_tTLC59711Params.nWhitePoint[2]);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::MAX_CURRENT)) {
+		printf(" %s=%d\n", DevicesParamsConst::MAX_CURRENT, m_tTLC59711Params.nMaxCurrent);
+	}
 #endif
 }
 
@@ -46,4 +46,20 @@ void TLC59711DmxParams::Set(TLC59711Dmx* pTLC59711Dmx) {
 	if(isMaskSet(TLC59711DmxParamsMask::SPI_SPEED)) {
 		pTLC59711Dmx->SetSpiSpeedHz(m_tTLC59711Params.nSpiSpeedHz);
 	}
+
+	if(isMaskSet(TLC59711DmxParamsMask::PIXEL_16BIT)) {
+		pTLC59711Dmx->Set16Bit(true);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::GAMMA)) {
+		pTLC59711Dmx->SetGamma(m_tTLC59711Params.nGamma);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::WHITE_POINT)) {
+		pTLC59711Dmx->SetWhitePoint(m_tTLC59711Params.nWhitePoint[0], m_tTLC59711Params.nWhitePoint[1], m_tTLC59711Params.nWhitePoint[2]);
+	}
+
+	if (isMaskSet(TLC59711DmxParamsMask::MAX_CURRENT)) {
+		pTLC59711Dmx->SetMaxCurrent(m_tTLC59711Params.nMaxCurrent);
+	}
 }
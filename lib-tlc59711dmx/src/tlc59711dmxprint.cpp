@@ -28,11 +28,13 @@
 #include "tlc59711dmx.h"
 #include "tlc59711dmxparams.h"
 #include "tlc59711.h"
+#include "pixellut.h"
 
 void TLC59711Dmx::Print() {
 	printf("PWM parameters\n");
 	printf(" Type  : %s [%d]\n", TLC59711DmxParams::GetType(m_LEDType), m_LEDType); //TODO Move TLC59711DmxParams to TLC59711
 	printf(" Count : %d %s\n", m_nLEDCount, m_LEDType == TTLC59711_TYPE_RGB ? "RGB" : "RGBW");
+	printf(" Curve : %s\n", PixelLut::IsIdentity(m_nGamma, m_aWhitePoint, m_nMaxCurrent) ? "Linear" : "Yes");
 	printf(" Clock : %d Hz %s {Default: %d Hz, Maximum %d Hz}\n", m_nSpiSpeedHz, (m_nSpiSpeedHz == 0 ? "Default" : ""), TLC59711SpiSpeed::DEFAULT, TLC59711SpiSpeed::MAX);
-	printf(" DMX   : StartAddress=%d, FootPrint=%d\n", m_nDmxStartAddress, m_nDmxFootprint);
+	printf(" DMX   : StartAddress=%d, FootPrint=%d%s\n", m_nDmxStartAddress, m_nDmxFootprint, m_b16Bit ? " [16-bit]" : "");
 }
@@ -53,6 +53,12 @@ void TLC59711DmxParams::Builder(const struct TTLC59711DmxParams *ptTLC59711Param
 	builder.Add(DevicesParamsConst::COUNT, m_tTLC59711Params.nLedCount, isMaskSet(TLC59711DmxParamsMask::COUNT));
 	builder.Add(LightSetConst::PARAMS_DMX_START_ADDRESS, m_tTLC59711Params.nDmxStartAddress, isMaskSet(TLC59711DmxParamsMask::START_ADDRESS));
 	builder.Add(DevicesParamsConst::SPI_SPEED_HZ, m_tTLC59711Params.nSpiSpeedHz, isMaskSet(TLC59711DmxParamsMask::SPI_SPEED));
+	builder.Add(DevicesParamsConst::PIXEL_16BIT, isMaskSet(TLC59711DmxParamsMask::PIXEL_16BIT));
+	builder.Add(DevicesParamsConst::GAMMA, static_cast<float>(m_tTLC59711Params.nGamma) / 10, isMaskSet(TLC59711DmxParamsMask::GAMMA), 1);
+	builder.Add(DevicesParamsConst::WHITE_POINT_RED, m_tTLC59711Params.nWhitePoint[0], isMaskSet(TLC59711DmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::WHITE_POINT_GREEN, m_tTLC59711Params.nWhitePoint[1], isMaskSet(TLC59711DmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::WHITE_POINT_BLUE, m_tTLC59711Params.nWhitePoint[2], isMaskSet(TLC59711DmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::MAX_CURRENT, m_tTLC59711Params.nMaxCurrent, isMaskSet(TLC59711DmxParamsMask::MAX_CURRENT));
 
 	nSize = builder.GetSize();
 
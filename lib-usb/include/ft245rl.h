@@ -41,6 +41,9 @@ extern uint8_t FT245RL_read_data();
 extern bool FT245RL_can_write(void);
 extern void FT245RL_write_data(uint8_t);
 
+extern void FT245RL_read(uint8_t *, uint32_t);
+extern void FT245RL_write(const uint8_t *, uint32_t);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,14 @@ extern "C" {
 extern uint8_t usb_read_byte(void);
 extern void usb_send_byte(uint8_t);
 
+inline static void usb_read(uint8_t *data, uint32_t length) {
+	FT245RL_read(data, length);
+}
+
+inline static void usb_send(const uint8_t *data, uint32_t length) {
+	FT245RL_write(data, length);
+}
+
 inline static bool usb_read_is_byte_available() {
 	return FT245RL_data_available();
 }
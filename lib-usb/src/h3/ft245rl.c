@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "ft245rl.h"
+
 #include "h3_gpio.h"
 #include "h3.h"
 
@@ -68,10 +70,28 @@
 #define NOP_COUNT_READ 24
 #define NOP_COUNT_WRITE 2
 
+#define DATA_MASK	((1U << D0) | (1U << D1) | (1U << D2) | (1U << D3) | (1U << D4) | (1U << D5) | (1U << D6) | (1U << D7))
+
+/*
+ * D1..D0, D3, D4, D7..D5 are PA16..PA10, D2 is PA6.
+ * Folding PA6 onto bit 7 gives an 8-bit index for the port to byte table.
+ */
+#define PORT_INDEX(x)	((((x) >> 10) & 0x7F) | (((x) << (7 - 6)) & 0x80))
+
+static uint32_t s_byte_to_port[256];
+static uint8_t s_port_to_byte[256];
+static bool s_is_data_output;
+
 /**
  * Set the GPIOs for data to output
  */
 static void data_gpio_fsel_output() {
+	if (s_is_data_output) {
+		return;
+	}
+
+	s_is_data_output = true;
+
 	uint32_t value = H3_PIO_PORTA->CFG0;
 	value &= (uint32_t) ~(GPIO_SELECT_MASK << PA6_SELECT_CFG0_SHIFT);	// D2
 	value |= (GPIO_FSEL_OUTPUT << PA6_SELECT_CFG0_SHIFT);
@@ -102,6 +122,12 @@ static void data_gpio_fsel_output() {
  * Set the GPIOs for data to input
  */
 static void data_gpio_fsel_input() {
+	if (!s_is_data_output) {
+		return;
+	}
+
+	s_is_data_output = false;
+
 	uint32_t value = H3_PIO_PORTA->CFG0;
 	value &= (uint32_t) ~(GPIO_SELECT_MASK << PA6_SELECT_CFG0_SHIFT);	// D2
 	value |= (GPIO_FSEL_INPUT << PA6_SELECT_CFG0_SHIFT);
@@ -128,11 +154,68 @@ static void data_gpio_fsel_input() {
 	H3_PIO_PORTA->CFG2 = value;
 }
 
+static void nop_delay(uint32_t count) {
+	for (; count > 0; count--) {
+		asm volatile("nop"::);
+	}
+}
+
+/**
+ * The data lines are scattered over PA6, PA10..PA16.
+ * Build the byte to port bits and the port bits to byte tables once,
+ * instead of testing the 8 bits for every byte.
+ */
+static void tables_init(void) {
+	uint32_t i;
+
+	for (i = 0; i < 256; i++) {
+		uint32_t port = 0;
+		port |= (i & 1) ? (1U << D0) : 0;
+		port |= (i & 2) ? (1U << D1) : 0;
+		port |= (i & 4) ? (1U << D2) : 0;
+		port |= (i & 8) ? (1U << D3) : 0;
+		port |= (i & 16) ? (1U << D4) : 0;
+		port |= (i & 32) ? (1U << D5) : 0;
+		port |= (i & 64) ? (1U << D6) : 0;
+		port |= (i & 128) ? (1U << D7) : 0;
+
+		s_byte_to_port[i] = port;
+		s_port_to_byte[PORT_INDEX(port)] = (uint8_t) i;
+	}
+}
+
+static inline void write_byte(uint8_t data) {
+	// Raise WR to start the write.
+	h3_gpio_set(WR);
+	nop_delay(NOP_COUNT_WRITE);
+	// Put the data on the bus.
+	H3_PIO_PORTA->DAT = (H3_PIO_PORTA->DAT & ~DATA_MASK) | s_byte_to_port[data];
+	nop_delay(NOP_COUNT_WRITE);
+	// Drop WR to tell the FT245 to read the data.
+	h3_gpio_clr(WR);
+}
+
+static inline uint8_t read_byte(void) {
+	h3_gpio_clr(_RD);
+	// Wait for the FT245 to respond with data.
+	nop_delay(NOP_COUNT_READ);
+	// Read the data from the data port.
+	const uint32_t in_gpio = H3_PIO_PORTA->DAT;
+	// Bring RD# back up so the FT245 can let go of the data.
+	h3_gpio_set(_RD);
+	return s_port_to_byte[PORT_INDEX(in_gpio)];
+}
+
 /**
  * Set RD#, WR to output, TXE#, RXF# to input.
  * Set RD# to high, set WR to low
  */
 void FT245RL_init(void) {
+	tables_init();
+
+	s_is_data_output = true;
+	data_gpio_fsel_input();
+
 	// RD#, WR output
 	uint32_t value = H3_PIO_PORTA->CFG0;
 	value &= (uint32_t) ~(GPIO_SELECT_MASK << PA3_SELECT_CFG0_SHIFT);	// WR
@@ -165,31 +248,8 @@ void FT245RL_init(void) {
  * Write 8-bits to USB
  */
 void FT245RL_write_data(uint8_t data) {
-	uint8_t i;
 	data_gpio_fsel_output();
-	// Raise WR to start the write.
-	h3_gpio_set(WR);
-	i = NOP_COUNT_WRITE;
-	for (; i > 0; i--) {
-		asm volatile("nop"::);
-	}
-	// Put the data on the bus.
-	uint32_t out_gpio = H3_PIO_PORTA->DAT & (uint32_t)~( (1 << D0) | (1 << D1) | (1 << D2) | (1 << D3) | (1 << D4) | (1 << D5) | (1 << D6) | (1 << D7));
-	out_gpio |= (data & 1) ? (1 << D0) : 0;
-	out_gpio |= (data & 2) ? (1 << D1) : 0;
-	out_gpio |= (data & 4) ? (1 << D2) : 0;
-	out_gpio |= (data & 8) ? (1 << D3) : 0;
-	out_gpio |= (data & 16) ? (1 << D4) : 0;
-	out_gpio |= (data & 32) ? (1 << D5) : 0;
-	out_gpio |= (data & 64) ? (1 << D6) : 0;
-	out_gpio |= (data & 128) ? (1 << D7) : 0;
-	H3_PIO_PORTA->DAT = out_gpio;
-	i = NOP_COUNT_WRITE;
-	for (; i > 0; i--) {
-		asm volatile("nop"::);
-	}
-	// Drop WR to tell the FT245 to read the data.
-	h3_gpio_clr(WR);
+	write_byte(data);
 }
 
 /**
@@ -197,25 +257,35 @@ void FT245RL_write_data(uint8_t data) {
  */
 uint8_t FT245RL_read_data() {
 	data_gpio_fsel_input();
-	h3_gpio_clr(_RD);
-	// Wait for the FT245 to respond with data.
-	uint8_t i = NOP_COUNT_READ;
-	for (; i > 0; i--) {
-		asm volatile("nop"::);
+	return read_byte();
+}
+
+/**
+ * Write a block to USB. The bus direction is set once,
+ * TXE# is polled before each byte.
+ */
+void FT245RL_write(const uint8_t *data, uint32_t length) {
+	data_gpio_fsel_output();
+
+	while (length-- != 0) {
+		while (!FT245RL_can_write())
+			;
+		write_byte(*data++);
+	}
+}
+
+/**
+ * Read a block from USB. The bus direction is set once,
+ * RXF# is polled before each byte.
+ */
+void FT245RL_read(uint8_t *data, uint32_t length) {
+	data_gpio_fsel_input();
+
+	while (length-- != 0) {
+		while (!FT245RL_data_available())
+			;
+		*data++ = read_byte();
 	}
-	// Read the data from the data port.
-	const uint32_t in_gpio = H3_PIO_PORTA->DAT;
-	uint8_t data = in_gpio & (1 << D0) ? 1 : 0;
-	data |= in_gpio & (1 << D1) ? 2 : 0;
-	data |= in_gpio & (1 << D2) ? 4 : 0;
-	data |= in_gpio & (1 << D3) ? 8 : 0;
-	data |= in_gpio & (1 << D4) ? 16 : 0;
-	data |= in_gpio & (1 << D5) ? 32 : 0;
-	data |= in_gpio & (1 << D6) ? 64 : 0;
-	data |= in_gpio & (1 << D7) ? 128 : 0;
-	// Bring RD# back up so the FT245 can let go of the data.
-	h3_gpio_set(_RD);
-	return data;
 }
 
 /**
@@ -226,3 +226,74 @@ const bool FT245RL_can_write(void) {
 	dmb();
 	return (!(BCM2835_GPIO->GPLEV0 & (1 << 24)));
 }
+
+/**
+ * @ingroup ft245rl
+ *
+ * Write a block to USB. The bus direction is set once,
+ * TXE# is polled before each byte.
+ *
+ * @param data
+ * @param length
+ */
+void FT245RL_write(const uint8_t *data, uint32_t length) {
+	uint8_t i;
+	data_gpio_fsel_output();
+
+	while (length-- != 0) {
+		while (!FT245RL_can_write())
+			;
+		// Raise WR to start the write.
+		bcm2835_gpio_set(WR);
+		dmb();
+		i = NOP_COUNT_WRITE;
+		for (; i > 0; i--) {
+			asm volatile("nop"::);
+		}
+		// Put the data on the bus.
+		const uint32_t out_gpio = ((*data & ~0b00000111) << 4) | ((*data & 0b00000111) << 2);
+		data++;
+		BCM2835_GPIO->GPSET0 = out_gpio;
+		BCM2835_GPIO->GPCLR0 = out_gpio ^ 0b111110011100;
+		dmb();
+		i = NOP_COUNT_WRITE;
+		for (; i > 0; i--) {
+			asm volatile("nop"::);
+		}
+		// Drop WR to tell the FT245 to read the data.
+		bcm2835_gpio_clr(WR);
+		dmb();
+	}
+}
+
+/**
+ * @ingroup ft245rl
+ *
+ * Read a block from USB. The bus direction is set once,
+ * RXF# is polled before each byte.
+ *
+ * @param data
+ * @param length
+ */
+void FT245RL_read(uint8_t *data, uint32_t length) {
+	uint8_t i;
+	data_gpio_fsel_input();
+
+	while (length-- != 0) {
+		while (!FT245RL_data_available())
+			;
+		bcm2835_gpio_clr(_RD);
+		dmb();
+		// Wait for the FT245 to respond with data.
+		i = NOP_COUNT_READ;
+		for (; i > 0; i--) {
+			asm volatile("nop"::);
+		}
+		// Read the data from the data port.
+		const uint32_t in_gpio = (BCM2835_GPIO->GPLEV0 & 0b111110011100) >> 2;
+		*data++ = (uint8_t) ((in_gpio >> 2) & 0xF8) | (uint8_t) (in_gpio & 0x0F);
+		// Bring RD# back up so the FT245 can let go of the data.
+		bcm2835_gpio_set(_RD);
+		dmb();
+	}
+}
@@ -0,0 +1,453 @@
+/**
+ * @file ft245cos.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Runs the widget against a simulated FT245 and DMX input.
+ * The host enables Receive DMX on Change (label 8), the DMX input replays a
+ * universe with a few moving slots. The label 9 messages read back from the
+ * FT245 are applied to a host copy of the universe, which must match the
+ * received packet. The USB bytes are compared with the label 5 stream.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <vector>
+#include <deque>
+
+#include "widget.h"
+#include "widgetconfiguration.h"
+#include "widgetmonitor.h"
+
+#include "hardware.h"
+
+#include "dmx.h"
+#include "dmx_changed.h"
+#include "rdm.h"
+#include "rdmdevice.h"
+
+#include "ft245rl.h"
+
+/*
+ * FT245 simulation
+ */
+
+static std::deque<uint8_t> s_HostToWidget;
+static std::vector<uint8_t> s_WidgetToHost;
+
+void FT245RL_init() {
+}
+
+bool FT245RL_data_available() {
+	return !s_HostToWidget.empty();
+}
+
+uint8_t FT245RL_read_data() {
+	if (s_HostToWidget.empty()) {
+		fprintf(stderr, "FT245 read without data\n");
+		exit(EXIT_FAILURE);
+	}
+
+	const auto nByte = s_HostToWidget.front();
+	s_HostToWidget.pop_front();
+	return nByte;
+}
+
+bool FT245RL_can_write() {
+	return true;
+}
+
+void FT245RL_write_data(uint8_t nByte) {
+	s_WidgetToHost.push_back(nByte);
+}
+
+void FT245RL_read(uint8_t *pData, uint32_t nLength) {
+	for (uint32_t i = 0; i < nLength; i++) {
+		pData[i] = FT245RL_read_data();
+	}
+}
+
+void FT245RL_write(const uint8_t *pData, uint32_t nLength) {
+	s_WidgetToHost.insert(s_WidgetToHost.end(), pData, pData + nLength);
+}
+
+/*
+ * DMX input simulation, dmx_is_data_changed() as in lib-dmx/src/h3/dmx.c
+ */
+
+static struct _dmx_data s_DmxData __attribute__((aligned(4)));
+static bool s_bDmxAvailable;
+static uint8_t s_DmxPrevious[DMX_DATA_BUFFER_SIZE] __attribute__((aligned(4)));
+static uint32_t s_DmxChangedBlocks[DMX_CHANGED_BLOCKS_WORDS];
+static uint32_t s_nSlotsInPacketPrevious;
+
+static void dmx_receive(const uint8_t *pSlots, uint32_t nSlots) {
+	memset(s_DmxData.data, 0, sizeof(s_DmxData.data));
+	memcpy(&s_DmxData.data[1], pSlots, nSlots);
+	s_DmxData.statistics.slots_in_packet = nSlots;
+	s_bDmxAvailable = true;
+}
+
+const uint8_t *dmx_get_available() {
+	if (!s_bDmxAvailable) {
+		return nullptr;
+	}
+
+	s_bDmxAvailable = false;
+	return s_DmxData.data;
+}
+
+const uint8_t *dmx_is_data_changed() {
+	const auto *p = dmx_get_available();
+
+	if (p == nullptr) {
+		return nullptr;
+	}
+
+	const auto isChanged = dmx_changed_update(reinterpret_cast<const uint32_t *>(p), reinterpret_cast<uint32_t *>(s_DmxPrevious), s_DmxChangedBlocks);
+
+	if (s_DmxData.statistics.slots_in_packet != s_nSlotsInPacketPrevious) {
+		s_nSlotsInPacketPrevious = s_DmxData.statistics.slots_in_packet;
+		return p;
+	}
+
+	return isChanged ? p : nullptr;
+}
+
+const uint32_t *dmx_get_changed_blocks() {
+	return s_DmxChangedBlocks;
+}
+
+void dmx_clear_data() {
+	memset(&s_DmxData, 0, sizeof(s_DmxData));
+	memset(s_DmxPrevious, 0, sizeof(s_DmxPrevious));
+	s_nSlotsInPacketPrevious = 0;
+}
+
+void dmx_set_send_data(__attribute__((unused)) const uint8_t *pData, __attribute__((unused)) uint16_t nLength) {
+}
+
+_dmx_port_direction dmx_get_port_direction() {
+	return DMX_PORT_DIRECTION_INP;
+}
+
+/*
+ * The widget dependencies which are not part of the test
+ */
+
+static uint32_t s_nMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nMillis;
+}
+
+DmxSet *DmxSet::s_pThis = nullptr;
+
+DmxSet::DmxSet() {
+	s_pThis = this;
+}
+
+Dmx::Dmx(__attribute__((unused)) uint8_t nGpioPin, __attribute__((unused)) bool DoInit) {
+}
+
+void Dmx::SetPortDirection(__attribute__((unused)) uint8_t nPort, __attribute__((unused)) TDmxRdmPortDirection tPortDirection, __attribute__((unused)) bool bEnableData) {
+}
+
+void Dmx::RdmSendRaw(__attribute__((unused)) uint8_t nPort, __attribute__((unused)) const uint8_t *pRdmData, __attribute__((unused)) uint16_t nLength) {
+}
+
+const uint8_t *Dmx::RdmReceive(__attribute__((unused)) uint8_t nPort) {
+	return nullptr;
+}
+
+const uint8_t *Dmx::RdmReceiveTimeOut(__attribute__((unused)) uint8_t nPort, __attribute__((unused)) uint32_t nTimeOut) {
+	return nullptr;
+}
+
+RDMDevice::RDMDevice() {
+}
+
+void RDMDevice::Init() {
+}
+
+void RDMDevice::GetManufacturerId(__attribute__((unused)) struct TRDMDeviceInfoData *pInfo) {
+}
+
+void RDMDevice::GetManufacturerName(__attribute__((unused)) struct TRDMDeviceInfoData *pInfo) {
+}
+
+void RDMDevice::GetLabel(__attribute__((unused)) struct TRDMDeviceInfoData *pInfo) {
+}
+
+void Rdm::SendRaw(__attribute__((unused)) uint8_t nPort, __attribute__((unused)) const uint8_t *pRdmData, __attribute__((unused)) uint16_t nLength) {
+}
+
+const uint8_t *Rdm::Receive(__attribute__((unused)) uint8_t nPort) {
+	return nullptr;
+}
+
+void WidgetMonitor::Line(__attribute__((unused)) int nLine, __attribute__((unused)) const char *fmt, ...) {
+}
+
+void WidgetMonitor::RdmData(__attribute__((unused)) int nLine, __attribute__((unused)) uint16_t nLength, __attribute__((unused)) const uint8_t *pData, __attribute__((unused)) bool bIsSent) {
+}
+
+uint8_t WidgetConfiguration::s_aDeviceTypeId[DEVICE_TYPE_ID_LENGTH];
+uint8_t WidgetConfiguration::s_nFirmwareLsb;
+uint8_t WidgetConfiguration::s_nFirmwareMsb;
+uint8_t WidgetConfiguration::s_nBreakTime;
+uint8_t WidgetConfiguration::s_nMabTime;
+uint8_t WidgetConfiguration::s_nRefreshRate;
+
+void WidgetConfiguration::Store(__attribute__((unused)) const struct TWidgetConfiguration *pWidgetConfiguration) {
+}
+
+void Widget::SnifferRdm() {
+}
+
+void Widget::SnifferDmx() {
+}
+
+/*
+ * Host side
+ */
+
+namespace label {
+static constexpr uint8_t RECEIVED_DMX_PACKET = 5;
+static constexpr uint8_t RECEIVE_DMX_ON_CHANGE = 8;
+static constexpr uint8_t RECEIVED_DMX_COS_TYPE = 9;
+}  // namespace label
+
+static constexpr uint32_t COS_CHANGED_BYTES = 5;
+
+static uint8_t s_HostUniverse[DMX_DATA_BUFFER_SIZE];
+
+static void host_send(uint8_t nLabel, const uint8_t *pData, uint16_t nLength) {
+	s_HostToWidget.push_back(static_cast<uint8_t>(widget::Amf::START_CODE));
+	s_HostToWidget.push_back(nLabel);
+	s_HostToWidget.push_back(static_cast<uint8_t>(nLength & 0xFF));
+	s_HostToWidget.push_back(static_cast<uint8_t>(nLength >> 8));
+	s_HostToWidget.insert(s_HostToWidget.end(), pData, pData + nLength);
+	s_HostToWidget.push_back(static_cast<uint8_t>(widget::Amf::END_CODE));
+}
+
+/**
+ * Decodes the bytes sent by the widget, applies the change-of-state messages.
+ * Returns the number of messages, or -1 on a framing error.
+ */
+static int host_receive() {
+	uint32_t nIndex = 0;
+	int nMessages = 0;
+
+	while (nIndex < s_WidgetToHost.size()) {
+		if ((s_WidgetToHost.size() - nIndex) < 5 || (s_WidgetToHost[nIndex] != static_cast<uint8_t>(widget::Amf::START_CODE))) {
+			return -1;
+		}
+
+		const auto nLabel = s_WidgetToHost[nIndex + 1];
+		const auto nLength = static_cast<uint32_t>(s_WidgetToHost[nIndex + 2] | (s_WidgetToHost[nIndex + 3] << 8));
+		const auto *pData = &s_WidgetToHost[nIndex + 4];
+
+		if ((nIndex + 4 + nLength >= s_WidgetToHost.size()) || (pData[nLength] != static_cast<uint8_t>(widget::Amf::END_CODE))) {
+			return -1;
+		}
+
+		if (nLabel == label::RECEIVED_DMX_COS_TYPE) {
+			if (nLength < 1 + COS_CHANGED_BYTES) {
+				return -1;
+			}
+
+			const auto nStart = pData[0] * 8U;
+			uint32_t nValue = 1 + COS_CHANGED_BYTES;
+
+			for (uint32_t i = 0; i < COS_CHANGED_BYTES * 8; i++) {
+				if ((pData[1 + i / 8] & (1U << (i & 7))) != 0) {
+					if ((nValue >= nLength) || (nStart + i >= sizeof(s_HostUniverse))) {
+						return -1;
+					}
+					s_HostUniverse[nStart + i] = pData[nValue++];
+				}
+			}
+
+			if (nValue != nLength) {
+				return -1;
+			}
+		}
+
+		nMessages++;
+		nIndex += 4 + nLength + 1;
+	}
+
+	return nMessages;
+}
+
+struct Result {
+	uint32_t nFrames;
+	uint32_t nMessages;
+	uint32_t nCosBytes;
+	uint32_t nFullBytes;
+	uint32_t nErrors;
+};
+
+static void run_frame(Widget& widget, const uint8_t *pSlots, uint32_t nSlots, Result& result) {
+	s_WidgetToHost.clear();
+
+	dmx_receive(pSlots, nSlots);
+	widget.Run();
+	s_nMillis += 25;
+
+	const auto nMessages = host_receive();
+
+	if ((nMessages < 0) || (memcmp(&s_HostUniverse[1], pSlots, nSlots) != 0) || (s_HostUniverse[0] != DMX512_START_CODE)) {
+		result.nErrors++;
+	} else {
+		result.nMessages += static_cast<uint32_t>(nMessages);
+	}
+
+	result.nFrames++;
+	result.nCosBytes += static_cast<uint32_t>(s_WidgetToHost.size());
+	// Label 5: header, receive status, start code and slots, footer
+	result.nFullBytes += 4 + 1 + 1 + nSlots + 1;
+}
+
+static bool report(const char *pName, const Result& result) {
+	const auto bPass = (result.nErrors == 0);
+
+	printf("%-16s frames %4u, messages %5u, COS %7u bytes (%6.1f/frame), label 5 %7u bytes, %5.1f%% -> %s\n",
+			pName, result.nFrames, result.nMessages, result.nCosBytes,
+			static_cast<double>(result.nCosBytes) / result.nFrames, result.nFullBytes,
+			100.0 * result.nCosBytes / result.nFullBytes, bPass ? "PASS" : "FAIL");
+
+	return bPass;
+}
+
+int main() {
+	Hardware hw;
+	Widget widget;
+
+	const uint8_t nOnChange = static_cast<uint8_t>(widget::SendState::ON_DATA_CHANGE_ONLY);
+	host_send(label::RECEIVE_DMX_ON_CHANGE, &nOnChange, 1);
+	widget.Run();
+
+	if ((widget.GetReceiveDmxOnChange() != widget::SendState::ON_DATA_CHANGE_ONLY) || !s_HostToWidget.empty()) {
+		puts("Receive DMX on Change not set -> FAIL");
+		return EXIT_FAILURE;
+	}
+
+	uint8_t aSlots[DMX_MAX_CHANNELS];
+	auto bPass = true;
+
+	srand(1);
+
+	// The first packet, all slots compared with zero
+	{
+		Result result {};
+		for (uint32_t i = 0; i < DMX_MAX_CHANNELS; i++) {
+			aSlots[i] = static_cast<uint8_t>(rand());
+		}
+		run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		bPass &= report("First packet", result);
+	}
+
+	// Repeated packets, nothing is sent
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 100; nFrame++) {
+			run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		}
+		bPass &= (result.nCosBytes == 0);
+		bPass &= report("Unchanged", result);
+	}
+
+	// A single fader
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 256; nFrame++) {
+			aSlots[100] = static_cast<uint8_t>(nFrame);
+			run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		}
+		bPass &= report("Fader", result);
+	}
+
+	// Three RGB fixtures spread over the universe
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 256; nFrame++) {
+			for (const auto nAddress : { 0U, 255U, 509U }) {
+				aSlots[nAddress + 0] = static_cast<uint8_t>(nFrame);
+				aSlots[nAddress + 1] = static_cast<uint8_t>(255 - nFrame);
+				aSlots[nAddress + 2] = static_cast<uint8_t>(nFrame * 3);
+			}
+			run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		}
+		bPass &= report("RGB fixtures", result);
+	}
+
+	// Random slots
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 256; nFrame++) {
+			for (uint32_t i = 0; i < 16; i++) {
+				aSlots[static_cast<uint32_t>(rand()) % DMX_MAX_CHANNELS] = static_cast<uint8_t>(rand());
+			}
+			run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		}
+		bPass &= report("Random 16 slots", result);
+	}
+
+	// Short packets, the last block is partial
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 256; nFrame++) {
+			aSlots[20] = static_cast<uint8_t>(nFrame);
+			run_frame(widget, aSlots, 21, result);
+		}
+		bPass &= report("21 slots", result);
+	}
+
+	// Everything changes
+	{
+		Result result {};
+		for (uint32_t nFrame = 0; nFrame < 64; nFrame++) {
+			for (uint32_t i = 0; i < DMX_MAX_CHANNELS; i++) {
+				aSlots[i] = static_cast<uint8_t>(aSlots[i] + 1);
+			}
+			run_frame(widget, aSlots, DMX_MAX_CHANNELS, result);
+		}
+		bPass &= report("All slots", result);
+	}
+
+	puts(bPass ? "PASS" : "FAIL");
+
+	return bPass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -62,6 +62,8 @@ enum {
 	GET_WIDGET_NAME_LABEL = 78				///< https://wiki.openlighting.org/index.php/USB_Protocol_Extensions
 };
 
+static constexpr uint32_t COS_CHANGED_BYTES = 5;	///< Changed bit array, 40 slots per \ref RECEIVED_DMX_COS_TYPE message
+
 using namespace widget;
 using namespace widgetmonitor;
 
@@ -348,12 +350,69 @@ void Widget::ReceivedDmxChangeOfStatePacket() {
 		return;
 	}
 
-	if (dmx_is_data_changed()) {
-		WidgetMonitor::Line(MonitorLine::INFO, "RECEIVED_DMX_COS_TYPE");
-		WidgetMonitor::Line(MonitorLine::STATUS, nullptr);
-		// TODO widget_received_dmx_change_of_state_packet
-		WidgetMonitor::Line(MonitorLine::INFO, "Sent changed DMX data to HOST");
+	const auto *pDmxData = dmx_is_data_changed();
+
+	if (pDmxData == nullptr) {
+		return;
 	}
+
+	const auto *pChangedBlocks = dmx_get_changed_blocks();
+	const auto *pDmxStatistics = reinterpret_cast<const struct _dmx_data *>(pDmxData);
+	const uint32_t nLength = pDmxStatistics->statistics.slots_in_packet + 1U;
+	const uint32_t nBlocks = (nLength + DMX_CHANGED_BLOCK_SLOTS - 1) / DMX_CHANGED_BLOCK_SLOTS;
+
+	WidgetMonitor::Line(MonitorLine::INFO, "RECEIVED_DMX_COS_TYPE");
+	WidgetMonitor::Line(MonitorLine::STATUS, nullptr);
+
+	m_nReceivedDmxPacketCount++;
+
+	/*
+	 * Each message covers 40 slots (5 blocks of 8) starting at block nStart:
+	 * [start block][changed bit array, 5 bytes][changed slots]
+	 * Bit n of the array is slot (nStart * 8 + n), slot 0 is the start code.
+	 * Messages are only sent for windows starting with a changed block.
+	 */
+	uint32_t nStart = 0;
+
+	while (nStart < nBlocks) {
+		if ((pChangedBlocks[nStart / 32] & (1U << (nStart & 31))) == 0) {
+			nStart++;
+			continue;
+		}
+
+		uint8_t aChangedBits[COS_CHANGED_BYTES];
+		uint16_t nDataLength = 0;
+
+		for (uint32_t i = 0; i < COS_CHANGED_BYTES; i++) {
+			const auto nBlock = nStart + i;
+
+			aChangedBits[i] = 0;
+
+			if ((nBlock < nBlocks) && ((pChangedBlocks[nBlock / 32] & (1U << (nBlock & 31))) != 0)) {
+				const auto nRemaining = nLength - nBlock * DMX_CHANGED_BLOCK_SLOTS;
+				const auto nSlots = (nRemaining < DMX_CHANGED_BLOCK_SLOTS) ? nRemaining : DMX_CHANGED_BLOCK_SLOTS;
+				aChangedBits[i] = static_cast<uint8_t>((1U << nSlots) - 1);
+				nDataLength = static_cast<uint16_t>(nDataLength + nSlots);
+			}
+		}
+
+		SendHeader(RECEIVED_DMX_COS_TYPE, static_cast<uint16_t>(1 + COS_CHANGED_BYTES + nDataLength));
+		usb_send_byte(static_cast<uint8_t>(nStart));
+		SendData(aChangedBits, COS_CHANGED_BYTES);
+
+		for (uint32_t i = 0; i < COS_CHANGED_BYTES; i++) {
+			if (aChangedBits[i] != 0) {
+				const auto nSlot = (nStart + i) * DMX_CHANGED_BLOCK_SLOTS;
+				SendData(&pDmxData[nSlot], static_cast<uint16_t>(__builtin_popcount(aChangedBits[i])));
+			}
+		}
+
+		SendFooter();
+
+		nStart += COS_CHANGED_BYTES;
+	}
+
+	WidgetMonitor::Line(MonitorLine::INFO, "Sent changed DMX data to HOST");
 }
 
 /**
@@ -480,17 +539,20 @@ void Widget::ReceiveDataFromHost() {
 		const auto nByte = usb_read_byte();
 
 		if (static_cast<uint8_t>(Amf::START_CODE) == nByte) {
-			const auto nLabel = usb_read_byte();
-			const auto nLsb = usb_read_byte();
-			const auto nMsb = usb_read_byte();
-			const uint16_t nDataLength = (nMsb << 8) | nLsb;
+			uint8_t aHeader[3];
+			usb_read(aHeader, sizeof(aHeader));
+
+			const auto nLabel = aHeader[0];
+			const uint16_t nDataLength = static_cast<uint16_t>((aHeader[2] << 8) | aHeader[1]);
 
-			uint32_t i;
+			uint32_t i = nDataLength;
 
-			for (i = 0; i < nDataLength; i++) {
-				m_aData[i] = usb_read_byte();
+			if (i > sizeof(m_aData) / sizeof(m_aData[0])) {
+				i = sizeof(m_aData) / sizeof(m_aData[0]);
 			}
 
+			usb_read(m_aData, i);
+
 			while ((static_cast<uint8_t>(Amf::END_CODE) != usb_read_byte()) && (i++ < (sizeof(m_aData) / sizeof(m_aData[0]))))
 				;
 
@@ -31,16 +31,17 @@
 using namespace widget;
 
 void Widget::SendHeader(uint8_t nLabel, uint16_t nLength) {
-	usb_send_byte(static_cast<uint8_t>(Amf::START_CODE));
-	usb_send_byte(nLabel);
-	usb_send_byte((nLength & 0x00FF));
-	usb_send_byte((nLength >> 8));
+	const uint8_t aHeader[] = {
+			static_cast<uint8_t>(Amf::START_CODE),
+			nLabel,
+			static_cast<uint8_t>(nLength & 0x00FF),
+			static_cast<uint8_t>(nLength >> 8) };
+
+	usb_send(aHeader, sizeof(aHeader));
 }
 
 void Widget::SendData(const uint8_t *pData, uint16_t nLength) {
-	for (uint32_t i = 0; i < nLength; i++) {
-		usb_send_byte(pData[i]);
-	}
+	usb_send(pData, nLength);
 }
 
 void Widget::SendFooter() {
@@ -0,0 +1,466 @@
+/**
+ * @file lutbench.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Checks the colour curve of PixelLut against pow() and the frames WS28xx
+ * writes to the SPI with the curve, for WS2812B, SK6812W, WS2801 and APA102.
+ * The APA102 frames are averaged over the 8 dither frames.
+ * The TLC59711Dmx frames are checked for 8-bit and 16-bit DMX, RGB and RGBW.
+ * Then the time per pixel of SetPixel is measured: linear, with the curve
+ * in the encoder, and with the curve as a separate pass before the encoder.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "bcm2835.h"
+
+#include "ws28xx.h"
+#include "pixelconfiguration.h"
+#include "pixellut.h"
+#include "pixeltype.h"
+#include "tlc59711dmx.h"
+
+using pixellut::Colour;
+
+static constexpr uint32_t BENCH_FRAMES = 200;
+
+/*
+ * SPI, the last frame written is kept
+ */
+
+static std::vector<uint8_t> s_Frame;
+
+void bcm2835_spi_begin() {
+}
+
+void bcm2835_spi_chipSelect(__attribute__((unused)) uint8_t nChipSelect) {
+}
+
+void bcm2835_spi_set_speed_hz(__attribute__((unused)) uint32_t nSpeedHz) {
+}
+
+void bcm2835_spi_setDataMode(__attribute__((unused)) uint8_t nMode) {
+}
+
+void bcm2835_spi_transfern(__attribute__((unused)) char *pBuffer, __attribute__((unused)) uint32_t nLength) {
+}
+
+void bcm2835_spi_writenb(const char *pBuffer, uint32_t nLength) {
+	s_Frame.assign(reinterpret_cast<const uint8_t *>(pBuffer), reinterpret_cast<const uint8_t *>(pBuffer) + nLength);
+}
+
+void bcm2835_spi_write(__attribute__((unused)) uint16_t nData) {
+}
+
+void bcm2835_delayMicroseconds(__attribute__((unused)) uint64_t nMicros) {
+}
+
+/*
+ * Test
+ */
+
+static uint32_t s_nFailed;
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void result(const char *pName, uint32_t nChecks, uint32_t nErrorMax, uint32_t nLimit) {
+	const auto bPass = (nErrorMax <= nLimit);
+	printf("%-40s %7u %6u %6u  %s\n", pName, nChecks, nErrorMax, nLimit, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+struct Curve {
+	uint8_t nGamma;
+	uint8_t aWhitePoint[3];
+	uint8_t nMaxCurrent;
+};
+
+static double reference(const Curve& curve, uint32_t nColour, uint32_t nValue) {
+	const auto nWhitePoint = (nColour < 3) ? curve.aWhitePoint[nColour] : pixellut::defaults::WHITE_POINT;
+	return pow(nValue / 255.0, curve.nGamma / 10.0) * 65535.0 * (curve.nMaxCurrent / 100.0) * nWhitePoint / 255;
+}
+
+static void check_build(const char *pName, const Curve& curve) {
+	PixelLut lut;
+	lut.Build(curve.nGamma, curve.aWhitePoint, curve.nMaxCurrent);
+
+	uint32_t nError16 = 0;
+	uint32_t nError8 = 0;
+
+	for (uint32_t nColour = 0; nColour < pixellut::COLOURS; nColour++) {
+		for (uint32_t nValue = 0; nValue < 256; nValue++) {
+			const auto fReference = reference(curve, nColour, nValue);
+			const auto nReference16 = static_cast<int32_t>(fReference + 0.5);
+			const auto nReference8 = static_cast<int32_t>(fReference / 257 + 0.5);
+			const auto nLut16 = static_cast<int32_t>(lut.Get16(static_cast<Colour>(nColour), static_cast<uint8_t>(nValue)));
+			const auto nLut8 = static_cast<int32_t>(lut.Get(static_cast<Colour>(nColour), static_cast<uint8_t>(nValue)));
+			const auto nDiff16 = static_cast<uint32_t>(abs(nLut16 - nReference16));
+			const auto nDiff8 = static_cast<uint32_t>(abs(nLut8 - nReference8));
+
+			nError16 = nDiff16 > nError16 ? nDiff16 : nError16;
+			nError8 = nDiff8 > nError8 ? nDiff8 : nError8;
+		}
+	}
+
+	char aName[64];
+	snprintf(aName, sizeof(aName), "%s 16-bit", pName);
+	result(aName, pixellut::COLOURS * 256, nError16, 1);
+	snprintf(aName, sizeof(aName), "%s 8-bit", pName);
+	result(aName, pixellut::COLOURS * 256, nError8, 1);
+}
+
+static void configure(PixelConfiguration& config, pixel::Type type, uint16_t nCount, const Curve *pCurve) {
+	config.SetType(type);
+	config.SetCount(nCount);
+
+	if (pCurve != nullptr) {
+		config.SetGamma(pCurve->nGamma);
+		config.SetWhitePoint(pCurve->aWhitePoint[0], pCurve->aWhitePoint[1], pCurve->aWhitePoint[2]);
+		config.SetMaxCurrent(pCurve->nMaxCurrent);
+	}
+}
+
+static uint8_t decode_rtz(uint32_t nOffset, uint8_t nHighCode) {
+	uint8_t nValue = 0;
+
+	for (uint32_t i = 0; i < 8; i++) {
+		nValue = static_cast<uint8_t>((nValue << 1) | (s_Frame[nOffset + i] == nHighCode ? 1 : 0));
+	}
+
+	return nValue;
+}
+
+static uint8_t pattern(uint32_t nIndex, uint32_t nColour) {
+	return static_cast<uint8_t>(nIndex * (2 * nColour + 1) + 64 * nColour);
+}
+
+/**
+ * WS2812B (GRB) and SK6812W (GRBW): the bits in the frame are the table entries
+ */
+static void check_rtz(const char *pName, pixel::Type type, const Curve *pCurve) {
+	PixelConfiguration config;
+	configure(config, type, 256, pCurve);
+
+	PixelLut lut;
+	if (pCurve != nullptr) {
+		lut.Build(pCurve->nGamma, pCurve->aWhitePoint, pCurve->nMaxCurrent);
+	}
+
+	const auto bRGBW = (type == pixel::Type::SK6812W);
+	const uint32_t nColours = bRGBW ? 4 : 3;
+	const uint32_t aOrder[4] = { 1, 0, 2, 3 };	// GRB(W)
+
+	WS28xx ws28xx(config);
+	const auto nHighCode = config.GetHighCode();
+
+	for (uint32_t i = 0; i < ws28xx.GetCount(); i++) {
+		if (bRGBW) {
+			ws28xx.SetPixel(i, pattern(i, 0), pattern(i, 1), pattern(i, 2), pattern(i, 3));
+		} else {
+			ws28xx.SetPixel(i, pattern(i, 0), pattern(i, 1), pattern(i, 2));
+		}
+	}
+
+	ws28xx.Update();
+
+	uint32_t nErrors = 0;
+
+	for (uint32_t i = 0; i < ws28xx.GetCount(); i++) {
+		for (uint32_t c = 0; c < nColours; c++) {
+			const auto nColour = aOrder[c];
+			const auto nInput = pattern(i, nColour);
+			const auto nExpected = (pCurve != nullptr) ? lut.Get(static_cast<Colour>(nColour), nInput) : nInput;
+
+			if (decode_rtz((i * nColours + c) * 8, nHighCode) != nExpected) {
+				nErrors++;
+			}
+		}
+	}
+
+	result(pName, ws28xx.GetCount() * nColours, nErrors, 0);
+}
+
+static void check_ws2801(const char *pName, const Curve& curve) {
+	PixelConfiguration config;
+	configure(config, pixel::Type::WS2801, 256, &curve);
+
+	PixelLut lut;
+	lut.Build(curve.nGamma, curve.aWhitePoint, curve.nMaxCurrent);
+
+	WS28xx ws28xx(config);
+
+	for (uint32_t i = 0; i < ws28xx.GetCount(); i++) {
+		ws28xx.SetPixel(i, pattern(i, 0), pattern(i, 1), pattern(i, 2));
+	}
+
+	ws28xx.Update();
+
+	uint32_t nErrors = 0;
+
+	for (uint32_t i = 0; i < ws28xx.GetCount(); i++) {
+		for (uint32_t nColour = 0; nColour < 3; nColour++) {
+			if (s_Frame[i * 3 + nColour] != lut.Get(static_cast<Colour>(nColour), pattern(i, nColour))) {
+				nErrors++;
+			}
+		}
+	}
+
+	result(pName, ws28xx.GetCount() * 3, nErrors, 0);
+}
+
+/**
+ * APA102: 5-bit global brightness x 8-bit PWM, averaged over the 8 dither frames,
+ * must be the 16-bit table entry within 1/8 of the PWM step.
+ * The error reported is in 1/16 of the PWM step.
+ */
+static void check_apa102(const char *pName, const Curve& curve) {
+	PixelConfiguration config;
+	configure(config, pixel::Type::APA102, 256, &curve);
+
+	PixelLut lut;
+	lut.Build(curve.nGamma, curve.aWhitePoint, curve.nMaxCurrent);
+
+	WS28xx ws28xx(config);
+
+	const auto nCount = ws28xx.GetCount();
+	std::vector<double> sum(nCount * 3, 0);
+	std::vector<double> step(nCount, 0);
+
+	for (uint32_t nFrame = 0; nFrame < 8; nFrame++) {
+		for (uint32_t i = 0; i < nCount; i++) {
+			ws28xx.SetPixel(i, pattern(i, 0), pattern(i, 1), pattern(i, 2));
+		}
+
+		ws28xx.Update();
+
+		for (uint32_t i = 0; i < nCount; i++) {
+			const auto *p = &s_Frame[4 + i * 4];
+			const auto nBrightness = p[0] & 0x1F;
+			step[i] = 65535.0 * nBrightness / (31.0 * 255.0);
+
+			for (uint32_t nColour = 0; nColour < 3; nColour++) {
+				sum[i * 3 + nColour] += p[1 + nColour] * step[i];
+			}
+		}
+	}
+
+	uint32_t nError = 0;
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		for (uint32_t nColour = 0; nColour < 3; nColour++) {
+			const auto fAverage = sum[i * 3 + nColour] / 8;
+			const auto fExpected = static_cast<double>(lut.Get16(static_cast<Colour>(nColour), pattern(i, nColour)));
+			const auto nDiff = static_cast<uint32_t>(fabs(fAverage - fExpected) * 16 / (step[i] > 0 ? step[i] : 1));
+
+			nError = nDiff > nError ? nDiff : nError;
+		}
+	}
+
+	result(pName, nCount * 3, nError, 2);
+}
+
+/**
+ * TLC59711: one board, 12 outputs. The 16-bit words are sent big-endian,
+ * output 11 first, after the 4 bytes of the command word.
+ */
+static uint16_t decode_tlc59711(uint32_t nOutput) {
+	const auto nOffset = 2 * (13 - nOutput);
+	return static_cast<uint16_t>((s_Frame[nOffset] << 8) | s_Frame[nOffset + 1]);
+}
+
+static void check_tlc59711(const char *pName, const Curve *pCurve, TTLC59711Type type, bool b16Bit) {
+	const uint32_t nColours = (type == TTLC59711_TYPE_RGB) ? 3 : 4;
+
+	TLC59711Dmx tlc59711;
+	tlc59711.SetLEDType(type);
+	tlc59711.SetLEDCount(static_cast<uint8_t>(12 / nColours));
+	tlc59711.Set16Bit(b16Bit);
+
+	PixelLut lut;
+
+	if (pCurve != nullptr) {
+		tlc59711.SetGamma(pCurve->nGamma);
+		tlc59711.SetWhitePoint(pCurve->aWhitePoint[0], pCurve->aWhitePoint[1], pCurve->aWhitePoint[2]);
+		tlc59711.SetMaxCurrent(pCurve->nMaxCurrent);
+		lut.Build(pCurve->nGamma, pCurve->aWhitePoint, pCurve->nMaxCurrent);
+	}
+
+	uint8_t aDmx[512];
+	uint16_t aInput[12];
+
+	for (uint32_t i = 0; i < 12; i++) {
+		const auto nCoarse = pattern(i / nColours, i % nColours);
+		aInput[i] = static_cast<uint16_t>(b16Bit ? (nCoarse << 8) | ((i * 37) & 0xFF) : nCoarse);
+
+		if (b16Bit) {
+			aDmx[i * 2] = nCoarse;
+			aDmx[i * 2 + 1] = static_cast<uint8_t>(aInput[i]);
+		} else {
+			aDmx[i] = nCoarse;
+		}
+	}
+
+	tlc59711.Stage(0, aDmx, static_cast<uint16_t>(b16Bit ? 24 : 12));
+	tlc59711.Commit();
+
+	uint32_t nErrors = 0;
+
+	for (uint32_t i = 0; i < 12; i++) {
+		const auto colour = static_cast<Colour>(i % nColours);
+		uint16_t nExpected;
+
+		if (pCurve != nullptr) {
+			nExpected = b16Bit ? lut.Interpolate16(colour, aInput[i]) : lut.Get16(colour, static_cast<uint8_t>(aInput[i]));
+		} else {
+			nExpected = b16Bit ? aInput[i] : static_cast<uint16_t>((aInput[i] << 8) | aInput[i]);
+		}
+
+		if (decode_tlc59711(i) != nExpected) {
+			nErrors++;
+		}
+	}
+
+	result(pName, 12, nErrors, 0);
+}
+
+/*
+ * Benchmark
+ */
+
+/*
+ * The separate pass corrects the 8-bit values in a buffer first, as done upstream.
+ * For APA102 the curve in the encoder is the 16-bit path with the 5-bit brightness,
+ * the separate pass loses that resolution.
+ */
+enum class Path {
+	LINEAR, FUSED, SEPARATE
+};
+
+static double bench(pixel::Type type, const Curve& curve, Path path) {
+	PixelConfiguration config;
+	configure(config, type, pixel::max::ledcount::RGB, path == Path::FUSED ? &curve : nullptr);
+
+	PixelLut lut;
+	lut.Build(curve.nGamma, curve.aWhitePoint, curve.nMaxCurrent);
+
+	WS28xx ws28xx(config);
+	const auto nCount = ws28xx.GetCount();
+
+	std::vector<uint8_t> input(nCount * 3);
+	std::vector<uint8_t> corrected(nCount * 3);
+
+	for (uint32_t i = 0; i < nCount * 3; i++) {
+		input[i] = static_cast<uint8_t>(i * 7);
+	}
+
+	const auto nStart = nanos();
+
+	for (uint32_t nFrame = 0; nFrame < BENCH_FRAMES; nFrame++) {
+		input[nFrame % (nCount * 3)]++;
+		const uint8_t *pData = input.data();
+
+		if (path == Path::SEPARATE) {
+			for (uint32_t i = 0; i < nCount * 3; i += 3) {
+				corrected[i] = lut.Get(Colour::RED, input[i]);
+				corrected[i + 1] = lut.Get(Colour::GREEN, input[i + 1]);
+				corrected[i + 2] = lut.Get(Colour::BLUE, input[i + 2]);
+			}
+			pData = corrected.data();
+		}
+
+		for (uint32_t i = 0; i < nCount; i++) {
+			ws28xx.SetPixel(i, pData[i * 3], pData[i * 3 + 1], pData[i * 3 + 2]);
+		}
+	}
+
+	const auto nElapsed = nanos() - nStart;
+
+	return static_cast<double>(nElapsed) / (BENCH_FRAMES * nCount);
+}
+
+int main() {
+	const Curve curve = { 22, { 255, 200, 180 }, 80 };
+	const Curve steep = { 28, { 255, 255, 255 }, 100 };
+	const Curve white = { 10, { 240, 255, 220 }, 100 };
+
+	printf("%-40s %7s %6s %6s\n", "Curve", "Checks", "Error", "Limit");
+
+	check_build("Gamma 2.2, white point, 80%", curve);
+	check_build("Gamma 2.8", steep);
+	check_build("Linear, white point only", white);
+
+	const uint8_t aDefault[3] = { pixellut::defaults::WHITE_POINT, pixellut::defaults::WHITE_POINT, pixellut::defaults::WHITE_POINT };
+	const auto bIdentity = PixelLut::IsIdentity(pixellut::defaults::GAMMA, aDefault, pixellut::defaults::MAX_CURRENT) && !PixelLut::IsIdentity(white.nGamma, white.aWhitePoint, white.nMaxCurrent);
+	result("Defaults need no table", 2, bIdentity ? 0 : 1, 0);
+
+	puts("");
+	printf("%-40s %7s %6s %6s\n", "Frame", "Checks", "Error", "Limit");
+
+	check_rtz("WS2812B linear", pixel::Type::WS2812B, nullptr);
+	check_rtz("WS2812B gamma 2.2, white point, 80%", pixel::Type::WS2812B, &curve);
+	check_rtz("SK6812W gamma 2.2, white point, 80%", pixel::Type::SK6812W, &curve);
+	check_ws2801("WS2801 gamma 2.8", steep);
+	check_apa102("APA102 gamma 2.2, 8 frames average", curve);
+	check_apa102("APA102 gamma 2.8, 8 frames average", steep);
+	check_tlc59711("TLC59711 linear", nullptr, TTLC59711_TYPE_RGB, false);
+	check_tlc59711("TLC59711 gamma 2.2, white point, 80%", &curve, TTLC59711_TYPE_RGB, false);
+	check_tlc59711("TLC59711W gamma 2.2, white point, 80%", &curve, TTLC59711_TYPE_RGBW, false);
+	check_tlc59711("TLC59711 16-bit gamma 2.8", &steep, TTLC59711_TYPE_RGB, true);
+	check_tlc59711("TLC59711W 16-bit gamma 2.2, white point", &curve, TTLC59711_TYPE_RGBW, true);
+
+	puts("");
+
+	PixelLut lut;
+	const auto nBuildStart = nanos();
+	lut.Build(curve.nGamma, curve.aWhitePoint, curve.nMaxCurrent);
+	printf("PixelLut::Build: %.0f us\n", static_cast<double>(nanos() - nBuildStart) / 1000);
+
+	printf("SetPixel, %u pixels, %u frames (host timing)\n", pixel::max::ledcount::RGB, BENCH_FRAMES);
+	printf("%-10s %10s %10s %16s\n", "Type", "Linear", "Curve", "Separate pass");
+
+	const pixel::Type types[] = { pixel::Type::WS2812B, pixel::Type::WS2801, pixel::Type::APA102 };
+
+	for (const auto type : types) {
+		const auto fLinear = bench(type, curve, Path::LINEAR);
+		const auto fFused = bench(type, curve, Path::FUSED);
+		const auto fSeparate = bench(type, curve, Path::SEPARATE);
+		printf("%-10s %7.1f ns %7.1f ns %13.1f ns\n", PixelType::GetType(type), fLinear, fFused, fSeparate);
+	}
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
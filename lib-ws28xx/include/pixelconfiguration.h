@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "pixeltype.h"
+#include "pixellut.h"
 
 class PixelConfiguration {
 public:
@@ -88,6 +89,50 @@ public:
 		return m_nGlobalBrightness;
 	}
 
+	/**
+	 * Colour curve, gamma x 10 (22 is 2.2), white point per colour, max current in percent
+	 */
+	void SetGamma(uint8_t nGamma) {
+		m_nGamma = nGamma;
+	}
+
+	uint8_t GetGamma() const {
+		return m_nGamma;
+	}
+
+	void SetWhitePoint(uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
+		m_aWhitePoint[0] = nRed;
+		m_aWhitePoint[1] = nGreen;
+		m_aWhitePoint[2] = nBlue;
+	}
+
+	const uint8_t *GetWhitePoint() const {
+		return m_aWhitePoint;
+	}
+
+	void SetMaxCurrent(uint8_t nMaxCurrent) {
+		m_nMaxCurrent = nMaxCurrent;
+	}
+
+	uint8_t GetMaxCurrent() const {
+		return m_nMaxCurrent;
+	}
+
+	bool HasLut() const {
+		return !PixelLut::IsIdentity(m_nGamma, m_aWhitePoint, m_nMaxCurrent);
+	}
+
+	/**
+	 * 16-bit per colour input (coarse, fine)
+	 */
+	void Set16Bit(bool b16Bit) {
+		m_b16Bit = b16Bit;
+	}
+
+	bool Is16Bit() const {
+		return m_b16Bit;
+	}
+
 	bool IsRTZProtocol() const {
 		return m_bIsRTZProtocol;
 	}
@@ -107,6 +152,10 @@ private:
 	uint8_t m_nLowCode { 0 };
 	uint8_t m_nHighCode { 0 };
 	uint8_t m_nGlobalBrightness { 0xFF };
+	uint8_t m_nGamma { pixellut::defaults::GAMMA };
+	uint8_t m_aWhitePoint[3] { pixellut::defaults::WHITE_POINT, pixellut::defaults::WHITE_POINT, pixellut::defaults::WHITE_POINT };
+	uint8_t m_nMaxCurrent { pixellut::defaults::MAX_CURRENT };
+	bool m_b16Bit { false };
 	// Calculated
 	bool m_bIsRTZProtocol { true };
 };
@@ -0,0 +1,134 @@
+/**
+ * @file pixeleffects.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELEFFECTS_H_
+#define PIXELEFFECTS_H_
+
+#include <stdint.h>
+
+namespace pixeleffects {
+enum class Effect : uint8_t {
+	NONE, SOLID, GRADIENT, RAINBOW, CHASE, WAVE, COMET, SPARKLE, LAST
+};
+struct Parameters {
+	Effect effect;
+	uint8_t nDimmer;
+	int32_t nSpeed;			///< 1/256 pixel per second, negative is reverse
+	uint32_t nSize;			///< Pixels
+	uint8_t aColour1[3];
+	uint8_t aColour2[3];
+};
+}  // namespace pixeleffects
+
+/**
+ * Renders into a linear RGB buffer, 16-bit per colour.
+ * The positions are in 1/256 pixel, so slow movements are smooth.
+ * The sine and colour wheel are tables, built once.
+ */
+class PixelEffects {
+public:
+	PixelEffects(uint32_t nCount);
+	~PixelEffects();
+
+	void SetParameters(const pixeleffects::Parameters& parameters);
+
+	const pixeleffects::Parameters& GetParameters() const {
+		return m_Parameters;
+	}
+
+	void Render(uint32_t nMillis);
+
+	const uint16_t *GetBuffer() const {
+		return m_pBuffer;
+	}
+
+	uint32_t GetCount() const {
+		return m_nCount;
+	}
+
+	static const char *GetName(pixeleffects::Effect effect);
+
+private:
+	void Solid();
+	void Gradient();
+	void Rainbow();
+	void Chase();
+	void Wave();
+	void Comet();
+	void Sparkle(uint32_t nSteps);
+
+	void Set(uint32_t nIndex, const uint32_t aColour[3]) {
+		auto *p = &m_pBuffer[nIndex * 3];
+		p[0] = static_cast<uint16_t>(aColour[0]);
+		p[1] = static_cast<uint16_t>(aColour[1]);
+		p[2] = static_cast<uint16_t>(aColour[2]);
+	}
+
+	/**
+	 * nFraction 0 is colour 2, 0xFFFF is colour 1
+	 */
+	void Blend(uint32_t nIndex, uint32_t nFraction) {
+		auto *p = &m_pBuffer[nIndex * 3];
+		for (uint32_t i = 0; i < 3; i++) {
+			const auto nDelta = static_cast<int32_t>(m_aColour1[i]) - static_cast<int32_t>(m_aColour2[i]);
+			p[i] = static_cast<uint16_t>(static_cast<int32_t>(m_aColour2[i]) + ((nDelta * static_cast<int32_t>(nFraction >> 1)) >> 15));
+		}
+	}
+
+	/**
+	 * A positive speed moves the pattern to the higher pixel indexes
+	 */
+	uint32_t Position(uint32_t nIndex) const {
+		return (nIndex << 8) - m_nPhase;
+	}
+
+	uint32_t Random() {
+		m_nRandom ^= m_nRandom << 13;
+		m_nRandom ^= m_nRandom >> 17;
+		m_nRandom ^= m_nRandom << 5;
+		return m_nRandom;
+	}
+
+	static void BuildTables();
+
+private:
+	uint16_t *m_pBuffer { nullptr };
+	uint32_t m_nCount;
+	pixeleffects::Parameters m_Parameters;
+	uint32_t m_aColour1[3];		///< Dimmed, 16-bit
+	uint32_t m_aColour2[3];
+	uint32_t m_nPhase { 0 };	///< 1/256 pixel
+	uint32_t m_nPhaseRemainder { 0 };
+	uint32_t m_nSparkle { 0 };
+	uint32_t m_nDimmer { 0 };		///< 0 - 256
+	uint32_t m_nMillis { 0 };
+	uint32_t m_nRandom { 0x12345678 };
+
+	static uint16_t s_Sine[256];
+	static uint16_t s_Wheel[256][3];
+	static bool s_bTables;
+};
+
+#endif /* PIXELEFFECTS_H_ */
@@ -0,0 +1,85 @@
+/**
+ * @file pixellut.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELLUT_H_
+#define PIXELLUT_H_
+
+#include <stdint.h>
+
+namespace pixellut {
+enum class Colour {
+	RED, GREEN, BLUE, WHITE, LAST
+};
+static constexpr uint32_t COLOURS = static_cast<uint32_t>(Colour::LAST);
+namespace defaults {
+static constexpr uint8_t GAMMA = 10;			///< Gamma x 10, 10 is linear
+static constexpr uint8_t WHITE_POINT = 0xFF;
+static constexpr uint8_t MAX_CURRENT = 100;		///< Percent
+}  // namespace defaults
+}  // namespace pixellut
+
+/**
+ * Per colour curve: gamma, white point and dimmer (max current).
+ * The tables are built once, the output stage does a single lookup per colour
+ * while encoding the bits. The 16-bit table is for chips with extra resolution.
+ */
+class PixelLut {
+public:
+	void Build(uint8_t nGamma, const uint8_t aWhitePoint[3], uint8_t nMaxCurrent);
+
+	uint8_t Get(pixellut::Colour colour, uint8_t nValue) const {
+		return m_aLut[static_cast<uint32_t>(colour)][nValue];
+	}
+
+	uint16_t Get16(pixellut::Colour colour, uint8_t nValue) const {
+		return m_aLut16[static_cast<uint32_t>(colour)][nValue];
+	}
+
+	/**
+	 * 16-bit input, linear interpolation between the table entries
+	 */
+	uint16_t Interpolate16(pixellut::Colour colour, uint16_t nValue) const {
+		const auto *pLut = m_aLut16[static_cast<uint32_t>(colour)];
+		const uint32_t nIndex = nValue >> 8;
+		const int32_t nLow = pLut[nIndex];
+		const int32_t nHigh = pLut[nIndex < 255 ? nIndex + 1 : 255];
+
+		return static_cast<uint16_t>(nLow + (((nHigh - nLow) * (nValue & 0xFF)) >> 8));
+	}
+
+	static bool IsIdentity(uint8_t nGamma, const uint8_t aWhitePoint[3], uint8_t nMaxCurrent) {
+		return ((nGamma == 0) || (nGamma == pixellut::defaults::GAMMA))
+				&& (aWhitePoint[0] == pixellut::defaults::WHITE_POINT)
+				&& (aWhitePoint[1] == pixellut::defaults::WHITE_POINT)
+				&& (aWhitePoint[2] == pixellut::defaults::WHITE_POINT)
+				&& ((nMaxCurrent == 0) || (nMaxCurrent >= pixellut::defaults::MAX_CURRENT));
+	}
+
+private:
+	uint8_t m_aLut[pixellut::COLOURS][256];
+	uint16_t m_aLut16[pixellut::COLOURS][256];
+};
+
+#endif /* PIXELLUT_H_ */
@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "pixelconfiguration.h"
+#include "pixellut.h"
 
 #if defined (H3)
 # include "h3_spi.h"
@@ -44,6 +45,25 @@ public:
 	void SetPixel(uint32_t nIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
 	void SetPixel(uint32_t nIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite);
 
+	/**
+	 * 16-bit per colour, requires PixelConfiguration::Set16Bit(true).
+	 * The 8-bit chips get the fraction with temporal error diffusion,
+	 * each Dither() call encodes the next frame from the stored 16-bit values.
+	 */
+	void SetPixel16(uint32_t nIndex, uint16_t nRed, uint16_t nGreen, uint16_t nBlue, uint16_t nWhite = 0);
+	void Dither();
+
+	bool Is16Bit() const {
+		return m_pPixel16 != nullptr;
+	}
+
+	/**
+	 * Time needed for sending a frame, including the reset/latch time
+	 */
+	uint32_t GetFrameMillis() const {
+		return 1 + ((m_nBufSize * 8U * 1000U) / m_nClockSpeedHz);
+	}
+
 #if defined ( H3 )
 	bool IsUpdating () {
 		return h3_spi_dma_tx_is_active();
@@ -76,6 +96,10 @@ public:
 private:
 	void SetupBuffers();
 	void SetColorWS28xx(uint32_t nOffset, uint8_t nValue);
+	void EncodePixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
+	void EncodePixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite);
+	void EncodePixel16(uint32_t nLEDIndex);
+	void SetPixelAPA102(uint32_t nLEDIndex, uint32_t nRed, uint32_t nGreen, uint32_t nBlue);
 
 private:
 	pixel::Type m_Type { pixel::defaults::TYPE };
@@ -89,6 +113,11 @@ private:
 	uint8_t m_nGlobalBrightness { 0xFF };
 	uint8_t *m_pBuffer { nullptr };
 	uint8_t *m_pBlackoutBuffer { nullptr };
+	PixelLut *m_pLut { nullptr };
+	uint32_t m_nFrame { 0 };
+	uint16_t *m_pPixel16 { nullptr };
+	uint8_t *m_pResidual { nullptr };
+	uint32_t m_nApa102Scale[32];
 
 	static WS28xx *s_pThis;
 };
@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "pixelconfiguration.h"
+#include "pixellut.h"
 
 #if defined (H3)
 # include "h3_spi.h"
@@ -53,6 +54,12 @@ public:
 	void Print();
 
 	void SetPixel(uint8_t nPort, uint16_t nIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
+		if (m_pLut != nullptr) {
+			nRed = m_pLut->Get(pixellut::Colour::RED, nRed);
+			nGreen = m_pLut->Get(pixellut::Colour::GREEN, nGreen);
+			nBlue = m_pLut->Get(pixellut::Colour::BLUE, nBlue);
+		}
+
 		if (m_Board == ws28xxmulti::Board::X8) {
 			SetPixel8x(nPort, nIndex, nRed, nGreen, nBlue);
 		} else {
@@ -60,6 +67,13 @@ public:
 		}
 	}
 	void SetPixel(uint8_t nPort, uint16_t nIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite) {
+		if (m_pLut != nullptr) {
+			nRed = m_pLut->Get(pixellut::Colour::RED, nRed);
+			nGreen = m_pLut->Get(pixellut::Colour::GREEN, nGreen);
+			nBlue = m_pLut->Get(pixellut::Colour::BLUE, nBlue);
+			nWhite = m_pLut->Get(pixellut::Colour::WHITE, nWhite);
+		}
+
 		if (m_Board == ws28xxmulti::Board::X8) {
 			SetPixel8x(nPort, nIndex, nRed, nGreen, nBlue, nWhite);
 		} else {
@@ -139,6 +153,7 @@ private:
 	uint8_t *m_pBuffer8x { nullptr };
 	uint8_t *m_pBlackoutBuffer8x { nullptr };
 	JamSTAPLDisplay *m_pJamSTAPLDisplay { nullptr };
+	PixelLut *m_pLut { nullptr };
 
 	static WS28xxMulti *s_pThis;
 };
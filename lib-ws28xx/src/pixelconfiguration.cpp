@@ -145,5 +145,8 @@ void PixelConfiguration::Dump() {
 	if (m_Type == Type::APA102) {
 		printf("GlobalBrightness=%u\n", m_nGlobalBrightness);
 	}
+
+	printf("Gamma=%u, WhitePoint=%u,%u,%u, MaxCurrent=%u\n", m_nGamma, m_aWhitePoint[0], m_aWhitePoint[1], m_aWhitePoint[2], m_nMaxCurrent);
+	printf("16-bit=%s\n", m_b16Bit ? "Yes" : "No");
 #endif
 }
@@ -0,0 +1,284 @@
+/**
+ * @file pixeleffects.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <cassert>
+
+#include "pixeleffects.h"
+
+#include "debug.h"
+
+using namespace pixeleffects;
+
+uint16_t PixelEffects::s_Sine[256];
+uint16_t PixelEffects::s_Wheel[256][3];
+bool PixelEffects::s_bTables;
+
+static constexpr char s_EffectNames[static_cast<uint32_t>(Effect::LAST)][9] = {
+		"None", "Solid", "Gradient", "Rainbow", "Chase", "Wave", "Comet", "Sparkle" };
+
+PixelEffects::PixelEffects(uint32_t nCount) : m_nCount(nCount) {
+	DEBUG_ENTRY
+
+	m_pBuffer = new uint16_t[nCount * 3];
+	assert(m_pBuffer != nullptr);
+	memset(m_pBuffer, 0, nCount * 3 * sizeof(uint16_t));
+
+	BuildTables();
+
+	Parameters parameters;
+	memset(&parameters, 0, sizeof(struct Parameters));
+	SetParameters(parameters);
+
+	DEBUG_EXIT
+}
+
+PixelEffects::~PixelEffects() {
+	delete [] m_pBuffer;
+	m_pBuffer = nullptr;
+}
+
+/*
+ * There is no sin() in the bare-metal libc, the cosine recurrence is accurate enough for 256 steps.
+ * The wheel is the same as PixelPatterns::Wheel, 16-bit.
+ */
+void PixelEffects::BuildTables() {
+	if (s_bTables) {
+		return;
+	}
+
+	constexpr double COS_STEP = 0.99969881869620422012;	// cos(2 * pi / 256)
+	double fPrevious = COS_STEP;	// cos(-step)
+	double fCosine = 1;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		s_Sine[i] = static_cast<uint16_t>(32767.5 * (1 - fCosine) + 0.5);
+		const auto fNext = 2 * COS_STEP * fCosine - fPrevious;
+		fPrevious = fCosine;
+		fCosine = fNext;
+	}
+
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t aWheel[3];
+
+		if (i < 85) {
+			aWheel[0] = 255 - i * 3; aWheel[1] = 0; aWheel[2] = i * 3;
+		} else if (i < 170) {
+			aWheel[0] = 0; aWheel[1] = (i - 85) * 3; aWheel[2] = 255 - (i - 85) * 3;
+		} else {
+			aWheel[0] = (i - 170) * 3; aWheel[1] = 255 - (i - 170) * 3; aWheel[2] = 0;
+		}
+
+		for (uint32_t c = 0; c < 3; c++) {
+			s_Wheel[i][c] = static_cast<uint16_t>(aWheel[c] * 257);
+		}
+	}
+
+	s_bTables = true;
+}
+
+void PixelEffects::SetParameters(const Parameters& parameters) {
+	m_Parameters = parameters;
+
+	if (m_Parameters.nSize == 0) {
+		m_Parameters.nSize = 1;
+	}
+
+	m_nDimmer = m_Parameters.nDimmer + (m_Parameters.nDimmer >> 7U);
+
+	for (uint32_t i = 0; i < 3; i++) {
+		m_aColour1[i] = (m_Parameters.aColour1[i] * 257U * m_nDimmer) >> 8;
+		m_aColour2[i] = (m_Parameters.aColour2[i] * 257U * m_nDimmer) >> 8;
+	}
+}
+
+void PixelEffects::Render(uint32_t nMillis) {
+	auto nElapsed = nMillis - m_nMillis;
+	m_nMillis = nMillis;
+
+	if (nElapsed > 1000) {
+		nElapsed = 1000;
+	}
+
+	const auto nSpeed = static_cast<uint32_t>(m_Parameters.nSpeed < 0 ? -m_Parameters.nSpeed : m_Parameters.nSpeed);
+
+	m_nPhaseRemainder += nSpeed * nElapsed;
+	const auto nSteps = m_nPhaseRemainder / 1000;
+	m_nPhaseRemainder -= nSteps * 1000;
+
+	if (m_Parameters.nSpeed >= 0) {
+		m_nPhase += nSteps;
+	} else {
+		m_nPhase -= nSteps;
+	}
+
+	switch (m_Parameters.effect) {
+	case Effect::SOLID:
+		Solid();
+		break;
+	case Effect::GRADIENT:
+		Gradient();
+		break;
+	case Effect::RAINBOW:
+		Rainbow();
+		break;
+	case Effect::CHASE:
+		Chase();
+		break;
+	case Effect::WAVE:
+		Wave();
+		break;
+	case Effect::COMET:
+		Comet();
+		break;
+	case Effect::SPARKLE:
+		Sparkle(nSteps);
+		break;
+	default:
+		memset(m_pBuffer, 0, m_nCount * 3 * sizeof(uint16_t));
+		break;
+	}
+}
+
+void PixelEffects::Solid() {
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		Set(i, m_aColour1);
+	}
+}
+
+/*
+ * Colour 1 to colour 2 and back, over 2 x size pixels
+ */
+void PixelEffects::Gradient() {
+	const auto nSize = m_Parameters.nSize << 8;
+	const auto nPeriod = nSize * 2;
+
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		const auto nPosition = Position(i) % nPeriod;
+		const auto nDistance = nPosition < nSize ? nPosition : nPeriod - nPosition;
+		const auto nFraction = (nDistance << 8) / m_Parameters.nSize;
+		Blend(i, nFraction > 0xFFFF ? 0xFFFF : nFraction);
+	}
+}
+
+/*
+ * A full colour wheel over size pixels
+ */
+void PixelEffects::Rainbow() {
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		const auto *pWheel = s_Wheel[(Position(i) / m_Parameters.nSize) & 0xFF];
+		auto *p = &m_pBuffer[i * 3];
+		p[0] = static_cast<uint16_t>((pWheel[0] * m_nDimmer) >> 8);
+		p[1] = static_cast<uint16_t>((pWheel[1] * m_nDimmer) >> 8);
+		p[2] = static_cast<uint16_t>((pWheel[2] * m_nDimmer) >> 8);
+	}
+}
+
+/*
+ * Blocks of size pixels, colour 1 and colour 2
+ */
+void PixelEffects::Chase() {
+	const auto nSize = m_Parameters.nSize << 8;
+	const auto nPeriod = nSize * 2;
+
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		Set(i, (Position(i) % nPeriod) < nSize ? m_aColour1 : m_aColour2);
+	}
+}
+
+/*
+ * Sine from colour 2 to colour 1, the wave length is size pixels
+ */
+void PixelEffects::Wave() {
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		Blend(i, s_Sine[(Position(i) / m_Parameters.nSize) & 0xFF]);
+	}
+}
+
+/*
+ * A head in colour 1 running over the strip, with a tail of size pixels fading to colour 2
+ */
+void PixelEffects::Comet() {
+	const auto nLength = m_nCount << 8;
+	const auto nSize = m_Parameters.nSize << 8;
+	const auto nHead = m_nPhase % nLength;
+
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		const auto nPixel = i << 8;
+		uint32_t nDistance;
+
+		if (m_Parameters.nSpeed >= 0) {
+			nDistance = nHead >= nPixel ? nHead - nPixel : nHead + nLength - nPixel;
+		} else {
+			nDistance = nPixel >= nHead ? nPixel - nHead : nPixel + nLength - nHead;
+		}
+
+		if (nDistance >= nSize) {
+			Set(i, m_aColour2);
+			continue;
+		}
+
+		const auto nFraction = 0xFFFF - ((nDistance << 8) / m_Parameters.nSize);
+		Blend(i, (nFraction * nFraction) >> 16);
+	}
+}
+
+/*
+ * The speed sets the sparkles per second, the size sets the decay to colour 2
+ */
+void PixelEffects::Sparkle(uint32_t nSteps) {
+	uint32_t nShift = 1;
+
+	while ((nShift < 8) && ((2U << nShift) <= m_Parameters.nSize)) {
+		nShift++;
+	}
+
+	for (uint32_t i = 0; i < m_nCount * 3; i++) {
+		const auto nTarget = static_cast<int32_t>(m_aColour2[i % 3]);
+		const auto nValue = static_cast<int32_t>(m_pBuffer[i]);
+		m_pBuffer[i] = static_cast<uint16_t>(nValue + ((nTarget - nValue) / (1 << nShift)));
+	}
+
+	m_nSparkle += nSteps;
+	auto nSparkles = m_nSparkle >> 8;
+	m_nSparkle &= 0xFF;
+
+	if (nSparkles > m_nCount) {
+		nSparkles = m_nCount;
+	}
+
+	for (uint32_t i = 0; i < nSparkles; i++) {
+		Set(Random() % m_nCount, m_aColour1);
+	}
+}
+
+const char *PixelEffects::GetName(Effect effect) {
+	if (effect < Effect::LAST) {
+		return s_EffectNames[static_cast<uint32_t>(effect)];
+	}
+
+	return "Unknown";
+}
@@ -0,0 +1,126 @@
+/**
+ * @file pixellut.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "pixellut.h"
+
+#include "debug.h"
+
+using namespace pixellut;
+
+/*
+ * There is no pow() in the bare-metal libc, the tables are built once,
+ * so a series is fast enough.
+ */
+namespace {
+constexpr double LN2 = 0.693147180559945309417;
+
+double Ln(double x) {
+	int32_t nExponent = 0;
+
+	while (x < 0.5) {
+		x *= 2;
+		nExponent--;
+	}
+
+	while (x >= 1.0) {
+		x /= 2;
+		nExponent++;
+	}
+
+	// ln(x) = 2 * atanh((x - 1) / (x + 1)), |z| <= 1/3
+	const auto z = (x - 1) / (x + 1);
+	const auto z2 = z * z;
+	auto fTerm = z;
+	double fSum = 0;
+
+	for (uint32_t k = 1; k < 40; k += 2) {
+		fSum += fTerm / k;
+		fTerm *= z2;
+	}
+
+	return 2 * fSum + nExponent * LN2;
+}
+
+double Exp(double y) {
+	auto n = static_cast<int32_t>(y / LN2 + (y < 0 ? -0.5 : 0.5));
+	const auto r = y - n * LN2;
+
+	double fSum = 1;
+	double fTerm = 1;
+
+	for (uint32_t k = 1; k < 20; k++) {
+		fTerm *= r / k;
+		fSum += fTerm;
+	}
+
+	for (; n > 0; n--) {
+		fSum *= 2;
+	}
+
+	for (; n < 0; n++) {
+		fSum /= 2;
+	}
+
+	return fSum;
+}
+}  // namespace
+
+void PixelLut::Build(uint8_t nGamma, const uint8_t aWhitePoint[3], uint8_t nMaxCurrent) {
+	DEBUG_ENTRY
+
+	if (nGamma == 0) {
+		nGamma = defaults::GAMMA;
+	}
+
+	if ((nMaxCurrent == 0) || (nMaxCurrent > defaults::MAX_CURRENT)) {
+		nMaxCurrent = defaults::MAX_CURRENT;
+	}
+
+	const auto fGamma = static_cast<double>(nGamma) / 10;
+	const auto fMaxCurrent = static_cast<double>(nMaxCurrent) / 100;
+
+	for (uint32_t nColour = 0; nColour < COLOURS; nColour++) {
+		const auto nWhitePoint = (nColour < 3) ? aWhitePoint[nColour] : defaults::WHITE_POINT;
+		const auto fScale = 65535.0 * fMaxCurrent * nWhitePoint / 255;
+
+		m_aLut16[nColour][0] = 0;
+		m_aLut[nColour][0] = 0;
+
+		for (uint32_t nValue = 1; nValue < 256; nValue++) {
+			const auto fValue = Exp(fGamma * Ln(static_cast<double>(nValue) / 255)) * fScale;
+			const auto nValue16 = static_cast<uint32_t>(fValue + 0.5);
+
+			m_aLut16[nColour][nValue] = static_cast<uint16_t>(nValue16 > 0xFFFF ? 0xFFFF : nValue16);
+
+			const auto nValue8 = (nValue16 + 128) / 257;
+			m_aLut[nColour][nValue] = static_cast<uint8_t>(nValue8 > 0xFF ? 0xFF : nValue8);
+		}
+	}
+
+	DEBUG_PRINTF("nGamma=%u, White=%u,%u,%u, nMaxCurrent=%u", nGamma, aWhitePoint[0], aWhitePoint[1], aWhitePoint[2], nMaxCurrent);
+	DEBUG_EXIT
+}
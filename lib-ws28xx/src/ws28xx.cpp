@@ -57,6 +57,33 @@ WS28xx::WS28xx(PixelConfiguration& pixelConfiguration) {
 	m_nHighCode = pixelConfiguration.GetHighCode();
 	m_bIsRTZProtocol = pixelConfiguration.IsRTZProtocol();
 	m_nGlobalBrightness = pixelConfiguration.GetGlobalBrightness();
+	m_nClockSpeedHz = pixelConfiguration.GetClockSpeedHz();
+
+	if (pixelConfiguration.HasLut()) {
+		m_pLut = new PixelLut;
+		assert(m_pLut != nullptr);
+		m_pLut->Build(pixelConfiguration.GetGamma(), pixelConfiguration.GetWhitePoint(), pixelConfiguration.GetMaxCurrent());
+	}
+
+	/*
+	 * APA102 16-bit: 8.8 fixed point (nGlobal << 8) / (257 * nBrightness) scaled by 2^16
+	 */
+	const uint32_t nGlobal = m_nGlobalBrightness & 0x1F;
+	m_nApa102Scale[0] = 0;
+
+	for (uint32_t nBrightness = 1; nBrightness < 32; nBrightness++) {
+		m_nApa102Scale[nBrightness] = (nGlobal << 24) / (257 * nBrightness);
+	}
+
+	if (pixelConfiguration.Is16Bit()) {
+		m_pPixel16 = new uint16_t[m_nCount * 4U];
+		assert(m_pPixel16 != nullptr);
+		memset(m_pPixel16, 0, m_nCount * 4U * sizeof(uint16_t));
+
+		m_pResidual = new uint8_t[m_nCount * 4U];
+		assert(m_pResidual != nullptr);
+		memset(m_pResidual, 0, m_nCount * 4U);
+	}
 
 	if ((m_Type == Type::SK6812W) || (m_Type == Type::APA102)) {
 		m_nBufSize = m_nCount * 4U;
@@ -84,6 +111,21 @@ WS28xx::WS28xx(PixelConfiguration& pixelConfiguration) {
 }
 
 WS28xx::~WS28xx() {
+	if (m_pLut != nullptr) {
+		delete m_pLut;
+		m_pLut = nullptr;
+	}
+
+	if (m_pPixel16 != nullptr) {
+		delete [] m_pPixel16;
+		m_pPixel16 = nullptr;
+	}
+
+	if (m_pResidual != nullptr) {
+		delete [] m_pResidual;
+		m_pResidual = nullptr;
+	}
+
 #if defined( H3 )
 	m_pBlackoutBuffer = nullptr;
 	m_pBuffer = nullptr;
@@ -156,6 +198,8 @@ void WS28xx::SetupBuffers() {
 
 void WS28xx::Update() {
 	assert (m_pBuffer != nullptr);
+	m_nFrame++;
+
 #if defined( H3 )
 	assert(!IsUpdating());
 
@@ -180,6 +224,8 @@ void WS28xx::Print() {
 	printf("Pixel parameters\n");
 	printf(" Type    : %s [%d]\n", PixelType::GetType(m_Type), static_cast<int>(m_Type));
 	printf(" Count   : %d\n", m_nCount);
+	printf(" Curve   : %s\n", m_pLut != nullptr ? "Yes" : "Linear");
+	printf(" Input   : %s\n", m_pPixel16 != nullptr ? "16-bit" : "8-bit");
 	if (m_bIsRTZProtocol) {
 		printf(" Mapping : %s [%d]\n", PixelType::GetMap(m_Map), static_cast<int>(m_Map));
 		printf(" T0H     : %.2f [0x%X]\n", PixelType::ConvertTxH(m_nLowCode), m_nLowCode);
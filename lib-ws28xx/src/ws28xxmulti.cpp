@@ -54,6 +54,12 @@ WS28xxMulti::WS28xxMulti(PixelConfiguration& pixelConfiguration) {
 	m_Map = pixelConfiguration.GetMap();
 	m_nBufSize = m_nCount * nLedsPerPixel * 8;
 
+	if (pixelConfiguration.HasLut()) {
+		m_pLut = new PixelLut;
+		assert(m_pLut != nullptr);
+		m_pLut->Build(pixelConfiguration.GetGamma(), pixelConfiguration.GetWhitePoint(), pixelConfiguration.GetMaxCurrent());
+	}
+
 	DEBUG_PRINTF("m_nBufSize=%d", m_nBufSize);
 
 	m_Board = GetBoard();
@@ -80,6 +86,11 @@ WS28xxMulti::WS28xxMulti(PixelConfiguration& pixelConfiguration) {
 }
 
 WS28xxMulti::~WS28xxMulti() {
+	if (m_pLut != nullptr) {
+		delete m_pLut;
+		m_pLut = nullptr;
+	}
+
 	if (m_Board == Board::X4) {
 		delete[] m_pBlackoutBuffer4x;
 		m_pBlackoutBuffer4x = nullptr;
@@ -98,6 +109,7 @@ void WS28xxMulti::Print() {
 	printf("Pixel parameters\n");
 	printf(" Type    : %s [%d] - %s [%d]\n", PixelType::GetType(m_Type), static_cast<int>(m_Type), PixelType::GetMap(m_Map), static_cast<int>(m_Map));
 	printf(" Count   : %d\n", m_nCount);
+	printf(" Curve   : %s\n", m_pLut != nullptr ? "Yes" : "Linear");
 //	printf(" T0H     : %.2f [0x%X]\n", WS28xx::ConvertTxH(pixelConfiguration.GetLowCode()), pixelConfiguration.GetLowCode());
 //	printf(" T1H     : %.2f [0x%X]\n", WS28xx::ConvertTxH(pixelConfiguration.GetHighCode()), pixelConfiguration.GetHighCode());
 	printf(" Board   : %dx\n", m_Board == ws28xxmulti::Board::X4 ? 4 : 8);
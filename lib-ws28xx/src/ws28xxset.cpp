@@ -27,13 +27,35 @@
 #include <cassert>
 
 #include "ws28xx.h"
+#include "pixellut.h"
 
 using namespace pixel;
+using pixellut::Colour;
+
+/*
+ * Ordered temporal dither, the offset is added to the 8.8 fixed point value
+ */
+static constexpr uint8_t s_Dither[8] = { 16, 144, 80, 208, 48, 176, 112, 240 };
 
 void WS28xx::SetPixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
 	assert(m_pBuffer != nullptr);
 	assert(nLEDIndex < m_nCount);
 
+	if (m_pLut != nullptr) {
+		if (m_Type == Type::APA102) {
+			SetPixelAPA102(nLEDIndex, m_pLut->Get16(Colour::RED, nRed), m_pLut->Get16(Colour::GREEN, nGreen), m_pLut->Get16(Colour::BLUE, nBlue));
+			return;
+		}
+
+		nRed = m_pLut->Get(Colour::RED, nRed);
+		nGreen = m_pLut->Get(Colour::GREEN, nGreen);
+		nBlue = m_pLut->Get(Colour::BLUE, nBlue);
+	}
+
+	EncodePixel(nLEDIndex, nRed, nGreen, nBlue);
+}
+
+void WS28xx::EncodePixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
 	if (__builtin_expect((m_bIsRTZProtocol), 1)) {
 		uint32_t nOffset = nLEDIndex * 3;
 		nOffset *= 8;
@@ -122,6 +144,17 @@ void WS28xx::SetPixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t
 	assert(nLEDIndex < m_nCount);
 	assert(m_Type == Type::SK6812W);
 
+	if (m_pLut != nullptr) {
+		nRed = m_pLut->Get(Colour::RED, nRed);
+		nGreen = m_pLut->Get(Colour::GREEN, nGreen);
+		nBlue = m_pLut->Get(Colour::BLUE, nBlue);
+		nWhite = m_pLut->Get(Colour::WHITE, nWhite);
+	}
+
+	EncodePixel(nLEDIndex, nRed, nGreen, nBlue, nWhite);
+}
+
+void WS28xx::EncodePixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite) {
 	uint32_t nOffset = nLEDIndex * 4;
 
 	if (m_Type == Type::SK6812W) {
@@ -134,6 +167,65 @@ void WS28xx::SetPixel(uint32_t nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t
 	}
 }
 
+void WS28xx::SetPixel16(uint32_t nLEDIndex, uint16_t nRed, uint16_t nGreen, uint16_t nBlue, uint16_t nWhite) {
+	assert(m_pPixel16 != nullptr);
+	assert(nLEDIndex < m_nCount);
+
+	auto *pPixel16 = &m_pPixel16[nLEDIndex * 4];
+
+	if (m_pLut != nullptr) {
+		pPixel16[0] = m_pLut->Interpolate16(Colour::RED, nRed);
+		pPixel16[1] = m_pLut->Interpolate16(Colour::GREEN, nGreen);
+		pPixel16[2] = m_pLut->Interpolate16(Colour::BLUE, nBlue);
+		pPixel16[3] = m_pLut->Interpolate16(Colour::WHITE, nWhite);
+	} else {
+		pPixel16[0] = nRed;
+		pPixel16[1] = nGreen;
+		pPixel16[2] = nBlue;
+		pPixel16[3] = nWhite;
+	}
+
+	EncodePixel16(nLEDIndex);
+}
+
+void WS28xx::Dither() {
+	assert(m_pPixel16 != nullptr);
+
+	for (uint32_t nLEDIndex = 0; nLEDIndex < m_nCount; nLEDIndex++) {
+		EncodePixel16(nLEDIndex);
+	}
+}
+
+/*
+ * Temporal error diffusion: the part below the 8-bit step is carried to the next frame
+ * of the same LED. Over the frames the average output is the 16-bit value.
+ */
+void WS28xx::EncodePixel16(uint32_t nLEDIndex) {
+	const auto *pPixel16 = &m_pPixel16[nLEDIndex * 4];
+
+	if (m_Type == Type::APA102) {
+		SetPixelAPA102(nLEDIndex, pPixel16[0], pPixel16[1], pPixel16[2]);
+		return;
+	}
+
+	auto *pResidual = &m_pResidual[nLEDIndex * 4];
+	uint8_t aValue[4];
+
+	for (uint32_t i = 0; i < 4; i++) {
+		// 0xFFFF maps to 0xFF00, 8.8 fixed point
+		const uint32_t nValue16 = pPixel16[i];
+		const uint32_t nValue = nValue16 - (nValue16 >> 8) + pResidual[i];
+		aValue[i] = static_cast<uint8_t>(nValue >> 8);
+		pResidual[i] = static_cast<uint8_t>(nValue);
+	}
+
+	if (m_Type == Type::SK6812W) {
+		EncodePixel(nLEDIndex, aValue[0], aValue[1], aValue[2], aValue[3]);
+	} else {
+		EncodePixel(nLEDIndex, aValue[0], aValue[1], aValue[2]);
+	}
+}
+
 void WS28xx::SetColorWS28xx(uint32_t nOffset, uint8_t nValue) {
 	assert(m_Type != Type::WS2801);
 	assert(nOffset + 7 < m_nBufSize);
@@ -147,3 +239,29 @@ void WS28xx::SetColorWS28xx(uint32_t nOffset, uint8_t nValue) {
 		nOffset++;
 	}
 }
+
+/*
+ * 16-bit input: the 5-bit global brightness of each LED is set as low as possible,
+ * so the 8-bit PWM values keep the low-end resolution. The remaining fraction is dithered over the frames.
+ * The divisions by the brightness are a multiply with m_nApa102Scale, there is no branch:
+ * black gives brightness 0 with scale 0, and the scaled value plus dither never exceeds 0xFF.
+ */
+void WS28xx::SetPixelAPA102(uint32_t nLEDIndex, uint32_t nRed, uint32_t nGreen, uint32_t nBlue) {
+	const uint32_t nOffset = 4 + (nLEDIndex * 4);
+	assert(nOffset + 3 < m_nBufSize);
+
+	const uint32_t nGlobal = m_nGlobalBrightness & 0x1F;
+	auto nMax = nRed > nGreen ? nRed : nGreen;
+	nMax = nMax > nBlue ? nMax : nBlue;
+
+	// ceil(nMax * nGlobal / 65535)
+	const auto nRounded = nMax * nGlobal + 65534;
+	const auto nBrightness = (nRounded + (nRounded >> 16) + 1) >> 16;
+	const auto nScale = static_cast<uint64_t>(m_nApa102Scale[nBrightness]);
+	const auto nDither = s_Dither[(m_nFrame + nLEDIndex) & 0x7];
+
+	m_pBuffer[nOffset] = static_cast<uint8_t>(0xE0 | nBrightness);
+	m_pBuffer[nOffset + 1] = static_cast<uint8_t>((static_cast<uint32_t>((nRed * nScale) >> 16) + nDither) >> 8);
+	m_pBuffer[nOffset + 2] = static_cast<uint8_t>((static_cast<uint32_t>((nGreen * nScale) >> 16) + nDither) >> 8);
+	m_pBuffer[nOffset + 3] = static_cast<uint8_t>((static_cast<uint32_t>((nBlue * nScale) >> 16) + nDither) >> 8);
+}
@@ -0,0 +1,351 @@
+/**
+ * @file ditherbench.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Drives WS28xxDmx with the 16-bit RGB personality (6 channels per pixel)
+ * on a simulated millisecond clock. 341 WS2812B pixels fill 4 universes,
+ * pixels cross the universe boundaries.
+ * Each frame written to the SPI is decoded. The 8-bit values averaged over
+ * N frames must be the 16-bit DMX value within 257/N, the bound of the
+ * error diffusion. The dithered frames must fit in between the DMX frames
+ * and continue when the input pauses.
+ * Then the time per DMX frame (16-bit and 8-bit) and per dithered frame is measured.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "bcm2835.h"
+
+#include "ws28xxdmx.h"
+#include "ws28xx.h"
+#include "pixeldmxconfiguration.h"
+#include "lightset.h"
+#include "hardware.h"
+
+using lightset::Dmx;
+
+static constexpr uint32_t COUNT = 341;
+static constexpr uint32_t CHANNELS = 4 * Dmx::UNIVERSE_SIZE;
+static constexpr uint32_t BENCH_FRAMES = 200;
+
+/*
+ * Hardware, the clock is simulated
+ */
+
+static uint32_t s_nNowMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nNowMillis;
+}
+
+uint32_t Hardware::Micros() {
+	return s_nNowMillis * 1000U;
+}
+
+/*
+ * SPI, the WS2812B (GRB) frames are decoded and added up per colour
+ */
+
+static uint32_t s_nWrites;
+static uint32_t s_nLastWriteMillis;
+static bool s_bAccumulate;
+static std::vector<uint32_t> s_Sum(COUNT * 3);
+
+void bcm2835_spi_begin() {
+}
+
+void bcm2835_spi_chipSelect(__attribute__((unused)) uint8_t nChipSelect) {
+}
+
+void bcm2835_spi_set_speed_hz(__attribute__((unused)) uint32_t nSpeedHz) {
+}
+
+void bcm2835_spi_setDataMode(__attribute__((unused)) uint8_t nMode) {
+}
+
+void bcm2835_spi_transfern(__attribute__((unused)) char *pBuffer, __attribute__((unused)) uint32_t nLength) {
+}
+
+void bcm2835_spi_writenb(const char *pBuffer, uint32_t nLength) {
+	s_nWrites++;
+	s_nLastWriteMillis = s_nNowMillis;
+
+	if (!s_bAccumulate) {
+		return;
+	}
+
+	const auto *pFrame = reinterpret_cast<const uint8_t *>(pBuffer);
+	const uint32_t aOrder[3] = { 1, 0, 2 };	// GRB
+
+	for (uint32_t i = 0; (i < COUNT) && ((i + 1) * 24 <= nLength); i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			const auto *p = &pFrame[(i * 3 + c) * 8];
+			uint32_t nValue = 0;
+
+			for (uint32_t nBit = 0; nBit < 8; nBit++) {
+				nValue = (nValue << 1) | (p[nBit] > 0xC0 ? 1 : 0);
+			}
+
+			s_Sum[i * 3 + aOrder[c]] += nValue;
+		}
+	}
+}
+
+void bcm2835_spi_write(__attribute__((unused)) uint16_t nData) {
+}
+
+void bcm2835_delayMicroseconds(__attribute__((unused)) uint64_t nMicros) {
+}
+
+/*
+ * Test
+ */
+
+static uint32_t s_nFailed;
+static uint8_t s_Channels[CHANNELS];
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void result(const char *pName, uint32_t nValue, uint32_t nLimit, bool bAtLeast = false) {
+	const auto bPass = bAtLeast ? (nValue >= nLimit) : (nValue <= nLimit);
+	printf("%-44s %7u %s%6u  %s\n", pName, nValue, bAtLeast ? ">=" : "<=", nLimit, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+static void fill(uint32_t nSeed, uint32_t nFirst, uint32_t nLast) {
+	for (uint32_t i = nFirst; i < nLast; i++) {
+		const auto nPixel = i / 6;
+		const auto nColour = (i % 6) / 2;
+		// Mostly low levels, where 8-bit has no resolution
+		const auto nValue = static_cast<uint16_t>(((nPixel * 977U + nColour * 20011U + nSeed) & 0x0FFF) << (nColour == 2 ? 4 : 0));
+		s_Channels[i] = static_cast<uint8_t>((i & 1) == 0 ? nValue >> 8 : nValue);
+	}
+}
+
+static void send(WS28xxDmx& dmx, uint32_t nPortFirst, uint32_t nPortLast) {
+	for (uint32_t nPort = nPortFirst; nPort <= nPortLast; nPort++) {
+		dmx.SetData(static_cast<uint8_t>(nPort), &s_Channels[nPort * Dmx::UNIVERSE_SIZE], Dmx::UNIVERSE_SIZE);
+	}
+}
+
+/**
+ * Runs the dithering with the DMX input paused, until nFrames are written.
+ * Returns the maximum error, in 16-bit units, of the average against the DMX values.
+ */
+static uint32_t average_error(WS28xxDmx& dmx, uint32_t nFrames) {
+	for (auto& nSum : s_Sum) {
+		nSum = 0;
+	}
+
+	const auto nWrites = s_nWrites;
+	s_bAccumulate = true;
+
+	while ((s_nWrites - nWrites) < nFrames) {
+		s_nNowMillis++;
+		dmx.Run();
+	}
+
+	s_bAccumulate = false;
+
+	uint32_t nError = 0;
+
+	for (uint32_t i = 0; i < COUNT; i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			const auto *p = &s_Channels[i * 6 + c * 2];
+			const auto nExpected = static_cast<double>((p[0] << 8) | p[1]);
+			const auto fAverage = static_cast<double>(s_Sum[i * 3 + c]) * 257 / nFrames;
+			const auto fDiff = fAverage > nExpected ? fAverage - nExpected : nExpected - fAverage;
+			const auto nDiff = static_cast<uint32_t>(fDiff);
+
+			nError = nDiff > nError ? nDiff : nError;
+		}
+	}
+
+	return nError;
+}
+
+static void configure(PixelDmxConfiguration& config, uint32_t nCount, bool b16Bit) {
+	config.SetType(pixel::Type::WS2812B);
+	config.SetCount(static_cast<uint16_t>(nCount));
+	config.Set16Bit(b16Bit);
+}
+
+/**
+ * DMX frames every nIntervalMillis, minus up to nJitterMillis, for nMillis.
+ * A DMX frame is late when a dithered frame is still being sent.
+ */
+static void pacing(const char *pName, WS28xxDmx& dmx, uint32_t nIntervalMillis, uint32_t nJitterMillis, uint32_t nMillis, uint32_t nLateLimit) {
+	const auto nFrameMillis = WS28xx::Get()->GetFrameMillis();
+	uint32_t nDmxFrames = 0;
+	uint32_t nDitherFrames = 0;
+	uint32_t nLate = 0;
+
+	const auto nEnd = s_nNowMillis + nMillis;
+	auto nNextDmx = s_nNowMillis + nIntervalMillis;
+
+	while (s_nNowMillis < nEnd) {
+		s_nNowMillis++;
+
+		if (s_nNowMillis == nNextDmx) {
+			if ((s_nNowMillis - s_nLastWriteMillis) < nFrameMillis) {
+				nLate++;
+			}
+
+			fill(s_nNowMillis, 0, CHANNELS);
+			send(dmx, 0, 3);
+			nDmxFrames++;
+			nNextDmx += nIntervalMillis - ((nDmxFrames * 7) % (nJitterMillis + 1));
+			continue;
+		}
+
+		const auto nWrites = s_nWrites;
+		dmx.Run();
+		nDitherFrames += (s_nWrites - nWrites);
+	}
+
+	// A dithered frame every nFrameMillis after the DMX frame, when it ends before the next one
+	const auto nExpected = nDmxFrames * ((nIntervalMillis - nJitterMillis) / nFrameMillis - 1);
+
+	char aName[64];
+	snprintf(aName, sizeof(aName), "%s, late frames", pName);
+	result(aName, nLate, nLateLimit);
+	snprintf(aName, sizeof(aName), "%s, dithered frames", pName);
+	result(aName, nDitherFrames, nExpected, true);
+}
+
+static double bench_dmx(bool b16Bit) {
+	PixelDmxConfiguration config;
+	configure(config, b16Bit ? COUNT : 4 * 170, b16Bit);
+
+	WS28xxDmx dmx(config);
+	dmx.Start();
+
+	const auto nStart = nanos();
+
+	for (uint32_t nFrame = 0; nFrame < BENCH_FRAMES; nFrame++) {
+		s_Channels[nFrame % CHANNELS]++;
+		send(dmx, 0, 3);
+	}
+
+	return static_cast<double>(nanos() - nStart) / (1000.0 * BENCH_FRAMES);
+}
+
+static double bench_dither() {
+	PixelDmxConfiguration config;
+	configure(config, COUNT, true);
+
+	WS28xxDmx dmx(config);
+	dmx.Start();
+	send(dmx, 0, 3);
+
+	auto *pWS28xx = WS28xx::Get();
+	const auto nStart = nanos();
+
+	for (uint32_t nFrame = 0; nFrame < BENCH_FRAMES; nFrame++) {
+		pWS28xx->Dither();
+	}
+
+	return static_cast<double>(nanos() - nStart) / (1000.0 * BENCH_FRAMES);
+}
+
+int main() {
+	Hardware hw;
+
+	PixelDmxConfiguration config;
+	configure(config, COUNT, true);
+
+	{
+		WS28xxDmx dmx(config);
+		dmx.Start();
+
+		printf("%u pixels, %u universes, frame %u ms\n\n", COUNT, dmx.GetUniverses(), WS28xx::Get()->GetFrameMillis());
+		printf("%-44s %7s %8s\n", "Check", "Value", "Limit");
+
+		fill(0, 0, CHANNELS);
+		send(dmx, 0, 3);
+
+		const uint32_t aFrames[] = { 4, 16, 64, 256 };
+
+		for (const auto nFrames : aFrames) {
+			char aName[64];
+			snprintf(aName, sizeof(aName), "Average of %u frames, error", nFrames);
+			result(aName, average_error(dmx, nFrames), 257 / nFrames + 1);
+		}
+
+		// Only the second universe changes, the pixel across the boundary with the first one too
+		fill(7, Dmx::UNIVERSE_SIZE, 2 * Dmx::UNIVERSE_SIZE);
+		send(dmx, 1, 1);
+		result("Universe 2 only, average of 256 frames", average_error(dmx, 256), 2);
+
+		// The coarse byte only, as an 8-bit personality would show it
+		uint32_t nError8 = 0;
+		for (uint32_t i = 0; i < COUNT * 6; i += 2) {
+			const auto nValue = static_cast<int32_t>((s_Channels[i] << 8) | s_Channels[i + 1]);
+			const auto nDiff = static_cast<uint32_t>(abs(nValue - s_Channels[i] * 257));
+			nError8 = nDiff > nError8 ? nDiff : nError8;
+		}
+		printf("%-44s %7u\n", "Coarse byte only (8-bit), error", nError8);
+
+		puts("");
+		// The first frame after a pause, or at a higher rate, cannot be foreseen
+		pacing("DMX at 25 Hz, after a pause", dmx, 40, 0, 4000, 1);
+		pacing("DMX at 25 Hz, 3 ms jitter", dmx, 40, 3, 4000, 0);
+		pacing("DMX at 44 Hz", dmx, 23, 0, 4000, 1);
+
+		// No dithering while the next DMX frame is expected, at most 2 intervals
+		const auto nWrites = s_nWrites;
+		for (uint32_t i = 0; i < 1000; i++) {
+			s_nNowMillis++;
+			dmx.Run();
+		}
+		result("DMX paused 1 s, dithered frames", s_nWrites - nWrites, (1000 - 2 * 23) / WS28xx::Get()->GetFrameMillis(), true);
+	}
+
+	puts("");
+	printf("Host timing, %u frames\n", BENCH_FRAMES);
+	printf(" SetData 4 universes, 8-bit, 680 pixels  : %7.2f us\n", bench_dmx(false));
+	printf(" SetData 4 universes, 16-bit, 341 pixels : %7.2f us\n", bench_dmx(true));
+	printf(" Dither, 341 pixels                       : %7.2f us\n", bench_dither());
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
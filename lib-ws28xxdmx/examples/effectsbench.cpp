@@ -0,0 +1,478 @@
+/**
+ * @file effectsbench.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Drives PixelEffectsDmx with its 10 channels, on a simulated millisecond clock,
+ * into 300 WS2812B pixels. Each frame written to the SPI is decoded.
+ * With the speed at stop, the frames are compared with a reference computed
+ * with sin() and the colour wheel. With a speed, a frame must be the earlier
+ * frame moved by speed x time pixels, in the direction set.
+ * Then the render time per pixel of each effect is measured, and the time per
+ * frame of the effects against PixelPatterns, which sets each pixel with SetPixel.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "bcm2835.h"
+
+#include "pixeleffectsdmx.h"
+#include "pixeleffects.h"
+#include "pixelpatterns.h"
+#include "ws28xx.h"
+#include "pixelconfiguration.h"
+#include "hardware.h"
+
+using pixeleffects::Effect;
+using namespace pixeleffectsdmx;
+
+static constexpr uint32_t COUNT = 300;
+static constexpr uint32_t BENCH_COUNT = 4096;
+static constexpr uint32_t BENCH_FRAMES = 200;
+
+/*
+ * Hardware, the clock is simulated
+ */
+
+static uint32_t s_nNowMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nNowMillis;
+}
+
+uint32_t Hardware::Micros() {
+	return s_nNowMillis * 1000U;
+}
+
+/*
+ * SPI, the last WS2812B (GRB) frame is decoded into RGB
+ */
+
+static std::vector<uint8_t> s_Frame(COUNT * 3);
+
+void bcm2835_spi_begin() {
+}
+
+void bcm2835_spi_chipSelect(__attribute__((unused)) uint8_t nChipSelect) {
+}
+
+void bcm2835_spi_set_speed_hz(__attribute__((unused)) uint32_t nSpeedHz) {
+}
+
+void bcm2835_spi_setDataMode(__attribute__((unused)) uint8_t nMode) {
+}
+
+void bcm2835_spi_transfern(__attribute__((unused)) char *pBuffer, __attribute__((unused)) uint32_t nLength) {
+}
+
+void bcm2835_spi_writenb(const char *pBuffer, uint32_t nLength) {
+	const auto *pFrame = reinterpret_cast<const uint8_t *>(pBuffer);
+	const uint32_t aOrder[3] = { 1, 0, 2 };	// GRB
+
+	for (uint32_t i = 0; (i < COUNT) && ((i + 1) * 24 <= nLength); i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			const auto *p = &pFrame[(i * 3 + c) * 8];
+			uint32_t nValue = 0;
+
+			for (uint32_t nBit = 0; nBit < 8; nBit++) {
+				nValue = (nValue << 1) | (p[nBit] > 0xC0 ? 1 : 0);
+			}
+
+			s_Frame[i * 3 + aOrder[c]] = static_cast<uint8_t>(nValue);
+		}
+	}
+}
+
+void bcm2835_spi_write(__attribute__((unused)) uint16_t nData) {
+}
+
+void bcm2835_delayMicroseconds(__attribute__((unused)) uint64_t nMicros) {
+}
+
+/*
+ * Test
+ */
+
+static uint32_t s_nFailed;
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void result(const char *pName, uint32_t nErrors, uint32_t nLimit = 0) {
+	const auto bPass = (nErrors <= nLimit);
+	printf("%-44s %7u %6u  %s\n", pName, nErrors, nLimit, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+struct Fixture {
+	Effect effect;
+	uint8_t nDimmer;
+	uint8_t nSpeed;
+	uint8_t nSize;
+	uint8_t aColour1[3];
+	uint8_t aColour2[3];
+};
+
+static constexpr uint16_t START_ADDRESS = 100;
+
+/**
+ * Runs the fixture from 0 until nMillis, the DMX frame is sent every 25 ms
+ */
+static void run(PixelEffectsDmx& effects, const Fixture& fixture, uint32_t nMillis) {
+	uint8_t aDmx[lightset::Dmx::UNIVERSE_SIZE];
+	memset(aDmx, 0, sizeof(aDmx));
+
+	auto *p = &aDmx[START_ADDRESS - 1];
+	p[slot::EFFECT] = static_cast<uint8_t>(static_cast<uint32_t>(fixture.effect) * 32 + 16);
+	p[slot::DIMMER] = fixture.nDimmer;
+	p[slot::SPEED] = fixture.nSpeed;
+	p[slot::SIZE] = fixture.nSize;
+	memcpy(&p[slot::COLOUR1], fixture.aColour1, 3);
+	memcpy(&p[slot::COLOUR2], fixture.aColour2, 3);
+
+	while (s_nNowMillis < nMillis) {
+		s_nNowMillis++;
+
+		if ((s_nNowMillis % 25) == 0) {
+			effects.SetData(0, aDmx, lightset::Dmx::UNIVERSE_SIZE);
+		}
+
+		effects.Run();
+	}
+}
+
+/**
+ * Each scenario starts with a new fixture at time 0, so the pattern starts at position 0
+ */
+static PixelEffectsDmx *create() {
+	s_nNowMillis = 0;
+
+	auto *pEffects = new PixelEffectsDmx;
+	pEffects->SetDmxStartAddress(START_ADDRESS);
+	pEffects->Start();
+
+	return pEffects;
+}
+
+/**
+ * The size in pixels for the size channel, as PixelEffectsDmx::SetData
+ */
+static uint32_t size(uint8_t nSize) {
+	return 1 + ((static_cast<uint32_t>(nSize) * nSize) >> 6);
+}
+
+static uint32_t difference(double fExpected, uint8_t nValue) {
+	const auto fDiff = fabs(fExpected - nValue);
+	return fDiff > 1.0 ? static_cast<uint32_t>(fDiff) : 0;
+}
+
+static uint32_t compare(double (*pReference)(const Fixture&, uint32_t, uint32_t), const Fixture& fixture) {
+	uint32_t nErrors = 0;
+
+	for (uint32_t i = 0; i < COUNT; i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			if (difference(pReference(fixture, i, c), s_Frame[i * 3 + c]) != 0) {
+				nErrors++;
+			}
+		}
+	}
+
+	return nErrors;
+}
+
+static double mix(const Fixture& fixture, uint32_t c, double fFraction) {
+	const auto nDimmer = fixture.nDimmer + (fixture.nDimmer >> 7);
+	const auto fColour1 = fixture.aColour1[c] * 257.0 * nDimmer / 256;
+	const auto fColour2 = fixture.aColour2[c] * 257.0 * nDimmer / 256;
+	return (fColour2 + (fColour1 - fColour2) * fFraction) / 256;
+}
+
+static double solid(const Fixture& fixture, __attribute__((unused)) uint32_t i, uint32_t c) {
+	return mix(fixture, c, 1);
+}
+
+static double gradient(const Fixture& fixture, uint32_t i, uint32_t c) {
+	const auto nSize = size(fixture.nSize);
+	const auto nPosition = i % (2 * nSize);
+	const auto nDistance = nPosition < nSize ? nPosition : 2 * nSize - nPosition;
+	return mix(fixture, c, static_cast<double>(nDistance) / nSize);
+}
+
+static double wave(const Fixture& fixture, uint32_t i, uint32_t c) {
+	const auto nIndex = ((i << 8) / size(fixture.nSize)) & 0xFF;
+	return mix(fixture, c, (1 - cos(2 * M_PI * nIndex / 256)) / 2);
+}
+
+static double rainbow(__attribute__((unused)) const Fixture& fixture, uint32_t i, uint32_t c) {
+	const auto nIndex = ((i << 8) / size(fixture.nSize)) & 0xFF;
+	uint32_t aWheel[3];
+
+	if (nIndex < 85) {
+		aWheel[0] = 255 - nIndex * 3; aWheel[1] = 0; aWheel[2] = nIndex * 3;
+	} else if (nIndex < 170) {
+		aWheel[0] = 0; aWheel[1] = (nIndex - 85) * 3; aWheel[2] = 255 - (nIndex - 85) * 3;
+	} else {
+		aWheel[0] = (nIndex - 170) * 3; aWheel[1] = 255 - (nIndex - 170) * 3; aWheel[2] = 0;
+	}
+
+	return aWheel[c];
+}
+
+/**
+ * The head is on pixel 0, the tail runs back over the end of the strip
+ */
+static double comet(const Fixture& fixture, uint32_t i, uint32_t c) {
+	const auto nSize = size(fixture.nSize);
+	const auto nDistance = (i == 0) ? 0 : COUNT - i;
+
+	if (nDistance >= nSize) {
+		return mix(fixture, c, 0);
+	}
+
+	const auto fFraction = 1 - static_cast<double>(nDistance) / nSize;
+	return mix(fixture, c, fFraction * fFraction);
+}
+
+static void check_reference(const char *pName, const Fixture& fixture, double (*pReference)(const Fixture&, uint32_t, uint32_t)) {
+	auto *pEffects = create();
+	run(*pEffects, fixture, 500);
+	result(pName, compare(pReference, fixture));
+	delete pEffects;
+}
+
+/**
+ * The frame at 1500 ms must be the frame at 1000 ms moved by nShift pixels
+ */
+static void check_movement(const char *pName, const Fixture& fixture, int32_t nShift) {
+	auto *pEffects = create();
+	run(*pEffects, fixture, 1000);
+	const auto before = s_Frame;
+	run(*pEffects, fixture, 1500);
+
+	uint32_t nErrors = 0;
+	uint32_t nChecks = 0;
+
+	for (int32_t i = 0; i < static_cast<int32_t>(COUNT); i++) {
+		const auto j = i - nShift;
+
+		if ((j < 0) || (j >= static_cast<int32_t>(COUNT))) {
+			continue;
+		}
+
+		nChecks++;
+
+		if (memcmp(&s_Frame[static_cast<uint32_t>(i) * 3], &before[static_cast<uint32_t>(j) * 3], 3) != 0) {
+			nErrors++;
+		}
+	}
+
+	const auto bMoved = (nShift == 0) || (before != s_Frame);
+	result(pName, nErrors + (bMoved ? 0 : nChecks) + (nChecks == 0 ? 1 : 0));
+	delete pEffects;
+}
+
+/**
+ * Chase: only the two colours, in blocks of size pixels
+ */
+static void check_chase(const char *pName, const Fixture& fixture) {
+	auto *pEffects = create();
+	run(*pEffects, fixture, 500);
+
+	const auto nSize = size(fixture.nSize);
+	uint32_t nErrors = 0;
+	uint32_t nRun = 0;
+	bool bFirst = true;
+
+	for (uint32_t i = 0; i < COUNT; i++) {
+		const auto bColour1 = (memcmp(&s_Frame[i * 3], fixture.aColour1, 3) == 0);
+		const auto bColour2 = (memcmp(&s_Frame[i * 3], fixture.aColour2, 3) == 0);
+
+		if (!bColour1 && !bColour2) {
+			nErrors++;
+		}
+
+		const auto bSame = (i != 0) && (memcmp(&s_Frame[i * 3], &s_Frame[(i - 1) * 3], 3) == 0);
+
+		if (!bSame && (i != 0)) {
+			// A block ends, the first one can be cut by the strip start
+			if (!bFirst && (nRun != nSize)) {
+				nErrors++;
+			}
+			bFirst = false;
+			nRun = 0;
+		}
+
+		nRun++;
+	}
+
+	result(pName, nErrors);
+	delete pEffects;
+}
+
+/**
+ * Sparkle: the pixels are colour 1 or on the way to colour 2
+ */
+static void check_sparkle(const char *pName, const Fixture& fixture) {
+	auto *pEffects = create();
+	run(*pEffects, fixture, 3000);
+
+	uint32_t nErrors = 0;
+	uint32_t nSparkles = 0;
+
+	for (uint32_t i = 0; i < COUNT; i++) {
+		if (memcmp(&s_Frame[i * 3], fixture.aColour1, 3) == 0) {
+			nSparkles++;
+		}
+
+		for (uint32_t c = 0; c < 3; c++) {
+			const auto nLow = std::min(fixture.aColour1[c], fixture.aColour2[c]);
+			const auto nHigh = std::max(fixture.aColour1[c], fixture.aColour2[c]);
+
+			if ((s_Frame[i * 3 + c] < nLow) || (s_Frame[i * 3 + c] > nHigh)) {
+				nErrors++;
+			}
+		}
+	}
+
+	result(pName, nErrors + (nSparkles == 0 ? 1 : 0));
+	delete pEffects;
+}
+
+/*
+ * Benchmark
+ */
+
+static double bench_render(Effect effect) {
+	PixelEffects pixelEffects(BENCH_COUNT);
+
+	pixeleffects::Parameters parameters;
+	memset(&parameters, 0, sizeof(parameters));
+	parameters.effect = effect;
+	parameters.nDimmer = 200;
+	parameters.nSpeed = 4096;
+	parameters.nSize = 50;
+	parameters.aColour1[0] = 255; parameters.aColour1[1] = 128; parameters.aColour1[2] = 10;
+	parameters.aColour2[2] = 200;
+	pixelEffects.SetParameters(parameters);
+
+	const auto nStart = nanos();
+
+	for (uint32_t nFrame = 0; nFrame < BENCH_FRAMES; nFrame++) {
+		pixelEffects.Render(nFrame * 20);
+	}
+
+	return static_cast<double>(nanos() - nStart) / (BENCH_FRAMES * BENCH_COUNT);
+}
+
+static double bench_effects_frame() {
+	const Fixture fixture = { Effect::RAINBOW, 255, 160, 60, { 0, 0, 0 }, { 0, 0, 0 } };
+	auto *pEffects = create();
+	run(*pEffects, fixture, 25);
+
+	const auto nStart = nanos();
+	run(*pEffects, fixture, 25 + BENCH_FRAMES * RENDER_MILLIS);
+	const auto nElapsed = nanos() - nStart;
+
+	delete pEffects;
+	return static_cast<double>(nElapsed) / (1000.0 * BENCH_FRAMES);
+}
+
+static double bench_patterns_frame() {
+	s_nNowMillis = 0;
+
+	PixelPatterns patterns(1);
+	patterns.RainbowCycle(0, RENDER_MILLIS);
+
+	const auto nStart = nanos();
+
+	while (s_nNowMillis < BENCH_FRAMES * RENDER_MILLIS) {
+		s_nNowMillis++;
+		patterns.Run();
+	}
+
+	return static_cast<double>(nanos() - nStart) / (1000.0 * BENCH_FRAMES);
+}
+
+int main() {
+	Hardware hw;
+
+	PixelConfiguration config;
+	config.SetType(pixel::Type::WS2812B);
+	config.SetCount(COUNT);
+
+	WS28xx ws28xx(config);
+
+	printf("%-44s %7s %6s\n", "Check", "Errors", "Limit");
+
+	const uint8_t aRed[3] = { 255, 40, 0 };
+	const uint8_t aBlue[3] = { 0, 30, 200 };
+
+	check_reference("Solid, dimmer full", { Effect::SOLID, 255, 128, 0, { aRed[0], aRed[1], aRed[2] }, { 0, 0, 0 } }, solid);
+	check_reference("Solid, dimmer 100", { Effect::SOLID, 100, 128, 0, { aRed[0], aRed[1], aRed[2] }, { 0, 0, 0 } }, solid);
+	check_reference("Gradient, size 17", { Effect::GRADIENT, 255, 128, 32, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, gradient);
+	check_reference("Wave against sin(), size 65", { Effect::WAVE, 200, 128, 64, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, wave);
+	check_reference("Rainbow against the wheel, size 145", { Effect::RAINBOW, 255, 128, 96, { 0, 0, 0 }, { 0, 0, 0 } }, rainbow);
+	check_reference("Comet, size 37", { Effect::COMET, 255, 128, 48, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, comet);
+	check_chase("Chase, blocks of size 17", { Effect::CHASE, 255, 128, 32, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } });
+	check_sparkle("Sparkle, between the colours", { Effect::SPARKLE, 255, 250, 20, { 255, 255, 255 }, { aBlue[0], aBlue[1], aBlue[2] } });
+
+	// Speed 64 above stop is 64 * 64 * 4 / 256 = 64 pixels per second, 32 pixels in 500 ms
+	check_movement("Chase, forward 32 pixels in 500 ms", { Effect::CHASE, 255, 192, 32, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, 32);
+	check_movement("Chase, reverse 32 pixels in 500 ms", { Effect::CHASE, 255, 64, 32, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, -32);
+	check_movement("Wave, forward 32 pixels in 500 ms", { Effect::WAVE, 255, 192, 64, { aRed[0], aRed[1], aRed[2] }, { aBlue[0], aBlue[1], aBlue[2] } }, 32);
+	check_movement("Rainbow, stop", { Effect::RAINBOW, 255, 128, 64, { 0, 0, 0 }, { 0, 0, 0 } }, 0);
+
+	puts("");
+	printf("Render, %u pixels, %u frames (host timing)\n", BENCH_COUNT, BENCH_FRAMES);
+
+	for (uint32_t i = static_cast<uint32_t>(Effect::SOLID); i < static_cast<uint32_t>(Effect::LAST); i++) {
+		const auto effect = static_cast<Effect>(i);
+		printf(" %-10s %6.2f ns per pixel\n", PixelEffects::GetName(effect), bench_render(effect));
+	}
+
+	puts("");
+	printf("Rainbow frame, %u pixels, render and encode (host timing)\n", COUNT);
+	printf(" PixelEffectsDmx : %7.2f us\n", bench_effects_frame());
+	printf(" PixelPatterns   : %7.2f us\n", bench_patterns_frame());
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file gatherbench.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Drives WS28xxDmx with a pixel map: 680 WS2812B pixels in a 34 x 20 matrix,
+ * wired serpentine, over 4 universes of 170 pixels.
+ * Each frame written to the SPI is decoded, every physical pixel must have
+ * the colour of its position in the DMX image.
+ * Then the time per DMX frame is measured with the map (the gather pass)
+ * and without (linear), for the same pixels.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "bcm2835.h"
+
+#include "ws28xxdmx.h"
+#include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
+#include "lightset.h"
+#include "hardware.h"
+
+using lightset::Dmx;
+
+static constexpr uint32_t WIDTH = 34;
+static constexpr uint32_t HEIGHT = 20;
+static constexpr uint32_t COUNT = WIDTH * HEIGHT;
+static constexpr uint32_t PIXELS_PER_UNIVERSE = 170;
+static constexpr uint32_t UNIVERSES = COUNT / PIXELS_PER_UNIVERSE;
+static constexpr uint32_t BENCH_FRAMES = 2000;
+
+/*
+ * Hardware, the clock is simulated
+ */
+
+static uint32_t s_nNowMillis;
+
+Hardware *Hardware::s_pThis = nullptr;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nNowMillis;
+}
+
+uint32_t Hardware::Micros() {
+	return s_nNowMillis * 1000U;
+}
+
+/*
+ * SPI, the last WS2812B (GRB) frame is decoded
+ */
+
+static bool s_bDecode;
+static uint8_t s_Frame[COUNT][3];
+
+void bcm2835_spi_begin() {
+}
+
+void bcm2835_spi_chipSelect(__attribute__((unused)) uint8_t nChipSelect) {
+}
+
+void bcm2835_spi_set_speed_hz(__attribute__((unused)) uint32_t nSpeedHz) {
+}
+
+void bcm2835_spi_setDataMode(__attribute__((unused)) uint8_t nMode) {
+}
+
+void bcm2835_spi_transfern(__attribute__((unused)) char *pBuffer, __attribute__((unused)) uint32_t nLength) {
+}
+
+void bcm2835_spi_writenb(const char *pBuffer, uint32_t nLength) {
+	if (!s_bDecode) {
+		return;
+	}
+
+	const auto *pFrame = reinterpret_cast<const uint8_t *>(pBuffer);
+	const uint32_t aOrder[3] = { 1, 0, 2 };	// GRB
+
+	for (uint32_t i = 0; (i < COUNT) && ((i + 1) * 24 <= nLength); i++) {
+		for (uint32_t c = 0; c < 3; c++) {
+			const auto *p = &pFrame[(i * 3 + c) * 8];
+			uint32_t nValue = 0;
+
+			for (uint32_t nBit = 0; nBit < 8; nBit++) {
+				nValue = (nValue << 1) | (p[nBit] > 0xC0 ? 1 : 0);
+			}
+
+			s_Frame[i][aOrder[c]] = static_cast<uint8_t>(nValue);
+		}
+	}
+}
+
+void bcm2835_spi_write(__attribute__((unused)) uint16_t nData) {
+}
+
+void bcm2835_delayMicroseconds(__attribute__((unused)) uint64_t nMicros) {
+}
+
+/*
+ * Test
+ */
+
+static uint32_t s_nFailed;
+static uint8_t s_Channels[UNIVERSES * Dmx::UNIVERSE_SIZE];
+
+static uint64_t nanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void result(const char *pName, uint32_t nValue, uint32_t nLimit) {
+	const auto bPass = (nValue <= nLimit);
+	printf("%-44s %7u <=%6u  %s\n", pName, nValue, nLimit, bPass ? "PASS" : "FAIL");
+
+	if (!bPass) {
+		s_nFailed++;
+	}
+}
+
+/*
+ * The colour of a pixel of the DMX image, from its x and y
+ */
+static void colour(uint32_t x, uint32_t y, uint32_t nSeed, uint8_t rgb[3]) {
+	rgb[0] = static_cast<uint8_t>(x * 7 + nSeed);
+	rgb[1] = static_cast<uint8_t>(y * 11 + nSeed);
+	rgb[2] = static_cast<uint8_t>((x * y) ^ nSeed);
+}
+
+static void fill(uint32_t nSeed) {
+	for (uint32_t nImagePixel = 0; nImagePixel < COUNT; nImagePixel++) {
+		const auto nUniverse = nImagePixel / PIXELS_PER_UNIVERSE;
+		auto *p = &s_Channels[nUniverse * Dmx::UNIVERSE_SIZE + (nImagePixel % PIXELS_PER_UNIVERSE) * 3];
+		colour(nImagePixel % WIDTH, nImagePixel / WIDTH, nSeed, p);
+	}
+}
+
+static void send(WS28xxDmx& dmx) {
+	for (uint32_t nPort = 0; nPort < UNIVERSES; nPort++) {
+		dmx.SetData(static_cast<uint8_t>(nPort), &s_Channels[nPort * Dmx::UNIVERSE_SIZE], Dmx::UNIVERSE_SIZE);
+	}
+}
+
+static void configure(PixelDmxConfiguration& config, bool bMap) {
+	config.SetType(pixel::Type::WS2812B);
+	config.SetCount(static_cast<uint16_t>(COUNT));
+
+	if (bMap) {
+		const pixelmap::Layout layout = { WIDTH, HEIGHT, 1, 1, pixelmap::flags::SERPENTINE, pixelmap::Rotate::R0 };
+		config.SetMapLayout(layout);
+	}
+}
+
+/*
+ * Pixels of the decoded frame with another colour than their position in the image.
+ * The odd rows are wired from right to left.
+ */
+static uint32_t mismatches(uint32_t nSeed) {
+	uint32_t nMismatches = 0;
+
+	for (uint32_t y = 0; y < HEIGHT; y++) {
+		for (uint32_t nWired = 0; nWired < WIDTH; nWired++) {
+			const auto x = ((y & 0x1) != 0) ? WIDTH - 1 - nWired : nWired;
+			uint8_t rgb[3];
+			colour(x, y, nSeed, rgb);
+
+			if (memcmp(s_Frame[y * WIDTH + nWired], rgb, 3) != 0) {
+				nMismatches++;
+			}
+		}
+	}
+
+	return nMismatches;
+}
+
+static double bench(bool bMap) {
+	PixelDmxConfiguration config;
+	configure(config, bMap);
+
+	WS28xxDmx dmx(config);
+	dmx.Start();
+
+	const auto nStart = nanos();
+
+	for (uint32_t nFrame = 0; nFrame < BENCH_FRAMES; nFrame++) {
+		s_Channels[nFrame % sizeof(s_Channels)]++;
+		send(dmx);
+	}
+
+	return static_cast<double>(nanos() - nStart) / (1000.0 * BENCH_FRAMES);
+}
+
+int main() {
+	Hardware hw;
+
+	{
+		PixelDmxConfiguration config;
+		configure(config, true);
+
+		WS28xxDmx dmx(config);
+		dmx.Start();
+
+		printf("%u pixels, %ux%u serpentine, %u universes\n\n", COUNT, WIDTH, HEIGHT, dmx.GetUniverses());
+		printf("%-44s %7s %8s\n", "Check", "Value", "Limit");
+
+		s_bDecode = true;
+
+		for (uint32_t nSeed = 0; nSeed < 3; nSeed++) {
+			fill(nSeed * 101);
+			send(dmx);
+
+			char aName[64];
+			snprintf(aName, sizeof(aName), "Frame %u, pixels not at their position", nSeed + 1);
+			result(aName, mismatches(nSeed * 101), 0);
+		}
+
+		s_bDecode = false;
+	}
+
+	const auto fLinear = bench(false);
+	const auto fMapped = bench(true);
+
+	puts("");
+	printf("Host timing, %u frames of %u universes\n", BENCH_FRAMES, UNIVERSES);
+	printf(" Linear, no map        : %7.2f us\n", fLinear);
+	printf(" Map, gather pass      : %7.2f us\n", fMapped);
+	printf(" Gather throughput     : %7.2f pixels/us\n", COUNT / fMapped);
+
+	return (s_nFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "pixelconfiguration.h"
+#include "pixelmap.h"
 
 namespace pixeldmxconfiguration {
 struct PortInfo {
@@ -65,6 +66,18 @@ public:
 		return m_nGroupingCount;
 	}
 
+	void SetMapLayout(const pixelmap::Layout& layout) {
+		m_MapLayout = layout;
+	}
+
+	const pixelmap::Layout& GetMapLayout() const {
+		return m_MapLayout;
+	}
+
+	bool HasMap() const {
+		return (m_MapLayout.nWidth != 0) && (m_MapLayout.nHeight != 0);
+	}
+
 	void Validate(uint32_t nPortsMax, uint32_t& nLedsPerPixel, pixeldmxconfiguration::PortInfo& portInfo, uint32_t& nGroups, uint32_t& nUniverses);
 
 	void Dump();
@@ -73,6 +86,7 @@ private:
 	uint32_t m_nOutputPorts { 1 };
 	bool m_isGroupingEnabled { false };
 	uint32_t m_nGroupingCount { 1 };
+	pixelmap::Layout m_MapLayout { 0, 0, 1, 1, 0, pixelmap::Rotate::R0 };
 };
 
 #endif /* PIXELDMXCONFIGURATION_H_ */
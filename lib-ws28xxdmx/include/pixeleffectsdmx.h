@@ -0,0 +1,110 @@
+/**
+ * @file pixeleffectsdmx.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELEFFECTSDMX_H_
+#define PIXELEFFECTSDMX_H_
+
+#include <stdint.h>
+
+#include "lightset.h"
+
+#include "pixeleffects.h"
+
+#if defined (OUTPUT_PIXEL_MULTI)
+# include "ws28xxmulti.h"
+#else
+# include "ws28xx.h"
+#endif
+
+namespace pixeleffectsdmx {
+static constexpr uint32_t FOOTPRINT = 10;
+namespace slot {
+static constexpr uint32_t EFFECT = 0;
+static constexpr uint32_t DIMMER = 1;
+static constexpr uint32_t SPEED = 2;	///< 128 is stop, above is forward, below is reverse
+static constexpr uint32_t SIZE = 3;
+static constexpr uint32_t COLOUR1 = 4;	///< RGB
+static constexpr uint32_t COLOUR2 = 7;	///< RGB
+}  // namespace slot
+static constexpr uint32_t RENDER_MILLIS = 20;
+}  // namespace pixeleffectsdmx
+
+/**
+ * The effects engine as a 10 channel fixture, driving the pixel output created by WS28xxDmx.
+ * For the multi output, the ports are joined into a single strip.
+ */
+class PixelEffectsDmx: public LightSet {
+public:
+	PixelEffectsDmx(uint32_t nActivePorts = 1);
+	~PixelEffectsDmx() override;
+
+	void Start(uint8_t nPort = 0) override;
+	void Stop(uint8_t nPort = 0) override;
+
+	void SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) override;
+
+	void Blackout(bool bBlackout) override;
+
+	void Run();
+
+	void Print() override;
+
+public: // RDM
+	bool SetDmxStartAddress(uint16_t nDmxStartAddress) override;
+
+	uint16_t GetDmxStartAddress() override {
+		return m_nDmxStartAddress;
+	}
+
+	uint16_t GetDmxFootprint() override {
+		return pixeleffectsdmx::FOOTPRINT;
+	}
+
+	bool GetSlotInfo(uint16_t nSlotOffset, lightset::SlotInfo &tSlotInfo) override;
+
+private:
+	void Output();
+
+private:
+#if defined (OUTPUT_PIXEL_MULTI)
+	WS28xxMulti *m_pOutput;
+#else
+	WS28xx *m_pOutput;
+#endif
+	PixelEffects *m_pPixelEffects { nullptr };
+	uint32_t m_nActivePorts;
+	uint32_t m_nCount;
+	uint32_t m_nRenderMillis { pixeleffectsdmx::RENDER_MILLIS };
+	uint32_t m_nMillis { 0 };
+	uint32_t m_nRenderMicros { 0 };
+
+	uint16_t m_nDmxStartAddress { lightset::Dmx::START_ADDRESS_DEFAULT };
+	uint8_t m_Data[pixeleffectsdmx::FOOTPRINT];
+
+	bool m_bIsStarted { false };
+	bool m_bBlackout { false };
+};
+
+#endif /* PIXELEFFECTSDMX_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file pixelmap.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELMAP_H_
+#define PIXELMAP_H_
+
+#include <stdint.h>
+
+namespace pixelmap {
+enum class Rotate : uint8_t {
+	R0, R90, R180, R270
+};
+namespace flags {
+static constexpr uint8_t SERPENTINE = (1U << 0);		///< Every other row is wired in the opposite direction
+static constexpr uint8_t MIRROR_X = (1U << 1);
+static constexpr uint8_t MIRROR_Y = (1U << 2);
+static constexpr uint8_t TILES_SERPENTINE = (1U << 3);	///< Every other row of tiles is wired in the opposite direction
+}  // namespace flags
+static constexpr uint16_t UNMAPPED = 0xFFFF;
+
+struct Layout {
+	uint16_t nWidth;	///< Pixels per row in a tile, 0 is no map
+	uint16_t nHeight;	///< Rows in a tile
+	uint8_t nTilesX;
+	uint8_t nTilesY;
+	uint8_t nFlags;
+	Rotate rotate;		///< Clockwise, the wiring of a tile relative to the DMX image
+};
+}  // namespace pixelmap
+
+/**
+ * The DMX image is row major, from top left. The table has an entry per physical pixel
+ * with the channel offset (universe * 512 + slot) of its first colour.
+ * The output stage does a single gather pass per frame.
+ */
+class PixelMap {
+public:
+	PixelMap(uint32_t nCount);
+	~PixelMap();
+
+	/**
+	 * nPixelsPerUniverse is 0 when the pixels are packed over the universe boundaries
+	 */
+	void Build(const pixelmap::Layout& layout, uint32_t nChannelsPerPixel, uint32_t nPixelsPerUniverse, uint32_t nChannels);
+
+	void Set(uint32_t nPixel, uint16_t nOffset) {
+		if (nPixel < m_nCount) {
+			m_pMap[nPixel] = nOffset;
+		}
+	}
+
+	const uint16_t *Get() const {
+		return m_pMap;
+	}
+
+	uint32_t GetCount() const {
+		return m_nCount;
+	}
+
+	void Dump();
+
+private:
+	uint16_t *m_pMap { nullptr };
+	uint32_t m_nCount;
+};
+
+#endif /* PIXELMAP_H_ */
@@ -34,6 +34,7 @@
 #include "ws28xxdmxstore.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
 #include "pixelpatterns.h"
 
 class WS28xxDmx: public LightSet {
@@ -47,9 +48,16 @@ public:
 	void Stop(uint8_t nPort = 0) override;
 
 	void SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) override;
+	void Stage(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) override;
+	void Commit() override;
 
 	void Blackout(bool bBlackout) override;
 
+	/**
+	 * 16-bit input only: sends dithered frames in between the DMX frames
+	 */
+	void Run();
+
 	void SetWS28xxDmxStore(WS28xxDmxStore *pWS28xxDmxStore) {
 		m_pWS28xxDmxStore = pWS28xxDmxStore;
 	}
@@ -77,6 +85,11 @@ public: // RDM
 
 	bool GetSlotInfo(uint16_t nSlotOffset, lightset::SlotInfo &tSlotInfo) override;
 
+private:
+	void StageChannels(uint8_t nPortId, const uint8_t *pData, uint16_t nLength);
+	void Gather();
+	void Updated();
+
 private:
 	pixeldmxconfiguration::PortInfo m_PortInfo;
 	uint32_t m_nChannelsPerPixel;
@@ -101,6 +114,18 @@ private:
 
 	bool m_bIsStarted { false };
 	bool m_bBlackout { false };
+	bool m_bStaged { false };
+
+	bool m_b16Bit { false };
+	uint8_t *m_pChannels { nullptr };
+	uint32_t m_nFrameMillis { 0 };
+	uint32_t m_nDmxMillis { 0 };
+	uint32_t m_nDmxIntervalMillis { 25 };
+	bool m_bDmxResumed { false };
+	uint32_t m_nUpdateMillis { 0 };
+	uint32_t m_nDitherFrames { 0 };
+
+	PixelMap *m_pPixelMap { nullptr };
 };
 
 #endif /* WS28XXDMX_H_ */
@@ -33,6 +33,7 @@
 #include "ws28xxmulti.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
 #include "pixelpatterns.h"
 
 namespace ws28xxdmxmulti {
@@ -48,6 +49,8 @@ public:
 	void Stop(uint8_t nPort) override;
 
 	void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override;
+	void Stage(uint8_t nPort, const uint8_t *pData, uint16_t nLength) override;
+	void Commit() override;
 
 	void Blackout(bool bBlackout) override;
 
@@ -78,6 +81,9 @@ public:
 		return 0;
 	}
 
+private:
+	void Gather();
+
 private:
 	pixeldmxconfiguration::PortInfo m_PortInfo;
 	uint32_t m_nChannelsPerPixel;
@@ -90,6 +96,10 @@ private:
 
 	uint32_t m_bIsStarted { 0 };
 	bool m_bBlackout { false };
+	bool m_bStaged { false };
+
+	uint8_t *m_pChannels { nullptr };
+	PixelMap *m_pPixelMap { nullptr };
 };
 
 #endif /* WS28XXDMXMULTI_H_ */
@@ -35,6 +35,10 @@
 
 namespace ws28xxdmxparams {
 	static constexpr auto MAX_OUTPUTS = 8;
+	namespace layout {
+	static constexpr uint8_t ROTATE_SHIFT = 4;	///< nLayoutFlags bits 0-3 are pixelmap::flags
+	static constexpr uint8_t ROTATE_MASK = (0x3 << ROTATE_SHIFT);
+	}  // namespace layout
 }  // ws28xxdmxparams name
 
 struct TWS28xxDmxParams {
@@ -53,6 +57,14 @@ struct TWS28xxDmxParams {
 	uint8_t nHighCode;										///< 1	  22
 	uint16_t nStartUniverse[ws28xxdmxparams::MAX_OUTPUTS];	///< 16   38
 	uint8_t nTestPattern;									///< 1    39
+	uint8_t nGamma;											///< 1    40
+	uint8_t nWhitePoint[3];									///< 3    43
+	uint8_t nMaxCurrent;									///< 1    44
+	uint16_t nLayoutWidth;									///< 2    46
+	uint16_t nLayoutHeight;									///< 2    48
+	uint8_t nLayoutTilesX;									///< 1    49
+	uint8_t nLayoutTilesY;									///< 1    50
+	uint8_t nLayoutFlags;									///< 1    51
 }__attribute__((packed));
 
 static_assert(sizeof(struct TWS28xxDmxParams) <= 64, "struct TWS28xxDmxParams is too large");
@@ -79,6 +91,14 @@ struct WS28xxDmxParamsMask {
 	static constexpr auto START_UNI_PORT_7 = (1U << 18);
 	static constexpr auto START_UNI_PORT_8 = (1U << 19);
 	static constexpr auto TEST_PATTERN = (1U << 20);
+	static constexpr auto GAMMA = (1U << 21);
+	static constexpr auto WHITE_POINT = (1U << 22);
+	static constexpr auto MAX_CURRENT = (1U << 23);
+	static constexpr auto PIXEL_16BIT = (1U << 24);
+	static constexpr auto LAYOUT = (1U << 25);
+	static constexpr auto LAYOUT_TILES = (1U << 26);
+	static constexpr auto LAYOUT_FLAGS = (1U << 27);
+	static constexpr auto PIXEL_EFFECTS = (1U << 28);
 };
 
 class WS28xxDmxParamsStore {
@@ -116,6 +136,10 @@ public:
 		return 0;
 	}
 
+	bool IsEffects() const {
+		return isMaskSet(WS28xxDmxParamsMask::PIXEL_EFFECTS);
+	}
+
 	uint8_t GetTestPattern() const {
 		return m_tWS28xxParams.nTestPattern;
 	}
@@ -125,6 +149,7 @@ public:
 
 private:
     void callbackFunction(const char *pLine);
+    void SetLayoutMask();
     bool isMaskSet(uint32_t nMask) const {
     	return (m_tWS28xxParams.nSetList & nMask) == nMask;
     }
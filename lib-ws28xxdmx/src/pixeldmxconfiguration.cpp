@@ -33,6 +33,8 @@
 
 #include "pixeldmxconfiguration.h"
 
+#include "lightset.h"
+
 #include "debug.h"
 
 using namespace pixeldmxconfiguration;
@@ -59,6 +61,10 @@ void PixelDmxConfiguration::Validate(uint32_t nPortsMax, uint32_t& nLedsPerPixel
 		portInfo.nBeginIndexPortId3 = 510;
 	}
 
+	if (HasMap()) {
+		m_isGroupingEnabled = false;
+	}
+
 	if (m_isGroupingEnabled) {
 		if ((m_nGroupingCount == 0) || (m_nGroupingCount > GetCount())) {
 			m_nGroupingCount = GetCount();
@@ -70,6 +76,33 @@ void PixelDmxConfiguration::Validate(uint32_t nPortsMax, uint32_t& nLedsPerPixel
 	nGroups = GetCount() / m_nGroupingCount;
 
 	m_nOutputPorts = std::min(nPortsMax, m_nOutputPorts);
+
+	if (nPortsMax != 1) {
+		Set16Bit(false);
+	}
+
+	if (Is16Bit()) {
+		/*
+		 * Coarse and fine channel per colour. The pixels are packed,
+		 * a pixel can start in one universe and end in the next one.
+		 */
+		nLedsPerPixel *= 2;
+
+		constexpr uint32_t UNIVERSE_SIZE = lightset::Dmx::UNIVERSE_SIZE;
+		const auto nGroupsMax = (4 * UNIVERSE_SIZE) / nLedsPerPixel;
+		nGroups = std::min(nGroups, nGroupsMax);
+
+		portInfo.nBeginIndexPortId1 = (1 * UNIVERSE_SIZE + nLedsPerPixel - 1) / nLedsPerPixel;
+		portInfo.nBeginIndexPortId2 = (2 * UNIVERSE_SIZE + nLedsPerPixel - 1) / nLedsPerPixel;
+		portInfo.nBeginIndexPortId3 = (3 * UNIVERSE_SIZE + nLedsPerPixel - 1) / nLedsPerPixel;
+
+		nUniverses = std::max(1U, (nGroups * nLedsPerPixel + UNIVERSE_SIZE - 1) / UNIVERSE_SIZE);
+		portInfo.nProtocolPortIdLast = nUniverses - 1;
+
+		DEBUG_EXIT
+		return;
+	}
+
 	nUniverses = 1 + (nGroups  / (1 + portInfo.nBeginIndexPortId1));
 
 	if (nPortsMax == 1) {
@@ -92,5 +125,11 @@ void PixelDmxConfiguration::Dump() {
 	if (m_isGroupingEnabled) {
 		printf(" nGroupingCount=%u\n", m_nGroupingCount);
 	}
+	if (Is16Bit()) {
+		printf(" 16-bit\n");
+	}
+	if (HasMap()) {
+		printf(" Map %ux%u, tiles %ux%u, flags=%.2x, rotate=%u\n", m_MapLayout.nWidth, m_MapLayout.nHeight, m_MapLayout.nTilesX, m_MapLayout.nTilesY, m_MapLayout.nFlags, static_cast<uint32_t>(m_MapLayout.rotate));
+	}
 #endif
 }
@@ -0,0 +1,275 @@
+/**
+ * @file pixeleffectsdmx.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <cassert>
+
+#include "pixeleffectsdmx.h"
+#include "pixeleffects.h"
+
+#include "lightset.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+using namespace pixeleffects;
+using namespace pixeleffectsdmx;
+using namespace lightset;
+
+PixelEffectsDmx::PixelEffectsDmx(uint32_t nActivePorts) {
+	DEBUG_ENTRY
+
+#if defined (OUTPUT_PIXEL_MULTI)
+	m_pOutput = WS28xxMulti::Get();
+	m_nActivePorts = std::max(static_cast<uint32_t>(1), nActivePorts);
+#else
+	m_pOutput = WS28xx::Get();
+	m_nActivePorts = 1;
+	(void) nActivePorts;
+#endif
+
+	assert(m_pOutput != nullptr);
+
+	m_nCount = m_pOutput->GetCount();
+
+	m_pPixelEffects = new PixelEffects(m_nCount * m_nActivePorts);
+	assert(m_pPixelEffects != nullptr);
+
+	memset(m_Data, 0, sizeof(m_Data));
+	m_Data[slot::SPEED] = 128;
+
+#if !defined (OUTPUT_PIXEL_MULTI)
+	m_nRenderMillis = std::max(RENDER_MILLIS, m_pOutput->GetFrameMillis());
+#endif
+
+	// Render throughput, shown with Print()
+	const auto nMicros = Hardware::Get()->Micros();
+	m_pPixelEffects->Render(0);
+	m_nRenderMicros = Hardware::Get()->Micros() - nMicros;
+
+	DEBUG_PRINTF("m_nCount=%u, m_nActivePorts=%u, m_nRenderMillis=%u", m_nCount, m_nActivePorts, m_nRenderMillis);
+	DEBUG_EXIT
+}
+
+PixelEffectsDmx::~PixelEffectsDmx() {
+	delete m_pPixelEffects;
+	m_pPixelEffects = nullptr;
+}
+
+void PixelEffectsDmx::Start(__attribute__((unused)) uint8_t nPort) {
+	if (m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = true;
+
+	if (m_pLightSetHandler != nullptr) {
+		m_pLightSetHandler->Start();
+	}
+}
+
+void PixelEffectsDmx::Stop(__attribute__((unused)) uint8_t nPort) {
+	if (!m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = false;
+
+	while (m_pOutput->IsUpdating()) {
+		// wait for completion
+	}
+
+	m_pOutput->Blackout();
+
+	if (m_pLightSetHandler != nullptr) {
+		m_pLightSetHandler->Stop();
+	}
+}
+
+/*
+ * Only the 10 channels are used, the parameters are applied with the next render
+ */
+void PixelEffectsDmx::SetData(__attribute__((unused)) uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
+	assert(pData != nullptr);
+
+	const auto nOffset = static_cast<uint32_t>(m_nDmxStartAddress - 1);
+
+	if (nLength <= nOffset) {
+		return;
+	}
+
+	const auto nCopy = std::min(FOOTPRINT, nLength - nOffset);
+
+	if (memcmp(m_Data, &pData[nOffset], nCopy) == 0) {
+		return;
+	}
+
+	memcpy(m_Data, &pData[nOffset], nCopy);
+
+	Parameters parameters;
+
+	parameters.effect = static_cast<Effect>((m_Data[slot::EFFECT] * static_cast<uint32_t>(Effect::LAST)) >> 8);
+	parameters.nDimmer = m_Data[slot::DIMMER];
+
+	// Quadratic, 255 is 64 pixels per second
+	const auto nSpeed = static_cast<int32_t>(m_Data[slot::SPEED]) - 128;
+	parameters.nSpeed = nSpeed * (nSpeed < 0 ? -nSpeed : nSpeed) * 4;
+
+	// Quadratic, 1 - 1017 pixels
+	parameters.nSize = 1 + ((static_cast<uint32_t>(m_Data[slot::SIZE]) * m_Data[slot::SIZE]) >> 6);
+
+	memcpy(parameters.aColour1, &m_Data[slot::COLOUR1], 3);
+	memcpy(parameters.aColour2, &m_Data[slot::COLOUR2], 3);
+
+	m_pPixelEffects->SetParameters(parameters);
+}
+
+void PixelEffectsDmx::Run() {
+	if (!m_bIsStarted || m_bBlackout || m_pOutput->IsUpdating()) {
+		return;
+	}
+
+	const auto nMillis = Hardware::Get()->Millis();
+
+	if ((nMillis - m_nMillis) < m_nRenderMillis) {
+#if !defined (OUTPUT_PIXEL_MULTI)
+		if (m_pOutput->Is16Bit() && ((nMillis - m_nMillis) >= m_pOutput->GetFrameMillis())) {
+			m_pOutput->Dither();
+			m_pOutput->Update();
+		}
+#endif
+		return;
+	}
+
+	m_nMillis = nMillis;
+
+	m_pPixelEffects->Render(nMillis);
+	Output();
+}
+
+void PixelEffectsDmx::Output() {
+	const auto *pBuffer = m_pPixelEffects->GetBuffer();
+
+#if defined (OUTPUT_PIXEL_MULTI)
+	for (uint32_t nPort = 0; nPort < m_nActivePorts; nPort++) {
+		for (uint32_t i = 0; i < m_nCount; i++) {
+			m_pOutput->SetPixel(static_cast<uint8_t>(nPort), static_cast<uint16_t>(i), static_cast<uint8_t>(pBuffer[0] >> 8), static_cast<uint8_t>(pBuffer[1] >> 8), static_cast<uint8_t>(pBuffer[2] >> 8));
+			pBuffer += 3;
+		}
+	}
+#else
+	if (m_pOutput->Is16Bit()) {
+		for (uint32_t i = 0; i < m_nCount; i++) {
+			m_pOutput->SetPixel16(i, pBuffer[0], pBuffer[1], pBuffer[2]);
+			pBuffer += 3;
+		}
+	} else {
+		for (uint32_t i = 0; i < m_nCount; i++) {
+			m_pOutput->SetPixel(static_cast<uint16_t>(i), static_cast<uint8_t>(pBuffer[0] >> 8), static_cast<uint8_t>(pBuffer[1] >> 8), static_cast<uint8_t>(pBuffer[2] >> 8));
+			pBuffer += 3;
+		}
+	}
+#endif
+
+	m_pOutput->Update();
+}
+
+void PixelEffectsDmx::Blackout(bool bBlackout) {
+	m_bBlackout = bBlackout;
+
+	while (m_pOutput->IsUpdating()) {
+		// wait for completion
+	}
+
+	if (bBlackout) {
+		m_pOutput->Blackout();
+	} else {
+		Output();
+	}
+}
+
+void PixelEffectsDmx::Print() {
+	m_pOutput->Print();
+
+	const auto& parameters = m_pPixelEffects->GetParameters();
+
+	printf("Pixel effects\n");
+	printf(" Pixels         : %u [Ports : %u]\n", m_nCount * m_nActivePorts, m_nActivePorts);
+	printf(" Render         : %u ms, %u us\n", m_nRenderMillis, m_nRenderMicros);
+	printf(" Effect         : %s\n", PixelEffects::GetName(parameters.effect));
+	printf(" Speed / Size   : %d / %u\n", static_cast<int>(parameters.nSpeed), parameters.nSize);
+}
+
+// DMX
+
+bool PixelEffectsDmx::SetDmxStartAddress(uint16_t nDmxStartAddress) {
+	assert((nDmxStartAddress != 0) && (nDmxStartAddress <= (Dmx::UNIVERSE_SIZE - FOOTPRINT + 1)));
+
+	if ((nDmxStartAddress != 0) && (nDmxStartAddress <= (Dmx::UNIVERSE_SIZE - FOOTPRINT + 1))) {
+		m_nDmxStartAddress = nDmxStartAddress;
+
+		if (m_pLightSetDisplay != nullptr) {
+			m_pLightSetDisplay->ShowDmxStartAddress();
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+// RDM
+
+bool PixelEffectsDmx::GetSlotInfo(uint16_t nSlotOffset, SlotInfo& tSlotInfo) {
+	if (nSlotOffset >= FOOTPRINT) {
+		return false;
+	}
+
+	tSlotInfo.nType = 0x00;	// ST_PRIMARY
+
+	switch (nSlotOffset) {
+	case slot::EFFECT:
+		tSlotInfo.nCategory = 0x0504; // SD_MACRO
+		break;
+	case slot::DIMMER:
+		tSlotInfo.nCategory = 0x0001; // SD_INTENSITY
+		break;
+	case slot::SPEED:
+		tSlotInfo.nCategory = 0x0503; // SD_FIXTURE_SPEED
+		break;
+	case slot::SIZE:
+		tSlotInfo.nCategory = 0xFFFF; // SD_UNDEFINED
+		break;
+	default:
+		tSlotInfo.nCategory = static_cast<uint16_t>(0x0205 + ((nSlotOffset - slot::COLOUR1) % 3)); // SD_COLOR_ADD_RED
+		break;
+	}
+
+	return true;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file pixelmap.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if !defined(__clang__)	// Needed for compiling on MacOS
+# pragma GCC push_options
+# pragma GCC optimize ("Os")
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <cassert>
+
+#include "pixelmap.h"
+
+#include "lightset.h"
+
+#include "debug.h"
+
+using namespace pixelmap;
+
+PixelMap::PixelMap(uint32_t nCount) : m_nCount(nCount) {
+	DEBUG_ENTRY
+
+	m_pMap = new uint16_t[nCount];
+	assert(m_pMap != nullptr);
+
+	for (uint32_t i = 0; i < nCount; i++) {
+		m_pMap[i] = UNMAPPED;
+	}
+
+	DEBUG_EXIT
+}
+
+PixelMap::~PixelMap() {
+	delete [] m_pMap;
+	m_pMap = nullptr;
+}
+
+void PixelMap::Build(const Layout& layout, uint32_t nChannelsPerPixel, uint32_t nPixelsPerUniverse, uint32_t nChannels) {
+	DEBUG_ENTRY
+	assert(nChannelsPerPixel != 0);
+
+	constexpr uint32_t UNIVERSE_SIZE = lightset::Dmx::UNIVERSE_SIZE;
+	const uint32_t nWidth = layout.nWidth;
+	const uint32_t nHeight = layout.nHeight;
+	const uint32_t nTilesX = layout.nTilesX == 0 ? 1 : layout.nTilesX;
+	const uint32_t nTilesY = layout.nTilesY == 0 ? 1 : layout.nTilesY;
+
+	if ((nWidth == 0) || (nHeight == 0)) {
+		DEBUG_EXIT
+		return;
+	}
+
+	const auto bIsRotated = (layout.rotate == Rotate::R90) || (layout.rotate == Rotate::R270);
+	// The wiring runs along the rows of the rotated tile
+	const auto nWiredWidth = bIsRotated ? nHeight : nWidth;
+	const auto nTilePixels = nWidth * nHeight;
+	const auto nImageWidth = nWidth * nTilesX;
+
+	for (uint32_t nPixel = 0; nPixel < m_nCount; nPixel++) {
+		const auto nTile = nPixel / nTilePixels;
+
+		if (nTile >= (nTilesX * nTilesY)) {
+			m_pMap[nPixel] = UNMAPPED;
+			continue;
+		}
+
+		const auto nIndex = nPixel - (nTile * nTilePixels);
+		const auto nRow = nIndex / nWiredWidth;
+		auto nColumn = nIndex - (nRow * nWiredWidth);
+
+		if (((layout.nFlags & flags::SERPENTINE) != 0) && ((nRow & 0x1) != 0)) {
+			nColumn = nWiredWidth - 1 - nColumn;
+		}
+
+		uint32_t x, y;
+
+		switch (layout.rotate) {
+		case Rotate::R90:
+			x = nWidth - 1 - nRow;
+			y = nColumn;
+			break;
+		case Rotate::R180:
+			x = nWidth - 1 - nColumn;
+			y = nHeight - 1 - nRow;
+			break;
+		case Rotate::R270:
+			x = nRow;
+			y = nHeight - 1 - nColumn;
+			break;
+		default:
+			x = nColumn;
+			y = nRow;
+			break;
+		}
+
+		if ((layout.nFlags & flags::MIRROR_X) != 0) {
+			x = nWidth - 1 - x;
+		}
+
+		if ((layout.nFlags & flags::MIRROR_Y) != 0) {
+			y = nHeight - 1 - y;
+		}
+
+		const auto nTileY = nTile / nTilesX;
+		auto nTileX = nTile - (nTileY * nTilesX);
+
+		if (((layout.nFlags & flags::TILES_SERPENTINE) != 0) && ((nTileY & 0x1) != 0)) {
+			nTileX = nTilesX - 1 - nTileX;
+		}
+
+		const auto nImagePixel = ((nTileY * nHeight) + y) * nImageWidth + (nTileX * nWidth) + x;
+
+		uint32_t nOffset;
+
+		if (nPixelsPerUniverse == 0) {
+			nOffset = nImagePixel * nChannelsPerPixel;
+		} else {
+			const auto nUniverse = nImagePixel / nPixelsPerUniverse;
+			nOffset = nUniverse * UNIVERSE_SIZE + (nImagePixel - (nUniverse * nPixelsPerUniverse)) * nChannelsPerPixel;
+		}
+
+		m_pMap[nPixel] = ((nOffset + nChannelsPerPixel) <= nChannels) ? static_cast<uint16_t>(nOffset) : UNMAPPED;
+	}
+
+	DEBUG_PRINTF("%ux%u, %ux%u tiles, flags=%.2x, rotate=%u", nWidth, nHeight, nTilesX, nTilesY, layout.nFlags, static_cast<uint32_t>(layout.rotate));
+	DEBUG_EXIT
+}
+
+void PixelMap::Dump() {
+#ifndef NDEBUG
+	for (uint32_t i = 0; i < m_nCount; i++) {
+		printf("%4u:%4u%c", i, m_pMap[i], ((i + 1) & 0x7) == 0 ? '\n' : ' ');
+	}
+	puts("");
+#endif
+}
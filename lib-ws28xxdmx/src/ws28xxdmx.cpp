@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
 #include <cassert>
 
@@ -39,6 +40,9 @@
 #include "lightset.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
+
+#include "hardware.h"
 
 #include "debug.h"
 
@@ -57,6 +61,23 @@ WS28xxDmx::WS28xxDmx(PixelDmxConfiguration& pixelDmxConfiguration) {
 
 	m_pWS28xx->Blackout();
 
+	if (pixelDmxConfiguration.Is16Bit() || pixelDmxConfiguration.HasMap()) {
+		m_pChannels = new uint8_t[4 * Dmx::UNIVERSE_SIZE];
+		assert(m_pChannels != nullptr);
+		memset(m_pChannels, 0, 4 * Dmx::UNIVERSE_SIZE);
+	}
+
+	if (pixelDmxConfiguration.Is16Bit()) {
+		m_b16Bit = true;
+		m_nFrameMillis = m_pWS28xx->GetFrameMillis();
+	}
+
+	if (pixelDmxConfiguration.HasMap()) {
+		m_pPixelMap = new PixelMap(pixelDmxConfiguration.GetCount());
+		assert(m_pPixelMap != nullptr);
+		m_pPixelMap->Build(pixelDmxConfiguration.GetMapLayout(), m_nChannelsPerPixel, m_b16Bit ? 0 : m_PortInfo.nBeginIndexPortId1, 4 * Dmx::UNIVERSE_SIZE);
+	}
+
 	m_nGroupingCount = pixelDmxConfiguration.GetGroupingCount();
 	pixelDmxConfiguration.Dump();
 
@@ -66,6 +87,16 @@ WS28xxDmx::WS28xxDmx(PixelDmxConfiguration& pixelDmxConfiguration) {
 WS28xxDmx::~WS28xxDmx() {
 	delete m_pWS28xx;
 	m_pWS28xx = nullptr;
+
+	if (m_pChannels != nullptr) {
+		delete [] m_pChannels;
+		m_pChannels = nullptr;
+	}
+
+	if (m_pPixelMap != nullptr) {
+		delete m_pPixelMap;
+		m_pPixelMap = nullptr;
+	}
 }
 
 void WS28xxDmx::Start(__attribute__((unused)) uint8_t nPort) {
@@ -100,9 +131,34 @@ void WS28xxDmx::Stop(__attribute__((unused)) uint8_t nPort) {
 }
 
 void WS28xxDmx::SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
+	Stage(nPortId, pData, nLength);
+
+	if (nPortId == m_PortInfo.nProtocolPortIdLast) {
+		if (m_pPixelMap != nullptr) {
+			while (m_pWS28xx->IsUpdating()) {
+				// wait for completion
+			}
+
+			Gather();
+		}
+
+		m_pWS28xx->Update();
+		m_bStaged = false;
+		Updated();
+	}
+}
+
+void WS28xxDmx::Stage(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
 	assert(pData != nullptr);
 	assert(nLength <= Dmx::UNIVERSE_SIZE);
 
+	m_bStaged = true;
+
+	if (m_pChannels != nullptr) {
+		StageChannels(nPortId, pData, nLength);
+		return;
+	}
+
 	uint32_t d = 0;
 	uint32_t beginIndex, endIndex;
 
@@ -160,10 +216,167 @@ void WS28xxDmx::SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength)
 			d = d + 4;
 		}
 	}
+}
 
-	if (nPortId == m_PortInfo.nProtocolPortIdLast) {
-		m_pWS28xx->Update();
+/*
+ * The universes are copied into one channel buffer, so a pixel can cross a universe boundary.
+ * With a map, the pixels are gathered once per output frame.
+ * Otherwise all pixels touching the received universe are set again.
+ */
+void WS28xxDmx::StageChannels(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
+	uint32_t d = 0;
+
+	if (m_nUniverses == 1) {
+		d = static_cast<uint32_t>(m_nDmxStartAddress - 1);
+	}
+
+	if (nLength <= d) {
+		return;
+	}
+
+	const uint32_t nBegin = (nPortId & 0x03) * Dmx::UNIVERSE_SIZE;
+	const uint32_t nEnd = nBegin + nLength - d;
+
+	memcpy(&m_pChannels[nBegin], &pData[d], nLength - d);
+
+	if (m_pPixelMap != nullptr) {
+		return;
+	}
+
+	const auto beginIndex = nBegin / m_nChannelsPerPixel;
+	const auto endIndex = std::min(m_nGroups, (nEnd + m_nChannelsPerPixel - 1) / m_nChannelsPerPixel);
+
+	while (m_pWS28xx->IsUpdating()) {
+		// wait for completion
+	}
+
+	for (uint32_t j = beginIndex; j < endIndex; j++) {
+		const auto *p = &m_pChannels[j * m_nChannelsPerPixel];
+		const auto nRed = static_cast<uint16_t>((p[0] << 8) | p[1]);
+		const auto nGreen = static_cast<uint16_t>((p[2] << 8) | p[3]);
+		const auto nBlue = static_cast<uint16_t>((p[4] << 8) | p[5]);
+		const auto nWhite = (m_nChannelsPerPixel == 8) ? static_cast<uint16_t>((p[6] << 8) | p[7]) : static_cast<uint16_t>(0);
+		const auto nPixelIndexStart = j * m_nGroupingCount;
+
+		for (uint32_t k = 0; k < m_nGroupingCount; k++) {
+			m_pWS28xx->SetPixel16(nPixelIndexStart + k, nRed, nGreen, nBlue, nWhite);
+		}
+	}
+}
+
+void WS28xxDmx::Gather() {
+	const auto *pMap = m_pPixelMap->Get();
+	const auto nCount = m_pPixelMap->GetCount();
+
+	if (m_b16Bit) {
+		for (uint32_t i = 0; i < nCount; i++) {
+			if (pMap[i] == pixelmap::UNMAPPED) {
+				m_pWS28xx->SetPixel16(i, 0, 0, 0, 0);
+				continue;
+			}
+
+			const auto *p = &m_pChannels[pMap[i]];
+			const auto nWhite = (m_nChannelsPerPixel == 8) ? static_cast<uint16_t>((p[6] << 8) | p[7]) : static_cast<uint16_t>(0);
+			m_pWS28xx->SetPixel16(i, static_cast<uint16_t>((p[0] << 8) | p[1]), static_cast<uint16_t>((p[2] << 8) | p[3]), static_cast<uint16_t>((p[4] << 8) | p[5]), nWhite);
+		}
+	} else if (m_nChannelsPerPixel == 3) {
+		for (uint32_t i = 0; i < nCount; i++) {
+			if (pMap[i] == pixelmap::UNMAPPED) {
+				m_pWS28xx->SetPixel(i, 0, 0, 0);
+				continue;
+			}
+
+			const auto *p = &m_pChannels[pMap[i]];
+			m_pWS28xx->SetPixel(i, p[0], p[1], p[2]);
+		}
+	} else {
+		for (uint32_t i = 0; i < nCount; i++) {
+			if (pMap[i] == pixelmap::UNMAPPED) {
+				m_pWS28xx->SetPixel(i, 0, 0, 0, 0);
+				continue;
+			}
+
+			const auto *p = &m_pChannels[pMap[i]];
+			m_pWS28xx->SetPixel(i, p[0], p[1], p[2], p[3]);
+		}
+	}
+}
+
+void WS28xxDmx::Commit() {
+	if (!m_bStaged) {
+		return;
+	}
+
+	m_bStaged = false;
+
+	while (m_pWS28xx->IsUpdating()) {
+		// wait for completion
+	}
+
+	if (m_pPixelMap != nullptr) {
+		Gather();
+	}
+
+	m_pWS28xx->Update();
+	Updated();
+}
+
+void WS28xxDmx::Updated() {
+	if (!m_b16Bit) {
+		return;
 	}
+
+	const auto nMillis = Hardware::Get()->Millis();
+	const auto nDelta = std::min(nMillis - m_nDmxMillis, static_cast<uint32_t>(1000));
+
+	/*
+	 * A dithered frame still being sent delays the DMX frame, so a shorter interval is taken at once.
+	 * The first interval after a pause is not counted, the next one restarts the average.
+	 */
+	if (nDelta == 0) {
+		// Another update within the same millisecond
+	} else if (m_bDmxResumed) {
+		m_nDmxIntervalMillis = nDelta;
+		m_bDmxResumed = false;
+	} else if (nDelta > (2 * m_nDmxIntervalMillis)) {
+		m_bDmxResumed = true;
+	} else if (nDelta < m_nDmxIntervalMillis) {
+		m_nDmxIntervalMillis = nDelta;
+	} else {
+		m_nDmxIntervalMillis = (3 * m_nDmxIntervalMillis + nDelta) / 4;
+	}
+
+	m_nDmxMillis = nMillis;
+	m_nUpdateMillis = nMillis;
+}
+
+/*
+ * The DMX frame rate is lower than the pixel refresh rate. The spare time is used
+ * for dithered frames, but only when a frame fits before the next DMX frame is expected.
+ * When the DMX input is paused, the dithering continues.
+ */
+void WS28xxDmx::Run() {
+	if (!m_b16Bit || !m_bIsStarted || m_bBlackout || m_pWS28xx->IsUpdating()) {
+		return;
+	}
+
+	const auto nMillis = Hardware::Get()->Millis();
+
+	if ((nMillis - m_nUpdateMillis) < m_nFrameMillis) {
+		return;
+	}
+
+	const auto nElapsed = nMillis - m_nDmxMillis;
+
+	if ((nElapsed < (2 * m_nDmxIntervalMillis)) && ((nElapsed + m_nFrameMillis) > m_nDmxIntervalMillis)) {
+		return;
+	}
+
+	m_pWS28xx->Dither();
+	m_pWS28xx->Update();
+
+	m_nUpdateMillis = nMillis;
+	m_nDitherFrames++;
 }
 
 void WS28xxDmx::Blackout(bool bBlackout) {
@@ -215,7 +428,17 @@ bool WS28xxDmx::GetSlotInfo(uint16_t nSlotOffset, SlotInfo& tSlotInfo) {
 		return false;
 	}
 
-	if (m_tLedType == Type::SK6812W) {
+	if (m_b16Bit) {
+		nIndex = MOD(nSlotOffset, m_nChannelsPerPixel);
+
+		if ((nIndex & 0x1) != 0) {
+			tSlotInfo.nType = 0x01;	// ST_SEC_FINE
+			tSlotInfo.nCategory = static_cast<uint16_t>(nSlotOffset - 1);
+			return true;
+		}
+
+		nIndex = nIndex / 2;
+	} else if (m_tLedType == Type::SK6812W) {
 		nIndex = MOD(nSlotOffset, 4);
 	} else {
 		nIndex = MOD(nSlotOffset, 3);
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <algorithm>
 #include <cassert>
 
@@ -34,6 +35,7 @@
 #include "ws28xx.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
 
 #include "debug.h"
 
@@ -62,6 +64,18 @@ WS28xxDmxMulti::WS28xxDmxMulti(PixelDmxConfiguration& pixelDmxConfiguration) {
 	m_nGroupingCount = pixelDmxConfiguration.GetGroupingCount();
 	m_nOutputPorts = pixelDmxConfiguration.GetOutputPorts();
 
+	if (pixelDmxConfiguration.HasMap()) {
+		const auto nSize = m_nOutputPorts * 4 * Dmx::UNIVERSE_SIZE;
+
+		m_pChannels = new uint8_t[nSize];
+		assert(m_pChannels != nullptr);
+		memset(m_pChannels, 0, nSize);
+
+		m_pPixelMap = new PixelMap(pixelDmxConfiguration.GetCount());
+		assert(m_pPixelMap != nullptr);
+		m_pPixelMap->Build(pixelDmxConfiguration.GetMapLayout(), m_nChannelsPerPixel, m_PortInfo.nBeginIndexPortId1, 4 * Dmx::UNIVERSE_SIZE);
+	}
+
 	pixelDmxConfiguration.Dump();
 
 	DEBUG_EXIT
@@ -70,6 +84,16 @@ WS28xxDmxMulti::WS28xxDmxMulti(PixelDmxConfiguration& pixelDmxConfiguration) {
 WS28xxDmxMulti::~WS28xxDmxMulti() {
 	delete m_pWS28xxMulti;
 	m_pWS28xxMulti = nullptr;
+
+	if (m_pChannels != nullptr) {
+		delete [] m_pChannels;
+		m_pChannels = nullptr;
+	}
+
+	if (m_pPixelMap != nullptr) {
+		delete m_pPixelMap;
+		m_pPixelMap = nullptr;
+	}
 }
 
 void WS28xxDmxMulti::Start(uint8_t nPortId) {
@@ -98,9 +122,28 @@ void WS28xxDmxMulti::Stop(uint8_t nPortId) {
 }
 
 void WS28xxDmxMulti::SetData(uint8_t nPortId, const uint8_t* pData, uint16_t nLength) {
+	Stage(nPortId, pData, nLength);
+
+	if (nPortId == m_PortInfo.nProtocolPortIdLast) {
+		if (m_pPixelMap != nullptr) {
+			while (m_pWS28xxMulti->IsUpdating()) {
+				// wait for completion
+			}
+
+			Gather();
+		}
+
+		m_pWS28xxMulti->Update();
+		m_bStaged = false;
+	}
+}
+
+void WS28xxDmxMulti::Stage(uint8_t nPortId, const uint8_t* pData, uint16_t nLength) {
 	assert(pData != nullptr);
 	assert(nLength <= Dmx::UNIVERSE_SIZE);
 
+	m_bStaged = true;
+
 	uint32_t beginIndex, endIndex;
 
 #if defined (NODE_ARTNET)
@@ -111,6 +154,13 @@ void WS28xxDmxMulti::SetData(uint8_t nPortId, const uint8_t* pData, uint16_t nLe
 	const uint8_t nSwitch = nPortId - (nOutIndex * m_nUniverses);
 #endif
 
+	if (m_pPixelMap != nullptr) {
+		if (nOutIndex < m_nOutputPorts) {
+			memcpy(&m_pChannels[(nOutIndex * 4 + nSwitch) * Dmx::UNIVERSE_SIZE], pData, nLength);
+		}
+		return;
+	}
+
 	switch (nSwitch) {
 	case 0:
 		beginIndex = 0;
@@ -164,12 +214,60 @@ void WS28xxDmxMulti::SetData(uint8_t nPortId, const uint8_t* pData, uint16_t nLe
 			d = d + 4;
 		}
 	}
+}
 
-	if (nPortId == m_PortInfo.nProtocolPortIdLast) {
-		m_pWS28xxMulti->Update();
+/*
+ * One pass per output frame, all outputs share the same map
+ */
+void WS28xxDmxMulti::Gather() {
+	const auto *pMap = m_pPixelMap->Get();
+	const auto nCount = m_pPixelMap->GetCount();
+
+	for (uint32_t nOutIndex = 0; nOutIndex < m_nOutputPorts; nOutIndex++) {
+		const auto *pChannels = &m_pChannels[nOutIndex * 4 * Dmx::UNIVERSE_SIZE];
+
+		if (m_nChannelsPerPixel == 3) {
+			for (uint32_t i = 0; i < nCount; i++) {
+				if (pMap[i] == pixelmap::UNMAPPED) {
+					m_pWS28xxMulti->SetPixel(nOutIndex, i, 0, 0, 0);
+					continue;
+				}
+
+				const auto *p = &pChannels[pMap[i]];
+				m_pWS28xxMulti->SetPixel(nOutIndex, i, p[0], p[1], p[2]);
+			}
+		} else {
+			for (uint32_t i = 0; i < nCount; i++) {
+				if (pMap[i] == pixelmap::UNMAPPED) {
+					m_pWS28xxMulti->SetPixel(nOutIndex, i, 0, 0, 0, 0);
+					continue;
+				}
+
+				const auto *p = &pChannels[pMap[i]];
+				m_pWS28xxMulti->SetPixel(nOutIndex, i, p[0], p[1], p[2], p[3]);
+			}
+		}
 	}
 }
 
+void WS28xxDmxMulti::Commit() {
+	if (!m_bStaged) {
+		return;
+	}
+
+	m_bStaged = false;
+
+	while (m_pWS28xxMulti->IsUpdating()) {
+		// wait for completion
+	}
+
+	if (m_pPixelMap != nullptr) {
+		Gather();
+	}
+
+	m_pWS28xxMulti->Update();
+}
+
 void WS28xxDmxMulti::Blackout(bool bBlackout) {
 	m_bBlackout = bBlackout;
 
@@ -190,4 +288,8 @@ void WS28xxDmxMulti::Print() {
 	printf("Pixel DMX parameters\n");
 	printf(" Outputs : %d\n", m_nOutputPorts);
 	printf(" Grouping count : %d [Groups : %d]\n", m_nGroupingCount, m_nGroups);
+
+	if (m_pPixelMap != nullptr) {
+		printf(" Map : %u pixels x %u outputs\n", m_pPixelMap->GetCount(), m_nOutputPorts);
+	}
 }
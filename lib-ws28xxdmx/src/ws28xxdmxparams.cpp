@@ -36,6 +36,8 @@
 #include "ws28xxdmxparams.h"
 
 #include "pixeltype.h"
+#include "pixellut.h"
+#include "pixelmap.h"
 #include "ws28xxdmx.h"
 
 #include "lightset.h"
@@ -43,6 +45,7 @@
 
 #include "readconfigfile.h"
 #include "sscan.h"
+#include "propertieskey.h"
 
 #include "devicesparamsconst.h"
 
@@ -77,6 +80,16 @@ WS28xxDmxParams::WS28xxDmxParams(WS28xxDmxParamsStore *pWS28XXStripeParamsStore)
 		nStartUniverse += 4;
 	}
 	m_tWS28xxParams.nTestPattern = 0;
+	m_tWS28xxParams.nGamma = pixellut::defaults::GAMMA;
+	for (uint32_t i = 0; i < 3; i++) {
+		m_tWS28xxParams.nWhitePoint[i] = pixellut::defaults::WHITE_POINT;
+	}
+	m_tWS28xxParams.nMaxCurrent = pixellut::defaults::MAX_CURRENT;
+	m_tWS28xxParams.nLayoutWidth = 0;
+	m_tWS28xxParams.nLayoutHeight = 0;
+	m_tWS28xxParams.nLayoutTilesX = 1;
+	m_tWS28xxParams.nLayoutTilesY = 1;
+	m_tWS28xxParams.nLayoutFlags = 0;
 }
 
 bool WS28xxDmxParams::Load() {
@@ -121,168 +134,322 @@ void WS28xxDmxParams::callbackFunction(const char *pLine) {
 
 	uint8_t nValue8;
 	uint16_t nValue16;
+#if defined (PARAMS_INLCUDE_ALL) || !defined(OUTPUT_PIXEL_MULTI)
+	uint32_t nValue32;
+#endif
 	float fValue;
 	char cBuffer[16];
-
-	uint32_t nLength = TYPES_MAX_NAME_LENGTH;
-
-	if (Sscan::Char(pLine, DevicesParamsConst::TYPE, cBuffer, nLength) == Sscan::OK) {
-		cBuffer[nLength] = '\0';
-		const auto type = PixelType::GetType(cBuffer);
-
-		if (type != pixel::Type::UNDEFINED) {
-			m_tWS28xxParams.nType = static_cast<uint8_t>(type);
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::TYPE;
-		} else {
-			m_tWS28xxParams.nType = static_cast<uint8_t>(pixel::defaults::TYPE);
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::TYPE;
+	uint32_t nLength;
+
+	switch (properties::key(pLine)) {
+	case properties::hash(DevicesParamsConst::TYPE):
+		nLength = TYPES_MAX_NAME_LENGTH;
+		if (Sscan::Char(pLine, DevicesParamsConst::TYPE, cBuffer, nLength) == Sscan::OK) {
+			cBuffer[nLength] = '\0';
+			const auto type = PixelType::GetType(cBuffer);
+
+			if (type != pixel::Type::UNDEFINED) {
+				m_tWS28xxParams.nType = static_cast<uint8_t>(type);
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::TYPE;
+			} else {
+				m_tWS28xxParams.nType = static_cast<uint8_t>(pixel::defaults::TYPE);
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::TYPE;
+			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint16(pLine, DevicesParamsConst::COUNT, nValue16) == Sscan::OK) {
-		if (nValue16 != 0 && nValue16 <= std::max(max::ledcount::RGB, max::ledcount::RGBW)) {
-			m_tWS28xxParams.nCount = nValue16;
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::COUNT;
-		} else {
-			m_tWS28xxParams.nCount = defaults::COUNT;
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::COUNT;
+	case properties::hash(DevicesParamsConst::COUNT):
+		if (Sscan::Uint16(pLine, DevicesParamsConst::COUNT, nValue16) == Sscan::OK) {
+			if (nValue16 != 0 && nValue16 <= std::max(max::ledcount::RGB, max::ledcount::RGBW)) {
+				m_tWS28xxParams.nCount = nValue16;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::COUNT;
+			} else {
+				m_tWS28xxParams.nCount = defaults::COUNT;
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::COUNT;
+			}
 		}
 		return;
-	}
+	case properties::hash(DevicesParamsConst::MAP):
+		nLength = 3;
+		if (Sscan::Char(pLine, DevicesParamsConst::MAP, cBuffer, nLength) == Sscan::OK) {
+			cBuffer[nLength] = '\0';
 
-	nLength = 3;
-	if (Sscan::Char(pLine, DevicesParamsConst::MAP, cBuffer, nLength) == Sscan::OK) {
-		cBuffer[nLength] = '\0';
+			const auto map = PixelType::GetMap(cBuffer);
 
-		const auto map = PixelType::GetMap(cBuffer);
+			if (map != Map::UNDEFINED) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::MAP;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::MAP;
+			}
 
-		if (map != Map::UNDEFINED) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::MAP;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::MAP;
+			m_tWS28xxParams.nMap = static_cast<uint8_t>(map);
 		}
-
-		m_tWS28xxParams.nMap = static_cast<uint8_t>(map);
 		return;
-	}
+	case properties::hash(DevicesParamsConst::LED_T0H):
+		if (Sscan::Float(pLine, DevicesParamsConst::LED_T0H, fValue) == Sscan::OK) {
+			if ((nValue8 = PixelType::ConvertTxH(fValue)) != 0) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::LOW_CODE;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::LOW_CODE;
+			}
 
-	if (Sscan::Float(pLine, DevicesParamsConst::LED_T0H, fValue) == Sscan::OK) {
-		if ((nValue8 = PixelType::ConvertTxH(fValue)) != 0) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::LOW_CODE;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::LOW_CODE;
+			m_tWS28xxParams.nLowCode = nValue8;
 		}
-
-		m_tWS28xxParams.nLowCode = nValue8;
 		return;
-	}
+	case properties::hash(DevicesParamsConst::LED_T1H):
+		if (Sscan::Float(pLine, DevicesParamsConst::LED_T1H, fValue) == Sscan::OK) {
+			if ((nValue8 = PixelType::ConvertTxH(fValue)) != 0) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::HIGH_CODE;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::HIGH_CODE;
+			}
 
-	if (Sscan::Float(pLine, DevicesParamsConst::LED_T1H, fValue) == Sscan::OK) {
-		if ((nValue8 = PixelType::ConvertTxH(fValue)) != 0) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::HIGH_CODE;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::HIGH_CODE;
+			m_tWS28xxParams.nHighCode = nValue8;
 		}
-
-		m_tWS28xxParams.nHighCode = nValue8;
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, DevicesParamsConst::GROUPING_ENABLED, nValue8) == Sscan::OK) {
-		if (nValue8 != 0) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GROUPING_ENABLED;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GROUPING_ENABLED;
+	case properties::hash(DevicesParamsConst::GROUPING_ENABLED):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::GROUPING_ENABLED, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GROUPING_ENABLED;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GROUPING_ENABLED;
+			}
 		}
 		return;
-	}
-
-	if (Sscan::Uint16(pLine, DevicesParamsConst::GROUPING_COUNT, nValue16) == Sscan::OK) {
-		if (nValue16 > 1 && nValue16 <= std::max(max::ledcount::RGB, max::ledcount::RGBW)) {
-			m_tWS28xxParams.nGroupingCount = nValue16;
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GROUPING_COUNT;
-		} else {
-			m_tWS28xxParams.nGroupingCount = 1;
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GROUPING_COUNT;
+	case properties::hash(DevicesParamsConst::GROUPING_COUNT):
+		if (Sscan::Uint16(pLine, DevicesParamsConst::GROUPING_COUNT, nValue16) == Sscan::OK) {
+			if (nValue16 > 1 && nValue16 <= std::max(max::ledcount::RGB, max::ledcount::RGBW)) {
+				m_tWS28xxParams.nGroupingCount = nValue16;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GROUPING_COUNT;
+			} else {
+				m_tWS28xxParams.nGroupingCount = 1;
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GROUPING_COUNT;
+			}
 		}
 		return;
-	}
-
 #if defined (PARAMS_INLCUDE_ALL) || !defined(OUTPUT_PIXEL_MULTI)
-	if (Sscan::Uint16(pLine, LightSetConst::PARAMS_DMX_START_ADDRESS, nValue16) == Sscan::OK) {
-		if ((nValue16 != 0) && nValue16 <= (Dmx::UNIVERSE_SIZE) && (nValue16 != Dmx::START_ADDRESS_DEFAULT)) {
-			m_tWS28xxParams.nDmxStartAddress = nValue16;
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::DMX_START_ADDRESS;
-		} else {
-			m_tWS28xxParams.nDmxStartAddress = Dmx::START_ADDRESS_DEFAULT;
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::DMX_START_ADDRESS;
+	case properties::hash(LightSetConst::PARAMS_DMX_START_ADDRESS):
+		if (Sscan::Uint16(pLine, LightSetConst::PARAMS_DMX_START_ADDRESS, nValue16) == Sscan::OK) {
+			if ((nValue16 != 0) && nValue16 <= (Dmx::UNIVERSE_SIZE) && (nValue16 != Dmx::START_ADDRESS_DEFAULT)) {
+				m_tWS28xxParams.nDmxStartAddress = nValue16;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::DMX_START_ADDRESS;
+			} else {
+				m_tWS28xxParams.nDmxStartAddress = Dmx::START_ADDRESS_DEFAULT;
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::DMX_START_ADDRESS;
+			}
 		}
 		return;
-	}
-
-	uint32_t nValue32;
-
-	if (Sscan::Uint32(pLine, DevicesParamsConst::SPI_SPEED_HZ, nValue32) == Sscan::OK) {
-		if (nValue32 != pixel::spi::speed::ws2801::default_hz) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::SPI_SPEED;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::SPI_SPEED;
+	case properties::hash(DevicesParamsConst::SPI_SPEED_HZ):
+		if (Sscan::Uint32(pLine, DevicesParamsConst::SPI_SPEED_HZ, nValue32) == Sscan::OK) {
+			if (nValue32 != pixel::spi::speed::ws2801::default_hz) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::SPI_SPEED;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::SPI_SPEED;
+			}
+			m_tWS28xxParams.nSpiSpeedHz = nValue32;
 		}
-		m_tWS28xxParams.nSpiSpeedHz = nValue32;
 		return;
-	}
-
-	if (Sscan::Uint8(pLine, DevicesParamsConst::GLOBAL_BRIGHTNESS, nValue8) == Sscan::OK) {
-		if ((nValue8 != 0) && (nValue8 != 0xFF)) {
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GLOBAL_BRIGHTNESS;
-			m_tWS28xxParams.nGlobalBrightness = nValue8;
-		} else {
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GLOBAL_BRIGHTNESS;
-			m_tWS28xxParams.nGlobalBrightness = 0xFF;
+	case properties::hash(DevicesParamsConst::GLOBAL_BRIGHTNESS):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::GLOBAL_BRIGHTNESS, nValue8) == Sscan::OK) {
+			if ((nValue8 != 0) && (nValue8 != 0xFF)) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GLOBAL_BRIGHTNESS;
+				m_tWS28xxParams.nGlobalBrightness = nValue8;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GLOBAL_BRIGHTNESS;
+				m_tWS28xxParams.nGlobalBrightness = 0xFF;
+			}
 		}
 		return;
-	}
 #endif
-
 #if defined (PARAMS_INLCUDE_ALL) || defined(OUTPUT_PIXEL_MULTI)
-	for (uint32_t i = 0; i < std::min(static_cast<size_t>(MAX_OUTPUTS), sizeof(LightSetConst::PARAMS_START_UNI_PORT) / sizeof(LightSetConst::PARAMS_START_UNI_PORT[0])); i++) {
-		if (Sscan::Uint16(pLine, LightSetConst::PARAMS_START_UNI_PORT[i], nValue16) == Sscan::OK) {
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[0]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[1]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[2]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[3]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[4]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[5]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[6]):
+	case properties::hash(LightSetConst::PARAMS_START_UNI_PORT[7]):
+		for (uint32_t i = 0; i < std::min(static_cast<size_t>(MAX_OUTPUTS), sizeof(LightSetConst::PARAMS_START_UNI_PORT) / sizeof(LightSetConst::PARAMS_START_UNI_PORT[0])); i++) {
+			if (Sscan::Uint16(pLine, LightSetConst::PARAMS_START_UNI_PORT[i], nValue16) == Sscan::OK) {
 #if !defined (NODE_ARTNET)
-			if (nValue16 > 0) {
+				if (nValue16 > 0) {
 #endif
-				m_tWS28xxParams.nStartUniverse[i] = nValue16;
-				m_tWS28xxParams.nSetList |= (WS28xxDmxParamsMask::START_UNI_PORT_1 << i);
+					m_tWS28xxParams.nStartUniverse[i] = nValue16;
+					m_tWS28xxParams.nSetList |= (WS28xxDmxParamsMask::START_UNI_PORT_1 << i);
 #if !defined (NODE_ARTNET)
+				} else {
+					m_tWS28xxParams.nStartUniverse[i] = 1 + (i * 4);
+					m_tWS28xxParams.nSetList &= ~(WS28xxDmxParamsMask::START_UNI_PORT_1 << i);
+				}
+#endif
+				return;
+			}
+		}
+		return;
+	case properties::hash(DevicesParamsConst::ACTIVE_OUT):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::ACTIVE_OUT, nValue8) == Sscan::OK) {
+			if ((nValue8 > 0) &&  (nValue8 <= 8) &&  (nValue8 != pixel::defaults::OUTPUT_PORTS)) {
+				m_tWS28xxParams.nActiveOutputs = nValue8;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::ACTIVE_OUT;
 			} else {
-				m_tWS28xxParams.nStartUniverse[i] = 1 + (i * 4);
-				m_tWS28xxParams.nSetList &= ~(WS28xxDmxParamsMask::START_UNI_PORT_1 << i);
+				m_tWS28xxParams.nActiveOutputs = pixel::defaults::OUTPUT_PORTS;
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::ACTIVE_OUT;
 			}
+		}
+		return;
 #endif
+	case properties::hash(DevicesParamsConst::GAMMA):
+		if (Sscan::Float(pLine, DevicesParamsConst::GAMMA, fValue) == Sscan::OK) {
+			if ((fValue >= 1.0f) && (fValue <= 3.0f)) {
+				m_tWS28xxParams.nGamma = static_cast<uint8_t>(fValue * 10 + 0.5f);
+			} else {
+				m_tWS28xxParams.nGamma = pixellut::defaults::GAMMA;
+			}
+
+			if (m_tWS28xxParams.nGamma != pixellut::defaults::GAMMA) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::GAMMA;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::GAMMA;
+			}
+		}
+		return;
+	case properties::hash(DevicesParamsConst::WHITE_POINT_RED):
+	case properties::hash(DevicesParamsConst::WHITE_POINT_GREEN):
+	case properties::hash(DevicesParamsConst::WHITE_POINT_BLUE): {
+		const char *pWhitePoint[3] = { DevicesParamsConst::WHITE_POINT_RED, DevicesParamsConst::WHITE_POINT_GREEN, DevicesParamsConst::WHITE_POINT_BLUE };
+
+		for (uint32_t i = 0; i < 3; i++) {
+			if (Sscan::Uint8(pLine, pWhitePoint[i], nValue8) == Sscan::OK) {
+				m_tWS28xxParams.nWhitePoint[i] = nValue8;
+
+				if ((m_tWS28xxParams.nWhitePoint[0] & m_tWS28xxParams.nWhitePoint[1] & m_tWS28xxParams.nWhitePoint[2]) != pixellut::defaults::WHITE_POINT) {
+					m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::WHITE_POINT;
+				} else {
+					m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::WHITE_POINT;
+				}
+				return;
+			}
 		}
+		return;
 	}
+	case properties::hash(DevicesParamsConst::LAYOUT_WIDTH):
+		if (Sscan::Uint16(pLine, DevicesParamsConst::LAYOUT_WIDTH, nValue16) == Sscan::OK) {
+			m_tWS28xxParams.nLayoutWidth = nValue16;
+			SetLayoutMask();
+		}
+		return;
+	case properties::hash(DevicesParamsConst::LAYOUT_HEIGHT):
+		if (Sscan::Uint16(pLine, DevicesParamsConst::LAYOUT_HEIGHT, nValue16) == Sscan::OK) {
+			m_tWS28xxParams.nLayoutHeight = nValue16;
+			SetLayoutMask();
+		}
+		return;
+	case properties::hash(DevicesParamsConst::LAYOUT_TILES_X):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::LAYOUT_TILES_X, nValue8) == Sscan::OK) {
+			m_tWS28xxParams.nLayoutTilesX = (nValue8 == 0) ? 1 : nValue8;
+			SetLayoutMask();
+		}
+		return;
+	case properties::hash(DevicesParamsConst::LAYOUT_TILES_Y):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::LAYOUT_TILES_Y, nValue8) == Sscan::OK) {
+			m_tWS28xxParams.nLayoutTilesY = (nValue8 == 0) ? 1 : nValue8;
+			SetLayoutMask();
+		}
+		return;
+	case properties::hash(DevicesParamsConst::LAYOUT_ROTATE):
+		if (Sscan::Uint16(pLine, DevicesParamsConst::LAYOUT_ROTATE, nValue16) == Sscan::OK) {
+			m_tWS28xxParams.nLayoutFlags &= static_cast<uint8_t>(~layout::ROTATE_MASK);
 
-	if (Sscan::Uint8(pLine, DevicesParamsConst::ACTIVE_OUT, nValue8) == Sscan::OK) {
-		if ((nValue8 > 0) &&  (nValue8 <= 8) &&  (nValue8 != pixel::defaults::OUTPUT_PORTS)) {
-			m_tWS28xxParams.nActiveOutputs = nValue8;
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::ACTIVE_OUT;
-		} else {
-			m_tWS28xxParams.nActiveOutputs = pixel::defaults::OUTPUT_PORTS;
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::ACTIVE_OUT;
+			if ((nValue16 == 90) || (nValue16 == 180) || (nValue16 == 270)) {
+				m_tWS28xxParams.nLayoutFlags |= static_cast<uint8_t>((nValue16 / 90) << layout::ROTATE_SHIFT);
+			}
+
+			SetLayoutMask();
+		}
+		return;
+	case properties::hash(DevicesParamsConst::LAYOUT_SERPENTINE):
+	case properties::hash(DevicesParamsConst::LAYOUT_MIRROR_X):
+	case properties::hash(DevicesParamsConst::LAYOUT_MIRROR_Y):
+	case properties::hash(DevicesParamsConst::LAYOUT_TILES_SERPENTINE): {
+		const char *pLayoutFlags[] = { DevicesParamsConst::LAYOUT_SERPENTINE, DevicesParamsConst::LAYOUT_MIRROR_X, DevicesParamsConst::LAYOUT_MIRROR_Y, DevicesParamsConst::LAYOUT_TILES_SERPENTINE };
+		const uint8_t aLayoutFlags[] = { pixelmap::flags::SERPENTINE, pixelmap::flags::MIRROR_X, pixelmap::flags::MIRROR_Y, pixelmap::flags::TILES_SERPENTINE };
+
+		for (uint32_t i = 0; i < sizeof(aLayoutFlags); i++) {
+			if (Sscan::Uint8(pLine, pLayoutFlags[i], nValue8) == Sscan::OK) {
+				if (nValue8 != 0) {
+					m_tWS28xxParams.nLayoutFlags |= aLayoutFlags[i];
+				} else {
+					m_tWS28xxParams.nLayoutFlags &= static_cast<uint8_t>(~aLayoutFlags[i]);
+				}
+
+				SetLayoutMask();
+				return;
+			}
 		}
 		return;
 	}
-#endif
-
-	if (Sscan::Uint8(pLine, LightSetConst::PARAMS_TEST_PATTERN, nValue8) == Sscan::OK) {
-		if ((nValue8 != static_cast<uint8_t>(pixelpatterns::Pattern::NONE)) && (nValue8 < static_cast<uint8_t>(pixelpatterns::Pattern::LAST))) {
-			m_tWS28xxParams.nTestPattern = nValue8;
-			m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::TEST_PATTERN;
-		} else {
-			m_tWS28xxParams.nTestPattern = static_cast<uint8_t>(pixelpatterns::Pattern::NONE);
-			m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::TEST_PATTERN;
+	case properties::hash(DevicesParamsConst::PIXEL_16BIT):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::PIXEL_16BIT, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::PIXEL_16BIT;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::PIXEL_16BIT;
+			}
+		}
+		return;
+	case properties::hash(DevicesParamsConst::PIXEL_EFFECTS):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::PIXEL_EFFECTS, nValue8) == Sscan::OK) {
+			if (nValue8 != 0) {
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::PIXEL_EFFECTS;
+			} else {
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::PIXEL_EFFECTS;
+			}
+		}
+		return;
+	case properties::hash(DevicesParamsConst::MAX_CURRENT):
+		if (Sscan::Uint8(pLine, DevicesParamsConst::MAX_CURRENT, nValue8) == Sscan::OK) {
+			if ((nValue8 != 0) && (nValue8 < pixellut::defaults::MAX_CURRENT)) {
+				m_tWS28xxParams.nMaxCurrent = nValue8;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::MAX_CURRENT;
+			} else {
+				m_tWS28xxParams.nMaxCurrent = pixellut::defaults::MAX_CURRENT;
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::MAX_CURRENT;
+			}
+		}
+		return;
+	case properties::hash(LightSetConst::PARAMS_TEST_PATTERN):
+		if (Sscan::Uint8(pLine, LightSetConst::PARAMS_TEST_PATTERN, nValue8) == Sscan::OK) {
+			if ((nValue8 != static_cast<uint8_t>(pixelpatterns::Pattern::NONE)) && (nValue8 < static_cast<uint8_t>(pixelpatterns::Pattern::LAST))) {
+				m_tWS28xxParams.nTestPattern = nValue8;
+				m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::TEST_PATTERN;
+			} else {
+				m_tWS28xxParams.nTestPattern = static_cast<uint8_t>(pixelpatterns::Pattern::NONE);
+				m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::TEST_PATTERN;
+			}
 		}
 		return;
+	default:
+		return;
+	}
+}
+
+void WS28xxDmxParams::SetLayoutMask() {
+	if ((m_tWS28xxParams.nLayoutWidth != 0) && (m_tWS28xxParams.nLayoutHeight != 0)) {
+		m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::LAYOUT;
+	} else {
+		m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::LAYOUT;
+	}
+
+	if ((m_tWS28xxParams.nLayoutTilesX != 1) || (m_tWS28xxParams.nLayoutTilesY != 1)) {
+		m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::LAYOUT_TILES;
+	} else {
+		m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::LAYOUT_TILES;
+	}
+
+	if (m_tWS28xxParams.nLayoutFlags != 0) {
+		m_tWS28xxParams.nSetList |= WS28xxDmxParamsMask::LAYOUT_FLAGS;
+	} else {
+		m_tWS28xxParams.nSetList &= ~WS28xxDmxParamsMask::LAYOUT_FLAGS;
 	}
 }
 
@@ -93,6 +93,43 @@ void WS28xxDmxParams::Dump() {
 		printf(" %s=%d\n", DevicesParamsConst::GLOBAL_BRIGHTNESS, m_tWS28xxParams.nGlobalBrightness);
 	}
 
+	if (isMaskSet(WS28xxDmxParamsMask::GAMMA)) {
+		printf(" %s=%d.%d\n", DevicesParamsConst::GAMMA, m_tWS28xxParams.nGamma / 10, m_tWS28xxParams.nGamma % 10);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::WHITE_POINT)) {
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_RED, m_tWS28xxParams.nWhitePoint[0]);
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_GREEN, m_tWS28xxParams.nWhitePoint[1]);
+		printf(" %s=%d\n", DevicesParamsConst::WHITE_POINT_BLUE, m_tWS28xxParams.nWhitePoint[2]);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::MAX_CURRENT)) {
+		printf(" %s=%d\n", DevicesParamsConst::MAX_CURRENT, m_tWS28xxParams.nMaxCurrent);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::LAYOUT)) {
+		printf(" %s=%d\n", DevicesParamsConst::LAYOUT_WIDTH, m_tWS28xxParams.nLayoutWidth);
+		printf(" %s=%d\n", DevicesParamsConst::LAYOUT_HEIGHT, m_tWS28xxParams.nLayoutHeight);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::LAYOUT_TILES)) {
+		printf(" %s=%d\n", DevicesParamsConst::LAYOUT_TILES_X, m_tWS28xxParams.nLayoutTilesX);
+		printf(" %s=%d\n", DevicesParamsConst::LAYOUT_TILES_Y, m_tWS28xxParams.nLayoutTilesY);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::LAYOUT_FLAGS)) {
+		printf(" %s=%d\n", DevicesParamsConst::LAYOUT_ROTATE, 90 * ((m_tWS28xxParams.nLayoutFlags & layout::ROTATE_MASK) >> layout::ROTATE_SHIFT));
+		printf(" Layout flags=%.2x\n", m_tWS28xxParams.nLayoutFlags & static_cast<uint8_t>(~layout::ROTATE_MASK));
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::PIXEL_16BIT)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::PIXEL_16BIT);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::PIXEL_EFFECTS)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::PIXEL_EFFECTS);
+	}
+
 	if (isMaskSet(WS28xxDmxParamsMask::DMX_START_ADDRESS)) {
 		printf(" %s=%d\n", LightSetConst::PARAMS_DMX_START_ADDRESS, m_tWS28xxParams.nDmxStartAddress);
 	}
@@ -36,6 +36,7 @@
 #include "ws28xxdmxparams.h"
 #include "pixeltype.h"
 #include "pixelconfiguration.h"
+#include "pixelmap.h"
 
 #include "propertiesbuilder.h"
 
@@ -89,6 +90,28 @@ void WS28xxDmxParams::Builder(const struct TWS28xxDmxParams *ptWS28xxParams, cha
 	builder.Add(DevicesParamsConst::LED_T0H, PixelType::ConvertTxH(m_tWS28xxParams.nLowCode), isMaskSet(WS28xxDmxParamsMask::LOW_CODE), 2);
 	builder.Add(DevicesParamsConst::LED_T1H, PixelType::ConvertTxH(m_tWS28xxParams.nHighCode), isMaskSet(WS28xxDmxParamsMask::HIGH_CODE), 2);
 
+	builder.AddComment("Colour curve");
+	builder.Add(DevicesParamsConst::GAMMA, static_cast<float>(m_tWS28xxParams.nGamma) / 10, isMaskSet(WS28xxDmxParamsMask::GAMMA), 1);
+	builder.Add(DevicesParamsConst::WHITE_POINT_RED, m_tWS28xxParams.nWhitePoint[0], isMaskSet(WS28xxDmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::WHITE_POINT_GREEN, m_tWS28xxParams.nWhitePoint[1], isMaskSet(WS28xxDmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::WHITE_POINT_BLUE, m_tWS28xxParams.nWhitePoint[2], isMaskSet(WS28xxDmxParamsMask::WHITE_POINT));
+	builder.Add(DevicesParamsConst::MAX_CURRENT, m_tWS28xxParams.nMaxCurrent, isMaskSet(WS28xxDmxParamsMask::MAX_CURRENT));
+	builder.Add(DevicesParamsConst::PIXEL_16BIT, isMaskSet(WS28xxDmxParamsMask::PIXEL_16BIT));
+	builder.Add(DevicesParamsConst::PIXEL_EFFECTS, isMaskSet(WS28xxDmxParamsMask::PIXEL_EFFECTS));
+
+	builder.AddComment("Layout");
+	const auto nFlags = m_tWS28xxParams.nLayoutFlags;
+	const auto nRotate = static_cast<uint16_t>(90 * ((nFlags & layout::ROTATE_MASK) >> layout::ROTATE_SHIFT));
+	builder.Add(DevicesParamsConst::LAYOUT_WIDTH, m_tWS28xxParams.nLayoutWidth, isMaskSet(WS28xxDmxParamsMask::LAYOUT));
+	builder.Add(DevicesParamsConst::LAYOUT_HEIGHT, m_tWS28xxParams.nLayoutHeight, isMaskSet(WS28xxDmxParamsMask::LAYOUT));
+	builder.Add(DevicesParamsConst::LAYOUT_SERPENTINE, (nFlags & pixelmap::flags::SERPENTINE) != 0);
+	builder.Add(DevicesParamsConst::LAYOUT_ROTATE, nRotate, nRotate != 0);
+	builder.Add(DevicesParamsConst::LAYOUT_MIRROR_X, (nFlags & pixelmap::flags::MIRROR_X) != 0);
+	builder.Add(DevicesParamsConst::LAYOUT_MIRROR_Y, (nFlags & pixelmap::flags::MIRROR_Y) != 0);
+	builder.Add(DevicesParamsConst::LAYOUT_TILES_X, m_tWS28xxParams.nLayoutTilesX, isMaskSet(WS28xxDmxParamsMask::LAYOUT_TILES));
+	builder.Add(DevicesParamsConst::LAYOUT_TILES_Y, m_tWS28xxParams.nLayoutTilesY, isMaskSet(WS28xxDmxParamsMask::LAYOUT_TILES));
+	builder.Add(DevicesParamsConst::LAYOUT_TILES_SERPENTINE, (nFlags & pixelmap::flags::TILES_SERPENTINE) != 0);
+
 	builder.AddComment("Grouping");
 	builder.Add(DevicesParamsConst::GROUPING_ENABLED, isMaskSet(WS28xxDmxParamsMask::GROUPING_ENABLED));
 	builder.Add(DevicesParamsConst::GROUPING_COUNT, m_tWS28xxParams.nGroupingCount, isMaskSet(WS28xxDmxParamsMask::GROUPING_COUNT));
@@ -34,4 +34,13 @@ void WS28xxDmx::Print() {
 
 	printf("Pixel DMX parameters\n");
 	printf(" Grouping count : %d [Groups : %d]\n", m_nGroupingCount, m_nGroups);
+
+	if (m_b16Bit) {
+		printf(" 16-bit         : %d channels [Universes : %d]\n", m_nChannelsPerPixel, m_nUniverses);
+		printf(" Dither         : %d ms [frames : %u]\n", m_nFrameMillis, m_nDitherFrames);
+	}
+
+	if (m_pPixelMap != nullptr) {
+		printf(" Map            : %u pixels\n", m_pPixelMap->GetCount());
+	}
 }
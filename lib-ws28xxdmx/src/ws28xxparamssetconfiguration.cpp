@@ -29,7 +29,9 @@
 #include "ws28xxdmxparams.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixelmap.h"
 
+using namespace ws28xxdmxparams;
 using namespace pixel;
 
 void WS28xxDmxParams::Set(PixelDmxConfiguration *pPixelDmxConfiguration) {
@@ -67,6 +69,36 @@ void WS28xxDmxParams::Set(PixelDmxConfiguration *pPixelDmxConfiguration) {
 	}
 #endif
 
+	if (isMaskSet(WS28xxDmxParamsMask::GAMMA)) {
+		pPixelDmxConfiguration->SetGamma(m_tWS28xxParams.nGamma);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::WHITE_POINT)) {
+		pPixelDmxConfiguration->SetWhitePoint(m_tWS28xxParams.nWhitePoint[0], m_tWS28xxParams.nWhitePoint[1], m_tWS28xxParams.nWhitePoint[2]);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::MAX_CURRENT)) {
+		pPixelDmxConfiguration->SetMaxCurrent(m_tWS28xxParams.nMaxCurrent);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::LAYOUT)) {
+		const auto nFlags = m_tWS28xxParams.nLayoutFlags;
+		pixelmap::Layout mapLayout;
+
+		mapLayout.nWidth = m_tWS28xxParams.nLayoutWidth;
+		mapLayout.nHeight = m_tWS28xxParams.nLayoutHeight;
+		mapLayout.nTilesX = m_tWS28xxParams.nLayoutTilesX;
+		mapLayout.nTilesY = m_tWS28xxParams.nLayoutTilesY;
+		mapLayout.nFlags = static_cast<uint8_t>(nFlags & ~layout::ROTATE_MASK);
+		mapLayout.rotate = static_cast<pixelmap::Rotate>((nFlags & layout::ROTATE_MASK) >> layout::ROTATE_SHIFT);
+
+		pPixelDmxConfiguration->SetMapLayout(mapLayout);
+	}
+
+	if (isMaskSet(WS28xxDmxParamsMask::PIXEL_16BIT)) {
+		pPixelDmxConfiguration->Set16Bit(true);
+	}
+
 	// Dmx
 
 	if (isMaskSet(WS28xxDmxParamsMask::GROUPING_ENABLED)) {
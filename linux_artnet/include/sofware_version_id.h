@@ -0,0 +1,2 @@
+// Generated Mon Oct 19 13:04:52 UTC 2026
+static const uint32_t DEVICE_SOFTWARE_VERSION_ID=1792415092;
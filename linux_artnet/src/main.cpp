@@ -31,6 +31,7 @@
 
 #include "hardware.h"
 #include "networklinux.h"
+#include "networkreactor.h"
 #include "ledblink.h"
 
 #include "artnet4node.h"
@@ -81,6 +82,15 @@ int main(int argc, char **argv) {
 		return -1;
 	}
 
+#if defined (__linux__)
+	NetworkReactor *pReactor = nullptr;
+
+	if (fopen("network.reactor", "r") != NULL) {
+		pReactor = new NetworkReactor;
+		pReactor->AddTimer(networkreactor::TICK_MILLIS);
+	} // No worries about closing this file pointer
+#endif
+
 	SpiFlashStore spiFlashStore;
 
 	StoreArtNet storeArtNet;
@@ -184,6 +194,11 @@ int main(int argc, char **argv) {
 	node.Start();
 
 	for (;;) {
+#if defined (__linux__)
+		if (pReactor != nullptr) {
+			pReactor->Wait();
+		}
+#endif
 		node.Run();
 		identify.Run();
 		remoteConfig.Run();
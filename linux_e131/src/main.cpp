@@ -30,6 +30,7 @@
 
 #include "hardware.h"
 #include "networklinux.h"
+#include "networkreactor.h"
 #include "ledblink.h"
 
 #include "e131bridge.h"
@@ -71,6 +72,15 @@ int main(int argc, char **argv) {
 		return -1;
 	}
 
+#if defined (__linux__)
+	NetworkReactor *pReactor = nullptr;
+
+	if (fopen("network.reactor", "r") != NULL) {
+		pReactor = new NetworkReactor;
+		pReactor->AddTimer(networkreactor::TICK_MILLIS);
+	} // No worries about closing this file pointer
+#endif
+
 	SpiFlashStore spiFlashStore;
 
 	E131Params e131Params(new StoreE131);
@@ -132,6 +142,11 @@ int main(int argc, char **argv) {
 	bridge.Start();
 
 	for (;;) {
+#if defined (__linux__)
+		if (pReactor != nullptr) {
+			pReactor->Wait();
+		}
+#endif
 		bridge.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
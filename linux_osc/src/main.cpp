@@ -30,6 +30,7 @@
 
 #include "hardware.h"
 #include "networklinux.h"
+#include "networkreactor.h"
 
 #include "handler.h"
 
@@ -69,6 +70,15 @@ int main(int argc, char **argv) {
 		return -1;
 	}
 
+#if defined (__linux__)
+	NetworkReactor *pReactor = nullptr;
+
+	if (fopen("network.reactor", "r") != NULL) {
+		pReactor = new NetworkReactor;
+		pReactor->AddTimer(networkreactor::TICK_MILLIS);
+	} // No worries about closing this file pointer
+#endif
+
 	SpiFlashStore spiFlashStore;
 	StoreOscServer storeOscServer;
 
@@ -110,6 +120,11 @@ int main(int argc, char **argv) {
 	server.Start();
 
 	for (;;) {
+#if defined (__linux__)
+		if (pReactor != nullptr) {
+			pReactor->Wait();
+		}
+#endif
 		server.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
@@ -50,6 +50,7 @@
 #include "pixeldmxconfiguration.h"
 #include "pixeltype.h"
 #include "pixeltestpattern.h"
+#include "pixeleffectsdmx.h"
 #include "lightset.h"
 #include "ws28xxdmxparams.h"
 #include "ws28xxdmx.h"
@@ -142,6 +143,8 @@ void notmain(void) {
 	}
 
 	PixelTestPattern *pPixelTestPattern = nullptr;
+	WS28xxDmx *pWS28xxDmx = nullptr;
+	PixelEffectsDmx *pPixelEffectsDmx = nullptr;
 
 	if (!isLedTypeSet) {
 		assert(pSpi == nullptr);
@@ -155,7 +158,7 @@ void notmain(void) {
 			ws28xxparms.Dump();
 		}
 
-		auto *pWS28xxDmx = new WS28xxDmx(pixelDmxConfiguration);
+		pWS28xxDmx = new WS28xxDmx(pixelDmxConfiguration);
 		assert(pWS28xxDmx != nullptr);
 		pSpi = pWS28xxDmx;
 
@@ -167,7 +170,13 @@ void notmain(void) {
 			display.Printf(7, "%s:%d", PixelType::GetType(pixelDmxConfiguration.GetType()), nCount);
 		}
 
-		const auto nUniverses = pWS28xxDmx->GetUniverses();
+		if (ws28xxparms.IsEffects()) {
+			pPixelEffectsDmx = new PixelEffectsDmx;
+			assert(pPixelEffectsDmx != nullptr);
+			pSpi = pPixelEffectsDmx;
+		}
+
+		const auto nUniverses = (pPixelEffectsDmx != nullptr) ? 1 : pWS28xxDmx->GetUniverses();
 		node.SetDirectUpdate(nUniverses != 1);
 
 		for (uint32_t u = 1; u < nUniverses; u++) {
@@ -240,6 +249,12 @@ void notmain(void) {
 		if (__builtin_expect((pPixelTestPattern != nullptr), 0)) {
 			pPixelTestPattern->Run();
 		}
+		if (pWS28xxDmx != nullptr) {
+			pWS28xxDmx->Run();
+		}
+		if (pPixelEffectsDmx != nullptr) {
+			pPixelEffectsDmx->Run();
+		}
 	}
 }
 
@@ -54,6 +54,9 @@
 #include "handleroled.h"
 #include "storews28xxdmx.h"
 
+#include "lightsetqueue.h"
+#include "multicore.h"
+
 // RDMNet LLRP Device Only
 #include "rdmnetdevice.h"
 #include "rdmpersonality.h"
@@ -118,6 +121,9 @@ void notmain(void) {
 	WS28xxMulti::Get()->SetJamSTAPLDisplay(new HandlerOled);
 	pixelDmxMulti.SetLightSetHandler(new WS28xxDmxStartSop);
 
+	// The pixel encoding runs on core 1, the network and protocol stack stays on core 0
+	LightSetQueue lightSetQueue(&pixelDmxMulti);
+
 	const auto nActivePorts = pixelDmxMulti.GetOutputPorts();
 
 	ArtNet4Node node(nActivePorts);
@@ -135,7 +141,7 @@ void notmain(void) {
 	node.SetArtNetDisplay(&displayUdfHandler);
 	node.SetArtNetStore(&storeArtNet);
 	node.SetDirectUpdate(true);
-	node.SetOutput(&pixelDmxMulti);
+	node.SetOutput(&lightSetQueue);
 
 	const auto nUniverses = pixelDmxMulti.GetUniverses();
 
@@ -225,6 +231,13 @@ void notmain(void) {
 	while (spiFlashStore.Flash())
 		;
 
+	MultiCore multiCore;
+
+	// The test pattern writes the pixels from core 0, the node has no output then
+	if (pPixelTestPattern == nullptr) {
+		multiCore.Start(1, LightSetQueue::Task, &lightSetQueue);
+	}
+
 	display.TextStatus(ArtNetMsgConst::START, Display7SegmentMessage::INFO_NODE_START, CONSOLE_YELLOW);
 
 	node.Start();
@@ -245,6 +258,7 @@ void notmain(void) {
 		if (__builtin_expect((pPixelTestPattern != nullptr), 0)) {
 			pPixelTestPattern->Run();
 		}
+		multiCore.Run();
 	}
 }
 
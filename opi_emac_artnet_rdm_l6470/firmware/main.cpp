@@ -331,6 +331,11 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		node.Run();
+#if defined (ORANGE_PI_ONE)
+		pSlushDmx->Run();
+#else
+		pSparkFunDmx->Run();
+#endif
 		ntpClient.Run();
 		identify.Run();
 #if defined (ORANGE_PI)
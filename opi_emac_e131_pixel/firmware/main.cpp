@@ -47,6 +47,7 @@
 #include "pixeldmxconfiguration.h"
 #include "pixeltype.h"
 #include "pixeltestpattern.h"
+#include "pixeleffectsdmx.h"
 #include "lightset.h"
 #include "ws28xxdmxparams.h"
 #include "ws28xxdmx.h"
@@ -130,6 +131,8 @@ void notmain(void) {
 	}
 
 	PixelTestPattern *pPixelTestPattern = nullptr;
+	WS28xxDmx *pWS28xxDmx = nullptr;
+	PixelEffectsDmx *pPixelEffectsDmx = nullptr;
 
 	if (!isLedTypeSet) {
 		assert(pSpi == nullptr);
@@ -143,7 +146,7 @@ void notmain(void) {
 			ws28xxparms.Dump();
 		}
 
-		auto *pWS28xxDmx = new WS28xxDmx(pixelDmxConfiguration);
+		pWS28xxDmx = new WS28xxDmx(pixelDmxConfiguration);
 		assert(pWS28xxDmx != nullptr);
 		pSpi = pWS28xxDmx;
 
@@ -155,7 +158,13 @@ void notmain(void) {
 			display.Printf(7, "%s:%d", PixelType::GetType(pixelDmxConfiguration.GetType()), nCount);
 		}
 
-		const auto nUniverses = pWS28xxDmx->GetUniverses();
+		if (ws28xxparms.IsEffects()) {
+			pPixelEffectsDmx = new PixelEffectsDmx;
+			assert(pPixelEffectsDmx != nullptr);
+			pSpi = pPixelEffectsDmx;
+		}
+
+		const auto nUniverses = (pPixelEffectsDmx != nullptr) ? 1 : pWS28xxDmx->GetUniverses();
 		bridge.SetDirectUpdate(nUniverses != 1);
 
 		for (uint32_t u = 1; u < nUniverses; u++) {
@@ -228,6 +237,12 @@ void notmain(void) {
 		if (__builtin_expect((pPixelTestPattern != nullptr), 0)) {
 			pPixelTestPattern->Run();
 		}
+		if (pWS28xxDmx != nullptr) {
+			pWS28xxDmx->Run();
+		}
+		if (pPixelEffectsDmx != nullptr) {
+			pPixelEffectsDmx->Run();
+		}
 	}
 }
 
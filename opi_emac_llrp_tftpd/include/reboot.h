@@ -54,9 +54,11 @@ public:
 			Network::Get()->Shutdown();
 
 			printf("Rebooting ...\n");
+			Display::Get()->PrintLatencyHistogram();
 
 			Display::Get()->Cls();
 			Display::Get()->TextStatus("Rebooting ...", Display7SegmentMessage::INFO_REBOOTING);
+			Display::Get()->Flush();
 		}
 
 		DEBUG_EXIT
@@ -392,6 +392,7 @@ void McpButtons::HandleRunActionSelect() {
 
 		Display::Get()->Cls();
 		Display::Get()->TextStatus("Reboot ...", Display7SegmentMessage::INFO_REBOOTING);
+		Display::Get()->Flush();
 
 		Network::Get()->Shutdown();
 		Hardware::Get()->Reboot();
@@ -39,6 +39,9 @@
 #include "showfileparams.h"
 #include "storeshowfile.h"
 #include "showfileosc.h"
+#include "showfilezones.h"
+#include "showfilemtc.h"
+#include "showfileltc.h"
 
 #include "spiflashinstall.h"
 #include "spiflashstore.h"
@@ -135,6 +138,25 @@ void notmain(void) {
 
 	showFileParams.Set();
 
+	// Chase timecode, Art-Net OpTimeCode is handled by ShowFileProtocolArtNet
+	ShowFileMtc *pShowFileMtc = nullptr;
+	ShowFileLtc *pShowFileLtc = nullptr;
+
+	switch (showFileParams.GetChaseSource()) {
+	case ShowFileChaseSources::MTC:
+		pShowFileMtc = new ShowFileMtc;
+		assert(pShowFileMtc != nullptr);
+		pShowFileMtc->Start();
+		break;
+	case ShowFileChaseSources::LTC:
+		pShowFileLtc = new ShowFileLtc;
+		assert(pShowFileLtc != nullptr);
+		pShowFileLtc->Start();
+		break;
+	default:
+		break;
+	}
+
 	oscServer.Start();
 	oscServer.Print();
 
@@ -175,11 +197,23 @@ void notmain(void) {
 
 	display.Show();
 
-	pShowFile->SetShowFile(showFileParams.GetShow());
-	pShowFile->Print();
+	// Concurrent zones replace the single show file when zones.txt is present, it is then not opened
+	auto *pShowFileZones = new ShowFileZones(pShowFileProtocolHandler);
+	assert(pShowFileZones != nullptr);
 
-	if (showFileParams.IsAutoStart()) {
-		pShowFile->Start();
+	if (pShowFileZones->Load()) {
+		pShowFileZones->Print();
+		pShowFileZones->Start();
+	} else {
+		delete pShowFileZones;
+		pShowFileZones = nullptr;
+
+		pShowFile->SetShowFile(showFileParams.GetShow());
+		pShowFile->Print();
+
+		if (showFileParams.IsAutoStart()) {
+			pShowFile->Start();
+		}
 	}
 
 	// Fixed row 5, 6, 7
@@ -200,8 +234,18 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		//
-		pShowFile->Run();
+		if (pShowFileZones != nullptr) {
+			pShowFileZones->Run();
+		} else {
+			pShowFile->Run();
+		}
 		pShowFileProtocolHandler->Run();
+		if (pShowFileMtc != nullptr) {
+			pShowFileMtc->Run();
+		}
+		if (pShowFileLtc != nullptr) {
+			pShowFileLtc->Run();
+		}
 		oscServer.Run();
 		//
 		rdmNetLLRPOnly.Run();
@@ -0,0 +1,53 @@
+/**
+ * @file showfilemtc.h
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILEMTC_H_
+#define SHOWFILEMTC_H_
+
+#include <stdint.h>
+
+#include "midi.h"
+
+/**
+ * MIDI Time Code input (UART2) for the show file chase mode.
+ * Quarter frames and full frame messages are passed to ShowFile::TimeCode.
+ */
+class ShowFileMtc {
+public:
+	void Start();
+	void Run();
+
+private:
+	void HandleQf();
+	void HandleFullFrame(const uint8_t *pSystemExclusive);
+
+private:
+	Midi m_Midi;
+	uint8_t m_aQf[8] {};
+	uint32_t m_nPartPrevious{0};
+	bool m_bDirection{true};
+};
+
+#endif /* SHOWFILEMTC_H_ */
@@ -0,0 +1,144 @@
+/**
+ * @file showfileltc.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "showfileltc.h"
+#include "showfile.h"
+
+#include "ltc.h"
+#include "ltcdecoder.h"
+
+#include "h3.h"
+#include "h3_board.h"
+#include "h3_gpio.h"
+#include "h3_hs_timer.h"
+
+#include "irq_timer.h"
+
+#include "arm/arm.h"
+#include "arm/synchronize.h"
+#include "arm/gic.h"
+
+#include "debug.h"
+
+static volatile uint32_t s_nFiqUsPrevious;
+
+static volatile uint8_t s_aTimeCode[ltc::decoder::BITS_BYTES] __attribute__ ((aligned (4)));	///< Copy of the last complete frame
+static volatile bool s_bTimeCodeAvailable;
+
+// ARM Generic Timer
+static volatile uint32_t s_nUpdatesPerSecond;
+static volatile uint32_t s_nUpdatesPrevious;
+static volatile uint32_t s_nUpdates;
+
+static void frame_handler(const uint8_t *pBits) {
+	s_nUpdates = s_nUpdates + 1;
+
+	for (uint32_t n = 0; n < ltc::decoder::BITS_BYTES; n++) {
+		s_aTimeCode[n] = pBits[n];
+	}
+
+	s_bTimeCodeAvailable = true;
+}
+
+static LtcDecoder s_LtcDecoder(frame_handler);
+
+static void __attribute__((interrupt("FIQ"))) fiq_handler() {
+	dmb();
+
+	const auto nFiqUsCurrent = h3_hs_timer_lo_us();
+
+	H3_PIO_PA_INT->STA = static_cast<uint32_t>(~0x0);
+
+	s_LtcDecoder.Edge(nFiqUsCurrent - s_nFiqUsPrevious);
+
+	s_nFiqUsPrevious = nFiqUsCurrent;
+
+	dmb();
+}
+
+static void arm_timer_handler() {
+	s_nUpdatesPerSecond = s_nUpdates - s_nUpdatesPrevious;
+	s_nUpdatesPrevious = s_nUpdates;
+}
+
+void ShowFileLtc::Start() {
+	DEBUG_ENTRY
+
+	irq_timer_arm_physical_set(static_cast<thunk_irq_timer_arm_t>(arm_timer_handler));
+	irq_timer_init();
+
+	h3_gpio_fsel(GPIO_EXT_26, GPIO_FSEL_EINT);
+
+	arm_install_handler(reinterpret_cast<unsigned>(fiq_handler), ARM_VECTOR(ARM_VECTOR_FIQ));
+
+	gic_fiq_config(H3_PA_EINT_IRQn, GIC_CORE0);
+
+	H3_PIO_PA_INT->CFG1 = (GPIO_INT_CFG_DOUBLE_EDGE << 8);
+	H3_PIO_PA_INT->CTL |= (1 << GPIO_EXT_26);
+	H3_PIO_PA_INT->STA = (1 << GPIO_EXT_26);
+	H3_PIO_PA_INT->DEB = 1;
+
+	__enable_fiq();
+
+	DEBUG_EXIT
+}
+
+void ShowFileLtc::Run() {
+	dmb();
+	if (!s_bTimeCodeAvailable) {
+		return;
+	}
+
+	uint8_t aBits[ltc::decoder::BITS_BYTES];
+
+	__disable_fiq();
+	for (uint32_t n = 0; n < ltc::decoder::BITS_BYTES; n++) {
+		aBits[n] = s_aTimeCode[n];
+	}
+	s_bTimeCodeAvailable = false;
+	__enable_fiq();
+
+	struct TLtcTimeCode tLtcTimeCode;
+	LtcDecoder::GetTimeCode(aBits, tLtcTimeCode);
+
+	uint32_t nType;
+
+	if (LtcDecoder::IsDropFrame(aBits)) {
+		nType = ltc::type::DF;
+	} else if (s_nUpdatesPerSecond == 24) {
+		nType = ltc::type::FILM;
+	} else if (s_nUpdatesPerSecond == 25) {
+		nType = ltc::type::EBU;
+	} else if (s_nUpdatesPerSecond == 30) {
+		nType = ltc::type::SMPTE;
+	} else {
+		// The rate is not known yet, the first second after the start
+		return;
+	}
+
+	ShowFile::Get()->TimeCode(tLtcTimeCode.nHours, tLtcTimeCode.nMinutes, tLtcTimeCode.nSeconds, tLtcTimeCode.nFrames, nType);
+}
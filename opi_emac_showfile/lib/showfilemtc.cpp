@@ -0,0 +1,107 @@
+/**
+ * @file showfilemtc.cpp
+ *
+ */
+/* Copyright (C) 2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "showfilemtc.h"
+#include "showfile.h"
+
+#include "midi.h"
+
+#include "debug.h"
+
+using namespace midi;
+
+void ShowFileMtc::Start() {
+	DEBUG_ENTRY
+
+	m_Midi.SetActiveSense(false);
+	m_Midi.Init(Direction::INPUT);
+
+	DEBUG_EXIT
+}
+
+void ShowFileMtc::HandleFullFrame(const uint8_t *pSystemExclusive) {
+	const auto nType = static_cast<uint32_t>(pSystemExclusive[5] >> 5);
+
+	ShowFile::Get()->TimeCode(pSystemExclusive[5] & 0x1F, pSystemExclusive[6], pSystemExclusive[7], pSystemExclusive[8], nType);
+}
+
+/*
+ * A complete time code is available after 8 quarter frames,
+ * with piece 7 when running forward and with piece 0 when running backward.
+ */
+void ShowFileMtc::HandleQf() {
+	uint8_t nData1, nData2;
+
+	m_Midi.GetMessageData(nData1, nData2);
+
+	const auto nPart = static_cast<uint32_t>((nData1 & 0x70) >> 4);
+
+	m_aQf[nPart] = nData1 & 0x0F;
+
+	if ((nPart != 7) && (m_nPartPrevious != 7)) {
+		m_bDirection = (m_nPartPrevious < nPart);
+	}
+
+	if ((m_bDirection && (nPart == 7)) || (!m_bDirection && (nPart == 0))) {
+		const auto nHours = static_cast<uint32_t>(m_aQf[6] | ((m_aQf[7] & 0x1) << 4));
+		const auto nMinutes = static_cast<uint32_t>(m_aQf[4] | (m_aQf[5] << 4));
+		const auto nSeconds = static_cast<uint32_t>(m_aQf[2] | (m_aQf[3] << 4));
+		const auto nFrames = static_cast<uint32_t>(m_aQf[0] | (m_aQf[1] << 4));
+		const auto nType = static_cast<uint32_t>(m_aQf[7] >> 1);
+
+		ShowFile::Get()->TimeCode(nHours, nMinutes, nSeconds, nFrames, nType);
+	}
+
+	m_nPartPrevious = nPart;
+}
+
+void ShowFileMtc::Run() {
+	if (!m_Midi.Read(static_cast<uint8_t>(Channel::OMNI))) {
+		return;
+	}
+
+	if (m_Midi.GetChannel() != 0) {
+		return;
+	}
+
+	switch (m_Midi.GetMessageType()) {
+	case Types::TIME_CODE_QUARTER_FRAME:
+		HandleQf();
+		break;
+	case Types::SYSTEM_EXCLUSIVE: {
+		uint8_t nSystemExclusiveLength;
+		const auto *pSystemExclusive = m_Midi.GetSystemExclusive(nSystemExclusiveLength);
+
+		if ((nSystemExclusiveLength >= 10) && (pSystemExclusive[1] == 0x7F) && (pSystemExclusive[2] == 0x7F) && (pSystemExclusive[3] == 0x01)) {
+			HandleFullFrame(pSystemExclusive);
+		}
+	}
+		break;
+	default:
+		break;
+	}
+}
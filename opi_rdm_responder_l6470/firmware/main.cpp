@@ -204,6 +204,11 @@ void notmain(void) {
 	for(;;) {
 		hw.WatchdogFeed();
 		dmxrdm.Run();
+#if defined (ORANGE_PI_ONE)
+		pSlushDmx->Run();
+#else
+		pSparkFunDmx->Run();
+#endif
 		identify.Run();
 #if defined (ORANGE_PI)
 		spiFlashStore.Flash();